@@ -13,11 +13,24 @@
 #include <scoped_allocator>
 #include <type_traits>
 
+#include <bsl_deque.h>
+#include <bsl_functional.h>
+#include <bsl_list.h>
+#include <bsl_map.h>
 #include <bsl_memory.h>
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+#include <bsl_unordered_set.h>
+#include <bsl_vector.h>
 #include <bslma_mallocfreeallocator.h>
+#include <bslma_memoryresource.h>
 
 #include <bdlma_sequentialallocator.h>
+#include <bdlma_boundallocator.h>
+#include <bdlma_bitmappool.h>
 #include <bdlma_bufferedsequentialallocator.h>
+#include <bdlma_fixedpool.h>
 #include <bdlma_multipoolallocator.h>
 
 using namespace BloombergLP;
@@ -56,12 +69,12 @@ struct stdalloc {
         using allocator = std::allocator<T>;
 };
 
-// Varriant of a bslma::BufferedSequentalPool that supports overaligned types
-// up to a pre-determined limit (usually a cache line).
+// Varriant of a bslma::BufferedSequentalPool that aligns each allocation to
+// the lowest set bit of its size, up to a pre-determined limit (usually a
+// cache line).
 class OveralignedBufferedSequentialPool {
     BloombergLP::bdlma::BufferedSequentialPool d_imp;
     int                                        d_maxAlign;
-    int                                        d_alignOffset;
 
 public:
     OveralignedBufferedSequentialPool(char             *buffer,
@@ -69,8 +82,7 @@ public:
                                       int               maxAlign,
                                       bslma::Allocator *basicAllocator = 0)
         : d_imp(buffer, size, basicAllocator)
-        , d_maxAlign(maxAlign)
-        , d_alignOffset((intptr_t) buffer & (maxAlign - 1)) { }
+        , d_maxAlign(maxAlign) { }
     OveralignedBufferedSequentialPool(char             *buffer,
                                       int               size,
                                       int               maxAlign,
@@ -78,37 +90,12 @@ public:
                                                          growthStrategy,
                                       bslma::Allocator  *basicAllocator = 0)
         : d_imp(buffer, size, growthStrategy, basicAllocator)
-        , d_maxAlign(maxAlign)
-        , d_alignOffset((intptr_t) buffer & (maxAlign - 1)) { }
+        , d_maxAlign(maxAlign) { }
 
     void *allocate(bsls::Types::size_type size) {
-        using std::intptr_t;
-        void *ret;
-
         int alignment = static_cast<int>(size | d_maxAlign);
         alignment &= -alignment; // clear all but lowest order set bit
-        int alignMask = alignment - 1;
-
-        // If next allocation will naturally achieve sufficient alignment for
-        // this allocation, just allocate from imp. Afterwords, test for
-        // proper alignment in case a buffer realloc happened.
-        if (! (d_alignOffset & alignMask)) {
-            ret = d_imp.allocate(size);
-            d_alignOffset = ((intptr_t) ret + size) & (d_maxAlign - 1);
-        };
-
-        // If next allocation will not achieve sufficient alignment for this
-        // allocation, adjust alignment by allocating sufficient extra bytes,
-        // then try allocating repeatedly until success. Given the allocation
-        // strategy, it should take no more than two tries to get it right.
-        while (d_alignOffset & alignMask) {
-            int diff = alignment - (d_alignOffset & alignMask);
-            (void) d_imp.allocate(diff);
-            ret = d_imp.allocate(size);
-            d_alignOffset = ((intptr_t) ret + size) & (d_maxAlign - 1);
-        }
-
-        return ret;
+        return d_imp.allocateAligned(size, alignment);
     }
 
     void deallocate(void*) {}
@@ -323,6 +310,65 @@ template <class Key,
         Key,Hash,Pred,allocator<Key>>;
 };
 
+// Node-based containers whose nodes, all of at most 'SIZE' bytes, are
+// supplied by a 'bdlma::FixedPool<SIZE>', the compile-time-bound (CT)
+// counterpart of a single pool of a multipool.  Containers that allocate
+// anything other than nodes (e.g., the bucket arrays of the unordered
+// containers) cannot be supplied by a fixed-size pool, and are omitted.
+template <int SIZE>
+struct fixedpool {
+
+using pool = BloombergLP::bdlma::FixedPool<SIZE>;
+
+template <typename T>
+    using allocator = std::scoped_allocator_adaptor<pool_adaptor<T,pool>>;
+
+template <class T>
+    using list = std::list<T,allocator<T>>;
+template <class T>
+    using forward_list = std::forward_list<T,allocator<T>>;
+
+template <class Key, class T, class Compare = std::less<Key>>
+    using map = std::map<
+        Key,T,Compare,allocator<std::pair<const Key,T>>>;
+template <class Key, class T, class Compare = std::less<Key>>
+    using multimap = std::multimap<
+        Key,T,Compare,allocator<std::pair<const Key,T>>>;
+
+template <class Key, class Compare = std::less<Key>>
+    using set =      std::set<Key,Compare,allocator<Key>>;
+template <class Key, class Compare = std::less<Key>>
+    using multiset = std::multiset<Key,Compare,allocator<Key>>;
+};
+
+// As 'fixedpool', but with the nodes supplied by a 'bdlma::BitmapPool',
+// which records free blocks in per-chunk bitmaps rather than threading a free
+// list through them, so that allocation stays address-ordered under churn.
+template <int SIZE>
+struct bitmappool {
+
+struct pool : BloombergLP::bdlma::BitmapPool {
+    pool() : BloombergLP::bdlma::BitmapPool(SIZE) {}
+    void *allocate(size_t) {
+        return BloombergLP::bdlma::BitmapPool::allocate();
+    }
+};
+
+template <typename T>
+    using allocator = std::scoped_allocator_adaptor<pool_adaptor<T,pool>>;
+
+template <class T>
+    using list = std::list<T,allocator<T>>;
+template <class T>
+    using forward_list = std::forward_list<T,allocator<T>>;
+
+template <class Key, class T, class Compare = std::less<Key>>
+    using map = std::map<
+        Key,T,Compare,allocator<std::pair<const Key,T>>>;
+template <class Key, class Compare = std::less<Key>>
+    using set =      std::set<Key,Compare,allocator<Key>>;
+};
+
 struct poly {
 
 template <typename T>
@@ -374,6 +420,112 @@ template <class Key,
         Key,Hash,Pred,allocator<Key>>;
 };
 
+// 'bsl' containers whose allocator, a 'bdlma::BoundAllocator', is bound at
+// compile time to the concrete 'MECHANISM' (e.g., 'bdlma::MultipoolAllocator'
+// or 'bdlma::SequentialAllocator'): supplied a 'MECHANISM', they call it
+// non-virtually, while still passing it to their elements as 'poly'
+// containers do.  The 'bsl' containers propagate the mechanism themselves, so
+// no 'std::scoped_allocator_adaptor' is needed.
+template <class MECHANISM>
+struct bound {
+
+template <typename T>
+    using allocator = BloombergLP::bdlma::BoundAllocator<T,MECHANISM>;
+
+template <class T>
+    using list = bsl::list<T,allocator<T>>;
+template <class T>
+    using deque = bsl::deque<T,allocator<T>>;
+template <class T>
+    using vector = bsl::vector<T,allocator<T>>;
+
+template <class T>
+    using basic_string =
+        bsl::basic_string<T,bsl::char_traits<T>,allocator<T>>;
+
+using string = basic_string<char>;
+
+template <class Key, class T, class Compare = bsl::less<Key>>
+    using map = bsl::map<
+        Key,T,Compare,allocator<bsl::pair<const Key,T>>>;
+template <class Key, class T, class Compare = bsl::less<Key>>
+    using multimap = bsl::multimap<
+        Key,T,Compare,allocator<bsl::pair<const Key,T>>>;
+
+template <class Key, class Compare = bsl::less<Key>>
+    using set =      bsl::set<Key,Compare,allocator<Key>>;
+template <class Key, class Compare = bsl::less<Key>>
+    using multiset = bsl::multiset<Key,Compare,allocator<Key>>;
+
+template <class Key, class T,
+          class Hash = bsl::hash<Key>, class Pred = bsl::equal_to<Key>>
+    using unordered_map = bsl::unordered_map<
+        Key,T,Hash,Pred,allocator<bsl::pair<const Key,T>>>;
+template <class Key, class T,
+          class Hash = bsl::hash<Key>, class Pred = bsl::equal_to<Key>>
+    using unordered_multimap = bsl::unordered_multimap<
+        Key,T,Hash,Pred,allocator<bsl::pair<const Key,T>>>;
+
+template <class Key,
+          class Hash = bsl::hash<Key>, class Pred = bsl::equal_to<Key>>
+    using unordered_set = bsl::unordered_set<
+        Key,Hash,Pred,allocator<Key>>;
+template <class Key,
+          class Hash = bsl::hash<Key>, class Pred = bsl::equal_to<Key>>
+    using unordered_multiset = bsl::unordered_multiset<
+        Key,Hash,Pred,allocator<Key>>;
+};
+
+#ifdef BSLMA_MEMORYRESOURCE_HAS_PMR
+// C++17 'std::pmr' containers, whose 'std::pmr::polymorphic_allocator' is
+// bound at run time to a 'std::pmr::memory_resource' -- for example, a
+// 'bslma::AllocatorResource<bdlma::MultipoolAllocator>'.  Like the 'bsl'
+// containers, they propagate the resource to their elements themselves.
+struct pmr {
+
+template <typename T>
+    using allocator = std::pmr::polymorphic_allocator<T>;
+
+template <class T>
+    using list = std::pmr::list<T>;
+template <class T>
+    using forward_list = std::pmr::forward_list<T>;
+template <class T>
+    using deque = std::pmr::deque<T>;
+template <class T>
+    using vector = std::pmr::vector<T>;
+
+template <class T>
+    using basic_string = std::pmr::basic_string<T>;
+
+using string = std::pmr::string;
+
+template <class Key, class T, class Compare = std::less<Key>>
+    using map = std::pmr::map<Key,T,Compare>;
+template <class Key, class T, class Compare = std::less<Key>>
+    using multimap = std::pmr::multimap<Key,T,Compare>;
+
+template <class Key, class Compare = std::less<Key>>
+    using set =      std::pmr::set<Key,Compare>;
+template <class Key, class Compare = std::less<Key>>
+    using multiset = std::pmr::multiset<Key,Compare>;
+
+template <class Key, class T,
+          class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+    using unordered_map = std::pmr::unordered_map<Key,T,Hash,Pred>;
+template <class Key, class T,
+          class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+    using unordered_multimap = std::pmr::unordered_multimap<Key,T,Hash,Pred>;
+
+template <class Key,
+          class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+    using unordered_set = std::pmr::unordered_set<Key,Hash,Pred>;
+template <class Key,
+          class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+    using unordered_multiset = std::pmr::unordered_multiset<Key,Hash,Pred>;
+};
+#endif
+
 #endif
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <stdint.h>
+
+#include <bdlma_countingallocator.h>
+#include <bdlma_headerlessmultipool.h>
+#include <bdlma_multipool.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+
+// Measure the memory footprint of small blocks: 'activeAllocation' blocks of
+// 'allocationSize' bytes are kept live while 'totalAllocation' blocks are
+// allocated in total, replacing the live blocks round-robin.  For each
+// multipool, report the bytes obtained from the underlying allocator per live
+// block, and the running time relative to 'bdlma::Multipool'.
+
+int64_t totalAllocation;
+int64_t activeAllocation;
+int     allocationSize;
+
+template <class T>
+double testOnce(T& allocator) {
+    timespec start;
+    timespec stop;
+
+    bsl::vector<void *> active;
+    active.resize(activeAllocation);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int64_t i;
+    for (i = 0; i < totalAllocation && i < activeAllocation; ++i) {
+        active[i] = allocator.allocate(allocationSize);
+        ++(*static_cast<char *>(active[i]));
+    }
+    for (; i < totalAllocation; ++i) {
+        int64_t j = i % activeAllocation;
+        allocator.deallocate(active[j]);
+        active[j] = allocator.allocate(allocationSize);
+        ++(*static_cast<char *>(active[j]));
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    for (i = 0; i < totalAllocation && i < activeAllocation; ++i) {
+        allocator.deallocate(active[i]);
+    }
+
+    int64_t rv = static_cast<int64_t>(stop.tv_sec - start.tv_sec) * 1000000000LL
+                    + (stop.tv_nsec - start.tv_nsec);
+    return (static_cast<double>(rv) / 1000000000.0L);
+}
+
+template <class T>
+double test(double *bytesPerObject) {
+    bdlma::CountingAllocator counter;
+    double                   rv;
+    {
+        T allocator(&counter);
+        rv = testOnce(allocator);
+
+        // Neither multipool returns memory to 'counter' before 'release', so
+        // the bytes in use are also the peak.
+
+        *bytesPerObject = static_cast<double>(counter.numBytesInUse())
+                                                           / activeAllocation;
+    }
+    return rv;
+}
+
+int main(int argc, char *argv[]) {
+    int totalSize = argc > 1 ? atoi(argv[1]) : 24;
+    int activeSize = argc > 2 ? atoi(argv[2]) : 16;
+    allocationSize = argc > 3 ? atoi(argv[3]) : 16;
+
+    totalAllocation = 1LL << totalSize;
+    activeAllocation = 1LL << activeSize;
+
+    double mpBytes;
+    double hmBytes;
+
+    double mpTime = test<bdlma::Multipool>(&mpBytes);
+    double hmTime = test<bdlma::HeaderlessMultipool>(&hmBytes);
+
+    printf("%i,%i,%i,%0.1lf,%0.1lf,%0.3lfs,%0.0lf\n",
+           totalSize, activeSize, allocationSize,
+           mpBytes, hmBytes, mpTime, 100.0 * hmTime / mpTime);
+    return 0;
+}
@@ -0,0 +1,426 @@
+
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <iterator>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <memory.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <bsl_memory.h>
+#include <bslma_newdeleteallocator.h>
+#include <bsls_stopwatch.h>
+
+#include <bdlma_hugepageallocator.h>
+#include <bdlma_sequentialallocator.h>
+#include <bdlma_multipoolallocator.h>
+
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <scoped_allocator>
+#include "allocont.h"
+
+using namespace BloombergLP;
+
+// A variant of growth.cc that compares the upstream source of the blocks
+// obtained by monotonic and multipool/monotonic arenas: the heap, huge-page
+// mappings, or prefaulted huge-page mappings.  Each arena is created and
+// destroyed once per round, so every round pays for the first touch of the
+// memory it uses.  For each case the wall time and the number of page faults
+// taken are reported.
+
+static const int max_problem_logsize = 30;
+
+void usage(char const* cmd, int result)
+{
+    std::cerr <<
+"usage: " << cmd << " <size> <split> [<csv>]\n"
+"    size:  log2 of total element count, 20 -> 1,000,000\n"
+"    split: log2 of container size, 10 -> 1,000\n"
+"    csv:   if present, produce CSV: <<time>, <%>, <faults>, <description>...>\n"
+"    Number of containers used is 2^(size - split)\n"
+"    1 <= size <= " << max_problem_logsize << ", 1 <= split <= size\n";
+    exit(result);
+}
+
+// side_effect() touches memory in a way that optimizers will not optimize away
+
+void side_effect(void* p, size_t len)
+{
+    static volatile thread_local char* target;
+    target = (char*) p;
+    memset((char*)target, 0xff, len);
+}
+
+// (not standard yet)
+struct range {
+    int start; int stop;
+    struct iter {
+        int i;
+        bool operator!=(iter other) { return other.i != i; };
+        iter& operator++() { ++i; return *this; };
+        int operator*() { return i; }
+    };
+    iter begin() { return iter{start}; }
+    iter end() { return iter{stop}; }
+};
+
+char trash[1 << 16];  // random characters to construct string keys from
+
+std::default_random_engine random_engine;
+std::uniform_int_distribution<int> pos_dist(0, sizeof(trash) - 1000);
+std::uniform_int_distribution<int> length_dist(33, 1000);
+
+char* sptr() { return trash + pos_dist(random_engine); }
+size_t slen() {return length_dist(random_engine); }
+
+// Arenas start with a buffer of one huge page, so that every block they obtain
+// from a huge-page upstream is mapped.
+
+static const int initial_size = bdlma::HugePageAllocator::k_HUGE_PAGE_SIZE;
+
+enum {
+    VEC=1<<0, HASH=1<<1, VECVEC=1<<2,
+    INT=1<<3, STR=1<<4,
+    SA=1<<5, MT=1<<6, PM=1<<7,
+    ND=1<<8, HP=1<<9, HPF=1<<10
+};
+
+char const* const names[] = {
+    "vector", "unordered_set", "vector:vector",
+    "int", "string",
+    "new/delete", "monotonic", "multipool/monotonic",
+    "heap", "huge-page", "huge-page/prefault"
+};
+
+void print_case(int mask)
+{
+    for (int i = 5, m = SA; m <= PM; ++i, m <<= 1) {
+        if (m & mask)
+            std::cout << "allocator: " << names[i];
+    }
+    for (int i = 8, m = ND; m <= HPF; ++i, m <<= 1) {
+        if (m & mask)
+            std::cout << ", upstream: " << names[i];
+    }
+}
+void print_datastruct(int mask)
+{
+    for (int i = 0, m = VEC; m < SA; ++i, (m <<= 1)) {
+        if (m & mask) {
+            std::cout << names[i];
+            if (m < INT)
+                std::cout << ":";
+        }}
+}
+
+long page_faults()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+template <typename Test>
+double measure(int mask, bool csv, double reference, Test test)
+{
+    if (mask & SA)
+        std::cout << std::endl;
+    if (!csv) {
+        if (mask & SA) {
+            print_datastruct(mask);
+            std::cout << ":\n\n";
+        }
+        std::cout << "   ";
+        print_case(mask);
+        std::cout << std::endl;
+    }
+
+    std::cout.flush();
+
+    int pipes[2];
+    int result = pipe(pipes);
+    if (result < 0) {
+        std::cerr << "\nFailed pipe\n";
+        std::cout << "\nFailed pipe\n";
+        exit(-1);
+    }
+    union { double result_time; char buf[sizeof(double)]; };
+    result_time = 0.0;
+    int pid = fork();
+    if (pid < 0) {
+        std::cerr << "\nFailed fork\n";
+        std::cout << "\nFailed fork\n";
+        exit(-1);
+    } else if (pid > 0) {  // parent
+        close(pipes[1]);
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (status == 0) {
+            int got = read(pipes[0], buf, sizeof(buf));
+            if (got != sizeof(buf)) {
+                std::cerr << "\nFailed read\n";
+                std::cout << "\nFailed read\n";
+                exit(-1);
+            }
+        } else {
+            if (!csv) {
+                std::cout << "   (failed)\n" << std::endl;
+            } else {
+                std::cout << "(failed), (failed%), (failed), ";
+                print_datastruct(mask);
+                std::cout << ", ";
+                print_case(mask);
+                std::cout << std::endl;
+            }
+        }
+        close(pipes[0]);
+    } else {  // child
+        close(pipes[0]);
+        bool failed = false;
+        bsls::Stopwatch timer;
+        long faults = page_faults();
+        try {
+            timer.start(true);
+            test();
+        } catch (std::bad_alloc&) {
+            failed = true;
+        }
+        timer.stop();
+        faults = page_faults() - faults;
+
+        double times[3] = { 0.0, 0.0, 0.0 };
+        if (!failed)
+            timer.accumulatedTimes(times, times+1, times+2);
+
+        if (!csv) {
+            if (!failed) {
+                std::cout << "   sys: " << times[0]
+                          << " user: " << times[1]
+                          << " wall: " << times[2]
+                          << " faults: " << faults << ", ";
+                if (mask & SA) {
+                    std::cout << "(100%)\n";
+                } else if (reference == 0.0) {  // reference run failed
+                    std::cout << "(N/A%)\n";
+                } else {
+                    std::cout << (times[2] * 100.)/reference << "%\n";
+                }
+            } else {
+                std::cout << "   (failed)\n";
+            }
+            std::cout << std::endl;
+        } else {
+            if (!failed) {
+                std::cout << times[2] << ", ";
+                if (mask & SA) {
+                    std::cout << "(100%), ";
+                } else if (reference == 0.0) {  // reference run failed
+                    std::cout << "(N/A%), ";
+                } else {
+                    std::cout << (times[2] * 100.)/reference << "%, ";
+                }
+                std::cout << faults << ", ";
+            } else {
+                std::cout << "(failed), (failed%), (failed), ";
+            }
+            print_datastruct(mask);
+            std::cout << ", ";
+            print_case(mask);
+            std::cout << std::endl;
+        }
+        std::cout.flush();
+        result_time = times[2];
+        write(pipes[1], buf, sizeof(buf));
+        close(pipes[1]);
+        exit(0);
+    }
+
+    return (mask & SA) ? result_time : reference;
+}
+
+#ifdef __GLIBCXX__
+namespace std {
+  template<typename C, typename T, typename A>
+    struct hash<basic_string<C, T, A>>
+    {
+      using result_type = size_t;
+      using argument_type = basic_string<C, T, A>;
+
+      result_type operator()(const argument_type& s) const noexcept
+      { return std::_Hash_impl::hash(s.data(), s.length()); }
+    };
+}
+#endif
+
+template <typename PolyCont, typename Work>
+void apply_upstreams(int mask, int runs, int split, bool csv, Work work)
+{
+    double reference;
+
+// allocator: newdelete
+    reference = measure((SA|mask), csv, 0.0,
+        [runs,split,work]() {
+                bslma::NewDeleteAllocator mfa;
+                for (int run: range{0, runs}) {
+                    PolyCont c(&mfa);
+                    c.reserve(split);
+                    work(c, split);
+                }});
+
+    struct upstream { int mask; bdlma::HugePageAllocator::PrefaultPolicy pp; };
+    const upstream upstreams[] = {
+        { HP, bdlma::HugePageAllocator::e_NO_PREFAULT },
+        { HPF, bdlma::HugePageAllocator::e_PREFAULT }
+    };
+
+// allocator: monotonic, upstream: heap
+    measure((MT|ND|mask), csv, reference,
+        [runs,split,work]() {
+                bslma::NewDeleteAllocator mfa;
+                for (int run: range{0, runs}) {
+                    bdlma::SequentialAllocator sa(initial_size, &mfa);
+                    PolyCont c(&sa);
+                    c.reserve(split);
+                    work(c, split);
+                }});
+
+// allocator: monotonic, upstream: huge-page, huge-page/prefault
+    for (const upstream& up: upstreams) {
+        const bdlma::HugePageAllocator::PrefaultPolicy pp = up.pp;
+        measure((MT|up.mask|mask), csv, reference,
+            [runs,split,work,pp]() {
+                    bdlma::HugePageAllocator hpa(pp);
+                    for (int run: range{0, runs}) {
+                        bdlma::SequentialAllocator sa(initial_size, &hpa);
+                        PolyCont c(&sa);
+                        c.reserve(split);
+                        work(c, split);
+                    }});
+    }
+
+// allocator: multipool/monotonic, upstream: heap
+    measure((PM|ND|mask), csv, reference,
+        [runs,split,work]() {
+                bslma::NewDeleteAllocator mfa;
+                for (int run: range{0, runs}) {
+                    bdlma::SequentialAllocator sa(initial_size, &mfa);
+                    bdlma::MultipoolAllocator mpa(&sa);
+                    PolyCont c(&mpa);
+                    c.reserve(split);
+                    work(c, split);
+                }});
+
+// allocator: multipool/monotonic, upstream: huge-page, huge-page/prefault
+    for (const upstream& up: upstreams) {
+        const bdlma::HugePageAllocator::PrefaultPolicy pp = up.pp;
+        measure((PM|up.mask|mask), csv, reference,
+            [runs,split,work,pp]() {
+                    bdlma::HugePageAllocator hpa(pp);
+                    for (int run: range{0, runs}) {
+                        bdlma::SequentialAllocator sa(initial_size, &hpa);
+                        bdlma::MultipoolAllocator mpa(&sa);
+                        PolyCont c(&mpa);
+                        c.reserve(split);
+                        work(c, split);
+                    }});
+    }
+}
+
+void apply_containers(int runs, int split, bool csv)
+{
+    apply_upstreams<poly::vector<int>>(
+        VEC|INT, runs * 128, split, csv,
+        [] (auto& c, int elems) {
+            for (int elt: range{0, elems}) {
+                c.emplace_back(elt);
+                side_effect(&c.back(), 4);
+        }});
+
+    apply_upstreams<poly::vector<poly::string>>(
+        VEC|STR, runs * 128, split, csv,
+        [] (auto& c, int elems) {
+            for (int elt: range{0, elems}) {
+                c.emplace_back(sptr(), slen());
+                side_effect(const_cast<char*>(c.back().data()), 4);
+        }});
+
+    apply_upstreams<poly::unordered_set<poly::string>>(
+        HASH|STR, runs * 128, split, csv,
+        [] (auto& c, int elems) {
+            for (int elt: range{0, elems})
+                c.emplace(sptr(), slen());
+        });
+
+    apply_upstreams<poly::vector<poly::vector<poly::string>>>(
+        VECVEC|STR, runs, split, csv,
+        [split] (auto& c, int elems) {
+            typename std::decay<decltype(c)>::type::value_type s(
+                c.get_allocator());
+            s.reserve(128);
+            for (int i : range{0,128})
+                s.emplace_back(sptr(), slen());
+            c.emplace_back(std::move(s));
+            for (int elt: range{0, split})
+                c.emplace_back(c.back());
+        });
+}
+
+
+int main(int ac, char** av)
+{
+    std::ios::sync_with_stdio(false);
+    if (ac != 3 && ac != 4)
+        usage(*av, 1);
+    int logsize = atoi(av[1]);
+    int logsplit = atoi(av[2]);
+    if (logsize < 1 || logsize > max_problem_logsize)
+        usage(*av, 2);
+    if (logsplit < 1 || logsplit > logsize)
+        usage(*av, 3);
+    bool csv = (ac == 4);
+
+    if (!csv) {
+        std::cout << "Total # of objects = 2^" << logsize
+                  << ", # elements per container = 2^" << logsplit
+                  << ", # rounds = 2^" << logsize - logsplit << "\n";
+    }
+
+    int size = 1 << logsize;
+    int split = 1 << logsplit;
+    int runs = size / split;
+
+    std::uniform_int_distribution<char> char_dist('!', '~');
+    for (char& c : trash)
+        c = char_dist(random_engine);
+
+    std::cout << std::setprecision(3);
+
+    apply_containers(runs, split, csv);
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
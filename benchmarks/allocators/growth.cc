@@ -22,10 +22,13 @@
 #include <bdlma_bufferedsequentialallocator.h>
 #include <bdlma_multipoolallocator.h>
 
+#include <bslma_memoryresource.h>
+
 #include <vector>
 #include <string>
 #include <unordered_set>
 #include <scoped_allocator>
+#include <memory_resource>
 #include "allocont.h"
 
 using namespace BloombergLP;
@@ -83,7 +86,7 @@ enum {
         HASHVEC=1<<4, HASHHASH=1<<5,
     INT=1<<6, STR=1<<7,
     SA=1<<8, MT=1<<9, MTD=1<<10, PL=1<<11, PLD=1<<12,
-        PM=1<<13, PMD=1<<14, CT=1<<15, RT=1<<16
+        PM=1<<13, PMD=1<<14, CT=1<<15, RT=1<<16, PR=1<<17
 };
 
 char const* const names[] = {
@@ -92,12 +95,12 @@ char const* const names[] = {
     "int", "string",
     "new/delete", "monotonic", "monotonic/drop", "multipool", "multipool/drop",
         "multipool/monotonic", "multipool/monotonic/drop",
-    "compile-time", "run-time"
+    "compile-time", "run-time", "pmr"
 };
 
 void print_case(int mask)
 {
-    for (int i = 8, m = SA; m <= RT; ++i, m <<= 1) {
+    for (int i = 8, m = SA; m <= PR; ++i, m <<= 1) {
         if (m & mask) {
             if (m < CT)
                 std::cout << "allocator: " << names[i] << ", ";
@@ -263,6 +266,7 @@ template <
     typename MonoCont,
     typename MultiCont,
     typename PolyCont,
+    typename PmrCont,
     typename Work>
 void apply_allocation_strategies(
     int mask, int runs, int split, bool csv, Work work)
@@ -415,13 +419,93 @@ void apply_allocation_strategies(
                     c->reserve(split);
                     work(*c, split);
                 }});
+
+// allocator: newdelete, bound: pmr
+    measure((SA|mask|PR), csv, reference,
+        [runs,split,work]() {
+                std::pmr::memory_resource* ndr =
+                        std::pmr::new_delete_resource();
+                for (int run: range{0, runs}) {
+                    PmrCont c(ndr);
+                    c.reserve(split);
+                    work(c, split);
+                }});
+
+// allocator: monotonic, bound: pmr
+    measure((MT|mask|PR), csv, reference,
+        [runs,split,work]() {
+                for (int run: range{0, runs}) {
+                    bslma::AllocatorResource<
+                        bdlma::BufferedSequentialAllocator> bsa(pool,
+                                                                sizeof(pool));
+                    PmrCont c(&bsa);
+                    c.reserve(split);
+                    work(c, split);
+                }});
+
+// allocator: monotonic, bound: pmr, drop
+    measure((MTD|mask|PR), csv, reference,
+        [runs,split,work]() {
+                for (int run: range{0, runs}) {
+                    bslma::AllocatorResource<
+                        bdlma::BufferedSequentialAllocator> bsa(pool,
+                                                                sizeof(pool));
+                    auto* c = new(bsa) PmrCont(&bsa);
+                    c->reserve(split);
+                    work(*c, split);
+                }});
+
+// allocator: multipool, bound: pmr
+    measure((PL|mask|PR), csv, reference,
+        [runs,split,work]() {
+                for (int run: range{0, runs}) {
+                    bslma::AllocatorResource<bdlma::MultipoolAllocator> mpa;
+                    PmrCont c(&mpa);
+                    c.reserve(split);
+                    work(c, split);
+                }});
+
+// allocator: multipool, bound: pmr, drop
+    measure((PLD|mask|PR), csv, reference,
+        [runs,split,work]() {
+                for (int run: range{0, runs}) {
+                    bslma::AllocatorResource<bdlma::MultipoolAllocator> mpa;
+                    auto* c = new(mpa) PmrCont(&mpa);
+                    c->reserve(split);
+                    work(*c, split);
+                }});
+
+// allocator: multipool/monotonic, bound: pmr
+    measure((PM|mask|PR), csv, reference,
+        [runs,split,work]() {
+                for (int run: range{0, runs}) {
+                    bdlma::BufferedSequentialAllocator bsa(pool, sizeof(pool));
+                    bslma::AllocatorResource<bdlma::MultipoolAllocator> mpa(
+                                                                        &bsa);
+                    PmrCont c(&mpa);
+                    c.reserve(split);
+                    work(c, split);
+                }});
+
+// allocator: multipool/monotonic, bound: pmr, drop monotonic
+    measure((PMD|mask|PR), csv, reference,
+        [runs,split,work]() {
+                for (int run: range{0, runs}) {
+                    bdlma::BufferedSequentialAllocator bsa(pool, sizeof(pool));
+                    auto* mp = new(bsa)
+                        bslma::AllocatorResource<bdlma::MultipoolAllocator>(
+                                                                        &bsa);
+                    auto* c = new(*mp) PmrCont(mp);
+                    c->reserve(split);
+                    work(*c, split);
+                }});
 }
 
 void apply_containers(int runs, int split, bool csv)
 {
     apply_allocation_strategies<
             std::vector<int>,monotonic::vector<int>,
-            multipool::vector<int>,poly::vector<int>>(
+            multipool::vector<int>,poly::vector<int>,pmr::vector<int>>(
         VEC|INT, runs * 128, split, csv,
         [] (auto& c, int elems) {
             for (int elt: range{0, elems}) {
@@ -433,7 +517,8 @@ void apply_containers(int runs, int split, bool csv)
             std::vector<std::string>,
             monotonic::vector<monotonic::string>,
             multipool::vector<multipool::string>,
-            poly::vector<poly::string>>(
+            poly::vector<poly::string>,
+            pmr::vector<pmr::string>>(
         VEC|STR, runs * 128, split, csv,
         [] (auto& c, int elems) {
             for (int elt: range{0, elems}) {
@@ -443,7 +528,8 @@ void apply_containers(int runs, int split, bool csv)
 
     apply_allocation_strategies<
             std::unordered_set<int>,monotonic::unordered_set<int>,
-            multipool::unordered_set<int>,poly::unordered_set<int>>(
+            multipool::unordered_set<int>,poly::unordered_set<int>,
+            pmr::unordered_set<int>>(
         HASH|INT, runs * 128, split, csv,
         [] (auto& c, int elems) {
             for (int elt: range{0, elems})
@@ -454,7 +540,8 @@ void apply_containers(int runs, int split, bool csv)
             std::unordered_set<std::string>,
             monotonic::unordered_set<monotonic::string>,
             multipool::unordered_set<multipool::string>,
-            poly::unordered_set<poly::string>>(
+            poly::unordered_set<poly::string>,
+            pmr::unordered_set<pmr::string>>(
         HASH|STR, runs * 128, split, csv,
         [] (auto& c, int elems) {
             for (int elt: range{0, elems})
@@ -465,7 +552,8 @@ void apply_containers(int runs, int split, bool csv)
             std::vector<std::vector<int>>,
             monotonic::vector<monotonic::vector<int>>,
             multipool::vector<multipool::vector<int>>,
-            poly::vector<poly::vector<int>>>(
+            poly::vector<poly::vector<int>>,
+            pmr::vector<pmr::vector<int>>>(
         VECVEC|INT, runs, split, csv,
         [] (auto& c, int elems) {
             c.emplace_back(128, 1);
@@ -477,7 +565,8 @@ void apply_containers(int runs, int split, bool csv)
             std::vector<std::vector<std::string>>,
             monotonic::vector<monotonic::vector<monotonic::string>>,
             multipool::vector<multipool::vector<multipool::string>>,
-            poly::vector<poly::vector<poly::string>>>(
+            poly::vector<poly::vector<poly::string>>,
+            pmr::vector<pmr::vector<pmr::string>>>(
         VECVEC|STR, runs, split, csv,
         [split] (auto& c, int elems) {
             typename std::decay<decltype(c)>::type::value_type s(
@@ -494,7 +583,8 @@ void apply_containers(int runs, int split, bool csv)
             std::vector<std::unordered_set<int>>,
             monotonic::vector<monotonic::unordered_set<int>>,
             multipool::vector<multipool::unordered_set<int>>,
-            poly::vector<poly::unordered_set<int>>>(
+            poly::vector<poly::unordered_set<int>>,
+            pmr::vector<pmr::unordered_set<int>>>(
         VECHASH|INT, runs, split, csv,
         [split] (auto& c, int elems) {
             int in[128]; std::generate(in, in+128, random_engine);
@@ -510,7 +600,8 @@ void apply_containers(int runs, int split, bool csv)
             std::vector<std::unordered_set<std::string>>,
             monotonic::vector<monotonic::unordered_set<monotonic::string>>,
             multipool::vector<multipool::unordered_set<multipool::string>>,
-            poly::vector<poly::unordered_set<poly::string>>>(
+            poly::vector<poly::unordered_set<poly::string>>,
+            pmr::vector<pmr::unordered_set<pmr::string>>>(
         VECHASH|STR, runs, split, csv,
         [split] (auto& c, int elems) {
             typename std::decay<decltype(c)>::type::value_type s(
@@ -534,7 +625,10 @@ void apply_containers(int runs, int split, bool csv)
                     my_equal<multipool::vector<int>>>,
             poly::unordered_set<poly::vector<int>,
                     my_hash<poly::vector<int>>,
-                    my_equal<poly::vector<int>>>>(
+                    my_equal<poly::vector<int>>>,
+            pmr::unordered_set<pmr::vector<int>,
+                    my_hash<pmr::vector<int>>,
+                    my_equal<pmr::vector<int>>>>(
         HASHVEC|INT, runs, split, csv,
         [split] (auto& c, int elems) {
             typename std::decay<decltype(c)>::type::key_type s(
@@ -559,7 +653,10 @@ void apply_containers(int runs, int split, bool csv)
                 my_equal<multipool::vector<multipool::string>>>,
             poly::unordered_set<poly::vector<poly::string>,
                 my_hash<poly::vector<poly::string>>,
-                my_equal<poly::vector<poly::string>>>>(
+                my_equal<poly::vector<poly::string>>>,
+            pmr::unordered_set<pmr::vector<pmr::string>,
+                my_hash<pmr::vector<pmr::string>>,
+                my_equal<pmr::vector<pmr::string>>>>(
         HASHVEC|STR, runs, split, csv,
         [split] (auto& c, int elems) {
             typename std::decay<decltype(c)>::type::key_type s(
@@ -587,7 +684,11 @@ void apply_containers(int runs, int split, bool csv)
             poly::unordered_set<
                 poly::unordered_set<int>,
                     my_hash<poly::unordered_set<int>>,
-                    my_equal<poly::unordered_set<int>>>>(
+                    my_equal<poly::unordered_set<int>>>,
+            pmr::unordered_set<
+                pmr::unordered_set<int>,
+                    my_hash<pmr::unordered_set<int>>,
+                    my_equal<pmr::unordered_set<int>>>>(
         HASHHASH|INT, runs, split, csv,
         [split] (auto& c, int elems) {
             typename std::decay<decltype(c)>::type::key_type s(
@@ -614,7 +715,11 @@ void apply_containers(int runs, int split, bool csv)
             poly::unordered_set<
                 poly::unordered_set<poly::string>,
                     my_hash<poly::unordered_set<poly::string>>,
-                    my_equal<poly::unordered_set<poly::string>>>>(
+                    my_equal<poly::unordered_set<poly::string>>>,
+            pmr::unordered_set<
+                pmr::unordered_set<pmr::string>,
+                    my_hash<pmr::unordered_set<pmr::string>>,
+                    my_equal<pmr::unordered_set<pmr::string>>>>(
         HASHHASH|STR, runs, split, csv,
         [split] (auto& c, int elems) {
             typename std::decay<decltype(c)>::type::key_type s(
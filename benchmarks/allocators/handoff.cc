@@ -0,0 +1,229 @@
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <bdlma_multipool.h>
+#include <bdlma_threadcachingmultipool.h>
+#include <bdlma_threadheapmultipool.h>
+
+using namespace BloombergLP;
+
+// Measure allocators when the thread that allocates a block is never the one
+// that deallocates it: each of 'P' producer threads allocates '2^N' messages
+// of '2^S' bytes and hands them, through a single-producer single-consumer
+// ring, to its own consumer thread, which touches and deallocates them.  All
+// threads share one allocator: 'operator new' (AS1), a mutex-guarded
+// 'bdlma::Multipool' (SM), a 'bdlma::ThreadCachingMultipool' (TC), or a
+// 'bdlma::ThreadHeapMultipool' (TH).
+
+#define ITER 7
+#define RING_SIZE 1024
+
+int N;
+int S;
+int P;
+
+struct Ring {
+    // Single-producer single-consumer queue of messages.
+    void                  *d_slots[RING_SIZE];
+    std::atomic<unsigned>  d_head;  // next slot to pop, written by consumer
+    char                   d_padding[64];
+    std::atomic<unsigned>  d_tail;  // next slot to push, written by producer
+
+    Ring() : d_head(0), d_tail(0) {}
+
+    void push(void *p) {
+        unsigned tail = d_tail.load(std::memory_order_relaxed);
+        while (tail - d_head.load(std::memory_order_acquire) == RING_SIZE) {
+            sched_yield();
+        }
+        d_slots[tail % RING_SIZE] = p;
+        d_tail.store(tail + 1, std::memory_order_release);
+    }
+
+    void *pop() {
+        unsigned head = d_head.load(std::memory_order_relaxed);
+        while (head == d_tail.load(std::memory_order_acquire)) {
+            sched_yield();
+        }
+        void *p = d_slots[head % RING_SIZE];
+        d_head.store(head + 1, std::memory_order_release);
+        return p;
+    }
+};
+
+pthread_mutex_t                sharedLock = PTHREAD_MUTEX_INITIALIZER;
+bdlma::Multipool              *sharedMultipool;
+bdlma::ThreadCachingMultipool *sharedCachingMultipool;
+bdlma::ThreadHeapMultipool    *sharedHeapMultipool;
+
+struct newDelete {
+    static void *allocate(size_t s) {  return ::operator new(s);  }
+    static void deallocate(void *p) {  ::operator delete(p);  }
+};
+
+struct lockedMultipool {
+    static void *allocate(size_t s) {
+        pthread_mutex_lock(&sharedLock);
+        void *p = sharedMultipool->allocate(s);
+        pthread_mutex_unlock(&sharedLock);
+        return p;
+    }
+    static void deallocate(void *p) {
+        pthread_mutex_lock(&sharedLock);
+        sharedMultipool->deallocate(p);
+        pthread_mutex_unlock(&sharedLock);
+    }
+};
+
+struct cachingMultipool {
+    static void *allocate(size_t s) {
+        return sharedCachingMultipool->allocate(s);
+    }
+    static void deallocate(void *p) {
+        sharedCachingMultipool->deallocate(p);
+    }
+};
+
+struct heapMultipool {
+    static void *allocate(size_t s) {
+        return sharedHeapMultipool->allocate(s);
+    }
+    static void deallocate(void *p) {  sharedHeapMultipool->deallocate(p);  }
+};
+
+template <class A>
+void *producer(void *arg) {
+    Ring *ring = static_cast<Ring *>(arg);
+    for (int i = 0; i < N; ++i) {
+        char *p = static_cast<char *>(A::allocate(S));
+        *p = static_cast<char>(i);
+        ring->push(p);
+    }
+    return 0;
+}
+
+template <class A>
+void *consumer(void *arg) {
+    Ring *ring = static_cast<Ring *>(arg);
+    for (int i = 0; i < N; ++i) {
+        char *p = static_cast<char *>(ring->pop());
+        ++(*p);
+        A::deallocate(p);
+    }
+    return 0;
+}
+
+template <class A>
+double testOnce() {
+    timespec start;
+    timespec stop;
+
+    std::vector<Ring>      rings(P);
+    std::vector<pthread_t> id(2 * P);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < P; ++i) {
+        pthread_create(&id[2 * i], 0, consumer<A>, &rings[i]);
+        pthread_create(&id[2 * i + 1], 0, producer<A>, &rings[i]);
+    }
+    for (int i = 0; i < 2 * P; ++i) {
+        pthread_join(id[i], 0);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    int64_t rv = static_cast<int64_t>(stop.tv_sec - start.tv_sec) * 1000000000LL
+                    + (stop.tv_nsec - start.tv_nsec);
+    return (static_cast<double>(rv) / 1000000000.0L);
+}
+
+template <class A>
+double test() {
+    // Return the mean of the 'ITER' runs, less the two fastest and the two
+    // slowest.
+
+    std::vector<double> v;
+    for (int i = 0; i < ITER; ++i) {
+        v.push_back(testOnce<A>());
+    }
+    std::sort(v.begin(), v.end());
+
+    double t = 0;
+    for (unsigned i = 2; i < v.size() - 2; ++i) {
+        t += v[i];
+    }
+    return t / (v.size() - 4);
+}
+
+int main(int argc, char *argv[]) {
+    N = argc > 1 ? atoi(argv[1]) : 1;
+    S = argc > 2 ? atoi(argv[2]) : 1;
+    P = argc > 3 ? atoi(argv[3]) : 1;
+
+    // Time for 'operator new' (AS1), then time relative to it, as a
+    // percentage, for the shared mutex-guarded multipool (SM), the shared
+    // thread-caching multipool (TC), and the shared thread-heap multipool
+    // (TH).
+
+    printf("%i,%i,%i", N, S, P);
+
+    N = 1 << N;
+    S = 1 << S;
+
+    double rv = -1.0;
+    double firstRV = -1.0;
+
+    rv = test<newDelete>();
+    firstRV = rv;
+    printf(",%0.3lfs", rv);
+    fflush(stdout);
+
+    {
+        bdlma::Multipool allocator;
+        sharedMultipool = &allocator;
+        rv = test<lockedMultipool>();
+        printf(",%0.0lf", 100.0 * rv / firstRV);
+        fflush(stdout);
+    }
+
+    {
+        bdlma::ThreadCachingMultipool allocator;
+        sharedCachingMultipool = &allocator;
+        rv = test<cachingMultipool>();
+        printf(",%0.0lf", 100.0 * rv / firstRV);
+        fflush(stdout);
+    }
+
+    {
+        bdlma::ThreadHeapMultipool allocator;
+        sharedHeapMultipool = &allocator;
+        rv = test<heapMultipool>();
+        printf(",%0.0lf", 100.0 * rv / firstRV);
+    }
+
+    printf("\n");
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
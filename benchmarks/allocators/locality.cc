@@ -34,9 +34,38 @@
 #elif defined(CTMULTI)
     template <typename T>
         using List =  multipool::list<T>;
+#elif defined(CTFIXED)
+    template <typename T>
+        struct ListNode {
+            // This 'struct' has the layout of a 'std::list' node: two links
+            // followed by the element.
+            void *d_links[2];
+            T     d_value;
+        };
+    template <typename T>
+        using ListPool = fixedpool<sizeof(ListNode<T>)>;
+    template <typename T>
+        using List =  typename ListPool<T>::template list<T>;
+#elif defined(CTBITMAP)
+    template <typename T>
+        struct ListNode {
+            // This 'struct' has the layout of a 'std::list' node: two links
+            // followed by the element.
+            void *d_links[2];
+            T     d_value;
+        };
+    template <typename T>
+        using ListPool = bitmappool<sizeof(ListNode<T>)>;
+    template <typename T>
+        using List =  typename ListPool<T>::template list<T>;
 #elif defined(RTMULTI) || defined(RTMULTIMONO)
     template <typename T>
         using List =  poly::list<T>;
+#elif defined(BTMULTI)
+    template <typename T>
+        using List =
+                  typename bound<BloombergLP::bdlma::MultipoolAllocator>::
+                                                          template list<T>;
 #endif
 
 
@@ -46,7 +75,9 @@ class Subsystem {
 
 #if defined(CTMULTI)
     BloombergLP::bdlma::Multipool d_allocator;
-#elif defined(RTMULTI)
+#elif defined(CTFIXED) || defined(CTBITMAP)
+    ListPool<int>::pool d_allocator;
+#elif defined(RTMULTI) || defined(BTMULTI)
     BloombergLP::bdlma::MultipoolAllocator d_allocator;
 #elif defined(RTMULTIMONO)
     BloombergLP::bdlma::BufferedSequentialAllocator d_backing;
@@ -59,10 +90,10 @@ class Subsystem {
   public:
     Subsystem(int initialLength)
         // Create a subsystem having the specified 'initialLength'.
-#if defined CTMULTI
+#if defined(CTMULTI) || defined(CTFIXED) || defined(CTBITMAP)
     : d_allocator()
     , d_data(&d_allocator)
-#elif defined(RTMULTI)
+#elif defined(RTMULTI) || defined(BTMULTI)
     : d_allocator()
     , d_data(&d_allocator)
 #elif defined(RTMULTIMONO)
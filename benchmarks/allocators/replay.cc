@@ -0,0 +1,347 @@
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+#include <bdlma_bufferedsequentialpool.h>
+#include <bdlma_multipool.h>
+#include <bdlma_multipoolallocator.h>
+#include <bdlma_tracingallocator.h>
+#include <bslma_allocator.h>
+
+#include "allocont.h"
+
+// Replay a trace captured by 'bdlma::TracingAllocator' against each of the
+// allocation strategies of 'allocont.h' ('stdalloc', 'monotonic', 'multipool',
+// and 'poly' over a multipool), and report for each the running time, the
+// peak number of bytes obtained from the system, and the fragmentation, i.e.,
+// the fraction of the peak footprint not accounted for by the peak number of
+// bytes requested and still live.
+//
+// Each request is made through the strategy's 'allocator<char>', i.e., the
+// very allocator type that its containers use, supplied by the same mechanism
+// as in the other benchmarks; only the upstream allocator of the mechanism
+// (which measures the footprint) is specific to this benchmark.
+//
+// The trace is loaded before replaying, and each address is mapped to a slot
+// in a vector of live blocks, so that the time reported excludes reading the
+// trace and looking up addresses.  Events are replayed in a single thread, in
+// the order in which they were recorded, whatever thread recorded them.  Each
+// strategy is run in a separate process, so that it starts with a fresh heap.
+
+#define ITER 3
+
+struct Operation {
+    int64_t d_slot;      // index of the block in the vector of live blocks
+    size_t  d_size;      // bytes of the block
+    bool    d_allocate;  // 'true' to allocate the block, 'false' to free it
+};
+
+std::vector<Operation> operations;
+int64_t                numSlots;
+int64_t                numAllocations;
+int64_t                peakLive;
+
+inline size_t usableSize(void *address) {
+#if defined(__APPLE__)
+    return malloc_size(address);
+#else
+    return malloc_usable_size(address);
+#endif
+}
+
+alignas(long long) static char buffer[4096];  // initial monotonic buffer
+
+struct measuredStdAllocator {
+    // Allocate as 'stdalloc::allocator<char>' does, and measure the bytes held
+    // by the heap for the blocks in use, which (on platforms where 'operator
+    // new' calls 'malloc') includes the rounding of each block by 'malloc',
+    // but not its header.
+    stdalloc::allocator<char> d_imp;
+    int64_t                   d_inUse;
+    int64_t                   d_peak;
+
+    measuredStdAllocator() : d_inUse(0), d_peak(0) {}
+
+    char *allocate(size_t s) {
+        char *p = d_imp.allocate(s);
+        d_inUse += usableSize(p);
+        if (d_inUse > d_peak) {
+            d_peak = d_inUse;
+        }
+        return p;
+    }
+    void deallocate(char *p, size_t s) {
+        d_inUse -= usableSize(p);
+        d_imp.deallocate(p, s);
+    }
+};
+
+class PeakAllocator : public bslma::Allocator {
+    // Allocate from 'malloc', and measure the bytes held by the heap for the
+    // blocks in use, as 'measuredDirectAllocator' does.
+    int64_t d_inUse;
+    int64_t d_peak;
+
+  public:
+    PeakAllocator() : d_inUse(0), d_peak(0) {}
+
+    void *allocate(size_type s) {
+        void *p = malloc(s);
+        d_inUse += usableSize(p);
+        if (d_inUse > d_peak) {
+            d_peak = d_inUse;
+        }
+        return p;
+    }
+    void deallocate(void *p) {
+        if (p) {
+            d_inUse -= usableSize(p);
+            free(p);
+        }
+    }
+
+    int64_t peak() const { return d_peak; }
+};
+
+bool load(const char *path) {
+    bdlma::TracingAllocatorReader reader(path);
+    if (!reader.isValid()) {
+        return false;
+    }
+
+    std::unordered_map<bsls::Types::UintPtr, int64_t> slots;
+    std::unordered_map<int64_t, size_t>               sizes;
+    std::vector<int64_t>                              freeSlots;
+    int64_t                                           live = 0;
+
+    bdlma::TracingAllocator::Event event;
+    int rc;
+    while (0 == (rc = reader.readEvent(&event))) {
+        Operation op;
+        if (bdlma::TracingAllocator::e_ALLOCATE == event.d_type) {
+            // Skip empty requests, which no strategy satisfies with a block.
+
+            if (0 == event.d_size) {
+                continue;
+            }
+            if (freeSlots.empty()) {
+                op.d_slot = numSlots++;
+            }
+            else {
+                op.d_slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            op.d_size = event.d_size;
+            op.d_allocate = true;
+            slots[event.d_address] = op.d_slot;
+            sizes[op.d_slot] = op.d_size;
+            ++numAllocations;
+            live += op.d_size;
+            if (live > peakLive) {
+                peakLive = live;
+            }
+        }
+        else {
+            // Skip deallocations of blocks allocated before the trace began.
+
+            auto it = slots.find(event.d_address);
+            if (it == slots.end()) {
+                continue;
+            }
+            op.d_slot = it->second;
+            op.d_size = sizes[op.d_slot];
+            op.d_allocate = false;
+            slots.erase(it);
+            freeSlots.push_back(op.d_slot);
+            live -= op.d_size;
+        }
+        operations.push_back(op);
+    }
+    return 1 == rc;
+}
+
+template <class ALLOC>
+double replayOnce(ALLOC& allocator) {
+    // Replay the trace through the specified 'allocator', an allocator of
+    // 'char' (e.g., 'monotonic::allocator<char>'), and return the time taken.
+    timespec start;
+    timespec stop;
+
+    std::vector<char *> active(numSlots, static_cast<char *>(0));
+    std::vector<size_t> sizes(numSlots, 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (const Operation& op : operations) {
+        if (op.d_allocate) {
+            active[op.d_slot] = allocator.allocate(op.d_size);
+            ++(*active[op.d_slot]);
+        }
+        else {
+            allocator.deallocate(active[op.d_slot], op.d_size);
+            active[op.d_slot] = 0;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    // Blocks still live at the end of the trace are released untimed.  Their
+    // sizes are those of the last allocation of each slot.
+
+    for (const Operation& op : operations) {
+        if (op.d_allocate) {
+            sizes[op.d_slot] = op.d_size;
+        }
+    }
+    for (int64_t slot = 0; slot < numSlots; ++slot) {
+        if (active[slot]) {
+            allocator.deallocate(active[slot], sizes[slot]);
+        }
+    }
+
+    int64_t rv = static_cast<int64_t>(stop.tv_sec - start.tv_sec) * 1000000000LL
+                    + (stop.tv_nsec - start.tv_nsec);
+    return (static_cast<double>(rv) / 1000000000.0L);
+}
+
+struct Result {
+    double  d_time;       // best time of 'ITER' replays, in seconds
+    int64_t d_footprint;  // peak bytes held by the heap
+};
+
+template <class FUNC>
+Result replayWith(FUNC replay) {
+    // Call the specified 'replay', which replays the trace against a strategy
+    // whose mechanism obtains its memory from the 'bslma::Allocator *' passed
+    // to it, 'ITER' times, each with a fresh 'PeakAllocator', and return the
+    // best time and the footprint.
+    Result result = { -1.0, 0 };
+    for (int i = 0; i < ITER; ++i) {
+        PeakAllocator upstream;
+        double        rv = replay(&upstream);
+        if (result.d_time < 0 || rv < result.d_time) {
+            result.d_time = rv;
+        }
+        result.d_footprint = upstream.peak();
+    }
+    return result;
+}
+
+Result replayStd() {
+    // Replay the trace against 'stdalloc::allocator<char>', i.e., 'operator
+    // new' and 'operator delete', and then replay it once more to measure the
+    // footprint, which would otherwise add to the time of every request.
+    Result result = { -1.0, 0 };
+    for (int i = 0; i < ITER; ++i) {
+        stdalloc::allocator<char> allocator;
+        double                    rv = replayOnce(allocator);
+        if (result.d_time < 0 || rv < result.d_time) {
+            result.d_time = rv;
+        }
+    }
+    measuredStdAllocator allocator;
+    replayOnce(allocator);
+    result.d_footprint = allocator.d_peak;
+    return result;
+}
+
+template <class FUNC>
+Result childTest(FUNC test) {
+    int fd[2];
+    if (-1 == pipe(fd)) {
+        printf("could not open pipe\n");
+        exit(0);
+    }
+    pid_t pid = fork();
+    if (0 == pid) {
+        Result rv = test();
+        write(fd[1], &rv, sizeof rv);
+        close(fd[0]);
+        close(fd[1]);
+        exit(0);
+    }
+    int status;
+    wait(&status);
+    Result rv = { -1.0, 0 };
+    if (WIFEXITED(status)) {
+        read(fd[0], &rv, sizeof rv);
+    }
+    close(fd[0]);
+    close(fd[1]);
+    return rv;
+}
+
+void report(const char *name, const Result& rv) {
+    if (rv.d_time == -1.0) {
+        printf("%s,fail\n", name);
+    }
+    else {
+        printf("%s,%0.3lfs,%lld,%0.1lf\n",
+               name,
+               rv.d_time,
+               static_cast<long long>(rv.d_footprint),
+               rv.d_footprint ? 100.0 - 100.0 * peakLive / rv.d_footprint
+                              : 0.0);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        printf("usage: %s trace-file\n", argv[0]);
+        return 1;
+    }
+
+    if (!load(argv[1])) {
+        printf("could not read trace '%s'\n", argv[1]);
+        return 1;
+    }
+
+    // First, the trace: number of replayed events and allocations, and the
+    // peak bytes requested and still live.  Then, for each strategy: time,
+    // peak footprint in bytes, and fragmentation as a percentage.
+
+    printf("trace,%lld,%lld,%lld\n",
+           static_cast<long long>(operations.size()),
+           static_cast<long long>(numAllocations),
+           static_cast<long long>(peakLive));
+    fflush(stdout);
+
+    // The initial monotonic buffer is not counted in the footprint.
+
+    report("newdelete", childTest(replayStd));
+    report("monotonic", childTest([]() {
+        return replayWith([](bslma::Allocator *upstream) {
+            bdlma::BufferedSequentialPool bsp(buffer, sizeof buffer, upstream);
+            monotonic::allocator<char>    allocator(&bsp);
+            return replayOnce(allocator);
+        });
+    }));
+    report("multipool", childTest([]() {
+        return replayWith([](bslma::Allocator *upstream) {
+            bdlma::Multipool           mp(upstream);
+            multipool::allocator<char> allocator(&mp);
+            return replayOnce(allocator);
+        });
+    }));
+    report("poly", childTest([]() {
+        return replayWith([](bslma::Allocator *upstream) {
+            bdlma::MultipoolAllocator mpa(upstream);
+            poly::allocator<char>     allocator(&mpa);
+            return replayOnce(allocator);
+        });
+    }));
+    return 0;
+}
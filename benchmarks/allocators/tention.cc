@@ -10,6 +10,7 @@
 #include <string>
 #include <bdlma_sequentialallocator.h>
 #include <bdlma_multipoolallocator.h>
+#include <bdlma_threadcachingmultipool.h>
 #include <bslma_newdeleteallocator.h>
 #include <bsl_vector.h>
 
@@ -109,6 +110,34 @@ void *f13(void *arg) {
     return 0;
 }
 
+// The following cases share one allocator among all threads.
+
+pthread_mutex_t                sharedLock = PTHREAD_MUTEX_INITIALIZER;
+bdlma::Multipool              *sharedMultipool;
+bdlma::ThreadCachingMultipool *sharedCachingMultipool;
+
+void *fsm(void *arg) {
+    for (int i = 0; i < N; ++i) {
+        pthread_mutex_lock(&sharedLock);
+        char *p = static_cast<char *>(sharedMultipool->allocate(S));
+        pthread_mutex_unlock(&sharedLock);
+        ++(*p);
+        pthread_mutex_lock(&sharedLock);
+        sharedMultipool->deallocate(p);
+        pthread_mutex_unlock(&sharedLock);
+    }
+    return 0;
+}
+
+void *ftc(void *arg) {
+    for (int i = 0; i < N; ++i) {
+        char *p = static_cast<char *>(sharedCachingMultipool->allocate(S));
+        ++(*p);
+        sharedCachingMultipool->deallocate(p);
+    }
+    return 0;
+}
+
 double testOnce(void *(*f)(void *)) {
     timespec start;
     timespec stop;
@@ -177,7 +206,8 @@ int main(int argc, char *argv[]) {
     S = argc > 2 ? atoi(argv[2]) : 1;
     W = argc > 3 ? atoi(argv[3]) : 1;
 
-    // allocator index: 1, 2, 3, 5, 7, 9, 11, 13
+    // allocator index: 1, 2, 3, 5, 7, 9, 11, 13, then the shared mutex-guarded
+    // multipool (SM) and the shared thread-caching multipool (TC)
 
     printf("%i,%i,%i", N, S, W);
 
@@ -212,6 +242,20 @@ int main(int argc, char *argv[]) {
     rv = test(f13);
     printf(",%0.0lf", 100.0 * rv / firstRV);
 
+    {
+        bdlma::Multipool allocator;
+        sharedMultipool = &allocator;
+        rv = test(fsm);
+        printf(",%0.0lf", 100.0 * rv / firstRV);
+    }
+
+    {
+        bdlma::ThreadCachingMultipool allocator;
+        sharedCachingMultipool = &allocator;
+        rv = test(ftc);
+        printf(",%0.0lf", 100.0 * rv / firstRV);
+    }
+
     printf("\n");
     return 0;
 }
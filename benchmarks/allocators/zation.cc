@@ -8,9 +8,11 @@
 
 #include <algorithm>
 #include <iostream>
+#include <string>
 #include <bdlma_sequentialallocator.h>
 #include <bdlma_multipoolallocator.h>
 #include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
 #include <bsl_vector.h>
 
 using namespace BloombergLP;
@@ -204,7 +206,68 @@ double childTest() {
     return rv;
 }
 
+// Utilization of a bdlma::Multipool: the bytes requested by the live blocks
+// as a percentage of the peak bytes it obtained from its upstream allocator,
+// for power-of-two, quarter-power-of-two, and adaptive size classes, with
+// all three covering blocks of up to 4096 bytes.
+
+double utilizationOnce(int numPools,
+                       bdlma::Multipool::SizeClassSpacing spacing,
+                       const int *sizes, int numSizes, int64_t count) {
+    bslma::TestAllocator upstream;
+    int64_t requested = 0;
+    {
+        bdlma::Multipool pool(numPools, spacing, &upstream);
+        for (int64_t i = 0; i < count; ++i) {
+            int size = sizes[i % numSizes];
+            ++(*static_cast<char *>(pool.allocate(size)));
+            requested += size;
+        }
+    }
+    return 100.0 * requested / upstream.numBytesMax();
+}
+
+void utilization(const int *sizes, int numSizes) {
+    const int64_t count = 1LL << 16;
+
+    printf("%i", sizes[0]);
+    for (int i = 1; i < numSizes; ++i) {
+        printf("+%i", sizes[i]);
+    }
+    printf(",%0.1lf%%,%0.1lf%%,%0.1lf%%\n",
+           utilizationOnce(10, bdlma::Multipool::e_POWER_OF_TWO,
+                           sizes, numSizes, count),
+           utilizationOnce(32, bdlma::Multipool::e_QUARTER_POWER_OF_TWO,
+                           sizes, numSizes, count),
+           utilizationOnce(10, bdlma::Multipool::e_ADAPTIVE,
+                           sizes, numSizes, count));
+}
+
+int reportUtilization(int argc, char *argv[]) {
+    printf("SIZE,POW2,QUARTER,ADAPTIVE\n");
+
+    if (argc > 2) {
+        for (int i = 2; i < argc; ++i) {
+            int size = atoi(argv[i]);
+            utilization(&size, 1);
+        }
+        return 0;
+    }
+
+    static const int sizes[] = { 33, 72, 100, 200, 520, 1100, 3000 };
+    const int numSizes = sizeof sizes / sizeof *sizes;
+    for (int i = 0; i < numSizes; ++i) {
+        utilization(sizes + i, 1);
+    }
+    utilization(sizes, numSizes);
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "-u") {
+        return reportUtilization(argc, argv);
+    }
+
     int totalSize = argc > 1 ? atoi(argv[1]) : 10;
     int activeSize = argc > 2 ? atoi(argv[2]) : 6;
     int blockSize = argc > 3 ? atoi(argv[3]) : 4;
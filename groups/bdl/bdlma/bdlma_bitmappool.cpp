@@ -0,0 +1,307 @@
+// bdlma_bitmappool.cpp                                               -*-C++-*-
+#include <bdlma_bitmappool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_bitmappool_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+namespace {
+
+// CONSTANTS
+enum {
+    k_INITIAL_CHUNK_SIZE =  1,  // default number of blocks per chunk
+
+    k_GROWTH_FACTOR      =  2,  // multiplicative factor by which to grow pool
+                                // capacity
+
+    k_MAX_CHUNK_SIZE     = 32   // maximum number of blocks per chunk
+};
+
+// LOCAL FUNCTIONS
+static inline
+int roundUp(int x, int y)
+    // Round up the specified 'x' to the nearest whole integer multiple of the
+    // specified 'y'.  The behavior is undefined unless '0 <= x' and '1 <= y'.
+{
+    BSLS_ASSERT(0 <= x);
+    BSLS_ASSERT(1 <= y);
+
+    return (x + y - 1) / y * y;
+}
+
+struct ChunkAddressLess {
+    // This 'struct' provides a comparator ordering an address before the
+    // chunks located after it, for 'bsl::upper_bound'.
+
+    template <class CHUNK>
+    bool operator()(const char *address, const CHUNK *chunk) const
+        // Return 'true' if the specified 'address' precedes the specified
+        // 'chunk' in memory, and 'false' otherwise.
+    {
+        return reinterpret_cast<bsls::Types::UintPtr>(address)
+             < reinterpret_cast<bsls::Types::UintPtr>(chunk);
+    }
+
+    template <class CHUNK>
+    bool operator()(const CHUNK *lhs, const CHUNK *rhs) const
+        // Return 'true' if the specified 'lhs' chunk precedes the specified
+        // 'rhs' chunk in memory, and 'false' otherwise.
+    {
+        return reinterpret_cast<bsls::Types::UintPtr>(lhs)
+             < reinterpret_cast<bsls::Types::UintPtr>(rhs);
+    }
+};
+
+}  // close unnamed namespace
+
+                           // ----------------
+                           // class BitmapPool
+                           // ----------------
+
+// PRIVATE MANIPULATORS
+void BitmapPool::addChunk(int numBlocks)
+{
+    BSLS_ASSERT(1 <= numBlocks);
+
+    // The bitmap follows the header, and the (maximally-aligned) blocks
+    // follow the bitmap.
+
+    const int wordSize   = static_cast<int>(sizeof(Word));
+    const int numWords   = (numBlocks + k_BITS_PER_WORD - 1) / k_BITS_PER_WORD;
+    const int mapOffset  = roundUp(static_cast<int>(sizeof(Chunk)), wordSize);
+    const int headerSize = roundUp(mapOffset + numWords * wordSize,
+                                   bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT);
+
+    // Reserve the slot of the chunk in 'd_chunks' first, so that no memory is
+    // leaked if doing so throws.
+
+    d_chunks.reserve(d_chunks.size() + 1);
+
+    char *memory = static_cast<char *>(d_blockList.allocate(
+                                headerSize + numBlocks * d_internalBlockSize));
+
+    Chunk *chunk = reinterpret_cast<Chunk *>(memory);
+    chunk->d_blocks_p      = memory + headerSize;
+    chunk->d_freeMap_p     = reinterpret_cast<Word *>(memory + mapOffset);
+    chunk->d_numBlocks     = numBlocks;
+    chunk->d_numFreeBlocks = numBlocks;
+
+    for (int i = 0; i < numWords; ++i) {
+        chunk->d_freeMap_p[i] = ~static_cast<Word>(0);
+    }
+    if (numBlocks % k_BITS_PER_WORD) {
+        const int numBits = numBlocks % k_BITS_PER_WORD;
+
+        chunk->d_freeMap_p[numWords - 1] =
+                                        (static_cast<Word>(1) << numBits) - 1;
+    }
+
+    const int index = static_cast<int>(
+                   bsl::upper_bound(d_chunks.begin(),
+                                    d_chunks.end(),
+                                    chunk,
+                                    ChunkAddressLess()) - d_chunks.begin());
+    d_chunks.insert(d_chunks.begin() + index, chunk);
+
+    // The chunks following 'd_firstFreeChunk' are shifted by the insertion.
+
+    if (index <= d_firstFreeChunk) {
+        d_firstFreeChunk = index;
+    }
+
+    d_numFreeBlocks += numBlocks;
+}
+
+void BitmapPool::replenish()
+{
+    addChunk(d_chunkSize);
+
+    if (bsls::BlockGrowth::BSLS_GEOMETRIC == d_growthStrategy
+     && d_chunkSize < d_maxBlocksPerChunk) {
+
+        if (d_chunkSize * k_GROWTH_FACTOR <= d_maxBlocksPerChunk) {
+            d_chunkSize *= k_GROWTH_FACTOR;
+        }
+        else {
+            d_chunkSize = d_maxBlocksPerChunk;
+        }
+    }
+}
+
+// CREATORS
+BitmapPool::BitmapPool(int blockSize, bslma::Allocator *basicAllocator)
+: d_blockSize(blockSize)
+, d_chunkSize(k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(k_MAX_CHUNK_SIZE)
+, d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
+, d_numFreeBlocks(0)
+, d_firstFreeChunk(0)
+, d_chunks(bslma::Default::allocator(basicAllocator))
+, d_blockList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= blockSize);
+
+    d_internalBlockSize = roundUp(
+                   blockSize,
+                   bsls::AlignmentUtil::calculateAlignmentFromSize(blockSize));
+}
+
+BitmapPool::BitmapPool(int                          blockSize,
+                       bsls::BlockGrowth::Strategy  growthStrategy,
+                       bslma::Allocator            *basicAllocator)
+: d_blockSize(blockSize)
+, d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
+              ? k_MAX_CHUNK_SIZE
+              : k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(k_MAX_CHUNK_SIZE)
+, d_growthStrategy(growthStrategy)
+, d_numFreeBlocks(0)
+, d_firstFreeChunk(0)
+, d_chunks(bslma::Default::allocator(basicAllocator))
+, d_blockList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= blockSize);
+
+    d_internalBlockSize = roundUp(
+                   blockSize,
+                   bsls::AlignmentUtil::calculateAlignmentFromSize(blockSize));
+}
+
+BitmapPool::BitmapPool(int                          blockSize,
+                       bsls::BlockGrowth::Strategy  growthStrategy,
+                       int                          maxBlocksPerChunk,
+                       bslma::Allocator            *basicAllocator)
+: d_blockSize(blockSize)
+, d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
+              ? maxBlocksPerChunk
+              : k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(maxBlocksPerChunk)
+, d_growthStrategy(growthStrategy)
+, d_numFreeBlocks(0)
+, d_firstFreeChunk(0)
+, d_chunks(bslma::Default::allocator(basicAllocator))
+, d_blockList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= blockSize);
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+
+    d_internalBlockSize = roundUp(
+                   blockSize,
+                   bsls::AlignmentUtil::calculateAlignmentFromSize(blockSize));
+}
+
+BitmapPool::~BitmapPool()
+{
+    BSLS_ASSERT(d_blockSize <= d_internalBlockSize);
+    BSLS_ASSERT(0 < d_chunkSize);
+}
+
+// MANIPULATORS
+void BitmapPool::deallocate(void *address)
+{
+    BSLS_ASSERT(address);
+
+    const char *block = static_cast<const char *>(address);
+
+    // Find the last chunk starting at or before 'block'.
+
+    bsl::vector<Chunk *>::iterator it = bsl::upper_bound(d_chunks.begin(),
+                                                         d_chunks.end(),
+                                                         block,
+                                                         ChunkAddressLess());
+    BSLS_ASSERT(it != d_chunks.begin());
+
+    Chunk *chunk = *--it;
+
+    const int offset = static_cast<int>(block - chunk->d_blocks_p);
+    const int index  = offset / d_internalBlockSize;
+
+    BSLS_ASSERT(0     <= offset);
+    BSLS_ASSERT(index <  chunk->d_numBlocks);
+    BSLS_ASSERT_SAFE(0 == offset % d_internalBlockSize);
+
+    Word&      word = chunk->d_freeMap_p[index / k_BITS_PER_WORD];
+    const Word bit  = static_cast<Word>(1) << index % k_BITS_PER_WORD;
+
+    BSLS_ASSERT_SAFE(0 == (word & bit));
+
+    word |= bit;
+    ++chunk->d_numFreeBlocks;
+    ++d_numFreeBlocks;
+
+    const int chunkIndex = static_cast<int>(it - d_chunks.begin());
+    if (chunkIndex < d_firstFreeChunk) {
+        d_firstFreeChunk = chunkIndex;
+    }
+}
+
+void BitmapPool::release()
+{
+    d_blockList.release();
+    d_chunks.clear();
+    d_numFreeBlocks  = 0;
+    d_firstFreeChunk = 0;
+}
+
+void BitmapPool::reserveCapacity(int numBlocks)
+{
+    BSLS_ASSERT(0 <= numBlocks);
+
+    if (numBlocks > d_numFreeBlocks) {
+        addChunk(numBlocks - d_numFreeBlocks);
+    }
+}
+
+int BitmapPool::trim()
+{
+    int numReleased = 0;
+
+    bsl::vector<Chunk *>::iterator out = d_chunks.begin();
+    for (bsl::vector<Chunk *>::iterator it = d_chunks.begin();
+         it != d_chunks.end();
+         ++it) {
+        Chunk *chunk = *it;
+
+        if (chunk->d_numFreeBlocks == chunk->d_numBlocks) {
+            d_numFreeBlocks -= chunk->d_numBlocks;
+            d_blockList.deallocate(chunk);
+            ++numReleased;
+        }
+        else {
+            *out++ = chunk;
+        }
+    }
+    d_chunks.erase(out, d_chunks.end());
+
+    d_firstFreeChunk = 0;
+
+    return numReleased;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,409 @@
+// bdlma_bitmappool.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLMA_BITMAPPOOL
+#define INCLUDED_BDLMA_BITMAPPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a pool of uniform blocks tracking free blocks in bitmaps.
+//
+//@CLASSES:
+//  bdlma::BitmapPool: pool dispensing the lowest free block of uniform size
+//
+//@SEE_ALSO: bdlma_pool
+//
+//@DESCRIPTION: This component implements a memory pool, 'bdlma::BitmapPool',
+// that allocates and manages memory blocks of some uniform size specified at
+// construction.  Like a 'bdlma::Pool', a 'bdlma::BitmapPool' obtains large,
+// contiguous "chunks" of memory from its basic allocator and splits them into
+// blocks, with the size of the chunks governed by a growth strategy and a
+// maximum number of blocks per chunk.  Unlike a 'bdlma::Pool', which threads
+// a linked list through its free blocks, a 'bdlma::BitmapPool' records which
+// blocks of each chunk are free in a bitmap kept in a header at the start of
+// the chunk:
+//..
+//     +-------+---+---+---+---+-----+---+
+//     |header |   |   |   |   | ... |   |
+//     +-------+---+---+---+---+-----+---+
+//       |      \______________ ________/
+//       |                     V
+//       |       blocks of uniform size
+//       V
+//   address of the first block, and one bit per block: 1 if free
+//..
+// This has two consequences:
+//
+//: o 'allocate' always dispenses the free block having the lowest address (by
+//:   scanning for the first nonzero bitmap word of the lowest chunk having a
+//:   free block, and the lowest set bit of that word), so that however much
+//:   allocation and deallocation has taken place, the blocks that are in use
+//:   stay packed toward the low addresses of the pool, and blocks allocated
+//:   in succession are adjacent whenever possible.  By contrast, after much
+//:   churn, the free list of a 'bdlma::Pool' dispenses blocks in an order
+//:   unrelated to their addresses, and so scatters the nodes of a container
+//:   across memory.
+//:
+//: o 'deallocate' does not access the block being deallocated, only the
+//:   header of its chunk, a single word of which covers 64 blocks.  Also,
+//:   blocks need not be large enough to hold a pointer.
+//
+// In exchange, 'deallocate' must find the chunk of a block, which takes time
+// logarithmic in the number of chunks of the pool, and 'allocate' may skip
+// over the (full) words of a bitmap; both are constant time for a pool having
+// a single chunk.  Note that, because 'allocate' prefers the lowest address,
+// the chunks at the highest addresses tend to become entirely free, which
+// 'trim' returns to the basic allocator.
+//
+// The blocks dispensed by a 'bdlma::BitmapPool' are naturally aligned for an
+// object of the block size, i.e., aligned to the largest power of two
+// dividing the block size, up to 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT',
+// and are spaced by the block size rounded up to a multiple of that
+// alignment.
+//
+///Configuration at Construction
+///-----------------------------
+// When creating a 'bdlma::BitmapPool', clients can optionally configure the
+// GROWTH STRATEGY, MAX BLOCKS PER CHUNK, and BASIC ALLOCATOR, with the same
+// meanings and defaults as for 'bdlma::Pool' (see 'bdlma_pool').
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Keeping the Nodes of a List in Address Order
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a long-lived queue of events is implemented as a linked list,
+// and that it is traversed often.  If its nodes come from a 'bdlma::Pool',
+// the removal and insertion of nodes over time leaves consecutive nodes at
+// unrelated addresses; if they come from a 'bdlma::BitmapPool', each new node
+// takes the lowest free address.
+//
+// First, we create a pool for blocks the size of a node, allocating chunks of
+// a constant number of blocks:
+//..
+//  struct Node {
+//      Node *d_next_p;  // next node, or 0
+//      int   d_value;   // value of this node
+//  };
+//
+//  bslma::TestAllocator ta;
+//  bdlma::BitmapPool    pool(sizeof(Node),
+//                            bsls::BlockGrowth::BSLS_CONSTANT,
+//                            &ta);
+//..
+// Then, we allocate some nodes, which are adjacent in memory:
+//..
+//  Node *nodes[4];
+//  for (int i = 0; i < 4; ++i) {
+//      nodes[i] = static_cast<Node *>(pool.allocate());
+//  }
+//  assert(nodes[1] == nodes[0] + 1);
+//  assert(nodes[2] == nodes[1] + 1);
+//..
+// Next, we deallocate two of the nodes, the higher first:
+//..
+//  pool.deallocate(nodes[2]);
+//  pool.deallocate(nodes[1]);
+//..
+// Finally, we observe that the next allocations dispense the lowest free
+// addresses, in address order, rather than the most recently freed one:
+//..
+//  assert(nodes[1] == pool.allocate());
+//  assert(nodes[2] == pool.allocate());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BLOCKGROWTH
+#include <bsls_blockgrowth.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                           // ================
+                           // class BitmapPool
+                           // ================
+
+class BitmapPool {
+    // This class implements a memory pool that allocates and manages memory
+    // blocks of some uniform size specified at construction.  This memory pool
+    // records the free blocks of each of its chunks in a bitmap, and
+    // dispenses the free block having the lowest address for each 'allocate'
+    // method invocation.  When a memory block is deallocated, it is marked as
+    // free in the bitmap of its chunk.
+
+    // PRIVATE TYPES
+    typedef bdlb::BitUtil::uint64_t Word;  // word of a bitmap
+
+    enum { k_BITS_PER_WORD = 64 };         // number of bits in a 'Word'
+
+    struct Chunk {
+        // This 'struct' is the header of each chunk of this pool, located at
+        // the start of the chunk, and is followed in memory by the bitmap of
+        // the chunk, and then by the blocks of the chunk.
+
+        char *d_blocks_p;       // first block of this chunk
+
+        Word *d_freeMap_p;      // bit 'i % 64' of word 'i / 64' is 1 if and
+                                // only if block 'i' is free
+
+        int   d_numBlocks;      // number of blocks in this chunk
+
+        int   d_numFreeBlocks;  // number of free blocks in this chunk
+    };
+
+    // DATA
+    int                  d_blockSize;          // size (in bytes) of each
+                                               // allocated memory block
+                                               // returned to client
+
+    int                  d_internalBlockSize;  // distance between consecutive
+                                               // blocks of a chunk
+
+    int                  d_chunkSize;          // current chunk size (in
+                                               // blocks-per-chunk)
+
+    int                  d_maxBlocksPerChunk;  // maximum chunk size (in
+                                               // blocks-per-chunk)
+
+    bsls::BlockGrowth::Strategy
+                         d_growthStrategy;     // growth strategy of the chunk
+                                               // size
+
+    int                  d_numFreeBlocks;      // number of free blocks in all
+                                               // chunks
+
+    int                  d_firstFreeChunk;     // index in 'd_chunks' before
+                                               // which no chunk has a free
+                                               // block
+
+    bsl::vector<Chunk *> d_chunks;             // chunks of this pool, in
+                                               // address order
+
+    BlockList            d_blockList;          // memory manager for allocated
+                                               // memory
+
+  private:
+    // PRIVATE MANIPULATORS
+    void addChunk(int numBlocks);
+        // Allocate a chunk of the specified 'numBlocks' free blocks, and add
+        // it to the chunks of this pool.  The behavior is undefined unless
+        // '1 <= numBlocks'.
+
+    void replenish();
+        // Dynamically allocate a new chunk using this pool's underlying growth
+        // strategy.
+
+  private:
+    // NOT IMPLEMENTED
+    BitmapPool(const BitmapPool&);
+    BitmapPool& operator=(const BitmapPool&);
+
+  public:
+    // CREATORS
+    explicit
+    BitmapPool(int                          blockSize,
+               bslma::Allocator            *basicAllocator = 0);
+    BitmapPool(int                          blockSize,
+               bsls::BlockGrowth::Strategy  growthStrategy,
+               bslma::Allocator            *basicAllocator = 0);
+    BitmapPool(int                          blockSize,
+               bsls::BlockGrowth::Strategy  growthStrategy,
+               int                          maxBlocksPerChunk,
+               bslma::Allocator            *basicAllocator = 0);
+        // Create a memory pool that returns blocks of contiguous memory of the
+        // specified 'blockSize' (in bytes) for each 'allocate' method
+        // invocation.  Optionally specify a 'growthStrategy' used to control
+        // the growth of internal memory chunks (from which memory blocks are
+        // dispensed).  If 'growthStrategy' is not specified, geometric growth
+        // is used.  Optionally specify 'maxBlocksPerChunk' as the maximum
+        // chunk size if 'growthStrategy' is specified.  If geometric growth is
+        // used, the chunk size grows starting at one block, doubling in size
+        // until it is exactly 'maxBlocksPerChunk' blocks.  If constant growth
+        // is used, the chunk size is always 'maxBlocksPerChunk' blocks.  If
+        // 'maxBlocksPerChunk' is not specified, an implementation-defined
+        // value is used.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '1 <= blockSize' and '1 <= maxBlocksPerChunk'.
+
+    ~BitmapPool();
+        // Destroy this pool, releasing all associated memory back to the
+        // underlying allocator.
+
+    // MANIPULATORS
+    void *allocate();
+        // Return the address of the free block of memory having the lowest
+        // address of this pool, replenishing the pool first if it has no free
+        // block.  The block has the fixed block size specified at
+        // construction, and is aligned as described in the component-level
+        // documentation.
+
+    void deallocate(void *address);
+        // Relinquish the memory block at the specified 'address' back to this
+        // pool object for reuse.  The behavior is undefined unless 'address'
+        // is non-zero, was allocated by this pool, and has not already been
+        // deallocated.  Note that the memory of the block is not accessed.
+
+    template <class TYPE>
+    void deleteObject(const TYPE *object);
+        // Destroy the specified 'object' based on its dynamic type and then
+        // use this pool to deallocate its memory footprint.  This method has
+        // no effect if 'object' is 0.  The behavior is undefined unless
+        // 'object', when cast appropriately to 'void *', was allocated using
+        // this pool and has not already been deallocated.  Note that
+        // 'dynamic_cast<void *>(object)' is applied if 'TYPE' is polymorphic,
+        // and 'static_cast<void *>(object)' is applied otherwise.
+
+    template <class TYPE>
+    void deleteObjectRaw(const TYPE *object);
+        // Destroy the specified 'object' and then use this pool to deallocate
+        // its memory footprint.  This method has no effect if 'object' is 0.
+        // The behavior is undefined unless 'object' is !not! a secondary base
+        // class pointer (i.e., the address is (numerically) the same as when
+        // it was originally dispensed by this pool), was allocated using this
+        // pool, and has not already been deallocated.
+
+    void release();
+        // Relinquish all memory currently allocated via this pool object.
+
+    void reserveCapacity(int numBlocks);
+        // Reserve memory from this pool to satisfy memory requests for at
+        // least the specified 'numBlocks' before the pool replenishes.  The
+        // behavior is undefined unless '0 <= numBlocks'.
+
+    int trim();
+        // Return to the basic allocator every chunk of this pool none of whose
+        // blocks is currently allocated, and return the number of chunks so
+        // released.
+
+    // ACCESSORS
+    int blockSize() const;
+        // Return the size (in bytes) of the memory blocks allocated from this
+        // pool object.  Note that all blocks dispensed by this pool have the
+        // same size.
+
+    int numFreeBlocks() const;
+        // Return the number of blocks that this pool can dispense before it
+        // replenishes.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                           // ----------------
+                           // class BitmapPool
+                           // ----------------
+
+// MANIPULATORS
+inline
+void *BitmapPool::allocate()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == d_numFreeBlocks)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        replenish();
+    }
+
+    Chunk *chunk = d_chunks[d_firstFreeChunk];
+    while (0 == chunk->d_numFreeBlocks) {
+        chunk = d_chunks[++d_firstFreeChunk];
+    }
+
+    Word *word = chunk->d_freeMap_p;
+    while (0 == *word) {
+        ++word;
+    }
+
+    const int index = static_cast<int>(word - chunk->d_freeMap_p)
+                                                             * k_BITS_PER_WORD
+                    + bdlb::BitUtil::numTrailingUnsetBits(*word);
+
+    *word &= *word - 1;  // clear the lowest set bit
+
+    --chunk->d_numFreeBlocks;
+    --d_numFreeBlocks;
+
+    return chunk->d_blocks_p + index * d_internalBlockSize;
+}
+
+template <class TYPE>
+inline
+void BitmapPool::deleteObject(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObject(object, this);
+}
+
+template <class TYPE>
+inline
+void BitmapPool::deleteObjectRaw(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObjectRaw(object, this);
+}
+
+// ACCESSORS
+inline
+int BitmapPool::blockSize() const
+{
+    return d_blockSize;
+}
+
+inline
+int BitmapPool::numFreeBlocks() const
+{
+    return d_numFreeBlocks;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
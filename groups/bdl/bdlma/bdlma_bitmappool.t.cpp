@@ -0,0 +1,827 @@
+// bdlma_bitmappool.t.cpp                                             -*-C++-*-
+#include <bdlma_bitmappool.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The goals of this 'bdlma::BitmapPool' test driver are to verify that: 1) the
+// 'allocate' method dispenses naturally-aligned memory blocks of the block
+// size specified at construction, always the free block having the lowest
+// address, 2) the pool replenishes according to its growth strategy and
+// maximum blocks per chunk, 3) the 'deallocate' method returns a block to the
+// pool without accessing its memory, and 4) 'trim', 'release', and the
+// destructor return memory to the basic allocator.
+//
+// The number of free blocks that a pool holds after replenishing reveals the
+// size of the chunk it allocated, and is observed with 'numFreeBlocks'.
+//-----------------------------------------------------------------------------
+// [ 2] BitmapPool(blockSize, basicAllocator = 0);
+// [ 2] BitmapPool(blockSize, gs, basicAllocator = 0);
+// [ 2] BitmapPool(blockSize, gs, mbpc, basicAllocator = 0);
+// [ 4] ~BitmapPool();
+// [ 2] void *allocate();
+// [ 3] void deallocate(address);
+// [ 5] template <class TYPE> void deleteObject(const TYPE *object);
+// [ 5] template <class TYPE> void deleteObjectRaw(const TYPE *object);
+// [ 4] void release();
+// [ 4] void reserveCapacity(numBlocks);
+// [ 4] int trim();
+// [ 2] int blockSize() const;
+// [ 2] int numFreeBlocks() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [ *] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+//-----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                               GLOBAL TYPEDEF
+//-----------------------------------------------------------------------------
+
+typedef bdlma::BitmapPool           Obj;
+typedef bsls::BlockGrowth::Strategy Strategy;
+
+static const Strategy GEO = bsls::BlockGrowth::BSLS_GEOMETRIC;
+static const Strategy CON = bsls::BlockGrowth::BSLS_CONSTANT;
+
+// ============================================================================
+//                      FILE-STATIC FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+int naturalAlignment(int size)
+    // Return the largest power of two that divides the specified 'size', or
+    // the maximum alignment if that is smaller.  The behavior is undefined
+    // unless '1 <= size'.
+{
+    int alignment = size & -size;
+    return alignment < bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+           ? alignment
+           : bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+}
+
+static
+bool isIncreasing(const bsl::vector<char *>& blocks)
+    // Return 'true' if the addresses in the specified 'blocks' are in
+    // strictly increasing order, and 'false' otherwise.
+{
+    for (bsl::size_t i = 1; i < blocks.size(); ++i) {
+        if (!(blocks[i - 1] < blocks[i])) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+//=============================================================================
+// CONCRETE OBJECTS FOR TESTING 'deleteObject'
+//-----------------------------------------------------------------------------
+
+static int my_ClassCode = 0;
+
+class my_Class1 {
+  public:
+    my_Class1()  { my_ClassCode = 1; }
+    ~my_Class1() { my_ClassCode = 2; }
+};
+
+static int leftBaseObjectCount    = 0;
+static int rightBaseObjectCount   = 0;
+static int mostDerivedObjectCount = 0;
+
+class my_LeftBase {
+    int x;
+  public:
+    my_LeftBase()             { leftBaseObjectCount = 1; }
+    virtual ~my_LeftBase()    { leftBaseObjectCount = 0; }
+};
+
+class my_RightBase {
+    int x;
+  public:
+    my_RightBase()            { rightBaseObjectCount = 1; }
+    virtual ~my_RightBase()   { rightBaseObjectCount = 0; }
+};
+
+class my_MostDerived : public my_LeftBase, public my_RightBase {
+    int x;
+  public:
+    my_MostDerived()          { mostDerivedObjectCount = 1; }
+    ~my_MostDerived()         { mostDerivedObjectCount = 0; }
+};
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Keeping the Nodes of a List in Address Order
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a long-lived queue of events is implemented as a linked list,
+// and that it is traversed often.  If its nodes come from a 'bdlma::Pool',
+// the removal and insertion of nodes over time leaves consecutive nodes at
+// unrelated addresses; if they come from a 'bdlma::BitmapPool', each new node
+// takes the lowest free address.
+//
+// First, we create a pool for blocks the size of a node, allocating chunks of
+// a constant number of blocks:
+//..
+    struct Node {
+        Node *d_next_p;  // next node, or 0
+        int   d_value;   // value of this node
+    };
+
+    bslma::TestAllocator ta;
+    bdlma::BitmapPool    pool(sizeof(Node),
+                              bsls::BlockGrowth::BSLS_CONSTANT,
+                              &ta);
+//..
+// Then, we allocate some nodes, which are adjacent in memory:
+//..
+    Node *nodes[4];
+    for (int i = 0; i < 4; ++i) {
+        nodes[i] = static_cast<Node *>(pool.allocate());
+    }
+    ASSERT(nodes[1] == nodes[0] + 1);
+    ASSERT(nodes[2] == nodes[1] + 1);
+//..
+// Next, we deallocate two of the nodes, the higher first:
+//..
+    pool.deallocate(nodes[2]);
+    pool.deallocate(nodes[1]);
+//..
+// Finally, we observe that the next allocations dispense the lowest free
+// addresses, in address order, rather than the most recently freed one:
+//..
+    ASSERT(nodes[1] == pool.allocate());
+    ASSERT(nodes[2] == pool.allocate());
+//..
+
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'deleteObject' AND 'deleteObjectRaw'
+        //
+        // Concerns:
+        //: 1 'deleteObject' and 'deleteObjectRaw' invoke the destructor of the
+        //:   object and return its memory to the pool.
+        //:
+        //: 2 'deleteObject' returns the memory of an object deleted through a
+        //:   pointer to a secondary base class.
+        //:
+        //: 3 Neither method has an effect on a null pointer.
+        //
+        // Plan:
+        //: 1 Create objects in blocks of the pool, delete them by each method,
+        //:   and verify that their destructors ran and that the next block
+        //:   allocated is the block of the deleted object.  (C-1..2)
+        //:
+        //: 2 Invoke each method with a null pointer.  (C-3)
+        //
+        // Testing:
+        //   template <class TYPE> void deleteObject(const TYPE *object);
+        //   template <class TYPE> void deleteObjectRaw(const TYPE *object);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'deleteObject' AND 'deleteObjectRaw'" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        {
+            Obj mX(sizeof(my_Class1), &ta);
+
+            my_Class1 *p = new (mX.allocate()) my_Class1;
+            ASSERT(1 == my_ClassCode);
+
+            mX.deleteObjectRaw(p);
+            ASSERT(2 == my_ClassCode);
+            ASSERT(static_cast<void *>(p) == mX.allocate());
+
+            my_Class1 *q = new (mX.allocate()) my_Class1;
+            mX.deleteObject(q);
+            ASSERT(2 == my_ClassCode);
+            ASSERT(static_cast<void *>(q) == mX.allocate());
+
+            mX.deleteObject(static_cast<my_Class1 *>(0));
+            mX.deleteObjectRaw(static_cast<my_Class1 *>(0));
+        }
+
+        {
+            Obj mX(sizeof(my_MostDerived), &ta);
+
+            void           *block = mX.allocate();
+            my_MostDerived *p     = new (block) my_MostDerived;
+            ASSERT(1 == leftBaseObjectCount);
+            ASSERT(1 == rightBaseObjectCount);
+            ASSERT(1 == mostDerivedObjectCount);
+
+            my_RightBase *r = p;
+            ASSERT(static_cast<void *>(r) != block);
+
+            mX.deleteObject(r);
+            ASSERT(0 == leftBaseObjectCount);
+            ASSERT(0 == rightBaseObjectCount);
+            ASSERT(0 == mostDerivedObjectCount);
+            ASSERT(block == mX.allocate());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'reserveCapacity', 'trim', 'release', AND DTOR
+        //
+        // Concerns:
+        //: 1 'reserveCapacity' allocates a single chunk making up the
+        //:   shortfall of free blocks, if any, and does not change the growth
+        //:   of the chunks allocated when replenishing.
+        //:
+        //: 2 'trim' returns exactly the chunks all of whose blocks are free,
+        //:   and the pool remains usable, dispensing the lowest free block.
+        //:
+        //: 3 'release' and the destructor return all memory to the basic
+        //:   allocator, and the pool remains usable after 'release'.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Reserve capacity, and verify 'numFreeBlocks' and the number of
+        //:   allocations from a test allocator.  (C-1)
+        //:
+        //: 2 Allocate blocks from several chunks, free all of the blocks of
+        //:   some chunks and some of the blocks of the others, and verify the
+        //:   value returned by 'trim', 'numFreeBlocks', and the memory in use;
+        //:   then reallocate the free blocks and verify that they are
+        //:   dispensed in address order.  (C-2)
+        //:
+        //: 3 Verify the memory in use by a test allocator after 'release' and
+        //:   destruction.  (C-3)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   ~BitmapPool();
+        //   void release();
+        //   void reserveCapacity(numBlocks);
+        //   int trim();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'reserveCapacity', 'trim', 'release', AND DTOR"
+                          << endl
+                          << "=============================================="
+                          << endl;
+
+        if (verbose) cout << "\nTesting 'reserveCapacity'." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj                  mX(24, GEO, 8, &ta);  const Obj& X = mX;
+
+            mX.reserveCapacity(0);
+            ASSERT(0 == X.numFreeBlocks());
+            ASSERT(0 == ta.numBlocksInUse());
+
+            mX.reserveCapacity(100);
+            ASSERT(100 == X.numFreeBlocks());
+
+            const bsls::Types::Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+            mX.reserveCapacity(60);
+            ASSERT(100        == X.numFreeBlocks());
+            ASSERT(NUM_BLOCKS == ta.numBlocksInUse());
+
+            bsl::vector<char *> blocks;
+            for (int i = 0; i < 100; ++i) {
+                blocks.push_back(static_cast<char *>(mX.allocate()));
+            }
+            ASSERT(isIncreasing(blocks));
+            ASSERT(NUM_BLOCKS == ta.numBlocksInUse());
+
+            // Replenishing starts from a chunk of one block.
+
+            mX.allocate();
+            ASSERT(0 == X.numFreeBlocks());
+
+            mX.reserveCapacity(3);
+            ASSERT(3 == X.numFreeBlocks());
+        }
+
+        if (verbose) cout << "\nTesting 'trim'." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj                  mX(40, CON, 4, &ta);  const Obj& X = mX;
+
+            enum { NUM_CHUNKS = 6 };
+
+            ASSERT(0 == mX.trim());
+
+            bsl::vector<char *> blocks;
+            for (int i = 0; i < 4 * NUM_CHUNKS; ++i) {
+                blocks.push_back(static_cast<char *>(mX.allocate()));
+            }
+            const bsls::Types::Int64 NUM_BYTES = ta.numBytesInUse();
+
+            // Free every block of the chunks that were allocated first, and
+            // third, and one block of each of the other chunks.
+
+            int numFreed = 0;
+            for (int i = 0; i < 4 * NUM_CHUNKS; ++i) {
+                const int chunk = i / 4;
+                if (0 == chunk || 2 == chunk || 1 == i % 4) {
+                    mX.deallocate(blocks[i]);
+                    ++numFreed;
+                }
+            }
+            ASSERT(numFreed == X.numFreeBlocks());
+
+            ASSERT(2                == mX.trim());
+            ASSERT(numFreed - 8     == X.numFreeBlocks());
+            ASSERT(NUM_BYTES        >  ta.numBytesInUse());
+            ASSERT(0                == mX.trim());
+
+            bsl::vector<char *> reallocated;
+            for (int i = 0; i < numFreed - 8; ++i) {
+                reallocated.push_back(static_cast<char *>(mX.allocate()));
+                bsl::memset(reallocated.back(), 0xa5, 40);
+            }
+            ASSERT(isIncreasing(reallocated));
+            ASSERT(0 == X.numFreeBlocks());
+        }
+
+        if (verbose) cout << "\nTesting 'release' and the destructor."
+                          << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(8, &ta);  const Obj& X = mX;
+
+                for (int i = 0; i < 100; ++i) {
+                    mX.allocate();
+                }
+                mX.release();
+                ASSERT(0 == X.numFreeBlocks());
+
+                // Only the (empty) index of chunks may remain.
+
+                ASSERT(1 >= ta.numBlocksInUse());
+
+                char *p = static_cast<char *>(mX.allocate());
+                char *q = static_cast<char *>(mX.allocate());
+                ASSERT(q == p + 8);
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(8);
+
+            ASSERT_PASS(mX.reserveCapacity(0));
+            ASSERT_FAIL(mX.reserveCapacity(-1));
+        }
+
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'deallocate'
+        //
+        // Concerns:
+        //: 1 A deallocated block is dispensed again, but only once every free
+        //:   block at a lower address has been dispensed.
+        //:
+        //: 2 'deallocate' does not access the memory of the block.
+        //:
+        //: 3 Blocks of every chunk, whatever the order in which the chunks
+        //:   were allocated, are deallocated correctly.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a set of block sizes, allocate blocks spread over several
+        //:   chunks, fill them with a pattern, and deallocate a pseudo-random
+        //:   half of them in a pseudo-random order; verify that the pattern of
+        //:   each deallocated block is intact, and that 'numFreeBlocks' is the
+        //:   number of deallocated blocks.  (C-2..3)
+        //:
+        //: 2 Allocate as many blocks as were deallocated, and verify that the
+        //:   deallocated blocks are dispensed in increasing address order.
+        //:   (C-1)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void deallocate(address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'deallocate'" << endl
+                                  << "============" << endl;
+
+        const int SIZES[]   = { 1, 8, 12, 24, 64, 100 };
+        const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        // Chunks of 1, 2, 4, ..., 64, 100, and 100 blocks.
+
+        enum { NUM_BLOCKS = 327 };
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int SIZE = SIZES[ti];
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj                  mX(SIZE, GEO, 100, &ta);  const Obj& X = mX;
+
+            bsl::vector<char *> blocks;
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks.push_back(static_cast<char *>(mX.allocate()));
+                bsl::memset(blocks.back(), 0x5a, SIZE);
+            }
+            ASSERT(0 == X.numFreeBlocks());
+
+            bsl::vector<char *> freed;
+            unsigned            seed = 12345;
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                seed = seed * 1103515245 + 12345;
+                const int j = (seed >> 8) % NUM_BLOCKS;
+                if (blocks[j]) {
+                    mX.deallocate(blocks[j]);
+                    for (int k = 0; k < SIZE; ++k) {
+                        LOOP2_ASSERT(SIZE, j, 0x5a == blocks[j][k]);
+                    }
+                    freed.push_back(blocks[j]);
+                    blocks[j] = 0;
+                }
+            }
+            LOOP_ASSERT(SIZE,
+                        static_cast<int>(freed.size()) == X.numFreeBlocks());
+
+            if (veryVerbose) {
+                T_ P_(SIZE) P(freed.size())
+            }
+
+            bsl::vector<char *> reallocated;
+            for (bsl::size_t i = 0; i < freed.size(); ++i) {
+                reallocated.push_back(static_cast<char *>(mX.allocate()));
+            }
+            LOOP_ASSERT(SIZE, isIncreasing(reallocated));
+            LOOP_ASSERT(SIZE, 0 == X.numFreeBlocks());
+
+            bsl::sort(freed.begin(), freed.end());
+            LOOP_ASSERT(SIZE, freed == reallocated);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(16);
+
+            void *p = mX.allocate();
+            ASSERT_FAIL(mX.deallocate(0));
+            ASSERT_SAFE_FAIL(mX.deallocate(static_cast<char *>(p) + 1));
+            ASSERT_PASS(mX.deallocate(p));
+            ASSERT_SAFE_FAIL(mX.deallocate(p));
+        }
+
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CTOR AND 'allocate'
+        //
+        // Concerns:
+        //: 1 The block size is the one specified at construction.
+        //:
+        //: 2 The blocks are naturally aligned for the block size, and the
+        //:   blocks of a chunk are the block size (rounded up to a multiple of
+        //:   that alignment) apart.
+        //:
+        //: 3 Each chunk has as many blocks as the growth strategy and maximum
+        //:   blocks per chunk dictate, with the same defaults as for
+        //:   'bdlma::Pool'.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a set of block sizes, allocate blocks, and verify their
+        //:   alignment and distance, and the block size.  (C-1..2)
+        //:
+        //: 2 For each constructor and a set of maximum chunk sizes, allocate
+        //:   blocks, and verify after each replenishment that 'numFreeBlocks'
+        //:   is one less than the expected chunk size.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   BitmapPool(blockSize, basicAllocator = 0);
+        //   BitmapPool(blockSize, gs, basicAllocator = 0);
+        //   BitmapPool(blockSize, gs, mbpc, basicAllocator = 0);
+        //   void *allocate();
+        //   int blockSize() const;
+        //   int numFreeBlocks() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CTOR AND 'allocate'" << endl
+                                  << "===================" << endl;
+
+        if (verbose) cout << "\nTesting block size and alignment." << endl;
+        {
+            const int SIZES[]   = { 1, 2, 3, 4, 7, 8, 12, 16, 24, 33, 64,
+                                    100, 1000 };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                const int SIZE       = SIZES[ti];
+                const int EXP_ALIGN  = naturalAlignment(SIZE);
+                const int EXP_STRIDE = (SIZE + EXP_ALIGN - 1)
+                                                       / EXP_ALIGN * EXP_ALIGN;
+
+                bslma::TestAllocator ta(veryVeryVerbose);
+                Obj                  mX(SIZE, CON, 70, &ta);
+                const Obj&           X = mX;
+
+                LOOP_ASSERT(SIZE, SIZE == X.blockSize());
+
+                char *prev = static_cast<char *>(mX.allocate());
+                for (int i = 1; i < 70; ++i) {
+                    char *p = static_cast<char *>(mX.allocate());
+
+                    LOOP3_ASSERT(SIZE, i, p - prev, EXP_STRIDE == p - prev);
+                    LOOP2_ASSERT(SIZE, i,
+                                 0 == reinterpret_cast<bsls::Types::UintPtr>(p)
+                                                                 % EXP_ALIGN);
+                    bsl::memset(p, 0xff, SIZE);
+                    prev = p;
+                }
+                LOOP_ASSERT(SIZE, 0 == X.numFreeBlocks());
+            }
+        }
+
+        if (verbose) cout << "\nTesting chunk sizes." << endl;
+        {
+            const int MAX_BLOCKS[]   = { 1, 2, 5, 32, 64, 65, 200 };
+            const int NUM_MAX_BLOCKS = sizeof MAX_BLOCKS / sizeof *MAX_BLOCKS;
+
+            for (int ti = 0; ti < NUM_MAX_BLOCKS + 2; ++ti) {
+                for (int tg = 0; tg < 2; ++tg) {
+                    const Strategy STRATEGY = tg ? CON : GEO;
+
+                    bslma::TestAllocator ta(veryVeryVerbose);
+
+                    // The last two iterations use the defaults: the strategy
+                    // is geometric if unspecified, and the maximum is 32.
+
+                    Obj *mX;
+                    int  max;
+                    if (ti < NUM_MAX_BLOCKS) {
+                        max = MAX_BLOCKS[ti];
+                        mX  = new (ta) Obj(16, STRATEGY, max, &ta);
+                    }
+                    else if (ti == NUM_MAX_BLOCKS) {
+                        max = 32;
+                        mX  = new (ta) Obj(16, STRATEGY, &ta);
+                    }
+                    else {
+                        if (tg) {
+                            continue;
+                        }
+                        max = 32;
+                        mX  = new (ta) Obj(16, &ta);
+                    }
+
+                    int expChunk = CON == STRATEGY ? max : 1;
+                    for (int chunk = 0; chunk < 12; ++chunk) {
+                        mX->allocate();
+                        LOOP3_ASSERT(ti, tg, chunk,
+                                     expChunk - 1 == mX->numFreeBlocks());
+
+                        for (int i = 1; i < expChunk; ++i) {
+                            mX->allocate();
+                        }
+                        expChunk = expChunk * 2 < max ? expChunk * 2 : max;
+                    }
+
+                    ta.deleteObject(mX);
+                    LOOP2_ASSERT(ti, tg, 0 == ta.numBlocksInUse());
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj( 1));
+            ASSERT_FAIL(Obj( 0));
+            ASSERT_FAIL(Obj(-1));
+            ASSERT_PASS(Obj( 1, GEO));
+            ASSERT_FAIL(Obj( 0, GEO));
+            ASSERT_PASS(Obj( 1, GEO, 1));
+            ASSERT_FAIL(Obj( 0, GEO, 1));
+            ASSERT_FAIL(Obj( 1, GEO, 0));
+        }
+
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a pool, allocate, deallocate, and release blocks, and
+        //:   verify the memory in use by its test allocator.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        const bslma::TestAllocator& TA = ta;
+
+        {
+            Obj mX(32, CON, 4, &ta);  const Obj& X = mX;
+
+            ASSERT(32 == X.blockSize());
+            ASSERT( 0 == X.numFreeBlocks());
+            ASSERT( 0 == TA.numBlocksInUse());
+
+            char *p = static_cast<char *>(mX.allocate());
+            ASSERT(3 == X.numFreeBlocks());
+
+            char *q = static_cast<char *>(mX.allocate());
+            ASSERT(q == p + 32);
+
+            mX.deallocate(q);
+            mX.deallocate(p);
+            ASSERT(4 == X.numFreeBlocks());
+            ASSERT(p == mX.allocate());
+            ASSERT(q == mX.allocate());
+
+            ASSERT(0 == mX.trim());
+
+            mX.release();
+            ASSERT(0 == X.numFreeBlocks());
+
+            mX.allocate();
+            ASSERT(3 == X.numFreeBlocks());
+        }
+        ASSERT(0 == TA.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
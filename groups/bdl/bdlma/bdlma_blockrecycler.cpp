@@ -0,0 +1,309 @@
+// bdlma_blockrecycler.cpp                                            -*-C++-*-
+#include <bdlma_blockrecycler.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_blockrecycler_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+#include <bslma_newdeleteallocator.h>
+
+#include <bsls_bslonce.h>
+#include <bsls_objectbuffer.h>
+#include <bsls_performancehint.h>
+
+#include <bsl_new.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+namespace {
+
+// CONSTANTS
+enum {
+    k_DEFAULT_NUM_CLASSES   = 13,          // default number of size classes,
+                                           // covering blocks of up to 1 MiB
+
+    k_MAX_NUM_CLASSES       = 20,          // maximum number of size classes
+
+    k_MAGAZINE_BYTES        = 256 * 1024,  // approximate number of bytes of
+                                           // blocks held by a full magazine
+
+    k_MIN_MAGAZINE_CAPACITY =  1,          // minimum number of blocks held by
+                                           // a full magazine
+
+    k_MAX_MAGAZINE_CAPACITY = 16,          // maximum number of blocks held by
+                                           // a full magazine
+
+    k_DEPOT_MAGAZINES       =  4           // number of full magazines' worth
+                                           // of blocks held by a full depot
+};
+
+// LOCAL FUNCTIONS
+static
+int magazineCapacity(bslma::Allocator::size_type blockSize)
+    // Return the number of blocks of the specified 'blockSize' (in bytes)
+    // held by a full magazine.
+{
+    return Magazine::capacityFor(blockSize,
+                                 k_MAGAZINE_BYTES,
+                                 k_MIN_MAGAZINE_CAPACITY,
+                                 k_MAX_MAGAZINE_CAPACITY);
+}
+
+}  // close unnamed namespace
+
+                            // -------------------
+                            // class BlockRecycler
+                            // -------------------
+
+// PRIVATE CLASS METHODS
+void BlockRecycler::flushMagazines(void *recycler, Magazine *magazines)
+{
+    BSLS_ASSERT(recycler);
+    BSLS_ASSERT(magazines);
+
+    BlockRecycler *owner = static_cast<BlockRecycler *>(recycler);
+
+    for (int i = 0; i < owner->d_numClasses; ++i) {
+        owner->stashBlocks(&magazines[i], i, magazines[i].numBlocks());
+    }
+}
+
+// PRIVATE MANIPULATORS
+void BlockRecycler::drain(Magazine *magazine, int classIdx)
+{
+    BSLS_ASSERT(magazine);
+    BSLS_ASSERT(0 <= classIdx);
+    BSLS_ASSERT(classIdx < d_numClasses);
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    stashBlocks(magazine, classIdx, magazine->batchSize());
+}
+
+void BlockRecycler::initialize()
+{
+    BSLS_ASSERT(1 <= d_numClasses);
+    BSLS_ASSERT(d_numClasses <= k_MAX_NUM_CLASSES);
+
+    d_maxBlockSize = classSize(d_numClasses - 1);
+
+    d_depots_p = static_cast<Magazine *>(
+                   d_allocator_p->allocate(d_numClasses * sizeof *d_depots_p));
+
+    for (int i = 0; i < d_numClasses; ++i) {
+        const int capacity = magazineCapacity(classSize(i) + sizeof(Header));
+
+        d_magazineCache.setCapacity(i, capacity);
+        new (d_depots_p + i) Magazine(k_DEPOT_MAGAZINES * capacity);
+    }
+}
+
+void BlockRecycler::refill(Magazine *magazine, int classIdx)
+{
+    BSLS_ASSERT(magazine);
+    BSLS_ASSERT(magazine->isEmpty());
+    BSLS_ASSERT(0 <= classIdx);
+    BSLS_ASSERT(classIdx < d_numClasses);
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    Magazine& depot = d_depots_p[classIdx];
+
+    if (depot.isEmpty()) {
+        magazine->push(d_allocator_p->allocate(classSize(classIdx)
+                                                            + sizeof(Header)));
+        return;                                                       // RETURN
+    }
+
+    depot.moveBlocks(magazine, magazine->batchSize());
+}
+
+void BlockRecycler::returnBlocks(Magazine *list, int numBlocks)
+{
+    BSLS_ASSERT(list);
+    BSLS_ASSERT(0 <= numBlocks);
+
+    for (int i = 0; i < numBlocks && !list->isEmpty(); ++i) {
+        d_allocator_p->deallocate(list->pop());
+    }
+}
+
+void BlockRecycler::stashBlocks(Magazine *magazine,
+                                int       classIdx,
+                                int       numBlocks)
+{
+    BSLS_ASSERT(magazine);
+    BSLS_ASSERT(0 <= classIdx);
+    BSLS_ASSERT(classIdx < d_numClasses);
+    BSLS_ASSERT(0 <= numBlocks);
+
+    const int numStashed = magazine->moveBlocks(&d_depots_p[classIdx],
+                                                numBlocks);
+
+    // The blocks that do not fit in the depot are returned.
+
+    returnBlocks(magazine, numBlocks - numStashed);
+}
+
+// CLASS METHODS
+BlockRecycler& BlockRecycler::singleton()
+{
+    static bsls::ObjectBuffer<BlockRecycler> s_recycler;
+    static bsls::BslOnce                     s_once = BSLS_BSLONCE_INITIALIZER;
+
+    bsls::BslOnceGuard onceGuard;
+    if (onceGuard.enter(&s_once)) {
+        new (s_recycler.buffer()) BlockRecycler(
+                                      &bslma::NewDeleteAllocator::singleton());
+    }
+    return s_recycler.object();
+}
+
+// CREATORS
+BlockRecycler::BlockRecycler(bslma::Allocator *basicAllocator)
+: d_numClasses(k_DEFAULT_NUM_CLASSES)
+, d_magazineCache(d_numClasses,
+                  &flushMagazines,
+                  this,
+                  &d_lock,
+                  basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize();
+}
+
+BlockRecycler::BlockRecycler(int numClasses, bslma::Allocator *basicAllocator)
+: d_numClasses(numClasses)
+, d_magazineCache(d_numClasses,
+                  &flushMagazines,
+                  this,
+                  &d_lock,
+                  basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numClasses);
+    BSLS_ASSERT(numClasses <= k_MAX_NUM_CLASSES);
+
+    initialize();
+}
+
+BlockRecycler::~BlockRecycler()
+{
+    BSLS_ASSERT(d_depots_p);
+    BSLS_ASSERT(1 <= d_numClasses);
+    BSLS_ASSERT(d_allocator_p);
+
+    d_magazineCache.flushAll();
+
+    for (int i = 0; i < d_numClasses; ++i) {
+        returnBlocks(&d_depots_p[i], d_depots_p[i].numBlocks());
+    }
+    d_allocator_p->deallocate(d_depots_p);
+}
+
+// MANIPULATORS
+void *BlockRecycler::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return 0;                                                     // RETURN
+    }
+
+    if (size <= d_maxBlockSize) {
+        const int  classIdx = findClass(size);
+        Magazine&  magazine = d_magazineCache.threadMagazines()[classIdx];
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(magazine.isEmpty())) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            refill(&magazine, classIdx);
+        }
+
+        Header *p = static_cast<Header *>(magazine.pop());
+        p->d_header.d_classIdx = classIdx;
+        return p + 1;                                                 // RETURN
+    }
+
+    // The requested size is large and will not be recycled.
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    Header *p = static_cast<Header *>(d_allocator_p->allocate(
+                                                       size + sizeof(Header)));
+    p->d_header.d_classIdx = -1;
+    return p + 1;
+}
+
+void BlockRecycler::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return;                                                       // RETURN
+    }
+
+    Header *h = static_cast<Header *>(address) - 1;
+
+    const int classIdx = h->d_header.d_classIdx;
+
+    if (-1 == classIdx) {
+        bsls::BslLockGuard guard(&d_lock);
+
+        d_allocator_p->deallocate(h);
+        return;                                                       // RETURN
+    }
+
+    BSLS_ASSERT_SAFE(0 <= classIdx);
+    BSLS_ASSERT_SAFE(classIdx < d_numClasses);
+
+    Magazine& magazine = d_magazineCache.threadMagazines()[classIdx];
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(magazine.isFull())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        drain(&magazine, classIdx);
+    }
+
+    magazine.push(h);
+}
+
+int BlockRecycler::trim()
+{
+    Magazine *magazines = d_magazineCache.lookupThreadMagazines();
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    int numReturned = 0;
+
+    for (int i = 0; i < d_numClasses; ++i) {
+        if (magazines) {
+            numReturned += magazines[i].numBlocks();
+            returnBlocks(&magazines[i], magazines[i].numBlocks());
+        }
+        numReturned += d_depots_p[i].numBlocks();
+        returnBlocks(&d_depots_p[i], d_depots_p[i].numBlocks());
+    }
+
+    return numReturned;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
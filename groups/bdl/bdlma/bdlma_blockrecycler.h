@@ -0,0 +1,428 @@
+// bdlma_blockrecycler.h                                              -*-C++-*-
+#ifndef INCLUDED_BDLMA_BLOCKRECYCLER
+#define INCLUDED_BDLMA_BLOCKRECYCLER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-caching recycler of arena blocks for reuse.
+//
+//@CLASSES:
+//  bdlma::BlockRecycler: upstream allocator recycling freed arena blocks
+//
+//@SEE_ALSO: bdlma_blocklist, bdlma_infrequentdeleteblocklist,
+//           bdlma_magazinecache, bdlma_sequentialallocator,
+//           bdlma_threadcachingmultipool
+//
+//@DESCRIPTION: This component provides a concrete, thread-safe allocation
+// mechanism, 'bdlma::BlockRecycler', that implements the 'bslma::Allocator'
+// protocol and keeps the blocks deallocated to it in size-segregated caches,
+// from which later requests of a similar size are satisfied, instead of
+// returning them to the basic allocator supplied at construction:
+//..
+//   ,--------------------.
+//  ( bdlma::BlockRecycler )
+//   `--------------------'
+//              |         ctor/dtor
+//              |         singleton
+//              |         trim
+//              |         maxRecycledBlockSize
+//              |         numClasses
+//              V
+//      ,----------------.
+//     ( bslma::Allocator )
+//      `----------------'
+//                        allocate
+//                        deallocate
+//..
+// A 'BlockRecycler' is intended to be used as the *upstream* allocator of the
+// managed allocators and pools in 'bdlma' (e.g., 'bdlma::SequentialAllocator'
+// and 'bdlma::LocalSequentialAllocator'), which obtain their memory in large
+// blocks through a 'bdlma::BlockList' or a 'bdlma::InfrequentDeleteBlockList'
+// and return all of it at once when they are released or destroyed.  When
+// many such arenas are created and destroyed in quick succession, each would
+// otherwise obtain the same sizes of blocks from, and return them to, the
+// system allocator; with a shared 'BlockRecycler' upstream, a new arena
+// reuses memory just released by an earlier one, which is usually still
+// mapped and resident in the cache.
+//
+///Size Classes
+///------------
+// Blocks are recycled in a fixed number of size classes.  The blocks of the
+// first class have room for 'k_MIN_BLOCK_SIZE' bytes plus
+// 'k_SIZE_ALLOWANCE' bytes, and each successive class doubles the
+// power-of-two part of that capacity.  The allowance accommodates the headers
+// that block lists and pools add to the power-of-two buffer sizes they
+// usually request, so that (for example) a 4096-byte buffer obtained through
+// a 'bdlma::InfrequentDeleteBlockList' is recycled in the 4096-byte class
+// rather than the 8192-byte one.  A request is satisfied from the smallest
+// class that can hold it.  Requests larger than the capacity of the last
+// class ('maxRecycledBlockSize') are forwarded to the basic allocator, and
+// the resulting blocks are returned to it when deallocated.
+//
+///Thread Caches
+///-------------
+// Each thread that uses a 'bdlma::BlockRecycler' is given its own thread
+// cache holding one "magazine" (a short singly-linked list of free blocks)
+// per size class, in front of a shared "depot" of free blocks per class.
+// Allocation pops a block from the calling thread's magazine, and
+// deallocation pushes the block onto it; neither takes a lock unless the
+// magazine is empty (on allocation) or full (on deallocation), in which case
+// half of a magazine's worth of blocks is moved, in one batch, between the
+// magazine and the depot while holding an internal lock.  Only when the depot
+// is also empty is a block obtained from the basic allocator, and only when
+// the depot is full is a block returned to it.  Both the magazines and the
+// depot hold a bounded number of bytes per class, so the memory kept by a
+// 'BlockRecycler' is bounded.  A block may be deallocated by a thread other
+// than the one that allocated it; the block then simply becomes part of the
+// deallocating thread's cache.  The magazines and thread caches are those of
+// 'bdlma_magazinecache'.
+//
+// The free blocks cached by the calling thread, and those in the depot, can
+// be returned to the basic allocator at any time by calling 'trim'.
+//
+///The Process-Wide Recycler
+///-------------------------
+// The 'singleton' class method returns a 'BlockRecycler' that is created on
+// first use, obtains its memory from 'bslma::NewDeleteAllocator', and is
+// never destroyed, so that arenas created anywhere in a process -- including
+// during the destruction of static objects -- share the same cache of blocks.
+//
+///Thread Safety
+///-------------
+// 'allocate', 'deallocate', and 'trim' may be called concurrently from any
+// number of threads.  The basic allocator need not be thread-safe; it is only
+// ever used while holding the internal lock.
+//
+// On POSIX platforms, the blocks cached by a thread are moved to the depot
+// (or, if it is full, returned to the basic allocator) when that thread
+// exits.  On Windows, they are returned when the recycler is destroyed.  In
+// either case, the behavior is undefined if a thread that has used a
+// 'bdlma::BlockRecycler' exits while that recycler is being destroyed.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Recycling the Blocks of Short-Lived Arenas
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that each request processed by a server is given its own arena, a
+// block list from which the request's objects are carved and which is
+// released when the request completes.  We supply a shared
+// 'bdlma::BlockRecycler' to every arena, so that an arena reuses the blocks
+// released by earlier ones.
+//
+// First, we define a function that processes one request in its own arena:
+//..
+//  void processRequest(bslma::Allocator *upstream, int numBlocks)
+//      // Process a request requiring the specified 'numBlocks' arena blocks,
+//      // obtained from the specified 'upstream' allocator.
+//  {
+//      bdlma::InfrequentDeleteBlockList arena(upstream);
+//
+//      for (int i = 0; i < numBlocks; ++i) {
+//          char *block = static_cast<char *>(arena.allocate(4096));
+//          memset(block, 'x', 4096);
+//      }
+//  }   // 'arena' releases its blocks to 'upstream'
+//..
+// Then, we create a recycler obtaining its memory from a test allocator, so
+// that we can observe how often the system allocator would be called:
+//..
+//  bslma::TestAllocator ta;
+//  bdlma::BlockRecycler recycler(&ta);
+//..
+// Next, we process a first request, whose blocks all come from 'ta', and
+// note the number of allocations made from 'ta' so far:
+//..
+//  processRequest(&recycler, 4);
+//
+//  const bsls::Types::Int64 numAllocations = ta.numAllocations();
+//..
+// Now, we process many more requests.  Their blocks are all recycled from
+// the blocks released by the first request, so 'ta' is not called again:
+//..
+//  for (int i = 0; i < 100; ++i) {
+//      processRequest(&recycler, 4);
+//  }
+//  assert(numAllocations == ta.numAllocations());
+//..
+// Finally, we return the four cached blocks to 'ta':
+//..
+//  assert(4 == recycler.trim());
+//..
+// Note that an application would typically supply
+// '&bdlma::BlockRecycler::singleton()' to its arenas, for example as the
+// basic allocator of each 'bdlma::SequentialAllocator' it creates.
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_MAGAZINECACHE
+#include <bdlma_magazinecache.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                            // ===================
+                            // class BlockRecycler
+                            // ===================
+
+class BlockRecycler : public bslma::Allocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'bslma::Allocator' protocol, and caches the blocks
+    // deallocated to it, segregated by size class, for reuse by later
+    // allocations.  Free blocks are held in per-thread magazines fronting a
+    // shared, locked depot; blocks are obtained from (and returned to) an
+    // (optionally specified) basic allocator only when the depot is empty (or
+    // full).  Requests that exceed the largest recycled block size are
+    // forwarded to the basic allocator.
+
+  public:
+    // TYPES
+    enum {
+        k_MIN_BLOCK_SIZE  = 256,  // power-of-two part of the capacity of the
+                                  // smallest size class
+
+        k_SIZE_ALLOWANCE  = 64    // bytes added to the power-of-two part of
+                                  // the capacity of each size class
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Header {
+        // This 'struct' provides header information for each allocated memory
+        // block.  The header stores the index of the size class of the block.
+
+        union {
+            int                    d_classIdx;  // index of the size class of
+                                                // this block, or -1 if not
+                                                // recycled
+
+            bsls::AlignmentUtil::MaxAlignedType
+                                   d_dummy;     // force maximum alignment
+        } d_header;
+    };
+
+    // DATA
+    Magazine              *d_depots_p;      // array of shared free lists,
+                                            // one per size class
+
+    int                    d_numClasses;    // number of size classes
+
+    size_type              d_maxBlockSize;  // capacity of the largest size
+                                            // class
+
+    mutable bsls::BslLock  d_lock;          // guards depots, thread caches,
+                                            // and basic allocator
+
+    MagazineCache          d_magazineCache; // magazines of all threads
+
+    bslma::Allocator      *d_allocator_p;   // holds (but does not own)
+                                            // allocator
+
+  private:
+    // PRIVATE CLASS METHODS
+    static size_type classSize(int classIdx);
+        // Return the capacity (in bytes) of the blocks of the size class
+        // having the specified 'classIdx'.
+
+    static void flushMagazines(void *recycler, Magazine *magazines);
+        // Move all blocks held by the specified 'magazines' of a thread to
+        // the depots of the specified 'recycler', returning to the basic
+        // allocator those that do not fit.  The behavior is undefined unless
+        // the internal lock of 'recycler' is held by the calling thread.
+
+    // PRIVATE MANIPULATORS
+    void drain(Magazine *magazine, int classIdx);
+        // Move half of the blocks held by the specified 'magazine' to the
+        // depot of the size class having the specified 'classIdx', returning
+        // to the basic allocator those that do not fit.
+
+    void initialize();
+        // Allocate and initialize the depots of this recycler.
+
+    void refill(Magazine *magazine, int classIdx);
+        // Load the specified 'magazine' with up to half of its capacity of
+        // blocks from the depot of the size class having the specified
+        // 'classIdx', or, if the depot is empty, with one block obtained from
+        // the basic allocator.  The behavior is undefined unless 'magazine'
+        // is empty.
+
+    void returnBlocks(Magazine *list, int numBlocks);
+        // Move up to the specified 'numBlocks' blocks from the specified
+        // 'list' to the basic allocator.  The behavior is undefined unless
+        // the internal lock is held by the calling thread.
+
+    void stashBlocks(Magazine *magazine, int classIdx, int numBlocks);
+        // Move up to the specified 'numBlocks' blocks from the specified
+        // 'magazine' to the depot of the size class having the specified
+        // 'classIdx', returning to the basic allocator those that do not fit.
+        // The behavior is undefined unless the internal lock is held by the
+        // calling thread.
+
+    // PRIVATE ACCESSORS
+    int findClass(size_type size) const;
+        // Return the index of the smallest size class whose blocks can hold
+        // the specified 'size' (in bytes).  The behavior is undefined unless
+        // '1 <= size <= maxRecycledBlockSize()'.
+
+  private:
+    // NOT IMPLEMENTED
+    BlockRecycler(const BlockRecycler&);
+    BlockRecycler& operator=(const BlockRecycler&);
+
+  public:
+    // CLASS METHODS
+    static BlockRecycler& singleton();
+        // Return a reference to a modifiable process-wide block recycler that
+        // obtains its memory from 'bslma::NewDeleteAllocator::singleton()',
+        // creating it on the first call.  Note that this recycler is never
+        // destroyed, so the blocks it caches are not reclaimed at process
+        // exit unless 'trim' is called.
+
+    // CREATORS
+    explicit
+    BlockRecycler(bslma::Allocator *basicAllocator = 0);
+    explicit
+    BlockRecycler(int numClasses, bslma::Allocator *basicAllocator = 0);
+        // Create a block recycler.  Optionally specify 'numClasses',
+        // indicating the number of size classes of recycled blocks; the
+        // capacity of the first class is 'k_MIN_BLOCK_SIZE + k_SIZE_ALLOWANCE'
+        // bytes, with the power-of-two part of the capacity of each
+        // additional class successively doubling.  If 'numClasses' is not
+        // specified, an implementation-defined number of classes, covering
+        // blocks of up to approximately 1 MiB, is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '1 <= numClasses <= 20'.
+
+    virtual ~BlockRecycler();
+        // Destroy this recycler, returning all cached blocks, including those
+        // held in the caches of all threads, to the basic allocator.  The
+        // behavior is undefined unless every block allocated from this
+        // recycler has been deallocated.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated maximally-aligned block of memory of (at
+        // least) the specified 'size' (in bytes).  If 'size' is 0, no memory
+        // is allocated and 0 is returned.  If
+        // 'size <= maxRecycledBlockSize()', the block is taken from the cache
+        // of the smallest size class that can hold it, if available;
+        // otherwise, it is obtained from the basic allocator.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // recycler.  If 'address' is 0, this method has no effect.  If the
+        // block was allocated with a size of at most 'maxRecycledBlockSize()',
+        // it is cached for reuse; otherwise, it is returned to the basic
+        // allocator.  The behavior is undefined unless 'address' was returned
+        // by 'allocate' on this recycler and has not already been
+        // deallocated.  Note that 'address' need not have been allocated by
+        // the calling thread.
+
+    int trim();
+        // Return the free blocks cached by the calling thread, and all free
+        // blocks in the depots of this recycler, to the basic allocator.
+        // Return the number of blocks returned.  Note that the blocks cached
+        // by other threads are unaffected.
+
+    // ACCESSORS
+    size_type maxRecycledBlockSize() const;
+        // Return the largest size (in bytes) of allocation requests that are
+        // recycled by this recycler.  Note that the value is defined as:
+        //..
+        //  k_MIN_BLOCK_SIZE * 2 ^ (numClasses - 1) + k_SIZE_ALLOWANCE
+        //..
+
+    int numClasses() const;
+        // Return the number of size classes of this recycler.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                            // -------------------
+                            // class BlockRecycler
+                            // -------------------
+
+// PRIVATE CLASS METHODS
+inline
+bslma::Allocator::size_type BlockRecycler::classSize(int classIdx)
+{
+    return (static_cast<size_type>(k_MIN_BLOCK_SIZE) << classIdx)
+                                                           + k_SIZE_ALLOWANCE;
+}
+
+// PRIVATE ACCESSORS
+inline
+int BlockRecycler::findClass(size_type size) const
+{
+    BSLS_ASSERT_SAFE(1    <= size);
+    BSLS_ASSERT_SAFE(size <= d_maxBlockSize);
+
+    int       classIdx = 0;
+    size_type capacity = k_MIN_BLOCK_SIZE;
+
+    while (capacity + k_SIZE_ALLOWANCE < size) {
+        capacity *= 2;
+        ++classIdx;
+    }
+    return classIdx;
+}
+
+// ACCESSORS
+inline
+bslma::Allocator::size_type BlockRecycler::maxRecycledBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+inline
+int BlockRecycler::numClasses() const
+{
+    return d_numClasses;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,847 @@
+// bdlma_blockrecycler.t.cpp                                          -*-C++-*-
+#include <bdlma_blockrecycler.h>
+
+#include <bdlma_infrequentdeleteblocklist.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// A 'bdlma::BlockRecycler' is a mechanism (i.e., having state but no value)
+// that is used as a thread-safe upstream allocator.  It caches the blocks
+// deallocated to it in per-thread magazines and shared depots, segregated by
+// size class, and forwards requests that are too large to be recycled to its
+// basic allocator.
+//
+// Primary testing concerns are: 1) that the manipulators dispense blocks of
+// the requested size and alignment, and reuse deallocated blocks of the same
+// size class, 2) that memory is obtained from, and returned to, the allocator
+// supplied at construction, and that the amount of memory cached is bounded,
+// and 3) that many threads may allocate and deallocate concurrently,
+// including deallocating blocks allocated by other threads.  The
+// 'bslma_testallocator' component is used to verify the memory usage of the
+// recycler.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 6] static BlockRecycler& singleton();
+//
+// CREATORS
+// [ 2] BlockRecycler(Allocator *ba = 0);
+// [ 2] BlockRecycler(int numClasses, Allocator *ba = 0);
+// [ 2] ~BlockRecycler();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+// [ 4] int trim();
+//
+// ACCESSORS
+// [ 2] size_type maxRecycledBlockSize() const;
+// [ 2] int numClasses() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] CONCERN: Concurrent allocation and deallocation is thread-safe.
+// [ 7] USAGE EXAMPLE
+// [ *] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                       GLOBAL TYPES AND CONSTANTS
+//-----------------------------------------------------------------------------
+
+typedef bdlma::BlockRecycler Obj;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+enum {
+    MIN_SIZE  = Obj::k_MIN_BLOCK_SIZE,
+    ALLOWANCE = Obj::k_SIZE_ALLOWANCE
+};
+
+//=============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+bool isMaximallyAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address)
+                                   % bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+}
+
+                                // ------
+                                // case 5
+                                // ------
+
+enum { NUM_THREADS = 8, NUM_ITERATIONS = 2000, NUM_SLOTS = 16 };
+
+struct ThreadArgs {
+    Obj             *d_recycler_p;  // recycler shared by all threads
+    int              d_id;          // index of this thread
+    char           **d_handoff_p;   // blocks passed to the main thread
+    bsls::AtomicInt *d_errors_p;    // number of corrupted blocks detected
+};
+
+extern "C" void *workerThread(void *arg)
+    // Repeatedly allocate blocks of varying sizes from the shared recycler,
+    // fill them with a thread-specific pattern, verify
+    // the pattern, and deallocate them.  Hand off half of the blocks
+    // outstanding at the end to be deallocated by the main thread.
+{
+    ThreadArgs& args = *static_cast<ThreadArgs *>(arg);
+    Obj&        mX   = *args.d_recycler_p;
+
+    const char pattern = static_cast<char>('A' + args.d_id);
+
+    char *slots[NUM_SLOTS];
+    int   sizes[NUM_SLOTS];
+
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        slots[i] = 0;
+    }
+
+    const int maxSize = static_cast<int>(mX.maxRecycledBlockSize()) * 2;
+
+    unsigned seed = args.d_id + 1;
+
+    for (int iter = 0; iter < NUM_ITERATIONS; ++iter) {
+        seed = seed * 1103515245 + 12345;
+
+        const int slot = (seed >> 8) % NUM_SLOTS;
+
+        if (slots[slot]) {
+            const char *p = slots[slot];
+            const int   n = sizes[slot];
+            if (pattern != p[0] || pattern != p[n / 2] || pattern != p[n - 1])
+            {
+                ++*args.d_errors_p;
+            }
+            mX.deallocate(slots[slot]);
+        }
+
+        sizes[slot] = 1 + (seed >> 12) % maxSize;
+        slots[slot] = static_cast<char *>(mX.allocate(sizes[slot]));
+
+        if (!isMaximallyAligned(slots[slot])) {
+            ++*args.d_errors_p;
+        }
+        memset(slots[slot], pattern, sizes[slot]);
+    }
+
+    // Deallocate half of the outstanding blocks, and hand off the other half
+    // to be deallocated by the main thread.
+
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        if (i % 2) {
+            if (slots[i]) {
+                mX.deallocate(slots[i]);
+            }
+        }
+        else {
+            args.d_handoff_p[i / 2] = slots[i];
+        }
+    }
+
+    return arg;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Example 1: Recycling the Blocks of Short-Lived Arenas
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that each request processed by a server is given its own arena, a
+// block list from which the request's objects are carved and which is
+// released when the request completes.  We supply a shared
+// 'bdlma::BlockRecycler' to every arena, so that an arena reuses the blocks
+// released by earlier ones.
+//
+// First, we define a function that processes one request in its own arena:
+//..
+    void processRequest(bslma::Allocator *upstream, int numBlocks)
+        // Process a request requiring the specified 'numBlocks' arena blocks,
+        // obtained from the specified 'upstream' allocator.
+    {
+        bdlma::InfrequentDeleteBlockList arena(upstream);
+
+        for (int i = 0; i < numBlocks; ++i) {
+            char *block = static_cast<char *>(arena.allocate(4096));
+            memset(block, 'x', 4096);
+        }
+    }   // 'arena' releases its blocks to 'upstream'
+//..
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator  testAllocator(veryVeryVerbose);
+    bslma::Allocator     *Z = &testAllocator;
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+//..
+// Then, we create a recycler obtaining its memory from a test allocator, so
+// that we can observe how often the system allocator would be called:
+//..
+    bslma::TestAllocator ta;
+    bdlma::BlockRecycler recycler(&ta);
+//..
+// Next, we process a first request, whose blocks all come from 'ta', and
+// note the number of allocations made from 'ta' so far:
+//..
+    processRequest(&recycler, 4);
+
+    const bsls::Types::Int64 numAllocations = ta.numAllocations();
+//..
+// Now, we process many more requests.  Their blocks are all recycled from
+// the blocks released by the first request, so 'ta' is not called again:
+//..
+    for (int i = 0; i < 100; ++i) {
+        processRequest(&recycler, 4);
+    }
+    ASSERT(numAllocations == ta.numAllocations());
+//..
+// Finally, we return the four cached blocks to 'ta':
+//..
+    ASSERT(4 == recycler.trim());
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'singleton'
+        //
+        // Concerns:
+        //: 1 'singleton' returns the same recycler on every call.
+        //:
+        //: 2 The singleton recycles blocks, and does not obtain memory from
+        //:   the default or global allocators.
+        //
+        // Plan:
+        //: 1 Invoke 'singleton' twice and compare the addresses.  (C-1)
+        //:
+        //: 2 Install a test allocator as the default allocator, allocate and
+        //:   deallocate a block from the singleton twice, and verify that the
+        //:   same block is returned and that neither the default nor the
+        //:   global allocator was used.  (C-2)
+        //
+        // Testing:
+        //   static BlockRecycler& singleton();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'singleton'" << endl
+                          << "===================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        Obj& mX = Obj::singleton();
+
+        ASSERT(&mX == &Obj::singleton());
+
+        void *p = mX.allocate(5000);
+        ASSERT(p);
+        memset(p, 'x', 5000);
+        mX.deallocate(p);
+
+        ASSERT(p == mX.allocate(5000));
+        mX.deallocate(p);
+
+        ASSERT(0 <= mX.trim());
+
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 Many threads may concurrently allocate and deallocate blocks of
+        //:   varying sizes from one recycler.
+        //:
+        //: 2 A block allocated by one thread may be deallocated by another
+        //:   thread.
+        //:
+        //: 3 A block is never dispensed to two threads at once.
+        //:
+        //: 4 The blocks cached by a thread are kept for reuse when the thread
+        //:   exits, and all memory is returned to the allocator supplied at
+        //:   construction when the recycler is destroyed.
+        //
+        // Plan:
+        //: 1 Create several threads that each repeatedly allocate blocks of
+        //:   pseudo-random sizes (some exceeding the maximum recycled block
+        //:   size), fill each with a pattern unique to the thread, and verify
+        //:   that pattern before deallocating the block.  (C-1, 3)
+        //:
+        //: 2 Have each thread hand off half of its outstanding blocks to the
+        //:   main thread, which deallocates them after the thread exits.
+        //:   (C-2)
+        //:
+        //: 3 Repeat the whole procedure on the same recycler to exercise the
+        //:   reuse of blocks returned by exited threads.  Verify that no
+        //:   memory is outstanding in the test allocator after destroying the
+        //:   recycler.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: Concurrent allocation and deallocation is thread-safe.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONCURRENCY TEST"
+                          << endl << "================" << endl;
+
+        {
+            Obj mX(6, Z);  // classes of blocks from 256 to 8192 bytes
+
+            bsls::AtomicInt errors(0);
+
+            for (int round = 0; round < 3; ++round) {
+                ThreadArgs  args[NUM_THREADS];
+                ThreadId    ids[NUM_THREADS];
+                char       *handoff[NUM_THREADS][NUM_SLOTS / 2];
+
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    args[i].d_recycler_p = &mX;
+                    args[i].d_id         = i;
+                    args[i].d_handoff_p  = handoff[i];
+                    args[i].d_errors_p   = &errors;
+
+                    ids[i] = createThread(&workerThread, &args[i]);
+                }
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    joinThread(ids[i]);
+                }
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    for (int j = 0; j < NUM_SLOTS / 2; ++j) {
+                        if (handoff[i][j]) {
+                            mX.deallocate(handoff[i][j]);
+                        }
+                    }
+                }
+
+                LOOP_ASSERT(round, 0 == errors);
+
+                if (veryVerbose) {
+                    P_(round) P(testAllocator.numBlocksInUse())
+                }
+            }
+        }
+        LOOP_ASSERT(testAllocator.numBlocksInUse(),
+                    0 == testAllocator.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'trim'
+        //
+        // Concerns:
+        //: 1 'trim' returns the free blocks cached by the calling thread, and
+        //:   those in the depots, to the basic allocator, and returns their
+        //:   number.
+        //:
+        //: 2 'trim' does not affect blocks that are in use.
+        //:
+        //: 3 The recycler is usable after 'trim'.
+        //
+        // Plan:
+        //: 1 Invoke 'trim' on a new recycler and verify that it returns 0.
+        //:
+        //: 2 Allocate blocks of several size classes, deallocate some of them
+        //:   (enough to spill from the magazine to the depot for one class),
+        //:   and invoke 'trim'.  Verify the value returned, and that the
+        //:   number of blocks in use in the test allocator drops by that
+        //:   value.  Verify that the blocks still in use are intact.  (C-1..2)
+        //:
+        //: 3 Allocate again and deallocate everything.  (C-3)
+        //
+        // Testing:
+        //   int trim();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'trim'" << endl
+                          << "==============" << endl;
+
+        {
+            Obj mX(Z);
+
+            ASSERT(0 == mX.trim());
+
+            enum { NUM = 80 };
+
+            char *p[NUM];
+            for (int i = 0; i < NUM; ++i) {
+                const int size = i < NUM / 2 ? 1000 : 16000;
+                p[i] = static_cast<char *>(mX.allocate(size));
+                memset(p[i], 'a' + i % 26, size);
+            }
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksInUse();
+
+            for (int i = 0; i < NUM; i += 2) {
+                mX.deallocate(p[i]);
+            }
+            ASSERT(NUM_BLOCKS == testAllocator.numBlocksInUse());
+
+            const int numReturned = mX.trim();
+
+            LOOP_ASSERT(numReturned, NUM / 2 == numReturned);
+            LOOP2_ASSERT(NUM_BLOCKS, testAllocator.numBlocksInUse(),
+                         NUM_BLOCKS - NUM / 2 ==
+                                               testAllocator.numBlocksInUse());
+
+            ASSERT(0 == mX.trim());
+
+            for (int i = 1; i < NUM; i += 2) {
+                const int size = i < NUM / 2 ? 1000 : 16000;
+                LOOP_ASSERT(i, 'a' + i % 26 == p[i][0]);
+                LOOP_ASSERT(i, 'a' + i % 26 == p[i][size - 1]);
+            }
+
+            for (int i = 0; i < NUM; i += 2) {
+                p[i] = static_cast<char *>(mX.allocate(1000));
+            }
+            for (int i = 0; i < NUM; ++i) {
+                mX.deallocate(p[i]);
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns maximally-aligned memory of at least the
+        //:   requested size, and returns 0 if the requested size is 0.
+        //:
+        //: 2 A deallocated block is reused by the next allocation of any size
+        //:   in the same size class, and not by allocations of other classes.
+        //:
+        //: 3 The capacity of each size class includes the allowance for block
+        //:   headers.
+        //:
+        //: 4 Requests larger than 'maxRecycledBlockSize()' are satisfied by
+        //:   the basic allocator, and are returned to it on deallocation.
+        //:
+        //: 5 Deallocating more blocks than fit in a thread cache and a depot
+        //:   returns the excess to the basic allocator, so the memory held by
+        //:   the recycler is bounded.
+        //:
+        //: 6 Deallocating a null pointer has no effect.
+        //
+        // Plan:
+        //: 1 For a range of sizes, allocate blocks, verify their alignment,
+        //:   and write to every byte.  Allocate 0 bytes.  (C-1)
+        //:
+        //: 2 For each size class, allocate and deallocate a block of the
+        //:   largest size of the class, and verify that the smallest size of
+        //:   the class (but not the largest size of the previous class)
+        //:   reuses the block.  (C-2..3)
+        //:
+        //: 3 Allocate and deallocate a large block, and verify the number of
+        //:   blocks in use in the test allocator.  (C-4)
+        //:
+        //: 4 Allocate and then deallocate many blocks of one size class, and
+        //:   verify that the number of blocks in use in the test allocator is
+        //:   bounded.  (C-5)
+        //:
+        //: 5 Deallocate a null pointer.  (C-6)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocate' AND 'deallocate'" << endl
+                          << "===================================" << endl;
+
+        {
+            Obj mX(4, Z);
+
+            const int MAX = static_cast<int>(mX.maxRecycledBlockSize());
+
+            for (int size = 1; size <= 2 * MAX; size += 7) {
+                char *p = static_cast<char *>(mX.allocate(size));
+                LOOP_ASSERT(size, isMaximallyAligned(p));
+                memset(p, 0xa5, size);
+                mX.deallocate(p);
+            }
+
+            ASSERT(0 == mX.allocate(0));
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        {
+            Obj mX(Z);  const Obj& X = mX;
+
+            for (int i = 0; i < X.numClasses(); ++i) {
+                const int HI = (MIN_SIZE << i) + ALLOWANCE;
+                const int LO = i ? (MIN_SIZE << (i - 1)) + ALLOWANCE + 1 : 1;
+
+                void *p = mX.allocate(HI);
+                mX.deallocate(p);
+
+                if (i) {
+                    void *q = mX.allocate(LO - 1);
+                    LOOP_ASSERT(i, p != q);
+                    mX.deallocate(q);
+                }
+
+                void *r = mX.allocate(LO);
+                LOOP_ASSERT(i, p == r);
+                mX.deallocate(r);
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        {
+            Obj mX(3, Z);
+
+            void *p = mX.allocate(1);  // create the thread cache
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksInUse();
+
+            void *q = mX.allocate(mX.maxRecycledBlockSize() + 1);
+            ASSERT(NUM_BLOCKS + 1 == testAllocator.numBlocksInUse());
+
+            mX.deallocate(q);
+            ASSERT(NUM_BLOCKS     == testAllocator.numBlocksInUse());
+
+            mX.deallocate(p);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        {
+            Obj mX(Z);
+
+            enum { NUM = 500 };
+
+            bsl::vector<void *> blocks(Z);
+            for (int i = 0; i < NUM; ++i) {
+                blocks.push_back(mX.allocate(MIN_SIZE));
+            }
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksInUse();
+
+            for (int i = 0; i < NUM; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            // At most one full magazine and one full depot remain cached.
+
+            LOOP_ASSERT(testAllocator.numBlocksInUse(),
+                        testAllocator.numBlocksInUse() < NUM_BLOCKS - NUM / 2);
+
+            for (int i = 0; i < NUM; ++i) {
+                blocks[i] = mX.allocate(MIN_SIZE);
+            }
+            for (int i = 0; i < NUM; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            mX.deallocate(0);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates the requested number of size classes,
+        //:   and 'maxRecycledBlockSize' reflects that number.
+        //:
+        //: 2 Memory is supplied by the allocator specified at construction,
+        //:   or by the default allocator if none is specified.
+        //:
+        //: 3 The destructor returns all memory, including the blocks cached
+        //:   by the calling thread, to the underlying allocator.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Construct a recycler with each constructor, verify 'numClasses'
+        //:   and 'maxRecycledBlockSize', allocate from it, and verify that no
+        //:   memory remains in use after it is destroyed.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   BlockRecycler(Allocator *ba = 0);
+        //   BlockRecycler(int numClasses, Allocator *ba = 0);
+        //   ~BlockRecycler();
+        //   size_type maxRecycledBlockSize() const;
+        //   int numClasses() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CREATORS AND BASIC ACCESSORS" << endl
+                          << "====================================" << endl;
+
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            {
+                Obj mX;  const Obj& X = mX;
+
+                ASSERT(13                       == X.numClasses());
+                ASSERT(1024 * 1024 + ALLOWANCE  == X.maxRecycledBlockSize());
+
+                mX.deallocate(mX.allocate(100));
+                ASSERT(0 <  da.numBlocksInUse());
+                ASSERT(0 == testAllocator.numBlocksInUse());
+            }
+            ASSERT(0 == da.numBlocksInUse());
+        }
+
+        for (int numClasses = 1; numClasses <= 20; ++numClasses) {
+            const bsls::Types::size_type MAX_SIZE =
+                     (static_cast<bsls::Types::size_type>(MIN_SIZE)
+                                            << (numClasses - 1)) + ALLOWANCE;
+            {
+                Obj mX(numClasses, Z);  const Obj& X = mX;
+                LOOP_ASSERT(numClasses, numClasses == X.numClasses());
+                LOOP_ASSERT(numClasses, MAX_SIZE == X.maxRecycledBlockSize());
+                if (numClasses <= 13) {
+                    mX.deallocate(mX.allocate(MAX_SIZE));
+                }
+            }
+            LOOP_ASSERT(numClasses, 0 == testAllocator.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj( 1, Z));
+            ASSERT_PASS(Obj(20, Z));
+            ASSERT_FAIL(Obj( 0, Z));
+            ASSERT_FAIL(Obj(-1, Z));
+            ASSERT_FAIL(Obj(21, Z));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //   That the basic functionality of 'bdlma::BlockRecycler' works
+        //   properly.
+        //
+        // Plan:
+        //   Create a recycler having three size classes.  Allocate blocks of
+        //   the first two classes, as well as a block too large to recycle.
+        //   Deallocate them, and verify that a block of the first class is
+        //   reused.  Finally, let the recycler go out of scope to exercise the
+        //   destructor.
+        //
+        // Testing:
+        //   This "test" exercises basic functionality, but tests nothing.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST"
+                          << endl << "==============" << endl;
+
+        {
+            Obj mX(3, Z);
+
+            char *p = static_cast<char *>(mX.allocate(100));     ASSERT(p);
+            char *q = static_cast<char *>(mX.allocate(500));     ASSERT(q);
+            char *r = static_cast<char *>(mX.allocate(10000));   ASSERT(r);
+
+            ASSERT(p != q);
+
+            mX.deallocate(p);
+            mX.deallocate(q);
+            mX.deallocate(r);
+
+            ASSERT(p == mX.allocate(200));
+            mX.deallocate(p);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,568 @@
+// bdlma_boundallocator.h                                             -*-C++-*-
+#ifndef INCLUDED_BDLMA_BOUNDALLOCATOR
+#define INCLUDED_BDLMA_BOUNDALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an STL allocator bound statically to a concrete mechanism.
+//
+//@CLASSES:
+//  bdlma::BoundAllocator: 'bsl::allocator' bound to a concrete mechanism type
+//
+//@SEE_ALSO: bslstl_allocator, bdlma_sequentialallocator,
+//           bdlma_multipoolallocator
+//
+//@DESCRIPTION: This component provides an STL-compatible allocator class
+// template, 'bdlma::BoundAllocator', that, like 'bsl::allocator', forwards
+// allocation calls to a mechanism object of a type derived from
+// 'bslma::Allocator', but that is additionally parameterized by the concrete
+// type of the mechanism the client intends to supply, e.g.,
+// 'bdlma::SequentialAllocator' or 'bdlma::MultipoolAllocator'.  Whenever the
+// mechanism supplied to a 'bdlma::BoundAllocator' is of exactly that
+// (template parameter) 'MECHANISM' type, 'allocate' and 'deallocate' call the
+// mechanism through a qualified (i.e., non-virtual) call, which the compiler
+// can inline; otherwise they fall back to the virtual 'bslma::Allocator'
+// interface, exactly as 'bsl::allocator' does.
+//
+///Binding
+///-------
+// A 'bdlma::BoundAllocator' records, when it is created from a
+// 'bslma::Allocator' pointer, whether the dynamic type of the mechanism is
+// exactly 'MECHANISM' (and not merely derived from it), so that a
+// non-virtual call is never made to a mechanism whose most-derived type
+// overrides 'allocate' or 'deallocateSized'.  When it is created from a
+// 'MECHANISM' pointer, the mechanism is bound without that check, and the
+// behavior is undefined unless the most-derived type of the mechanism is
+// 'MECHANISM'.  Copies, and rebound copies, of a 'bdlma::BoundAllocator'
+// share the binding of the original.  A default-constructed
+// 'bdlma::BoundAllocator' uses the currently installed default allocator,
+// and is therefore unbound unless the default allocator is a 'MECHANISM'.
+//
+// To return memory, a bound 'bdlma::BoundAllocator' calls the
+// 'deallocateSized' method of 'MECHANISM' with the size of the block; if
+// 'MECHANISM' does not override 'deallocateSized', that call is made to the
+// implementation in 'bslma::Allocator', which calls 'deallocate' virtually.
+//
+///Use with 'bsl' Containers
+///-------------------------
+// 'bdlma::BoundAllocator' is implicitly convertible from 'bslma::Allocator *',
+// and provides a 'mechanism' accessor returning that pointer, so the 'bsl'
+// containers recognize it as a 'bslma'-style allocator exactly as they do
+// 'bsl::allocator': a container instantiated with a 'bdlma::BoundAllocator'
+// passes its mechanism to each element whose type uses 'bslma' allocators
+// (i.e., allocators propagate to elements as with a scoped allocator), and
+// copy-constructing such a container uses the default allocator rather than
+// that of the original.  Note that 'bdlma::BoundAllocator' objects with the
+// same mechanism compare equal whatever their binding, so containers that
+// use them can be swapped exactly when their mechanisms are the same.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Binding a Vector to a Sequential Allocator
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we build, in a tight loop, many short-lived vectors of strings
+// whose memory all comes from a 'bdlma::SequentialAllocator'.  With
+// 'bsl::allocator', each allocation by a vector is a virtual call, which the
+// compiler cannot inline, to 'bdlma::SequentialAllocator::allocate'.
+//
+// First, we define a vector type whose allocator is bound to
+// 'bdlma::SequentialAllocator':
+//..
+//  typedef bdlma::BoundAllocator<bsl::string, bdlma::SequentialAllocator>
+//                                                            StringAllocator;
+//  typedef bsl::vector<bsl::string, StringAllocator>         StringVector;
+//..
+// Then, we create a sequential allocator, and, in an inner scope, a vector
+// that uses it:
+//..
+//  bslma::TestAllocator       ta;
+//  bdlma::SequentialAllocator sa(&ta);
+//  {
+//      StringVector v(&sa);
+//      assert(&sa == v.get_allocator().mechanism());
+//      assert(v.get_allocator().isBound());
+//..
+// Next, we append a string that is too long for the short-string buffer; the
+// vector allocates its array through a non-virtual call to 'sa', and passes
+// 'sa' on to the string it creates:
+//..
+//      v.push_back("A string long enough to need memory of its own.");
+//      assert(&sa == v[0].get_allocator().mechanism());
+//  }
+//..
+// Finally, we observe that all of the memory came from 'sa', which obtained
+// it from 'ta', and which, being a sequential allocator, keeps it until it
+// is released:
+//..
+//  assert(0 < ta.numBytesInUse());
+//  sa.release();
+//  assert(0 == ta.numBytesInUse());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ASSERT
+#include <bslmf_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEEQUALITYCOMPARABLE
+#include <bslmf_isbitwiseequalitycomparable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISCONVERTIBLE
+#include <bslmf_isconvertible.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISTRIVIALLYCOPYABLE
+#include <bslmf_istriviallycopyable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_UTIL
+#include <bsls_util.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_TYPEINFO
+#include <bsl_typeinfo.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                            // ====================
+                            // class BoundAllocator
+                            // ====================
+
+template <class TYPE, class MECHANISM>
+class BoundAllocator {
+    // This STL-compatible allocator forwards allocation calls to an
+    // underlying mechanism object of a type derived from 'bslma::Allocator',
+    // as does 'bsl::allocator', but calls the mechanism non-virtually
+    // whenever its most-derived type is the (template parameter)
+    // 'MECHANISM'.  This class template adheres to the allocator requirements
+    // of the C++ standard, and is recognized by the 'bsl' containers as an
+    // allocator that propagates its mechanism to the elements it constructs.
+
+    BSLMF_ASSERT((bsl::is_convertible<MECHANISM *,
+                                      bslma::Allocator *>::value));
+
+    // DATA
+    bslma::Allocator *d_mechanism_p;  // mechanism (held, not owned)
+
+    MECHANISM        *d_bound_p;      // 'd_mechanism_p' if its most-derived
+                                      // type is 'MECHANISM', and 0 otherwise
+
+    // FRIENDS
+    template <class OTHER_TYPE, class OTHER_MECHANISM>
+    friend class BoundAllocator;
+
+    // PRIVATE CLASS METHODS
+    static MECHANISM *bind(bslma::Allocator *mechanism);
+        // Return the specified 'mechanism' as a pointer to 'MECHANISM' if its
+        // most-derived type is 'MECHANISM', and 0 otherwise.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(BoundAllocator, bsl::is_trivially_copyable);
+    BSLMF_NESTED_TRAIT_DECLARATION(BoundAllocator, bslmf::IsBitwiseMoveable);
+    BSLMF_NESTED_TRAIT_DECLARATION(BoundAllocator,
+                                   bslmf::IsBitwiseEqualityComparable);
+
+    // PUBLIC TYPES
+    typedef bsl::size_t     size_type;
+    typedef bsl::ptrdiff_t  difference_type;
+    typedef TYPE           *pointer;
+    typedef const TYPE     *const_pointer;
+    typedef TYPE&           reference;
+    typedef const TYPE&     const_reference;
+    typedef TYPE            value_type;
+
+    template <class ANY_TYPE>
+    struct rebind {
+        // This nested 'struct' template, parameterized by 'ANY_TYPE',
+        // provides a namespace for an 'other' type alias, which is an
+        // allocator type bound to the same 'MECHANISM' as this one but that
+        // allocates elements of 'ANY_TYPE'.
+
+        typedef BoundAllocator<ANY_TYPE, MECHANISM> other;
+    };
+
+    // CREATORS
+    BoundAllocator();
+        // Create an allocator that forwards allocation calls to the currently
+        // installed default allocator, and that is bound only if the
+        // most-derived type of the default allocator is 'MECHANISM'.
+
+    BoundAllocator(bslma::Allocator *mechanism);                    // IMPLICIT
+        // Create an allocator that forwards allocation calls to the specified
+        // 'mechanism', and that is bound if the most-derived type of
+        // 'mechanism' is 'MECHANISM'.  If 'mechanism' is 0, the currently
+        // installed default allocator is used.
+
+    BoundAllocator(MECHANISM *mechanism);                           // IMPLICIT
+        // Create an allocator that is bound to the specified 'mechanism'.
+        // The behavior is undefined unless 'mechanism' is non-null and its
+        // most-derived type is 'MECHANISM'.
+
+    template <class ANY_TYPE>
+    BoundAllocator(const BoundAllocator<ANY_TYPE, MECHANISM>& original);
+        // Create an allocator having the same mechanism and binding as the
+        // specified 'original'.  Note that the new allocator compares equal
+        // to 'original', even though they are instantiated on different
+        // types.
+
+    //! BoundAllocator(const BoundAllocator& original) = default;
+        // Create an allocator having the same mechanism and binding as the
+        // specified 'original'.
+
+    //! ~BoundAllocator() = default;
+        // Destroy this object.  Note that this does not delete the object
+        // pointed to by 'mechanism()'.
+
+    // MANIPULATORS
+    //! BoundAllocator& operator=(const BoundAllocator& rhs) = default;
+        // Assign to this object the mechanism and binding of the specified
+        // 'rhs', and return a reference providing modifiable access to this
+        // object.
+
+    pointer allocate(size_type n, const void *hint = 0);
+        // Allocate enough (properly aligned) space for the specified 'n'
+        // objects of (template parameter) 'TYPE' by calling 'allocate' on the
+        // mechanism object, non-virtually if this allocator is bound.  The
+        // optionally specified 'hint' argument is ignored by this allocator
+        // type.  The behavior is undefined unless 'n <= max_size()'.
+
+    void deallocate(pointer p, size_type n = 1);
+        // Return memory previously allocated with 'allocate' to the
+        // mechanism object by calling 'deallocateSized' on it, non-virtually
+        // if this allocator is bound, with the specified 'p' and the size (in
+        // bytes) of the optionally specified 'n' objects of (template
+        // parameter) 'TYPE'.  The behavior is undefined unless 'p' was
+        // returned by a call to 'allocate(n)' on an allocator that compares
+        // equal to this one.
+
+    // ACCESSORS
+    pointer address(reference x) const;
+        // Return the address of the object referred to by the specified 'x',
+        // even if the (template parameter) 'TYPE' overloads the unary
+        // 'operator&'.
+
+    const_pointer address(const_reference x) const;
+        // Return the address of the object referred to by the specified 'x',
+        // even if the (template parameter) 'TYPE' overloads the unary
+        // 'operator&'.
+
+    MECHANISM *boundMechanism() const;
+        // Return the address of the mechanism object to which this allocator
+        // forwards allocation calls non-virtually, or 0 if this allocator is
+        // not bound.
+
+    bool isBound() const;
+        // Return 'true' if this allocator calls its mechanism non-virtually,
+        // and 'false' otherwise.
+
+    size_type max_size() const;
+        // Return the maximum number of elements of (template parameter)
+        // 'TYPE' that can be allocated using this allocator.  Note that there
+        // is no guarantee that attempts at allocating fewer elements than the
+        // value returned by 'max_size' will not throw.
+
+    bslma::Allocator *mechanism() const;
+        // Return the address of the mechanism object to which this allocator
+        // forwards allocation calls.
+};
+
+// FREE OPERATORS
+template <class TYPE1, class TYPE2, class MECHANISM>
+bool operator==(const BoundAllocator<TYPE1, MECHANISM>& lhs,
+                const BoundAllocator<TYPE2, MECHANISM>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' forward allocation calls
+    // to the same mechanism object, and 'false' otherwise.  Note that the two
+    // allocators need not be instantiated on the same type in order to
+    // compare equal.
+
+template <class TYPE1, class TYPE2, class MECHANISM>
+bool operator!=(const BoundAllocator<TYPE1, MECHANISM>& lhs,
+                const BoundAllocator<TYPE2, MECHANISM>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' forward allocation calls
+    // to different mechanism objects, and 'false' otherwise.
+
+template <class TYPE, class MECHANISM>
+bool operator==(const BoundAllocator<TYPE, MECHANISM>&  lhs,
+                const bslma::Allocator                 *rhs);
+template <class TYPE, class MECHANISM>
+bool operator==(const bslma::Allocator                 *lhs,
+                const BoundAllocator<TYPE, MECHANISM>&  rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' refer to the same
+    // mechanism object, and 'false' otherwise.
+
+template <class TYPE, class MECHANISM>
+bool operator!=(const BoundAllocator<TYPE, MECHANISM>&  lhs,
+                const bslma::Allocator                 *rhs);
+template <class TYPE, class MECHANISM>
+bool operator!=(const bslma::Allocator                 *lhs,
+                const BoundAllocator<TYPE, MECHANISM>&  rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' refer to different
+    // mechanism objects, and 'false' otherwise.
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                            // --------------------
+                            // class BoundAllocator
+                            // --------------------
+
+// PRIVATE CLASS METHODS
+template <class TYPE, class MECHANISM>
+inline
+MECHANISM *BoundAllocator<TYPE, MECHANISM>::bind(bslma::Allocator *mechanism)
+{
+    BSLS_ASSERT_SAFE(mechanism);
+
+    return typeid(*mechanism) == typeid(MECHANISM)
+           ? static_cast<MECHANISM *>(mechanism)
+           : 0;
+}
+
+// CREATORS
+template <class TYPE, class MECHANISM>
+inline
+BoundAllocator<TYPE, MECHANISM>::BoundAllocator()
+: d_mechanism_p(bslma::Default::defaultAllocator())
+, d_bound_p(bind(d_mechanism_p))
+{
+}
+
+template <class TYPE, class MECHANISM>
+inline
+BoundAllocator<TYPE, MECHANISM>::BoundAllocator(bslma::Allocator *mechanism)
+: d_mechanism_p(bslma::Default::allocator(mechanism))
+, d_bound_p(bind(d_mechanism_p))
+{
+}
+
+template <class TYPE, class MECHANISM>
+inline
+BoundAllocator<TYPE, MECHANISM>::BoundAllocator(MECHANISM *mechanism)
+: d_mechanism_p(mechanism)
+, d_bound_p(mechanism)
+{
+    BSLS_ASSERT_SAFE(mechanism);
+    BSLS_ASSERT_SAFE(typeid(*mechanism) == typeid(MECHANISM));
+}
+
+template <class TYPE, class MECHANISM>
+template <class ANY_TYPE>
+inline
+BoundAllocator<TYPE, MECHANISM>::BoundAllocator(
+                           const BoundAllocator<ANY_TYPE, MECHANISM>& original)
+: d_mechanism_p(original.d_mechanism_p)
+, d_bound_p(original.d_bound_p)
+{
+}
+
+// MANIPULATORS
+template <class TYPE, class MECHANISM>
+inline
+typename BoundAllocator<TYPE, MECHANISM>::pointer
+BoundAllocator<TYPE, MECHANISM>::allocate(size_type n, const void *hint)
+{
+    BSLS_ASSERT_SAFE(n <= this->max_size());
+
+    (void)hint;  // suppress unused parameter warning
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(d_bound_p)) {
+        return static_cast<pointer>(
+                             d_bound_p->MECHANISM::allocate(n * sizeof(TYPE)));
+                                                                      // RETURN
+    }
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    return static_cast<pointer>(d_mechanism_p->allocate(n * sizeof(TYPE)));
+}
+
+template <class TYPE, class MECHANISM>
+inline
+void BoundAllocator<TYPE, MECHANISM>::deallocate(pointer p, size_type n)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(d_bound_p)) {
+        d_bound_p->MECHANISM::deallocateSized(p, n * sizeof(TYPE));
+        return;                                                       // RETURN
+    }
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    d_mechanism_p->deallocateSized(p, n * sizeof(TYPE));
+}
+
+// ACCESSORS
+template <class TYPE, class MECHANISM>
+inline
+typename BoundAllocator<TYPE, MECHANISM>::pointer
+BoundAllocator<TYPE, MECHANISM>::address(reference x) const
+{
+    return BSLS_UTIL_ADDRESSOF(x);
+}
+
+template <class TYPE, class MECHANISM>
+inline
+typename BoundAllocator<TYPE, MECHANISM>::const_pointer
+BoundAllocator<TYPE, MECHANISM>::address(const_reference x) const
+{
+    return BSLS_UTIL_ADDRESSOF(x);
+}
+
+template <class TYPE, class MECHANISM>
+inline
+MECHANISM *BoundAllocator<TYPE, MECHANISM>::boundMechanism() const
+{
+    return d_bound_p;
+}
+
+template <class TYPE, class MECHANISM>
+inline
+bool BoundAllocator<TYPE, MECHANISM>::isBound() const
+{
+    return 0 != d_bound_p;
+}
+
+template <class TYPE, class MECHANISM>
+inline
+typename BoundAllocator<TYPE, MECHANISM>::size_type
+BoundAllocator<TYPE, MECHANISM>::max_size() const
+{
+    // Return the largest value, 'v', such that 'v * sizeof(TYPE)' fits in a
+    // 'size_type'.
+
+    static const bsl::size_t MAX_NUM_BYTES    = ~bsl::size_t(0);
+    static const bsl::size_t MAX_NUM_ELEMENTS = MAX_NUM_BYTES / sizeof(TYPE);
+
+    return MAX_NUM_ELEMENTS;
+}
+
+template <class TYPE, class MECHANISM>
+inline
+bslma::Allocator *BoundAllocator<TYPE, MECHANISM>::mechanism() const
+{
+    return d_mechanism_p;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class TYPE1, class TYPE2, class MECHANISM>
+inline
+bool bdlma::operator==(const BoundAllocator<TYPE1, MECHANISM>& lhs,
+                       const BoundAllocator<TYPE2, MECHANISM>& rhs)
+{
+    return lhs.mechanism() == rhs.mechanism();
+}
+
+template <class TYPE1, class TYPE2, class MECHANISM>
+inline
+bool bdlma::operator!=(const BoundAllocator<TYPE1, MECHANISM>& lhs,
+                       const BoundAllocator<TYPE2, MECHANISM>& rhs)
+{
+    return lhs.mechanism() != rhs.mechanism();
+}
+
+template <class TYPE, class MECHANISM>
+inline
+bool bdlma::operator==(const BoundAllocator<TYPE, MECHANISM>&  lhs,
+                       const bslma::Allocator                 *rhs)
+{
+    return lhs.mechanism() == rhs;
+}
+
+template <class TYPE, class MECHANISM>
+inline
+bool bdlma::operator==(const bslma::Allocator                 *lhs,
+                       const BoundAllocator<TYPE, MECHANISM>&  rhs)
+{
+    return lhs == rhs.mechanism();
+}
+
+template <class TYPE, class MECHANISM>
+inline
+bool bdlma::operator!=(const BoundAllocator<TYPE, MECHANISM>&  lhs,
+                       const bslma::Allocator                 *rhs)
+{
+    return lhs.mechanism() != rhs;
+}
+
+template <class TYPE, class MECHANISM>
+inline
+bool bdlma::operator!=(const bslma::Allocator                 *lhs,
+                       const BoundAllocator<TYPE, MECHANISM>&  rhs)
+{
+    return lhs != rhs.mechanism();
+}
+
+// TRAITS
+namespace bslma {
+
+template <class TYPE, class MECHANISM>
+struct UsesBslmaAllocator<bdlma::BoundAllocator<TYPE, MECHANISM> >
+    : bsl::false_type {
+    // A 'bdlma::BoundAllocator' is itself an allocator, not an object that
+    // takes one at construction.
+};
+
+}  // close namespace bslma
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,896 @@
+// bdlma_boundallocator.t.cpp                                         -*-C++-*-
+#include <bdlma_boundallocator.h>
+
+#include <bdlma_multipoolallocator.h>
+#include <bdlma_sequentialallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_list.h>
+#include <bsl_map.h>
+#include <bsl_string.h>
+#include <bsl_unordered_set.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The goals of this 'bdlma::BoundAllocator' test driver are to verify that:
+// 1) an allocator is bound exactly when the most-derived type of its
+// mechanism is the (template parameter) 'MECHANISM', 2) 'allocate' and
+// 'deallocate' reach the mechanism with the expected sizes whether or not the
+// allocator is bound, and never bypass an override in a type derived from
+// 'MECHANISM', and 3) the 'bsl' containers treat a 'bdlma::BoundAllocator'
+// as they treat 'bsl::allocator', in particular propagating its mechanism to
+// their elements.
+//
+// To observe the calls made to a mechanism, the tests use a mechanism type,
+// 'my_CountingAllocator', that counts the calls to each of its methods and
+// forwards them to a test allocator, and a type derived from it that counts
+// its own calls to 'allocate'.
+//-----------------------------------------------------------------------------
+// [ 2] BoundAllocator();
+// [ 2] BoundAllocator(bslma::Allocator *mechanism);
+// [ 2] BoundAllocator(MECHANISM *mechanism);
+// [ 2] BoundAllocator(const BoundAllocator<ANY_TYPE, MECHANISM>& original);
+// [ 3] pointer allocate(size_type n, const void *hint = 0);
+// [ 3] void deallocate(pointer p, size_type n = 1);
+// [ 3] pointer address(reference x) const;
+// [ 3] const_pointer address(const_reference x) const;
+// [ 2] MECHANISM *boundMechanism() const;
+// [ 2] bool isBound() const;
+// [ 3] size_type max_size() const;
+// [ 2] bslma::Allocator *mechanism() const;
+// [ 2] bool operator==(const BoundAllocator<T1, M>&, ... <T2, M>&);
+// [ 2] bool operator!=(const BoundAllocator<T1, M>&, ... <T2, M>&);
+// [ 2] bool operator==(const BoundAllocator<T, M>&, const Allocator *);
+// [ 2] bool operator==(const Allocator *, const BoundAllocator<T, M>&);
+// [ 2] bool operator!=(const BoundAllocator<T, M>&, const Allocator *);
+// [ 2] bool operator!=(const Allocator *, const BoundAllocator<T, M>&);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCERN: 'bsl' containers propagate the mechanism to elements.
+// [ 5] USAGE EXAMPLE
+// [ *] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+//-----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  CONCRETE MECHANISMS FOR TESTING
+// ----------------------------------------------------------------------------
+
+class my_CountingAllocator : public bslma::Allocator {
+    // This mechanism counts the calls to each of its methods, records the
+    // size passed to the last of them, and forwards each call to the
+    // allocator supplied at construction.
+
+    // DATA
+    bslma::Allocator *d_allocator_p;  // supplies memory (held, not owned)
+
+  public:
+    // PUBLIC DATA
+    int       d_numAllocate;         // number of calls to 'allocate'
+    int       d_numDeallocate;       // number of calls to 'deallocate'
+    int       d_numDeallocateSized;  // number of calls to 'deallocateSized'
+    size_type d_lastSize;            // size passed to last method called
+
+    // CREATORS
+    explicit my_CountingAllocator(bslma::Allocator *basicAllocator)
+    : d_allocator_p(basicAllocator)
+    , d_numAllocate(0)
+    , d_numDeallocate(0)
+    , d_numDeallocateSized(0)
+    , d_lastSize(0)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        ++d_numAllocate;
+        d_lastSize = size;
+        return d_allocator_p->allocate(size);
+    }
+
+    virtual void deallocate(void *address)
+    {
+        ++d_numDeallocate;
+        d_allocator_p->deallocate(address);
+    }
+
+    virtual void deallocateSized(void *address, size_type size)
+    {
+        ++d_numDeallocateSized;
+        d_lastSize = size;
+        d_allocator_p->deallocate(address);
+    }
+};
+
+class my_DerivedCountingAllocator : public my_CountingAllocator {
+    // This mechanism counts the calls to its 'allocate' override separately
+    // from those counted by its base class.
+
+  public:
+    // PUBLIC DATA
+    int d_numDerivedAllocate;  // number of calls to this 'allocate'
+
+    // CREATORS
+    explicit my_DerivedCountingAllocator(bslma::Allocator *basicAllocator)
+    : my_CountingAllocator(basicAllocator)
+    , d_numDerivedAllocate(0)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        ++d_numDerivedAllocate;
+        return my_CountingAllocator::allocate(size);
+    }
+};
+
+//=============================================================================
+//                               GLOBAL TYPEDEFS
+//-----------------------------------------------------------------------------
+
+typedef bdlma::BoundAllocator<int, my_CountingAllocator>    Obj;
+typedef bdlma::BoundAllocator<double, my_CountingAllocator> DoubleObj;
+
+struct my_Big {
+    // This 'struct' is larger than an 'int', so that the sizes requested for
+    // it differ from those requested for an 'int'.
+
+    char d_data[24];  // payload
+};
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    (void)veryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Binding a Vector to a Sequential Allocator
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we build, in a tight loop, many short-lived vectors of strings
+// whose memory all comes from a 'bdlma::SequentialAllocator'.  With
+// 'bsl::allocator', each allocation by a vector is a virtual call, which the
+// compiler cannot inline, to 'bdlma::SequentialAllocator::allocate'.
+//
+// First, we define a vector type whose allocator is bound to
+// 'bdlma::SequentialAllocator':
+//..
+    typedef bdlma::BoundAllocator<bsl::string, bdlma::SequentialAllocator>
+                                                              StringAllocator;
+    typedef bsl::vector<bsl::string, StringAllocator>         StringVector;
+//..
+// Then, we create a sequential allocator, and, in an inner scope, a vector
+// that uses it:
+//..
+    bslma::TestAllocator       ta;
+    bdlma::SequentialAllocator sa(&ta);
+    {
+        StringVector v(&sa);
+        ASSERT(&sa == v.get_allocator().mechanism());
+        ASSERT(v.get_allocator().isBound());
+//..
+// Next, we append a string that is too long for the short-string buffer; the
+// vector allocates its array through a non-virtual call to 'sa', and passes
+// 'sa' on to the string it creates:
+//..
+        v.push_back("A string long enough to need memory of its own.");
+        ASSERT(&sa == v[0].get_allocator().mechanism());
+    }
+//..
+// Finally, we observe that all of the memory came from 'sa', which obtained
+// it from 'ta', and which, being a sequential allocator, keeps it until it
+// is released:
+//..
+    ASSERT(0 < ta.numBytesInUse());
+    sa.release();
+    ASSERT(0 == ta.numBytesInUse());
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCERN: 'bsl' CONTAINERS PROPAGATE THE MECHANISM
+        //
+        // Concerns:
+        //: 1 A 'bsl' container instantiated with a 'bdlma::BoundAllocator'
+        //:   obtains all of its memory from the mechanism supplied at
+        //:   construction, through a bound allocator.
+        //:
+        //: 2 The container passes that mechanism to each element whose type
+        //:   uses 'bslma' allocators, whether the element uses
+        //:   'bsl::allocator' or a 'bdlma::BoundAllocator'.
+        //:
+        //: 3 A copy of the container uses the default allocator, as does a
+        //:   copy of a container that uses 'bsl::allocator'.
+        //:
+        //: 4 The container returns all of its memory to the mechanism.
+        //
+        // Plan:
+        //: 1 For each of 'bsl::vector', 'bsl::list', 'bsl::map', and
+        //:   'bsl::unordered_set' of 'bsl::string', and for 'bsl::string'
+        //:   itself, instantiated with a 'bdlma::BoundAllocator' bound to
+        //:   'bdlma::MultipoolAllocator', create a container supplied with a
+        //:   multipool allocator that obtains memory from a test allocator,
+        //:   insert long strings, and verify the mechanism of the container
+        //:   and of its elements, and that no memory came from the default
+        //:   allocator.  (C-1..2)
+        //:
+        //: 2 Copy each container and verify that the copy uses the default
+        //:   allocator.  (C-3)
+        //:
+        //: 3 Destroy the containers and their multipools, and verify that
+        //:   the test allocator holds no memory; check the balance of calls
+        //:   with a counting mechanism for 'bsl::vector'.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: 'bsl' containers propagate the mechanism to elements.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONTAINER PROPAGATION" << endl
+                                  << "=====================" << endl;
+
+        typedef bdlma::MultipoolAllocator Mech;
+
+        typedef bdlma::BoundAllocator<char, Mech> CharAlloc;
+        typedef bsl::basic_string<char, bsl::char_traits<char>, CharAlloc>
+                                                  BoundString;
+
+        typedef bsl::vector<bsl::string,
+                            bdlma::BoundAllocator<bsl::string, Mech> >
+                                                  Vector;
+        typedef bsl::list<bsl::string,
+                          bdlma::BoundAllocator<bsl::string, Mech> >
+                                                  List;
+        typedef bsl::map<int,
+                         bsl::string,
+                         bsl::less<int>,
+                         bdlma::BoundAllocator<
+                                        bsl::pair<const int, bsl::string>,
+                                        Mech> >   Map;
+        typedef bsl::unordered_set<bsl::string,
+                                   bsl::hash<bsl::string>,
+                                   bsl::equal_to<bsl::string>,
+                                   bdlma::BoundAllocator<bsl::string, Mech> >
+                                                  UnorderedSet;
+        typedef bsl::vector<BoundString,
+                            bdlma::BoundAllocator<BoundString, Mech> >
+                                                  NestedVector;
+
+        const char *LONG = "a string too long for the short-string buffer";
+
+        bslma::TestAllocator ta("multipool", veryVeryVerbose);
+
+        bslma::TestAllocator sa("source", veryVeryVerbose);
+        const bsl::string    S(LONG, &sa);
+
+        if (verbose) cout << "\tTesting 'bsl::vector'." << endl;
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Mech   mpa(&ta);
+            Vector mX(&mpa);  const Vector& X = mX;
+
+            ASSERT(X.get_allocator().isBound());
+            ASSERT(&mpa == X.get_allocator().boundMechanism());
+
+            for (int i = 0; i < 10; ++i) {
+                mX.push_back(S);
+                LOOP_ASSERT(i, &mpa == X[i].get_allocator().mechanism());
+            }
+            ASSERT(0 <  ta.numBlocksInUse());
+            ASSERT(0 == da.numBlocksTotal());
+
+            {
+                Vector mY(X);  const Vector& Y = mY;
+
+                ASSERT(X == Y);
+                ASSERT(&da == Y.get_allocator().mechanism());
+                ASSERT(!Y.get_allocator().isBound());
+                ASSERT(&da == Y[0].get_allocator().mechanism());
+                ASSERT(0 <  da.numBlocksInUse());
+            }
+            ASSERT(0 == da.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting 'bsl::list'." << endl;
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Mech mpa(&ta);
+            List mX(&mpa);  const List& X = mX;
+
+            for (int i = 0; i < 10; ++i) {
+                mX.push_back(S);
+                LOOP_ASSERT(i, &mpa == X.back().get_allocator().mechanism());
+            }
+            ASSERT(0 == da.numBlocksTotal());
+
+            List mY(X);  const List& Y = mY;
+            ASSERT(X == Y);
+            ASSERT(&da == Y.front().get_allocator().mechanism());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting 'bsl::map'." << endl;
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Mech mpa(&ta);
+            Map  mX(&mpa);  const Map& X = mX;
+
+            for (int i = 0; i < 10; ++i) {
+                mX[i] = LONG;
+                LOOP_ASSERT(i, &mpa == X.find(i)->second.get_allocator()
+                                                               .mechanism());
+            }
+            ASSERT(0 == da.numBlocksTotal());
+
+            Map mY(X);  const Map& Y = mY;
+            ASSERT(X == Y);
+            ASSERT(&da == Y.begin()->second.get_allocator().mechanism());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting 'bsl::unordered_set'." << endl;
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Mech         mpa(&ta);
+            UnorderedSet mX(&mpa);  const UnorderedSet& X = mX;
+
+            for (int i = 0; i < 10; ++i) {
+                bsl::string s(S, &sa);
+                s.push_back(static_cast<char>('a' + i));
+                mX.insert(s);
+            }
+            ASSERT(10 == X.size());
+            for (UnorderedSet::const_iterator it = X.begin();
+                                              it != X.end(); ++it) {
+                ASSERT(&mpa == it->get_allocator().mechanism());
+            }
+            ASSERT(0 == da.numBlocksTotal());
+
+            UnorderedSet mY(X);  const UnorderedSet& Y = mY;
+            ASSERT(X == Y);
+            ASSERT(&da == Y.begin()->get_allocator().mechanism());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting 'bsl::basic_string'." << endl;
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Mech         mpa(&ta);
+            NestedVector mX(&mpa);  const NestedVector& X = mX;
+
+            for (int i = 0; i < 10; ++i) {
+                mX.push_back(BoundString(LONG, &mpa));
+                LOOP_ASSERT(i, &mpa == X[i].get_allocator().mechanism());
+                LOOP_ASSERT(i, X[i].get_allocator().isBound());
+            }
+            mX.emplace_back();
+            ASSERT(&mpa == X.back().get_allocator().mechanism());
+            ASSERT(X.back().get_allocator().isBound());
+            ASSERT(0 == da.numBlocksTotal());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting balance of calls." << endl;
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            my_CountingAllocator ca(&ta);
+            {
+                bsl::vector<int, Obj> mX(&ca);
+
+                for (int i = 0; i < 100; ++i) {
+                    mX.push_back(i);
+                }
+                ASSERT(0 < ca.d_numAllocate);
+            }
+            ASSERT(ca.d_numAllocate == ca.d_numDeallocateSized);
+            ASSERT(0 == ca.d_numDeallocate);
+            ASSERT(0 == da.numBlocksTotal());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ALLOCATE AND DEALLOCATE
+        //
+        // Concerns:
+        //: 1 'allocate(n)' calls 'allocate' on the mechanism, exactly once,
+        //:   with 'n * sizeof(TYPE)', whether or not the allocator is bound.
+        //:
+        //: 2 'deallocate(p, n)' calls 'deallocateSized' on the mechanism,
+        //:   exactly once, with 'p' and 'n * sizeof(TYPE)', whether or not
+        //:   the allocator is bound.
+        //:
+        //: 3 An allocator whose mechanism is of a type derived from
+        //:   'MECHANISM' calls the overrides of the derived type.
+        //:
+        //: 4 'address' returns the address of its argument, and 'max_size'
+        //:   returns the largest number of objects whose size fits in a
+        //:   'size_type'.
+        //
+        // Plan:
+        //: 1 For allocators bound to a 'my_CountingAllocator', and unbound
+        //:   allocators whose mechanism is a 'my_DerivedCountingAllocator',
+        //:   instantiated on 'int' and on a larger 'struct', allocate and
+        //:   deallocate arrays of several lengths and verify the counts and
+        //:   sizes recorded by the mechanism.  (C-1..3)
+        //:
+        //: 2 Verify 'address' and 'max_size' directly.  (C-4)
+        //
+        // Testing:
+        //   pointer allocate(size_type n, const void *hint = 0);
+        //   void deallocate(pointer p, size_type n = 1);
+        //   pointer address(reference x) const;
+        //   const_pointer address(const_reference x) const;
+        //   size_type max_size() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "ALLOCATE AND DEALLOCATE" << endl
+                                  << "=======================" << endl;
+
+        typedef bdlma::BoundAllocator<my_Big, my_CountingAllocator> BigObj;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        const int LENGTHS[]   = { 1, 2, 3, 7, 100 };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        if (verbose) cout << "\tTesting a bound allocator." << endl;
+        {
+            my_CountingAllocator ca(&ta);
+
+            Obj    mX(&ca);
+            BigObj mY(mX);
+
+            ASSERT(mX.isBound());
+            ASSERT(mY.isBound());
+
+            for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+                const int N = LENGTHS[ti];
+
+                int *p = mX.allocate(N);
+                LOOP_ASSERT(N, 2 * ti + 1 == ca.d_numAllocate);
+                LOOP_ASSERT(N, N * sizeof(int) == ca.d_lastSize);
+
+                my_Big *q = mY.allocate(N, p);
+                LOOP_ASSERT(N, 2 * ti + 2 == ca.d_numAllocate);
+                LOOP_ASSERT(N, N * sizeof(my_Big) == ca.d_lastSize);
+
+                mX.deallocate(p, N);
+                LOOP_ASSERT(N, 2 * ti + 1 == ca.d_numDeallocateSized);
+                LOOP_ASSERT(N, N * sizeof(int) == ca.d_lastSize);
+
+                mY.deallocate(q, N);
+                LOOP_ASSERT(N, 2 * ti + 2 == ca.d_numDeallocateSized);
+                LOOP_ASSERT(N, N * sizeof(my_Big) == ca.d_lastSize);
+            }
+            ASSERT(0 == ca.d_numDeallocate);
+
+            int *p = mX.allocate(1);
+            mX.deallocate(p);
+            ASSERT(sizeof(int) == ca.d_lastSize);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting an unbound allocator." << endl;
+        {
+            my_DerivedCountingAllocator dca(&ta);
+
+            Obj mX(static_cast<bslma::Allocator *>(&dca));
+
+            ASSERT(!mX.isBound());
+
+            for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+                const int N = LENGTHS[ti];
+
+                int *p = mX.allocate(N);
+                LOOP_ASSERT(N, ti + 1 == dca.d_numDerivedAllocate);
+                LOOP_ASSERT(N, ti + 1 == dca.d_numAllocate);
+                LOOP_ASSERT(N, N * sizeof(int) == dca.d_lastSize);
+
+                mX.deallocate(p, N);
+                LOOP_ASSERT(N, ti + 1 == dca.d_numDeallocateSized);
+                LOOP_ASSERT(N, N * sizeof(int) == dca.d_lastSize);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting 'address' and 'max_size'." << endl;
+        {
+            my_CountingAllocator ca(&ta);
+
+            const Obj    X(&ca);
+            const BigObj Y(&ca);
+
+            int       i  = 0;
+            const int CI = 0;
+            ASSERT(&i  == X.address(i));
+            ASSERT(&CI == X.address(CI));
+
+            const bsl::size_t MAX = ~bsl::size_t(0);
+            ASSERT(MAX / sizeof(int)    == X.max_size());
+            ASSERT(MAX / sizeof(my_Big) == Y.max_size());
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                          bsls::AssertTest::failTestDriver);
+
+            my_CountingAllocator ca(&ta);
+
+            Obj mX(&ca);
+
+            ASSERT_SAFE_PASS(mX.deallocate(mX.allocate(1)));
+            ASSERT_SAFE_FAIL(mX.allocate(mX.max_size() + 1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, BINDING, AND COMPARISON
+        //
+        // Concerns:
+        //: 1 An allocator created from a 'bslma::Allocator' pointer is bound
+        //:   if and only if the most-derived type of the mechanism is
+        //:   'MECHANISM'; in particular, it is not bound to a mechanism of a
+        //:   type derived from 'MECHANISM'.
+        //:
+        //: 2 An allocator created from a null pointer, or default-created,
+        //:   uses the currently installed default allocator.
+        //:
+        //: 3 An allocator created from a 'MECHANISM' pointer is bound.
+        //:
+        //: 4 Copies, rebound copies, and assigned-to allocators share the
+        //:   mechanism and the binding of the original.
+        //:
+        //: 5 Allocators compare equal if and only if they have the same
+        //:   mechanism, whatever their binding and value type, and compare
+        //:   with a 'bslma::Allocator' pointer by mechanism.
+        //:
+        //: 6 Precondition violations are detected in appropriate build modes.
+        //
+        // Plan:
+        //: 1 Create allocators in each of the ways, with mechanisms of type
+        //:   'my_CountingAllocator', 'my_DerivedCountingAllocator', and
+        //:   'bslma::TestAllocator', and verify 'mechanism', 'isBound', and
+        //:   'boundMechanism'.  (C-1..3)
+        //:
+        //: 2 Copy, rebind, and assign the allocators and verify the same.
+        //:   (C-4)
+        //:
+        //: 3 Compare the allocators with one another and with pointers.
+        //:   (C-5)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null 'MECHANISM' pointer, and for a 'MECHANISM'
+        //:   pointer to an object of a derived type.  (C-6)
+        //
+        // Testing:
+        //   BoundAllocator();
+        //   BoundAllocator(bslma::Allocator *mechanism);
+        //   BoundAllocator(MECHANISM *mechanism);
+        //   BoundAllocator(const BoundAllocator<ANY_TYPE, MECHANISM>& orig);
+        //   MECHANISM *boundMechanism() const;
+        //   bool isBound() const;
+        //   bslma::Allocator *mechanism() const;
+        //   bool operator==(const BoundAllocator<T1, M>&, ... <T2, M>&);
+        //   bool operator!=(const BoundAllocator<T1, M>&, ... <T2, M>&);
+        //   bool operator==(const BoundAllocator<T, M>&, const Allocator *);
+        //   bool operator==(const Allocator *, const BoundAllocator<T, M>&);
+        //   bool operator!=(const BoundAllocator<T, M>&, const Allocator *);
+        //   bool operator!=(const Allocator *, const BoundAllocator<T, M>&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CREATORS, BINDING, AND COMPARISON"
+                          << endl << "================================="
+                          << endl;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator        ta(veryVeryVerbose);
+        my_CountingAllocator        ca(&ta);
+        my_CountingAllocator        ca2(&ta);
+        my_DerivedCountingAllocator dca(&ta);
+
+        bslma::Allocator *const CA  = &ca;
+        bslma::Allocator *const DCA = &dca;
+
+        if (verbose) cout << "\tTesting creators." << endl;
+        {
+            const Obj A;
+            ASSERT(&da == A.mechanism());
+            ASSERT(!A.isBound());
+            ASSERT(0 == A.boundMechanism());
+
+            const Obj B(static_cast<bslma::Allocator *>(0));
+            ASSERT(&da == B.mechanism());
+            ASSERT(!B.isBound());
+
+            const Obj C(static_cast<bslma::Allocator *>(&ta));
+            ASSERT(&ta == C.mechanism());
+            ASSERT(!C.isBound());
+
+            const Obj D(CA);
+            ASSERT(CA  == D.mechanism());
+            ASSERT(&ca == D.boundMechanism());
+            ASSERT(D.isBound());
+
+            const Obj E(&ca);
+            ASSERT(CA  == E.mechanism());
+            ASSERT(&ca == E.boundMechanism());
+            ASSERT(E.isBound());
+
+            const Obj F(DCA);
+            ASSERT(DCA == F.mechanism());
+            ASSERT(0   == F.boundMechanism());
+            ASSERT(!F.isBound());
+        }
+
+        if (verbose) cout << "\tTesting copy, rebind, and assignment."
+                          << endl;
+        {
+            const Obj X(CA);
+            const Obj U(DCA);
+
+            const Obj Y(X);
+            ASSERT(CA  == Y.mechanism());
+            ASSERT(&ca == Y.boundMechanism());
+
+            const DoubleObj Z(X);
+            ASSERT(CA  == Z.mechanism());
+            ASSERT(&ca == Z.boundMechanism());
+
+            const DoubleObj W(U);
+            ASSERT(DCA == W.mechanism());
+            ASSERT(!W.isBound());
+
+            Obj mV(U);  const Obj& V = mV;
+            ASSERT(!V.isBound());
+
+            mV = X;
+            ASSERT(CA  == V.mechanism());
+            ASSERT(&ca == V.boundMechanism());
+
+            mV = U;
+            ASSERT(DCA == V.mechanism());
+            ASSERT(!V.isBound());
+        }
+
+        if (verbose) cout << "\tTesting comparison." << endl;
+        {
+            const Obj       X(&ca);
+            const DoubleObj Y(CA);
+            const Obj       Z(&ca2);
+            const Obj       U(DCA);
+
+            ASSERT(  X == Y);    ASSERT(!(X != Y));
+            ASSERT(  Y == X);    ASSERT(!(Y != X));
+            ASSERT(!(X == Z));   ASSERT(  X != Z);
+            ASSERT(!(X == U));   ASSERT(  X != U);
+
+            ASSERT(  X  == CA);  ASSERT(!(X  != CA));
+            ASSERT(  CA == X);   ASSERT(!(CA != X));
+            ASSERT(!(X  == DCA)); ASSERT(  X  != DCA);
+            ASSERT(!(DCA == X)); ASSERT(  DCA != X);
+            ASSERT(  U  == DCA); ASSERT(  DCA == U);
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                          bsls::AssertTest::failTestDriver);
+
+            ASSERT_SAFE_PASS(Obj(&ca).isBound());
+            ASSERT_SAFE_FAIL(
+                  Obj(static_cast<my_CountingAllocator *>(0)).isBound());
+            ASSERT_SAFE_FAIL(
+                  Obj(static_cast<my_CountingAllocator *>(&dca)).isBound());
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a vector whose allocator is bound to a
+        //:   'bdlma::SequentialAllocator', append elements to it, and verify
+        //:   that the memory comes from the sequential allocator.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        typedef bdlma::BoundAllocator<int, bdlma::SequentialAllocator> Alloc;
+
+        bslma::TestAllocator         da(veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            bdlma::SequentialAllocator sa(&ta);
+
+            bsl::vector<int, Alloc> mX(&sa);
+            const bsl::vector<int, Alloc>& X = mX;
+
+            ASSERT(&sa == X.get_allocator().mechanism());
+            ASSERT(&sa == X.get_allocator().boundMechanism());
+
+            for (int i = 0; i < 100; ++i) {
+                mX.push_back(i);
+            }
+            ASSERT(100 == X.size());
+            ASSERT(99  == X.back());
+            ASSERT(0   <  ta.numBlocksInUse());
+
+            bsl::vector<int, Alloc> mY(X);
+            ASSERT(X == mY);
+            ASSERT(&da == mY.get_allocator().mechanism());
+            ASSERT(!mY.get_allocator().isBound());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
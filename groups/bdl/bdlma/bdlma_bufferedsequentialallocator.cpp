@@ -30,6 +30,17 @@ void *BufferedSequentialAllocator::allocate(size_type size)
     return d_pool.allocate(size);
 }
 
+void *BufferedSequentialAllocator::allocateAligned(size_type size,
+                                                   size_type alignment)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    return d_pool.allocateAligned(size, static_cast<int>(alignment));
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
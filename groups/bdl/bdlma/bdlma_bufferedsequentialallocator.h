@@ -12,7 +12,8 @@ BSLS_IDENT("$Id: $")
 //@CLASSES:
 //  bdlma::BufferedSequentialAllocator: allocator using an external buffer
 //
-//@SEE_ALSO: bdlma_bufferedsequentialpool, bdlma_sequentialallocator
+//@SEE_ALSO: bdlma_bufferedsequentialpool, bdlma_sequentialallocator,
+//           bdlma_checkpoint
 //
 //@DESCRIPTION: This component provides a concrete mechanism,
 // 'bdlma::BufferedSequentialAllocator', that implements the
@@ -90,6 +91,24 @@ BSLS_IDENT("$Id: $")
 // wasted depends on whether natural alignment, maximum alignment, or 1-byte
 // alignment is used (see 'bsls_alignment' for more details).
 //
+///Checkpoints
+///-----------
+// The 'checkpoint' method returns a 'bdlma::Checkpoint' recording the current
+// allocation state of the allocator, and the 'rewind' method restores the
+// allocator to a previously recorded state, making all memory allocated since
+// available for reuse.  A 'bdlma::CheckpointGuard' can be used to rewind the
+// allocator at the end of a scope, discarding the memory allocated by, e.g., a
+// failed speculative parse.  See 'bdlma_checkpoint' for details.
+//
+///Retaining Memory on Release
+///---------------------------
+// The 'setRetainOnRelease' method configures 'release' to keep the largest
+// block of memory obtained from the allocator supplied at construction (and,
+// optionally, further blocks up to a byte budget) for reuse, rather than
+// deallocating it, so that an allocator released after each of a sequence of
+// similar tasks stops allocating from that allocator once it reaches a steady
+// state.
+//
 ///Usage
 ///-----
 ///Example 1: Using 'bdlma::BufferedSequentialAllocator' with Exact Calculation
@@ -184,6 +203,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlma_bufferedsequentialpool.h>
 #endif
 
+#ifndef INCLUDED_BDLMA_CHECKPOINT
+#include <bdlma_checkpoint.h>
+#endif
+
 #ifndef INCLUDED_BDLMA_MANAGEDALLOCATOR
 #include <bdlma_managedallocator.h>
 #endif
@@ -323,19 +346,70 @@ class BufferedSequentialAllocator : public ManagedAllocator {
         // memory space in the external buffer supplied at construction, use
         // memory obtained from the allocator supplied at construction.
 
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return the address of a contiguous block of memory of the specified
+        // 'size' (in bytes) aligned to the specified 'alignment', which may
+        // exceed the maximal alignment of the platform.  If 'size' is 0, no
+        // memory is allocated and 0 is returned.  Only the bytes needed to
+        // reach the next suitably aligned address are skipped.  The behavior
+        // is undefined unless 'alignment' is a positive power of two.
+
     virtual void deallocate(void *address);
         // This method has no effect on the memory block at the specified
         // 'address' as all memory allocated by this allocator is managed.  The
         // behavior is undefined unless 'address' is 0, or was allocated by
         // this allocator and has not already been deallocated.
 
+    virtual void deallocateSized(void *address, size_type size);
+        // This method has no effect on the memory block at the specified
+        // 'address' of the specified 'size' as all memory allocated by this
+        // allocator is managed.  Note that this override lets a caller that
+        // binds statically to this type (e.g., 'bdlma::BoundAllocator')
+        // return memory without a call through the virtual table.  The
+        // behavior is undefined unless 'address' is 0, or was allocated by
+        // this allocator and has not already been deallocated.
+
     virtual void release();
         // Release all memory currently allocated through this allocator.  This
         // method deallocates all memory (if any) allocated with the allocator
         // provided at construction, and makes the memory from the entire
         // external buffer supplied at construction available for subsequent
-        // allocations, but has no effect on the contents of the buffer.  Note
-        // that this allocator is reset to its initial state by this method.
+        // allocations, but has no effect on the contents of the buffer.  If
+        // retention was enabled by 'setRetainOnRelease', some of the memory
+        // allocated with the allocator provided at construction is kept for
+        // reuse by subsequent allocations instead of being deallocated.  Note
+        // that this allocator is otherwise reset to its initial state by this
+        // method.
+
+    void rewind(const Checkpoint& checkpoint);
+        // Restore this allocator to the allocation state recorded by the
+        // specified 'checkpoint', making all memory allocated through this
+        // allocator since 'checkpoint' was taken available for subsequent
+        // allocations.  The behavior is undefined unless 'checkpoint' was
+        // returned by the 'checkpoint' method of this allocator, and neither
+        // 'release' nor 'rewind' to an earlier checkpoint was called since.
+
+    void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+        // Configure subsequent calls to 'release' to retain memory if the
+        // specified 'retain' flag is 'true', and to deallocate all memory
+        // (the default behavior) otherwise.  If retaining, 'release' keeps
+        // the largest block obtained from the allocator supplied at
+        // construction, together with further blocks as fit within the
+        // optionally specified 'maxRetainedBytes' (including the largest
+        // block), for reuse by subsequent allocations.  If 'maxRetainedBytes'
+        // is not specified, only the largest block is retained.  The behavior
+        // is undefined unless '0 <= maxRetainedBytes'.
+
+    Checkpoint checkpoint() const;
+        // Return the current allocation state of this allocator, suitable for
+        // later passing to 'rewind'.  Note that no memory is allocated.
+
+    // ACCESSORS
+    virtual bool hasNoOpDeallocate() const;
+        // Return 'true', as 'deallocate' and 'deallocateSized' have no effect
+        // for this allocator.  Note that containers using this allocator may
+        // therefore skip returning the memory of wink-out-safe elements on
+        // destruction (see 'bslma_winkoututil').
 };
 
 // ============================================================================
@@ -442,12 +516,43 @@ void BufferedSequentialAllocator::deallocate(void *)
 {
 }
 
+inline
+void BufferedSequentialAllocator::deallocateSized(void *, size_type)
+{
+}
+
 inline
 void BufferedSequentialAllocator::release()
 {
     d_pool.release();
 }
 
+inline
+void BufferedSequentialAllocator::rewind(const Checkpoint& checkpoint)
+{
+    d_pool.rewind(checkpoint);
+}
+
+inline
+void BufferedSequentialAllocator::setRetainOnRelease(bool retain,
+                                                     int  maxRetainedBytes)
+{
+    d_pool.setRetainOnRelease(retain, maxRetainedBytes);
+}
+
+// ACCESSORS
+inline
+Checkpoint BufferedSequentialAllocator::checkpoint() const
+{
+    return d_pool.checkpoint();
+}
+
+inline
+bool BufferedSequentialAllocator::hasNoOpDeallocate() const
+{
+    return true;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -68,11 +68,18 @@ using namespace bsl;
 //
 // // MANIPULATORS
 // [ 2] void *allocate(size_type size);
+// [ 2] void *allocateAligned(size_type size, size_type alignment);
 // [ 3] void deallocate(void *address);
+// [ 3] void deallocateSized(void *address, size_type size);
 // [ 4] void release();
+// [ 6] void rewind(const Checkpoint& checkpoint);
+// [ 7] void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+//
+// // ACCESSORS
+// [ 6] Checkpoint checkpoint() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 6] USAGE TEST
+// [ 8] USAGE TEST
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -247,7 +254,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 6: {
+      case 8: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -328,6 +335,137 @@ int main(int argc, char *argv[])
             if (verbose) P(objectAllocator.numBytesTotal())
         }
 
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // 'setRetainOnRelease' TEST
+        //
+        // Concerns:
+        //   1) That 'setRetainOnRelease' configures 'release' to retain memory
+        //      obtained from the allocator supplied at construction.
+        //
+        //   2) That retained memory is reused by subsequent allocations.
+        //
+        //   3) That disabling retention restores the default behavior.
+        //
+        // Plan:
+        //   Enable retention, and repeatedly allocate and 'release'.  Verify,
+        //   using the test allocator, that one block remains in use after
+        //   each 'release', and that later cycles allocate no more memory from
+        //   the test allocator.  Then disable retention, and verify that
+        //   'release' deallocates all memory.
+        //
+        // Testing:
+        //   void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'setRetainOnRelease' TEST" << endl
+                                  << "=========================" << endl;
+
+        char *buffer = bufferStorage.buffer();
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        {
+            Obj mX(buffer, BUFFER_SIZE, &ta);
+
+            mX.setRetainOnRelease(true);
+
+            bsls::Types::Int64 numBlocksTotal = 0;
+
+            for (int cycle = 0; cycle < 8; ++cycle) {
+                for (int i = 0; i < 100; ++i) {
+                    mX.allocate(100);
+                }
+
+                mX.release();
+                ASSERTV(cycle, 1 == ta.numBlocksInUse());
+
+                if (2 <= cycle) {
+                    ASSERTV(cycle, numBlocksTotal == ta.numBlocksTotal());
+                }
+                numBlocksTotal = ta.numBlocksTotal();
+            }
+
+            mX.setRetainOnRelease(false);
+            mX.release();
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // 'checkpoint' AND 'rewind' TEST
+        //
+        // Concerns:
+        //   1) That 'rewind' to a checkpoint taken within the external buffer
+        //      deallocates all memory obtained from the allocator supplied at
+        //      construction.
+        //
+        //   2) That allocation following 'rewind' resumes at the position
+        //      recorded by 'checkpoint'.
+        //
+        //   3) That a 'bdlma::CheckpointGuard' can manage the allocator.
+        //
+        // Plan:
+        //   For concerns 1 and 2, allocate from the external buffer, take a
+        //   checkpoint, and allocate enough additional memory to trigger
+        //   several dynamic allocations.  Invoke 'rewind' and verify, using
+        //   the test allocator, that no memory remains allocated, and that the
+        //   next allocation returns the same address as the first allocation
+        //   following the checkpoint.
+        //
+        //   For concern 3, repeatedly allocate under a guard and verify that
+        //   no memory remains allocated from the test allocator.
+        //
+        // Testing:
+        //   void rewind(const Checkpoint& checkpoint);
+        //   Checkpoint checkpoint() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'checkpoint' AND 'rewind' TEST" << endl
+                                  << "==============================" << endl;
+
+        char *buffer = bufferStorage.buffer();
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        {
+            Obj mX(buffer, BUFFER_SIZE, &ta);  const Obj& X = mX;
+
+            mX.allocate(8);
+
+            const bdlma::Checkpoint C = X.checkpoint();
+
+            void *p = mX.allocate(8);
+            for (int i = 0; i < 20; ++i) {
+                mX.allocate(BUFFER_SIZE / 2);
+            }
+            ASSERT(0 < ta.numBlocksInUse());
+
+            mX.rewind(C);
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+            ASSERT(p == mX.allocate(8));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nTesting 'bdlma::CheckpointGuard'." << endl;
+        {
+            Obj mX(buffer, BUFFER_SIZE, &ta);
+
+            for (int i = 1; i <= 32; ++i) {
+                bdlma::CheckpointGuard<Obj> guard(&mX);
+
+                for (int j = 0; j < i; ++j) {
+                    mX.allocate(i * 16);
+                }
+            }
+
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
       } break;
       case 5: {
         // --------------------------------------------------------------------
@@ -520,7 +658,7 @@ int main(int argc, char *argv[])
         // 'deallocate' TEST
         //
         // Concerns:
-        //   That 'deallocate' has no effect.
+        //   That 'deallocate' and 'deallocateSized' have no effect.
         //
         // Plan:
         //   Create a buffered sequential allocator initialized with a test
@@ -531,6 +669,7 @@ int main(int argc, char *argv[])
         //
         // Testing:
         //   void deallocate(void *address);
+        //   void deallocateSized(void *address, size_type size);
         // --------------------------------------------------------------------
 
         if (verbose) cout << endl << "'deallocate' TEST" << endl
@@ -550,8 +689,10 @@ int main(int argc, char *argv[])
         for (int i = 0; i < NUM_DATA; ++i) {
             const int SIZE = DATA[i];
             void *p = mX.allocate(SIZE);
+            void *q = mX.allocate(SIZE);
             const int numBytesInUse = objectAllocator.numBytesInUse();
             mX.deallocate(p);
+            mX.deallocateSized(q, SIZE);
             LOOP_ASSERT(i, numBytesInUse == objectAllocator.numBytesInUse());
             LOOP_ASSERT(i, lastNumBytesInUse <=
                                               objectAllocator.numBytesInUse());
@@ -597,6 +738,7 @@ int main(int argc, char *argv[])
         //   bdlma::BufferedSequentialAllocator(*buf, sz, max, AS, *a = 0);
         //   bdlma::BufferedSequentialAllocator(*buf, sz, max, GS, AS, *a = 0);
         //   void *allocate(size_type size);
+        //   void *allocateAligned(size_type size, size_type alignment);
         // --------------------------------------------------------------------
 
         if (verbose) cout << endl << "CTOR / ALLOCATE TEST" << endl
@@ -863,6 +1005,29 @@ int main(int argc, char *argv[])
             }
         }
 
+        if (verbose) cout << "\nTesting 'allocateAligned'." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+            Obj                  mX(buffer,
+                                    BUFFER_SIZE,
+                                    bsls::Alignment::BSLS_BYTEALIGNED,
+                                    &ta);
+            bslma::Allocator&    a = mX;
+
+            ASSERT(0 == a.allocateAligned(0, 64));
+
+            for (int align = 1; align <= 4096; align <<= 1) {
+                char *p = static_cast<char *>(a.allocate(1));
+                *p = 'x';
+
+                p = static_cast<char *>(a.allocateAligned(3, align));
+
+                LOOP_ASSERT(align, 0 == bsls::Types::UintPtr(p) % align);
+
+                p[0] = p[1] = p[2] = 'x';
+            }
+        }
+
 #undef GEO
 #undef CON
 
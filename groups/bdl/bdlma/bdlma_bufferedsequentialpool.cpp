@@ -4,6 +4,7 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(bdlma_bufferedsequentialpool_cpp,"$Id$ $CSID$")
 
+#include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
 #include <bsls_performancehint.h>
 
@@ -55,6 +56,7 @@ BufferedSequentialPool::BufferedSequentialPool(
 , d_buffer(buffer, size)
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(buffer);
@@ -71,6 +73,7 @@ BufferedSequentialPool::BufferedSequentialPool(
 , d_buffer(buffer, size)
 , d_growthStrategy(growthStrategy)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(buffer);
@@ -87,6 +90,7 @@ BufferedSequentialPool::BufferedSequentialPool(
 , d_buffer(buffer, size, alignmentStrategy)
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(buffer);
@@ -104,6 +108,7 @@ BufferedSequentialPool::BufferedSequentialPool(
 , d_buffer(buffer, size, alignmentStrategy)
 , d_growthStrategy(growthStrategy)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(buffer);
@@ -120,6 +125,7 @@ BufferedSequentialPool::BufferedSequentialPool(
 , d_buffer(buffer, size)
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_maxBufferSize(maxBufferSize)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(buffer);
@@ -138,6 +144,7 @@ BufferedSequentialPool::BufferedSequentialPool(
 , d_buffer(buffer, size)
 , d_growthStrategy(growthStrategy)
 , d_maxBufferSize(maxBufferSize)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(buffer);
@@ -156,6 +163,7 @@ BufferedSequentialPool::BufferedSequentialPool(
 , d_buffer(buffer, size, alignmentStrategy)
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_maxBufferSize(maxBufferSize)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(buffer);
@@ -175,6 +183,7 @@ BufferedSequentialPool::BufferedSequentialPool(
 , d_buffer(buffer, size, alignmentStrategy)
 , d_growthStrategy(growthStrategy)
 , d_maxBufferSize(maxBufferSize)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(buffer);
@@ -192,20 +201,61 @@ void *BufferedSequentialPool::allocate(bsls::Types::size_type size)
         return result;                                                // RETURN
     }
 
-    const int nextSize = calculateNextBufferSize(size);
+    int nextSize = calculateNextBufferSize(size);
 
     if (nextSize < static_cast<int>(size)) {
         return d_blockList.allocate(size);                            // RETURN
     }
 
-    // Manage the new buffer using 'BufferManager'.
+    // Manage the new buffer using 'BufferManager'.  A retained block reused
+    // for the new buffer may be larger than 'nextSize', in which case all of
+    // it is used.
 
-    d_buffer.replaceBuffer(static_cast<char *>(d_blockList.allocate(nextSize)),
-                           nextSize);
+    char *buffer = static_cast<char *>(
+                                   d_blockList.allocateAndExpand(&nextSize));
+    d_buffer.replaceBuffer(buffer, nextSize);
 
     return d_buffer.allocateRaw(size);
 }
 
+void *BufferedSequentialPool::allocateAligned(bsls::Types::size_type size,
+                                              int                    alignment)
+{
+    BSLS_ASSERT(0 < size);
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    void *result = d_buffer.allocateAligned(size, alignment);
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(result)) {
+        return result;                                                // RETURN
+    }
+
+    // New buffers are maximally aligned, so at most the difference between
+    // 'alignment' and the maximal alignment need be skipped to align a block.
+
+    const int padding = alignment > bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+                      ? alignment - bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+                      : 0;
+
+    const int paddedSize = static_cast<int>(size) + padding;
+    int       nextSize   = calculateNextBufferSize(paddedSize);
+
+    if (nextSize < paddedSize) {
+        char *block = static_cast<char *>(d_blockList.allocate(paddedSize));
+        return block + bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                          block,
+                                                          alignment); // RETURN
+    }
+
+    // Manage the new buffer using 'BufferManager'.
+
+    char *buffer = static_cast<char *>(
+                                   d_blockList.allocateAndExpand(&nextSize));
+    d_buffer.replaceBuffer(buffer, nextSize);
+
+    return d_buffer.allocateAlignedRaw(static_cast<int>(size), alignment);
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
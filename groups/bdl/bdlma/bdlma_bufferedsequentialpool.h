@@ -12,7 +12,7 @@ BSLS_IDENT("$Id: $")
 //@CLASSES:
 //  bdlma::BufferedSequentialPool: pool using an external buffer and a fallback
 //
-//@SEE_ALSO: bdlma_buffermanager, bdlma_sequentialpool
+//@SEE_ALSO: bdlma_buffermanager, bdlma_sequentialpool, bdlma_checkpoint
 //
 //@DESCRIPTION: This component provides a maximally efficient sequential memory
 // pool, 'bdlma::BufferedSequentialPool', that dispenses heterogeneous memory
@@ -47,6 +47,28 @@ BSLS_IDENT("$Id: $")
 // 'size <= maxBufferSize', where 'size' is the extent (in bytes) of the
 // external buffer supplied at construction.
 //
+///Checkpoints
+///-----------
+// The 'checkpoint' method returns a 'bdlma::Checkpoint' recording the current
+// allocation state of the pool, and the 'rewind' method restores the pool to
+// a previously recorded state, making all memory allocated since available
+// for reuse.  If the checkpoint was taken while the external buffer was still
+// in use, rewinding to it returns every dynamically-allocated buffer to the
+// allocator supplied at construction and resumes allocating from the external
+// buffer.  A 'bdlma::CheckpointGuard' can be used to rewind the pool at the
+// end of a scope.  Note that a call to 'release' invalidates all outstanding
+// checkpoints.
+//
+///Retaining Memory on Release
+///---------------------------
+// By default, 'release' returns all dynamically-allocated memory to the
+// allocator supplied at construction.  Calling 'setRetainOnRelease' configures
+// 'release' instead to keep the largest dynamically-allocated block -- and,
+// optionally, further blocks up to a total byte budget -- for reuse once the
+// external buffer is exhausted again.  A pool that is released after each of a
+// sequence of similar tasks, and whose tasks outgrow the external buffer, then
+// soon stops allocating from the allocator supplied at construction.
+//
 ///Warning
 ///-------
 // Note that, even when a buffer having 'n' bytes of memory is supplied at
@@ -302,6 +324,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlma_buffermanager.h>
 #endif
 
+#ifndef INCLUDED_BDLMA_CHECKPOINT
+#include <bdlma_checkpoint.h>
+#endif
+
 #ifndef INCLUDED_BDLMA_INFREQUENTDELETEBLOCKLIST
 #include <bdlma_infrequentdeleteblocklist.h>
 #endif
@@ -314,6 +340,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_alignment.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
 #ifndef INCLUDED_BSLS_BLOCKGROWTH
 #include <bsls_blockgrowth.h>
 #endif
@@ -360,6 +390,10 @@ class BufferedSequentialPool {
 
     int                  d_maxBufferSize;    // maximum internal buffer size
 
+    int                  d_maxRetainedBytes; // budget for memory retained by
+                                             // 'release' (negative if none
+                                             // is retained)
+
     InfrequentDeleteBlockList
                          d_blockList;        // memory manager used to supply
                                              // dynamically allocated memory
@@ -465,6 +499,16 @@ class BufferedSequentialPool {
         // memory obtained from the allocator supplied at construction.  The
         // behavior is undefined unless '0 < size'.
 
+    void *allocateAligned(bsls::Types::size_type size, int alignment);
+        // Return the address of a contiguous block of memory of the specified
+        // 'size' (in bytes) aligned to the specified 'alignment', which may
+        // exceed the maximal alignment of the platform.  The alignment
+        // strategy specified at construction is not used.  If the allocation
+        // request exceeds the remaining free memory space in the current
+        // buffer, use memory obtained from the allocator supplied at
+        // construction.  The behavior is undefined unless '0 < size' and
+        // 'alignment' is a positive power of two.
+
     void deallocate(void*) {}
 
     template <class TYPE>
@@ -484,8 +528,41 @@ class BufferedSequentialPool {
         // method deallocates all memory (if any) allocated with the allocator
         // provided at construction, and makes the memory from the entire
         // external buffer supplied at construction available for subsequent
-        // allocations, but has no effect on the contents of the buffer.  Note
-        // that this pool is reset to its initial state by this method.
+        // allocations, but has no effect on the contents of the buffer.  If
+        // retention was enabled by 'setRetainOnRelease', some of the memory
+        // allocated with the allocator provided at construction is kept for
+        // reuse by subsequent allocations instead of being deallocated.  Note
+        // that this pool is otherwise reset to its initial state by this
+        // method.
+
+    void rewind(const Checkpoint& checkpoint);
+        // Restore this pool to the allocation state recorded by the specified
+        // 'checkpoint', making all memory allocated through this pool since
+        // 'checkpoint' was taken available for subsequent allocations.
+        // Buffers and blocks obtained from the allocator supplied at
+        // construction after 'checkpoint' was taken are deallocated.  The
+        // behavior is undefined unless 'checkpoint' was returned by the
+        // 'checkpoint' method of this pool, and neither 'release' nor 'rewind'
+        // to an earlier checkpoint was called since.
+
+    void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+        // Configure subsequent calls to 'release' to retain memory if the
+        // specified 'retain' flag is 'true', and to deallocate all memory
+        // (the default behavior) otherwise.  If retaining, 'release' keeps
+        // the largest block obtained from the allocator supplied at
+        // construction, together with further blocks as fit within the
+        // optionally specified 'maxRetainedBytes' (including the largest
+        // block); retained memory is used to satisfy subsequent requests for
+        // dynamically-allocated buffers (and separate blocks) before more
+        // memory is obtained from the allocator.  If 'maxRetainedBytes' is not
+        // specified, only the largest block is retained.  The behavior is
+        // undefined unless '0 <= maxRetainedBytes'.  Note that all memory is
+        // deallocated when this pool is destroyed.
+
+    // ACCESSORS
+    Checkpoint checkpoint() const;
+        // Return the current allocation state of this pool, suitable for
+        // later passing to 'rewind'.  Note that no memory is allocated.
 };
 
 }  // close package namespace
@@ -595,7 +672,43 @@ inline
 void BufferedSequentialPool::release()
 {
     d_buffer.replaceBuffer(d_initialBuffer_p, d_initialSize);
-    d_blockList.release();
+
+    if (0 <= d_maxRetainedBytes) {
+        d_blockList.releaseRetaining(d_maxRetainedBytes);
+    }
+    else {
+        d_blockList.release();
+    }
+}
+
+inline
+void BufferedSequentialPool::rewind(const Checkpoint& checkpoint)
+{
+    BSLS_ASSERT_SAFE(checkpoint.buffer());
+
+    d_blockList.releaseAfter(checkpoint.lastBlock());
+
+    d_buffer.replaceBuffer(checkpoint.buffer(), checkpoint.bufferSize());
+    d_buffer.setCursor(checkpoint.cursor());
+}
+
+inline
+void BufferedSequentialPool::setRetainOnRelease(bool retain,
+                                                int  maxRetainedBytes)
+{
+    BSLS_ASSERT_SAFE(0 <= maxRetainedBytes);
+
+    d_maxRetainedBytes = retain ? maxRetainedBytes : -1;
+}
+
+// ACCESSORS
+inline
+Checkpoint BufferedSequentialPool::checkpoint() const
+{
+    return Checkpoint(d_buffer.buffer(),
+                      d_buffer.bufferSize(),
+                      d_buffer.cursor(),
+                      d_blockList.lastBlock());
 }
 
 }  // close package namespace
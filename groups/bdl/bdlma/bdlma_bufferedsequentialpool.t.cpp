@@ -13,6 +13,7 @@
 #include <bsls_alignmentutil.h>
 #include <bsls_asserttest.h>
 
+#include <bsl_climits.h>
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>
 #include <bsl_iostream.h>
@@ -65,14 +66,20 @@ using namespace bsl;
 //
 // // MANIPULATORS
 // [ 4] void *allocate(size_type size);
+// [ 9] void *allocateAligned(size_type size, int alignment);
 // [ 6] void deleteObjectRaw(const TYPE *object);
 // [ 6] void deleteObject(const TYPE *object);
 // [ 5] void release();
+// [10] void rewind(const Checkpoint& checkpoint);
+// [11] void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+//
+// // ACCESSORS
+// [10] Checkpoint checkpoint() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] HELPER FUNCTION: 'int blockSize(numBytes)'
 // [ 8] FREE FUNCTION: 'operator new(size_t, bdlma::BufferedSequentialPool)'
-// [ 9] USAGE TEST
+// [12] USAGE TEST
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -486,7 +493,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 9: {
+      case 12: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -508,6 +515,370 @@ int main(int argc, char *argv[])
                           << "USAGE EXAMPLE" << endl
                           << "=============" << endl;
 
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // 'setRetainOnRelease' TEST
+        //
+        // Concerns:
+        //: 1 By default, 'release' deallocates all memory obtained from the
+        //:   allocator supplied at construction.
+        //:
+        //: 2 With retention enabled, 'release' retains only the largest block
+        //:   if no budget is specified.
+        //:
+        //: 3 With retention enabled, 'release' retains further blocks within
+        //:   the specified budget.
+        //:
+        //: 4 Retained memory is reused, so that a steady-state cycle of
+        //:   allocations followed by 'release' obtains no more memory from the
+        //:   allocator supplied at construction.
+        //:
+        //: 5 Disabling retention restores the default behavior.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate, 'release', and verify that no memory remains in use
+        //:   from the test allocator.  (C-1)
+        //:
+        //: 2 With retention enabled, 'release' keeps one block allocated from
+        //:   the test allocator, and a cycle of identical allocations
+        //:   outgrowing the external buffer, followed by 'release', stops
+        //:   allocating from the test allocator after the first few cycles.
+        //:   (C-2, 4)
+        //:
+        //: 3 Repeat P-2 with an unlimited budget, and verify that every block
+        //:   is retained and that no cycle after the first allocates from the
+        //:   test allocator.  (C-3..4)
+        //:
+        //: 4 Disable retention and verify that 'release' deallocates all
+        //:   memory.  (C-5)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-6)
+        //
+        // Testing:
+        //   void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'setRetainOnRelease' TEST" << endl
+                                  << "=========================" << endl;
+
+        enum { NUM_CYCLES = 8, NUM_ALLOCS = 100, ALLOC_SIZE = 100 };
+
+        if (verbose) cout << "\nTesting the default behavior." << endl;
+        {
+            bsls::AlignedBuffer<BUFFER_SIZE> buffer;
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            Obj mX(buffer.buffer(), BUFFER_SIZE, &ta);
+
+            for (int i = 0; i < NUM_ALLOCS; ++i) {
+                bsl::memset(mX.allocate(ALLOC_SIZE), 0xa5, ALLOC_SIZE);
+            }
+            ASSERT(1 < ta.numBlocksInUse());
+
+            mX.release();
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nRetaining the largest block." << endl;
+        {
+            bsls::AlignedBuffer<BUFFER_SIZE> buffer;
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            Obj mX(buffer.buffer(), BUFFER_SIZE, &ta);
+
+            mX.setRetainOnRelease(true);
+
+            bsls::Types::Int64 numBlocksTotal = 0;
+
+            for (int cycle = 0; cycle < NUM_CYCLES; ++cycle) {
+                for (int i = 0; i < NUM_ALLOCS; ++i) {
+                    bsl::memset(mX.allocate(ALLOC_SIZE), 0xa5, ALLOC_SIZE);
+                }
+
+                mX.release();
+                ASSERTV(cycle, 1 == ta.numBlocksInUse());
+
+                if (2 <= cycle) {
+                    ASSERTV(cycle, numBlocksTotal == ta.numBlocksTotal());
+                }
+                numBlocksTotal = ta.numBlocksTotal();
+            }
+
+            if (verbose) cout << "\nDisabling retention." << endl;
+
+            mX.setRetainOnRelease(false);
+            mX.allocate(ALLOC_SIZE);
+            mX.release();
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nRetaining within a budget." << endl;
+        {
+            bsls::AlignedBuffer<BUFFER_SIZE> buffer;
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            Obj mX(buffer.buffer(), BUFFER_SIZE, &ta);
+
+            mX.setRetainOnRelease(true, INT_MAX);
+
+            bsls::Types::Int64 numBlocksTotal = 0;
+
+            for (int cycle = 0; cycle < NUM_CYCLES; ++cycle) {
+                for (int i = 0; i < NUM_ALLOCS; ++i) {
+                    bsl::memset(mX.allocate(ALLOC_SIZE), 0xa5, ALLOC_SIZE);
+                }
+
+                const bsls::Types::Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+                mX.release();
+                ASSERTV(cycle, NUM_BLOCKS == ta.numBlocksInUse());
+
+                if (1 <= cycle) {
+                    ASSERTV(cycle, numBlocksTotal == ta.numBlocksTotal());
+                }
+                numBlocksTotal = ta.numBlocksTotal();
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bsls::AlignedBuffer<BUFFER_SIZE> buffer;
+            Obj mX(buffer.buffer(), BUFFER_SIZE, &objectAllocator);
+
+            ASSERT_SAFE_PASS(mX.setRetainOnRelease(true,  0));
+            ASSERT_SAFE_PASS(mX.setRetainOnRelease(false, 0));
+            ASSERT_SAFE_FAIL(mX.setRetainOnRelease(true, -1));
+        }
+      } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // 'checkpoint' AND 'rewind' TEST
+        //
+        // Concerns:
+        //: 1 Rewinding to a checkpoint taken in the external buffer makes the
+        //:   memory allocated since available again, and deallocates every
+        //:   buffer and block obtained from the allocator since.
+        //:
+        //: 2 Rewinding to a checkpoint taken in a dynamically-allocated buffer
+        //:   resumes allocation in that buffer at the checkpointed cursor, and
+        //:   retains the buffer.
+        //:
+        //: 3 A 'bdlma::CheckpointGuard' managing the pool keeps the memory
+        //:   footprint of repeated speculative allocation constant.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate from the external buffer, take a checkpoint, and
+        //:   allocate enough to overflow into several dynamically-allocated
+        //:   buffers.  Rewind, and verify that no memory is in use from the
+        //:   test allocator and that the next allocation reuses the first
+        //:   address allocated after the checkpoint.  (C-1)
+        //:
+        //: 2 Overflow the external buffer, take a checkpoint, allocate
+        //:   further, and rewind.  Verify the blocks in use and the address of
+        //:   the next allocation.  (C-2)
+        //:
+        //: 3 Repeatedly allocate under a 'bdlma::CheckpointGuard' and verify
+        //:   that no memory remains in use from the test allocator.  (C-3)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-4)
+        //
+        // Testing:
+        //   void rewind(const Checkpoint& checkpoint);
+        //   Checkpoint checkpoint() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'checkpoint' AND 'rewind' TEST" << endl
+                                  << "==============================" << endl;
+
+        if (verbose) cout << "\nTesting rewind into the external buffer."
+                          << endl;
+        {
+            bsls::AlignedBuffer<BUFFER_SIZE> buffer;
+            bslma::TestAllocator             ta(veryVeryVerbose);
+
+            Obj mX(buffer.buffer(), BUFFER_SIZE, &ta);  const Obj& X = mX;
+            mX.allocate(8);
+
+            const bdlma::Checkpoint C = X.checkpoint();
+            ASSERT(buffer.buffer() == C.buffer());
+
+            void *p = mX.allocate(16);
+            for (int i = 0; i < 20; ++i) {
+                mX.allocate(BUFFER_SIZE / 2);
+            }
+            ASSERT(0 < ta.numBlocksInUse());
+
+            mX.rewind(C);
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+            ASSERT(p == mX.allocate(16));
+        }
+
+        if (verbose) cout << "\nTesting rewind into a dynamic buffer."
+                          << endl;
+        {
+            bsls::AlignedBuffer<BUFFER_SIZE> buffer;
+            bslma::TestAllocator             ta(veryVeryVerbose);
+
+            Obj mX(buffer.buffer(), BUFFER_SIZE, &ta);  const Obj& X = mX;
+            mX.allocate(BUFFER_SIZE);
+            mX.allocate(8);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            const bsls::Types::Int64 NUM_BYTES = ta.numBytesInUse();
+            const bdlma::Checkpoint  C         = X.checkpoint();
+            ASSERT(buffer.buffer() != C.buffer());
+
+            void *p = mX.allocate(8);
+            for (int i = 0; i < 20; ++i) {
+                mX.allocate(BUFFER_SIZE);
+            }
+            ASSERT(1 < ta.numBlocksInUse());
+
+            mX.rewind(C);
+            ASSERTV(ta.numBlocksInUse(), 1         == ta.numBlocksInUse());
+            ASSERTV(ta.numBytesInUse(),  NUM_BYTES == ta.numBytesInUse());
+            ASSERT(p == mX.allocate(8));
+        }
+
+        if (verbose) cout << "\nTesting 'bdlma::CheckpointGuard'." << endl;
+        {
+            bsls::AlignedBuffer<BUFFER_SIZE> buffer;
+            bslma::TestAllocator             ta(veryVeryVerbose);
+
+            Obj mX(buffer.buffer(), BUFFER_SIZE, &ta);
+
+            for (int i = 1; i <= 64; ++i) {
+                bdlma::CheckpointGuard<Obj> guard(&mX);
+
+                for (int j = 0; j < i; ++j) {
+                    mX.allocate(i * 8);
+                }
+            }
+
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bsls::AlignedBuffer<BUFFER_SIZE> buffer;
+
+            Obj mX(buffer.buffer(), BUFFER_SIZE, &objectAllocator);
+
+            ASSERT_SAFE_PASS(mX.rewind(mX.checkpoint()));
+            ASSERT_SAFE_FAIL(mX.rewind(bdlma::Checkpoint()));
+        }
+      } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // 'allocateAligned' TEST
+        //
+        // Concerns:
+        //: 1 'allocateAligned' returns memory aligned to the specified
+        //:   alignment, which may exceed the maximal alignment of the
+        //:   platform, irrespective of the alignment strategy of the pool.
+        //:
+        //: 2 Requests that fit in the external buffer after alignment are
+        //:   served from it without dynamic allocation.
+        //:
+        //: 3 Requests that do not fit in the external buffer are served from
+        //:   an internal buffer, or, if they cannot be satisfied by the next
+        //:   internal buffer, from a single block that is large enough to be
+        //:   aligned and that does not replace the current buffer.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using a pool with a 1-byte alignment strategy, an external buffer
+        //:   of 256 bytes, and a maximum buffer size of 512 bytes, allocate a
+        //:   sequence of aligned blocks and verify their addresses and the
+        //:   memory obtained from the test allocator.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void *allocateAligned(size_type size, int alignment);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'allocateAligned' TEST" << endl
+                                  << "======================" << endl;
+
+        char *buffer = bufferStorage.buffer();
+
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj mX(buffer,
+                   BUFFER_SIZE,
+                   2 * BUFFER_SIZE,
+                   bsls::Alignment::BSLS_BYTEALIGNED,
+                   &ta);
+
+            if (verbose) cout << "\nTesting the external buffer." << endl;
+
+            ASSERT(buffer      == mX.allocate(1));
+            ASSERT(buffer +  8 == mX.allocateAligned(8, 8));
+            ASSERT(buffer + 16 == mX.allocateAligned(16, 16));
+            ASSERT(0 == ta.numBlocksTotal());
+
+            if (verbose) cout << "\nTesting an internal buffer." << endl;
+
+            char *q = static_cast<char *>(mX.allocateAligned(300, 64));
+
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(0 == bsls::Types::UintPtr(q) % 64);
+
+            bsl::memset(q, 0xa5, 300);
+
+            if (verbose) cout << "\nTesting requests exceeding the buffer."
+                              << endl;
+
+            const int SIZE    = 2000;
+            const int ALIGN   = 512;
+            const int PADDING = ALIGN > MAX_ALIGN ? ALIGN - MAX_ALIGN : 0;
+
+            char *s = static_cast<char *>(mX.allocateAligned(SIZE, ALIGN));
+
+            ASSERT(2 == ta.numBlocksInUse());
+            ASSERT(0 == bsls::Types::UintPtr(s) % ALIGN);
+            LOOP_ASSERT(ta.lastAllocatedNumBytes(),
+                        static_cast<bsls::Types::size_type>(
+                                                   blockSize(SIZE + PADDING))
+                                                == ta.lastAllocatedNumBytes());
+
+            bsl::memset(s, 0xa5, SIZE);
+
+            ASSERT(q + 300 == mX.allocateAligned(4, 4));
+            ASSERT(2 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(buffer, BUFFER_SIZE, &objectAllocator);
+
+            ASSERT_PASS(mX.allocateAligned(1, 64));
+            ASSERT_FAIL(mX.allocateAligned(0, 64));
+            ASSERT_FAIL(mX.allocateAligned(1, 0));
+            ASSERT_FAIL(mX.allocateAligned(1, 48));
+        }
+
       } break;
       case 8: {
         // --------------------------------------------------------------------
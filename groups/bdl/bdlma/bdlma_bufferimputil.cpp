@@ -57,6 +57,35 @@ void *BufferImpUtil::allocateFromBuffer(int                       *cursor,
     return result;
 }
 
+void *BufferImpUtil::allocateAlignedFromBuffer(int  *cursor,
+                                               char *buffer,
+                                               int   bufferSize,
+                                               int   size,
+                                               int   alignment)
+{
+    BSLS_ASSERT(cursor);
+    BSLS_ASSERT(buffer);
+    BSLS_ASSERT(0 <= bufferSize);
+    BSLS_ASSERT(0 < size);
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+    BSLS_ASSERT(0 <= *cursor);
+    BSLS_ASSERT(*cursor <= bufferSize);
+
+    const int offset = bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                              buffer + *cursor,
+                                                              alignment);
+
+    if (*cursor + offset + size > bufferSize) {
+        return 0;                                                     // RETURN
+    }
+
+    void *result = &buffer[*cursor + offset];
+    *cursor += offset + size;
+
+    return result;
+}
+
 void *BufferImpUtil::allocateMaximallyAlignedFromBuffer(int  *cursor,
                                                         char *buffer,
                                                         int   bufferSize,
@@ -170,6 +199,28 @@ void *BufferImpUtil::allocateFromBufferRaw(int                       *cursor,
     return result;
 }
 
+void *BufferImpUtil::allocateAlignedFromBufferRaw(int  *cursor,
+                                                  char *buffer,
+                                                  int   size,
+                                                  int   alignment)
+{
+    BSLS_ASSERT(cursor);
+    BSLS_ASSERT(buffer);
+    BSLS_ASSERT(0 < size);
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+    BSLS_ASSERT(0 <= *cursor);
+
+    const int offset = bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                              buffer + *cursor,
+                                                              alignment);
+
+    void *result = &buffer[*cursor + offset];
+    *cursor += offset + size;
+
+    return result;
+}
+
 void *BufferImpUtil::allocateMaximallyAlignedFromBufferRaw(int  *cursor,
                                                            char *buffer,
                                                            int   size)
@@ -73,6 +73,14 @@ BSLS_IDENT("$Id: $")
 // strategy (otherwise, more bytes would have been skipped if maximum alignment
 // was used).  See 'bsls_alignment' for more details about memory alignment.
 //
+///Extended Alignment
+///------------------
+// 'allocateAlignedFromBuffer' and 'allocateAlignedFromBufferRaw' take an
+// explicit alignment instead of an alignment strategy.  The alignment may be
+// any power of two, including one greater than the maximal alignment of the
+// platform (e.g., the size of a cache line).  As with the other procedures,
+// the bytes skipped to achieve the alignment are wasted.
+//
 ///Raw vs. Non-Raw
 ///---------------
 // The raw and non-raw versions differ in behavior only when the requested
@@ -201,6 +209,23 @@ struct BufferImpUtil {
         // otherwise.  The behavior is undefined unless '0 <= bufferSize',
         // '0 < size', '0 <= *cursor', and '*cursor <= bufferSize'.
 
+    static void *allocateAlignedFromBuffer(int  *cursor,
+                                           char *buffer,
+                                           int   bufferSize,
+                                           int   size,
+                                           int   alignment);
+        // Allocate a memory block of the specified 'size' (in bytes), aligned
+        // to the specified 'alignment', from the specified 'buffer' having the
+        // specified 'bufferSize' (in bytes) at the specified 'cursor'
+        // position.  Return the address of the allocated memory block if
+        // 'buffer' contains sufficient available memory, and 0 otherwise.  The
+        // 'cursor' is set to the first byte position immediately after the
+        // allocated memory if there is sufficient memory, and not modified
+        // otherwise.  The behavior is undefined unless '0 <= bufferSize',
+        // '0 < size', 'alignment' is a positive power of two, '0 <= *cursor',
+        // and '*cursor <= bufferSize'.  Note that 'alignment' may exceed the
+        // maximal alignment of the platform.
+
     static void *allocateMaximallyAlignedFromBuffer(int  *cursor,
                                                     char *buffer,
                                                     int   bufferSize,
@@ -255,6 +280,19 @@ struct BufferImpUtil {
         // unless '0 < size', 'buffer' contains sufficient available memory,
         // and 'cursor' refers to a valid position in 'buffer'.
 
+    static void *allocateAlignedFromBufferRaw(int  *cursor,
+                                              char *buffer,
+                                              int   size,
+                                              int   alignment);
+        // Allocate a memory block of the specified 'size' (in bytes), aligned
+        // to the specified 'alignment', from the specified 'buffer' at the
+        // specified 'cursor' position.  Return the address of the allocated
+        // memory block.  The 'cursor' is set to the first byte position
+        // immediately after the allocated memory.  The behavior is undefined
+        // unless '0 < size', 'alignment' is a positive power of two, 'buffer'
+        // contains sufficient available memory, and 'cursor' refers to a
+        // valid position in 'buffer'.
+
     static void *allocateMaximallyAlignedFromBufferRaw(int  *cursor,
                                                        char *buffer,
                                                        int   size);
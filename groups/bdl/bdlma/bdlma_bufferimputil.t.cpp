@@ -46,8 +46,10 @@ using namespace bsl;
 // [ 1] void *allocateMaximallyAlignedFromBufferRaw(cur, buf, sz, Strat);
 // [ 1] void *allocateNaturallyAlignedFromBufferRaw(cur, buf, sz, Strat);
 // [ 1] void *allocateOneByteAlignedFromBufferRaw(cur, buf, sz, Strat);
+// [ 2] void *allocateAlignedFromBuffer(cur, buf, bs, sz, align);
+// [ 2] void *allocateAlignedFromBufferRaw(cur, buf, sz, align);
 //-----------------------------------------------------------------------------
-// [ 2] USAGE EXAMPLE
+// [ 3] USAGE EXAMPLE
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -223,7 +225,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 2: {
+      case 3: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -246,6 +248,143 @@ int main(int argc, char *argv[])
                           << "=============" << endl;
 
       } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // EXTENDED-ALIGNMENT METHODS TEST
+        //
+        // Concerns:
+        //: 1 The address of the allocated memory block is aligned to the
+        //:   specified alignment, including alignments exceeding the maximal
+        //:   alignment of the platform.
+        //:
+        //: 2 The block is allocated at the first suitably-aligned position at
+        //:   or after the cursor, and the cursor is updated to the position
+        //:   immediately after the allocated memory.
+        //:
+        //: 3 When the non-raw method is used and the allocation request would
+        //:   exceed the capacity of the buffer, 0 is returned and the cursor
+        //:   is not affected.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each cursor position in a small range and for each power of
+        //:   two alignment up to 256, allocate from a 256-byte aligned buffer
+        //:   using both methods, and verify the address and the cursor against
+        //:   the expected values.  (C-1..2)
+        //:
+        //: 2 Request a block whose aligned end is beyond the buffer and verify
+        //:   that 0 is returned and the cursor is unchanged.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void *allocateAlignedFromBuffer(cur, buf, bs, sz, align);
+        //   void *allocateAlignedFromBufferRaw(cur, buf, sz, align);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "EXTENDED-ALIGNMENT METHODS TEST" << endl
+                                  << "===============================" << endl;
+
+        enum { BUFFER_SIZE = 1024, MAX_TEST_ALIGN = 256 };
+
+        union {
+            char d_buffer[BUFFER_SIZE + MAX_TEST_ALIGN];
+            bsls::AlignmentUtil::MaxAlignedType d_dummy;
+        } storage;
+
+        char *buffer = storage.d_buffer
+                     + bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                              storage.d_buffer,
+                                                              MAX_TEST_ALIGN);
+
+        for (int ti = 0; ti < 70; ++ti) {
+            for (int align = 1; align <= MAX_TEST_ALIGN; align <<= 1) {
+                const int SIZE   = 5;
+                const int OFFSET = (ti + align - 1) & ~(align - 1);
+
+                if (veryVerbose) { T_ P_(ti) P(align) }
+
+                int cursor = ti;
+                void *p = Obj::allocateAlignedFromBuffer(&cursor,
+                                                         buffer,
+                                                         BUFFER_SIZE,
+                                                         SIZE,
+                                                         align);
+                LOOP2_ASSERT(ti, align, buffer + OFFSET == p);
+                LOOP2_ASSERT(ti, align, OFFSET + SIZE == cursor);
+
+                cursor = ti;
+                p = Obj::allocateAlignedFromBufferRaw(&cursor,
+                                                      buffer,
+                                                      SIZE,
+                                                      align);
+                LOOP2_ASSERT(ti, align, buffer + OFFSET == p);
+                LOOP2_ASSERT(ti, align, OFFSET + SIZE == cursor);
+            }
+        }
+
+        if (verbose) cout << "\nTesting insufficient capacity." << endl;
+        {
+            int cursor = 1;
+            ASSERT(0 == Obj::allocateAlignedFromBuffer(&cursor,
+                                                       buffer,
+                                                       128,
+                                                       64,
+                                                       128));
+            ASSERT(1 == cursor);
+
+            ASSERT(buffer + 64 == Obj::allocateAlignedFromBuffer(&cursor,
+                                                                 buffer,
+                                                                 128,
+                                                                 64,
+                                                                 64));
+            ASSERT(128 == cursor);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            int cursor = 0;
+
+            ASSERT_SAFE_PASS(Obj::allocateAlignedFromBuffer(&cursor,
+                                                            buffer,
+                                                            64,
+                                                            1,
+                                                            8));
+            ASSERT_SAFE_FAIL(Obj::allocateAlignedFromBuffer(&cursor,
+                                                            buffer,
+                                                            64,
+                                                            1,
+                                                            0));
+            ASSERT_SAFE_FAIL(Obj::allocateAlignedFromBuffer(&cursor,
+                                                            buffer,
+                                                            64,
+                                                            1,
+                                                            12));
+            ASSERT_SAFE_FAIL(Obj::allocateAlignedFromBuffer(&cursor,
+                                                            buffer,
+                                                            64,
+                                                            0,
+                                                            8));
+
+            ASSERT_SAFE_PASS(Obj::allocateAlignedFromBufferRaw(&cursor,
+                                                               buffer,
+                                                               1,
+                                                               8));
+            ASSERT_SAFE_FAIL(Obj::allocateAlignedFromBufferRaw(&cursor,
+                                                               buffer,
+                                                               1,
+                                                               12));
+            ASSERT_SAFE_FAIL(Obj::allocateAlignedFromBufferRaw(&cursor,
+                                                               buffer,
+                                                               0,
+                                                               8));
+        }
+      } break;
       case 1: {
         // --------------------------------------------------------------------
         // CLASS METHODS TEST
@@ -40,6 +40,13 @@ BSLS_IDENT("$Id: $")
 // allocation, when the user knows in advance the maximum amount of memory
 // needed.
 //
+// The 'allocateAligned' and 'allocateAlignedRaw' methods dispense memory
+// aligned to an explicitly specified power of two, irrespective of the
+// alignment strategy supplied at construction.  The alignment may exceed the
+// maximal alignment of the platform (e.g., to place an object on a cache line
+// of its own); only the bytes needed to reach the next aligned address in the
+// buffer are skipped.
+//
 ///Usage
 ///-----
 // Suppose that we need to detect whether there are at least 'n' duplicates
@@ -239,6 +246,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlscm_version.h>
 #endif
 
+#ifndef INCLUDED_BDLMA_BUFFERIMPUTIL
+#include <bdlma_bufferimputil.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ALIGNMENT
 #include <bsls_alignment.h>
 #endif
@@ -340,6 +351,24 @@ class BufferManager {
         // external buffer, '0 < size', and this object is currently managing
         // a buffer.
 
+    void *allocateAligned(bsls::Types::size_type size, int alignment);
+        // Return the address of a contiguous block of memory of the specified
+        // 'size' (in bytes) aligned to the specified 'alignment' on success,
+        // and 0 if the allocation request exceeds the remaining free memory
+        // space in the external buffer.  The alignment strategy specified at
+        // construction is not used.  The behavior is undefined unless
+        // '0 < size', 'alignment' is a positive power of two, and this object
+        // is currently managing a buffer.
+
+    void *allocateAlignedRaw(int size, int alignment);
+        // Return the address of a contiguous block of memory of the specified
+        // 'size' (in bytes) aligned to the specified 'alignment'.  The
+        // alignment strategy specified at construction is not used.  The
+        // behavior is undefined unless the allocation request does not exceed
+        // the remaining free memory space in the external buffer, '0 < size',
+        // 'alignment' is a positive power of two, and this object is currently
+        // managing a buffer.
+
     template <class TYPE>
     void deleteObjectRaw(const TYPE *object);
         // Destroy the specified 'object'.  Note that memory associated with
@@ -389,6 +418,16 @@ class BufferManager {
         // of this object with no effect on the outstanding allocated memory
         // blocks.
 
+    void setCursor(int cursor);
+        // Set the offset of the next available byte in the buffer currently
+        // managed by this object to the specified 'cursor'.  Subsequent
+        // allocations will allocate memory from 'cursor' onward; any memory
+        // previously allocated at or beyond 'cursor' must no longer be in use.
+        // The behavior is undefined unless this object is currently managing a
+        // buffer, '0 <= cursor', and 'cursor <= bufferSize()'.  Note that this
+        // method, together with 'cursor', allows a client to rewind this
+        // object to an earlier allocation state.
+
     int truncate(void *address, int originalSize, int newSize);
         // Reduce the amount of memory allocated at the specified 'address'
         // of the specified 'originalSize' (in bytes) to the specified
@@ -412,6 +451,11 @@ class BufferManager {
         // Return the size (in bytes) of the buffer currently managed by this
         // object, or 0 if this object currently manages no buffer.
 
+    int cursor() const;
+        // Return the offset of the next available byte in the buffer
+        // currently managed by this object, or 0 if this object currently
+        // manages no buffer.
+
     bool hasSufficientCapacity(int size) const;
         // Return 'true' if there is sufficient memory space in the buffer to
         // allocate a contiguous memory block of the specified 'size' (in
@@ -487,6 +531,40 @@ void *BufferManager::allocateRaw(int size)
     return (*d_allocateRaw_p)(&d_cursor, d_buffer_p, size);
 }
 
+inline
+void *BufferManager::allocateAligned(bsls::Types::size_type size,
+                                     int                    alignment)
+{
+    BSLS_ASSERT_SAFE(0 < size);
+    BSLS_ASSERT_SAFE(0 < alignment);
+    BSLS_ASSERT_SAFE(0 == (alignment & (alignment - 1)));
+    BSLS_ASSERT_SAFE(d_buffer_p);
+    BSLS_ASSERT_SAFE(0 <= d_cursor);
+    BSLS_ASSERT_SAFE(d_cursor <= d_bufferSize);
+
+    return BufferImpUtil::allocateAlignedFromBuffer(&d_cursor,
+                                                    d_buffer_p,
+                                                    d_bufferSize,
+                                                    static_cast<int>(size),
+                                                    alignment);
+}
+
+inline
+void *BufferManager::allocateAlignedRaw(int size, int alignment)
+{
+    BSLS_ASSERT_SAFE(0 < size);
+    BSLS_ASSERT_SAFE(0 < alignment);
+    BSLS_ASSERT_SAFE(0 == (alignment & (alignment - 1)));
+    BSLS_ASSERT_SAFE(d_buffer_p);
+    BSLS_ASSERT_SAFE(0 <= d_cursor);
+    BSLS_ASSERT_SAFE(d_cursor <= d_bufferSize);
+
+    return BufferImpUtil::allocateAlignedFromBufferRaw(&d_cursor,
+                                                       d_buffer_p,
+                                                       size,
+                                                       alignment);
+}
+
 template <class TYPE>
 inline
 void BufferManager::deleteObjectRaw(const TYPE *object)
@@ -535,6 +613,16 @@ void BufferManager::reset()
     d_cursor     = 0;
 }
 
+inline
+void BufferManager::setCursor(int cursor)
+{
+    BSLS_ASSERT_SAFE(d_buffer_p);
+    BSLS_ASSERT_SAFE(0 <= cursor);
+    BSLS_ASSERT_SAFE(cursor <= d_bufferSize);
+
+    d_cursor = cursor;
+}
+
 // ACCESSORS
 inline
 char *BufferManager::buffer() const
@@ -548,6 +636,12 @@ int BufferManager::bufferSize() const
     return d_bufferSize;
 }
 
+inline
+int BufferManager::cursor() const
+{
+    return d_cursor;
+}
+
 inline
 bool BufferManager::hasSufficientCapacity(int size) const
 {
@@ -55,21 +55,25 @@ using namespace bsl;
 // // MANIPULATORS
 // [ 3] void *allocate(size_type size);
 // [ 3] void *allocateRaw(int size);
+// [11] void *allocateAligned(size_type size, int alignment);
+// [11] void *allocateAlignedRaw(int size, int alignment);
 // [ 8] void deleteObjectRaw(const TYPE *object);
 // [ 8] void deleteObject(const TYPE *object);
 // [ 9] int expand(void *address, int size);
 // [ 4] char *replaceBuffer(char *newBuffer, int newBufferSize);
 // [ 5] void release();
 // [ 6] void reset();
+// [12] void setCursor(int cursor);
 // [10] int truncate(void *address, int originalSize, int newSize);
 //
 // // ACCESSORS
 // [ 2] char *buffer() const;
 // [ 2] int bufferSize() const;
+// [12] int cursor() const;
 // [ 7] bool hasSufficientCapacity(int size) const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [11] USAGE EXAMPLE
+// [13] USAGE EXAMPLE
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -369,7 +373,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 11: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -400,6 +404,185 @@ int main(int argc, char *argv[])
         ASSERT(false == result);
 
       } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // 'cursor' AND 'setCursor' TEST
+        //
+        // Concerns:
+        //: 1 'cursor' reports the offset of the next allocation within the
+        //:   managed buffer.
+        //:
+        //: 2 'setCursor' repositions the next allocation to the specified
+        //:   offset, making the memory allocated beyond it available again.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate from a managed buffer and verify 'cursor' after each
+        //:   allocation.  (C-1)
+        //:
+        //: 2 Record the cursor, allocate further, restore the cursor with
+        //:   'setCursor', and verify that the next allocation returns the same
+        //:   address as the first allocation following the recording.  (C-2)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-3)
+        //
+        // Testing:
+        //   void setCursor(int cursor);
+        //   int cursor() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'cursor' AND 'setCursor' TEST" << endl
+                                  << "=============================" << endl;
+
+        char *buffer = bufferStorage.buffer();
+
+        {
+            Obj mX(buffer, BUFFER_SIZE, bsls::Alignment::BSLS_BYTEALIGNED);
+            const Obj& X = mX;
+
+            ASSERT(0 == X.cursor());
+
+            mX.allocate(5);              ASSERT( 5 == X.cursor());
+            mX.allocate(7);              ASSERT(12 == X.cursor());
+
+            const int CURSOR = X.cursor();
+
+            void *p = mX.allocate(16);   ASSERT(28 == X.cursor());
+            mX.allocate(100);            ASSERT(128 == X.cursor());
+
+            mX.setCursor(CURSOR);        ASSERT(CURSOR == X.cursor());
+            ASSERT(p == mX.allocate(16));
+
+            mX.setCursor(0);             ASSERT(0 == X.cursor());
+            ASSERT(buffer == mX.allocate(1));
+
+            mX.setCursor(BUFFER_SIZE);
+            ASSERT(BUFFER_SIZE == X.cursor());
+            ASSERT(!X.hasSufficientCapacity(1));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(buffer, BUFFER_SIZE);
+
+            ASSERT_SAFE_PASS(mX.setCursor(0));
+            ASSERT_SAFE_PASS(mX.setCursor(BUFFER_SIZE));
+
+            ASSERT_SAFE_FAIL(mX.setCursor(-1));
+            ASSERT_SAFE_FAIL(mX.setCursor(BUFFER_SIZE + 1));
+
+            Obj mY;
+
+            ASSERT_SAFE_FAIL(mY.setCursor(0));
+        }
+
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // EXTENDED-ALIGNMENT ALLOCATION TEST
+        //
+        // Concerns:
+        //: 1 'allocateAligned' and 'allocateAlignedRaw' return memory aligned
+        //:   to the specified alignment, which may exceed the maximal
+        //:   alignment of the platform, irrespective of the alignment strategy
+        //:   specified at construction.
+        //:
+        //: 2 Only the padding needed to reach the alignment is skipped, and
+        //:   subsequent allocations continue after the aligned block.
+        //:
+        //: 3 'allocateAligned' returns 0, without affecting the buffer, if the
+        //:   aligned request does not fit in the remaining buffer space.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each alignment strategy, allocate one byte, then allocate
+        //:   blocks of various alignments (up to 256) using both methods, and
+        //:   verify the offset of each block from the start of a 256-byte
+        //:   aligned buffer.  (C-1..2)
+        //:
+        //: 2 Request an aligned block that does not fit in the buffer, and
+        //:   verify that 0 is returned and that the next allocation is at the
+        //:   expected offset.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void *allocateAligned(size_type size, int alignment);
+        //   void *allocateAlignedRaw(int size, int alignment);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "EXTENDED-ALIGNMENT ALLOCATION TEST"
+                          << endl << "=================================="
+                          << endl;
+
+        enum { ALIGNED_BUFFER_SIZE = 1024 };
+
+        static bsls::AlignedBuffer<ALIGNED_BUFFER_SIZE + 256> alignedStorage;
+
+        char *buffer = alignedStorage.buffer()
+                     + bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                      alignedStorage.buffer(),
+                                                      256);
+
+        const Strat STRATEGIES[] = { bsls::Alignment::BSLS_NATURAL,
+                                     bsls::Alignment::BSLS_MAXIMUM,
+                                     bsls::Alignment::BSLS_BYTEALIGNED };
+        const int NUM_STRATEGIES = sizeof STRATEGIES / sizeof *STRATEGIES;
+
+        for (int ti = 0; ti < NUM_STRATEGIES; ++ti) {
+            const Strat STRAT = STRATEGIES[ti];
+
+            if (veryVerbose) { T_ P(STRAT) }
+
+            Obj mX(buffer, ALIGNED_BUFFER_SIZE, STRAT);
+
+            ASSERT(buffer == mX.allocateRaw(1));
+
+            LOOP_ASSERT(ti, buffer +  64 == mX.allocateAligned(3, 64));
+            LOOP_ASSERT(ti, buffer +  67 == mX.allocateAlignedRaw(1, 1));
+            LOOP_ASSERT(ti, buffer +  80 == mX.allocateAligned(16, 16));
+            LOOP_ASSERT(ti, buffer + 128 == mX.allocateAlignedRaw(1, 128));
+            LOOP_ASSERT(ti, buffer + 256 == mX.allocateAligned(1, 256));
+            LOOP_ASSERT(ti, buffer + 264 == mX.allocateAligned(8, 8));
+
+            // Too large for the remaining buffer after alignment.
+
+            LOOP_ASSERT(ti, 0 == mX.allocateAligned(ALIGNED_BUFFER_SIZE - 511,
+                                                    512));
+            LOOP_ASSERT(ti, buffer + 512 == mX.allocateAligned(
+                                                    ALIGNED_BUFFER_SIZE - 512,
+                                                    512));
+            LOOP_ASSERT(ti, 0 == mX.allocateAligned(1, 1));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(buffer, ALIGNED_BUFFER_SIZE);
+
+            ASSERT_SAFE_PASS(mX.allocateAligned(1, 32));
+            ASSERT_SAFE_FAIL(mX.allocateAligned(0, 32));
+            ASSERT_SAFE_FAIL(mX.allocateAligned(1, 0));
+            ASSERT_SAFE_FAIL(mX.allocateAligned(1, 24));
+
+            ASSERT_SAFE_PASS(mX.allocateAlignedRaw(1, 32));
+            ASSERT_SAFE_FAIL(mX.allocateAlignedRaw(0, 32));
+            ASSERT_SAFE_FAIL(mX.allocateAlignedRaw(1, 24));
+
+            Obj mY;
+            ASSERT_SAFE_FAIL(mY.allocateAligned(1, 32));
+        }
+      } break;
       case 10: {
         // --------------------------------------------------------------------
         // TRUNCATE TEST
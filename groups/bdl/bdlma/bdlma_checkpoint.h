@@ -0,0 +1,437 @@
+// bdlma_checkpoint.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLMA_CHECKPOINT
+#define INCLUDED_BDLMA_CHECKPOINT
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a mark of, and scoped rewind to, a sequential arena state.
+//
+//@CLASSES:
+//  bdlma::Checkpoint: allocation state of a sequential pool or allocator
+//  bdlma::CheckpointGuard: proctor to rewind a sequential arena at destruction
+//
+//@SEE_ALSO: bdlma_sequentialpool, bdlma_bufferedsequentialpool,
+//           bdlma_autoreleaser
+//
+//@DESCRIPTION: This component provides an attribute class,
+// 'bdlma::Checkpoint', that records the allocation state of a sequential
+// memory arena (such as 'bdlma::SequentialPool' or
+// 'bdlma::BufferedSequentialAllocator'), and a proctor class template,
+// 'bdlma::CheckpointGuard', that rewinds an arena to the state recorded at
+// the guard's construction when the guard is destroyed, unless the guard's
+// 'release' method has been called.
+//
+// A checkpoint holds the buffer from which the arena is currently dispensing
+// memory, the offset of the next available byte in that buffer, and the most
+// recent block the arena obtained from its allocator.  Rewinding an arena to a
+// checkpoint makes all memory allocated after the checkpoint was taken
+// available for reuse: memory dispensed from the checkpointed buffer is
+// reclaimed simply by restoring the cursor, and any blocks subsequently
+// obtained from the allocator are returned to it.  Taking a checkpoint
+// allocates no memory, and rewinding to a checkpoint whose buffer is still
+// the current buffer costs no more than a few stores.  Note that checkpoints
+// nest: rewinding to a checkpoint invalidates every checkpoint of the same
+// arena taken after it, but not those taken before it.
+//
+///REQUIREMENTS
+///------------
+// The object of the (template parameter) type 'ARENA_TYPE' managed by a
+// 'bdlma::CheckpointGuard' must provide methods having the following
+// signatures:
+//..
+//  bdlma::Checkpoint checkpoint() const;
+//  void rewind(const bdlma::Checkpoint& checkpoint);
+//..
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Discarding a Failed Speculative Parse
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a recursive-descent parser allocates the nodes of its syntax
+// tree from a sequential arena, and that some productions must be parsed
+// speculatively: if the parse of a production fails, the parser backtracks
+// and tries an alternative.  A 'bdlma::CheckpointGuard' lets the nodes
+// allocated by the failed attempt be discarded, so that the alternative
+// reuses the same memory rather than growing the arena.
+//
+// First, we define a minimal arena, 'my_Arena', that dispenses memory from a
+// fixed buffer and meets the requirements of 'bdlma::CheckpointGuard' (in
+// practice, 'bdlma::SequentialAllocator' or 'bdlma::SequentialPool' would be
+// used):
+//..
+//  class my_Arena {
+//      // This class dispenses memory sequentially from a fixed buffer.
+//
+//      // DATA
+//      char d_buffer[1024];  // buffer from which memory is dispensed
+//      int  d_cursor;        // offset of the next available byte
+//
+//    public:
+//      // CREATORS
+//      my_Arena() : d_cursor(0) {}
+//          // Create an arena having no memory allocated.
+//
+//      // MANIPULATORS
+//      void *allocate(int size)
+//          // Return the address of a block of the specified 'size' (in
+//          // bytes), or 0 if the buffer is exhausted.
+//      {
+//          size = (size + 7) & ~7;
+//          if (d_cursor + size > static_cast<int>(sizeof d_buffer)) {
+//              return 0;                                             // RETURN
+//          }
+//          void *result = d_buffer + d_cursor;
+//          d_cursor += size;
+//          return result;
+//      }
+//
+//      void rewind(const bdlma::Checkpoint& checkpoint)
+//          // Rewind this arena to the specified 'checkpoint'.
+//      {
+//          d_cursor = checkpoint.cursor();
+//      }
+//
+//      // ACCESSORS
+//      bdlma::Checkpoint checkpoint() const
+//          // Return the current allocation state of this arena.
+//      {
+//          return bdlma::Checkpoint(const_cast<char *>(d_buffer),
+//                                   static_cast<int>(sizeof d_buffer),
+//                                   d_cursor,
+//                                   0);
+//      }
+//
+//      int numBytesAllocated() const { return d_cursor; }
+//          // Return the number of bytes allocated from this arena.
+//  };
+//..
+// Then, we define a node type and a function that speculatively parses a run
+// of decimal digits into a list of nodes, failing if the run is not
+// terminated by a ';':
+//..
+//  struct my_Node {
+//      // This 'struct' represents a node of a parsed list of digits.
+//
+//      int      d_value;   // value of the digit
+//      my_Node *d_next_p;  // next node in the list, or 0
+//  };
+//
+//  my_Node *parseDigits(const char **input, my_Arena *arena)
+//      // Parse the run of decimal digits at the specified '*input', followed
+//      // by a ';', into a list of nodes allocated from the specified 'arena'.
+//      // On success, advance '*input' past the ';' and return the head of the
+//      // list; otherwise, leave '*input' and the allocation state of 'arena'
+//      // unchanged and return 0.
+//  {
+//      bdlma::CheckpointGuard<my_Arena> guard(arena);
+//
+//      const char  *p    = *input;
+//      my_Node     *head = 0;
+//      my_Node    **tail = &head;
+//
+//      while ('0' <= *p && *p <= '9') {
+//          my_Node *node = static_cast<my_Node *>(
+//                                             arena->allocate(sizeof *node));
+//          node->d_value  = *p - '0';
+//          node->d_next_p = 0;
+//          *tail = node;
+//          tail  = &node->d_next_p;
+//          ++p;
+//      }
+//
+//      if (';' != *p) {
+//          return 0;                                                 // RETURN
+//      }
+//
+//      guard.release();
+//      *input = p + 1;
+//      return head;
+//  }
+//..
+// Next, we parse an input that does not match, repeatedly.  Since every
+// failed attempt is rewound, the arena does not grow:
+//..
+//  my_Arena arena;
+//
+//  const char *input = "12345,";
+//
+//  for (int i = 0; i < 100; ++i) {
+//      assert(0 == parseDigits(&input, &arena));
+//  }
+//
+//  assert(0 == arena.numBytesAllocated());
+//  assert(0 == bsl::strcmp("12345,", input));
+//..
+// Finally, we parse an input that does match, and verify the result:
+//..
+//  input = "42;";
+//
+//  my_Node *list = parseDigits(&input, &arena);
+//
+//  assert(list);
+//  assert(4 == list->d_value);
+//  assert(2 == list->d_next_p->d_value);
+//  assert(0 == list->d_next_p->d_next_p);
+//  assert('\0' == *input);
+//  assert(0 <  arena.numBytesAllocated());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                        // ================
+                        // class Checkpoint
+                        // ================
+
+class Checkpoint {
+    // This simply constrained attribute class records the allocation state of
+    // a sequential memory arena: the buffer from which the arena dispenses
+    // memory, the size of that buffer, the offset of the next available byte
+    // in it, and the address of the most recent block the arena obtained from
+    // its allocator.  A checkpoint is produced by, and meaningful only to, the
+    // arena whose state it records.
+
+    // DATA
+    char *d_buffer_p;     // current buffer of the arena, or 0 (held, not
+                          // owned)
+
+    int   d_bufferSize;   // size (in bytes) of 'd_buffer_p'
+
+    int   d_cursor;       // offset of the next available byte in
+                          // 'd_buffer_p'
+
+    void *d_lastBlock_p;  // most recent block obtained by the arena from its
+                          // allocator, or 0 (held, not owned)
+
+  public:
+    // CREATORS
+    Checkpoint();
+        // Create a checkpoint recording the state of an arena that manages no
+        // buffer and has obtained no blocks from its allocator.
+
+    Checkpoint(char *buffer, int bufferSize, int cursor, void *lastBlock);
+        // Create a checkpoint recording the state of an arena whose current
+        // buffer is the specified 'buffer' of the specified 'bufferSize' (in
+        // bytes) with the next available byte at the specified 'cursor'
+        // offset, and whose most recent block obtained from its allocator is
+        // the specified 'lastBlock'.  The behavior is undefined unless
+        // '0 <= cursor', 'cursor <= bufferSize', and 'buffer' is 0 if and
+        // only if '0 == bufferSize'.
+
+    // Checkpoint(const Checkpoint& original) = default;
+    // ~Checkpoint() = default;
+
+    // MANIPULATORS
+    // Checkpoint& operator=(const Checkpoint& rhs) = default;
+
+    // ACCESSORS
+    char *buffer() const;
+        // Return the address of the buffer recorded by this checkpoint, or 0
+        // if the arena was managing no buffer.
+
+    int bufferSize() const;
+        // Return the size (in bytes) of the buffer recorded by this
+        // checkpoint, or 0 if the arena was managing no buffer.
+
+    int cursor() const;
+        // Return the offset of the next available byte in the buffer recorded
+        // by this checkpoint.
+
+    void *lastBlock() const;
+        // Return the address of the most recent block the arena had obtained
+        // from its allocator, or 0 if it had obtained none.
+};
+
+                        // =====================
+                        // class CheckpointGuard
+                        // =====================
+
+template <class ARENA_TYPE>
+class CheckpointGuard {
+    // This class implements a proctor that records the allocation state of
+    // its managed sequential arena at construction, and rewinds the arena to
+    // that state at destruction unless the proctor's 'release' method is
+    // invoked.
+
+    // DATA
+    ARENA_TYPE *d_arena_p;     // managed arena (held, not owned), or 0
+
+    Checkpoint  d_checkpoint;  // state of 'd_arena_p' at construction
+
+  private:
+    // NOT IMPLEMENTED
+    CheckpointGuard(const CheckpointGuard&);
+    CheckpointGuard& operator=(const CheckpointGuard&);
+
+  public:
+    // CREATORS
+    explicit
+    CheckpointGuard(ARENA_TYPE *arena);
+        // Create a proctor object to manage the specified 'arena', recording
+        // its current allocation state.  Unless the 'release' method of this
+        // proctor is invoked, 'arena' is rewound to the recorded state upon
+        // destruction of this proctor.  The behavior is undefined unless
+        // 'arena' is non-null.
+
+    ~CheckpointGuard();
+        // Destroy this proctor object and, unless the 'release' method has
+        // been invoked on this object, rewind the managed arena to the state
+        // recorded at construction.
+
+    // MANIPULATORS
+    void release();
+        // Release from management the arena currently managed by this
+        // proctor, keeping all memory allocated from it since this proctor
+        // was created.  If no arena is currently being managed, this method
+        // has no effect.
+
+    void rewind();
+        // Rewind the arena currently managed by this proctor to the state
+        // recorded at construction, and continue to manage it.  The behavior
+        // is undefined unless this proctor currently manages an arena.
+
+    // ACCESSORS
+    const Checkpoint& checkpoint() const;
+        // Return a reference providing non-modifiable access to the
+        // allocation state recorded by this proctor at construction.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                        // ----------------
+                        // class Checkpoint
+                        // ----------------
+
+// CREATORS
+inline
+Checkpoint::Checkpoint()
+: d_buffer_p(0)
+, d_bufferSize(0)
+, d_cursor(0)
+, d_lastBlock_p(0)
+{
+}
+
+inline
+Checkpoint::Checkpoint(char *buffer,
+                       int   bufferSize,
+                       int   cursor,
+                       void *lastBlock)
+: d_buffer_p(buffer)
+, d_bufferSize(bufferSize)
+, d_cursor(cursor)
+, d_lastBlock_p(lastBlock)
+{
+    BSLS_ASSERT_SAFE(0 <= cursor);
+    BSLS_ASSERT_SAFE(cursor <= bufferSize);
+    BSLS_ASSERT_SAFE((0 != buffer) == (0 != bufferSize));
+}
+
+// ACCESSORS
+inline
+char *Checkpoint::buffer() const
+{
+    return d_buffer_p;
+}
+
+inline
+int Checkpoint::bufferSize() const
+{
+    return d_bufferSize;
+}
+
+inline
+int Checkpoint::cursor() const
+{
+    return d_cursor;
+}
+
+inline
+void *Checkpoint::lastBlock() const
+{
+    return d_lastBlock_p;
+}
+
+                        // ---------------------
+                        // class CheckpointGuard
+                        // ---------------------
+
+// CREATORS
+template <class ARENA_TYPE>
+inline
+CheckpointGuard<ARENA_TYPE>::CheckpointGuard(ARENA_TYPE *arena)
+: d_arena_p(arena)
+{
+    BSLS_ASSERT_SAFE(arena);
+
+    d_checkpoint = arena->checkpoint();
+}
+
+template <class ARENA_TYPE>
+inline
+CheckpointGuard<ARENA_TYPE>::~CheckpointGuard()
+{
+    if (d_arena_p) {
+        d_arena_p->rewind(d_checkpoint);
+    }
+}
+
+// MANIPULATORS
+template <class ARENA_TYPE>
+inline
+void CheckpointGuard<ARENA_TYPE>::release()
+{
+    d_arena_p = 0;
+}
+
+template <class ARENA_TYPE>
+inline
+void CheckpointGuard<ARENA_TYPE>::rewind()
+{
+    BSLS_ASSERT_SAFE(d_arena_p);
+
+    d_arena_p->rewind(d_checkpoint);
+}
+
+// ACCESSORS
+template <class ARENA_TYPE>
+inline
+const Checkpoint& CheckpointGuard<ARENA_TYPE>::checkpoint() const
+{
+    return d_checkpoint;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,662 @@
+// bdlma_checkpoint.t.cpp                                             -*-C++-*-
+#include <bdlma_checkpoint.h>
+
+#include <bdls_testutil.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The attribute class 'bdlma::Checkpoint' is tested by verifying that each
+// constructor stores the supplied attributes, and that the accessors report
+// them.  The proctor 'bdlma::CheckpointGuard' is tested with a local
+// 'TestArena' whose state is a cursor, and which counts the calls made to its
+// 'rewind' method; we verify that a guard records the arena's state at
+// construction, rewinds to it at destruction unless released, and that
+// 'rewind' may be invoked explicitly any number of times.
+// ----------------------------------------------------------------------------
+// bdlma::Checkpoint
+// [ 2] Checkpoint();
+// [ 2] Checkpoint(char *buffer, int bufferSize, int cursor, void *lastBlock);
+// [ 2] char *buffer() const;
+// [ 2] int bufferSize() const;
+// [ 2] int cursor() const;
+// [ 2] void *lastBlock() const;
+//
+// bdlma::CheckpointGuard
+// [ 3] explicit CheckpointGuard(ARENA_TYPE *arena);
+// [ 3] ~CheckpointGuard();
+// [ 3] void release();
+// [ 3] void rewind();
+// [ 3] const Checkpoint& checkpoint() const;
+// ----------------------------------------------------------------------------
+// [ 4] USAGE EXAMPLE
+// [ 1] Ensure local helper class TestArena works as expected.
+
+// ============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::Checkpoint Obj;
+
+// ============================================================================
+//                               TEST APPARATUS
+// ----------------------------------------------------------------------------
+
+class TestArena {
+    // This test class models a sequential arena whose allocation state is a
+    // cursor into a fixed buffer, and counts the calls made to its 'rewind'
+    // method.
+
+    // DATA
+    char d_buffer[64];   // buffer whose address is reported in checkpoints
+    int  d_cursor;       // current allocation state
+    int  d_numRewinds;   // number of calls to 'rewind'
+
+  public:
+    // CREATORS
+    TestArena() : d_cursor(0), d_numRewinds(0) {}
+        // Create a test arena having a cursor of 0.
+
+    // MANIPULATORS
+    void advance(int numBytes) { d_cursor += numBytes; }
+        // Advance the cursor of this arena by the specified 'numBytes'.
+
+    void rewind(const bdlma::Checkpoint& checkpoint)
+        // Set the cursor of this arena to that of the specified 'checkpoint',
+        // and increment the number of rewinds.
+    {
+        ASSERT(d_buffer == checkpoint.buffer());
+
+        d_cursor = checkpoint.cursor();
+        ++d_numRewinds;
+    }
+
+    // ACCESSORS
+    bdlma::Checkpoint checkpoint() const
+        // Return a checkpoint recording the cursor of this arena.
+    {
+        return bdlma::Checkpoint(const_cast<char *>(d_buffer),
+                                 static_cast<int>(sizeof d_buffer),
+                                 d_cursor,
+                                 0);
+    }
+
+    int cursor() const { return d_cursor; }
+        // Return the cursor of this arena.
+
+    int numRewinds() const { return d_numRewinds; }
+        // Return the number of calls made to 'rewind'.
+};
+
+// ============================================================================
+//                                USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Discarding a Failed Speculative Parse
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a recursive-descent parser allocates the nodes of its syntax
+// tree from a sequential arena, and that some productions must be parsed
+// speculatively: if the parse of a production fails, the parser backtracks
+// and tries an alternative.  A 'bdlma::CheckpointGuard' lets the nodes
+// allocated by the failed attempt be discarded, so that the alternative
+// reuses the same memory rather than growing the arena.
+//
+// First, we define a minimal arena, 'my_Arena', that dispenses memory from a
+// fixed buffer and meets the requirements of 'bdlma::CheckpointGuard' (in
+// practice, 'bdlma::SequentialAllocator' or 'bdlma::SequentialPool' would be
+// used):
+//..
+    class my_Arena {
+        // This class dispenses memory sequentially from a fixed buffer.
+
+        // DATA
+        char d_buffer[1024];  // buffer from which memory is dispensed
+        int  d_cursor;        // offset of the next available byte
+
+      public:
+        // CREATORS
+        my_Arena() : d_cursor(0) {}
+            // Create an arena having no memory allocated.
+
+        // MANIPULATORS
+        void *allocate(int size)
+            // Return the address of a block of the specified 'size' (in
+            // bytes), or 0 if the buffer is exhausted.
+        {
+            size = (size + 7) & ~7;
+            if (d_cursor + size > static_cast<int>(sizeof d_buffer)) {
+                return 0;                                             // RETURN
+            }
+            void *result = d_buffer + d_cursor;
+            d_cursor += size;
+            return result;
+        }
+
+        void rewind(const bdlma::Checkpoint& checkpoint)
+            // Rewind this arena to the specified 'checkpoint'.
+        {
+            d_cursor = checkpoint.cursor();
+        }
+
+        // ACCESSORS
+        bdlma::Checkpoint checkpoint() const
+            // Return the current allocation state of this arena.
+        {
+            return bdlma::Checkpoint(const_cast<char *>(d_buffer),
+                                     static_cast<int>(sizeof d_buffer),
+                                     d_cursor,
+                                     0);
+        }
+
+        int numBytesAllocated() const { return d_cursor; }
+            // Return the number of bytes allocated from this arena.
+    };
+//..
+// Then, we define a node type and a function that speculatively parses a run
+// of decimal digits into a list of nodes, failing if the run is not
+// terminated by a ';':
+//..
+    struct my_Node {
+        // This 'struct' represents a node of a parsed list of digits.
+
+        int      d_value;   // value of the digit
+        my_Node *d_next_p;  // next node in the list, or 0
+    };
+
+    my_Node *parseDigits(const char **input, my_Arena *arena)
+        // Parse the run of decimal digits at the specified '*input', followed
+        // by a ';', into a list of nodes allocated from the specified 'arena'.
+        // On success, advance '*input' past the ';' and return the head of the
+        // list; otherwise, leave '*input' and the allocation state of 'arena'
+        // unchanged and return 0.
+    {
+        bdlma::CheckpointGuard<my_Arena> guard(arena);
+
+        const char  *p    = *input;
+        my_Node     *head = 0;
+        my_Node    **tail = &head;
+
+        while ('0' <= *p && *p <= '9') {
+            my_Node *node = static_cast<my_Node *>(
+                                               arena->allocate(sizeof *node));
+            node->d_value  = *p - '0';
+            node->d_next_p = 0;
+            *tail = node;
+            tail  = &node->d_next_p;
+            ++p;
+        }
+
+        if (';' != *p) {
+            return 0;                                                 // RETURN
+        }
+
+        guard.release();
+        *input = p + 1;
+        return head;
+    }
+//..
+
+// ============================================================================
+//                                MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Next, we parse an input that does not match, repeatedly.  Since every
+// failed attempt is rewound, the arena does not grow:
+//..
+    my_Arena arena;
+
+    const char *input = "12345,";
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT(0 == parseDigits(&input, &arena));
+    }
+
+    ASSERT(0 == arena.numBytesAllocated());
+    ASSERT(0 == bsl::strcmp("12345,", input));
+//..
+// Finally, we parse an input that does match, and verify the result:
+//..
+    input = "42;";
+
+    my_Node *list = parseDigits(&input, &arena);
+
+    ASSERT(list);
+    ASSERT(4 == list->d_value);
+    ASSERT(2 == list->d_next_p->d_value);
+    ASSERT(0 == list->d_next_p->d_next_p);
+    ASSERT('\0' == *input);
+    ASSERT(0 <  arena.numBytesAllocated());
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'CheckpointGuard'
+        //   Ensure that 'bdlma::CheckpointGuard' works as expected.
+        //
+        // Concerns:
+        //: 1 A guard records the state of its arena at construction, and
+        //:   'checkpoint' reports that state.
+        //:
+        //: 2 A guard rewinds its arena to the recorded state upon destruction.
+        //:
+        //: 3 A guard does *not* rewind an arena that has been released from
+        //:   management prior to destruction.
+        //:
+        //: 4 'rewind' rewinds the arena to the recorded state, and the guard
+        //:   continues to manage the arena, so that 'rewind' may be invoked
+        //:   repeatedly and the arena is rewound again at destruction.
+        //:
+        //: 5 Nested guards each rewind to their own recorded state.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create a 'TestArena', advance its cursor, and create a guard for
+        //:   it.  Verify 'checkpoint' reports the cursor.  Advance the cursor
+        //:   further and let the guard go out of scope.  Verify the arena was
+        //:   rewound once, to the recorded cursor.  (C-1..2)
+        //:
+        //: 2 Repeat P-1, invoking 'release' before the guard goes out of
+        //:   scope, and verify the arena was not rewound.  (C-3)
+        //:
+        //: 3 Create a guard, and alternately advance the arena and invoke
+        //:   'rewind', verifying the cursor after each rewind.  Let the guard
+        //:   go out of scope, and verify the total number of rewinds.  (C-4)
+        //:
+        //: 4 Create two nested guards with the arena advanced between them,
+        //:   and verify the cursor after each goes out of scope.  (C-5)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-6)
+        //
+        // Testing:
+        //   explicit CheckpointGuard(ARENA_TYPE *arena);
+        //   ~CheckpointGuard();
+        //   void release();
+        //   void rewind();
+        //   const Checkpoint& checkpoint() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'CheckpointGuard'" << endl
+                                  << "=================" << endl;
+
+        if (verbose) cout << "Testing constructor and destructor." << endl;
+        {
+            TestArena a;  const TestArena& A = a;
+            a.advance(8);
+            {
+                const bdlma::CheckpointGuard<TestArena> X(&a);
+                ASSERTV(X.checkpoint().cursor(), 8 == X.checkpoint().cursor());
+                ASSERT(0 == A.numRewinds());
+
+                a.advance(16);
+                ASSERT(24 == A.cursor());
+            }
+            ASSERTV(A.numRewinds(), 1 == A.numRewinds());
+            ASSERTV(A.cursor(),     8 == A.cursor());
+        }
+
+        if (verbose) cout << "Testing 'release'." << endl;
+        {
+            TestArena a;  const TestArena& A = a;
+            a.advance(8);
+            {
+                bdlma::CheckpointGuard<TestArena> x(&a);
+                a.advance(16);
+                x.release();
+                x.release();
+            }
+            ASSERTV(A.numRewinds(), 0 == A.numRewinds());
+            ASSERTV(A.cursor(),    24 == A.cursor());
+        }
+
+        if (verbose) cout << "Testing 'rewind'." << endl;
+        {
+            TestArena a;  const TestArena& A = a;
+            a.advance(4);
+            {
+                bdlma::CheckpointGuard<TestArena> x(&a);
+                for (int i = 1; i <= 5; ++i) {
+                    a.advance(i);
+                    x.rewind();
+                    ASSERTV(i, A.numRewinds(), i == A.numRewinds());
+                    ASSERTV(i, A.cursor(),     4 == A.cursor());
+                }
+                a.advance(100);
+            }
+            ASSERTV(A.numRewinds(), 6 == A.numRewinds());
+            ASSERTV(A.cursor(),     4 == A.cursor());
+        }
+
+        if (verbose) cout << "Testing nested guards." << endl;
+        {
+            TestArena a;  const TestArena& A = a;
+            {
+                bdlma::CheckpointGuard<TestArena> outer(&a);
+                a.advance(10);
+                {
+                    bdlma::CheckpointGuard<TestArena> inner(&a);
+                    a.advance(20);
+                }
+                ASSERTV(A.cursor(), 10 == A.cursor());
+
+                a.advance(5);
+            }
+            ASSERTV(A.cursor(),     0 == A.cursor());
+            ASSERTV(A.numRewinds(), 2 == A.numRewinds());
+        }
+
+        if (verbose) cout << "Negative testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            TestArena a;
+
+            ASSERT_SAFE_FAIL((void) bdlma::CheckpointGuard<TestArena>(0));
+            ASSERT_SAFE_PASS((void) bdlma::CheckpointGuard<TestArena>(&a));
+
+            bdlma::CheckpointGuard<TestArena> x(&a);
+            ASSERT_SAFE_PASS(x.rewind());
+
+            x.release();
+            ASSERT_SAFE_FAIL(x.rewind());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // 'Checkpoint'
+        //   Ensure that 'bdlma::Checkpoint' stores its attributes.
+        //
+        // Concerns:
+        //: 1 A default-constructed checkpoint has a null buffer, zero size and
+        //:   cursor, and a null last block.
+        //:
+        //: 2 The value constructor stores each supplied attribute, and the
+        //:   accessors report them.
+        //:
+        //: 3 Checkpoints may be copied and assigned.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Default-construct a checkpoint and verify its attributes.  (C-1)
+        //:
+        //: 2 Using a table of attribute values, construct a checkpoint from
+        //:   each row and verify the accessors.  Copy-construct and assign
+        //:   from it, and verify the copies.  (C-2..3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-4)
+        //
+        // Testing:
+        //   Checkpoint();
+        //   Checkpoint(char *buffer, int bufferSize, int cursor, void *last);
+        //   char *buffer() const;
+        //   int bufferSize() const;
+        //   int cursor() const;
+        //   void *lastBlock() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'Checkpoint'" << endl
+                                  << "============" << endl;
+
+        if (verbose) cout << "Testing default constructor." << endl;
+        {
+            const Obj X;
+
+            ASSERT(0 == X.buffer());
+            ASSERT(0 == X.bufferSize());
+            ASSERT(0 == X.cursor());
+            ASSERT(0 == X.lastBlock());
+        }
+
+        if (verbose) cout << "Testing value constructor." << endl;
+        {
+            static char buffer[64];
+            static int  block;
+
+            static const struct {
+                int   d_line;        // source line number
+                char *d_buffer_p;    // buffer
+                int   d_bufferSize;  // buffer size
+                int   d_cursor;      // cursor
+                void *d_block_p;     // last block
+            } DATA[] = {
+                //LINE  BUFFER      SIZE  CURSOR  BLOCK
+                //----  ----------  ----  ------  ------
+                { L_,   0,             0,      0,      0 },
+                { L_,   0,             0,      0, &block },
+                { L_,   buffer,        1,      0,      0 },
+                { L_,   buffer,        1,      1,      0 },
+                { L_,   buffer,       64,      0, &block },
+                { L_,   buffer,       64,     17, &block },
+                { L_,   buffer + 8,   56,     56,      0 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE   = DATA[ti].d_line;
+                char *const BUFFER = DATA[ti].d_buffer_p;
+                const int   SIZE   = DATA[ti].d_bufferSize;
+                const int   CURSOR = DATA[ti].d_cursor;
+                void *const BLOCK  = DATA[ti].d_block_p;
+
+                if (veryVerbose) { T_ P_(LINE) P_(SIZE) P(CURSOR) }
+
+                const Obj X(BUFFER, SIZE, CURSOR, BLOCK);
+
+                ASSERTV(LINE, BUFFER == X.buffer());
+                ASSERTV(LINE, SIZE   == X.bufferSize());
+                ASSERTV(LINE, CURSOR == X.cursor());
+                ASSERTV(LINE, BLOCK  == X.lastBlock());
+
+                const Obj Y(X);
+
+                ASSERTV(LINE, BUFFER == Y.buffer());
+                ASSERTV(LINE, SIZE   == Y.bufferSize());
+                ASSERTV(LINE, CURSOR == Y.cursor());
+                ASSERTV(LINE, BLOCK  == Y.lastBlock());
+
+                Obj mZ;  const Obj& Z = mZ;
+                mZ = X;
+
+                ASSERTV(LINE, BUFFER == Z.buffer());
+                ASSERTV(LINE, SIZE   == Z.bufferSize());
+                ASSERTV(LINE, CURSOR == Z.cursor());
+                ASSERTV(LINE, BLOCK  == Z.lastBlock());
+            }
+        }
+
+        if (verbose) cout << "Negative testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            char buffer[8];
+
+            ASSERT_SAFE_PASS(Obj(buffer, 8,  0, 0));
+            ASSERT_SAFE_PASS(Obj(buffer, 8,  8, 0));
+            ASSERT_SAFE_FAIL(Obj(buffer, 8, -1, 0));
+            ASSERT_SAFE_FAIL(Obj(buffer, 8,  9, 0));
+            ASSERT_SAFE_FAIL(Obj(buffer, 0,  0, 0));
+            ASSERT_SAFE_FAIL(Obj(0,      8,  0, 0));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // HELPER CLASS TEST
+        //   Ensure that the 'TestArena' works as expected.
+        //
+        // Concerns:
+        //: 1 A 'TestArena' is created with a cursor of 0 and no rewinds.
+        //:
+        //: 2 'advance' advances the cursor, and 'checkpoint' reports it.
+        //:
+        //: 3 'rewind' restores the cursor of the supplied checkpoint and
+        //:   increments the number of rewinds.
+        //
+        // Plan:
+        //: 1 Create a 'TestArena' and verify its initial state.  (C-1)
+        //:
+        //: 2 Advance the arena, take a checkpoint, advance again, and rewind
+        //:   to the checkpoint, verifying the state after each step.
+        //:   (C-2..3)
+        //
+        // Testing:
+        //   TestArena();
+        //   void advance(int numBytes);
+        //   void rewind(const bdlma::Checkpoint& checkpoint);
+        //   bdlma::Checkpoint checkpoint() const;
+        //   int cursor() const;
+        //   int numRewinds() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "HELPER CLASS TEST" << endl
+                                  << "=================" << endl;
+
+        TestArena mX;  const TestArena& X = mX;
+        ASSERT(0 == X.cursor());
+        ASSERT(0 == X.numRewinds());
+
+        mX.advance(12);
+        ASSERT(12 == X.cursor());
+
+        const Obj C = X.checkpoint();
+        ASSERT(12 == C.cursor());
+        ASSERT( 0 == C.lastBlock());
+
+        mX.advance(30);
+        ASSERT(42 == X.cursor());
+        ASSERT( 0 == X.numRewinds());
+
+        mX.rewind(C);
+        ASSERT(12 == X.cursor());
+        ASSERT( 1 == X.numRewinds());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,196 @@
+// bdlma_concurrentpool.cpp                                           -*-C++-*-
+#include <bdlma_concurrentpool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_concurrentpool_cpp,"$Id$ $CSID$")
+
+#include <bsls_alignmentfromtype.h>
+
+#include <bsl_algorithm.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+namespace {
+
+// CONSTANTS
+enum {
+    k_INITIAL_CHUNK_SIZE =  1,  // default number of blocks per chunk
+
+    k_GROWTH_FACTOR      =  2,  // multiplicative factor by which to grow pool
+                                // capacity
+
+    k_MAX_CHUNK_SIZE     = 32   // maximum number of blocks per chunk
+};
+
+// LOCAL FUNCTIONS
+static inline
+int roundUp(int x, int y)
+    // Round up the specified 'x' to the nearest whole integer multiple of the
+    // specified 'y'.  The behavior is undefined unless '0 <= x' and '1 <= y'.
+{
+    BSLS_ASSERT(0 <= x);
+    BSLS_ASSERT(1 <= y);
+
+    return (x + y - 1) / y * y;
+}
+
+}  // close unnamed namespace
+
+                           // --------------------
+                           // class ConcurrentPool
+                           // --------------------
+
+// PRIVATE MANIPULATORS
+void ConcurrentPool::replenish()
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    if (address(loadHead(&d_freeList))) {
+
+        // Another thread replenished the pool (or deallocated a block) while
+        // this thread was waiting for the lock.
+
+        return;                                                       // RETURN
+    }
+
+    char *begin = static_cast<char *>(d_blockList.allocate(
+                                           d_chunkSize * d_internalBlockSize));
+    char *last  = begin + (d_chunkSize - 1) * d_internalBlockSize;
+
+    for (char *p = begin; p < last; p += d_internalBlockSize) {
+        reinterpret_cast<Link *>(p)->d_next_p =
+                             reinterpret_cast<Link *>(p + d_internalBlockSize);
+    }
+
+    pushList(reinterpret_cast<Link *>(begin), reinterpret_cast<Link *>(last));
+
+    if (   bsls::BlockGrowth::BSLS_GEOMETRIC == d_growthStrategy
+        && d_chunkSize < d_maxBlocksPerChunk) {
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                       d_chunkSize * k_GROWTH_FACTOR <= d_maxBlocksPerChunk)) {
+            d_chunkSize = d_chunkSize * k_GROWTH_FACTOR;
+        }
+        else {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            d_chunkSize = d_maxBlocksPerChunk;
+        }
+    }
+}
+
+// CREATORS
+ConcurrentPool::ConcurrentPool(int blockSize, bslma::Allocator *basicAllocator)
+: d_blockSize(blockSize)
+, d_chunkSize(k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(k_MAX_CHUNK_SIZE)
+, d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
+, d_blockList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= blockSize);
+
+    storeHead(&d_freeList, Head());
+
+    d_internalBlockSize = bsl::max(
+                     static_cast<int>(sizeof(Link)),
+                     roundUp(blockSize, bsls::AlignmentFromType<Link>::VALUE));
+}
+
+ConcurrentPool::ConcurrentPool(int                          blockSize,
+                               bsls::BlockGrowth::Strategy  growthStrategy,
+                               bslma::Allocator            *basicAllocator)
+: d_blockSize(blockSize)
+, d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
+              ? k_MAX_CHUNK_SIZE
+              : k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(k_MAX_CHUNK_SIZE)
+, d_growthStrategy(growthStrategy)
+, d_blockList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= blockSize);
+
+    storeHead(&d_freeList, Head());
+
+    d_internalBlockSize = bsl::max(
+                     static_cast<int>(sizeof(Link)),
+                     roundUp(blockSize, bsls::AlignmentFromType<Link>::VALUE));
+}
+
+ConcurrentPool::ConcurrentPool(int                          blockSize,
+                               bsls::BlockGrowth::Strategy  growthStrategy,
+                               int                          maxBlocksPerChunk,
+                               bslma::Allocator            *basicAllocator)
+: d_blockSize(blockSize)
+, d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
+              ? maxBlocksPerChunk
+              : k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(maxBlocksPerChunk)
+, d_growthStrategy(growthStrategy)
+, d_blockList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= blockSize);
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+
+    storeHead(&d_freeList, Head());
+
+    d_internalBlockSize = bsl::max(
+                     static_cast<int>(sizeof(Link)),
+                     roundUp(blockSize, bsls::AlignmentFromType<Link>::VALUE));
+}
+
+ConcurrentPool::~ConcurrentPool()
+{
+    BSLS_ASSERT(static_cast<int>(sizeof(Link)) <= d_internalBlockSize);
+    BSLS_ASSERT(0 < d_chunkSize);
+}
+
+// MANIPULATORS
+void ConcurrentPool::release()
+{
+    d_blockList.release();
+
+    // Keep the counter, so that a tagged pointer is never reused.
+
+    storeHead(&d_freeList, tag(0, loadHead(&d_freeList)));
+}
+
+void ConcurrentPool::reserveCapacity(int numBlocks)
+{
+    BSLS_ASSERT(0 <= numBlocks);
+
+    if (0 == numBlocks) {
+        return;                                                       // RETURN
+    }
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    char *begin = static_cast<char *>(
+                        d_blockList.allocate(numBlocks * d_internalBlockSize));
+    char *last  = begin + (numBlocks - 1) * d_internalBlockSize;
+
+    for (char *p = begin; p < last; p += d_internalBlockSize) {
+        reinterpret_cast<Link *>(p)->d_next_p =
+                             reinterpret_cast<Link *>(p + d_internalBlockSize);
+    }
+
+    pushList(reinterpret_cast<Link *>(begin), reinterpret_cast<Link *>(last));
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,682 @@
+// bdlma_concurrentpool.h                                             -*-C++-*-
+#ifndef INCLUDED_BDLMA_CONCURRENTPOOL
+#define INCLUDED_BDLMA_CONCURRENTPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide thread-safe allocation of memory blocks of uniform size.
+//
+//@CLASSES:
+//  bdlma::ConcurrentPool: thread-safe memory manager for uniform-size blocks
+//
+//@SEE_ALSO: bdlma_pool
+//
+//@DESCRIPTION: This component implements a memory pool,
+// 'bdlma::ConcurrentPool', that allocates and manages maximally-aligned memory
+// blocks of some uniform size specified at construction, and that may be used
+// by many threads at once without external synchronization.  Its interface
+// and chunk-growth behavior match those of 'bdlma::Pool', so that one may be
+// substituted for the other.
+//
+// A 'bdlma::ConcurrentPool' maintains a lock-free linked list of free memory
+// blocks.  'allocate' pops a block from the head of the list, and
+// 'deallocate' pushes a block onto it, each with a single compare-and-swap
+// and without acquiring a lock.  To prevent the ABA problem (a thread's
+// compare-and-swap succeeding after the head block was popped and pushed back
+// by other threads in the meantime), the head of the list is a "tagged
+// pointer": the address of the first free block combined with a counter that
+// is incremented on every update, both of which are replaced by a single
+// compare-and-swap (see "ABA Bound" below).
+//
+// Whenever the list of free blocks is depleted, the pool acquires an internal
+// lock, allocates a large, contiguous "chunk" of memory, splits it into
+// blocks, and pushes all of those blocks onto the free list with a single
+// compare-and-swap.  If several threads find the list empty at the same time,
+// only the first to acquire the lock replenishes the pool; the others find
+// the new blocks once they acquire the lock, and do not allocate another
+// chunk.
+//
+// Note that memory obtained from the underlying allocator is returned only
+// when 'release' is called or the pool is destroyed, so a block that has been
+// popped by one thread always remains addressable by threads that read its
+// (stale) link.
+//
+///Configuration at Construction
+///-----------------------------
+// When creating a 'bdlma::ConcurrentPool', clients must specify the specific
+// block size managed and dispensed by the pool.  Furthermore, clients can
+// optionally configure the GROWTH STRATEGY, the MAX BLOCKS PER CHUNK, and the
+// BASIC ALLOCATOR exactly as for 'bdlma::Pool' (see 'bdlma_pool').  The basic
+// allocator need not be thread-safe; it is only ever used while holding the
+// internal lock.
+//
+///Thread Safety
+///-------------
+// 'allocate', 'deallocate', 'deleteObject', 'deleteObjectRaw', and
+// 'reserveCapacity' may be called concurrently from any number of threads.
+// 'release' must *not* be called concurrently with any other method.
+//
+///ABA Bound
+///---------
+// The protection against the ABA problem lasts until the counter wraps, and
+// so depends on the width of the counter:
+//
+//: o On x86-64 platforms built with GCC or Clang, the head of the list is a
+//:   16-byte pair of the address and a 64-bit counter, updated by a 16-byte
+//:   compare-and-swap ('cmpxchg16b').  The counter wraps after 2^64 updates,
+//:   which is more than 500 years of updates at one per nanosecond.
+//:
+//: o On other 64-bit platforms, 'bsls::AtomicOperations' provides no
+//:   double-width compare-and-swap, so the address and the counter share a
+//:   single 64-bit word.  The word reserves 48 bits for the address, which
+//:   assumes (and verifies) that no block lies at or above 2^48 -- the
+//:   user-space limit of the supported platforms, which hand out higher
+//:   addresses only to processes that explicitly request them.  Block
+//:   addresses are multiples of 8, so only 45 of those bits are stored, and
+//:   the counter has 64 - 45 = 19 bits: it wraps after 524,288 updates.
+//:
+//: o On 32-bit platforms, the address and a 32-bit counter share a 64-bit
+//:   word, and the counter wraps after 4,294,967,296 updates.
+//
+// An ABA failure therefore requires a thread to be suspended between reading
+// the head of the list and its compare-and-swap while *exactly* a multiple of
+// that number of 'allocate' and 'deallocate' operations complete on other
+// threads, *and* the same block to be at the head of the list again when the
+// thread resumes.  This is possible (though unlikely) only on 64-bit
+// platforms without a double-width compare-and-swap, for a thread preempted
+// for several milliseconds while many other threads continuously allocate
+// from and deallocate to the same pool; clients on such platforms that cannot
+// accept this bound should use a 'bdlma::Pool' guarded by a mutex.
+//
+// Where the address and the counter share a word, every block address pushed
+// onto the free list is verified (with 'BSLS_ASSERT', which is enabled in all
+// but optimized-only builds) to fit in the reserved bits and to have the
+// expected alignment, since a truncated address would silently corrupt
+// memory.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing a Pool of Order Nodes Among Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that several threads create and destroy nodes of a fixed size
+// (e.g., the entries of an order cache) that are passed between threads.  A
+// single 'bdlma::ConcurrentPool' can supply the nodes to all threads.
+//
+// First, we define the node type:
+//..
+//  struct OrderNode {
+//      int        d_orderId;
+//      double     d_price;
+//      OrderNode *d_next_p;
+//  };
+//..
+// Then, we create a pool for nodes of that size:
+//..
+//  bdlma::ConcurrentPool pool(sizeof(OrderNode));
+//..
+// Now, any thread may create a node using the pool:
+//..
+//  OrderNode *node = new (pool) OrderNode();
+//  node->d_orderId = 42;
+//  node->d_price   = 1.5;
+//  node->d_next_p  = 0;
+//..
+// Finally, any thread (not necessarily the one that created it) may destroy
+// the node, returning its memory to the pool:
+//..
+//  pool.deleteObject(node);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_INFREQUENTDELETEBLOCKLIST
+#include <bdlma_infrequentdeleteblocklist.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BLOCKGROWTH
+#include <bsls_blockgrowth.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>        // for 'bsl::size_t'
+#endif
+
+#if defined(BSLS_PLATFORM_CPU_X86_64)                                         \
+ && (defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG))
+#define BDLMA_CONCURRENTPOOL_DOUBLE_WIDTH_CAS 1
+    // The head of the free list is a 16-byte pair updated with 'cmpxchg16b'.
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                           // ====================
+                           // class ConcurrentPool
+                           // ====================
+
+class ConcurrentPool {
+    // This class implements a memory pool that allocates and manages memory
+    // blocks of some uniform size specified at construction, and that may be
+    // used concurrently by multiple threads.  This memory pool maintains a
+    // lock-free linked list of free memory blocks, and dispenses one block for
+    // each 'allocate' method invocation.  When a memory block is deallocated,
+    // it is returned to the free list for potential reuse.
+
+    // PRIVATE TYPES
+    struct Link {
+        // This 'struct' implements a link data structure that stores the
+        // address of the next link, and is used to implement the internal
+        // linked list of free memory blocks.
+
+        Link *d_next_p;  // pointer to next link
+    };
+
+    typedef bsls::AtomicOperations AtomicOps;
+
+#ifdef BDLMA_CONCURRENTPOOL_DOUBLE_WIDTH_CAS
+    struct TaggedPointer {
+        // This 'struct' pairs the address of the first free block with a
+        // counter that is incremented on every update of the head of the free
+        // list; the pair is read and replaced as a unit by a 16-byte
+        // compare-and-swap.
+
+        Link                *d_link_p;   // first free block, or 0
+        bsls::Types::Uint64  d_counter;  // number of updates; wraps after
+                                         // 2^64 updates (see {ABA Bound})
+    } __attribute__((aligned(16)));
+
+    typedef TaggedPointer Head;  // value of the head of the free list
+#else
+    typedef AtomicOps::AtomicTypes::Int64 TaggedPointer;
+    typedef bsls::Types::Int64            Head;
+
+    enum {
+#ifdef BSLS_PLATFORM_CPU_64_BIT
+        k_ADDRESS_BITS   = 48,  // significant bits in the address of a block;
+                                // assumes user space lies below 2^48
+        k_ALIGNMENT_BITS =  3,  // low-order bits that are 0 in every block
+                                // address
+#else
+        k_ADDRESS_BITS   = 32,
+        k_ALIGNMENT_BITS =  0,
+#endif
+
+        k_TAG_SHIFT      = k_ADDRESS_BITS - k_ALIGNMENT_BITS
+                                // position of the counter in a tagged pointer;
+                                // the counter has '64 - k_TAG_SHIFT' bits (19
+                                // on 64-bit platforms, wrapping after 524,288
+                                // updates, and 32 on 32-bit platforms,
+                                // wrapping after 4,294,967,296 updates)
+    };
+#endif
+
+    // DATA
+    int                         d_blockSize;          // size (in bytes) of
+                                                      // each allocated block
+                                                      // returned to client
+
+    int                         d_internalBlockSize;  // actual size of each
+                                                      // block maintained on
+                                                      // free list
+
+    int                         d_chunkSize;          // current chunk size
+                                                      // (in blocks-per-chunk)
+
+    int                         d_maxBlocksPerChunk;  // maximum chunk size (in
+                                                      // blocks-per-chunk)
+
+    bsls::BlockGrowth::Strategy d_growthStrategy;     // growth strategy of the
+                                                      // chunk size
+
+    TaggedPointer               d_freeList;           // tagged address of the
+                                                      // first free block
+
+    InfrequentDeleteBlockList   d_blockList;          // memory manager for
+                                                      // allocated memory
+
+    bsls::BslLock               d_lock;               // guards chunk size and
+                                                      // 'd_blockList'
+
+  private:
+    // PRIVATE CLASS METHODS
+    static Link *address(const Head& head);
+        // Return the address of the block encoded in the specified 'head'.
+
+    static Head tag(Link *link, const Head& previous);
+        // Return a head encoding the address of the specified 'link' and a
+        // counter one greater than that of the specified 'previous' head.
+
+    static Head loadHead(TaggedPointer *taggedPointer);
+        // Return the value of the specified 'taggedPointer', with acquire
+        // semantics.  Note that, where the head is a 16-byte pair, the two
+        // halves may be read from different updates; a torn value is never
+        // installed, since the compare-and-swap that follows fails.
+
+    static void storeHead(TaggedPointer *taggedPointer, const Head& value);
+        // Set the specified 'taggedPointer' to the specified 'value', with
+        // release semantics.  The behavior is undefined if 'taggedPointer' is
+        // modified concurrently.
+
+    static bool compareAndSwap(TaggedPointer *taggedPointer,
+                               Head          *expected,
+                               const Head&    value);
+        // If the specified 'taggedPointer' has the value of the specified
+        // '*expected', atomically set it to the specified 'value' and return
+        // 'true'; otherwise, load the current value of 'taggedPointer' into
+        // '*expected' and return 'false'.  The operation has acquire-release
+        // semantics.
+
+    // PRIVATE MANIPULATORS
+    void pushList(Link *first, Link *last);
+        // Atomically add the list of free blocks from the specified 'first'
+        // through the specified 'last' block (linked by their 'd_next_p'
+        // members) to the head of the free list of this pool.
+
+    void replenish();
+        // Dynamically allocate a new chunk using this pool's underlying growth
+        // strategy, unless another thread has added blocks to the free list
+        // since it was found to be empty.
+
+  private:
+    // NOT IMPLEMENTED
+    ConcurrentPool(const ConcurrentPool&);
+    ConcurrentPool& operator=(const ConcurrentPool&);
+
+  public:
+    // CREATORS
+    explicit
+    ConcurrentPool(int                          blockSize,
+                   bslma::Allocator            *basicAllocator = 0);
+    ConcurrentPool(int                          blockSize,
+                   bsls::BlockGrowth::Strategy  growthStrategy,
+                   bslma::Allocator            *basicAllocator = 0);
+    ConcurrentPool(int                          blockSize,
+                   bsls::BlockGrowth::Strategy  growthStrategy,
+                   int                          maxBlocksPerChunk,
+                   bslma::Allocator            *basicAllocator = 0);
+        // Create a memory pool that returns blocks of contiguous memory of the
+        // specified 'blockSize' (in bytes) for each 'allocate' method
+        // invocation.  Optionally specify a 'growthStrategy' used to control
+        // the growth of internal memory chunks (from which memory blocks are
+        // dispensed).  If 'growthStrategy' is not specified, geometric growth
+        // is used.  Optionally specify 'maxBlocksPerChunk' as the maximum
+        // chunk size if 'growthStrategy' is specified.  If geometric growth is
+        // used, the chunk size grows starting at 'blockSize', doubling in size
+        // until the size is exactly 'blockSize * maxBlocksPerChunk'.  If
+        // constant growth is used, the chunk size is always
+        // 'blockSize * maxBlocksPerChunk'.  If 'maxBlocksPerChunk' is not
+        // specified, an implementation-defined value is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '1 <= blockSize' and
+        // '1 <= maxBlocksPerChunk'.
+
+    ~ConcurrentPool();
+        // Destroy this pool, releasing all associated memory back to the
+        // underlying allocator.
+
+    // MANIPULATORS
+    void *allocate();
+        // Return the address of a contiguous block of maximally-aligned memory
+        // having the fixed block size specified at construction.
+
+    void deallocate(void *address);
+        // Relinquish the memory block at the specified 'address' back to this
+        // pool object for reuse.  The behavior is undefined unless 'address'
+        // is non-zero, was allocated by this pool, and has not already been
+        // deallocated.  Note that 'address' need not have been allocated by
+        // the calling thread.
+
+    template <class TYPE>
+    void deleteObject(const TYPE *object);
+        // Destroy the specified 'object' based on its dynamic type and then
+        // use this pool to deallocate its memory footprint.  This method has
+        // no effect if 'object' is 0.  The behavior is undefined unless
+        // 'object', when cast appropriately to 'void *', was allocated using
+        // this pool and has not already been deallocated.  Note that
+        // 'dynamic_cast<void *>(object)' is applied if 'TYPE' is polymorphic,
+        // and 'static_cast<void *>(object)' is applied otherwise.
+
+    template <class TYPE>
+    void deleteObjectRaw(const TYPE *object);
+        // Destroy the specified 'object' and then use this pool to deallocate
+        // its memory footprint.  This method has no effect if 'object' is 0.
+        // The behavior is undefined unless 'object' is !not! a secondary base
+        // class pointer (i.e., the address is (numerically) the same as when
+        // it was originally dispensed by this pool), was allocated using this
+        // pool, and has not already been deallocated.
+
+    void release();
+        // Relinquish all memory currently allocated via this pool object.  The
+        // behavior is undefined if this method is called concurrently with any
+        // other method of this object.
+
+    void reserveCapacity(int numBlocks);
+        // Reserve memory from this pool to satisfy memory requests for at
+        // least the specified 'numBlocks' before the pool replenishes.  The
+        // behavior is undefined unless '0 <= numBlocks'.  Note that, as the
+        // free list cannot be traversed safely while other threads use this
+        // pool, 'numBlocks' new blocks are added to the free list regardless
+        // of the number of blocks already free.
+
+    // ACCESSORS
+    int blockSize() const;
+        // Return the size (in bytes) of the memory blocks allocated from this
+        // pool object.  Note that all blocks dispensed by this pool have the
+        // same size.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// FREE OPERATORS
+void *operator new(bsl::size_t size, BloombergLP::bdlma::ConcurrentPool& pool);
+    // Return a block of memory of the specified 'size' (in bytes) allocated
+    // from the specified 'pool'.  The behavior is undefined unless 'size' is
+    // the same or smaller than the 'blockSize' with which 'pool' was
+    // constructed.  Note that the analogous version of 'operator delete'
+    // should not be called directly; use 'pool.deleteObject' instead (see
+    // 'bdlma_pool').
+
+void operator delete(void *address, BloombergLP::bdlma::ConcurrentPool& pool);
+    // Use the specified 'pool' to deallocate the memory at the specified
+    // 'address'.  The behavior is undefined unless 'address' is non-zero, was
+    // allocated using 'pool', and has not already been deallocated.  Note that
+    // this operator is supplied solely to allow the compiler to arrange for it
+    // to be called in the case of an exception.
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+namespace BloombergLP {
+namespace bdlma {
+
+                           // --------------------
+                           // class ConcurrentPool
+                           // --------------------
+
+// PRIVATE CLASS METHODS
+#ifdef BDLMA_CONCURRENTPOOL_DOUBLE_WIDTH_CAS
+inline
+ConcurrentPool::Link *ConcurrentPool::address(const Head& head)
+{
+    return head.d_link_p;
+}
+
+inline
+ConcurrentPool::Head ConcurrentPool::tag(Link *link, const Head& previous)
+{
+    Head result;
+    result.d_link_p  = link;
+    result.d_counter = previous.d_counter + 1;
+    return result;
+}
+
+inline
+ConcurrentPool::Head ConcurrentPool::loadHead(TaggedPointer *taggedPointer)
+{
+    Head result;
+    result.d_counter = __atomic_load_n(&taggedPointer->d_counter,
+                                       __ATOMIC_ACQUIRE);
+    result.d_link_p  = __atomic_load_n(&taggedPointer->d_link_p,
+                                       __ATOMIC_ACQUIRE);
+    return result;
+}
+
+inline
+void ConcurrentPool::storeHead(TaggedPointer *taggedPointer,
+                               const Head&    value)
+{
+    __atomic_store_n(&taggedPointer->d_counter,
+                     value.d_counter,
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&taggedPointer->d_link_p,
+                     value.d_link_p,
+                     __ATOMIC_RELEASE);
+}
+
+inline
+bool ConcurrentPool::compareAndSwap(TaggedPointer *taggedPointer,
+                                    Head          *expected,
+                                    const Head&    value)
+{
+    // 'cmpxchg16b' compares 'rdx:rax' with the 16 bytes at 'taggedPointer',
+    // stores 'rcx:rbx' there if they are equal, and otherwise loads the 16
+    // bytes into 'rdx:rax'.  The 'lock' prefix makes it a full barrier.
+
+    bool result;
+    __asm__ __volatile__ ("lock; cmpxchg16b %1\n\t"
+                          "sete %0"
+                          : "=q" (result),
+                            "+m" (*taggedPointer),
+                            "+a" (expected->d_link_p),
+                            "+d" (expected->d_counter)
+                          : "b" (value.d_link_p),
+                            "c" (value.d_counter)
+                          : "memory", "cc");
+    return result;
+}
+#else
+inline
+ConcurrentPool::Link *ConcurrentPool::address(const Head& head)
+{
+    const bsls::Types::Uint64 mask =
+                      (static_cast<bsls::Types::Uint64>(1) << k_TAG_SHIFT) - 1;
+
+    return reinterpret_cast<Link *>(static_cast<bsls::Types::UintPtr>(
+                         (static_cast<bsls::Types::Uint64>(head) & mask)
+                                                         << k_ALIGNMENT_BITS));
+}
+
+inline
+ConcurrentPool::Head ConcurrentPool::tag(Link *link, const Head& previous)
+{
+    const bsls::Types::Uint64 bits = reinterpret_cast<bsls::Types::UintPtr>(
+                                                                        link);
+
+    const bsls::Types::Uint64 counter =
+            (static_cast<bsls::Types::Uint64>(previous) >> k_TAG_SHIFT) + 1;
+
+    return static_cast<Head>((counter << k_TAG_SHIFT)
+                                                 | (bits >> k_ALIGNMENT_BITS));
+}
+
+inline
+ConcurrentPool::Head ConcurrentPool::loadHead(TaggedPointer *taggedPointer)
+{
+    return AtomicOps::getInt64Acquire(taggedPointer);
+}
+
+inline
+void ConcurrentPool::storeHead(TaggedPointer *taggedPointer,
+                               const Head&    value)
+{
+    AtomicOps::setInt64Release(taggedPointer, value);
+}
+
+inline
+bool ConcurrentPool::compareAndSwap(TaggedPointer *taggedPointer,
+                                    Head          *expected,
+                                    const Head&    value)
+{
+    const Head previous = AtomicOps::testAndSwapInt64AcqRel(taggedPointer,
+                                                            *expected,
+                                                            value);
+    if (previous == *expected) {
+        return true;                                                  // RETURN
+    }
+    *expected = previous;
+    return false;
+}
+#endif
+
+// MANIPULATORS
+inline
+void *ConcurrentPool::allocate()
+{
+    Head head = loadHead(&d_freeList);
+
+    for (;;) {
+        Link *link = address(head);
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!link)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            replenish();
+            head = loadHead(&d_freeList);
+            continue;
+        }
+
+        // 'link' may already have been popped (and its 'd_next_p' member
+        // overwritten) by another thread; the counter in the tag ensures that
+        // the compare-and-swap then fails.
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                    compareAndSwap(&d_freeList,
+                                   &head,
+                                   tag(link->d_next_p, head)))) {
+            return link;                                              // RETURN
+        }
+    }
+}
+
+inline
+void ConcurrentPool::deallocate(void *address)
+{
+    BSLS_ASSERT_SAFE(address);
+
+    Link *link = static_cast<Link *>(address);
+    pushList(link, link);
+}
+
+template <class TYPE>
+inline
+void ConcurrentPool::deleteObject(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObject(object, this);
+}
+
+template <class TYPE>
+inline
+void ConcurrentPool::deleteObjectRaw(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObjectRaw(object, this);
+}
+
+inline
+void ConcurrentPool::pushList(Link *first, Link *last)
+{
+#ifndef BDLMA_CONCURRENTPOOL_DOUBLE_WIDTH_CAS
+    BSLS_ASSERT(0 == (static_cast<bsls::Types::Uint64>(
+                                reinterpret_cast<bsls::Types::UintPtr>(first))
+                                                           >> k_ADDRESS_BITS));
+    BSLS_ASSERT(0 == (reinterpret_cast<bsls::Types::UintPtr>(first)
+                                             & ((1 << k_ALIGNMENT_BITS) - 1)));
+#endif
+
+    Head head = loadHead(&d_freeList);
+
+    for (;;) {
+        last->d_next_p = address(head);
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                       compareAndSwap(&d_freeList, &head, tag(first, head)))) {
+            return;                                                   // RETURN
+        }
+    }
+}
+
+// ACCESSORS
+inline
+int ConcurrentPool::blockSize() const
+{
+    return d_blockSize;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// FREE OPERATORS
+inline
+void *operator new(bsl::size_t size, BloombergLP::bdlma::ConcurrentPool& pool)
+{
+    using namespace BloombergLP;
+
+    BSLS_ASSERT_SAFE(
+        static_cast<int>(size) <= pool.blockSize() &&
+        bsls::AlignmentUtil::calculateAlignmentFromSize(size)
+         <= bsls::AlignmentUtil::calculateAlignmentFromSize(pool.blockSize()));
+
+    static_cast<void>(size);  // suppress "unused parameter" warnings
+    return pool.allocate();
+}
+
+inline
+void operator delete(void *address, BloombergLP::bdlma::ConcurrentPool& pool)
+{
+    BSLS_ASSERT_SAFE(address);
+
+    pool.deallocate(address);
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
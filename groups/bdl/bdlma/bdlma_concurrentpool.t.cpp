@@ -0,0 +1,848 @@
+// bdlma_concurrentpool.t.cpp                                         -*-C++-*-
+#include <bdlma_concurrentpool.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// A 'bdlma::ConcurrentPool' is a mechanism (i.e., having state but no value)
+// that dispenses memory blocks of a uniform size to any number of threads.
+//
+// The goals of this test driver are to verify that: 1) 'allocate' dispenses
+// distinct, suitably-aligned blocks, 2) the pool replenishes according to the
+// 'growthStrategy' and 'maxBlocksPerChunk' constructor parameters, 3)
+// 'deallocate' returns blocks to the pool for reuse, 4) 'release' and the
+// destructor release all memory, and 5) concurrent allocation and
+// deallocation neither dispenses a block twice nor replenishes the pool more
+// often than necessary.  The 'bslma_testallocator' component is used to
+// observe the chunks requested by the pool.
+//-----------------------------------------------------------------------------
+// [ 2] ConcurrentPool(bs, basicAllocator = 0);
+// [ 2] ConcurrentPool(bs, gs, basicAllocator = 0);
+// [ 2] ConcurrentPool(bs, gs, mbpc, basicAllocator = 0);
+// [ 2] ~ConcurrentPool();
+// [ 3] void *allocate();
+// [ 3] void deallocate(void *address);
+// [ 4] template <class TYPE> void deleteObject(const TYPE *object);
+// [ 4] template <class TYPE> void deleteObjectRaw(const TYPE *object);
+// [ 5] void release();
+// [ 5] void reserveCapacity(int numBlocks);
+// [ 2] int blockSize() const;
+// [ 4] void *operator new(bsl::size_t size, bdlma::ConcurrentPool& pool);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] CONCERN: Concurrent use never dispenses a block twice.
+// [ 7] CONCERN: Concurrent exhaustion replenishes the pool only as needed.
+// [ 8] USAGE EXAMPLE
+// [ *] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                       GLOBAL TYPES AND CONSTANTS
+//-----------------------------------------------------------------------------
+
+typedef bdlma::ConcurrentPool       Obj;
+
+typedef bsls::BlockGrowth::Strategy Strategy;
+
+const Strategy GEO = bsls::BlockGrowth::BSLS_GEOMETRIC;
+const Strategy CON = bsls::BlockGrowth::BSLS_CONSTANT;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+//=============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+bool isNaturallyAligned(const void *address, int size)
+    // Return 'true' if the specified 'address' is suitably aligned for an
+    // object of the specified 'size', and 'false' otherwise.
+{
+    const int alignment =
+                     bsls::AlignmentUtil::calculateAlignmentFromSize(size);
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address) % alignment;
+}
+
+                                // ------
+                                // case 6
+                                // ------
+
+enum { NUM_THREADS = 16, NUM_ITERATIONS = 20000, NUM_SLOTS = 16 };
+
+struct StressArgs {
+    Obj             *d_pool_p;      // pool shared by all threads
+    int              d_id;          // index of this thread
+    bsls::AtomicInt *d_errors_p;    // number of corrupted blocks detected
+};
+
+extern "C" void *stressThread(void *arg)
+    // Repeatedly allocate blocks from the shared pool, stamp each with the
+    // identity of this thread, and verify the stamp before deallocating it.
+{
+    StressArgs& args = *static_cast<StressArgs *>(arg);
+    Obj&        mX   = *args.d_pool_p;
+
+    int *slots[NUM_SLOTS];
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        slots[i] = 0;
+    }
+
+    unsigned seed = args.d_id + 1;
+
+    for (int iter = 0; iter < NUM_ITERATIONS; ++iter) {
+        seed = seed * 1103515245 + 12345;
+
+        const int slot = (seed >> 8) % NUM_SLOTS;
+
+        if (slots[slot]) {
+            if (slots[slot][0] != args.d_id) {
+                ++*args.d_errors_p;
+            }
+            mX.deallocate(slots[slot]);
+        }
+
+        slots[slot]    = static_cast<int *>(mX.allocate());
+        slots[slot][0] = args.d_id;
+        slots[slot][1] = iter;
+    }
+
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        if (slots[i]) {
+            if (slots[i][0] != args.d_id) {
+                ++*args.d_errors_p;
+            }
+            mX.deallocate(slots[i]);
+        }
+    }
+
+    return arg;
+}
+
+                                // ------
+                                // case 7
+                                // ------
+
+enum { NUM_EXHAUST_BLOCKS = 1000 };
+
+struct ExhaustArgs {
+    Obj             *d_pool_p;      // pool shared by all threads
+    void           **d_blocks_p;    // blocks allocated by this thread
+    bsls::AtomicInt *d_start_p;     // set to 1 to start all threads
+};
+
+extern "C" void *exhaustThread(void *arg)
+    // Allocate 'NUM_EXHAUST_BLOCKS' blocks from the shared pool without
+    // deallocating any of them.
+{
+    ExhaustArgs& args = *static_cast<ExhaustArgs *>(arg);
+
+    while (0 == *args.d_start_p) {
+    }
+
+    for (int i = 0; i < NUM_EXHAUST_BLOCKS; ++i) {
+        args.d_blocks_p[i] = args.d_pool_p->allocate();
+    }
+    return arg;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Example 1: Sharing a Pool of Order Nodes Among Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that several threads create and destroy nodes of a fixed size
+// (e.g., the entries of an order cache) that are passed between threads.  A
+// single 'bdlma::ConcurrentPool' can supply the nodes to all threads.
+//
+// First, we define the node type:
+//..
+    struct OrderNode {
+        int        d_orderId;
+        double     d_price;
+        OrderNode *d_next_p;
+    };
+//..
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator  testAllocator(veryVeryVerbose);
+    bslma::Allocator     *Z = &testAllocator;
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+//..
+// Then, we create a pool for nodes of that size:
+//..
+    bdlma::ConcurrentPool pool(sizeof(OrderNode));
+//..
+// Now, any thread may create a node using the pool:
+//..
+    OrderNode *node = new (pool) OrderNode();
+    node->d_orderId = 42;
+    node->d_price   = 1.5;
+    node->d_next_p  = 0;
+//..
+// Finally, any thread (not necessarily the one that created it) may destroy
+// the node, returning its memory to the pool:
+//..
+    pool.deleteObject(node);
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENT REPLENISHMENT
+        //
+        // Concerns:
+        //: 1 When several threads find the free list empty at the same time,
+        //:   only one of them allocates a new chunk.
+        //
+        // Plan:
+        //: 1 Using constant growth, have several threads simultaneously
+        //:   allocate a number of blocks each without deallocating any.
+        //:   Verify that the number of chunks requested from the test
+        //:   allocator is exactly the number needed to supply all of the
+        //:   blocks, and that no block was dispensed twice.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: Concurrent exhaustion replenishes only as needed.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONCURRENT REPLENISHMENT"
+                          << endl << "========================" << endl;
+
+        enum { CHUNK = 7, NUM_BLOCKS = NUM_THREADS * NUM_EXHAUST_BLOCKS };
+
+        {
+            Obj mX(sizeof(int), CON, CHUNK, Z);
+
+            bsls::AtomicInt  start(0);
+            ExhaustArgs      args[NUM_THREADS];
+            ThreadId         ids[NUM_THREADS];
+
+            void **blocks = static_cast<void **>(
+                                 testAllocator.allocate(NUM_BLOCKS
+                                                        * sizeof(void *)));
+            const bsls::Types::Int64 NUM_ALLOCATIONS =
+                                               testAllocator.numAllocations();
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                args[i].d_pool_p   = &mX;
+                args[i].d_blocks_p = blocks + i * NUM_EXHAUST_BLOCKS;
+                args[i].d_start_p  = &start;
+                ids[i] = createThread(&exhaustThread, &args[i]);
+            }
+            start = 1;
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            const bsls::Types::Int64 numChunks =
+                             testAllocator.numAllocations() - NUM_ALLOCATIONS;
+
+            if (veryVerbose) { P(numChunks) }
+
+            LOOP_ASSERT(numChunks,
+                        (NUM_BLOCKS + CHUNK - 1) / CHUNK == numChunks);
+
+            // Stamp every block with its index and verify all stamps, to
+            // detect any block dispensed twice.
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                *static_cast<int *>(blocks[i]) = i;
+            }
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                LOOP_ASSERT(i, i == *static_cast<int *>(blocks[i]));
+            }
+
+            testAllocator.deallocate(blocks);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENT ALLOCATION AND DEALLOCATION
+        //
+        // Concerns:
+        //: 1 Many threads may concurrently allocate and deallocate blocks.
+        //:
+        //: 2 A block is never dispensed to two threads at once (i.e., the free
+        //:   list is not corrupted by the ABA problem).
+        //
+        // Plan:
+        //: 1 Create several threads that each repeatedly allocate blocks from
+        //:   one pool, stamp each block with the thread's identity, and verify
+        //:   that stamp before deallocating the block.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: Concurrent use never dispenses a block twice.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT ALLOCATION AND DEALLOCATION" << endl
+                          << "======================================" << endl;
+
+        {
+            Obj mX(2 * sizeof(int), Z);
+
+            bsls::AtomicInt errors(0);
+
+            StressArgs args[NUM_THREADS];
+            ThreadId   ids[NUM_THREADS];
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                args[i].d_pool_p   = &mX;
+                args[i].d_id       = i;
+                args[i].d_errors_p = &errors;
+                ids[i] = createThread(&stressThread, &args[i]);
+            }
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            LOOP_ASSERT(errors, 0 == errors);
+
+            // At most 'NUM_THREADS * NUM_SLOTS' blocks are ever in use, so
+            // geometric growth bounds the memory the pool acquired.
+
+            if (veryVerbose) { P(testAllocator.numBytesInUse()) }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'release' AND 'reserveCapacity'
+        //
+        // Concerns:
+        //: 1 'release' returns all memory to the underlying allocator, and the
+        //:   pool remains usable.
+        //:
+        //: 2 After 'reserveCapacity(n)', 'n' blocks can be allocated without
+        //:   obtaining memory from the underlying allocator.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate blocks, 'release', verify that no memory is in use, and
+        //:   allocate again.  (C-1)
+        //:
+        //: 2 For a range of 'n', reserve 'n' blocks and verify that allocating
+        //:   'n' blocks does not use the test allocator.  (C-2)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-3)
+        //
+        // Testing:
+        //   void release();
+        //   void reserveCapacity(int numBlocks);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'release' AND 'reserveCapacity'" << endl
+                          << "=======================================" << endl;
+
+        {
+            Obj mX(24, Z);
+
+            for (int i = 0; i < 100; ++i) {
+                mX.allocate();
+            }
+            ASSERT(0 < testAllocator.numBlocksInUse());
+
+            mX.release();
+            ASSERT(0 == testAllocator.numBlocksInUse());
+
+            void *p = mX.allocate();
+            ASSERT(p);
+            memset(p, 0xa5, 24);
+            mX.deallocate(p);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        for (int n = 0; n < 50; ++n) {
+            Obj mX(16, GEO, 4, Z);
+
+            mX.reserveCapacity(n);
+
+            const bsls::Types::Int64 NUM_ALLOCATIONS =
+                                               testAllocator.numAllocations();
+
+            for (int i = 0; i < n; ++i) {
+                mX.allocate();
+            }
+
+            LOOP_ASSERT(n, NUM_ALLOCATIONS == testAllocator.numAllocations());
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(8, Z);
+
+            ASSERT_PASS(mX.reserveCapacity( 0));
+            ASSERT_PASS(mX.reserveCapacity( 1));
+            ASSERT_FAIL(mX.reserveCapacity(-1));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'deleteObject', 'deleteObjectRaw', AND 'operator new'
+        //
+        // Concerns:
+        //: 1 'operator new' constructs an object in a block from the pool.
+        //:
+        //: 2 'deleteObject' and 'deleteObjectRaw' destroy the object and
+        //:   return its footprint to the pool for reuse.
+        //:
+        //: 3 Both delete methods have no effect on a null pointer.
+        //
+        // Plan:
+        //: 1 Create an object with 'operator new', delete it, and verify that
+        //:   its destructor ran and that the next allocation returns the same
+        //:   address.  (C-1..2)
+        //:
+        //: 2 Invoke both methods with a null pointer.  (C-3)
+        //
+        // Testing:
+        //   template <class TYPE> void deleteObject(const TYPE *object);
+        //   template <class TYPE> void deleteObjectRaw(const TYPE *object);
+        //   void *operator new(bsl::size_t size, bdlma::ConcurrentPool& pool);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'deleteObject' AND 'deleteObjectRaw'"
+                          << endl
+                          << "============================================"
+                          << endl;
+
+        struct Probe {
+            int *d_destroyed_p;
+
+            explicit Probe(int *destroyed) : d_destroyed_p(destroyed) {}
+            ~Probe() { ++*d_destroyed_p; }
+        };
+
+        int destroyed = 0;
+
+        Obj mX(sizeof(Probe), Z);
+
+        Probe *p = new (mX) Probe(&destroyed);
+        mX.deleteObject(p);
+        ASSERT(1 == destroyed);
+
+        Probe *q = new (mX) Probe(&destroyed);
+        ASSERT(p == q);
+
+        mX.deleteObjectRaw(q);
+        ASSERT(2 == destroyed);
+
+        mX.deleteObject(static_cast<Probe *>(0));
+        mX.deleteObjectRaw(static_cast<Probe *>(0));
+        ASSERT(2 == destroyed);
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns distinct, suitably-aligned blocks of at least
+        //:   the block size.
+        //:
+        //: 2 'deallocate' places a block at the head of the free list, so
+        //:   that blocks are reused in reverse order of deallocation.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a range of block sizes, allocate blocks, verify alignment,
+        //:   and write to every byte.  (C-1)
+        //:
+        //: 2 Allocate an array of blocks, deallocate them in order, and verify
+        //:   that they are allocated again in reverse order.  (C-2)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-3)
+        //
+        // Testing:
+        //   void *allocate();
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocate' AND 'deallocate'" << endl
+                          << "===================================" << endl;
+
+        for (int size = 1; size <= 100; ++size) {
+            Obj mX(size, Z);
+
+            char *p[20];
+            for (int i = 0; i < 20; ++i) {
+                p[i] = static_cast<char *>(mX.allocate());
+                LOOP2_ASSERT(size, i, isNaturallyAligned(p[i], size));
+                memset(p[i], i, size);
+            }
+            for (int i = 0; i < 20; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    LOOP3_ASSERT(size, i, j, i == p[i][j]);
+                }
+            }
+            for (int i = 0; i < 20; ++i) {
+                mX.deallocate(p[i]);
+            }
+            for (int i = 19; i >= 0; --i) {
+                LOOP2_ASSERT(size, i, p[i] == mX.allocate());
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(8, Z);
+
+            void *p = mX.allocate();
+            ASSERT_SAFE_PASS(mX.deallocate(p));
+            ASSERT_SAFE_FAIL(mX.deallocate(0));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND 'blockSize'
+        //
+        // Concerns:
+        //: 1 'blockSize' returns the block size supplied at construction.
+        //:
+        //: 2 The pool requests chunks whose sizes follow the specified growth
+        //:   strategy and maximum blocks per chunk, exactly as 'bdlma::Pool'.
+        //:
+        //: 3 Memory is supplied by the allocator specified at construction,
+        //:   or by the default allocator if none is specified, and is
+        //:   returned to it on destruction.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Construct pools with each constructor and verify 'blockSize'.
+        //:   (C-1)
+        //:
+        //: 2 For each growth strategy and a range of maximum chunk sizes,
+        //:   allocate blocks one at a time and verify, after each allocation
+        //:   that replenishes the pool, the size of the chunk requested from
+        //:   the test allocator.  (C-2..3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   ConcurrentPool(bs, basicAllocator = 0);
+        //   ConcurrentPool(bs, gs, basicAllocator = 0);
+        //   ConcurrentPool(bs, gs, mbpc, basicAllocator = 0);
+        //   ~ConcurrentPool();
+        //   int blockSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CREATORS AND 'blockSize'" << endl
+                          << "================================" << endl;
+
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Obj mX(5);  const Obj& X = mX;
+            ASSERT(5 == X.blockSize());
+
+            mX.allocate();
+            ASSERT(1 == da.numBlocksInUse());
+        }
+
+        {
+            Obj mX(12, CON, Z);  const Obj& X = mX;
+            ASSERT(12 == X.blockSize());
+        }
+
+        const int BS = 16;  // a multiple of every supported 'Link' alignment
+
+        for (int max = 1; max <= 40; ++max) {
+            for (int s = 0; s < 2; ++s) {
+                const Strategy STRATEGY = s ? CON : GEO;
+
+                Obj mX(BS, STRATEGY, max, Z);
+
+                int expected = GEO == STRATEGY ? 1 : max;
+                int numBlocks = 0;  // blocks remaining in the current chunk
+
+                for (int i = 0; i < 200; ++i) {
+                    const bsls::Types::Int64 NUM_ALLOCATIONS =
+                                               testAllocator.numAllocations();
+                    mX.allocate();
+
+                    if (0 == numBlocks) {
+                        LOOP3_ASSERT(max, s, i,
+                                     NUM_ALLOCATIONS + 1 ==
+                                               testAllocator.numAllocations());
+
+                        // The block list adds its own header to each chunk.
+
+                        const bslma::Allocator::size_type CHUNK_BYTES =
+                                                                 expected * BS;
+
+                        LOOP3_ASSERT(max, s, i,
+                                     CHUNK_BYTES
+                                     <= testAllocator.lastAllocatedNumBytes());
+                        LOOP3_ASSERT(max, s, i,
+                                     CHUNK_BYTES + 64
+                                      > testAllocator.lastAllocatedNumBytes());
+
+                        numBlocks = expected - 1;
+                        if (GEO == STRATEGY) {
+                            expected = expected * 2 <= max ? expected * 2
+                                                           : max;
+                        }
+                    }
+                    else {
+                        LOOP3_ASSERT(max, s, i,
+                                     NUM_ALLOCATIONS ==
+                                               testAllocator.numAllocations());
+                        --numBlocks;
+                    }
+                }
+            }
+            LOOP_ASSERT(max, 0 == testAllocator.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj( 1, Z));
+            ASSERT_FAIL(Obj( 0, Z));
+            ASSERT_FAIL(Obj(-1, Z));
+
+            ASSERT_PASS(Obj(1, GEO, 1, Z));
+            ASSERT_FAIL(Obj(1, GEO, 0, Z));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //   That the basic functionality of 'bdlma::ConcurrentPool' works
+        //   properly.
+        //
+        // Plan:
+        //   Create a pool, allocate and deallocate a few blocks, reserve
+        //   capacity, and release all memory.  Finally, let the pool go out
+        //   of scope to exercise the destructor.
+        //
+        // Testing:
+        //   This "test" exercises basic functionality, but tests nothing.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST"
+                          << endl << "==============" << endl;
+
+        {
+            Obj mX(32, Z);
+
+            void *p = mX.allocate();  ASSERT(p);
+            void *q = mX.allocate();  ASSERT(q);
+            ASSERT(p != q);
+
+            mX.deallocate(p);
+            ASSERT(p == mX.allocate());
+
+            mX.reserveCapacity(10);
+            mX.deallocate(q);
+
+            mX.release();
+            ASSERT(0 == testAllocator.numBlocksInUse());
+
+            p = mX.allocate();  ASSERT(p);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -4,12 +4,18 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(bdlma_countingallocator_cpp,"$Id$ $CSID$")
 
+#include <bdlma_threadindexutil.h>
+
 #include <bslma_default.h>
 
+#include <bslmf_assert.h>
+
 #include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
+#include <bsls_atomicoperations.h>
 #include <bsls_performancehint.h>
 
+#include <bsl_limits.h>
 #include <bsl_ostream.h>
 
 namespace BloombergLP {
@@ -17,6 +23,9 @@ namespace bdlma {
 
 namespace {
 
+typedef bsls::AtomicOperations              AtomicOps;
+typedef bsls::AtomicOperations::AtomicTypes AtomicTypes;
+
 // LOCAL CONSTANTS
 
 // Define the number of bytes by which the address returned to the user is
@@ -25,17 +34,245 @@ namespace {
 const bslma::Allocator::size_type OFFSET =
                                        bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
 
+// Define the number of shards of histogram counters of each allocator, and
+// the alignment of each shard.
+
+const int NUM_SHARDS = 8;
+const int CACHE_LINE = 64;
+
+// Define the number of ticks claimed by a shard at a time.  Batches are
+// claimed at multiples of 'TICK_BATCH', so a shard whose next tick is such a
+// multiple has exhausted its batch.
+
+const int TICK_BATCH = 64;
+
+struct HistogramHeader {
+    // This 'struct' overlays the start of a block allocated by a counting
+    // allocator that collects histograms.
+
+    bslma::Allocator::size_type d_size;  // size requested for the block
+    bsls::Types::Int64          d_tick;  // tick at which it was allocated
+};
+
+// HELPER FUNCTIONS
+
+int floorLog2(bsls::Types::Uint64 value)
+    // Return the index of the most significant set bit of the specified
+    // 'value'.  The behavior is undefined unless '0 < value'.
+{
+    BSLS_ASSERT_SAFE(0 < value);
+
+    int result = 0;
+
+    if (value >> 32) { value >>= 32; result += 32; }
+    if (value >> 16) { value >>= 16; result += 16; }
+    if (value >>  8) { value >>=  8; result +=  8; }
+    if (value >>  4) { value >>=  4; result +=  4; }
+    if (value >>  2) { value >>=  2; result +=  2; }
+    if (value >>  1) {               result +=  1; }
+
+    return result;
+}
+
+int threadShard()
+    // Return the index of the shard of histogram counters assigned to the
+    // calling thread.  Note that shards are assigned to threads in round-robin
+    // order of their indices, and that the assignments are shared by all
+    // counting allocators.
+{
+    return ThreadIndexUtil::threadIndex() % NUM_SHARDS;
+}
+
 }  // close unnamed namespace
 
+                       // ------------------------------
+                       // struct CountingAllocator::Shard
+                       // ------------------------------
+
+struct CountingAllocator::Shard {
+    // This 'struct' holds the histogram counters updated by the threads
+    // assigned to one shard.  Note that its size is a multiple of the cache
+    // line size, so that consecutive shards share no cache line.
+
+    AtomicTypes::Int64 d_nextTick;  // next tick of the batch claimed by the
+                                    // shard, or a multiple of 'TICK_BATCH' if
+                                    // the batch is exhausted
+
+    char               d_padding[CACHE_LINE - sizeof(AtomicTypes::Int64)];
+
+    AtomicTypes::Int64 d_numAllocations[k_NUM_SIZE_CLASSES];
+    AtomicTypes::Int64 d_numBytes[k_NUM_SIZE_CLASSES];
+    AtomicTypes::Int64 d_lifetimes[k_NUM_SIZE_CLASSES]
+                                  [k_NUM_LIFETIME_BUCKETS];
+};
+
                          // -----------------------
                          // class CountingAllocator
                          // -----------------------
 
+// PRIVATE MANIPULATORS
+void CountingAllocator::initHistograms()
+{
+    BSLMF_ASSERT(0 == sizeof(Shard) % CACHE_LINE);
+
+    d_offset = bsls::AlignmentUtil::roundUpToMaximalAlignment(
+                                                      sizeof(HistogramHeader));
+
+    d_shardMemory_p = d_allocator_p->allocate(NUM_SHARDS * sizeof(Shard)
+                                              + CACHE_LINE);
+
+    d_shards_p = reinterpret_cast<Shard *>(
+                (reinterpret_cast<bsls::Types::UintPtr>(d_shardMemory_p)
+                                        + CACHE_LINE - 1) & ~(CACHE_LINE - 1));
+
+    for (int i = 0; i < NUM_SHARDS; ++i) {
+        Shard& shard = d_shards_p[i];
+
+        AtomicOps::initInt64(&shard.d_nextTick, 0);
+
+        for (int c = 0; c < k_NUM_SIZE_CLASSES; ++c) {
+            AtomicOps::initInt64(&shard.d_numAllocations[c], 0);
+            AtomicOps::initInt64(&shard.d_numBytes[c], 0);
+
+            for (int b = 0; b < k_NUM_LIFETIME_BUCKETS; ++b) {
+                AtomicOps::initInt64(&shard.d_lifetimes[c][b], 0);
+            }
+        }
+    }
+}
+
+bsls::Types::Int64 CountingAllocator::nextTick(Shard *shard)
+{
+    BSLS_ASSERT_SAFE(shard);
+
+    bsls::Types::Int64 expected = AtomicOps::getInt64Relaxed(
+                                                          &shard->d_nextTick);
+
+    for (;;) {
+        bsls::Types::Int64 tick = expected;
+
+        if (0 == tick % TICK_BATCH) {
+            // The batch of the shard is exhausted; claim the next one.  If
+            // another thread of the shard installs a batch first, the batch
+            // claimed here is abandoned.
+
+            tick = d_numTicksClaimed.addRelaxed(TICK_BATCH) - TICK_BATCH;
+        }
+
+        const bsls::Types::Int64 previous = AtomicOps::testAndSwapInt64(
+                                                            &shard->d_nextTick,
+                                                            expected,
+                                                            tick + 1);
+
+        if (previous == expected) {
+            return tick;                                              // RETURN
+        }
+        expected = previous;
+    }
+}
+
+void CountingAllocator::recordAllocation(void *block, size_type size)
+{
+    HistogramHeader *header = static_cast<HistogramHeader *>(block);
+
+    Shard&    shard = d_shards_p[threadShard()];
+    const int c     = sizeClass(size);
+
+    header->d_tick = nextTick(&shard);
+
+    AtomicOps::addInt64Relaxed(&shard.d_numAllocations[c], 1);
+    AtomicOps::addInt64Relaxed(&shard.d_numBytes[c],
+                               static_cast<bsls::Types::Int64>(size));
+}
+
+void CountingAllocator::recordDeallocation(void *block, size_type size)
+{
+    const HistogramHeader *header = static_cast<HistogramHeader *>(block);
+
+    Shard& shard = d_shards_p[threadShard()];
+
+    // Measure the lifetime against the next tick of the shard of the calling
+    // thread, which is exact if the allocator is used by that shard alone,
+    // but no earlier than the number of ticks claimed by all shards, less the
+    // most that can be held unused in their batches, so that a stale shard
+    // does not understate the lifetime (see {Histograms}).
+
+    const bsls::Types::Int64 shardTick =
+                                 AtomicOps::getInt64Relaxed(&shard.d_nextTick);
+    const bsls::Types::Int64 claimedTick = d_numTicksClaimed.loadRelaxed()
+                                         - NUM_SHARDS * TICK_BATCH;
+
+    const bsls::Types::Int64 elapsed =
+                                   (shardTick > claimedTick ? shardTick
+                                                            : claimedTick)
+                                 - header->d_tick
+                                 - 1;
+    const bsls::Types::Int64 lifetime = elapsed > 0 ? elapsed : 0;
+
+    AtomicOps::addInt64Relaxed(
+              &shard.d_lifetimes[sizeClass(size)][lifetimeBucket(lifetime)],
+              1);
+}
+
+// CLASS METHODS
+int CountingAllocator::lifetimeBucket(bsls::Types::Int64 lifetime)
+{
+    BSLS_ASSERT_SAFE(0 <= lifetime);
+
+    if (0 == lifetime) {
+        return 0;                                                     // RETURN
+    }
+
+    const int bucket = floorLog2(lifetime) + 1;
+
+    return bucket < k_NUM_LIFETIME_BUCKETS ? bucket
+                                           : k_NUM_LIFETIME_BUCKETS - 1;
+}
+
+bsls::Types::Int64 CountingAllocator::lifetimeBucketLowerBound(int bucket)
+{
+    BSLS_ASSERT(0 <= bucket);
+    BSLS_ASSERT(     bucket < k_NUM_LIFETIME_BUCKETS);
+
+    return 0 == bucket ? 0 : bsls::Types::Int64(1) << (bucket - 1);
+}
+
+int CountingAllocator::sizeClass(size_type size)
+{
+    BSLS_ASSERT_SAFE(0 < size);
+
+    if (1 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    const int sizeClass = floorLog2(size - 1) + 1;
+
+    return sizeClass < k_NUM_SIZE_CLASSES ? sizeClass
+                                          : k_NUM_SIZE_CLASSES - 1;
+}
+
+bslma::Allocator::size_type CountingAllocator::sizeClassUpperBound(
+                                                                 int sizeClass)
+{
+    BSLS_ASSERT(0 <= sizeClass);
+    BSLS_ASSERT(     sizeClass < k_NUM_SIZE_CLASSES);
+
+    if (k_NUM_SIZE_CLASSES - 1 == sizeClass) {
+        return bsl::numeric_limits<size_type>::max();                 // RETURN
+    }
+
+    return size_type(1) << sizeClass;
+}
+
 // CREATORS
 CountingAllocator::CountingAllocator(Allocator *basicAllocator)
 : d_name_p(0)
 , d_numBytesInUse(0)
 , d_numBytesTotal(0)
+, d_numTicksClaimed(0)
+, d_offset(OFFSET)
+, d_shards_p(0)
+, d_shardMemory_p(0)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0 == name());
@@ -49,6 +286,10 @@ CountingAllocator::CountingAllocator(const char *name,
 : d_name_p(name)
 , d_numBytesInUse(0)
 , d_numBytesTotal(0)
+, d_numTicksClaimed(0)
+, d_offset(OFFSET)
+, d_shards_p(0)
+, d_shardMemory_p(0)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0 != this->name());
@@ -57,12 +298,37 @@ CountingAllocator::CountingAllocator(const char *name,
     BSLS_ASSERT(d_allocator_p);
 }
 
+CountingAllocator::CountingAllocator(const char       *name,
+                                     HistogramMode     histogramMode,
+                                     bslma::Allocator *basicAllocator)
+: d_name_p(name)
+, d_numBytesInUse(0)
+, d_numBytesTotal(0)
+, d_numTicksClaimed(0)
+, d_offset(OFFSET)
+, d_shards_p(0)
+, d_shardMemory_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 == numBytesInUse());
+    BSLS_ASSERT(0 == numBytesTotal());
+    BSLS_ASSERT(d_allocator_p);
+
+    if (e_COLLECT_HISTOGRAMS == histogramMode) {
+        initHistograms();
+    }
+}
+
 CountingAllocator::~CountingAllocator()
 {
     BSLS_ASSERT(0               <= numBytesInUse());
     BSLS_ASSERT(0               <= numBytesTotal());
     BSLS_ASSERT(numBytesInUse() <= numBytesTotal());
     BSLS_ASSERT(d_allocator_p);
+
+    if (d_shardMemory_p) {
+        d_allocator_p->deallocate(d_shardMemory_p);
+    }
 }
 
 // MANIPULATORS
@@ -77,7 +343,7 @@ void *CountingAllocator::allocate(size_type size)
     // 'size' in the allocated block.
 
     const size_type totalSize =
-                 bsls::AlignmentUtil::roundUpToMaximalAlignment(size) + OFFSET;
+               bsls::AlignmentUtil::roundUpToMaximalAlignment(size) + d_offset;
 
     void *address = d_allocator_p->allocate(totalSize);
 
@@ -86,7 +352,11 @@ void *CountingAllocator::allocate(size_type size)
 
     *static_cast<size_type *>(address) = size;
 
-    return static_cast<char *>(address) + OFFSET;
+    if (d_shards_p) {
+        recordAllocation(address, size);
+    }
+
+    return static_cast<char *>(address) + d_offset;
 }
 
 void CountingAllocator::deallocate(void *address)
@@ -96,15 +366,42 @@ void CountingAllocator::deallocate(void *address)
         return;                                                       // RETURN
     }
 
-    address = static_cast<char *>(address) - OFFSET;
+    address = static_cast<char *>(address) - d_offset;
 
     const size_type recordedSize = *static_cast<size_type *>(address);
 
     d_numBytesInUse.addRelaxed(-static_cast<bsls::Types::Int64>(recordedSize));
 
+    if (d_shards_p) {
+        recordDeallocation(address, recordedSize);
+    }
+
     d_allocator_p->deallocate(address);
 }
 
+void CountingAllocator::deallocateSized(void *address, size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    address = static_cast<char *>(address) - d_offset;
+
+    BSLS_ASSERT_SAFE(size == *static_cast<size_type *>(address));
+
+    d_numBytesInUse.addRelaxed(-static_cast<bsls::Types::Int64>(size));
+
+    if (d_shards_p) {
+        recordDeallocation(address, size);
+    }
+
+    const size_type totalSize =
+               bsls::AlignmentUtil::roundUpToMaximalAlignment(size) + d_offset;
+
+    d_allocator_p->deallocateSized(address, totalSize);
+}
+
 // ACCESSORS
 bsl::ostream& CountingAllocator::print(bsl::ostream& stream) const
 {
@@ -119,9 +416,96 @@ bsl::ostream& CountingAllocator::print(bsl::ostream& stream) const
     stream << "Bytes in use:   " << numBytesInUse() << "\n"
            << "Bytes in total: " << numBytesTotal() << "\n";
 
+    HistogramSnapshot histograms;
+    if (0 != snapshot(&histograms)) {
+        return stream;                                                // RETURN
+    }
+
+    stream << "Allocations:    " << histograms.d_numTicks << "\n";
+
+    // Write one line per non-empty size class, followed by the non-empty
+    // lifetime buckets of that class, each labeled by its lower bound.
+
+    for (int c = 0; c < k_NUM_SIZE_CLASSES; ++c) {
+        if (0 == histograms.d_numAllocations[c]) {
+            continue;
+        }
+
+        bsls::Types::Int64 numDeallocations = 0;
+        for (int b = 0; b < k_NUM_LIFETIME_BUCKETS; ++b) {
+            numDeallocations += histograms.d_lifetimes[c][b];
+        }
+
+        if (k_NUM_SIZE_CLASSES - 1 == c) {
+            stream << "  larger:";
+        }
+        else {
+            stream << "  <= " << sizeClassUpperBound(c) << ":";
+        }
+        stream << " allocations " << histograms.d_numAllocations[c]
+               << ", bytes "      << histograms.d_numBytes[c]
+               << ", in use "
+               << histograms.d_numAllocations[c] - numDeallocations
+               << "\n";
+
+        if (0 == numDeallocations) {
+            continue;
+        }
+
+        stream << "    lifetimes:";
+        for (int b = 0; b < k_NUM_LIFETIME_BUCKETS; ++b) {
+            if (histograms.d_lifetimes[c][b]) {
+                stream << " " << lifetimeBucketLowerBound(b) << "+:"
+                       << histograms.d_lifetimes[c][b];
+            }
+        }
+        stream << "\n";
+    }
+
     return stream;
 }
 
+int CountingAllocator::snapshot(HistogramSnapshot *result) const
+{
+    BSLS_ASSERT(result);
+
+    if (!d_shards_p) {
+        return -1;                                                    // RETURN
+    }
+
+    result->d_numTicks = 0;
+
+    for (int c = 0; c < k_NUM_SIZE_CLASSES; ++c) {
+        result->d_numAllocations[c] = 0;
+        result->d_numBytes[c]       = 0;
+
+        for (int b = 0; b < k_NUM_LIFETIME_BUCKETS; ++b) {
+            result->d_lifetimes[c][b] = 0;
+        }
+    }
+
+    for (int i = 0; i < NUM_SHARDS; ++i) {
+        const Shard& shard = d_shards_p[i];
+
+        for (int c = 0; c < k_NUM_SIZE_CLASSES; ++c) {
+            const bsls::Types::Int64 numAllocations =
+                   AtomicOps::getInt64Relaxed(&shard.d_numAllocations[c]);
+
+            result->d_numTicks          += numAllocations;
+            result->d_numAllocations[c] += numAllocations;
+            result->d_numBytes[c] +=
+                         AtomicOps::getInt64Relaxed(&shard.d_numBytes[c]);
+
+            for (int b = 0; b < k_NUM_LIFETIME_BUCKETS; ++b) {
+                result->d_lifetimes[c][b] +=
+                        AtomicOps::getInt64Relaxed(&shard.d_lifetimes[c][b]);
+            }
+        }
+    }
+
+    return 0;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -7,7 +7,7 @@
 //@CLASSES:
 //  bdlma::CountingAllocator: concrete allocator that counts allocated bytes
 //
-//@SEE_ALSO: bslma_allocator, bslma_testallocator
+//@SEE_ALSO: bslma_allocator, bslma_testallocator, bdlma_threadindexutil
 //
 //@DESCRIPTION: This component provides a special-purpose counting allocator,
 // 'bdlma::CountingAllocator', that implements the 'bslma::Allocator' protocol
@@ -15,17 +15,25 @@
 // use ('numBytesInUse'), and (2) the cumulative number of bytes that have ever
 // been allocated ('numBytesTotal').  The accumulated statistics are based
 // solely on the number of bytes requested in calls to the 'allocate' method.
-// A 'print' method is provided to output the current state of the allocator's
-// byte counts to a specified 'bsl::ostream':
+// Optionally, a counting allocator also collects histograms of request sizes
+// and of block lifetimes (see {Histograms}).  A 'print' method is provided to
+// output the current state of the allocator's byte counts (and histograms) to
+// a specified 'bsl::ostream':
 //..
 //   ,------------------------.
 //  ( bdlma::CountingAllocator )
 //   `------------------------'
 //                |           ctor/dtor
+//                |           collectsHistograms
+//                |           lifetimeBucket
+//                |           lifetimeBucketLowerBound
 //                |           numBytesInUse
 //                |           numBytesTotal
 //                |           name
 //                |           print
+//                |           sizeClass
+//                |           sizeClassUpperBound
+//                |           snapshot
 //                V
 //       ,----------------.
 //      ( bslma::Allocator )
@@ -59,11 +67,55 @@
 // currently in use is returned by 'numBytesInUse' and the total number of
 // bytes ever allocated is returned by 'numBytesTotal'.
 //
+///Histograms
+///----------
+// If 'e_COLLECT_HISTOGRAMS' is supplied at construction, a counting allocator
+// also maintains, for each *size class* of requests, the number of blocks
+// allocated and the number of bytes requested, and a histogram of the
+// *lifetimes* of the blocks of that class that have been deallocated.  Size
+// class 'k' holds requests of more than '2^(k-1)' and at most '2^k' bytes
+// (size class 0 holds requests of 1 byte, and the last size class holds all
+// larger requests).  The lifetime of a block is measured in allocation-count
+// *ticks*: the number of blocks allocated from the allocator after the block
+// and before its deallocation.  Lifetime bucket 0 counts blocks deallocated
+// before any other allocation, and bucket 'b' counts lifetimes of at least
+// '2^(b-1)' and less than '2^b' ticks (the last bucket counts all longer
+// lifetimes).  Such histograms reveal which size classes warrant a pool and
+// how long blocks of each class live, e.g., to choose between a pool and a
+// sequential (arena) allocator.
+//
+// The histograms are kept in several *shards* of counters, each on its own
+// cache lines, and each thread updates the shard selected by its index (see
+// 'bdlma_threadindexutil'), so that threads using the allocator concurrently
+// do not contend on the same counters.  The 'snapshot' method sums the shards
+// into a 'HistogramSnapshot' that may be examined or dumped, and 'print'
+// includes the non-empty size classes in its output.  Note that collecting
+// histograms adds a second maximally-aligned word of overhead to each block,
+// in which its allocation tick is recorded.
+//
+// So that threads do not contend on a single tick counter either, each shard
+// claims ticks from the allocator in batches of 64 and hands them out to its
+// threads.  The lifetime of a block deallocated by a thread is measured
+// against the next tick of that thread's shard or, if that shard has fallen
+// behind (e.g., because it has been idle while other threads allocated), the
+// number of ticks claimed by all shards less the 512 ticks that their 8
+// batches can hold unused, whichever is later.  When a single thread uses the
+// allocator, lifetimes are therefore exact.  When several threads do,
+// including when blocks allocated by one thread are deallocated by another,
+// a measured lifetime differs from the exact number of intervening
+// allocations by less than 512 ticks (negative differences being recorded as
+// a lifetime of 0), plus 64 ticks for each batch abandoned by a thread that
+// loses a race to claim a batch for its shard; since lifetimes are bucketed
+// by powers of two, only lifetimes shorter than a few thousand ticks are
+// appreciably affected.
+//
 ///Thread Safety
 ///-------------
 // The 'bdlma::CountingAllocator' class is fully thread-safe (see
 // 'bsldoc_glossary') provided that the underlying allocator (established at
-// construction) is fully thread-safe.
+// construction) is fully thread-safe.  A 'snapshot' taken while other threads
+// allocate or deallocate reflects each counter at some point during the call,
+// but not necessarily all counters at the same point.
 //
 ///Usage
 ///-----
@@ -263,6 +315,65 @@
 //  Bytes in use:   16
 //  Bytes in total: 28
 //..
+//
+///Example 2: Profiling Request Sizes and Lifetimes
+///------------------------------------------------
+// In this example, we use the histograms of a counting allocator to decide
+// whether the blocks allocated by a workload would be better served by a
+// pool.
+//
+// First, we create a counting allocator that collects histograms:
+//..
+//  typedef bdlma::CountingAllocator CA;
+//
+//  CA profiler("profiler", CA::e_COLLECT_HISTOGRAMS);
+//..
+// Then, we run our (simulated) workload, which allocates a temporary 24-byte
+// block and a long-lived 100-byte block in each iteration:
+//..
+//  void *kept[10];
+//  for (int i = 0; i < 10; ++i) {
+//      void *temporary = profiler.allocate(24);
+//      kept[i]         = profiler.allocate(100);
+//      profiler.deallocate(temporary);
+//  }
+//..
+// Next, we take a snapshot of the histograms, and find the size classes of
+// the two kinds of blocks:
+//..
+//  CA::HistogramSnapshot histograms;
+//  int rc = profiler.snapshot(&histograms);
+//  assert(0 == rc);
+//  assert(20 == histograms.d_numTicks);
+//
+//  const int SMALL = CA::sizeClass(24);
+//  const int LARGE = CA::sizeClass(100);
+//  assert(32  == CA::sizeClassUpperBound(SMALL));
+//  assert(128 == CA::sizeClassUpperBound(LARGE));
+//
+//  assert(10   == histograms.d_numAllocations[SMALL]);
+//  assert(240  == histograms.d_numBytes[SMALL]);
+//  assert(10   == histograms.d_numAllocations[LARGE]);
+//  assert(1000 == histograms.d_numBytes[LARGE]);
+//..
+// Now, we observe that every small block was deallocated after exactly one
+// other allocation, i.e., all small blocks are very short-lived, and that no
+// large block has been deallocated:
+//..
+//  const int ONE_TICK = CA::lifetimeBucket(1);
+//  assert(1  == CA::lifetimeBucketLowerBound(ONE_TICK));
+//  assert(10 == histograms.d_lifetimes[SMALL][ONE_TICK]);
+//
+//  for (int b = 0; b < CA::k_NUM_LIFETIME_BUCKETS; ++b) {
+//      assert(0 == histograms.d_lifetimes[LARGE][b]);
+//  }
+//..
+// Finally, we release the long-lived blocks:
+//..
+//  for (int i = 0; i < 10; ++i) {
+//      profiler.deallocate(kept[i]);
+//  }
+//..
 
 #ifndef INCLUDED_BDLSCM_VERSION
 #include <bdlscm_version.h>
@@ -305,19 +416,90 @@ class CountingAllocator : public bslma::Allocator {
     // other allocator implementing the 'bslma::Allocator' protocol provided
     // that it is fully thread-safe.
 
+  public:
+    // TYPES
+    enum HistogramMode {
+        // Enumerate the configuration options for 'CountingAllocator' that may
+        // be supplied at construction.
+
+        e_NO_HISTOGRAMS,      // count bytes only
+        e_COLLECT_HISTOGRAMS  // also collect size and lifetime histograms
+    };
+
+    enum {
+        k_NUM_SIZE_CLASSES     = 32,  // number of size classes
+        k_NUM_LIFETIME_BUCKETS = 32   // number of lifetime buckets per size
+                                      // class
+    };
+
+    struct HistogramSnapshot {
+        // This 'struct' holds the sums of the histogram counters of a counting
+        // allocator at the time of a call to 'snapshot'.
+
+        bsls::Types::Int64 d_numTicks;
+            // number of blocks ever allocated
+
+        bsls::Types::Int64 d_numAllocations[k_NUM_SIZE_CLASSES];
+            // number of blocks ever allocated in each size class
+
+        bsls::Types::Int64 d_numBytes[k_NUM_SIZE_CLASSES];
+            // number of bytes ever requested in each size class
+
+        bsls::Types::Int64 d_lifetimes[k_NUM_SIZE_CLASSES]
+                                      [k_NUM_LIFETIME_BUCKETS];
+            // number of blocks of each size class deallocated with a lifetime
+            // in each lifetime bucket
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Shard;  // histogram counters updated by a subset of threads
+                   // (defined in the implementation)
+
     // DATA
-    const char        *d_name_p;         // optionally specified name of this
-                                         // allocator object (or 0)
+    const char        *d_name_p;          // optionally specified name of this
+                                          // allocator object (or 0)
+
+    bsls::AtomicInt64  d_numBytesInUse;   // number of bytes currently
+                                          // allocated from this object
+
+    bsls::AtomicInt64  d_numBytesTotal;   // cumulative number of bytes ever
+                                          // allocated from this object
 
-    bsls::AtomicInt64  d_numBytesInUse;  // number of bytes currently allocated
-                                         // from this object
+    bsls::AtomicInt64  d_numTicksClaimed; // number of ticks claimed in
+                                          // batches by the shards (if
+                                          // histograms are collected)
 
-    bsls::AtomicInt64  d_numBytesTotal;  // cumulative number of bytes ever
-                                         // allocated from this object
+    size_type          d_offset;          // offset (in bytes) of the address
+                                          // returned to the user from the
+                                          // start of the allocated block
 
-    bslma::Allocator  *d_allocator_p;    // memory allocator (held, not owned)
+    Shard             *d_shards_p;        // histogram counters, or 0 if
+                                          // histograms are not collected
+
+    void              *d_shardMemory_p;   // block holding 'd_shards_p'
+
+    bslma::Allocator  *d_allocator_p;     // memory allocator (held, not owned)
 
   private:
+    // PRIVATE MANIPULATORS
+    void initHistograms();
+        // Allocate and zero the histogram counters and set the block offset
+        // for collecting histograms.
+
+    bsls::Types::Int64 nextTick(Shard *shard);
+        // Return the next tick of the batch held by the specified 'shard',
+        // first claiming a new batch for 'shard' if its batch is exhausted.
+
+    void recordAllocation(void *block, size_type size);
+        // Record in the histograms the allocation of a block of the specified
+        // 'size' (in bytes) whose header is at the specified 'block'.
+
+    void recordDeallocation(void *block, size_type size);
+        // Record in the histograms the deallocation of the block of the
+        // specified 'size' (in bytes) whose header is at the specified
+        // 'block'.
+
     // NOT IMPLEMENTED
     CountingAllocator(const CountingAllocator&);
     CountingAllocator& operator=(const CountingAllocator&);
@@ -338,6 +520,16 @@ class CountingAllocator : public bslma::Allocator {
         // supply memory.  If 'basicAllocator' is 0, the currently installed
         // default allocator is used.
 
+    CountingAllocator(const char       *name,
+                      HistogramMode     histogramMode,
+                      bslma::Allocator *basicAllocator = 0);
+        // Create a counting allocator having the specified 'name' (which may
+        // be 0), that collects size and lifetime histograms if the specified
+        // 'histogramMode' is 'e_COLLECT_HISTOGRAMS' (see {Histograms}).
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
     virtual ~CountingAllocator();
         // Destroy this allocator object.  Note that destroying this allocator
         // has no effect on any outstanding allocated memory.
@@ -359,7 +551,42 @@ class CountingAllocator : public bslma::Allocator {
         // behavior is undefined unless 'address' was allocated using this
         // allocator object and has not already been deallocated.
 
+    virtual void deallocateSized(void *address, size_type size);
+        // Return the memory block at the specified 'address', which was
+        // obtained by a call to 'allocate' with the specified 'size', back to
+        // this allocator.  If 'address' is 0, this function has no effect
+        // (e.g., on allocation statistics).  Otherwise, decrease the number of
+        // currently allocated bytes by 'size' without reading the size
+        // recorded in the block.  The behavior is undefined unless 'address'
+        // was allocated using this allocator object by a call to
+        // 'allocate(size)' and has not already been deallocated.
+
+    // CLASS METHODS
+    static int lifetimeBucket(bsls::Types::Int64 lifetime);
+        // Return the index of the lifetime bucket holding the specified
+        // 'lifetime' (in ticks).  The behavior is undefined unless
+        // '0 <= lifetime'.
+
+    static bsls::Types::Int64 lifetimeBucketLowerBound(int bucket);
+        // Return the shortest lifetime (in ticks) held by the specified
+        // lifetime 'bucket'.  The behavior is undefined unless
+        // '0 <= bucket < k_NUM_LIFETIME_BUCKETS'.
+
+    static int sizeClass(size_type size);
+        // Return the index of the size class holding requests of the specified
+        // 'size' (in bytes).  The behavior is undefined unless '0 < size'.
+
+    static size_type sizeClassUpperBound(int sizeClass);
+        // Return the largest request size (in bytes) held by the specified
+        // 'sizeClass', or the largest value of 'size_type' for the last size
+        // class.  The behavior is undefined unless
+        // '0 <= sizeClass < k_NUM_SIZE_CLASSES'.
+
     // ACCESSORS
+    bool collectsHistograms() const;
+        // Return 'true' if this allocator collects size and lifetime
+        // histograms, and 'false' otherwise.
+
     const char *name() const;
         // Return the name of this counting allocator, or 0 if no name was
         // specified at construction.
@@ -375,7 +602,15 @@ class CountingAllocator : public bslma::Allocator {
     bsl::ostream& print(bsl::ostream& stream) const;
         // Write the accumulated state information held in this allocator to
         // the specified 'stream' in some reasonable (multi-line) format, and
-        // return a reference to 'stream'.
+        // return a reference to 'stream'.  If this allocator collects
+        // histograms, the output includes the non-empty size classes and
+        // their lifetime histograms.
+
+    int snapshot(HistogramSnapshot *result) const;
+        // Load into the specified 'result' the sums of the histogram counters
+        // of this allocator.  Return 0 on success, and a non-zero value (with
+        // no effect on 'result') if this allocator does not collect
+        // histograms.
 };
 
 // ============================================================================
@@ -387,6 +622,12 @@ class CountingAllocator : public bslma::Allocator {
                            // -----------------------
 
 // ACCESSORS
+inline
+bool CountingAllocator::collectsHistograms() const
+{
+    return 0 != d_shards_p;
+}
+
 inline
 const char *CountingAllocator::name() const
 {
@@ -45,24 +45,35 @@ using namespace bsl;
 // CREATORS
 // [ 2] CountingAllocator(Allocator *ba = 0);
 // [ 4] CountingAllocator(const char *name, Allocator *ba = 0);
+// [ 7] CountingAllocator(const char *name, HistogramMode mode, *ba = 0);
 // [ 2] ~CountingAllocator();
 //
+// CLASS METHODS
+// [ 7] static int lifetimeBucket(Int64 lifetime);
+// [ 7] static Int64 lifetimeBucketLowerBound(int bucket);
+// [ 7] static int sizeClass(size_type size);
+// [ 7] static size_type sizeClassUpperBound(int sizeClass);
+//
 // MANIPULATORS
 // [ 3] void *allocate(size_type size);
 // [ 3] void deallocate(void *address);
+// [ 3] void deallocateSized(void *address, size_type size);
 //
 // ACCESSORS
+// [ 7] bool collectsHistograms() const;
 // [ 4] const char *name() const;
 // [ 3] Int64 numBytesInUse() const;
 // [ 3] Int64 numBytesTotal() const;
 // [ 5] bsl::ostream& print(bsl::ostream& stream) const;
+// [ 7] int snapshot(HistogramSnapshot *result) const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 7] USAGE EXAMPLE
+// [ 8] USAGE EXAMPLE
 // [ *] CONCERN: In no case does memory come from the global allocator.
 // [ *] CONCERN: There is no temporary allocation from any allocator.
 // [ 4] CONCERN: Precondition violations are detected when enabled.
 // [ 6] CONCERN: The 'allocate' and 'deallocate' methods are thread-safe.
+// [ 7] CONCERN: Histogram counters are not lost under concurrent use.
 
 // ============================================================================
 //                    STANDARD BDE ASSERT TEST MACRO
@@ -262,6 +273,29 @@ extern "C" void *threadFunction3(void *arg)
 
 }  // close namespace TestCase6
 
+namespace TestCase7 {
+
+struct FreeInfo {
+    void **d_blocks_p;
+    int    d_numBlocks;
+    Obj   *d_obj_p;
+};
+
+extern "C" void *freeFunction(void *arg)
+    // Deallocate, in order, the blocks described by the specified 'arg',
+    // which must be the address of a 'FreeInfo'.
+{
+    FreeInfo *info = (FreeInfo *)arg;
+
+    for (int i = 0; i < info->d_numBlocks; ++i) {
+        info->d_obj_p->deallocate(info->d_blocks_p[i]);
+    }
+
+    return arg;
+}
+
+}  // close namespace TestCase7
+
 // ============================================================================
 //                                USAGE EXAMPLE
 // ----------------------------------------------------------------------------
@@ -451,7 +485,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 7: {
+      case 8: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -527,6 +561,468 @@ if (veryVerbose)
 //  Bytes in total: 28
 //..
 
+///Example 2: Profiling Request Sizes and Lifetimes
+///------------------------------------------------
+// In this example, we use the histograms of a counting allocator to decide
+// whether the blocks allocated by a workload would be better served by a
+// pool.
+//
+// First, we create a counting allocator that collects histograms:
+//..
+    typedef bdlma::CountingAllocator CA;
+
+    CA profiler("profiler", CA::e_COLLECT_HISTOGRAMS);
+//..
+// Then, we run our (simulated) workload, which allocates a temporary 24-byte
+// block and a long-lived 100-byte block in each iteration:
+//..
+    void *kept[10];
+    for (int i = 0; i < 10; ++i) {
+        void *temporary = profiler.allocate(24);
+        kept[i]         = profiler.allocate(100);
+        profiler.deallocate(temporary);
+    }
+//..
+// Next, we take a snapshot of the histograms, and find the size classes of
+// the two kinds of blocks:
+//..
+    CA::HistogramSnapshot histograms;
+    int rc = profiler.snapshot(&histograms);
+    ASSERT(0 == rc);
+    ASSERT(20 == histograms.d_numTicks);
+
+    const int SMALL = CA::sizeClass(24);
+    const int LARGE = CA::sizeClass(100);
+    ASSERT(32  == CA::sizeClassUpperBound(SMALL));
+    ASSERT(128 == CA::sizeClassUpperBound(LARGE));
+
+    ASSERT(10   == histograms.d_numAllocations[SMALL]);
+    ASSERT(240  == histograms.d_numBytes[SMALL]);
+    ASSERT(10   == histograms.d_numAllocations[LARGE]);
+    ASSERT(1000 == histograms.d_numBytes[LARGE]);
+//..
+// Now, we observe that every small block was deallocated after exactly one
+// other allocation, i.e., all small blocks are very short-lived, and that no
+// large block has been deallocated:
+//..
+    const int ONE_TICK = CA::lifetimeBucket(1);
+    ASSERT(1  == CA::lifetimeBucketLowerBound(ONE_TICK));
+    ASSERT(10 == histograms.d_lifetimes[SMALL][ONE_TICK]);
+
+    for (int b = 0; b < CA::k_NUM_LIFETIME_BUCKETS; ++b) {
+        ASSERT(0 == histograms.d_lifetimes[LARGE][b]);
+    }
+//..
+// Finally, we release the long-lived blocks:
+//..
+    for (int i = 0; i < 10; ++i) {
+        profiler.deallocate(kept[i]);
+    }
+//..
+
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // HISTOGRAMS
+        //   Ensure that size and lifetime histograms are collected when
+        //   requested, and only then.
+        //
+        // Concerns:
+        //: 1 'sizeClass' maps each size to the least power of two not less
+        //:   than it, 'lifetimeBucket' maps each lifetime to one more than its
+        //:   binary logarithm, and both saturate at the last class or bucket.
+        //:
+        //: 2 'sizeClassUpperBound' and 'lifetimeBucketLowerBound' return the
+        //:   bounds of each class or bucket.
+        //:
+        //: 3 An allocator collects histograms only if 'e_COLLECT_HISTOGRAMS'
+        //:   is supplied at construction; otherwise 'snapshot' fails with no
+        //:   effect.
+        //:
+        //: 4 Each allocation is counted in its size class, and each
+        //:   deallocation (by 'deallocate' or 'deallocateSized') is counted
+        //:   in the lifetime bucket of its size class, with the lifetime
+        //:   measured in allocations since the block was allocated.
+        //:
+        //: 5 Blocks are maximally aligned, the byte counts are unaffected, and
+        //:   the histogram counters are allocated from the object allocator
+        //:   and released at destruction.
+        //:
+        //: 6 Counters are not lost when threads allocate and deallocate
+        //:   concurrently.
+        //:
+        //: 7 'print' includes the non-empty size classes, and allocates no
+        //:   memory.
+        //:
+        //: 8 A block deallocated by a thread other than the one that
+        //:   allocated it has its lifetime measured to within the documented
+        //:   bound, even if the shard of the deallocating thread is idle.
+        //
+        // Plan:
+        //: 1 Use the table-driven technique to verify the class methods for
+        //:   representative values, including boundaries.  (C-1..2)
+        //:
+        //: 2 Create objects with each constructor and verify
+        //:   'collectsHistograms' and 'snapshot'.  (C-3)
+        //:
+        //: 3 Allocate and deallocate blocks in a known order and verify the
+        //:   snapshot, the alignment, and the object allocator.  (C-4..5)
+        //:
+        //: 4 Run the threads of case 6 against an object collecting
+        //:   histograms, and verify that the snapshot accounts for every
+        //:   allocation and deallocation.  (C-6)
+        //:
+        //: 5 Print an object to a string stream and search the output.  (C-7)
+        //:
+        //: 6 Allocate many blocks in the main thread, deallocate them from a
+        //:   new thread that never allocates, and verify the lifetime bucket
+        //:   of the first and the last block.  (C-8)
+        //
+        // Testing:
+        //   CountingAllocator(const char *name, HistogramMode mode, *ba = 0);
+        //   static int lifetimeBucket(Int64 lifetime);
+        //   static Int64 lifetimeBucketLowerBound(int bucket);
+        //   static int sizeClass(size_type size);
+        //   static size_type sizeClassUpperBound(int sizeClass);
+        //   bool collectsHistograms() const;
+        //   int snapshot(HistogramSnapshot *result) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "HISTOGRAMS" << endl
+                          << "==========" << endl;
+
+        typedef bsls::Types::Int64     Int64;
+        typedef bsls::Types::size_type size_type;
+
+        if (verbose) cout << "\tClass methods." << endl;
+        {
+            static const struct {
+                int        d_line;
+                size_type  d_size;
+                int        d_class;
+            } SIZES[] = {
+                //LINE  SIZE        CLASS
+                //----  ----------  -----
+                { L_,            1,     0 },
+                { L_,            2,     1 },
+                { L_,            3,     2 },
+                { L_,            4,     2 },
+                { L_,            5,     3 },
+                { L_,            8,     3 },
+                { L_,            9,     4 },
+                { L_,           24,     5 },
+                { L_,          100,     7 },
+                { L_,         4096,    12 },
+                { L_,         4097,    13 },
+                { L_,   1u << 30,      30 },
+                { L_,  (1u << 30) + 1, 31 },
+                { L_,  ~size_type(0),  31 },
+            };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                const int       LINE  = SIZES[ti].d_line;
+                const size_type SIZE  = SIZES[ti].d_size;
+                const int       CLASS = SIZES[ti].d_class;
+
+                ASSERTV(LINE, CLASS == Obj::sizeClass(SIZE));
+            }
+
+            for (int c = 0; c < Obj::k_NUM_SIZE_CLASSES - 1; ++c) {
+                const size_type BOUND = Obj::sizeClassUpperBound(c);
+
+                ASSERTV(c, c     == Obj::sizeClass(BOUND));
+                ASSERTV(c, c + 1 == Obj::sizeClass(BOUND + 1));
+            }
+            ASSERT(~size_type(0) ==
+                   Obj::sizeClassUpperBound(Obj::k_NUM_SIZE_CLASSES - 1));
+
+            static const struct {
+                int    d_line;
+                Int64  d_lifetime;
+                int    d_bucket;
+            } LIFETIMES[] = {
+                //LINE  LIFETIME            BUCKET
+                //----  ------------------  ------
+                { L_,                    0,      0 },
+                { L_,                    1,      1 },
+                { L_,                    2,      2 },
+                { L_,                    3,      2 },
+                { L_,                    4,      3 },
+                { L_,                 1000,     10 },
+                { L_,   (Int64(1) << 30) - 1,   30 },
+                { L_,    Int64(1) << 30,        31 },
+                { L_,    Int64(1) << 62,        31 },
+            };
+            const int NUM_LIFETIMES = sizeof LIFETIMES / sizeof *LIFETIMES;
+
+            for (int ti = 0; ti < NUM_LIFETIMES; ++ti) {
+                const int   LINE     = LIFETIMES[ti].d_line;
+                const Int64 LIFETIME = LIFETIMES[ti].d_lifetime;
+                const int   BUCKET   = LIFETIMES[ti].d_bucket;
+
+                ASSERTV(LINE, BUCKET == Obj::lifetimeBucket(LIFETIME));
+            }
+
+            for (int b = 0; b < Obj::k_NUM_LIFETIME_BUCKETS; ++b) {
+                const Int64 BOUND = Obj::lifetimeBucketLowerBound(b);
+
+                ASSERTV(b, b == Obj::lifetimeBucket(BOUND));
+                if (0 < b) {
+                    ASSERTV(b, b - 1 == Obj::lifetimeBucket(BOUND - 1));
+                }
+            }
+        }
+
+        bslma::TestAllocator da("default",  veryVeryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\tHistograms are optional." << endl;
+        {
+            Obj::HistogramSnapshot histograms;
+            histograms.d_numTicks = 12345;
+
+            Obj mX(&sa);  const Obj& X = mX;
+            ASSERT(!X.collectsHistograms());
+            ASSERT(0 != X.snapshot(&histograms));
+
+            Obj mY("Y", &sa);  const Obj& Y = mY;
+            ASSERT(!Y.collectsHistograms());
+            ASSERT(0 != Y.snapshot(&histograms));
+
+            Obj mZ("Z", Obj::e_NO_HISTOGRAMS, &sa);  const Obj& Z = mZ;
+            ASSERT(!Z.collectsHistograms());
+            ASSERT(0 != Z.snapshot(&histograms));
+            ASSERT(0 == strcmp("Z", Z.name()));
+
+            ASSERT(12345 == histograms.d_numTicks);
+            ASSERT(0     == sa.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\tCounting allocations." << endl;
+        {
+            Obj mX(0, Obj::e_COLLECT_HISTOGRAMS, &sa);  const Obj& X = mX;
+
+            ASSERT(X.collectsHistograms());
+            ASSERT(0 == X.name());
+            ASSERT(1 == sa.numBlocksInUse());
+
+            Obj::HistogramSnapshot histograms;
+            ASSERT(0 == X.snapshot(&histograms));
+            ASSERT(0 == histograms.d_numTicks);
+            for (int c = 0; c < Obj::k_NUM_SIZE_CLASSES; ++c) {
+                ASSERTV(c, 0 == histograms.d_numAllocations[c]);
+                ASSERTV(c, 0 == histograms.d_numBytes[c]);
+                for (int b = 0; b < Obj::k_NUM_LIFETIME_BUCKETS; ++b) {
+                    ASSERTV(c, b, 0 == histograms.d_lifetimes[c][b]);
+                }
+            }
+
+            // Allocate blocks 'p[0..7]' of 5 bytes and 'q' of 100 bytes, then
+            // deallocate 'p[i]' after '8 - i' ticks.
+
+            void *p[8];
+            for (int i = 0; i < 8; ++i) {
+                p[i] = mX.allocate(5);
+                ASSERTV(i, 0 == reinterpret_cast<bsls::Types::UintPtr>(p[i])
+                                % bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT);
+            }
+            void *q = mX.allocate(100);
+
+            ASSERT(140 == X.numBytesInUse());
+            ASSERT(140 == X.numBytesTotal());
+
+            for (int i = 0; i < 8; ++i) {
+                if (i % 2) {
+                    mX.deallocate(p[i]);
+                }
+                else {
+                    mX.deallocateSized(p[i], 5);
+                }
+            }
+
+            ASSERT(0 == X.snapshot(&histograms));
+            ASSERT(9 == histograms.d_numTicks);
+
+            const int SMALL = Obj::sizeClass(5);
+            const int LARGE = Obj::sizeClass(100);
+
+            ASSERT(8   == histograms.d_numAllocations[SMALL]);
+            ASSERT(40  == histograms.d_numBytes[SMALL]);
+            ASSERT(1   == histograms.d_numAllocations[LARGE]);
+            ASSERT(100 == histograms.d_numBytes[LARGE]);
+
+            // Lifetimes 9 - (i + 1) for i in [0, 8): 8, 7, 6, 5, 4, 3, 2, 1.
+
+            ASSERT(1 == histograms.d_lifetimes[SMALL][1]);  // 1
+            ASSERT(2 == histograms.d_lifetimes[SMALL][2]);  // 2, 3
+            ASSERT(4 == histograms.d_lifetimes[SMALL][3]);  // 4..7
+            ASSERT(1 == histograms.d_lifetimes[SMALL][4]);  // 8
+
+            Int64 numLarge = 0;
+            for (int b = 0; b < Obj::k_NUM_LIFETIME_BUCKETS; ++b) {
+                numLarge += histograms.d_lifetimes[LARGE][b];
+            }
+            ASSERT(0 == numLarge);
+
+            mX.deallocate(q);
+
+            ASSERT(0 == X.snapshot(&histograms));
+            ASSERT(1 == histograms.d_lifetimes[LARGE][0]);
+            ASSERT(0 == X.numBytesInUse());
+
+            if (verbose) cout << "\tPrinting histograms." << endl;
+
+            ASSERT(0 == da.numBlocksTotal());
+
+            bslma::TestAllocatorMonitor dam(&da);
+
+            ostringstream os(&sa);
+            X.print(os);
+
+            ASSERT(dam.isTotalSame());
+
+            const string OUTPUT(os.str(), &sa);
+
+            if (veryVerbose) cout << OUTPUT << endl;
+
+            ASSERT(string::npos != OUTPUT.find("Allocations:    9"));
+            ASSERT(string::npos != OUTPUT.find(
+                                "<= 8: allocations 8, bytes 40, in use 0"));
+            ASSERT(string::npos != OUTPUT.find(
+                               "<= 128: allocations 1, bytes 100, in use 0"));
+            ASSERT(string::npos != OUTPUT.find(
+                                          "lifetimes: 1+:1 2+:2 4+:4 8+:1"));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\tLifetimes spanning tick batches." << endl;
+        {
+            Obj mX(0, Obj::e_COLLECT_HISTOGRAMS, &sa);  const Obj& X = mX;
+
+            // Ticks are claimed in batches of 64; a single thread must still
+            // observe exact lifetimes across batch boundaries.
+
+            enum { NUM_BLOCKS = 200 };
+
+            void *p[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                p[i] = mX.allocate(8);
+            }
+            mX.deallocate(p[0]);                          // lifetime 199
+            mX.deallocate(p[NUM_BLOCKS - 1]);             // lifetime 0
+            mX.deallocate(p[NUM_BLOCKS - 65]);            // lifetime 64
+
+            Obj::HistogramSnapshot histograms;
+            ASSERT(0 == X.snapshot(&histograms));
+            ASSERT(NUM_BLOCKS == histograms.d_numTicks);
+
+            const int C = Obj::sizeClass(8);
+
+            ASSERT(1 == histograms.d_lifetimes[C][0]);
+            ASSERT(1 == histograms.d_lifetimes[C][7]);    // 64..127
+            ASSERT(1 == histograms.d_lifetimes[C][8]);    // 128..255
+
+            for (int i = 1; i < NUM_BLOCKS - 1; ++i) {
+                if (NUM_BLOCKS - 65 != i) {
+                    mX.deallocate(p[i]);
+                }
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\tDeallocation by another thread." << endl;
+        {
+            using namespace TestCase7;
+
+            Obj mX(0, Obj::e_COLLECT_HISTOGRAMS, &sa);  const Obj& X = mX;
+
+            // The deallocating thread never allocates, so the next tick of
+            // its shard (if not shared with this thread) stays at 0; the
+            // lifetimes must nevertheless reflect the intervening
+            // allocations of this thread.
+
+            enum { NUM_BLOCKS = 10000 };
+
+            void **p = static_cast<void **>(
+                                   sa.allocate(NUM_BLOCKS * sizeof(void *)));
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                p[i] = mX.allocate(8);
+            }
+
+            FreeInfo info = { p, NUM_BLOCKS, &mX };
+
+            joinThread(createThread(&freeFunction, &info));
+
+            sa.deallocate(p);
+
+            Obj::HistogramSnapshot histograms;
+            ASSERT(0 == X.snapshot(&histograms));
+            ASSERT(NUM_BLOCKS == histograms.d_numTicks);
+
+            const int C = Obj::sizeClass(8);
+
+            // The first block lives 9999 ticks, which is far enough from a
+            // bucket boundary that the measurement must land in its bucket.
+
+            const int FIRST = Obj::lifetimeBucket(NUM_BLOCKS - 1);
+
+            ASSERTV(histograms.d_lifetimes[C][FIRST],
+                    1 <= histograms.d_lifetimes[C][FIRST]);
+            ASSERTV(histograms.d_lifetimes[C][0],
+                    NUM_BLOCKS > histograms.d_lifetimes[C][0]);
+
+            Int64 numDeallocations = 0;
+            for (int b = 0; b < Obj::k_NUM_LIFETIME_BUCKETS; ++b) {
+                ASSERTV(b, b <= FIRST || 0 == histograms.d_lifetimes[C][b]);
+                numDeallocations += histograms.d_lifetimes[C][b];
+            }
+            ASSERT(NUM_BLOCKS == numDeallocations);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\tConcurrent counting." << endl;
+        {
+            using namespace TestCase6;
+
+            Obj mX("concurrent", Obj::e_COLLECT_HISTOGRAMS, &sa);
+            const Obj& X = mX;
+
+            const int NUM_THREAD_ITERATIONS = 1000;
+
+            ThreadInfo info = { NUM_THREAD_ITERATIONS, &mX };
+
+            ThreadId id1 = createThread(&threadFunction1, &info);
+            ThreadId id2 = createThread(&threadFunction2, &info);
+            ThreadId id3 = createThread(&threadFunction3, &info);
+
+            joinThread(id1);
+            joinThread(id2);
+            joinThread(id3);
+
+            ASSERT(0 == X.numBytesInUse());
+
+            Obj::HistogramSnapshot histograms;
+            ASSERT(0 == X.snapshot(&histograms));
+
+            Int64 numAllocations = 0, numDeallocations = 0, numBytes = 0;
+            for (int c = 0; c < Obj::k_NUM_SIZE_CLASSES; ++c) {
+                numAllocations += histograms.d_numAllocations[c];
+                numBytes       += histograms.d_numBytes[c];
+                for (int b = 0; b < Obj::k_NUM_LIFETIME_BUCKETS; ++b) {
+                    numDeallocations += histograms.d_lifetimes[c][b];
+                }
+            }
+
+            ASSERT(histograms.d_numTicks == numAllocations);
+            ASSERT(numAllocations        == numDeallocations);
+            ASSERT(X.numBytesTotal()     == numBytes);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
       } break;
       case 6: {
         // --------------------------------------------------------------------
@@ -975,6 +1471,10 @@ if (veryVerbose)
         //:   two byte counts ('numBytesInUse' and 'numBytesTotal').
         //:
         //: 9 There is no temporary allocation from any allocator.
+        //:
+        //:10 'deallocateSized' updates the byte counts and returns memory to
+        //:   the object allocator exactly as 'deallocate' does, and has no
+        //:   effect if the address is 0.
         //
         // Plan:
         //: 1 Using the table-driven technique:
@@ -1023,10 +1523,16 @@ if (veryVerbose)
         //:
         //: 4 Perform a separate brute-force test to verify that
         //:   'mX.deallocate(0)' has no effect.  (C-6)
+        //:
+        //: 5 Allocate blocks of several sizes, return them using
+        //:   'deallocateSized', and verify the byte counts and the blocks in
+        //:   use from 'sa' after each call, including 'deallocateSized(0, 0)'.
+        //:   (C-10)
         //
         // Testing:
         //   void *allocate(size_type size);
         //   void deallocate(void *address);
+        //   void deallocateSized(void *address, size_type size);
         //   Int64 numBytesInUse() const;
         //   Int64 numBytesTotal() const;
         // --------------------------------------------------------------------
@@ -1230,6 +1736,50 @@ if (veryVerbose)
             ASSERT(0 == da.numBlocksTotal());
         }
 
+        if (verbose) cout << "\nTesting 'deallocateSized'." << endl;
+        {
+            bslma::TestAllocator da("default",  veryVeryVeryVerbose);
+            bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Obj mX(&sa);  const Obj& X = mX;
+
+            const int SIZES[]   = { 1, 5, 8, 16, 33, 1000 };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            void *blocks[NUM_SIZES];
+
+            bsls::Types::Int64 total = 0;
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                blocks[i] = mX.allocate(SIZES[i]);
+                total    += SIZES[i];
+            }
+
+            ASSERT(total     ==  X.numBytesInUse());
+            ASSERT(total     ==  X.numBytesTotal());
+            ASSERT(NUM_SIZES == sa.numBlocksInUse());
+
+            mX.deallocateSized(0, 0);
+
+            ASSERT(total     ==  X.numBytesInUse());
+            ASSERT(NUM_SIZES == sa.numBlocksInUse());
+
+            bsls::Types::Int64 inUse = total;
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                mX.deallocateSized(blocks[i], SIZES[i]);
+                inUse -= SIZES[i];
+
+                LOOP_ASSERT(i, inUse == X.numBytesInUse());
+                LOOP_ASSERT(i, total == X.numBytesTotal());
+                LOOP_ASSERT(i, NUM_SIZES - i - 1 == sa.numBlocksInUse());
+            }
+
+            ASSERT(0 == da.numBlocksTotal());
+        }
+
       } break;
       case 2: {
         // --------------------------------------------------------------------
@@ -0,0 +1,83 @@
+// bdlma_fixedpool.cpp                                                -*-C++-*-
+#include <bdlma_fixedpool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_fixedpool_cpp,"$Id$ $CSID$")
+
+#include <bsls_performancehint.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+namespace {
+
+// CONSTANTS
+enum {
+    k_GROWTH_FACTOR = 2  // multiplicative factor by which to grow pool
+                         // capacity
+};
+
+}  // close unnamed namespace
+
+                        // ---------------------
+                        // struct FixedPool_Util
+                        // ---------------------
+
+// CLASS METHODS
+void *FixedPool_Util::replenish(
+                               char                        **begin,
+                               char                        **end,
+                               BlockList                    *blockList,
+                               int                          *chunkSize,
+                               int                           maxBlocksPerChunk,
+                               bsls::BlockGrowth::Strategy   growthStrategy,
+                               int                           blockSize)
+{
+    BSLS_ASSERT(begin);
+    BSLS_ASSERT(end);
+    BSLS_ASSERT(blockList);
+    BSLS_ASSERT(chunkSize);
+    BSLS_ASSERT(1 <= *chunkSize);
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+    BSLS_ASSERT(1 <= blockSize);
+
+    char *chunk = static_cast<char *>(
+                                  blockList->allocate(*chunkSize * blockSize));
+
+    *begin = chunk + blockSize;
+    *end   = chunk + *chunkSize * blockSize;
+
+    if (   bsls::BlockGrowth::BSLS_GEOMETRIC == growthStrategy
+        && *chunkSize < maxBlocksPerChunk) {
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                          *chunkSize * k_GROWTH_FACTOR <= maxBlocksPerChunk)) {
+            *chunkSize = *chunkSize * k_GROWTH_FACTOR;
+        }
+        else {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            *chunkSize = maxBlocksPerChunk;
+        }
+    }
+
+    return chunk;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,623 @@
+// bdlma_fixedpool.h                                                  -*-C++-*-
+#ifndef INCLUDED_BDLMA_FIXEDPOOL
+#define INCLUDED_BDLMA_FIXEDPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a pool of blocks whose size is fixed at compile time.
+//
+//@CLASSES:
+//  bdlma::FixedPool: pool of blocks of a compile-time size and alignment
+//  bdlma::FixedPool_Util: implementation utility independent of block size
+//
+//@SEE_ALSO: bdlma_pool
+//
+//@DESCRIPTION: This component implements a memory pool class template,
+// 'bdlma::FixedPool', that allocates and manages memory blocks of a uniform
+// size, and with an alignment, specified as template parameters.  Apart from
+// the size being bound at compile time, a 'bdlma::FixedPool' behaves exactly
+// as a 'bdlma::Pool': it dispenses one block for each 'allocate' invocation
+// from an internal free list, returns each deallocated block to that list,
+// and replenishes the list by carving blocks from a "chunk" of memory
+// obtained from the basic allocator, whose size is governed by the same
+// growth strategy and maximum blocks per chunk.
+//
+// Because the size of the blocks, and therefore the distance between
+// consecutive blocks of a chunk, is a compile-time constant, the pool need
+// not store it, and 'allocate' and 'deallocate' are inlined to a handful of
+// instructions with the size and alignment arithmetic folded away.
+// 'bdlma::FixedPool' is therefore suitable for a node-based container whose
+// node size is known when the container type is, e.g.:
+//..
+//  typedef bdlma::FixedPool<sizeof(Node)> NodePool;
+//..
+//
+///Alignment
+///---------
+// The optional 'ALIGNMENT' template parameter specifies the alignment of each
+// block dispensed by the pool, and must be a power of two not exceeding
+// 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT'.  If 'ALIGNMENT' is 0 (the
+// default), each block is naturally aligned for an object of size
+// 'BLOCK_SIZE', i.e., aligned to the largest power of two dividing
+// 'BLOCK_SIZE', up to the maximum alignment.  Blocks are spaced by
+// 'BLOCK_SIZE' rounded up to a multiple of that alignment (and of the
+// alignment of a pointer, which each free block stores), so that specifying a
+// smaller alignment packs blocks more densely.  For example, blocks of a
+// 'bdlma::FixedPool<24>' are 8-byte aligned and 24 bytes apart, whereas those
+// of a 'bdlma::FixedPool<24, 16>' are 16-byte aligned and 32 bytes apart.
+//
+///Configuration at Construction
+///-----------------------------
+// When creating a 'bdlma::FixedPool', clients can optionally configure the
+// GROWTH STRATEGY, MAX BLOCKS PER CHUNK, and BASIC ALLOCATOR, with the same
+// meanings and defaults as for 'bdlma::Pool' (see 'bdlma_pool').
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating the Nodes of a Linked List
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we implement a simple stack of integers as a singly-linked
+// list, whose nodes all have the same size.  Since that size is known at
+// compile time, we can supply nodes from a 'bdlma::FixedPool' rather than
+// from a 'bdlma::Pool'.
+//
+// First, we define the node type and the interface of our stack:
+//..
+//  class my_IntStack {
+//      // This class implements a stack of 'int' values.
+//
+//      // PRIVATE TYPES
+//      struct Node {
+//          Node *d_next_p;  // next node, or 0
+//          int   d_value;   // value of this node
+//      };
+//
+//      typedef bdlma::FixedPool<sizeof(Node)> NodePool;
+//
+//      // DATA
+//      Node     *d_top_p;  // top of the stack, or 0 if empty
+//      NodePool  d_pool;   // supplies memory for nodes
+//
+//    public:
+//      // CREATORS
+//      explicit my_IntStack(bslma::Allocator *basicAllocator = 0);
+//          // Create an empty stack.  Optionally specify a 'basicAllocator'
+//          // used to supply memory.  If 'basicAllocator' is 0, the currently
+//          // installed default allocator is used.
+//
+//      // MANIPULATORS
+//      void push(int value);
+//          // Push the specified 'value' onto this stack.
+//
+//      int pop();
+//          // Remove the top value of this stack, and return it.  The behavior
+//          // is undefined if this stack is empty.
+//
+//      // ACCESSORS
+//      bool isEmpty() const;
+//          // Return 'true' if this stack is empty, and 'false' otherwise.
+//  };
+//..
+// Then, we implement the constructor, which need not supply a block size to
+// the pool:
+//..
+//  my_IntStack::my_IntStack(bslma::Allocator *basicAllocator)
+//  : d_top_p(0)
+//  , d_pool(basicAllocator)
+//  {
+//  }
+//..
+// Next, we implement the manipulators, which allocate a node from, and return
+// a node to, the pool:
+//..
+//  void my_IntStack::push(int value)
+//  {
+//      Node *node     = static_cast<Node *>(d_pool.allocate());
+//      node->d_next_p = d_top_p;
+//      node->d_value  = value;
+//      d_top_p        = node;
+//  }
+//
+//  int my_IntStack::pop()
+//  {
+//      Node *node  = d_top_p;
+//      int   value = node->d_value;
+//      d_top_p     = node->d_next_p;
+//      d_pool.deallocate(node);
+//      return value;
+//  }
+//
+//  bool my_IntStack::isEmpty() const
+//  {
+//      return 0 == d_top_p;
+//  }
+//..
+// Note that the stack does not deallocate its remaining nodes on destruction,
+// because the pool releases all of its memory when it is destroyed.
+//
+// Finally, we use the stack:
+//..
+//  bslma::TestAllocator ta;
+//  {
+//      my_IntStack stack(&ta);
+//      stack.push(1);
+//      stack.push(2);
+//      assert(2 == stack.pop());
+//      stack.push(3);
+//      assert(3 == stack.pop());
+//      assert(1 == stack.pop());
+//      assert(stack.isEmpty());
+//  }
+//  assert(0 == ta.numBytesInUse());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ASSERT
+#include <bslmf_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTFROMTYPE
+#include <bsls_alignmentfromtype.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BLOCKGROWTH
+#include <bsls_blockgrowth.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                        // =====================
+                        // struct FixedPool_Util
+                        // =====================
+
+struct FixedPool_Util {
+    // This 'struct' provides a namespace for the part of the implementation
+    // of 'FixedPool' that does not depend on its template parameters, and is
+    // kept out of line so that it does not burden the inlined 'allocate'.
+
+    // CLASS METHODS
+    static void *replenish(char                        **begin,
+                           char                        **end,
+                           BlockList                    *blockList,
+                           int                          *chunkSize,
+                           int                           maxBlocksPerChunk,
+                           bsls::BlockGrowth::Strategy   growthStrategy,
+                           int                           blockSize);
+        // Allocate from the specified 'blockList' a chunk of the specified
+        // '*chunkSize' blocks of the specified 'blockSize', return the
+        // address of its first block, and load into the specified '*begin'
+        // and '*end' the bounds of its remaining blocks.  Then, if the
+        // specified 'growthStrategy' is geometric, double '*chunkSize' up to
+        // the specified 'maxBlocksPerChunk'.  The behavior is undefined
+        // unless '1 <= *chunkSize', '1 <= maxBlocksPerChunk', and
+        // '1 <= blockSize'.
+};
+
+                        // ===============
+                        // class FixedPool
+                        // ===============
+
+template <int BLOCK_SIZE, int ALIGNMENT = 0>
+class FixedPool {
+    // This class implements a memory pool that allocates and manages memory
+    // blocks of the (template parameter) 'BLOCK_SIZE', each aligned to the
+    // (template parameter) 'ALIGNMENT' (or, if 'ALIGNMENT' is 0, naturally
+    // aligned for 'BLOCK_SIZE').  This memory pool maintains an internal
+    // linked list of free memory blocks, and dispenses one block for each
+    // 'allocate' method invocation.  When a memory block is deallocated, it is
+    // returned to the free list for potential reuse.
+
+    // PRIVATE TYPES
+    struct Link {
+        // This 'struct' implements a link data structure that stores the
+        // address of the next link, and is used to implement the internal
+        // linked list of free memory blocks.
+
+        Link *d_next_p;  // pointer to next link
+    };
+
+    enum {
+        k_MAX_ALIGNMENT      = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT,
+
+        k_NATURAL_ALIGNMENT  = (BLOCK_SIZE & -BLOCK_SIZE) < k_MAX_ALIGNMENT
+                             ? (BLOCK_SIZE & -BLOCK_SIZE)
+                             : k_MAX_ALIGNMENT,
+
+        k_ALIGNMENT          = ALIGNMENT ? ALIGNMENT : k_NATURAL_ALIGNMENT,
+
+        k_LINK_ALIGNMENT     = bsls::AlignmentFromType<Link>::VALUE,
+
+        k_STRIDE             = k_ALIGNMENT < k_LINK_ALIGNMENT
+                             ? k_LINK_ALIGNMENT
+                             : k_ALIGNMENT,
+
+        k_MIN_SIZE           = BLOCK_SIZE < static_cast<int>(sizeof(Link))
+                             ? static_cast<int>(sizeof(Link))
+                             : BLOCK_SIZE,
+
+        k_INTERNAL_BLOCK_SIZE
+                             = (k_MIN_SIZE + k_STRIDE - 1) / k_STRIDE
+                                                                  * k_STRIDE,
+                                   // distance between consecutive blocks
+
+        k_INITIAL_CHUNK_SIZE =  1, // default number of blocks per chunk
+
+        k_MAX_CHUNK_SIZE     = 32  // default maximum number of blocks per
+                                   // chunk
+    };
+
+    BSLMF_ASSERT(1 <= BLOCK_SIZE);
+    BSLMF_ASSERT(0 <= ALIGNMENT);
+    BSLMF_ASSERT(0 == (ALIGNMENT & (ALIGNMENT - 1)));
+    BSLMF_ASSERT(ALIGNMENT <= k_MAX_ALIGNMENT);
+
+    // DATA
+    Link      *d_freeList_p;        // linked list of free memory blocks
+
+    char      *d_begin_p;           // start of a contiguous group of memory
+                                    // blocks
+
+    char      *d_end_p;             // end of a contiguous group of memory
+                                    // blocks
+
+    int        d_chunkSize;         // current chunk size (in
+                                    // blocks-per-chunk)
+
+    int        d_maxBlocksPerChunk; // maximum chunk size (in
+                                    // blocks-per-chunk)
+
+    bsls::BlockGrowth::Strategy
+               d_growthStrategy;    // growth strategy of the chunk size
+
+    BlockList  d_blockList;         // memory manager for allocated memory
+
+  private:
+    // PRIVATE MANIPULATORS
+    void *replenish();
+        // Dynamically allocate a new chunk using this pool's underlying growth
+        // strategy, and return the address of its first block, dispensing the
+        // remaining blocks of the chunk from 'd_begin_p'.
+
+  private:
+    // NOT IMPLEMENTED
+    FixedPool(const FixedPool&);
+    FixedPool& operator=(const FixedPool&);
+
+  public:
+    // CREATORS
+    explicit
+    FixedPool(bslma::Allocator            *basicAllocator = 0);
+    explicit
+    FixedPool(bsls::BlockGrowth::Strategy  growthStrategy,
+              bslma::Allocator            *basicAllocator = 0);
+    FixedPool(bsls::BlockGrowth::Strategy  growthStrategy,
+              int                          maxBlocksPerChunk,
+              bslma::Allocator            *basicAllocator = 0);
+        // Create a memory pool that returns blocks of contiguous memory of the
+        // (template parameter) 'BLOCK_SIZE' (in bytes) for each 'allocate'
+        // method invocation.  Optionally specify a 'growthStrategy' used to
+        // control the growth of internal memory chunks (from which memory
+        // blocks are dispensed).  If 'growthStrategy' is not specified,
+        // geometric growth is used.  Optionally specify 'maxBlocksPerChunk' as
+        // the maximum chunk size if 'growthStrategy' is specified.  If
+        // geometric growth is used, the chunk size grows starting at one
+        // block, doubling in size until it is exactly 'maxBlocksPerChunk'
+        // blocks.  If constant growth is used, the chunk size is always
+        // 'maxBlocksPerChunk' blocks.  If 'maxBlocksPerChunk' is not
+        // specified, an implementation-defined value is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '1 <= maxBlocksPerChunk'.
+
+    ~FixedPool();
+        // Destroy this pool, releasing all associated memory back to the
+        // underlying allocator.
+
+    // MANIPULATORS
+    void *allocate();
+        // Return the address of a contiguous block of memory having the
+        // (template parameter) 'BLOCK_SIZE', aligned as described in the
+        // component-level documentation.
+
+    void *allocate(bsls::Types::size_type size);
+        // Return the address of a contiguous block of memory having the
+        // (template parameter) 'BLOCK_SIZE', aligned as described in the
+        // component-level documentation.  The behavior is undefined unless
+        // 'size <= BLOCK_SIZE'.  Note that this overload allows this pool to
+        // be used where an object providing 'allocate(size)' and
+        // 'deallocate(address)' is expected.
+
+    void deallocate(void *address);
+        // Relinquish the memory block at the specified 'address' back to this
+        // pool object for reuse.  The behavior is undefined unless 'address'
+        // is non-zero, was allocated by this pool, and has not already been
+        // deallocated.
+
+    template <class TYPE>
+    void deleteObject(const TYPE *object);
+        // Destroy the specified 'object' based on its dynamic type and then
+        // use this pool to deallocate its memory footprint.  This method has
+        // no effect if 'object' is 0.  The behavior is undefined unless
+        // 'object', when cast appropriately to 'void *', was allocated using
+        // this pool and has not already been deallocated.  Note that
+        // 'dynamic_cast<void *>(object)' is applied if 'TYPE' is polymorphic,
+        // and 'static_cast<void *>(object)' is applied otherwise.
+
+    template <class TYPE>
+    void deleteObjectRaw(const TYPE *object);
+        // Destroy the specified 'object' and then use this pool to deallocate
+        // its memory footprint.  This method has no effect if 'object' is 0.
+        // The behavior is undefined unless 'object' is !not! a secondary base
+        // class pointer (i.e., the address is (numerically) the same as when
+        // it was originally dispensed by this pool), was allocated using this
+        // pool, and has not already been deallocated.
+
+    void release();
+        // Relinquish all memory currently allocated via this pool object.
+
+    void reserveCapacity(int numBlocks);
+        // Reserve memory from this pool to satisfy memory requests for at
+        // least the specified 'numBlocks' before the pool replenishes.  The
+        // behavior is undefined unless '0 <= numBlocks'.
+
+    // ACCESSORS
+    int alignment() const;
+        // Return the alignment (in bytes) of the memory blocks allocated from
+        // this pool object.
+
+    int blockSize() const;
+        // Return the size (in bytes) of the memory blocks allocated from this
+        // pool object, i.e., the (template parameter) 'BLOCK_SIZE'.
+};
+
+// ============================================================================
+//                          INLINE DEFINITIONS
+// ============================================================================
+
+                        // ---------------
+                        // class FixedPool
+                        // ---------------
+
+// PRIVATE MANIPULATORS
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+void *FixedPool<BLOCK_SIZE, ALIGNMENT>::replenish()
+{
+    return FixedPool_Util::replenish(&d_begin_p,
+                                     &d_end_p,
+                                     &d_blockList,
+                                     &d_chunkSize,
+                                     d_maxBlocksPerChunk,
+                                     d_growthStrategy,
+                                     k_INTERNAL_BLOCK_SIZE);
+}
+
+// CREATORS
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+FixedPool<BLOCK_SIZE, ALIGNMENT>::FixedPool(bslma::Allocator *basicAllocator)
+: d_freeList_p(0)
+, d_begin_p(0)
+, d_end_p(0)
+, d_chunkSize(k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(k_MAX_CHUNK_SIZE)
+, d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
+, d_blockList(basicAllocator)
+{
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+FixedPool<BLOCK_SIZE, ALIGNMENT>::FixedPool(
+                                 bsls::BlockGrowth::Strategy  growthStrategy,
+                                 bslma::Allocator            *basicAllocator)
+: d_freeList_p(0)
+, d_begin_p(0)
+, d_end_p(0)
+, d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
+              ? k_MAX_CHUNK_SIZE
+              : k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(k_MAX_CHUNK_SIZE)
+, d_growthStrategy(growthStrategy)
+, d_blockList(basicAllocator)
+{
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+FixedPool<BLOCK_SIZE, ALIGNMENT>::FixedPool(
+                              bsls::BlockGrowth::Strategy  growthStrategy,
+                              int                          maxBlocksPerChunk,
+                              bslma::Allocator            *basicAllocator)
+: d_freeList_p(0)
+, d_begin_p(0)
+, d_end_p(0)
+, d_chunkSize(bsls::BlockGrowth::BSLS_CONSTANT == growthStrategy
+              ? maxBlocksPerChunk
+              : k_INITIAL_CHUNK_SIZE)
+, d_maxBlocksPerChunk(maxBlocksPerChunk)
+, d_growthStrategy(growthStrategy)
+, d_blockList(basicAllocator)
+{
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+FixedPool<BLOCK_SIZE, ALIGNMENT>::~FixedPool()
+{
+    BSLS_ASSERT(0 < d_chunkSize);
+}
+
+// MANIPULATORS
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+void *FixedPool<BLOCK_SIZE, ALIGNMENT>::allocate()
+{
+    if (d_begin_p == d_end_p) {
+        if (d_freeList_p) {
+            Link *p      = d_freeList_p;
+            d_freeList_p = p->d_next_p;
+            return p;                                                 // RETURN
+        }
+
+        return replenish();                                           // RETURN
+    }
+
+    char *p = d_begin_p;
+    d_begin_p += k_INTERNAL_BLOCK_SIZE;
+    return p;
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+void *FixedPool<BLOCK_SIZE, ALIGNMENT>::allocate(bsls::Types::size_type size)
+{
+    BSLS_ASSERT_SAFE(size <= static_cast<bsls::Types::size_type>(BLOCK_SIZE));
+
+    static_cast<void>(size);  // suppress "unused parameter" warnings
+    return allocate();
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+void FixedPool<BLOCK_SIZE, ALIGNMENT>::deallocate(void *address)
+{
+    BSLS_ASSERT_SAFE(address);
+
+    static_cast<Link *>(address)->d_next_p = d_freeList_p;
+    d_freeList_p = static_cast<Link *>(address);
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+template <class TYPE>
+inline
+void FixedPool<BLOCK_SIZE, ALIGNMENT>::deleteObject(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObject(object, this);
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+template <class TYPE>
+inline
+void FixedPool<BLOCK_SIZE, ALIGNMENT>::deleteObjectRaw(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObjectRaw(object, this);
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+void FixedPool<BLOCK_SIZE, ALIGNMENT>::release()
+{
+    d_blockList.release();
+    d_freeList_p = 0;
+    d_begin_p    = 0;
+    d_end_p      = 0;
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+void FixedPool<BLOCK_SIZE, ALIGNMENT>::reserveCapacity(int numBlocks)
+{
+    BSLS_ASSERT(0 <= numBlocks);
+
+    Link *p = d_freeList_p;
+    while (p && numBlocks > 0) {
+        p = p->d_next_p;
+        --numBlocks;
+    }
+
+    if (numBlocks > 0 && d_end_p == d_begin_p) {
+        d_begin_p = static_cast<char *>(
+                     d_blockList.allocate(numBlocks * k_INTERNAL_BLOCK_SIZE));
+        d_end_p   = d_begin_p + numBlocks * k_INTERNAL_BLOCK_SIZE;
+        return;                                                       // RETURN
+    }
+
+    numBlocks -= static_cast<int>(d_end_p - d_begin_p) / k_INTERNAL_BLOCK_SIZE;
+
+    if (numBlocks > 0) {
+
+        // Allocate memory and add its blocks to the free list.
+
+        char *begin = static_cast<char *>(
+                     d_blockList.allocate(numBlocks * k_INTERNAL_BLOCK_SIZE));
+        char *end   = begin + (numBlocks - 1) * k_INTERNAL_BLOCK_SIZE;
+
+        for (char *q = begin; q < end; q += k_INTERNAL_BLOCK_SIZE) {
+            reinterpret_cast<Link *>(q)->d_next_p =
+                           reinterpret_cast<Link *>(q + k_INTERNAL_BLOCK_SIZE);
+        }
+
+        reinterpret_cast<Link *>(end)->d_next_p = d_freeList_p;
+        d_freeList_p = reinterpret_cast<Link *>(begin);
+    }
+}
+
+// ACCESSORS
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+int FixedPool<BLOCK_SIZE, ALIGNMENT>::alignment() const
+{
+    return k_ALIGNMENT;
+}
+
+template <int BLOCK_SIZE, int ALIGNMENT>
+inline
+int FixedPool<BLOCK_SIZE, ALIGNMENT>::blockSize() const
+{
+    return BLOCK_SIZE;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
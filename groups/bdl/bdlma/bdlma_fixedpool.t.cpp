@@ -0,0 +1,1080 @@
+// bdlma_fixedpool.t.cpp                                              -*-C++-*-
+#include <bdlma_fixedpool.h>
+
+#include <bdlma_pool.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The goals of this 'bdlma::FixedPool' test driver are to verify that: 1) the
+// 'allocate' method dispenses memory blocks of the (template parameter) size
+// and alignment, 2) the pool replenishes exactly as a 'bdlma::Pool' of the
+// same block size configured with the same 'growthStrategy' and
+// 'maxBlocksPerChunk', 3) the 'deallocate' method returns the memory to the
+// pool, and 4) the 'release' method and the destructor release all memory
+// allocated through the pool.
+//
+// Since the block size and alignment are template parameters, the tests that
+// vary them are written as function templates instantiated for a table of
+// sizes and alignments.  Goal 2 is verified by driving a 'bdlma::FixedPool'
+// and a 'bdlma::Pool' in lock step, each supplied with its own test
+// allocator, and comparing the number of allocations made from each.
+//-----------------------------------------------------------------------------
+// [ 3] FixedPool(basicAllocator = 0);
+// [ 3] FixedPool(gs, basicAllocator = 0);
+// [ 3] FixedPool(gs, mbpc, basicAllocator = 0);
+// [ 5] ~FixedPool();
+// [ 2] void *allocate();
+// [ 7] void *allocate(bsls::Types::size_type size);
+// [ 4] void deallocate(address);
+// [ 6] template <class TYPE> void deleteObject(const TYPE *object);
+// [ 6] template <class TYPE> void deleteObjectRaw(const TYPE *object);
+// [ 5] void release();
+// [ 8] void reserveCapacity(numBlocks);
+// [ 2] int alignment() const;
+// [ 2] int blockSize() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 9] USAGE EXAMPLE
+// [ *] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+//-----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                               GLOBAL TYPEDEF
+//-----------------------------------------------------------------------------
+
+typedef bsls::BlockGrowth::Strategy Strategy;
+
+static const Strategy GEO = bsls::BlockGrowth::BSLS_GEOMETRIC;
+static const Strategy CON = bsls::BlockGrowth::BSLS_CONSTANT;
+
+// ============================================================================
+//                      FILE-STATIC FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+int naturalAlignment(int size)
+    // Return the largest power of two that divides the specified 'size', or
+    // the maximum alignment if that is smaller.  The behavior is undefined
+    // unless '1 <= size'.
+{
+    int alignment = size & -size;
+    return alignment < bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+           ? alignment
+           : bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+}
+
+static
+int expectedStride(int size, int alignment)
+    // Return the expected distance between consecutive blocks of a pool of
+    // blocks of the specified 'size' and 'alignment', where an 'alignment' of
+    // 0 denotes the natural alignment of 'size'.
+{
+    if (0 == alignment) {
+        alignment = naturalAlignment(size);
+    }
+    if (alignment < static_cast<int>(sizeof(void *))) {
+        alignment = sizeof(void *);
+    }
+    if (size < static_cast<int>(sizeof(void *))) {
+        size = sizeof(void *);
+    }
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+template <int SIZE, int ALIGNMENT>
+void testBlocks(int line, bool veryVerbose)
+    // Verify, for a 'bdlma::FixedPool<SIZE, ALIGNMENT>', that the accessors
+    // return the expected values, and that consecutive blocks carved from one
+    // chunk are aligned as expected and are the expected distance apart.
+    // Report failures using the specified 'line', and print diagnostics if
+    // the specified 'veryVerbose' is 'true'.
+{
+    typedef bdlma::FixedPool<SIZE, ALIGNMENT> Obj;
+
+    const int EXP_ALIGN  = ALIGNMENT ? ALIGNMENT : naturalAlignment(SIZE);
+    const int EXP_STRIDE = expectedStride(SIZE, ALIGNMENT);
+
+    bslma::TestAllocator ta;
+    Obj                  mX(CON, 8, &ta);  const Obj& X = mX;
+
+    LOOP_ASSERT(line, SIZE      == X.blockSize());
+    LOOP_ASSERT(line, EXP_ALIGN == X.alignment());
+
+    char *prev = static_cast<char *>(mX.allocate());
+    for (int i = 1; i < 8; ++i) {
+        char *p = static_cast<char *>(mX.allocate());
+
+        LOOP3_ASSERT(line, i, p - prev, EXP_STRIDE == p - prev);
+        LOOP2_ASSERT(line, i,
+                     0 == reinterpret_cast<bsls::Types::UintPtr>(p)
+                                                              % EXP_ALIGN);
+        prev = p;
+    }
+    LOOP_ASSERT(line, 1 == ta.numAllocations());
+
+    if (veryVerbose) {
+        T_ P_(line) P_(SIZE) P_(ALIGNMENT) P_(EXP_ALIGN) P(EXP_STRIDE)
+    }
+}
+
+template <int SIZE>
+void testGrowth(int line, Strategy strategy, int maxBlocks, bool veryVerbose)
+    // Verify that a 'bdlma::FixedPool<SIZE>' constructed with the specified
+    // 'strategy' and 'maxBlocks' requests memory from its basic allocator
+    // when, and only when, a 'bdlma::Pool' of blocks of 'SIZE' bytes
+    // constructed with the same arguments does, and that it never holds more
+    // memory than that pool (which precedes each chunk with a header).
+    // Report failures using the specified 'line', and print diagnostics if
+    // the specified 'veryVerbose' is 'true'.
+{
+    bslma::TestAllocator taX;  const bslma::TestAllocator& TAX = taX;
+    bslma::TestAllocator taY;  const bslma::TestAllocator& TAY = taY;
+
+    bdlma::FixedPool<SIZE> mX(strategy, maxBlocks, &taX);
+    bdlma::Pool            mY(SIZE, strategy, maxBlocks, &taY);
+
+    const int NUM_REQUESTS = 4 * maxBlocks + 40;
+
+    for (int i = 0; i < NUM_REQUESTS; ++i) {
+        mX.allocate();
+        mY.allocate();
+
+        LOOP3_ASSERT(line, i, TAX.numAllocations(),
+                     TAY.numAllocations() == TAX.numAllocations());
+        LOOP2_ASSERT(line, i, TAX.numBytesInUse() <= TAY.numBytesInUse());
+    }
+
+    if (veryVerbose) {
+        T_ P_(line) P_(SIZE) P_(maxBlocks) P(TAX.numAllocations())
+    }
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating the Nodes of a Linked List
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we implement a simple stack of integers as a singly-linked
+// list, whose nodes all have the same size.  Since that size is known at
+// compile time, we can supply nodes from a 'bdlma::FixedPool' rather than
+// from a 'bdlma::Pool'.
+//
+// First, we define the node type and the interface of our stack:
+//..
+    class my_IntStack {
+        // This class implements a stack of 'int' values.
+
+        // PRIVATE TYPES
+        struct Node {
+            Node *d_next_p;  // next node, or 0
+            int   d_value;   // value of this node
+        };
+
+        typedef bdlma::FixedPool<sizeof(Node)> NodePool;
+
+        // DATA
+        Node     *d_top_p;  // top of the stack, or 0 if empty
+        NodePool  d_pool;   // supplies memory for nodes
+
+      public:
+        // CREATORS
+        explicit my_IntStack(bslma::Allocator *basicAllocator = 0);
+            // Create an empty stack.  Optionally specify a 'basicAllocator'
+            // used to supply memory.  If 'basicAllocator' is 0, the currently
+            // installed default allocator is used.
+
+        // MANIPULATORS
+        void push(int value);
+            // Push the specified 'value' onto this stack.
+
+        int pop();
+            // Remove the top value of this stack, and return it.  The behavior
+            // is undefined if this stack is empty.
+
+        // ACCESSORS
+        bool isEmpty() const;
+            // Return 'true' if this stack is empty, and 'false' otherwise.
+    };
+//..
+// Then, we implement the constructor, which need not supply a block size to
+// the pool:
+//..
+    my_IntStack::my_IntStack(bslma::Allocator *basicAllocator)
+    : d_top_p(0)
+    , d_pool(basicAllocator)
+    {
+    }
+//..
+// Next, we implement the manipulators, which allocate a node from, and return
+// a node to, the pool:
+//..
+    void my_IntStack::push(int value)
+    {
+        Node *node     = static_cast<Node *>(d_pool.allocate());
+        node->d_next_p = d_top_p;
+        node->d_value  = value;
+        d_top_p        = node;
+    }
+
+    int my_IntStack::pop()
+    {
+        Node *node  = d_top_p;
+        int   value = node->d_value;
+        d_top_p     = node->d_next_p;
+        d_pool.deallocate(node);
+        return value;
+    }
+
+    bool my_IntStack::isEmpty() const
+    {
+        return 0 == d_top_p;
+    }
+//..
+// Note that the stack does not deallocate its remaining nodes on destruction,
+// because the pool releases all of its memory when it is destroyed.
+
+//=============================================================================
+// CONCRETE OBJECTS FOR TESTING 'deleteObject'
+//-----------------------------------------------------------------------------
+
+static int my_ClassCode = 0;
+
+class my_Class1 {
+  public:
+    my_Class1()  { my_ClassCode = 1; }
+    ~my_Class1() { my_ClassCode = 2; }
+};
+
+static int leftBaseObjectCount    = 0;
+static int rightBaseObjectCount   = 0;
+static int mostDerivedObjectCount = 0;
+
+class my_LeftBase {
+    int x;
+  public:
+    my_LeftBase()             { leftBaseObjectCount = 1; }
+    virtual ~my_LeftBase()    { leftBaseObjectCount = 0; }
+};
+
+class my_RightBase {
+    int x;
+  public:
+    my_RightBase()            { rightBaseObjectCount = 1; }
+    virtual ~my_RightBase()   { rightBaseObjectCount = 0; }
+};
+
+class my_MostDerived : public my_LeftBase, public my_RightBase {
+    int x;
+  public:
+    my_MostDerived()          { mostDerivedObjectCount = 1; }
+    ~my_MostDerived()         { mostDerivedObjectCount = 0; }
+};
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 9: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Finally, we use the stack:
+//..
+    bslma::TestAllocator ta;
+    {
+        my_IntStack stack(&ta);
+        stack.push(1);
+        stack.push(2);
+        ASSERT(2 == stack.pop());
+        stack.push(3);
+        ASSERT(3 == stack.pop());
+        ASSERT(1 == stack.pop());
+        ASSERT(stack.isEmpty());
+    }
+    ASSERT(0 == ta.numBytesInUse());
+//..
+
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // 'reserveCapacity' TEST
+        //
+        // Concerns:
+        //: 1 'reserveCapacity' obtains from the basic allocator exactly the
+        //:   memory needed for the requested number of blocks beyond those
+        //:   already available, as a single chunk.
+        //:
+        //: 2 The reserved blocks are then allocated without the pool
+        //:   replenishing.
+        //:
+        //: 3 Reserving no more blocks than are available has no effect.
+        //:
+        //: 4 Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a table of numbers of blocks allocated beforehand and of
+        //:   blocks to reserve, create a pool with a test allocator, allocate
+        //:   and deallocate the former, reserve the latter, and verify the
+        //:   number of allocations and the bytes in use.  Then allocate the
+        //:   reserved blocks and verify that the number of allocations does
+        //:   not change.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a negative number of blocks.  (C-4)
+        //
+        // Testing:
+        //   void reserveCapacity(numBlocks);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'reserveCapacity' TEST" << endl
+                                  << "======================" << endl;
+
+        typedef bdlma::FixedPool<24> Obj;
+
+        const int STRIDE = expectedStride(24, 0);
+
+        static const struct {
+            int d_line;
+            int d_numAllocated;   // blocks allocated, then deallocated
+            int d_numReserved;    // blocks to reserve
+            int d_expNewBlocks;   // blocks expected in the new chunk
+        } DATA[] = {
+            //LINE  ALLOCATED  RESERVED  NEW BLOCKS
+            //----  ---------  --------  ----------
+            { L_,           0,        0,          0 },
+            { L_,           0,        1,          1 },
+            { L_,           0,       10,         10 },
+            { L_,           1,        1,          0 },
+            { L_,           1,        3,          2 },
+            { L_,           3,        3,          0 },
+            { L_,           4,        2,          0 },
+            { L_,           4,       10,          3 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE      = DATA[ti].d_line;
+            const int ALLOCATED = DATA[ti].d_numAllocated;
+            const int RESERVED  = DATA[ti].d_numReserved;
+            const int EXP       = DATA[ti].d_expNewBlocks;
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            const bslma::TestAllocator& TA = ta;
+
+            // With geometric growth, the pool obtains chunks of 1, 2, and 4
+            // blocks, so that after allocating 4 blocks, 3 blocks of the
+            // current chunk have not yet been dispensed.
+
+            Obj mX(&ta);
+
+            void *blocks[16];
+            for (int i = 0; i < ALLOCATED; ++i) {
+                blocks[i] = mX.allocate();
+            }
+            for (int i = 0; i < ALLOCATED; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            const bsls::Types::Int64 NUM_ALLOCS = TA.numAllocations();
+            const bsls::Types::Int64 NUM_BYTES  = TA.numBytesInUse();
+
+            mX.reserveCapacity(RESERVED);
+
+            if (veryVerbose) {
+                T_ P_(LINE) P_(TA.numAllocations()) P(TA.numBytesInUse())
+            }
+
+            if (EXP) {
+                LOOP_ASSERT(LINE, NUM_ALLOCS + 1 == TA.numAllocations());
+                LOOP_ASSERT(LINE, EXP * STRIDE <= TA.numBytesInUse()
+                                                                - NUM_BYTES);
+                LOOP_ASSERT(LINE, EXP * STRIDE
+                                         + bsls::AlignmentUtil::
+                                                           BSLS_MAX_ALIGNMENT
+                                         + static_cast<int>(sizeof(void *)) * 2
+                                  >= TA.numBytesInUse() - NUM_BYTES);
+            }
+            else {
+                LOOP_ASSERT(LINE, NUM_ALLOCS == TA.numAllocations());
+            }
+
+            const bsls::Types::Int64 NUM_ALLOCS_RESERVED =
+                                                          TA.numAllocations();
+
+            for (int i = 0; i < RESERVED; ++i) {
+                mX.allocate();
+            }
+            LOOP_ASSERT(LINE, NUM_ALLOCS_RESERVED == TA.numAllocations());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX;
+
+            ASSERT_PASS(mX.reserveCapacity( 0));
+            ASSERT_FAIL(mX.reserveCapacity(-1));
+        }
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // 'allocate(size)' TEST
+        //
+        // Concerns:
+        //: 1 'allocate(size)' dispenses blocks exactly as 'allocate()' does.
+        //:
+        //: 2 The pool can be used as the backing store of an allocator
+        //:   adaptor that supplies the size of each request.
+        //:
+        //: 3 Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate blocks alternately with 'allocate()' and
+        //:   'allocate(size)' for sizes up to the block size, and verify that
+        //:   they are consecutive.  (C-1..2)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a size larger than the block size.  (C-3)
+        //
+        // Testing:
+        //   void *allocate(bsls::Types::size_type size);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'allocate(size)' TEST" << endl
+                                  << "=====================" << endl;
+
+        typedef bdlma::FixedPool<40> Obj;
+
+        const int STRIDE = expectedStride(40, 0);
+
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            const bslma::TestAllocator& TA = ta;
+
+            Obj mX(CON, 41, &ta);  // exactly the blocks allocated below
+
+            char *prev = static_cast<char *>(mX.allocate());
+            for (int size = 1; size <= 40; ++size) {
+                char *p = static_cast<char *>(size % 2
+                                              ? mX.allocate(size)
+                                              : mX.allocate());
+                LOOP_ASSERT(size, STRIDE == p - prev);
+                prev = p;
+            }
+            ASSERT(1 == TA.numAllocations());
+
+            mX.deallocate(prev);
+            ASSERT(prev == mX.allocate(1));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(&ta);
+
+            ASSERT_SAFE_PASS(mX.allocate(40));
+            ASSERT_SAFE_FAIL(mX.allocate(41));
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // 'deleteObject' AND 'deleteObjectRaw' TEST
+        //
+        // Concerns:
+        //: 1 'deleteObject' and 'deleteObjectRaw' invoke the destructor and
+        //:   then return the block to the pool.
+        //:
+        //: 2 'deleteObject' deallocates the most-derived object when given a
+        //:   pointer to a secondary base class.
+        //:
+        //: 3 Both methods have no effect when given a null pointer.
+        //
+        // Plan:
+        //: 1 Construct objects in blocks allocated from a pool that
+        //:   replenishes one block at a time, delete them, and verify that
+        //:   the destructors ran and that a subsequent 'allocate' returns the
+        //:   same block without replenishing.  (C-1..3)
+        //
+        // Testing:
+        //   template <class TYPE> void deleteObject(const TYPE *object);
+        //   template <class TYPE> void deleteObjectRaw(const TYPE *object);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'deleteObject' AND 'deleteObjectRaw' TEST"
+                          << endl
+                          << "========================================"
+                          << endl;
+
+        bslma::TestAllocator a(veryVeryVerbose);
+        const bslma::TestAllocator& A = a;
+
+        if (verbose) cout << "\nTesting 'deleteObjectRaw'." << endl;
+        {
+            bdlma::FixedPool<sizeof(my_Class1)> mX(CON, 1, &a);
+
+            my_ClassCode = 0;
+
+            my_Class1 *p = new (mX.allocate()) my_Class1;
+            ASSERT(1 == my_ClassCode);
+            ASSERT(1 == A.numAllocations());
+
+            mX.deleteObjectRaw(p);
+            ASSERT(2 == my_ClassCode);
+            ASSERT(p == mX.allocate());
+            ASSERT(1 == A.numAllocations());
+
+            p = 0;
+            mX.deleteObjectRaw(p);
+            ASSERT(1 == A.numAllocations());
+        }
+
+        if (verbose) cout << "\nTesting 'deleteObject'." << endl;
+        {
+            bdlma::FixedPool<sizeof(my_MostDerived)> mX(CON, 1, &a);
+
+            const bsls::Types::Int64 NUM_ALLOCS = A.numAllocations();
+
+            void           *block = mX.allocate();
+            my_MostDerived *pMost = new (block) my_MostDerived;
+            ASSERT(1 == mostDerivedObjectCount);
+            ASSERT(1 == leftBaseObjectCount);
+            ASSERT(1 == rightBaseObjectCount);
+
+            const my_RightBase *pRight = pMost;
+            ASSERT(static_cast<const void *>(pRight) != block);
+
+            mX.deleteObject(pRight);
+            ASSERT(0 == mostDerivedObjectCount);
+            ASSERT(0 == leftBaseObjectCount);
+            ASSERT(0 == rightBaseObjectCount);
+
+            ASSERT(block == mX.allocate());
+            ASSERT(NUM_ALLOCS + 1 == A.numAllocations());
+
+            pMost = 0;
+            mX.deleteObject(pMost);
+            ASSERT(NUM_ALLOCS + 1 == A.numAllocations());
+        }
+        ASSERT(0 == A.numBytesInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // DTOR AND RELEASE TEST
+        //
+        // Concerns:
+        //: 1 Both the destructor and the 'release' method free all memory
+        //:   used by the pool.
+        //:
+        //: 2 After 'release', the pool dispenses blocks as a new pool does,
+        //:   without having reset its chunk size.
+        //
+        // Plan:
+        //: 1 Create two pools, each supplied with its own test allocator, and
+        //:   allocate repeatedly from both.  Invoke 'release' on one pool,
+        //:   and allow the other pool to go out of scope.  Verify that both
+        //:   allocators indicate all memory has been released.  (C-1)
+        //:
+        //: 2 After 'release', allocate again and verify that the pool obtains
+        //:   a single chunk of the maximum size.  (C-2)
+        //
+        // Testing:
+        //   ~FixedPool();
+        //   void release();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "DTOR AND RELEASE TEST" << endl
+                                  << "=====================" << endl;
+
+        const int NUM_REQUESTS = 100;
+
+        bslma::TestAllocator taX(veryVeryVerbose);
+        const bslma::TestAllocator& TAX = taX;
+        bslma::TestAllocator taY(veryVeryVerbose);
+        const bslma::TestAllocator& TAY = taY;
+
+        {
+            bdlma::FixedPool<12> mX(&taX);
+            bdlma::FixedPool<12> mY(&taY);
+
+            for (int ai = 0; ai < NUM_REQUESTS; ++ai) {
+                mX.allocate();
+                mY.allocate();
+            }
+
+            ASSERT(0 < TAX.numBytesInUse());
+            mX.release();
+            ASSERT(0 == TAX.numBytesInUse());
+
+            const bsls::Types::Int64 NUM_ALLOCS = TAX.numAllocations();
+            for (int ai = 0; ai < 32; ++ai) {
+                mX.allocate();
+            }
+            ASSERT(NUM_ALLOCS + 1 == TAX.numAllocations());
+
+            mX.release();
+            ASSERT(0 == TAX.numBytesInUse());
+
+            ASSERT(0 < TAY.numBytesInUse());
+            // Let 'mY' go out of scope.
+        }
+        ASSERT(0 == TAY.numBytesInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // DEALLOCATE TEST
+        //
+        // Concerns:
+        //: 1 Deallocated blocks are reused, most recently deallocated first,
+        //:   once the current chunk is exhausted.
+        //:
+        //: 2 Reusing deallocated blocks does not replenish the pool.
+        //:
+        //: 3 Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate all the blocks of a pool with a constant chunk size,
+        //:   deallocate them in order, reallocate them, and verify that they
+        //:   are returned in reverse order and that the number of allocations
+        //:   from the test allocator is unchanged.  (C-1..2)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null address.  (C-3)
+        //
+        // Testing:
+        //   void deallocate(address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "DEALLOCATE TEST" << endl
+                                  << "===============" << endl;
+
+        typedef bdlma::FixedPool<20> Obj;
+
+        enum { NUM_BLOCKS = 16 };
+
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            const bslma::TestAllocator& TA = ta;
+
+            Obj mX(CON, NUM_BLOCKS, &ta);
+
+            void *blocks[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate();
+            }
+            ASSERT(1 == TA.numAllocations());
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            for (int i = NUM_BLOCKS - 1; 0 <= i; --i) {
+                void *p = mX.allocate();
+                LOOP_ASSERT(i, blocks[i] == p);
+            }
+            ASSERT(1 == TA.numAllocations());
+
+            mX.allocate();
+            ASSERT(2 == TA.numAllocations());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(&ta);
+
+            ASSERT_SAFE_PASS(mX.deallocate(mX.allocate()));
+            ASSERT_SAFE_FAIL(mX.deallocate(0));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CTORS AND 'growthStrategy' TEST
+        //
+        // Concerns:
+        //: 1 The pool replenishes exactly when, and by as much as, a
+        //:   'bdlma::Pool' of the same block size configured with the same
+        //:   growth strategy and maximum blocks per chunk does.
+        //:
+        //: 2 The constructors taking fewer arguments use the default growth
+        //:   strategy and maximum blocks per chunk of 'bdlma::Pool'.
+        //:
+        //: 3 The pool uses the default allocator if none is supplied.
+        //:
+        //: 4 Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, for each block size, growth
+        //:   strategy, and maximum blocks per chunk, drive a
+        //:   'bdlma::FixedPool' and a 'bdlma::Pool' in lock step, and verify
+        //:   that they make the same number of allocations from their test
+        //:   allocators, and (for block sizes at which both pools space their
+        //:   blocks alike) that the pool requests exactly the memory of a
+        //:   'bdlma::Pool' less the chunk headers of the latter.  (C-1)
+        //:
+        //: 2 Repeat P-1 for the one- and two-argument constructors.  (C-2)
+        //:
+        //: 3 Install a test allocator as the default, and verify that it
+        //:   supplies the memory of a pool created without an allocator.
+        //:   (C-3)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a non-positive maximum blocks per chunk.  (C-4)
+        //
+        // Testing:
+        //   FixedPool(basicAllocator = 0);
+        //   FixedPool(gs, basicAllocator = 0);
+        //   FixedPool(gs, mbpc, basicAllocator = 0);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CTORS AND 'growthStrategy' TEST" << endl
+                                  << "===============================" << endl;
+
+        if (verbose) cout << "\nComparing with 'bdlma::Pool'." << endl;
+        {
+            static const struct {
+                int      d_line;
+                Strategy d_strategy;
+                int      d_maxBlocksPerChunk;
+            } DATA[] = {
+                // LINE     STRATEGY     MAXBLOCKS
+                // ----     --------     ---------
+                {  L_,          CON,             1 },
+                {  L_,          CON,            16 },
+                {  L_,          CON,            30 },
+                {  L_,          CON,            64 },
+                {  L_,          GEO,             1 },
+                {  L_,          GEO,            16 },
+                {  L_,          GEO,            31 },
+                {  L_,          GEO,            33 },
+                {  L_,          GEO,            48 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int      LINE      = DATA[ti].d_line;
+                const Strategy STRATEGY  = DATA[ti].d_strategy;
+                const int      MAXBLOCKS = DATA[ti].d_maxBlocksPerChunk;
+
+                testGrowth<1>(LINE, STRATEGY, MAXBLOCKS, veryVerbose);
+                testGrowth<5>(LINE, STRATEGY, MAXBLOCKS, veryVerbose);
+                testGrowth<8>(LINE, STRATEGY, MAXBLOCKS, veryVerbose);
+                testGrowth<24>(LINE, STRATEGY, MAXBLOCKS, veryVerbose);
+                testGrowth<100>(LINE, STRATEGY, MAXBLOCKS, veryVerbose);
+            }
+        }
+
+        if (verbose) cout << "\nTesting default arguments." << endl;
+        {
+            const int NUM_REQUESTS = 200;
+
+            bslma::TestAllocator taX(veryVeryVerbose);
+            bslma::TestAllocator taY(veryVeryVerbose);
+            bslma::TestAllocator taZ(veryVeryVerbose);
+            bslma::TestAllocator taW(veryVeryVerbose);
+
+            bdlma::FixedPool<24> mX(&taX);
+            bdlma::Pool          mY(24, &taY);
+            bdlma::FixedPool<24> mZ(CON, &taZ);
+            bdlma::Pool          mW(24, CON, &taW);
+
+            for (int i = 0; i < NUM_REQUESTS; ++i) {
+                mX.allocate();
+                mY.allocate();
+                mZ.allocate();
+                mW.allocate();
+
+                LOOP_ASSERT(i, taY.numAllocations() == taX.numAllocations());
+                LOOP_ASSERT(i, taW.numAllocations() == taZ.numAllocations());
+            }
+        }
+
+        if (verbose) cout << "\nTesting default allocator." << endl;
+        {
+            bslma::TestAllocator         da(veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            {
+                bdlma::FixedPool<16> mX;
+                bdlma::FixedPool<16> mY(GEO);
+                bdlma::FixedPool<16> mZ(CON, 4);
+
+                mX.allocate();
+                mY.allocate();
+                mZ.allocate();
+
+                ASSERT(3 == da.numBlocksInUse());
+            }
+            ASSERT(0 == da.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            typedef bdlma::FixedPool<8> Obj;
+
+            ASSERT_PASS(Obj(CON,  1));
+            ASSERT_FAIL(Obj(CON,  0));
+            ASSERT_FAIL(Obj(CON, -1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // BLOCK SIZE AND ALIGNMENT TEST
+        //
+        // Concerns:
+        //: 1 'blockSize' returns the 'BLOCK_SIZE' template parameter.
+        //:
+        //: 2 'alignment' returns the 'ALIGNMENT' template parameter if it is
+        //:   not 0, and the natural alignment of 'BLOCK_SIZE' otherwise.
+        //:
+        //: 3 Each block is aligned as 'alignment' indicates.
+        //:
+        //: 4 Consecutive blocks of a chunk are 'BLOCK_SIZE' apart, rounded up
+        //:   to the alignment (and to the size and alignment of a pointer).
+        //
+        // Plan:
+        //: 1 For a table of block sizes and alignments, allocate consecutive
+        //:   blocks and verify their alignment and the distances between
+        //:   them.  (C-1..4)
+        //
+        // Testing:
+        //   void *allocate();
+        //   int alignment() const;
+        //   int blockSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BLOCK SIZE AND ALIGNMENT TEST" << endl
+                                  << "=============================" << endl;
+
+        testBlocks<1, 0>(L_, veryVerbose);
+        testBlocks<1, 1>(L_, veryVerbose);
+        testBlocks<2, 0>(L_, veryVerbose);
+        testBlocks<3, 0>(L_, veryVerbose);
+        testBlocks<4, 0>(L_, veryVerbose);
+        testBlocks<5, 0>(L_, veryVerbose);
+        testBlocks<8, 0>(L_, veryVerbose);
+        testBlocks<8, 2>(L_, veryVerbose);
+        testBlocks<8, 8>(L_, veryVerbose);
+        testBlocks<12, 0>(L_, veryVerbose);
+        testBlocks<12, 4>(L_, veryVerbose);
+        testBlocks<16, 0>(L_, veryVerbose);
+        testBlocks<20, 0>(L_, veryVerbose);
+        testBlocks<24, 0>(L_, veryVerbose);
+        testBlocks<24, 8>(L_, veryVerbose);
+        testBlocks<24, bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT>(L_,
+                                                                 veryVerbose);
+        testBlocks<32, 0>(L_, veryVerbose);
+        testBlocks<33, 0>(L_, veryVerbose);
+        testBlocks<33, 1>(L_, veryVerbose);
+        testBlocks<64, 0>(L_, veryVerbose);
+        testBlocks<100, 4>(L_, veryVerbose);
+        testBlocks<1000, 0>(L_, veryVerbose);
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a pool, allocate, deallocate, and release blocks, and
+        //:   verify the memory in use by its test allocator.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        const bslma::TestAllocator& TA = ta;
+
+        {
+            typedef bdlma::FixedPool<32> Obj;
+
+            Obj mX(CON, 1, &ta);  const Obj& X = mX;
+
+            ASSERT(32 == X.blockSize());
+            ASSERT( 0 == TA.numBlocksInUse());
+
+            char *p = static_cast<char *>(mX.allocate());
+            ASSERT(1 == TA.numBlocksInUse());
+            ASSERT(0 == reinterpret_cast<bsls::Types::UintPtr>(p)
+                                                           % X.alignment());
+
+            char *q = static_cast<char *>(mX.allocate());
+            ASSERT(p != q);
+            ASSERT(2 == TA.numBlocksInUse());
+
+            mX.deallocate(q);
+            mX.deallocate(p);
+            ASSERT(p == mX.allocate());
+            ASSERT(q == mX.allocate());
+            ASSERT(2 == TA.numBlocksInUse());
+
+            mX.release();
+            ASSERT(0 == TA.numBlocksInUse());
+
+            mX.allocate();
+            ASSERT(1 == TA.numBlocksInUse());
+        }
+        ASSERT(0 == TA.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
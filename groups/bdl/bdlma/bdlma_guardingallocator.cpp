@@ -63,6 +63,12 @@ AfterUserBlockDeallocationData *getDataBlockAddress(void *address)
 // Assert that we can fit our struct into the available space.
 BSLMF_ASSERT(sizeof(AfterUserBlockDeallocationData) <= OFFSET * 2);
 
+// Define the number of slots in the first slab of pooled slots, and the
+// maximum number of slots in a slab.
+
+const bslma::Allocator::size_type INITIAL_SLAB_SLOTS =   4;
+const bslma::Allocator::size_type MAX_SLAB_SLOTS     = 256;
+
 // HELPER FUNCTIONS
 
 int getSystemPageSize()
@@ -197,9 +203,101 @@ namespace bdlma {
                         // class GuardingAllocator
                         // -----------------------
 
+// PRIVATE MANIPULATORS
+int GuardingAllocator::mapSlab()
+{
+    const int       pageSize = getSystemPageSize();
+    const size_type stride   = d_slotSize + pageSize;  // slot and next guard
+    const size_type numSlots = d_nextNumSlots;
+
+    // One header page, then a guard page followed by each slot in turn, and a
+    // final guard page.
+
+    const size_type totalSize = pageSize + pageSize + numSlots * stride;
+
+    char *firstPage = static_cast<char *>(systemAlloc(totalSize));
+
+    if (!firstPage) {
+        return -1;                                                    // RETURN
+    }
+
+    char *slots = firstPage + 2 * pageSize;
+
+    // Protect every guard page of the slab in one pass; they remain protected
+    // until the slab is unmapped.
+
+    for (size_type i = 0; i <= numSlots; ++i) {
+        if (0 != systemProtect(slots - pageSize + i * stride, pageSize)) {
+            systemFree(firstPage, totalSize);
+            return -1;                                                // RETURN
+        }
+    }
+
+    Slab *slab        = reinterpret_cast<Slab *>(firstPage);
+    slab->d_next_p    = d_slabs_p;
+    slab->d_slots_p   = slots;
+    slab->d_numSlots  = numSlots;
+    slab->d_size      = totalSize;
+    d_slabs_p         = slab;
+
+    // Add the slots to the free list so that they are dispensed in address
+    // order.
+
+    for (size_type i = numSlots; i > 0; --i) {
+        Link *link     = reinterpret_cast<Link *>(slots + (i - 1) * stride);
+        link->d_next_p = d_freeList_p;
+        d_freeList_p   = link;
+    }
+
+    if (d_nextNumSlots < MAX_SLAB_SLOTS) {
+        d_nextNumSlots *= 2;
+    }
+
+    return 0;
+}
+
+// PRIVATE ACCESSORS
+char *GuardingAllocator::findSlot(void *address) const
+{
+    const size_type  stride = d_slotSize + getSystemPageSize();
+    char            *p      = static_cast<char *>(address);
+
+    for (Slab *slab = d_slabs_p; slab; slab = slab->d_next_p) {
+        char *slots = slab->d_slots_p;
+
+        if (slots <= p && p < slots + slab->d_numSlots * stride) {
+            return slots + (p - slots) / stride * stride;             // RETURN
+        }
+    }
+
+    return 0;
+}
+
 // CREATORS
+GuardingAllocator::GuardingAllocator(GuardPageLocation guardLocation,
+                                     size_type         maxPooledSize)
+: d_guardPageLocation(guardLocation)
+, d_maxPooledSize(maxPooledSize)
+, d_slotSize(0)
+, d_nextNumSlots(INITIAL_SLAB_SLOTS)
+, d_freeList_p(0)
+, d_slabs_p(0)
+{
+    const size_type pageSize = getSystemPageSize();
+
+    const size_type paddedSize =
+                 bsls::AlignmentUtil::roundUpToMaximalAlignment(maxPooledSize);
+
+    d_slotSize = (paddedSize + pageSize - 1) / pageSize * pageSize;
+}
+
 GuardingAllocator::~GuardingAllocator()
 {
+    while (d_slabs_p) {
+        Slab *next = d_slabs_p->d_next_p;
+        systemFree(d_slabs_p, d_slabs_p->d_size);
+        d_slabs_p = next;
+    }
 }
 
 // MANIPULATORS
@@ -213,6 +311,36 @@ void *GuardingAllocator::allocate(size_type size)
     const size_type paddedSize =
                           bsls::AlignmentUtil::roundUpToMaximalAlignment(size);
 
+    if (size <= d_maxPooledSize) {
+        Link *slot;
+        {
+            bsls::BslLockGuard guard(&d_lock);
+
+            if (!d_freeList_p && 0 != mapSlab()) {
+                slot = 0;
+            }
+            else {
+                slot         = d_freeList_p;
+                d_freeList_p = slot->d_next_p;
+            }
+        }
+
+        if (!slot) {
+#ifdef BDE_BUILD_TARGET_EXC
+            BSLS_THROW(bsl::bad_alloc());
+#else
+            return 0;                                                 // RETURN
+#endif
+        }
+
+        // Place the block against the guard page before or after the slot.
+
+        return e_BEFORE_USER_BLOCK == d_guardPageLocation
+               ? static_cast<void *>(slot)
+               : reinterpret_cast<char *>(slot) + d_slotSize - paddedSize;
+                                                                      // RETURN
+    }
+
     // Adjust for additional memory needed to stash reference addresses when
     // 'e_AFTER_USER_BLOCK' is in use.
 
@@ -287,6 +415,19 @@ void GuardingAllocator::deallocate(void *address)
         return;                                                       // RETURN
     }
 
+    if (d_maxPooledSize) {
+        bsls::BslLockGuard guard(&d_lock);
+
+        char *slot = findSlot(address);
+
+        if (slot) {
+            Link *link     = reinterpret_cast<Link *>(slot);
+            link->d_next_p = d_freeList_p;
+            d_freeList_p   = link;
+            return;                                                   // RETURN
+        }
+    }
+
     const int pageSize = getSystemPageSize();
 
     void *firstPage;  // address of the first page of the allocation
@@ -20,6 +20,7 @@
 //  ( bdlma::GuardingAllocator )
 //   `------------------------'
 //               |         ctor/dtor
+//               |         maxPooledSize
 //               V
 //      ,----------------.
 //     ( bslma::Allocator )
@@ -30,7 +31,10 @@
 // *WARNING*: Note that this allocator should *not* be used for production use;
 // it is intended for debugging purposes only.  In particular, clients should
 // be aware that a multiple of the page size is allocated for *each* 'allocate'
-// invocation (unless the size of the request is 0).
+// invocation (unless the size of the request is 0).  The cost of the system
+// calls made by each invocation can be largely avoided by configuring the
+// allocator to use pooled slots (see {Pooled Guard Slots}), which is intended
+// for canary deployments where overflow detection must be left enabled.
 //
 // Also note that, unlike many other BDE allocators, a 'bslma::Allocator *'
 // cannot be (optionally) supplied upon construction of a counting allocator;
@@ -80,10 +84,44 @@
 //      ^                              ^
 //      A == G                         U == A + PS
 //..
+///Pooled Guard Slots
+///------------------
+// By default, every call to 'allocate' maps a new region of memory and
+// protects its guard page, and every call to 'deallocate' unprotects and
+// unmaps it; i.e., each allocation costs three system calls.  If a non-zero
+// 'maxPooledSize' is supplied at construction, requests of at most
+// 'maxPooledSize' bytes are instead satisfied from fixed-size *slots*, each
+// spanning the number of pages needed to hold 'maxPooledSize' bytes, that are
+// carved from larger *slabs* of memory mapped by the allocator.  Within a
+// slab, every slot is surrounded by guard pages, which are protected once,
+// in a single pass, when the slab is mapped:
+//..
+//  H  - header page of the slab (bookkeeping)
+//  G  - read/write protected guard page
+//  S  - data pages of a slot
+//
+//      -------------------------------------------------
+//      | H | G |  S  | G |  S  | G |  ...  | G |  S  | G |
+//      -------------------------------------------------
+//..
+// A deallocated slot is pushed onto a free list, with its guard pages left
+// protected, and is reused by a later request; no system call is made
+// unless a new slab must be mapped.  The number of slots per slab starts
+// small and doubles with each new slab up to an implementation-defined
+// limit.  The block returned from a slot is positioned against its guard
+// page after or before the slot according to the 'GuardPageLocation' supplied
+// at construction, exactly as for unpooled blocks.  Requests larger than
+// 'maxPooledSize' are handled as if pooling was not configured.
+//
+// Note that slots are reused most-recently-freed first, so pooling makes
+// accesses to deallocated memory less likely to be detected than when each
+// block is unmapped on deallocation.  Also note that slabs are unmapped only
+// when the allocator is destroyed.
+//
 ///Thread Safety
 ///-------------
 // The 'bdlma::GuardingAllocator' class is fully thread-safe (see
-// 'bsldoc_glossary').
+// 'bsldoc_glossary').  Pooled slots are managed under an internal lock.
 //
 ///Usage
 ///-----
@@ -283,6 +321,10 @@
 #include <bslma_allocator.h>
 #endif
 
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
 namespace BloombergLP {
 namespace bdlma {
 
@@ -314,12 +356,61 @@ class GuardingAllocator : public bslma::Allocator {
     };
 
   private:
+    // PRIVATE TYPES
+    struct Link {
+        // This 'struct' overlays the first bytes of a free pooled slot.
+
+        Link *d_next_p;  // next free slot
+    };
+
+    struct Slab {
+        // This 'struct' overlays the header page of a slab of pooled slots.
+
+        Slab      *d_next_p;    // next slab of this allocator
+        char      *d_slots_p;   // address of the first page of the first
+                                // slot
+        size_type  d_numSlots;  // number of slots in this slab
+        size_type  d_size;      // size (in bytes) of the mapping of this slab
+    };
+
     // DATA
-    GuardPageLocation d_guardPageLocation;  // if 'e_AFTER_USER_BLOCK', place
-                                            // the read/write protected guard
-                                            // page after the user block;
-                                            // otherwise, place it before the
-                                            // block ('e_BEFORE_USER_BLOCK')
+    GuardPageLocation     d_guardPageLocation;  // if 'e_AFTER_USER_BLOCK',
+                                                // place the read/write
+                                                // protected guard page after
+                                                // the user block; otherwise,
+                                                // place it before the block
+                                                // ('e_BEFORE_USER_BLOCK')
+
+    size_type             d_maxPooledSize;      // largest request satisfied
+                                                // from a pooled slot, or 0 if
+                                                // pooling is disabled
+
+    size_type             d_slotSize;           // size (in bytes) of the data
+                                                // pages of a slot
+
+    size_type             d_nextNumSlots;       // number of slots in the next
+                                                // slab to be mapped
+
+    Link                 *d_freeList_p;         // list of free slots
+
+    Slab                 *d_slabs_p;            // list of mapped slabs
+
+    mutable bsls::BslLock d_lock;               // guards pooled slots
+
+  private:
+    // PRIVATE MANIPULATORS
+    int mapSlab();
+        // Map a new slab of slots, protect its guard pages, and add its slots
+        // to the free list.  Return 0 on success, and a non-zero value (with
+        // no effect) otherwise.  The behavior is undefined unless the
+        // internal lock is held by the calling thread.
+
+    // PRIVATE ACCESSORS
+    char *findSlot(void *address) const;
+        // Return the address of the first page of the pooled slot containing
+        // the specified 'address', or 0 if 'address' does not lie within a
+        // slab of this allocator.  The behavior is undefined unless the
+        // internal lock is held by the calling thread.
 
   private:
     // NOT IMPLEMENTED
@@ -336,9 +427,19 @@ class GuardingAllocator : public bslma::Allocator {
         // If 'guardLocation' is not specified, guard pages are placed
         // immediately following the memory blocks returned by 'allocate'.
 
+    GuardingAllocator(GuardPageLocation guardLocation,
+                      size_type         maxPooledSize);
+        // Create a guarding allocator that places read/write protected guard
+        // pages at the specified 'guardLocation' with respect to the memory
+        // blocks returned by the 'allocate' method, and that satisfies each
+        // request of at most the specified 'maxPooledSize' bytes from a
+        // recycled slot of pre-mapped, pre-guarded pages (see {Pooled Guard
+        // Slots}).  If 'maxPooledSize' is 0, no slots are pooled.
+
     virtual ~GuardingAllocator();
-        // Destroy this allocator object.  Note that destroying this allocator
-        // has no effect on any outstanding allocated memory.
+        // Destroy this allocator object, unmapping all slabs of pooled slots.
+        // Note that destroying this allocator has no effect on outstanding
+        // memory blocks that were not allocated from pooled slots.
 
     // MANIPULATORS
     virtual void *allocate(size_type size);
@@ -346,16 +447,26 @@ class GuardingAllocator : public bslma::Allocator {
         // specified 'size' (in bytes) that has a read/write protected guard
         // page located immediately before or after it according to the
         // 'GuardPageLocation' indicated at construction.  If 'size' is 0, no
-        // memory is allocated and 0 is returned.  Note that a multiple of the
-        // platform's memory page size is allocated for *every* call to this
-        // method.
+        // memory is allocated and 0 is returned.  If
+        // 'size <= maxPooledSize()', the block is taken from a free pooled
+        // slot, mapping a new slab of slots if none is free.  Note that
+        // otherwise a multiple of the platform's memory page size is
+        // allocated for *every* call to this method.
 
     virtual void deallocate(void *address);
         // Return the memory block at the specified 'address' back to this
-        // allocator.  If 'address' is 0, this method has no effect.
-        // Otherwise, the guard page associated with 'address' is unprotected
-        // and also deallocated.  The behavior is undefined unless 'address'
-        // was returned by 'allocate' and has not already been deallocated.
+        // allocator.  If 'address' is 0, this method has no effect.  If
+        // 'address' lies in a pooled slot, the slot is made available for
+        // reuse, leaving its guard pages protected.  Otherwise, the guard page
+        // associated with 'address' is unprotected and also deallocated.  The
+        // behavior is undefined unless 'address' was returned by 'allocate'
+        // and has not already been deallocated.
+
+    // ACCESSORS
+    size_type maxPooledSize() const;
+        // Return the size (in bytes) of the largest request that this
+        // allocator satisfies from a pooled slot, or 0 if slots are not
+        // pooled.
 };
 
 // ============================================================================
@@ -370,7 +481,19 @@ class GuardingAllocator : public bslma::Allocator {
 inline
 GuardingAllocator::GuardingAllocator(GuardPageLocation guardLocation)
 : d_guardPageLocation(guardLocation)
+, d_maxPooledSize(0)
+, d_slotSize(0)
+, d_nextNumSlots(0)
+, d_freeList_p(0)
+, d_slabs_p(0)
+{
+}
+
+// ACCESSORS
+inline
+bslma::Allocator::size_type GuardingAllocator::maxPooledSize() const
 {
+    return d_maxPooledSize;
 }
 
 }  // close package namespace
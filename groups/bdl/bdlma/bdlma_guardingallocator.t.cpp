@@ -47,16 +47,21 @@ using namespace bsl;
 // ----------------------------------------------------------------------------
 // CREATORS
 // [ 2] GuardingAllocator(GuardPageLocation loc = e_AFTER_USER_BLOCK);
+// [ 5] GuardingAllocator(GuardPageLocation loc, size_type maxPooledSize);
 // [ 2] ~GuardingAllocator();
 //
 // MANIPULATORS
 // [ 3] void *allocate(size_type size);
 // [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 5] size_type maxPooledSize() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 5] USAGE EXAMPLE
+// [ 6] USAGE EXAMPLE
 // [ *] CONCERN: In no case does memory come from the global allocator.
 // [ 4] CONCERN: The 'allocate' and 'deallocate' methods are thread-safe.
+// [ 5] CONCERN: Pooled slots are recycled with their guard pages intact.
 
 // ============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -690,7 +695,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 5: {
+      case 6: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -797,6 +802,209 @@ int main(int argc, char *argv[])
 // issue when analyzed in a debugger.
 
       } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // POOLED GUARD SLOTS
+        //   Ensure that an allocator configured with a 'maxPooledSize'
+        //   satisfies small requests from recycled, pre-guarded slots.
+        //
+        // Concerns:
+        //: 1 'maxPooledSize' returns the value supplied at construction, and 0
+        //:   for an allocator constructed without one.
+        //:
+        //: 2 Blocks from pooled slots are distinct, maximally aligned, of at
+        //:   least the requested size, and positioned against a
+        //:   write-protected guard page as indicated by the
+        //:   'GuardPageLocation'.
+        //:
+        //: 3 Both pages adjoining a slot are write-protected.
+        //:
+        //: 4 A deallocated slot is reused by a later request, and its guard
+        //:   pages remain write-protected.
+        //:
+        //: 5 Requests larger than 'maxPooledSize' are not pooled, and still
+        //:   have a write-protected guard page.
+        //:
+        //: 6 Pooled allocation and deallocation are thread-safe.
+        //:
+        //: 7 There is no allocation from either the default or global
+        //:   allocators.
+        //
+        // Plan:
+        //: 1 Construct allocators with and without a 'maxPooledSize', and
+        //:   verify the value returned by 'maxPooledSize'.  (C-1)
+        //:
+        //: 2 For each 'GuardPageLocation' and for a 'maxPooledSize' of one
+        //:   byte and of more than one page, allocate enough blocks of varying
+        //:   pooled sizes to require several slabs.  Verify the alignment of
+        //:   each block, overwrite it, and verify that both pages adjoining
+        //:   its slot fault when written.  (C-2..3)
+        //:
+        //: 3 Deallocate every block, allocate the same number again, and
+        //:   verify that every new block lies in a slot from P-2, and that its
+        //:   guard pages are still write-protected.  (C-4)
+        //:
+        //: 4 Allocate a block larger than 'maxPooledSize' and verify that its
+        //:   guard page is write-protected.  (C-5)
+        //:
+        //: 5 Run the thread functions of case 4 against pooling allocators.
+        //:   (C-6)
+        //:
+        //: 6 Verify that the default allocator is not used.  (C-7)
+        //
+        // Testing:
+        //   GuardingAllocator(GuardPageLocation loc, size_type maxPooledSize);
+        //   size_type maxPooledSize() const;
+        //   CONCERN: Pooled slots are recycled with their guard pages intact.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "POOLED GUARD SLOTS" << endl
+                          << "==================" << endl;
+
+        bslma::TestAllocator da("default", veryVeryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX;  const Obj& X = mX;
+            ASSERT(0 == X.maxPooledSize());
+
+            Obj mY(Obj::e_BEFORE_USER_BLOCK, 100);  const Obj& Y = mY;
+            ASSERT(100 == Y.maxPooledSize());
+
+            Obj mZ(Obj::e_AFTER_USER_BLOCK, 0);  const Obj& Z = mZ;
+            ASSERT(0 == Z.maxPooledSize());
+
+            void *p = mZ.allocate(1);
+            assertGuardPageIsProtected(p, Obj::e_AFTER_USER_BLOCK, pageSize);
+            mZ.deallocate(p);
+        }
+
+        const int MAX_SIZES[] = { 1, pageSize + 100 };
+        const int NUM_MAX_SIZES = sizeof MAX_SIZES / sizeof *MAX_SIZES;
+
+        for (char cfg = 'a'; cfg <= 'b'; ++cfg) {
+            const Enum LOC = 'a' == cfg ? Obj::e_AFTER_USER_BLOCK
+                                        : Obj::e_BEFORE_USER_BLOCK;
+
+            for (int mi = 0; mi < NUM_MAX_SIZES; ++mi) {
+                const int MAX = MAX_SIZES[mi];
+
+                // White-box: the data pages of a slot.
+
+                const int SLOT_SIZE =
+                     (static_cast<int>(bsls::AlignmentUtil::
+                                                roundUpToMaximalAlignment(MAX))
+                                     + pageSize - 1) / pageSize * pageSize;
+
+                if (veryVerbose) { P_(cfg) P_(MAX) P(SLOT_SIZE) }
+
+                Obj mX(LOC, MAX);
+
+                enum { NUM = 40 };  // requires several slabs
+
+                char *p[NUM];
+                char *slot[NUM];
+
+                for (int i = 0; i < NUM; ++i) {
+                    const int SIZE = 1 + (i * 37) % MAX;
+
+                    p[i] = static_cast<char *>(mX.allocate(SIZE));
+                    LOOP3_ASSERT(cfg, MAX, i, p[i]);
+
+                    typedef bsls::AlignmentUtil U;
+                    LOOP3_ASSERT(cfg, MAX, i,
+                                 0 == U::calculateAlignmentOffset(
+                                                       p[i],
+                                                       U::BSLS_MAX_ALIGNMENT));
+
+                    bsl::memset(p[i], 0xff, SIZE);
+
+                    slot[i] = Obj::e_BEFORE_USER_BLOCK == LOC
+                            ? p[i]
+                            : p[i] + U::roundUpToMaximalAlignment(SIZE)
+                                                                 - SLOT_SIZE;
+
+                    LOOP3_ASSERT(cfg, MAX, i,
+                                 causesMemoryFault(slot[i], -1, 'x'));
+                    LOOP3_ASSERT(cfg, MAX, i,
+                                 causesMemoryFault(slot[i] - pageSize, 0,
+                                                   'x'));
+                    LOOP3_ASSERT(cfg, MAX, i,
+                                 causesMemoryFault(slot[i], SLOT_SIZE, 'x'));
+                    LOOP3_ASSERT(cfg, MAX, i,
+                                 causesMemoryFault(slot[i],
+                                                   SLOT_SIZE + pageSize - 1,
+                                                   'x'));
+
+                    for (int j = 0; j < i; ++j) {
+                        LOOP4_ASSERT(cfg, MAX, i, j, slot[i] != slot[j]);
+                    }
+                }
+
+                for (int i = 0; i < NUM; ++i) {
+                    mX.deallocate(p[i]);
+                }
+
+                for (int i = 0; i < NUM; ++i) {
+                    const int SIZE = 1 + (i * 53) % MAX;
+
+                    char *q = static_cast<char *>(mX.allocate(SIZE));
+                    bsl::memset(q, 0xaa, SIZE);
+
+                    char *s = Obj::e_BEFORE_USER_BLOCK == LOC
+                            ? q
+                            : q + bsls::AlignmentUtil::
+                                            roundUpToMaximalAlignment(SIZE)
+                                                                 - SLOT_SIZE;
+
+                    bool found = false;
+                    for (int j = 0; j < NUM; ++j) {
+                        found = found || s == slot[j];
+                    }
+                    LOOP3_ASSERT(cfg, MAX, i, found);
+
+                    LOOP3_ASSERT(cfg, MAX, i, causesMemoryFault(s, -1, 'x'));
+                    LOOP3_ASSERT(cfg, MAX, i,
+                                 causesMemoryFault(s, SLOT_SIZE, 'x'));
+
+                    p[i] = q;
+                }
+
+                char *large = static_cast<char *>(mX.allocate(MAX + 1));
+                bsl::memset(large, 0xff, MAX + 1);
+                assertGuardPageIsProtected(large, LOC, pageSize);
+                mX.deallocate(large);
+
+                for (int i = 0; i < NUM; ++i) {
+                    mX.deallocate(p[i]);
+                }
+            }
+        }
+
+        if (verbose) cout << "\nConcurrency." << endl;
+        {
+            using namespace TestCase4;
+
+            Obj mX(Obj::e_AFTER_USER_BLOCK,  2 * pageSize);
+            Obj mY(Obj::e_BEFORE_USER_BLOCK, 2 * pageSize);
+
+            ThreadInfo info = { 100, &mX, &mY };
+
+            for (int ti = 0; ti < 10; ++ti) {
+                ThreadId id1 = createThread(&threadFunction1, &info);
+                ThreadId id2 = createThread(&threadFunction2, &info);
+                ThreadId id3 = createThread(&threadFunction3, &info);
+
+                joinThread(id1);
+                joinThread(id2);
+                joinThread(id3);
+            }
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
       case 4: {
         // --------------------------------------------------------------------
         // CONCURRENCY
@@ -0,0 +1,290 @@
+// bdlma_headerlessmultipool.cpp                                      -*-C++-*-
+#include <bdlma_headerlessmultipool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_headerlessmultipool_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bsl_cstring.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+// TYPES
+typedef bsls::Types::UintPtr UintPtr;
+
+enum {
+    DEFAULT_NUM_POOLS   = 10,         // default number of size classes
+
+    MIN_BLOCK_SIZE      =  8,         // minimum block size (in bytes)
+
+    MAX_NUM_POOLS       = 24,         // maximum number of size classes
+
+    MIN_PAGE_SHIFT      = 14,         // log2 of the minimum page size
+
+    MIN_BLOCKS_PER_PAGE =  4,         // minimum number of blocks of the
+                                      // largest size class per page
+
+    INITIAL_ARENA_PAGES =  4,         // number of pages in the first arena
+
+    MAX_ARENA_SIZE      = 512 * 1024,
+                                      // size (in bytes) beyond which arenas
+                                      // stop growing
+
+    INITIAL_MAP_SHIFT   =  6          // log2 of the initial capacity of the
+                                      // page hash table
+};
+
+                         // -------------------------
+                         // class HeaderlessMultipool
+                         // -------------------------
+
+// PRIVATE MANIPULATORS
+void HeaderlessMultipool::addPage(int poolIdx)
+{
+    BSLS_ASSERT(0 <= poolIdx);
+    BSLS_ASSERT(poolIdx < d_numPools);
+
+    const UintPtr pageSize = static_cast<UintPtr>(1) << d_pageShift;
+
+    if (d_nextPage_p == d_endPage_p) {
+
+        // Allocate a new arena with enough slack to align its first page.
+
+        char *arena = static_cast<char *>(
+                        d_arenaList.allocate((d_arenaPages + 1) * pageSize));
+        UintPtr first = (reinterpret_cast<UintPtr>(arena) + pageSize - 1)
+                                                           & ~(pageSize - 1);
+
+        d_nextPage_p = reinterpret_cast<char *>(first);
+        d_endPage_p  = d_nextPage_p + d_arenaPages * pageSize;
+
+        if (d_arenaPages * pageSize < MAX_ARENA_SIZE) {
+            d_arenaPages *= 2;
+        }
+    }
+
+    if (2 * (d_mapSize + 1) > (1 << d_mapShift)) {
+        growMap();
+    }
+
+    char *page    = d_nextPage_p;
+    d_nextPage_p += pageSize;
+
+    // Record the owner of the page.
+
+    const UintPtr number = reinterpret_cast<UintPtr>(page) >> d_pageShift;
+    const UintPtr mask   = (static_cast<UintPtr>(1) << d_mapShift) - 1;
+
+    UintPtr i = hash(number, d_mapShift);
+    while (0 != d_map_p[i].d_page) {
+        i = (i + 1) & mask;
+    }
+    d_map_p[i].d_page    = number;
+    d_map_p[i].d_poolIdx = poolIdx;
+    ++d_mapSize;
+
+    // Move the blocks remaining in the current page to the free list.
+
+    SizeClass& sc = d_classes_p[poolIdx];
+
+    while (sc.d_begin_p != sc.d_end_p) {
+        Link *link      = reinterpret_cast<Link *>(sc.d_begin_p);
+        link->d_next_p  = sc.d_freeList_p;
+        sc.d_freeList_p = link;
+        sc.d_begin_p   += sc.d_blockSize;
+    }
+
+    sc.d_begin_p = page;
+    sc.d_end_p   = page + pageSize;
+}
+
+void HeaderlessMultipool::growMap()
+{
+    const int newShift    = d_mapShift + 1;
+    const int newCapacity = 1 << newShift;
+
+    PageEntry *newMap = static_cast<PageEntry *>(
+                        d_allocator_p->allocate(newCapacity * sizeof *newMap));
+    bsl::memset(newMap, 0, newCapacity * sizeof *newMap);
+
+    const UintPtr mask = static_cast<UintPtr>(newCapacity) - 1;
+
+    for (int j = 0; j < (1 << d_mapShift); ++j) {
+        if (0 != d_map_p[j].d_page) {
+            UintPtr i = hash(d_map_p[j].d_page, newShift);
+            while (0 != newMap[i].d_page) {
+                i = (i + 1) & mask;
+            }
+            newMap[i] = d_map_p[j];
+        }
+    }
+
+    d_allocator_p->deallocate(d_map_p);
+    d_map_p    = newMap;
+    d_mapShift = newShift;
+}
+
+void HeaderlessMultipool::initialize()
+{
+    BSLS_ASSERT(1 <= d_numPools);
+    BSLS_ASSERT(d_numPools <= MAX_NUM_POOLS);
+
+    d_maxBlockSize = MIN_BLOCK_SIZE << (d_numPools - 1);
+
+    // Each page holds at least 'MIN_BLOCKS_PER_PAGE' blocks of the largest
+    // size class.
+
+    d_pageShift = MIN_PAGE_SHIFT;
+    while ((1 << d_pageShift) < MIN_BLOCKS_PER_PAGE * d_maxBlockSize) {
+        ++d_pageShift;
+    }
+
+    d_arenaPages = INITIAL_ARENA_PAGES;
+    while (1 < d_arenaPages
+        && (static_cast<UintPtr>(d_arenaPages) << d_pageShift)
+                                                            > MAX_ARENA_SIZE) {
+        d_arenaPages /= 2;
+    }
+
+    d_classes_p = static_cast<SizeClass *>(
+                  d_allocator_p->allocate(d_numPools * sizeof *d_classes_p));
+
+    for (int i = 0; i < d_numPools; ++i) {
+        d_classes_p[i].d_freeList_p = 0;
+        d_classes_p[i].d_begin_p    = 0;
+        d_classes_p[i].d_end_p      = 0;
+        d_classes_p[i].d_blockSize  = MIN_BLOCK_SIZE << i;
+    }
+
+    d_mapShift = INITIAL_MAP_SHIFT;
+
+    const int capacity = 1 << d_mapShift;
+
+    d_map_p = static_cast<PageEntry *>(
+                          d_allocator_p->allocate(capacity * sizeof *d_map_p));
+    bsl::memset(d_map_p, 0, capacity * sizeof *d_map_p);
+}
+
+void *HeaderlessMultipool::replenish(int poolIdx)
+{
+    BSLS_ASSERT(0 <= poolIdx);
+    BSLS_ASSERT(poolIdx < d_numPools);
+
+    addPage(poolIdx);
+
+    SizeClass& sc = d_classes_p[poolIdx];
+
+    char *p = sc.d_begin_p;
+    sc.d_begin_p += sc.d_blockSize;
+    return p;
+}
+
+// CREATORS
+HeaderlessMultipool::HeaderlessMultipool(bslma::Allocator *basicAllocator)
+: d_classes_p(0)
+, d_numPools(DEFAULT_NUM_POOLS)
+, d_nextPage_p(0)
+, d_endPage_p(0)
+, d_map_p(0)
+, d_mapSize(0)
+, d_arenaList(basicAllocator)
+, d_blockList(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize();
+}
+
+HeaderlessMultipool::HeaderlessMultipool(int               numPools,
+                                         bslma::Allocator *basicAllocator)
+: d_classes_p(0)
+, d_numPools(numPools)
+, d_nextPage_p(0)
+, d_endPage_p(0)
+, d_map_p(0)
+, d_mapSize(0)
+, d_arenaList(basicAllocator)
+, d_blockList(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numPools);
+    BSLS_ASSERT(numPools <= MAX_NUM_POOLS);
+
+    initialize();
+}
+
+HeaderlessMultipool::~HeaderlessMultipool()
+{
+    BSLS_ASSERT(d_classes_p);
+    BSLS_ASSERT(d_map_p);
+    BSLS_ASSERT(d_allocator_p);
+
+    d_blockList.release();
+    d_arenaList.release();
+
+    d_allocator_p->deallocate(d_map_p);
+    d_allocator_p->deallocate(d_classes_p);
+}
+
+// MANIPULATORS
+void HeaderlessMultipool::release()
+{
+    d_blockList.release();
+    d_arenaList.release();
+
+    for (int i = 0; i < d_numPools; ++i) {
+        d_classes_p[i].d_freeList_p = 0;
+        d_classes_p[i].d_begin_p    = 0;
+        d_classes_p[i].d_end_p      = 0;
+    }
+
+    d_nextPage_p = 0;
+    d_endPage_p  = 0;
+
+    bsl::memset(d_map_p, 0, (1 << d_mapShift) * sizeof *d_map_p);
+    d_mapSize = 0;
+}
+
+void HeaderlessMultipool::reserveCapacity(int size, int numBlocks)
+{
+    BSLS_ASSERT(1    <= size);
+    BSLS_ASSERT(size <= d_maxBlockSize);
+    BSLS_ASSERT(0    <= numBlocks);
+
+    const int  pool = findPool(size);
+    SizeClass& sc   = d_classes_p[pool];
+
+    for (Link *p = sc.d_freeList_p; p && 0 < numBlocks; p = p->d_next_p) {
+        --numBlocks;
+    }
+
+    numBlocks -= static_cast<int>((sc.d_end_p - sc.d_begin_p)
+                                                             / sc.d_blockSize);
+
+    const int blocksPerPage = (1 << d_pageShift) / sc.d_blockSize;
+
+    while (0 < numBlocks) {
+        addPage(pool);
+        numBlocks -= blocksPerPage;
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,593 @@
+// bdlma_headerlessmultipool.h                                        -*-C++-*-
+#ifndef INCLUDED_BDLMA_HEADERLESSMULTIPOOL
+#define INCLUDED_BDLMA_HEADERLESSMULTIPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a multipool that stores no per-block header.
+//
+//@CLASSES:
+//  bdlma::HeaderlessMultipool: multipool locating pools by block address
+//
+//@SEE_ALSO: bdlma_multipool, bdlma_pool
+//
+//@DESCRIPTION: This component implements a memory manager,
+// 'bdlma::HeaderlessMultipool', that dispenses memory blocks of varying sizes
+// from a configurable number of size classes, in the same manner as
+// 'bdlma::Multipool', but without storing any per-block header.  Each size
+// class manages memory blocks of a unique size, starting at 8 bytes, with
+// each successive class managing blocks of a size twice that of the previous
+// class.  Each allocation (deallocation) request allocates memory from
+// (returns memory to) the size class managing memory blocks of the smallest
+// size not less than the requested size, or else from a separately managed
+// list of memory blocks, if no size class managing memory blocks of
+// sufficient size exists.  Both the 'release' method and the destructor of a
+// 'bdlma::HeaderlessMultipool' release all memory currently allocated via the
+// object.
+//
+///Locating the Size Class of a Block
+///----------------------------------
+// 'bdlma::Multipool' precedes every block with a maximally-aligned header
+// recording the index of the pool that dispensed it, so that 'deallocate' can
+// return the block to that pool.  On most platforms the header occupies 16
+// bytes, doubling the footprint of a 16-byte node and placing consecutive
+// nodes further apart in memory.
+//
+// 'bdlma::HeaderlessMultipool' instead obtains memory from the underlying
+// allocator in large "arenas", which it divides into "pages" of a fixed size
+// (a power of 2, at least 16 KiB) aligned on a multiple of that size.  Each
+// page is assigned to exactly one size class, and is divided into blocks of
+// that class's size with no space between them.  The size class of each page
+// is recorded in a hash table keyed by page number (i.e., the address of the
+// page divided by the page size).  'deallocate' computes the page number of a
+// block from its address and looks it up in the table; a block whose page is
+// not in the table was allocated from the separately managed list of large
+// blocks.  Both the arenas and the table are released only by 'release' and
+// the destructor.
+//
+// As every page is aligned to the page size, and every block within it is at
+// an offset that is a multiple of its block size, each block is aligned to
+// its size (up to the page size).  In particular, every block of 16 or more
+// bytes is maximally aligned on all supported platforms.  The requested size
+// is rounded up to a multiple of 8, so blocks of the smallest size class are
+// aligned to 8 bytes.
+//
+// The price of omitting the header is that 'deallocate' performs a hash-table
+// probe rather than a single load from the block's header, and that each size
+// class in use holds at least one (partially used) page.  Applications that
+// allocate very few blocks from a multipool should prefer 'bdlma::Multipool'.
+// Clients that know the size of the block being returned can avoid the probe
+// entirely by calling 'deallocate(address, size)'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Storing Small List Nodes Compactly
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we maintain a singly-linked list of integers, whose 16-byte
+// nodes (on 64-bit platforms) are allocated from a multipool.  With a
+// 'bdlma::Multipool', each node would occupy 32 bytes including its header;
+// using a 'bdlma::HeaderlessMultipool', each node occupies exactly 16 bytes.
+//
+// First, we define the node type:
+//..
+//  struct Node {
+//      Node *d_next_p;
+//      int   d_value;
+//  };
+//..
+// Then, we create a multipool, and allocate a list of nodes from it:
+//..
+//  bdlma::HeaderlessMultipool multipool;
+//
+//  Node *head = 0;
+//  for (int i = 0; i < 100; ++i) {
+//      Node *node = static_cast<Node *>(multipool.allocate(sizeof(Node)));
+//      node->d_next_p = head;
+//      node->d_value  = i;
+//      head = node;
+//  }
+//..
+// Next, we observe that nodes allocated consecutively are adjacent in memory,
+// as no header separates them:
+//..
+//  const char *first  = reinterpret_cast<const char *>(head->d_next_p);
+//  const char *second = reinterpret_cast<const char *>(head);
+//  assert(sizeof(Node) == second - first);
+//..
+// Finally, we return the nodes to the multipool, one by one:
+//..
+//  while (head) {
+//      Node *next = head->d_next_p;
+//      multipool.deallocate(head);
+//      head = next;
+//  }
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_INFREQUENTDELETEBLOCKLIST
+#include <bdlma_infrequentdeleteblocklist.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                         // =========================
+                         // class HeaderlessMultipool
+                         // =========================
+
+class HeaderlessMultipool {
+    // This class implements a memory manager that dispenses memory blocks
+    // from a configurable number of size classes, each managing blocks of a
+    // unique size, with each successive class managing blocks of size twice
+    // that of the previous class.  Blocks carry no header: the size class of
+    // a block is found from its address, by looking up the (aligned) page
+    // containing it.  Requests larger than the largest size class are
+    // satisfied from a separately managed list of memory blocks.  Both the
+    // 'release' method and the destructor of a 'bdlma::HeaderlessMultipool'
+    // release all memory currently allocated via the object.
+
+    // PRIVATE TYPES
+    struct Link {
+        // This 'struct' implements a link data structure that stores the
+        // address of the next link, and is used to implement the internal
+        // linked list of free memory blocks of a size class.
+
+        Link *d_next_p;  // pointer to next link
+    };
+
+    struct SizeClass {
+        // This 'struct' holds the state of one size class: a list of free
+        // blocks and the unused remainder of the page most recently assigned
+        // to the class.
+
+        Link *d_freeList_p;  // linked list of free memory blocks
+
+        char *d_begin_p;     // start of unused portion of the current page
+
+        char *d_end_p;       // end of the current page
+
+        int   d_blockSize;   // size (in bytes) of each block of this class
+    };
+
+    struct PageEntry {
+        // This 'struct' is an entry of the open-addressing hash table that
+        // maps the number of a page to the index of the size class that owns
+        // it.  An entry whose page number is 0 is empty.
+
+        bsls::Types::UintPtr d_page;     // address of the page divided by the
+                                         // page size
+
+        int                  d_poolIdx;  // index of the owning size class
+    };
+
+    // DATA
+    SizeClass                 *d_classes_p;     // array of size classes
+
+    int                        d_numPools;      // number of size classes
+
+    int                        d_maxBlockSize;  // block size of the largest
+                                                // size class; always a power
+                                                // of 2
+
+    int                        d_pageShift;     // log2 of the page size
+
+    char                      *d_nextPage_p;    // next unassigned page of the
+                                                // current arena
+
+    char                      *d_endPage_p;     // end of the assignable pages
+                                                // of the current arena
+
+    int                        d_arenaPages;    // number of pages in the next
+                                                // arena to be allocated
+
+    PageEntry                 *d_map_p;         // hash table of assigned
+                                                // pages
+
+    int                        d_mapShift;      // log2 of the capacity of
+                                                // 'd_map_p'
+
+    int                        d_mapSize;       // number of non-empty entries
+                                                // in 'd_map_p'
+
+    InfrequentDeleteBlockList  d_arenaList;     // memory manager for arenas
+
+    BlockList                  d_blockList;     // memory manager for "large"
+                                                // memory blocks
+
+    bslma::Allocator          *d_allocator_p;   // holds (but does not own)
+                                                // allocator
+
+  private:
+    // PRIVATE CLASS METHODS
+    static bsls::Types::UintPtr hash(bsls::Types::UintPtr page, int shift);
+        // Return the index, in a hash table having '2^shift' entries, of the
+        // first entry to probe for the specified 'page'.
+
+    // PRIVATE MANIPULATORS
+    void addPage(int poolIdx);
+        // Assign a new page to the size class at the specified 'poolIdx',
+        // adding any blocks remaining in its current page to its free list.
+
+    void growMap();
+        // Double the capacity of the page hash table.
+
+    void initialize();
+        // Initialize the size classes, page size, and page hash table of this
+        // object.
+
+    void *replenish(int poolIdx);
+        // Assign a new page to the size class at the specified 'poolIdx', and
+        // return the address of a block from that page.
+
+    // PRIVATE ACCESSORS
+    int findPool(int size) const;
+        // Return the index of the size class in this multipool for an
+        // allocation request of the specified 'size' (in bytes).  The
+        // behavior is undefined unless '0 <= size <= maxPooledBlockSize()'.
+
+    int lookupPool(const void *address) const;
+        // Return the index of the size class owning the page containing the
+        // specified 'address', or -1 if no size class owns that page.
+
+  private:
+    // NOT IMPLEMENTED
+    HeaderlessMultipool(const HeaderlessMultipool&);
+    HeaderlessMultipool& operator=(const HeaderlessMultipool&);
+
+  public:
+    // CREATORS
+    explicit
+    HeaderlessMultipool(bslma::Allocator *basicAllocator = 0);
+    explicit
+    HeaderlessMultipool(int numPools, bslma::Allocator *basicAllocator = 0);
+        // Create a headerless multipool memory manager.  Optionally specify
+        // 'numPools', indicating the number of size classes; the block size
+        // of the first class is 8 bytes, with the block size of each
+        // additional class successively doubling.  If 'numPools' is not
+        // specified, an implementation-defined number of classes 'N' --
+        // covering memory blocks ranging in size from '2^3 = 8' to '2^(N+2)'
+        // -- is used.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '1 <= numPools <= 24'.
+
+    ~HeaderlessMultipool();
+        // Destroy this multipool.  All memory allocated from this multipool
+        // is released.
+
+    // MANIPULATORS
+    void *allocate(int size);
+        // Return the address of a contiguous block of memory of (at least)
+        // the specified 'size' (in bytes).  If 'size <= maxPooledBlockSize()',
+        // the block is naturally aligned for its rounded-up size (see
+        // {Locating the Size Class of a Block}); otherwise, the block is
+        // maximally aligned, and its allocation is managed directly by the
+        // underlying allocator, and will not be pooled, but will be
+        // deallocated when the 'release' method is called, or when this
+        // object is destroyed.  The behavior is undefined unless '1 <= size'.
+
+    void deallocate(void *address);
+        // Relinquish the memory block at the specified 'address' back to this
+        // multipool object for reuse.  The behavior is undefined unless
+        // 'address' is non-zero, was allocated by this multipool object, and
+        // has not already been deallocated.
+
+    void deallocate(void *address, int size);
+        // Relinquish the memory block at the specified 'address', which was
+        // obtained by a call to 'allocate' with the specified 'size', back to
+        // this multipool object for reuse.  The owning size class is computed
+        // from 'size', so the page map is not consulted.  The behavior is
+        // undefined unless 'address' is non-zero, was allocated by this
+        // multipool object by a call to 'allocate(size)', and has not already
+        // been deallocated.
+
+    template <class TYPE>
+    void deleteObject(const TYPE *object);
+        // Destroy the specified 'object' based on its dynamic type and then
+        // use this multipool object to deallocate its memory footprint.  This
+        // method has no effect if 'object' is 0.  The behavior is undefined
+        // unless 'object', when cast appropriately to 'void *', was allocated
+        // using this multipool object and has not already been deallocated.
+        // Note that 'dynamic_cast<void *>(object)' is applied if 'TYPE' is
+        // polymorphic, and 'static_cast<void *>(object)' is applied otherwise.
+
+    template <class TYPE>
+    void deleteObjectRaw(const TYPE *object);
+        // Destroy the specified 'object' and then use this multipool to
+        // deallocate its memory footprint.  This method has no effect if
+        // 'object' is 0.  The behavior is undefined unless 'object' is !not! a
+        // secondary base class pointer (i.e., the address is (numerically) the
+        // same as when it was originally dispensed by this multipool), was
+        // allocated using this multipool, and has not already been
+        // deallocated.
+
+    void release();
+        // Relinquish all memory currently allocated via this multipool object.
+
+    void reserveCapacity(int size, int numBlocks);
+        // Reserve memory from this multipool to satisfy memory requests for at
+        // least the specified 'numBlocks' having the specified 'size' (in
+        // bytes) before the size class replenishes.  The behavior is
+        // undefined unless '1 <= size <= maxPooledBlockSize()' and
+        // '0 <= numBlocks'.
+
+    // ACCESSORS
+    int numPools() const;
+        // Return the number of size classes managed by this multipool object.
+
+    int maxPooledBlockSize() const;
+        // Return the maximum size of memory blocks that are pooled by this
+        // multipool object.  Note that the maximum value is defined as:
+        //..
+        //  2 ^ (numPools + 2)
+        //..
+        // where 'numPools' is either specified at construction, or an
+        // implementation-defined value.
+
+    int pageSize() const;
+        // Return the size (and alignment) in bytes of the pages assigned to
+        // the size classes of this multipool object.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // class HeaderlessMultipool
+                         // -------------------------
+
+// PRIVATE CLASS METHODS
+inline
+bsls::Types::UintPtr HeaderlessMultipool::hash(bsls::Types::UintPtr page,
+                                               int                  shift)
+{
+    // Fibonacci hashing: the high-order bits of the product depend on all
+    // bits of 'page'.
+
+    const bsls::Types::Uint64 product =
+                static_cast<bsls::Types::Uint64>(page) * 0x9E3779B97F4A7C15ULL;
+
+    return static_cast<bsls::Types::UintPtr>(product >> (64 - shift));
+}
+
+// PRIVATE ACCESSORS
+inline
+int HeaderlessMultipool::findPool(int size) const
+{
+    BSLS_ASSERT_SAFE(0    <= size);
+    BSLS_ASSERT_SAFE(size <= d_maxBlockSize);
+
+    int accumulator = ((size + 7) >> 3) * 2 - 1;
+
+    accumulator |= accumulator >> 16;
+    accumulator |= accumulator >>  8;
+    accumulator |= accumulator >>  4;
+    accumulator |= accumulator >>  2;
+    accumulator |= accumulator >>  1;
+
+    unsigned input = accumulator;
+
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+    return __builtin_popcount(input) - 1;
+#else
+    input -= (input >> 1) & 0x55555555;
+
+    {
+        const int mask = 0x33333333;
+        input = ((input >> 2) & mask) + (input & mask);
+    }
+
+    input = ((input >>  4) + input) & 0x0f0f0f0f;
+    input =  (input >>  8) + input;
+    input =  (input >> 16) + input;
+
+    return (input & 0x000000ff) - 1;
+#endif
+}
+
+inline
+int HeaderlessMultipool::lookupPool(const void *address) const
+{
+    typedef bsls::Types::UintPtr UintPtr;
+
+    const UintPtr page = reinterpret_cast<UintPtr>(address) >> d_pageShift;
+    const UintPtr mask = (static_cast<UintPtr>(1) << d_mapShift) - 1;
+
+    for (UintPtr i = hash(page, d_mapShift); ; i = (i + 1) & mask) {
+        const PageEntry& entry = d_map_p[i];
+
+        if (entry.d_page == page) {
+            return entry.d_poolIdx;                                   // RETURN
+        }
+        if (0 == entry.d_page) {
+            return -1;                                                // RETURN
+        }
+    }
+}
+
+// MANIPULATORS
+inline
+void *HeaderlessMultipool::allocate(int size)
+{
+    BSLS_ASSERT(1 <= size);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(size <= d_maxBlockSize)) {
+        const int  pool = findPool(size);
+        SizeClass& sc   = d_classes_p[pool];
+
+        if (sc.d_freeList_p) {
+            Link *p = sc.d_freeList_p;
+            sc.d_freeList_p = p->d_next_p;
+            return p;                                                 // RETURN
+        }
+
+        if (sc.d_begin_p != sc.d_end_p) {
+            char *p = sc.d_begin_p;
+            sc.d_begin_p += sc.d_blockSize;
+            return p;                                                 // RETURN
+        }
+
+        return replenish(pool);                                       // RETURN
+    }
+
+    // The requested size is large and will not be pooled.
+
+    return d_blockList.allocate(size);
+}
+
+inline
+void HeaderlessMultipool::deallocate(void *address)
+{
+    BSLS_ASSERT(address);
+
+    const int pool = lookupPool(address);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(-1 == pool)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        d_blockList.deallocate(address);
+    }
+    else {
+        SizeClass& sc   = d_classes_p[pool];
+        Link      *link = static_cast<Link *>(address);
+
+        link->d_next_p  = sc.d_freeList_p;
+        sc.d_freeList_p = link;
+    }
+}
+
+inline
+void HeaderlessMultipool::deallocate(void *address, int size)
+{
+    BSLS_ASSERT(address);
+    BSLS_ASSERT(1 <= size);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_maxBlockSize < size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        BSLS_ASSERT_SAFE(-1 == lookupPool(address));
+
+        d_blockList.deallocate(address);
+    }
+    else {
+        const int pool = findPool(size);
+
+        BSLS_ASSERT_SAFE(pool == lookupPool(address));
+
+        SizeClass& sc   = d_classes_p[pool];
+        Link      *link = static_cast<Link *>(address);
+
+        link->d_next_p  = sc.d_freeList_p;
+        sc.d_freeList_p = link;
+    }
+}
+
+template <class TYPE>
+inline
+void HeaderlessMultipool::deleteObject(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObject(object, this);
+}
+
+template <class TYPE>
+inline
+void HeaderlessMultipool::deleteObjectRaw(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObjectRaw(object, this);
+}
+
+// ACCESSORS
+inline
+int HeaderlessMultipool::numPools() const
+{
+    return d_numPools;
+}
+
+inline
+int HeaderlessMultipool::maxPooledBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+inline
+int HeaderlessMultipool::pageSize() const
+{
+    return 1 << d_pageShift;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// FREE OPERATORS
+inline
+void *operator new(bsl::size_t                               size,
+                   BloombergLP::bdlma::HeaderlessMultipool&  pool)
+{
+    return pool.allocate(static_cast<int>(size));
+}
+
+inline
+void operator delete(void                                     *address,
+                     BloombergLP::bdlma::HeaderlessMultipool&  pool)
+{
+    pool.deallocate(address);
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
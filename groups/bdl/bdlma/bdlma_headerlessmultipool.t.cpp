@@ -0,0 +1,833 @@
+// bdlma_headerlessmultipool.t.cpp                                    -*-C++-*-
+#include <bdlma_headerlessmultipool.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// A 'bdlma::HeaderlessMultipool' is a mechanism (i.e., having state but no
+// value) that dispenses memory blocks of varying sizes from size classes
+// whose blocks carry no header.
+//
+// The goals of this test driver are to verify that: 1) 'allocate' dispenses
+// distinct blocks, naturally aligned for their size class and packed without
+// gaps, 2) 'deallocate' returns each block to the size class that dispensed
+// it (or to the underlying allocator, for blocks larger than the largest size
+// class), as found by the page hash table, including after the table grows,
+// 3) 'reserveCapacity' pre-allocates the requested blocks, 4) 'release' and
+// the destructor release all memory, and 5) the memory footprint of small
+// blocks is close to their size.  The 'bslma_testallocator' component is used
+// to observe the memory requested by the multipool.
+//-----------------------------------------------------------------------------
+// [ 2] HeaderlessMultipool(basicAllocator = 0);
+// [ 2] HeaderlessMultipool(numPools, basicAllocator = 0);
+// [ 2] ~HeaderlessMultipool();
+// [ 3] void *allocate(int size);
+// [ 3] void deallocate(void *address);
+// [ 3] void deallocate(void *address, int size);
+// [ 5] template <class TYPE> void deleteObject(const TYPE *object);
+// [ 5] template <class TYPE> void deleteObjectRaw(const TYPE *object);
+// [ 6] void release();
+// [ 6] void reserveCapacity(int size, int numBlocks);
+// [ 2] int numPools() const;
+// [ 2] int maxPooledBlockSize() const;
+// [ 2] int pageSize() const;
+// [ 5] void *operator new(size_t size, bdlma::HeaderlessMultipool& pool);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCERN: Blocks are returned to the class that dispensed them.
+// [ 7] CONCERN: Small blocks have no per-block overhead.
+// [ 8] USAGE EXAMPLE
+// [ *] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                       GLOBAL TYPES AND CONSTANTS
+//-----------------------------------------------------------------------------
+
+typedef bdlma::HeaderlessMultipool Obj;
+
+enum { DEFAULT_NUM_POOLS = 10 };  // implementation-defined default
+
+//=============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+int classSize(int size)
+    // Return the block size of the size class serving a request for the
+    // specified 'size' bytes.
+{
+    int blockSize = 8;
+    while (blockSize < size) {
+        blockSize *= 2;
+    }
+    return blockSize;
+}
+
+static
+bool isAligned(const void *address, int alignment)
+    // Return 'true' if the specified 'address' is a multiple of the specified
+    // 'alignment', and 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address) % alignment;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Example 1: Storing Small List Nodes Compactly
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we maintain a singly-linked list of integers, whose 16-byte
+// nodes (on 64-bit platforms) are allocated from a multipool.  With a
+// 'bdlma::Multipool', each node would occupy 32 bytes including its header;
+// using a 'bdlma::HeaderlessMultipool', each node occupies exactly 16 bytes.
+//
+// First, we define the node type:
+//..
+    struct Node {
+        Node *d_next_p;
+        int   d_value;
+    };
+//..
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator  testAllocator(veryVeryVerbose);
+    bslma::Allocator     *Z = &testAllocator;
+
+    bslma::TestAllocator  scratch("scratch", veryVeryVerbose);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+//..
+// Then, we create a multipool, and allocate a list of nodes from it:
+//..
+    bdlma::HeaderlessMultipool multipool;
+
+    Node *head = 0;
+    for (int i = 0; i < 100; ++i) {
+        Node *node = static_cast<Node *>(multipool.allocate(sizeof(Node)));
+        node->d_next_p = head;
+        node->d_value  = i;
+        head = node;
+    }
+//..
+// Next, we observe that nodes allocated consecutively are adjacent in memory,
+// as no header separates them:
+//..
+    const char *first  = reinterpret_cast<const char *>(head->d_next_p);
+    const char *second = reinterpret_cast<const char *>(head);
+    ASSERT(sizeof(Node) == second - first);
+//..
+// Finally, we return the nodes to the multipool, one by one:
+//..
+    while (head) {
+        Node *next = head->d_next_p;
+        multipool.deallocate(head);
+        head = next;
+    }
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // FOOTPRINT OF SMALL BLOCKS
+        //
+        // Concerns:
+        //: 1 The memory obtained from the underlying allocator for many small
+        //:   blocks is close to the total size of those blocks.
+        //
+        // Plan:
+        //: 1 For each of the smaller size classes, allocate many blocks and
+        //:   verify that the bytes in use by the test allocator exceed the
+        //:   total size of the blocks by less than 5%, plus a fixed amount
+        //:   for the partially used last arena and the page table.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: Small blocks have no per-block overhead.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "FOOTPRINT OF SMALL BLOCKS"
+                          << endl << "=========================" << endl;
+
+        enum { NUM_BLOCKS = 400000, FIXED = 1024 * 1024 };
+
+        for (int size = 8; size <= 64; size *= 2) {
+            Obj mX(Z);
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.allocate(size);
+            }
+
+            const bsls::Types::Int64 bytes = testAllocator.numBytesInUse();
+            const bsls::Types::Int64 total =
+                                 static_cast<bsls::Types::Int64>(NUM_BLOCKS)
+                                                                       * size;
+
+            if (veryVerbose) { P_(size) P_(bytes) P(total) }
+
+            LOOP3_ASSERT(size, bytes, total,
+                         bytes < total + total / 20 + FIXED);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'release' AND 'reserveCapacity'
+        //
+        // Concerns:
+        //: 1 'release' returns all memory, including large blocks, to the
+        //:   underlying allocator, and the multipool remains usable.
+        //:
+        //: 2 After 'reserveCapacity(size, n)', 'n' blocks of 'size' bytes can
+        //:   be allocated without obtaining memory from the underlying
+        //:   allocator, including when some blocks are already free.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate pooled and large blocks, 'release', verify that no
+        //:   memory is in use, and allocate again.  (C-1)
+        //:
+        //: 2 For a range of sizes and 'n', partially use the size class,
+        //:   reserve 'n' blocks, and verify that allocating 'n' blocks does
+        //:   not use the test allocator.  (C-2)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-3)
+        //
+        // Testing:
+        //   void release();
+        //   void reserveCapacity(int size, int numBlocks);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'release' AND 'reserveCapacity'" << endl
+                          << "=======================================" << endl;
+
+        {
+            Obj mX(Z);  const Obj& X = mX;
+
+            for (int i = 0; i < 1000; ++i) {
+                mX.allocate(1 + i % X.maxPooledBlockSize());
+            }
+            mX.allocate(X.maxPooledBlockSize() + 1);
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksInUse();
+
+            mX.release();
+
+            // Only the size classes and page table remain.
+
+            LOOP_ASSERT(NUM_BLOCKS, 2 == testAllocator.numBlocksInUse());
+
+            char *p = static_cast<char *>(mX.allocate(24));
+            ASSERT(p);
+            memset(p, 0xa5, 24);
+            mX.deallocate(p);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        const int SIZES[] = { 1, 8, 16, 100, 1024, 4096 };
+        const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int SIZE = SIZES[ti];
+
+            for (int n = 0; n < 3000; n += 1 + n / 2) {
+                Obj mX(Z);
+
+                // Leave some free blocks and a partially used page.
+
+                void *p = mX.allocate(SIZE);
+                mX.allocate(SIZE);
+                mX.deallocate(p);
+
+                mX.reserveCapacity(SIZE, n);
+
+                const bsls::Types::Int64 NUM_ALLOCATIONS =
+                                               testAllocator.numAllocations();
+
+                for (int i = 0; i < n; ++i) {
+                    mX.allocate(SIZE);
+                }
+
+                LOOP2_ASSERT(SIZE, n, NUM_ALLOCATIONS ==
+                                               testAllocator.numAllocations());
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(Z);  const Obj& X = mX;
+
+            const int MAX = X.maxPooledBlockSize();
+
+            ASSERT_PASS(mX.reserveCapacity(  1,  0));
+            ASSERT_PASS(mX.reserveCapacity(MAX,  1));
+            ASSERT_FAIL(mX.reserveCapacity(  0,  1));
+            ASSERT_FAIL(mX.reserveCapacity(MAX + 1, 1));
+            ASSERT_FAIL(mX.reserveCapacity(  1, -1));
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'deleteObject', 'deleteObjectRaw', AND 'operator new'
+        //
+        // Concerns:
+        //: 1 'operator new' constructs an object in a block from the
+        //:   multipool.
+        //:
+        //: 2 'deleteObject' and 'deleteObjectRaw' destroy the object and
+        //:   return its footprint to the multipool for reuse.
+        //:
+        //: 3 Both delete methods have no effect on a null pointer.
+        //
+        // Plan:
+        //: 1 Create an object with 'operator new', delete it, and verify that
+        //:   its destructor ran and that the next allocation returns the same
+        //:   address.  (C-1..2)
+        //:
+        //: 2 Invoke both methods with a null pointer.  (C-3)
+        //
+        // Testing:
+        //   template <class TYPE> void deleteObject(const TYPE *object);
+        //   template <class TYPE> void deleteObjectRaw(const TYPE *object);
+        //   void *operator new(size_t size, bdlma::HeaderlessMultipool& pool);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'deleteObject' AND 'deleteObjectRaw'"
+                          << endl
+                          << "============================================"
+                          << endl;
+
+        struct Probe {
+            int *d_destroyed_p;
+
+            explicit Probe(int *destroyed) : d_destroyed_p(destroyed) {}
+            ~Probe() { ++*d_destroyed_p; }
+        };
+
+        int destroyed = 0;
+
+        Obj mX(Z);
+
+        Probe *p = new (mX) Probe(&destroyed);
+        mX.deleteObject(p);
+        ASSERT(1 == destroyed);
+
+        Probe *q = new (mX) Probe(&destroyed);
+        ASSERT(p == q);
+
+        mX.deleteObjectRaw(q);
+        ASSERT(2 == destroyed);
+
+        mX.deleteObject(static_cast<Probe *>(0));
+        mX.deleteObjectRaw(static_cast<Probe *>(0));
+        ASSERT(2 == destroyed);
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // DEALLOCATION TO THE OWNING SIZE CLASS
+        //
+        // Concerns:
+        //: 1 'deallocate' returns every block to the size class (or large
+        //:   block list) that dispensed it, however many pages are in use,
+        //:   i.e., including after the page table has grown.
+        //
+        // Plan:
+        //: 1 Allocate many blocks of every size class, and some large blocks,
+        //:   spread over several arenas.  Deallocate them all in a scrambled
+        //:   order.  Then allocate the same number of blocks of each size
+        //:   class again, and verify that each block returned was previously
+        //:   dispensed by the same size class, and that no memory is obtained
+        //:   from the underlying allocator.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: Blocks are returned to the class that dispensed them.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DEALLOCATION TO THE OWNING SIZE CLASS" << endl
+                          << "=====================================" << endl;
+
+        enum { NUM_POOLS = 8, NUM_BLOCKS = 4000 };
+
+        Obj mX(NUM_POOLS, Z);  const Obj& X = mX;
+
+        const int MAX = X.maxPooledBlockSize();
+
+        bsl::vector<bsl::vector<void *> > blocks(NUM_POOLS + 1, &scratch);
+
+        // Allocate blocks of all sizes in an interleaved order, so that the
+        // pages of different size classes are interleaved.
+
+        for (int i = 0; i < NUM_BLOCKS; ++i) {
+            int blockSize = 8;
+            for (int pool = 0; pool < NUM_POOLS; ++pool, blockSize *= 2) {
+                if (blockSize * i > 64 * MAX) {
+                    continue;  // limit the memory used by large classes
+                }
+                void *p = mX.allocate(blockSize - (i % 8));
+                LOOP2_ASSERT(pool, i, isAligned(p, blockSize));
+                memset(p, pool, blockSize - (i % 8));
+                blocks[pool].push_back(p);
+            }
+            if (0 == i % 100) {
+                blocks[NUM_POOLS].push_back(mX.allocate(MAX + 1 + i));
+            }
+        }
+
+        // Deallocate all blocks, scrambling the order by striding through
+        // each array.
+
+        for (int pool = 0; pool <= NUM_POOLS; ++pool) {
+            bsl::vector<void *>& v = blocks[pool];
+            const int            N = static_cast<int>(v.size());
+
+            for (int i = 0; i < N; ++i) {
+                mX.deallocate(v[(i * 7919) % N]);
+            }
+            bsl::sort(v.begin(), v.end());
+        }
+
+        const bsls::Types::Int64 NUM_ALLOCATIONS =
+                                               testAllocator.numAllocations();
+
+        int blockSize = 8;
+        for (int pool = 0; pool < NUM_POOLS; ++pool, blockSize *= 2) {
+            bsl::vector<void *>& v = blocks[pool];
+            const int            N = static_cast<int>(v.size());
+
+            for (int i = 0; i < N; ++i) {
+                void *p = mX.allocate(blockSize);
+                LOOP2_ASSERT(pool, i,
+                             bsl::binary_search(v.begin(), v.end(), p));
+            }
+        }
+
+        LOOP2_ASSERT(NUM_ALLOCATIONS, testAllocator.numAllocations(),
+                     NUM_ALLOCATIONS == testAllocator.numAllocations());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns distinct blocks of at least the requested
+        //:   size, aligned to the block size of their size class.
+        //:
+        //: 2 Consecutive blocks from a fresh page are adjacent, i.e., no
+        //:   header separates them.
+        //:
+        //: 3 'deallocate', with or without the size of the block, makes a
+        //:   block available for reuse by its size class, in reverse order of
+        //:   deallocation.
+        //:
+        //: 4 Blocks larger than 'maxPooledBlockSize' are maximally aligned,
+        //:   and are returned to the underlying allocator on 'deallocate'.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For every size up to 'maxPooledBlockSize', allocate a few blocks
+        //:   from a new multipool, verify their alignment and adjacency, and
+        //:   write to every byte.  (C-1..2)
+        //:
+        //: 2 Deallocate the blocks in order, alternating between the sized
+        //:   and unsized 'deallocate', and verify that they are allocated
+        //:   again in reverse order.  (C-3)
+        //:
+        //: 3 Allocate and deallocate large blocks, using both forms of
+        //:   'deallocate', and observe the test allocator.  (C-4)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   void *allocate(int size);
+        //   void deallocate(void *address);
+        //   void deallocate(void *address, int size);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocate' AND 'deallocate'" << endl
+                          << "===================================" << endl;
+
+        enum { NUM_POOLS = 7, K = 4 };
+
+        for (int size = 1; size <= (8 << (NUM_POOLS - 1)); ++size) {
+            Obj mX(NUM_POOLS, Z);
+
+            const int BLOCK_SIZE = classSize(size);
+
+            char *p[K];
+            for (int i = 0; i < K; ++i) {
+                p[i] = static_cast<char *>(mX.allocate(size));
+                LOOP2_ASSERT(size, i, isAligned(p[i], BLOCK_SIZE));
+                memset(p[i], i, size);
+
+                if (i) {
+                    LOOP2_ASSERT(size, i, p[i - 1] + BLOCK_SIZE == p[i]);
+                }
+            }
+            for (int i = 0; i < K; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    LOOP3_ASSERT(size, i, j, i == p[i][j]);
+                }
+            }
+            for (int i = 0; i < K; ++i) {
+                if (i % 2) {
+                    mX.deallocate(p[i], size);
+                }
+                else {
+                    mX.deallocate(p[i]);
+                }
+            }
+            for (int i = K - 1; i >= 0; --i) {
+                LOOP2_ASSERT(size, i, p[i] == mX.allocate(size));
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nLarge blocks." << endl;
+        {
+            Obj mX(Z);  const Obj& X = mX;
+
+            const int MAX = X.maxPooledBlockSize();
+
+            // Allocate a pooled block first, so that the first arena is in
+            // place.
+
+            mX.allocate(8);
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksInUse();
+
+            void *p = mX.allocate(MAX + 1);
+            ASSERT(isAligned(p, bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT));
+            ASSERT(NUM_BLOCKS + 1 == testAllocator.numBlocksInUse());
+            memset(p, 0xff, MAX + 1);
+
+            mX.deallocate(p);
+            ASSERT(NUM_BLOCKS == testAllocator.numBlocksInUse());
+
+            p = mX.allocate(MAX + 1);
+            ASSERT(NUM_BLOCKS + 1 == testAllocator.numBlocksInUse());
+
+            mX.deallocate(p, MAX + 1);
+            ASSERT(NUM_BLOCKS == testAllocator.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(Z);
+
+            ASSERT_PASS(mX.allocate( 1));
+            ASSERT_FAIL(mX.allocate( 0));
+            ASSERT_FAIL(mX.allocate(-1));
+
+            void *p = mX.allocate(8);
+            ASSERT_PASS(mX.deallocate(p));
+            ASSERT_FAIL(mX.deallocate(0));
+
+            p = mX.allocate(8);
+            ASSERT_FAIL(mX.deallocate(0, 8));
+            ASSERT_FAIL(mX.deallocate(p, 0));
+            ASSERT_SAFE_FAIL(mX.deallocate(p, 16));
+            ASSERT_PASS(mX.deallocate(p, 8));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 'numPools' returns the number of size classes supplied at
+        //:   construction, or the implementation-defined default.
+        //:
+        //: 2 'maxPooledBlockSize' returns '2^(numPools + 2)'.
+        //:
+        //: 3 'pageSize' is a power of 2, at least 16 KiB, and at least four
+        //:   times 'maxPooledBlockSize'.
+        //:
+        //: 4 Memory is supplied by the allocator specified at construction,
+        //:   or by the default allocator if none is specified, and is
+        //:   returned to it on destruction.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Construct multipools with each constructor and a range of
+        //:   'numPools', verify the accessors, allocate a block of the largest
+        //:   pooled size, and verify that the memory comes from the expected
+        //:   allocator and is released on destruction.  (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   HeaderlessMultipool(basicAllocator = 0);
+        //   HeaderlessMultipool(numPools, basicAllocator = 0);
+        //   ~HeaderlessMultipool();
+        //   int numPools() const;
+        //   int maxPooledBlockSize() const;
+        //   int pageSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CREATORS AND ACCESSORS" << endl
+                          << "==============================" << endl;
+
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            {
+                Obj mX;  const Obj& X = mX;
+
+                ASSERT(DEFAULT_NUM_POOLS == X.numPools());
+                ASSERT((8 << (DEFAULT_NUM_POOLS - 1))
+                                                  == X.maxPooledBlockSize());
+
+                mX.allocate(X.maxPooledBlockSize());
+                ASSERT(0 < da.numBlocksInUse());
+            }
+            ASSERT(0 == da.numBlocksInUse());
+
+            {
+                Obj mX(3);  const Obj& X = mX;
+
+                ASSERT(3  == X.numPools());
+                ASSERT(32 == X.maxPooledBlockSize());
+                ASSERT(0 < da.numBlocksInUse());
+            }
+            ASSERT(0 == da.numBlocksInUse());
+        }
+
+        for (int numPools = 1; numPools <= 16; ++numPools) {
+            {
+                Obj mX(numPools, Z);  const Obj& X = mX;
+
+                const int MAX = 8 << (numPools - 1);
+
+                LOOP_ASSERT(numPools, numPools == X.numPools());
+                LOOP_ASSERT(numPools, MAX == X.maxPooledBlockSize());
+
+                const int PAGE = X.pageSize();
+                LOOP_ASSERT(numPools, 0 == (PAGE & (PAGE - 1)));
+                LOOP_ASSERT(numPools, 16 * 1024 <= PAGE);
+                LOOP_ASSERT(numPools, 4 * MAX <= PAGE);
+
+                void *p = mX.allocate(MAX);
+                LOOP_ASSERT(numPools, isAligned(p, MAX));
+                memset(p, 0, MAX);
+            }
+            LOOP_ASSERT(numPools, 0 == testAllocator.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj( 1, Z));
+            ASSERT_FAIL(Obj( 0, Z));
+            ASSERT_FAIL(Obj(-1, Z));
+            ASSERT_FAIL(Obj(25, Z));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //   That the basic functionality of 'bdlma::HeaderlessMultipool'
+        //   works properly.
+        //
+        // Plan:
+        //   Create a multipool, allocate and deallocate blocks of several
+        //   sizes (including one larger than 'maxPooledBlockSize'), and
+        //   release all memory.  Finally, let the multipool go out of scope to
+        //   exercise the destructor.
+        //
+        // Testing:
+        //   This "test" exercises basic functionality, but tests nothing.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST"
+                          << endl << "==============" << endl;
+
+        {
+            Obj mX(Z);  const Obj& X = mX;
+
+            void *p = mX.allocate(5);    ASSERT(p);
+            void *q = mX.allocate(100);  ASSERT(q);
+            void *r = mX.allocate(X.maxPooledBlockSize() * 2);  ASSERT(r);
+
+            ASSERT(p != q);
+            ASSERT(q != r);
+
+            mX.deallocate(p);
+            ASSERT(p == mX.allocate(8));
+
+            mX.deallocate(r);
+            mX.deallocate(q);
+
+            mX.release();
+            ASSERT(2 == testAllocator.numBlocksInUse());
+
+            p = mX.allocate(1);  ASSERT(p);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,670 @@
+// bdlma_heapprofilingallocator.cpp                                   -*-C++-*-
+#include <bdlma_heapprofilingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_heapprofilingallocator_cpp,"$Id$ $CSID$")
+
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+
+#include <bsls_assert.h>
+#include <bsls_bsllock.h>
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_algorithm.h>           // 'bsl::sort'
+#include <bsl_cmath.h>               // 'bsl::exp', 'bsl::log'
+#include <bsl_cstring.h>             // 'bsl::memcmp', 'bsl::memcpy',
+                                     // 'bsl::memset'
+#include <bsl_ios.h>
+#include <bsl_iomanip.h>
+#include <bsl_limits.h>              // 'bsl::numeric_limits'
+#include <bsl_ostream.h>
+#include <bsl_vector.h>
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+#include <bsl_fstream.h>
+#include <execinfo.h>  // 'backtrace'
+
+#elif defined(BSLS_PLATFORM_OS_DARWIN)
+
+#include <execinfo.h>  // 'backtrace'
+
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+
+#include <windows.h>   // 'CaptureStackBackTrace'
+
+#endif
+
+// Define a macro that loads the return addresses of the active calls, starting
+// with the function invoking the macro, into the specified 'frames' array of
+// at most the specified 'maxDepth' elements, and yields the number loaded.
+// Where the call stack cannot be walked, yield an unspecified address for the
+// invoking function followed by its return address (if available).  Note that
+// the function using this macro must not be inlined.
+
+#if defined(BSLS_PLATFORM_OS_LINUX) || defined(BSLS_PLATFORM_OS_DARWIN)
+#define BDLMA_HEAPPROFILINGALLOCATOR_BACKTRACE(frames, maxDepth)              \
+    backtrace((frames), (maxDepth))
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+#define BDLMA_HEAPPROFILINGALLOCATOR_BACKTRACE(frames, maxDepth)              \
+    static_cast<int>(CaptureStackBackTrace(0, (maxDepth), (frames), 0))
+#elif defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+#define BDLMA_HEAPPROFILINGALLOCATOR_BACKTRACE(frames, maxDepth)              \
+    ((frames)[0] = 0, (frames)[1] = __builtin_return_address(0), 2)
+#else
+#define BDLMA_HEAPPROFILINGALLOCATOR_BACKTRACE(frames, maxDepth) 0
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                     // ------------------------------------
+                     // struct HeapProfilingAllocator::Stack
+                     // ------------------------------------
+
+struct HeapProfilingAllocator::Stack {
+    // This 'struct' holds the samples taken of the blocks allocated by one
+    // call stack.
+
+    // DATA
+    Stack               *d_next_p;       // next entry in the hash chain
+    Stack               *d_nextStack_p;  // next entry in the list of all
+                                         // entries
+    bsls::Types::Uint64  d_hash;         // hash of the call stack
+    bsls::Types::Int64   d_numLive;      // number of live samples
+    bsls::Types::Int64   d_liveBytes;    // bytes in live samples
+    bsls::Types::Int64   d_numSamples;   // number of samples taken
+    bsls::Types::Int64   d_sampledBytes; // bytes in samples taken
+    int                  d_depth;        // number of return addresses
+    void                *d_frames[k_MAX_STACK_DEPTH];
+                                         // return addresses
+};
+
+                     // -------------------------------------
+                     // struct HeapProfilingAllocator::Sample
+                     // -------------------------------------
+
+struct HeapProfilingAllocator::Sample {
+    // This 'struct' records a sampled block that is in use.
+
+    // DATA
+    Sample      *d_next_p;     // next entry in the hash chain
+    const void  *d_address_p;  // address of the block
+    Stack       *d_stack_p;    // entry of the call stack that allocated the
+                               // block
+    size_type    d_size;       // size (in bytes) requested for the block
+};
+
+}  // close package namespace
+
+namespace {
+
+// LOCAL CONSTANTS
+
+// Define the number of chains in the hash table of call stacks of each
+// allocator.
+
+const int NUM_CHAINS = 1024;
+
+// Define the largest distance between sample points, so that adding a
+// request size to a distance cannot overflow.
+
+const bsls::Types::Int64 MAX_DISTANCE =
+                           bsl::numeric_limits<bsls::Types::Int64>::max() / 4;
+
+// Define the number of chains in the hash table of sampled blocks of each
+// allocator, as a power of two.
+
+const int SAMPLE_CHAIN_BITS = 14;
+const int NUM_SAMPLE_CHAINS = 1 << SAMPLE_CHAIN_BITS;
+
+typedef bsls::AtomicOperations AtomicOps;
+
+struct Estimate {
+    // This 'struct' holds the estimated number of blocks and bytes in use that
+    // are represented by the live samples of a call stack.
+
+    double d_bytes;   // estimated bytes in use
+    double d_blocks;  // estimated blocks in use
+    int    d_index;   // index of the call stack in the profile snapshot
+};
+
+bool greaterBytes(const Estimate& lhs, const Estimate& rhs)
+    // Return 'true' if the specified 'lhs' estimates more bytes in use than
+    // the specified 'rhs', or the same number of bytes but occurs earlier in
+    // the snapshot, and 'false' otherwise.
+{
+    return lhs.d_bytes != rhs.d_bytes ? lhs.d_bytes > rhs.d_bytes
+                                      : lhs.d_index < rhs.d_index;
+}
+
+bsls::Types::Uint64 hashStack(void *const *frames, int depth)
+    // Return a hash of the specified 'depth' return addresses at the specified
+    // 'frames'.
+{
+    bsls::Types::Uint64 hash = 0xCBF29CE484222325ULL;
+
+    for (int i = 0; i < depth; ++i) {
+        hash ^= reinterpret_cast<bsls::Types::UintPtr>(frames[i]);
+        hash *= 0x100000001B3ULL;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+int sampleChainIndex(const void *address)
+    // Return the index of the chain of the hash table of sampled blocks that
+    // holds the block at the specified 'address'.
+{
+    const bsls::Types::Uint64 bits =
+                             reinterpret_cast<bsls::Types::UintPtr>(address);
+
+    return static_cast<int>((bits * 0x9E3779B97F4A7C15ULL)
+                                                  >> (64 - SAMPLE_CHAIN_BITS));
+}
+
+void printStack(bsl::ostream& stream, void *const *frames, int depth)
+    // Write the specified 'depth' return addresses at the specified 'frames'
+    // to the specified 'stream', each in hexadecimal and preceded by a space.
+{
+    for (int i = 0; i < depth; ++i) {
+        stream << " 0x" << bsl::hex
+               << reinterpret_cast<bsls::Types::UintPtr>(frames[i])
+               << bsl::dec;
+    }
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                        // ----------------------------
+                        // class HeapProfilingAllocator
+                        // ----------------------------
+
+// PRIVATE MANIPULATORS
+bsls::Types::Int64 HeapProfilingAllocator::nextDistance()
+{
+    // Advance an 'xorshift64*' generator, and map the top 53 bits of its
+    // output to a uniform variate in '(0, 1]'.
+
+    bsls::Types::Uint64 x = d_randomState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    d_randomState = x;
+
+    const double uniform =
+        static_cast<double>(((x * 0x2545F4914F6CDD1DULL) >> 11) + 1)
+                                                      / 9007199254740992.0;
+
+    const double distance = -static_cast<double>(d_samplePeriod)
+                          * bsl::log(uniform);
+
+    if (distance < 1.0) {
+        return 1;                                                     // RETURN
+    }
+    if (distance >= static_cast<double>(MAX_DISTANCE)) {
+        return MAX_DISTANCE;                                          // RETURN
+    }
+    return static_cast<bsls::Types::Int64>(distance);
+}
+
+void *HeapProfilingAllocator::allocateSampled(size_type    size,
+                                              void *const *frames,
+                                              int          depth)
+{
+    BSLS_ASSERT(0 <= depth);
+    BSLS_ASSERT(depth <= k_MAX_STACK_DEPTH);
+
+    const bsls::Types::Uint64 hash = hashStack(frames, depth);
+
+    // Allocate the block, its sample, and a candidate entry for its call
+    // stack before acquiring the lock, so that no allocation (which may throw)
+    // is made while the lock is held.
+
+    void *block = d_allocator_p->allocate(size);
+    bslma::DeallocatorProctor<bslma::Allocator> blockProctor(block,
+                                                             d_allocator_p);
+
+    Sample *sample = static_cast<Sample *>(
+                                   d_allocator_p->allocate(sizeof *sample));
+    bslma::DeallocatorProctor<bslma::Allocator> sampleProctor(sample,
+                                                              d_allocator_p);
+
+    Stack *spare = static_cast<Stack *>(
+                                     d_allocator_p->allocate(sizeof *spare));
+
+    sampleProctor.release();
+    blockProctor.release();
+
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        Stack **chain = d_table_p + hash % NUM_CHAINS;
+        Stack  *stack = *chain;
+
+        while (stack && (stack->d_hash  != hash
+                      || stack->d_depth != depth
+                      || 0 != bsl::memcmp(stack->d_frames,
+                                          frames,
+                                          depth * sizeof *frames))) {
+            stack = stack->d_next_p;
+        }
+
+        if (!stack) {
+            stack = spare;
+            spare = 0;
+
+            stack->d_next_p       = *chain;
+            stack->d_nextStack_p  = d_stacks_p;
+            stack->d_hash         = hash;
+            stack->d_numLive      = 0;
+            stack->d_liveBytes    = 0;
+            stack->d_numSamples   = 0;
+            stack->d_sampledBytes = 0;
+            stack->d_depth        = depth;
+            bsl::memcpy(stack->d_frames, frames, depth * sizeof *frames);
+
+            *chain     = stack;
+            d_stacks_p = stack;
+        }
+
+        const bsls::Types::Int64 bytes = static_cast<bsls::Types::Int64>(size);
+
+        ++stack->d_numLive;
+        stack->d_liveBytes    += bytes;
+        ++stack->d_numSamples;
+        stack->d_sampledBytes += bytes;
+
+        SampleChain *sampleChain = d_samples_p + sampleChainIndex(block);
+
+        sample->d_next_p    = static_cast<Sample *>(
+                                      AtomicOps::getPtrRelaxed(sampleChain));
+        sample->d_address_p = block;
+        sample->d_stack_p   = stack;
+        sample->d_size      = size;
+        AtomicOps::setPtrRelease(sampleChain, sample);
+
+        ++d_numLive;
+        ++d_numSamples;
+    }
+
+    if (spare) {
+        d_allocator_p->deallocate(spare);
+    }
+
+    return block;
+}
+
+bool HeapProfilingAllocator::resetCountdown(bsls::Types::Int64 countdown)
+{
+    BSLS_ASSERT(0 >= countdown);
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    bool isSampled = true;
+
+    // A thread that has made no request has no countdown yet; place its first
+    // sample point at a new distance, sampling this request only if it
+    // reaches that point.
+
+    if (0 == d_countdown.value()) {
+        countdown += nextDistance();
+        isSampled  = 0 >= countdown;
+    }
+
+    if (isSampled) {
+        // Carry the bytes of the request beyond the sample point into the
+        // next distance.  If the request spans another sample point, place the
+        // next point a new distance beyond its end instead.
+
+        countdown += nextDistance();
+        if (0 >= countdown) {
+            countdown = nextDistance();
+        }
+    }
+
+    d_countdown.setValue(countdown);
+
+    return isSampled;
+}
+
+void HeapProfilingAllocator::releaseSample(const void *address)
+{
+    SampleChain *sampleChain = d_samples_p + sampleChainIndex(address);
+    Sample      *sample      = 0;
+
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        Sample *previous = 0;
+        sample = static_cast<Sample *>(AtomicOps::getPtrRelaxed(sampleChain));
+
+        while (sample && address != sample->d_address_p) {
+            previous = sample;
+            sample   = sample->d_next_p;
+        }
+
+        if (!sample) {
+            return;                                                   // RETURN
+        }
+
+        if (previous) {
+            previous->d_next_p = sample->d_next_p;
+        }
+        else {
+            AtomicOps::setPtrRelaxed(sampleChain, sample->d_next_p);
+        }
+
+        Stack *stack = sample->d_stack_p;
+
+        --stack->d_numLive;
+        stack->d_liveBytes -= static_cast<bsls::Types::Int64>(sample->d_size);
+
+        --d_numLive;
+    }
+
+    d_allocator_p->deallocate(sample);
+}
+
+// CREATORS
+HeapProfilingAllocator::HeapProfilingAllocator(
+                                              bslma::Allocator *basicAllocator)
+: d_countdown()
+, d_samplePeriod(k_DEFAULT_SAMPLE_PERIOD)
+, d_randomState(reinterpret_cast<bsls::Types::UintPtr>(this)
+                                                     ^ 0x9E3779B97F4A7C15ULL)
+, d_table_p(0)
+, d_stacks_p(0)
+, d_samples_p(0)
+, d_numLive(0)
+, d_numSamples(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    // Allocate the table of call stacks and the table of sampled blocks in a
+    // single block.
+
+    d_table_p = static_cast<Stack **>(d_allocator_p->allocate(
+                                   NUM_CHAINS        * sizeof *d_table_p
+                                 + NUM_SAMPLE_CHAINS * sizeof *d_samples_p));
+    bsl::memset(d_table_p, 0, NUM_CHAINS * sizeof *d_table_p);
+
+    d_samples_p = reinterpret_cast<SampleChain *>(d_table_p + NUM_CHAINS);
+    for (int i = 0; i < NUM_SAMPLE_CHAINS; ++i) {
+        AtomicOps::initPointer(d_samples_p + i, 0);
+    }
+}
+
+HeapProfilingAllocator::HeapProfilingAllocator(
+                                      bsls::Types::Int64  samplePeriod,
+                                      bslma::Allocator   *basicAllocator)
+: d_countdown()
+, d_samplePeriod(samplePeriod)
+, d_randomState(reinterpret_cast<bsls::Types::UintPtr>(this)
+                                                     ^ 0x9E3779B97F4A7C15ULL)
+, d_table_p(0)
+, d_stacks_p(0)
+, d_samples_p(0)
+, d_numLive(0)
+, d_numSamples(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < samplePeriod);
+
+    // Allocate the table of call stacks and the table of sampled blocks in a
+    // single block.
+
+    d_table_p = static_cast<Stack **>(d_allocator_p->allocate(
+                                   NUM_CHAINS        * sizeof *d_table_p
+                                 + NUM_SAMPLE_CHAINS * sizeof *d_samples_p));
+    bsl::memset(d_table_p, 0, NUM_CHAINS * sizeof *d_table_p);
+
+    d_samples_p = reinterpret_cast<SampleChain *>(d_table_p + NUM_CHAINS);
+    for (int i = 0; i < NUM_SAMPLE_CHAINS; ++i) {
+        AtomicOps::initPointer(d_samples_p + i, 0);
+    }
+}
+
+HeapProfilingAllocator::~HeapProfilingAllocator()
+{
+    for (int i = 0; i < NUM_SAMPLE_CHAINS; ++i) {
+        Sample *sample = static_cast<Sample *>(
+                                 AtomicOps::getPtrRelaxed(d_samples_p + i));
+        while (sample) {
+            Sample *next = sample->d_next_p;
+            d_allocator_p->deallocate(sample);
+            sample = next;
+        }
+    }
+
+    while (d_stacks_p) {
+        Stack *next = d_stacks_p->d_nextStack_p;
+        d_allocator_p->deallocate(d_stacks_p);
+        d_stacks_p = next;
+    }
+    d_allocator_p->deallocate(d_table_p);
+}
+
+// MANIPULATORS
+void *HeapProfilingAllocator::allocate(size_type size)
+{
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    const bsls::Types::Int64 countdown = d_countdown.value()
+                                       - static_cast<bsls::Types::Int64>(size);
+
+    // Sample the request if it reached the next sample point of the calling
+    // thread, i.e., if it brought the countdown to zero or below.
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 >= countdown)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        if (resetCountdown(countdown)) {
+            // Capture one more frame than is recorded, since the first frame
+            // is in this function.
+
+            void      *frames[k_MAX_STACK_DEPTH + 1];
+            const int  depth = BDLMA_HEAPPROFILINGALLOCATOR_BACKTRACE(
+                                                       frames,
+                                                       k_MAX_STACK_DEPTH + 1);
+
+            return allocateSampled(size,
+                                   frames + 1,
+                                   depth > 1 ? depth - 1 : 0);        // RETURN
+        }
+
+        return d_allocator_p->allocate(size);                         // RETURN
+    }
+
+    d_countdown.setValue(countdown);
+
+    return d_allocator_p->allocate(size);
+}
+
+void HeapProfilingAllocator::deallocate(void *address)
+{
+    if (0 == address) {
+        return;                                                       // RETURN
+    }
+
+    // Search for a sample of the block only if its chain is not empty.  A
+    // sample recorded when the block was allocated is visible here, since the
+    // allocation happens before this deallocation.
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 != AtomicOps::getPtrRelaxed(
+                                  d_samples_p + sampleChainIndex(address)))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        releaseSample(address);
+    }
+
+    d_allocator_p->deallocate(address);
+}
+
+// ACCESSORS
+bsls::Types::Int64 HeapProfilingAllocator::numLiveSamples() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_numLive;
+}
+
+bsls::Types::Int64 HeapProfilingAllocator::numSamples() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_numSamples;
+}
+
+bsl::ostream&
+HeapProfilingAllocator::printProfile(bsl::ostream&  stream,
+                                     ProfileFormat  format) const
+{
+    // Take a snapshot of the entries under the lock, so that the lock is not
+    // held while writing to 'stream' (which may allocate from this object).
+
+    bsl::vector<Stack> snapshot(d_allocator_p);
+    bsls::Types::Int64 numLive    = 0;
+    bsls::Types::Int64 numSamples = 0;
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        for (const Stack *stack = d_stacks_p;
+             stack;
+             stack = stack->d_nextStack_p) {
+            snapshot.push_back(*stack);
+        }
+        numLive    = d_numLive;
+        numSamples = d_numSamples;
+    }
+
+    // Entries were prepended to the list as they were created; report them in
+    // order of creation.
+
+    bsl::reverse(snapshot.begin(), snapshot.end());
+
+    const bsl::ios_base::fmtflags flags = stream.flags();
+    stream << bsl::dec;
+
+    if (e_PPROF == format) {
+        bsls::Types::Int64 liveBytes    = 0;
+        bsls::Types::Int64 sampledBytes = 0;
+        for (bsl::size_t i = 0; i < snapshot.size(); ++i) {
+            liveBytes    += snapshot[i].d_liveBytes;
+            sampledBytes += snapshot[i].d_sampledBytes;
+        }
+
+        stream << "heap profile: "
+               << bsl::setw(6) << numLive      << ": "
+               << bsl::setw(8) << liveBytes    << " ["
+               << bsl::setw(6) << numSamples   << ": "
+               << bsl::setw(8) << sampledBytes << "] @ heap_v2/"
+               << d_samplePeriod << '\n';
+
+        for (bsl::size_t i = 0; i < snapshot.size(); ++i) {
+            const Stack& stack = snapshot[i];
+
+            stream << bsl::setw(6) << stack.d_numLive      << ": "
+                   << bsl::setw(8) << stack.d_liveBytes    << " ["
+                   << bsl::setw(6) << stack.d_numSamples   << ": "
+                   << bsl::setw(8) << stack.d_sampledBytes << "] @";
+            printStack(stream, stack.d_frames, stack.d_depth);
+            stream << '\n';
+        }
+
+        stream << "\nMAPPED_LIBRARIES:\n";
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+        bsl::ifstream maps("/proc/self/maps");
+        if (maps.is_open()) {
+            stream << maps.rdbuf();
+        }
+#endif
+    }
+    else {
+        BSLS_ASSERT(e_TEXT == format);
+
+        // Scale each entry by the inverse of the probability that a block of
+        // the mean size of its live samples is sampled.
+
+        bsl::vector<Estimate> estimates(d_allocator_p);
+        double                totalBytes  = 0;
+        double                totalBlocks = 0;
+
+        for (bsl::size_t i = 0; i < snapshot.size(); ++i) {
+            const Stack& stack = snapshot[i];
+
+            if (0 == stack.d_numLive) {
+                continue;
+            }
+
+            const double meanSize =
+                             static_cast<double>(stack.d_liveBytes)
+                           / static_cast<double>(stack.d_numLive);
+            const double scale    = 1.0
+                                  / (1.0 - bsl::exp(-meanSize
+                                       / static_cast<double>(d_samplePeriod)));
+
+            Estimate estimate;
+            estimate.d_bytes  = static_cast<double>(stack.d_liveBytes) * scale;
+            estimate.d_blocks = static_cast<double>(stack.d_numLive)   * scale;
+            estimate.d_index  = static_cast<int>(i);
+            estimates.push_back(estimate);
+
+            totalBytes  += estimate.d_bytes;
+            totalBlocks += estimate.d_blocks;
+        }
+
+        bsl::sort(estimates.begin(), estimates.end(), &greaterBytes);
+
+        stream << "Heap profile: 1 in " << d_samplePeriod
+               << " bytes sampled, "    << numLive
+               << " live samples ("     << numSamples << " taken)\n"
+               << "Estimated in use: "
+               << static_cast<bsls::Types::Int64>(totalBytes + 0.5)
+               << " bytes in "
+               << static_cast<bsls::Types::Int64>(totalBlocks + 0.5)
+               << " blocks\n";
+
+        for (bsl::size_t i = 0; i < estimates.size(); ++i) {
+            const Estimate& estimate = estimates[i];
+            const Stack&    stack    = snapshot[estimate.d_index];
+
+            stream << '#' << i + 1 << ": "
+                   << static_cast<bsls::Types::Int64>(estimate.d_bytes + 0.5)
+                   << " bytes in "
+                   << static_cast<bsls::Types::Int64>(estimate.d_blocks + 0.5)
+                   << " blocks (" << stack.d_numLive << " samples)\n    @";
+            printStack(stream, stack.d_frames, stack.d_depth);
+            stream << '\n';
+        }
+    }
+
+    stream.flags(flags);
+
+    return stream;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
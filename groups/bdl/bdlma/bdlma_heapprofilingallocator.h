@@ -0,0 +1,424 @@
+// bdlma_heapprofilingallocator.h                                     -*-C++-*-
+#ifndef INCLUDED_BDLMA_HEAPPROFILINGALLOCATOR
+#define INCLUDED_BDLMA_HEAPPROFILINGALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator that samples allocations for heap profiles.
+//
+//@CLASSES:
+//  bdlma::HeapProfilingAllocator: samples allocations by bytes requested
+//
+//@SEE_ALSO: bdlma_countingallocator, bdlma_samplingguardedallocator
+//
+//@DESCRIPTION: This component provides a concrete allocation mechanism,
+// 'bdlma::HeapProfilingAllocator', that implements the 'bslma::Allocator'
+// protocol, forwards every request to an allocator supplied at construction,
+// and records the call stack of a pseudo-random sample of the allocations
+// made of it, chosen so that on average one sample is taken for every
+// 'samplePeriod' bytes allocated.  The allocator keeps a table of the sampled
+// blocks that are still in use (the *live* samples), aggregated by call stack,
+// from which it can print, on demand, a heap profile attributing the memory
+// in use (and the memory allocated over the life of the allocator) to the
+// call stacks that allocated it:
+//..
+//   ,-----------------------------.
+//  ( bdlma::HeapProfilingAllocator )
+//   `-----------------------------'
+//                  |         ctor/dtor
+//                  |         numLiveSamples
+//                  |         numSamples
+//                  |         printProfile
+//                  |         samplePeriod
+//                  V
+//          ,----------------.
+//         ( bslma::Allocator )
+//          `----------------'
+//                            allocate
+//                            deallocate
+//..
+// Unlike 'bslma::TestAllocator', which tracks every block, this allocator is
+// intended to run in production, to find the call sites that drive the growth
+// of a process's memory footprint: the cost of an unsampled request is that of
+// the wrapped allocator, plus the decrement of a countdown private to the
+// calling thread and a well-predicted branch, and no memory is added to an
+// unsampled block.  With the default sample period of 512 KiB, the cost of
+// capturing a call stack for each sampled request is negligible.
+//
+///Sampling
+///--------
+// Sampling is modeled as a Poisson process over the bytes requested: sample
+// points are placed along the sequence of bytes requested of the allocator,
+// with distances between successive points drawn from an exponential
+// distribution whose mean is 'samplePeriod', and a request is sampled if at
+// least one point falls within the bytes it requests.  The allocator
+// maintains, for each thread that uses it, a countdown of the bytes until the
+// next sample point, from which the size of each request made by that thread
+// is subtracted.  The request that brings the countdown to zero (or below) is
+// sampled, and the next distance is added to the countdown, so that the bytes
+// of the request beyond the sample point are carried over (if the request
+// spans more than one sample point, the next point is instead placed a new
+// distance beyond its end, which the memoryless distribution permits).  Hence,
+// a request of 'size' bytes is sampled with probability
+// '1 - exp(-size / samplePeriod)', independently of the requests that
+// preceded it, and a sample of 'n' such blocks represents, in expectation,
+// 'n / (1 - exp(-size / samplePeriod))' blocks.  The first request made by a
+// thread starts its countdown at a new distance.  Distances are drawn from a
+// single generator under the internal lock, which is therefore acquired only
+// when the countdown of some thread runs out (or starts).
+//
+///Sampled Blocks
+///--------------
+// Blocks are obtained from the wrapped allocator as requested, with no header.
+// Instead, the allocator records each sampled block that is in use in a hash
+// table of 16384 chains, keyed by address.  A deallocation tests (without the
+// lock) whether the chain of the block address is empty, and searches the
+// chain, under the lock, only if it is not.  The table occupies 128 KiB (on
+// 64-bit platforms).  While there are fewer than a few thousand live samples
+// (about one for every 'samplePeriod' bytes in use, for blocks much smaller
+// than 'samplePeriod'), most chains are empty, and the lock is rarely
+// acquired by the deallocation of an unsampled block; with 'n' live samples,
+// the fraction of such deallocations that acquire it is about
+// '1 - exp(-n / 16384)'.
+//
+///Call Stacks
+///-----------
+// The call stack of a sampled request is captured by 'backtrace' on Linux and
+// Darwin, and by 'CaptureStackBackTrace' on Windows, and consists of the
+// return addresses of (at most 'k_MAX_STACK_DEPTH') active calls, starting
+// with the call to 'allocate'.  On other platforms, only the return address of
+// the call to 'allocate' is captured, if the compiler supports
+// '__builtin_return_address'.  Samples having the same call stack are
+// aggregated into a single entry of the profile.  Entries, once created, are
+// never released until the allocator is destroyed, so that the profile also
+// reports the (sampled) allocations made over the life of the allocator.
+//
+// The metadata of the samples (and of the call stacks) is allocated from the
+// wrapped allocator, and is not itself sampled.
+//
+///Profile Formats
+///---------------
+// The 'printProfile' method writes a profile in one of two formats.  The
+// 'e_PPROF' format is the legacy text heap profile format understood by the
+// 'pprof' tool (as written by 'gperftools'), in which each entry reports the
+// number of live samples and their bytes, and the number of samples taken
+// (live or not) and their bytes, followed by the call stack:
+//..
+//  heap profile:    3:   147456 [    10:   491520] @ heap_v2/524288
+//       2:    98304 [     7:   344064] @ 0x4005d6 0x4006b2 0x7f31c4a2
+//       1:    49152 [     3:   147456] @ 0x400610 0x4006b2 0x7f31c4a2
+//
+//  MAPPED_LIBRARIES:
+//  00400000-00401000 r-xp 00000000 08:01 1311 /usr/local/bin/service
+//  ...
+//..
+// The header names the sample period, from which 'pprof' scales the sampled
+// counts to estimates of the actual counts (as described in {Sampling}), and
+// the memory map of the process (read from '/proc/self/maps', and therefore
+// available on Linux only) allows 'pprof' to symbolize the addresses.
+//
+// The 'e_TEXT' format is intended to be read directly.  It lists the entries
+// having live samples in decreasing order of the estimated number of bytes in
+// use, reporting the estimated bytes and blocks in use and the call stack of
+// each entry:
+//..
+//  Heap profile: 1 in 524288 bytes sampled, 3 live samples (10 taken)
+//  Estimated in use: 147729 bytes in 3 blocks
+//  #1: 98486 bytes in 2 blocks (2 samples)
+//      @ 0x4005d6 0x4006b2 0x7f31c4a2
+//  #2: 49243 bytes in 1 blocks (1 samples)
+//      @ 0x400610 0x4006b2 0x7f31c4a2
+//..
+// In both formats, addresses are written in hexadecimal, and can be mapped to
+// source locations with a symbolizer such as 'addr2line'.
+//
+///Thread Safety
+///-------------
+// The 'bdlma::HeapProfilingAllocator' class is fully thread-safe (see
+// 'bsldoc_glossary') provided that the wrapped allocator is fully
+// thread-safe.  The table of samples is managed under an internal lock, which
+// is acquired only by sampled requests (and the first request of each
+// thread), by the deallocation of a block whose chain of sampled blocks is
+// not empty (see {Sampled Blocks}), and (briefly) by 'printProfile', which
+// formats the profile after releasing the lock.  Note that 'printProfile' may
+// therefore be called with a stream that allocates from the profiled
+// allocator.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Source of Memory Growth
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that the memory footprint of a long-running service grows slowly,
+// and that we want to find out which code holds on to the memory.  We install
+// a heap profiling allocator as the default allocator at startup, and print a
+// profile when the footprint is large.
+//
+// First, we create an allocator that takes one sample for every 4096 bytes
+// allocated (on average), wrapping the allocator that the service would use
+// otherwise, and install it as the default allocator:
+//..
+//  bdlma::HeapProfilingAllocator profiler(4096);
+//  bslma::DefaultAllocatorGuard  guard(&profiler);
+//..
+// Then, the service runs.  Here, it caches 64 KiB of data per request and
+// forgets to prune the cache, while it also allocates (and releases) small
+// temporary blocks:
+//..
+//  void *cache[100];
+//  for (int i = 0; i < 100; ++i) {
+//      void *temporary = profiler.allocate(100);
+//      cache[i]        = profiler.allocate(65536);
+//      profiler.deallocate(temporary);
+//  }
+//..
+// Now, we observe that every cached block has been sampled (since the
+// probability that a block of 65536 bytes escapes the sample is
+// 'exp(-65536 / 4096)', about one in 9 million), while most temporary
+// blocks have not:
+//..
+//  assert(100 <= profiler.numLiveSamples());
+//  assert(100 <= profiler.numSamples());
+//..
+// Finally, we print a profile, which attributes the bulk of the memory in use
+// to the call stack that filled the cache:
+//..
+//  bsl::ostringstream profile;
+//  profiler.printProfile(profile, bdlma::HeapProfilingAllocator::e_TEXT);
+//
+//  for (int i = 0; i < 100; ++i) {
+//      profiler.deallocate(cache[i]);
+//  }
+//..
+// The profile begins as follows (the call stacks will differ):
+//..
+//  Heap profile: 1 in 4096 bytes sampled, 100 live samples (101 taken)
+//  Estimated in use: 6553600 bytes in 100 blocks
+//  #1: 6553600 bytes in 100 blocks (100 samples)
+//      @ 0x4016d3 0x401ec0 0x7f3a5c1d
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_SAMPLINGCOUNTDOWN
+#include <bdlma_samplingcountdown.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOSFWD
+#include <bsl_iosfwd.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                        // ============================
+                        // class HeapProfilingAllocator
+                        // ============================
+
+class HeapProfilingAllocator : public bslma::Allocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'bslma::Allocator' protocol, forwards every request to
+    // the allocator supplied at construction, and records the call stacks of
+    // a pseudo-random sample of the requests, weighted by size, in a table
+    // from which a heap profile can be printed on demand.
+
+  public:
+    // TYPES
+    enum ProfileFormat {
+        // Enumerate the formats in which a profile can be printed.
+
+        e_PPROF,  // legacy heap profile format understood by 'pprof'
+        e_TEXT    // human-readable summary of the samples in use
+    };
+
+    // CONSTANTS
+    enum {
+        k_DEFAULT_SAMPLE_PERIOD = 512 * 1024,  // default 'samplePeriod'
+        k_MAX_STACK_DEPTH       = 32           // maximum number of return
+                                               // addresses captured per sample
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Stack;   // samples having one call stack (defined in the
+                    // implementation)
+
+    struct Sample;  // sampled block in use (defined in the implementation)
+
+    typedef bsls::AtomicOperations::AtomicTypes::Pointer SampleChain;
+        // head of a chain of 'Sample' entries, tested for emptiness without
+        // the lock
+
+    // DATA
+    SamplingCountdown      d_countdown;     // bytes to go until the next
+                                            // sample point of each thread
+
+    bsls::Types::Int64     d_samplePeriod;  // mean distance between sample
+                                            // points
+
+    bsls::Types::Uint64    d_randomState;   // state of the generator of
+                                            // sample distances
+
+    Stack                **d_table_p;       // hash table of call stacks
+
+    Stack                 *d_stacks_p;      // list of all call stacks
+
+    SampleChain           *d_samples_p;     // hash table of sampled blocks
+                                            // in use
+
+    bsls::Types::Int64     d_numLive;       // number of live samples
+
+    bsls::Types::Int64     d_numSamples;    // number of samples taken
+
+    mutable bsls::BslLock  d_lock;          // guards the sample table
+
+    bslma::Allocator      *d_allocator_p;   // wrapped allocator (held, not
+                                            // owned)
+
+  private:
+    // PRIVATE MANIPULATORS
+    bsls::Types::Int64 nextDistance();
+        // Return a pseudo-random, exponentially distributed distance (in
+        // bytes), having a mean of 'samplePeriod()', to the next sample point.
+        // The behavior is undefined unless the internal lock is held by the
+        // calling thread.
+
+    void *allocateSampled(size_type    size,
+                          void *const *frames,
+                          int          depth);
+        // Return a newly-allocated block of the specified 'size' (in bytes)
+        // obtained from the wrapped allocator, recording it as a live sample
+        // allocated by the call stack having the specified 'depth' return
+        // addresses at the specified 'frames'.  If an exception is thrown, no
+        // memory is allocated and no sample is recorded.
+
+    bool resetCountdown(bsls::Types::Int64 countdown);
+        // Reset the countdown of the calling thread, whose value after
+        // deducting the size of the current request is the specified
+        // 'countdown', to the next sample point.  Return 'true' if the
+        // current request is sampled, and 'false' otherwise.  The current
+        // request is not sampled only if it is the first request of the
+        // calling thread, and falls short of the first sample point.  The
+        // behavior is undefined unless '0 >= countdown'.
+
+    void releaseSample(const void *address);
+        // Remove the live sample of the block at the specified 'address', if
+        // that block is sampled.
+
+  private:
+    // NOT IMPLEMENTED
+    HeapProfilingAllocator(const HeapProfilingAllocator&);
+    HeapProfilingAllocator& operator=(const HeapProfilingAllocator&);
+
+  public:
+    // CREATORS
+    explicit
+    HeapProfilingAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit
+    HeapProfilingAllocator(bsls::Types::Int64  samplePeriod,
+                           bslma::Allocator   *basicAllocator = 0);
+        // Create a heap profiling allocator that samples, on average, one
+        // request in every 'k_DEFAULT_SAMPLE_PERIOD' bytes requested, or in
+        // every specified 'samplePeriod' bytes requested.  Optionally specify
+        // a 'basicAllocator' to which every request is forwarded, and used to
+        // supply the sample table.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.  The behavior is undefined
+        // unless '0 < samplePeriod'.
+
+    virtual ~HeapProfilingAllocator();
+        // Destroy this allocator object, releasing its sample table.  The
+        // behavior is undefined unless every block allocated from this
+        // allocator has been deallocated.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated block of memory of the specified 'size' (in
+        // bytes), obtained from the wrapped allocator, recording the call
+        // stack of this call if the request is sampled (see {Sampling}).  If
+        // 'size' is 0, no memory is allocated and 0 is returned.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to the
+        // wrapped allocator, removing its sample (if any) from the live
+        // samples.  If 'address' is 0, this method has no effect.  The
+        // behavior is undefined unless 'address' was returned by 'allocate'
+        // and has not already been deallocated.
+
+    // ACCESSORS
+    bsls::Types::Int64 numLiveSamples() const;
+        // Return the number of sampled blocks that are currently in use.
+
+    bsls::Types::Int64 numSamples() const;
+        // Return the number of blocks that have been sampled since this
+        // allocator was created.
+
+    bsl::ostream& printProfile(bsl::ostream&  stream,
+                               ProfileFormat  format = e_PPROF) const;
+        // Write a heap profile of the samples of this allocator to the
+        // specified 'stream' in the optionally specified 'format' (see
+        // {Profile Formats}), and return a reference to 'stream'.  If 'format'
+        // is not specified, the 'pprof' format is used.  Note that the memory
+        // used to format the profile is obtained from the wrapped allocator
+        // (and from the allocator of 'stream').
+
+    bsls::Types::Int64 samplePeriod() const;
+        // Return the mean number of bytes requested between samples.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                        // ----------------------------
+                        // class HeapProfilingAllocator
+                        // ----------------------------
+
+// ACCESSORS
+inline
+bsls::Types::Int64 HeapProfilingAllocator::samplePeriod() const
+{
+    return d_samplePeriod;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
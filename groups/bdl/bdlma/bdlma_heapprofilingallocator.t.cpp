@@ -0,0 +1,986 @@
+// bdlma_heapprofilingallocator.t.cpp                                 -*-C++-*-
+#include <bdlma_heapprofilingallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cmath.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+  #include <windows.h>  // 'CreateThread'
+#else
+  #include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::HeapProfilingAllocator' forwards every request to a wrapped
+// allocator, and records the call stack of a pseudo-random sample of the
+// requests, weighted by size.  We verify that blocks are correctly aligned
+// and returned to the wrapped allocator, that the sampling rate matches the
+// exponential model documented in the component header, that samples are
+// aggregated by call stack and removed from the live samples when their
+// blocks are deallocated, and that the profiles printed in both formats
+// report the samples.  A sample period of 1 byte is used wherever the test
+// requires every request (of more than a few hundred bytes) to be sampled,
+// since a request of 'size' bytes then escapes the sample with probability
+// 'exp(-size)'.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] HeapProfilingAllocator(bslma::Allocator *ba = 0);
+// [ 2] HeapProfilingAllocator(Int64 samplePeriod, *ba = 0);
+// [ 2] ~HeapProfilingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 3] bsls::Types::Int64 numLiveSamples() const;
+// [ 3] bsls::Types::Int64 numSamples() const;
+// [ 5] bsl::ostream& printProfile(bsl::ostream&, ProfileFormat) const;
+// [ 2] bsls::Types::Int64 samplePeriod() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+// [ 4] CONCERN: Requests are sampled with probability '1 - exp(-s / P)'.
+// [ 5] CONCERN: Samples are aggregated by call stack.
+// [ 6] CONCERN: The 'allocate' and 'deallocate' methods are thread-safe.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::HeapProfilingAllocator Obj;
+typedef bsls::Types::Int64            Int64;
+typedef bsls::Types::UintPtr          UintPtr;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                   HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+static
+void *allocateFromSiteA(Obj *allocator, bslma::Allocator::size_type size)
+    // Return a block of the specified 'size' allocated from the specified
+    // 'allocator'.
+{
+    return allocator->allocate(size);
+}
+
+static
+void *allocateFromSiteB(Obj *allocator, bslma::Allocator::size_type size)
+    // Return a block of the specified 'size' allocated from the specified
+    // 'allocator' by a different call than 'allocateFromSiteA'.
+{
+    void *block = allocator->allocate(size);
+    return block;
+}
+
+static
+bool hasStack(const bsl::string& line)
+    // Return 'true' if the specified 'line' of a profile ends with a call
+    // stack of at least one hexadecimal address, and 'false' otherwise.
+{
+    const bsl::string::size_type at = line.find(" @ 0x");
+    return bsl::string::npos != at
+        && bsl::string::npos == line.find_first_not_of(" 0123456789abcdefx",
+                                                       at + 2);
+}
+
+namespace TestCase6 {
+
+struct ThreadInfo {
+    int  d_numIterations;
+    int  d_seed;
+    Obj *d_obj_p;
+};
+
+extern "C" void *threadFunction(void *arg)
+{
+    ThreadInfo *info = (ThreadInfo *)arg;
+
+    Obj& mX = *info->d_obj_p;
+
+    enum { k_NUM_HELD = 8 };
+
+    void     *held[k_NUM_HELD]  = { 0 };
+    int       sizes[k_NUM_HELD] = { 0 };
+    unsigned  seed              = info->d_seed;
+
+    for (int i = 0; i < info->d_numIterations; ++i) {
+        seed = seed * 1103515245 + 12345;
+
+        const int j = (seed >> 16) % k_NUM_HELD;
+
+        if (held[j]) {
+            for (int k = 0; k < sizes[j]; ++k) {
+                ASSERTV(j, k, static_cast<char>(j) ==
+                                             static_cast<char *>(held[j])[k]);
+            }
+            mX.deallocate(held[j]);
+        }
+
+        sizes[j] = 1 + (seed >> 8) % 200;
+        held[j]  = mX.allocate(sizes[j]);
+        bsl::memset(held[j], j, sizes[j]);
+    }
+
+    for (int j = 0; j < k_NUM_HELD; ++j) {
+        mX.deallocate(held[j]);
+    }
+
+    return arg;
+}
+
+}  // close namespace TestCase6
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator         defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Source of Memory Growth
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that the memory footprint of a long-running service grows slowly,
+// and that we want to find out which code holds on to the memory.  We install
+// a heap profiling allocator as the default allocator at startup, and print a
+// profile when the footprint is large.
+//
+// First, we create an allocator that takes one sample for every 4096 bytes
+// allocated (on average), wrapping the allocator that the service would use
+// otherwise, and install it as the default allocator:
+//..
+    bdlma::HeapProfilingAllocator profiler(4096);
+    bslma::DefaultAllocatorGuard  guard(&profiler);
+//..
+// Then, the service runs.  Here, it caches 64 KiB of data per request and
+// forgets to prune the cache, while it also allocates (and releases) small
+// temporary blocks:
+//..
+    void *cache[100];
+    for (int i = 0; i < 100; ++i) {
+        void *temporary = profiler.allocate(100);
+        cache[i]        = profiler.allocate(65536);
+        profiler.deallocate(temporary);
+    }
+//..
+// Now, we observe that every cached block has been sampled (since the
+// probability that a block of 65536 bytes escapes the sample is
+// 'exp(-65536 / 4096)', about one in 9 million), while most temporary
+// blocks have not:
+//..
+    ASSERT(100 <= profiler.numLiveSamples());
+    ASSERT(100 <= profiler.numSamples());
+//..
+// Finally, we print a profile, which attributes the bulk of the memory in use
+// to the call stack that filled the cache:
+//..
+    bsl::ostringstream profile;
+    profiler.printProfile(profile, bdlma::HeapProfilingAllocator::e_TEXT);
+
+    for (int i = 0; i < 100; ++i) {
+        profiler.deallocate(cache[i]);
+    }
+//..
+// The profile begins as follows (the call stacks will differ):
+//..
+//  Heap profile: 1 in 4096 bytes sampled, 100 live samples (101 taken)
+//  Estimated in use: 6553600 bytes in 100 blocks
+//  #1: 6553600 bytes in 100 blocks (100 samples)
+//      @ 0x4016d3 0x401ec0 0x7f3a5c1d
+//..
+        if (veryVerbose) {
+            cout << profile.str();
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 The 'allocate' and 'deallocate' methods are thread-safe, and the
+        //:   counts of samples are consistent after concurrent use.
+        //
+        // Plan:
+        //: 1 Create an allocator that samples frequently, and have several
+        //:   threads concurrently allocate, fill, verify, and deallocate
+        //:   blocks of varying sizes.  Verify that no block is corrupted, that
+        //:   no sample remains live, and that all memory is returned.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: The 'allocate' and 'deallocate' methods are thread-safe.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY TEST" << endl
+                          << "================" << endl;
+
+        using namespace TestCase6;
+
+        enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 20000 };
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX(256, &ta);  const Obj& X = mX;
+
+            ThreadInfo info[k_NUM_THREADS];
+            ThreadId   ids[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                info[i].d_numIterations = k_NUM_ITERATIONS;
+                info[i].d_seed          = i + 1;
+                info[i].d_obj_p         = &mX;
+
+                ids[i] = createThread(&threadFunction, &info[i]);
+            }
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            ASSERT(0 == X.numLiveSamples());
+            ASSERT(0 <  X.numSamples());
+
+            if (veryVerbose) {
+                P(X.numSamples());
+            }
+
+            ostringstream os(&ta);
+            X.printProfile(os);
+            ASSERT(string::npos != os.str().find("heap profile:      0:"));
+        }
+
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CALL STACKS AND PROFILES
+        //
+        // Concerns:
+        //: 1 Samples of blocks allocated by the same call stack are aggregated
+        //:   into a single entry, and samples from different call sites into
+        //:   different entries.
+        //:
+        //: 2 An entry reports its live samples and bytes, and its samples
+        //:   taken and bytes, and is kept when it has no live samples.
+        //:
+        //: 3 The 'e_PPROF' profile has the header and entry lines of the
+        //:   legacy heap profile format, naming the sample period, followed
+        //:   by the memory map of the process.
+        //:
+        //: 4 The 'e_TEXT' profile lists only the entries having live samples,
+        //:   in decreasing order of estimated bytes in use, scaled by the
+        //:   inverse of the probability of sampling.
+        //:
+        //: 5 'printProfile' returns the stream, and restores its format flags.
+        //:
+        //: 6 'printProfile' may be called with a stream that allocates from
+        //:   the allocator being profiled.
+        //
+        // Plan:
+        //: 1 Using a sample period of 1 byte, allocate blocks repeatedly from
+        //:   two call sites, deallocate some, and verify the lines of the
+        //:   profile in each format.  (C-1..5)
+        //:
+        //: 2 Print a profile to a stream that allocates from the allocator
+        //:   being profiled.  (C-6)
+        //:
+        //: 3 Using a large sample period, allocate blocks of 1 byte until one
+        //:   is sampled, and verify that the estimate in the 'e_TEXT' profile
+        //:   is scaled up.  (C-4)
+        //
+        // Testing:
+        //   bsl::ostream& printProfile(bsl::ostream&, ProfileFormat) const;
+        //   CONCERN: Samples are aggregated by call stack.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CALL STACKS AND PROFILES" << endl
+                          << "========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            void *blocksA[10];
+            void *blocksB[3];
+
+            for (int i = 0; i < 10; ++i) {
+                blocksA[i] = allocateFromSiteA(&mX, 1000);
+            }
+            for (int i = 0; i < 3; ++i) {
+                blocksB[i] = allocateFromSiteB(&mX, 5000);
+            }
+            for (int i = 0; i < 4; ++i) {
+                mX.deallocate(blocksA[i]);
+            }
+
+            ASSERT(9  == X.numLiveSamples());
+            ASSERT(13 == X.numSamples());
+
+            if (verbose) cout << "\tThe 'e_PPROF' format." << endl;
+            {
+                ostringstream os(&ta);
+                os << hex;
+
+                ASSERT(&os == &X.printProfile(os));
+                ASSERT(os.flags() & ios_base::hex);
+
+                if (veryVerbose) cout << os.str() << endl;
+
+                istringstream is(os.str(), &ta);
+                string        line(&ta);
+
+                getline(is, line);
+                ASSERTV(line, "heap profile:      9:    21000 [    13:    "
+                              "25000] @ heap_v2/1" == line);
+
+                getline(is, line);
+                ASSERTV(line, 0 == line.find("     6:     6000 [    10:    "
+                                             "10000] @ 0x"));
+                ASSERTV(line, hasStack(line));
+
+                getline(is, line);
+                ASSERTV(line, 0 == line.find("     3:    15000 [     3:    "
+                                             "15000] @ 0x"));
+                ASSERTV(line, hasStack(line));
+
+                getline(is, line);
+                ASSERTV(line, line.empty());
+
+                getline(is, line);
+                ASSERTV(line, "MAPPED_LIBRARIES:" == line);
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+                getline(is, line);
+                ASSERTV(line, !line.empty());
+#endif
+            }
+
+            if (verbose) cout << "\tThe 'e_TEXT' format." << endl;
+
+            for (int i = 0; i < 3; ++i) {
+                mX.deallocate(blocksB[i]);
+            }
+            for (int i = 0; i < 3; ++i) {
+                blocksB[i] = allocateFromSiteB(&mX, 500);
+            }
+
+            // Site A now has 6 live blocks of 1000 bytes, and site B 3 live
+            // blocks of 500 bytes, each sampled with probability 1 (to within
+            // 'exp(-500)').
+
+            {
+                ostringstream os(&ta);
+                X.printProfile(os, Obj::e_TEXT);
+
+                if (veryVerbose) cout << os.str() << endl;
+
+                istringstream is(os.str(), &ta);
+                string        line(&ta);
+
+                getline(is, line);
+                ASSERTV(line, "Heap profile: 1 in 1 bytes sampled, 9 live "
+                              "samples (16 taken)" == line);
+
+                getline(is, line);
+                ASSERTV(line, "Estimated in use: 7500 bytes in 9 blocks"
+                                                                    == line);
+
+                getline(is, line);
+                ASSERTV(line, "#1: 6000 bytes in 6 blocks (6 samples)"
+                                                                    == line);
+                getline(is, line);
+                ASSERTV(line, 0 == line.find("    @ 0x"));
+
+                getline(is, line);
+                ASSERTV(line, "#2: 1500 bytes in 3 blocks (3 samples)"
+                                                                    == line);
+                getline(is, line);
+                ASSERTV(line, 0 == line.find("    @ 0x"));
+
+                ASSERT(!getline(is, line));
+            }
+
+            if (verbose) cout << "\tPrinting to a profiled stream." << endl;
+            {
+                ostringstream os(&mX);
+                X.printProfile(os, Obj::e_TEXT);
+                X.printProfile(os, Obj::e_PPROF);
+
+                ASSERT(string::npos != os.str().find("MAPPED_LIBRARIES:"));
+            }
+
+            for (int i = 4; i < 10; ++i) {
+                mX.deallocate(blocksA[i]);
+            }
+            for (int i = 0; i < 3; ++i) {
+                mX.deallocate(blocksB[i]);
+            }
+
+            ASSERT(0 == X.numLiveSamples());
+
+            {
+                ostringstream os(&ta);
+                X.printProfile(os, Obj::e_TEXT);
+
+                ASSERT(string::npos != os.str().find(
+                                   "Estimated in use: 0 bytes in 0 blocks\n"));
+                ASSERT(string::npos == os.str().find("#1"));
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tScaling of estimates." << endl;
+        {
+            Obj mX(1 << 20, &ta);  const Obj& X = mX;
+
+            void *block = 0;
+            while (0 == X.numLiveSamples()) {
+                mX.deallocate(block);
+                block = mX.allocate(1);
+            }
+
+            // A block of 1 byte is sampled with probability '1 - exp(-1/P)',
+            // so it represents (about) 'P' blocks, and 'P' bytes.
+
+            ostringstream os(&ta);
+            X.printProfile(os, Obj::e_TEXT);
+
+            if (veryVerbose) cout << os.str() << endl;
+
+            ASSERT(string::npos != os.str().find("#1: 104857"));
+            ASSERT(string::npos != os.str().find(" bytes in 104857"));
+            ASSERT(string::npos != os.str().find(" blocks (1 samples)"));
+
+            mX.deallocate(block);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // SAMPLING RATE
+        //
+        // Concerns:
+        //: 1 A request of 's' bytes is sampled with probability
+        //:   '1 - exp(-s / P)', where 'P' is the sample period, for requests
+        //:   much smaller than, comparable to, and larger than 'P'.
+        //:
+        //: 2 A request is sampled independently of the size of the requests
+        //:   that precede it.
+        //
+        // Plan:
+        //: 1 For each of several combinations of sample period and request
+        //:   size, allocate and deallocate a large number of blocks, and
+        //:   verify that the number of samples is within 5% of the expected
+        //:   number (which is at least 6 standard deviations).  (C-1)
+        //:
+        //: 2 Interleave requests of two sizes and verify that the number of
+        //:   samples is within 5% of the expected number.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: Requests are sampled with probability '1 - exp(-s / P)'.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SAMPLING RATE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        static const struct {
+            int d_line;
+            int d_period;
+            int d_size;
+            int d_numRequests;
+        } DATA[] = {
+            //LINE  PERIOD  SIZE  REQUESTS
+            //----  ------  ----  --------
+            { L_,     1024,   16,  1000000 },
+            { L_,     1024,   64,   250000 },
+            { L_,     1024, 1024,    20000 },
+            { L_,     1024, 4096,    50000 },
+            { L_,   524288, 8192,  1000000 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE     = DATA[ti].d_line;
+            const int PERIOD   = DATA[ti].d_period;
+            const int SIZE     = DATA[ti].d_size;
+            const int REQUESTS = DATA[ti].d_numRequests;
+
+            Obj mX(PERIOD, &ta);  const Obj& X = mX;
+
+            for (int i = 0; i < REQUESTS; ++i) {
+                mX.deallocate(mX.allocate(SIZE));
+            }
+
+            const double EXPECTED = REQUESTS
+                                  * (1 - bsl::exp(-double(SIZE) / PERIOD));
+            const double ACTUAL   = static_cast<double>(X.numSamples());
+
+            if (veryVerbose) {
+                P_(LINE) P_(EXPECTED) P(ACTUAL)
+            }
+
+            ASSERTV(LINE, EXPECTED, ACTUAL,
+                    bsl::fabs(ACTUAL - EXPECTED) < 0.05 * EXPECTED);
+            ASSERTV(LINE, 0 == X.numLiveSamples());
+        }
+
+        if (verbose) cout << "\tInterleaved sizes." << endl;
+        {
+            Obj mX(1000, &ta);  const Obj& X = mX;
+
+            for (int i = 0; i < 100000; ++i) {
+                mX.deallocate(mX.allocate(10));
+                mX.deallocate(mX.allocate(2000));
+            }
+
+            const double EXPECTED = 100000 * ((1 - bsl::exp(-0.01))
+                                            + (1 - bsl::exp(-2.0)));
+            const double ACTUAL   = static_cast<double>(X.numSamples());
+
+            if (veryVerbose) {
+                P_(EXPECTED) P(ACTUAL)
+            }
+
+            ASSERTV(EXPECTED, ACTUAL,
+                    bsl::fabs(ACTUAL - EXPECTED) < 0.05 * EXPECTED);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ALLOCATE AND DEALLOCATE
+        //
+        // Concerns:
+        //: 1 'allocate' returns a block of the requested size, obtained from
+        //:   the wrapped allocator; an unsampled block has no memory added to
+        //:   it.
+        //:
+        //: 2 'allocate(0)' returns 0 and allocates no memory, and
+        //:   'deallocate(0)' has no effect.
+        //:
+        //: 3 A sampled block adds a live sample, which is removed when the
+        //:   block is deallocated; an unsampled block does not affect the
+        //:   samples.
+        //:
+        //: 4 'deallocate' returns the block to the wrapped allocator.
+        //:
+        //: 5 If the wrapped allocator throws while a request is sampled, no
+        //:   memory is leaked, no sample is recorded, and the allocator
+        //:   remains usable (in particular, its lock is not left held).
+        //
+        // Plan:
+        //: 1 Allocate blocks of various sizes from an allocator with a sample
+        //:   period of 1 byte (so that blocks of more than a few hundred
+        //:   bytes are always sampled), and with a very large period (so that
+        //:   small blocks are almost never sampled), and verify the blocks,
+        //:   the samples, and the wrapped allocator.  (C-1..4)
+        //:
+        //: 2 Using a sample period of 1 byte, allocate blocks in the presence
+        //:   of injected exceptions, and verify the samples and the memory in
+        //:   use after each exception.  (C-5)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   bsls::Types::Int64 numLiveSamples() const;
+        //   bsls::Types::Int64 numSamples() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE AND DEALLOCATE" << endl
+                          << "=======================" << endl;
+
+        const int MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\tEvery block sampled." << endl;
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            const Int64 NUM_BLOCKS = ta.numBlocksInUse();
+            const Int64 NUM_BYTES  = ta.numBytesInUse();
+
+            ASSERT(0 == mX.allocate(0));
+            ASSERT(NUM_BLOCKS == ta.numBlocksTotal());
+            mX.deallocate(0);
+
+            void *blocks[8];
+            int   totalSize = 0;
+            for (int i = 0; i < 8; ++i) {
+                const int SIZE = 1000 + 7 * i;
+
+                blocks[i] = mX.allocate(SIZE);
+                ASSERTV(i, 0 == reinterpret_cast<UintPtr>(blocks[i])
+                                                               % MAX_ALIGN);
+                bsl::memset(blocks[i], 0xa5, SIZE);
+
+                totalSize += SIZE;
+
+                ASSERTV(i, i + 1 == X.numLiveSamples());
+                ASSERTV(i, i + 1 == X.numSamples());
+            }
+
+            // Allow for the sample of each block and the entry of the call
+            // stack (and nothing else).
+
+            ASSERT(NUM_BLOCKS + 8 + 8 + 1 == ta.numBlocksInUse());
+            ASSERT(NUM_BYTES + totalSize  <  ta.numBytesInUse());
+
+            for (int i = 0; i < 8; ++i) {
+                mX.deallocate(blocks[i]);
+
+                ASSERTV(i, 7 - i == X.numLiveSamples());
+                ASSERTV(i, 8     == X.numSamples());
+            }
+            ASSERT(NUM_BLOCKS + 1 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNo block sampled." << endl;
+        {
+            Obj mX(Int64(1) << 50, &ta);  const Obj& X = mX;
+
+            const Int64 NUM_BLOCKS = ta.numBlocksInUse();
+            const Int64 NUM_BYTES  = ta.numBytesInUse();
+
+            for (int size = 1; size <= 100; ++size) {
+                void *block = mX.allocate(size);
+                ASSERTV(size,
+                        0 == reinterpret_cast<UintPtr>(block) % MAX_ALIGN);
+                bsl::memset(block, 0xa5, size);
+
+                ASSERTV(size, NUM_BLOCKS + 1 == ta.numBlocksInUse());
+                ASSERTV(size, NUM_BYTES + size == ta.numBytesInUse());
+
+                mX.deallocate(block);
+            }
+
+            ASSERT(0 == X.numSamples());
+            ASSERT(NUM_BLOCKS == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tException neutrality." << endl;
+        {
+            bslma::TestAllocator testAllocator("exception", veryVeryVerbose);
+
+            Obj mX(1, &testAllocator);  const Obj& X = mX;
+
+            const Int64 NUM_BLOCKS = testAllocator.numBlocksInUse();
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(testAllocator) {
+                const Int64 NUM_SAMPLES = X.numSamples();
+
+                ASSERT(0 == X.numLiveSamples());
+                ASSERT(NUM_BLOCKS == testAllocator.numBlocksInUse()
+                    || NUM_BLOCKS + 1 == testAllocator.numBlocksInUse());
+
+                void *block = mX.allocate(1000);
+
+                ASSERT(1               == X.numLiveSamples());
+                ASSERT(NUM_SAMPLES + 1 == X.numSamples());
+
+                mX.deallocate(block);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            // Only the entry of the call stack remains.
+
+            ASSERT(0              == X.numLiveSamples());
+            ASSERT(NUM_BLOCKS + 1 == testAllocator.numBlocksInUse());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CTORS, DTOR, AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor sets the sample period, and uses the supplied
+        //:   allocator or, if none is supplied, the default allocator.
+        //:
+        //: 2 A new object has no samples.
+        //:
+        //: 3 The destructor releases all memory allocated by the object.
+        //
+        // Plan:
+        //: 1 Create objects with each constructor, with and without an
+        //:   allocator, and verify the accessors and the memory used.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   HeapProfilingAllocator(bslma::Allocator *ba = 0);
+        //   HeapProfilingAllocator(Int64 samplePeriod, *ba = 0);
+        //   ~HeapProfilingAllocator();
+        //   bsls::Types::Int64 samplePeriod() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CTORS, DTOR, AND BASIC ACCESSORS" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(Obj::k_DEFAULT_SAMPLE_PERIOD == X.samplePeriod());
+            ASSERT(0 == X.numLiveSamples());
+            ASSERT(0 == X.numSamples());
+            ASSERT(0 <  defaultAllocator.numBlocksInUse());
+
+            void *block = mX.allocate(1);
+            mX.deallocate(block);
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(Obj::k_DEFAULT_SAMPLE_PERIOD == X.samplePeriod());
+            ASSERT(1 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        {
+            Obj mX(12345);  const Obj& X = mX;
+
+            ASSERT(12345 == X.samplePeriod());
+            ASSERT(0 <  defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            ASSERT(1 == X.samplePeriod());
+            ASSERT(0 == X.numSamples());
+
+            void *block = mX.allocate(1000);
+            ASSERT(1 == X.numSamples());
+            mX.deallocate(block);
+
+            ASSERT(1 < ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of various sizes, and print a
+        //:   profile in each format.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX(64, &ta);  const Obj& X = mX;
+
+            void *blocks[10];
+            for (int i = 0; i < 10; ++i) {
+                blocks[i] = mX.allocate(16 * (i + 1));
+                bsl::memset(blocks[i], i, 16 * (i + 1));
+            }
+
+            ASSERT(0 < X.numSamples());
+            ASSERT(X.numSamples() == X.numLiveSamples());
+
+            ostringstream os(&ta);
+            X.printProfile(os);
+            X.printProfile(os, Obj::e_TEXT);
+
+            if (veryVerbose) cout << os.str() << endl;
+
+            for (int i = 0; i < 10; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            ASSERT(0 == X.numLiveSamples());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
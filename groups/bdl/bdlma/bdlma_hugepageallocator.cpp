@@ -0,0 +1,246 @@
+// bdlma_hugepageallocator.cpp                                        -*-C++-*-
+#include <bdlma_hugepageallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_hugepageallocator_cpp,"$Id$ $CSID$")
+
+#include <bslmf_assert.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+
+#include <sys/mman.h>  // 'madvise', 'mmap', 'munmap'
+#include <unistd.h>    // 'sysconf'
+
+#endif
+
+namespace BloombergLP {
+
+namespace {
+
+typedef bslma::Allocator::size_type size_type;
+
+union Header {
+    // This 'union' precedes each block returned by 'allocate', and records
+    // the length of the mapping holding the block, or 0 if the block was
+    // obtained from the basic allocator.
+
+    size_type                           d_mappedSize;  // length of mapping,
+                                                       // or 0
+
+    bsls::AlignmentUtil::MaxAlignedType d_dummy;       // force maximum
+                                                       // alignment
+};
+
+BSLMF_ASSERT(0 == (bdlma::HugePageAllocator::k_HUGE_PAGE_SIZE
+                 & (bdlma::HugePageAllocator::k_HUGE_PAGE_SIZE - 1)));
+
+// HELPER FUNCTIONS
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+
+size_type getSystemPageSize()
+    // Return the size (in bytes) of a system memory page.
+{
+    static bsls::AtomicInt pageSize(0);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == pageSize.loadRelaxed())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        pageSize = static_cast<int>(sysconf(_SC_PAGESIZE));
+    }
+
+    return pageSize.loadRelaxed();
+}
+
+#endif
+
+void *systemMap(size_type size, bool prefault)
+    // Create an anonymous read/write mapping of the specified 'size' (in
+    // bytes), aligned to 'HugePageAllocator::k_HUGE_PAGE_SIZE' and advised to
+    // be backed by huge pages.  If the specified 'prefault' is 'true', fault
+    // in every page of the mapping.  Return the address of the mapping, or 0
+    // if it cannot be created.  The behavior is undefined unless 'size' is a
+    // positive multiple of the system page size.
+{
+    BSLS_ASSERT(0 < size);
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+
+    const size_type alignment = bdlma::HugePageAllocator::k_HUGE_PAGE_SIZE;
+    const size_type pageSize  = getSystemPageSize();
+
+    BSLS_ASSERT(0 == size % pageSize);
+
+    // Over-reserve by a huge page so that an aligned region of 'size' bytes
+    // lies within the reservation, then unmap the slack on either side.
+
+    const size_type reservedSize = size + alignment;
+
+    void *reserved = mmap(0,
+                          reservedSize,
+                          PROT_READ | PROT_WRITE,
+                          MAP_ANON | MAP_PRIVATE,
+                          -1,
+                          0);
+
+    if (MAP_FAILED == reserved) {
+        return 0;                                                     // RETURN
+    }
+
+    char *base   = static_cast<char *>(reserved);
+    char *region = base + bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                        base,
+                                                        static_cast<int>(
+                                                                  alignment));
+
+    const size_type leading  = static_cast<size_type>(region - base);
+    const size_type trailing = reservedSize - leading - size;
+
+    if (leading) {
+        munmap(base, leading);
+    }
+    if (trailing) {
+        munmap(region + size, trailing);
+    }
+
+#ifdef MADV_HUGEPAGE
+    // A failure means that transparent huge pages are unavailable, in which
+    // case the mapping is backed by ordinary pages.
+
+    madvise(region, size, MADV_HUGEPAGE);
+#endif
+
+    if (prefault) {
+        bool populated = false;
+
+#ifdef MADV_POPULATE_WRITE
+        populated = 0 == madvise(region, size, MADV_POPULATE_WRITE);
+#endif
+
+        if (!populated) {
+            volatile char *page = region;
+            for (size_type offset = 0; offset < size; offset += pageSize) {
+                page[offset] = 0;
+            }
+        }
+    }
+
+    return region;
+
+#else
+
+    (void) size;
+    (void) prefault;
+    return 0;
+
+#endif
+}
+
+void systemUnmap(void *address, size_type size)
+    // Remove the mapping of the specified 'size' (in bytes) at the specified
+    // 'address'.  The behavior is undefined unless 'address' and 'size'
+    // describe a mapping created by 'systemMap'.
+{
+    BSLS_ASSERT(address);
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+
+    munmap(static_cast<char *>(address), size);
+
+#else
+
+    (void) address;
+    (void) size;
+
+#endif
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                         // -----------------------
+                         // class HugePageAllocator
+                         // -----------------------
+
+// CREATORS
+HugePageAllocator::~HugePageAllocator()
+{
+}
+
+// MANIPULATORS
+void *HugePageAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    const size_type totalSize = size + sizeof(Header);
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+    if (totalSize >= d_minimumMappedSize) {
+        const size_type pageSize   = getSystemPageSize();
+        const size_type mappedSize = (totalSize + pageSize - 1)
+                                                             & ~(pageSize - 1);
+        const bool      prefault   = e_PREFAULT == d_prefaultPolicy;
+
+        Header *header = static_cast<Header *>(systemMap(mappedSize,
+                                                         prefault));
+
+        if (header) {
+            header->d_mappedSize = mappedSize;
+            d_numBytesMapped.addRelaxed(mappedSize);
+            return header + 1;                                        // RETURN
+        }
+    }
+#endif
+
+    Header *header = static_cast<Header *>(d_allocator_p->allocate(totalSize));
+    header->d_mappedSize = 0;
+    return header + 1;
+}
+
+void HugePageAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    Header *header = static_cast<Header *>(address) - 1;
+
+    const size_type mappedSize = header->d_mappedSize;
+
+    if (mappedSize) {
+        d_numBytesMapped.addRelaxed(
+                                 -static_cast<bsls::Types::Int64>(mappedSize));
+        systemUnmap(header, mappedSize);
+    }
+    else {
+        d_allocator_p->deallocate(header);
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,334 @@
+// bdlma_hugepageallocator.h                                          -*-C++-*-
+#ifndef INCLUDED_BDLMA_HUGEPAGEALLOCATOR
+#define INCLUDED_BDLMA_HUGEPAGEALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an upstream allocator mapping large blocks on huge pages.
+//
+//@CLASSES:
+//  bdlma::HugePageAllocator: allocator mapping large blocks on huge pages
+//
+//@SEE_ALSO: bdlma_blocklist, bdlma_infrequentdeleteblocklist,
+//           bdlma_sequentialallocator
+//
+//@DESCRIPTION: This component provides a concrete allocation mechanism,
+// 'bdlma::HugePageAllocator', that implements the 'bslma::Allocator' protocol
+// and supplies each sufficiently large block from its own anonymous memory
+// mapping, aligned to a huge-page boundary and marked as eligible for
+// transparent huge pages:
+//..
+//   ,------------------------.
+//  ( bdlma::HugePageAllocator )
+//   `------------------------'
+//               |         ctor/dtor
+//               |         minimumMappedSize
+//               |         numBytesMapped
+//               |         prefaultPolicy
+//               V
+//      ,----------------.
+//     ( bslma::Allocator )
+//      `----------------'
+//                         allocate
+//                         deallocate
+//..
+// A 'HugePageAllocator' is intended to be used as the *upstream* allocator of
+// the managed allocators and pools in 'bdlma', which obtain their memory in
+// large, infrequently allocated blocks through a 'bdlma::BlockList' or a
+// 'bdlma::InfrequentDeleteBlockList'.  Backing those blocks by 2 MiB pages
+// reduces the number of TLB misses incurred when the memory is used, and the
+// number of page faults incurred when it is first touched.
+//
+///Mapped and Unmapped Blocks
+///--------------------------
+// A request whose size (plus a small header) is at least the minimum mapped
+// size supplied at construction (by default 'k_HUGE_PAGE_SIZE') is satisfied
+// by a new anonymous mapping whose start is aligned to 'k_HUGE_PAGE_SIZE' and
+// whose length is a multiple of the system page size.  The mapping is
+// advised ('MADV_HUGEPAGE') to be backed by transparent huge pages, and is
+// unmapped when the block is deallocated.  Smaller requests, which could not
+// occupy a huge page by themselves, are forwarded to the basic allocator
+// supplied at construction.
+//
+// The allocator falls back cleanly where huge pages are unavailable: if the
+// kernel does not support (or has disabled) transparent huge pages, the
+// advice is ignored and the mapping is backed by ordinary pages; if the
+// mapping cannot be created (or the platform does not provide 'mmap'), the
+// request is forwarded to the basic allocator.
+//
+///Prefaulting
+///-----------
+// If 'e_PREFAULT' is supplied at construction, every page of a new mapping is
+// faulted in before the block is returned, moving the cost of first-touch
+// page faults from the code using the memory to the allocation itself.  Note
+// that the pages are populated *after* the huge-page advice is given (using
+// 'MADV_POPULATE_WRITE' where available, and by touching each page
+// otherwise); mapping the region with 'MAP_POPULATE' instead would populate
+// it with ordinary pages before the advice could take effect.
+//
+///Thread Safety
+///-------------
+// The 'bdlma::HugePageAllocator' class is fully thread-safe (see
+// 'bsldoc_glossary') provided that the basic allocator supplied at
+// construction is fully thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Backing a Block List by Huge Pages
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a request-processing arena obtains its memory in large blocks
+// from a 'bdlma::InfrequentDeleteBlockList'.  We can back the blocks by huge
+// pages by supplying a 'bdlma::HugePageAllocator' to the block list.
+//
+// First, we create the huge-page allocator, asking it to prefault the memory
+// it maps, and the block list that uses it:
+//..
+//  bdlma::HugePageAllocator hugePageAllocator(
+//                                      bdlma::HugePageAllocator::e_PREFAULT);
+//
+//  bdlma::InfrequentDeleteBlockList blockList(&hugePageAllocator);
+//..
+// Then, we allocate a large block, which is mapped directly:
+//..
+//  const int BLOCK_SIZE = 4 * bdlma::HugePageAllocator::k_HUGE_PAGE_SIZE;
+//
+//  char *block = static_cast<char *>(blockList.allocate(BLOCK_SIZE));
+//  block[0] = block[BLOCK_SIZE - 1] = 'x';
+//
+//  assert(BLOCK_SIZE < hugePageAllocator.numBytesMapped());
+//..
+// Next, we allocate a small block, which is obtained from the default
+// allocator instead:
+//..
+//  const bsls::Types::Int64 numBytesMapped =
+//                                         hugePageAllocator.numBytesMapped();
+//
+//  blockList.allocate(100);
+//
+//  assert(numBytesMapped == hugePageAllocator.numBytesMapped());
+//..
+// Finally, we release the blocks, which unmaps the large one:
+//..
+//  blockList.release();
+//
+//  assert(0 == hugePageAllocator.numBytesMapped());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                         // -----------------------
+                         // class HugePageAllocator
+                         // -----------------------
+
+class HugePageAllocator : public bslma::Allocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'bslma::Allocator' protocol, and supplies each block of
+    // at least a minimum size from its own anonymous memory mapping, aligned
+    // to a huge-page boundary and advised to be backed by transparent huge
+    // pages.  Smaller blocks are supplied by an (optionally specified) basic
+    // allocator.
+
+  public:
+    // TYPES
+    enum {
+        k_HUGE_PAGE_SIZE = 2 * 1024 * 1024  // size (in bytes) of a huge page,
+                                            // and alignment of each mapping
+    };
+
+    enum PrefaultPolicy {
+        // Enumerate the configuration options for 'HugePageAllocator' that may
+        // be (optionally) supplied at construction.
+
+        e_NO_PREFAULT,  // pages of a mapping are faulted in on first touch
+        e_PREFAULT      // pages of a mapping are faulted in when it is
+                        // created
+    };
+
+  private:
+    // DATA
+    PrefaultPolicy     d_prefaultPolicy;     // whether new mappings are
+                                             // faulted in immediately
+
+    size_type          d_minimumMappedSize;  // smallest request (including
+                                             // header) satisfied by a mapping
+
+    bsls::AtomicInt64  d_numBytesMapped;     // number of bytes currently
+                                             // mapped by this allocator
+
+    bslma::Allocator  *d_allocator_p;        // allocator for blocks that are
+                                             // not mapped (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    HugePageAllocator(const HugePageAllocator&);
+    HugePageAllocator& operator=(const HugePageAllocator&);
+
+  public:
+    // CREATORS
+    explicit
+    HugePageAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit
+    HugePageAllocator(PrefaultPolicy    prefaultPolicy,
+                      bslma::Allocator *basicAllocator = 0);
+    HugePageAllocator(PrefaultPolicy    prefaultPolicy,
+                      size_type         minimumMappedSize,
+                      bslma::Allocator *basicAllocator = 0);
+        // Create a huge-page allocator.  Optionally specify a
+        // 'prefaultPolicy' indicating whether the pages of each new mapping
+        // are faulted in before the block is returned.  If 'prefaultPolicy' is
+        // not specified, pages are faulted in on first touch.  Optionally
+        // specify a 'minimumMappedSize' (in bytes), the smallest request
+        // (including a header of maximal alignment) that is satisfied by a
+        // new mapping.  If 'minimumMappedSize' is not specified,
+        // 'k_HUGE_PAGE_SIZE' is used.  Optionally specify a 'basicAllocator'
+        // used to supply smaller blocks, and blocks that cannot be mapped.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 < minimumMappedSize'.
+
+    virtual ~HugePageAllocator();
+        // Destroy this allocator object.  Note that destroying this allocator
+        // has no effect on any outstanding allocated memory.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated maximally-aligned block of memory of the
+        // specified 'size' (in bytes).  If 'size' is 0, no memory is
+        // allocated and 0 is returned.  If 'size' plus the header of this
+        // allocator is at least the minimum mapped size of this allocator,
+        // the block is placed in a new anonymous mapping, aligned to
+        // 'k_HUGE_PAGE_SIZE' and advised to be backed by huge pages, when such
+        // a mapping can be created; otherwise, the block is obtained from the
+        // basic allocator.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // allocator.  If 'address' is 0, this method has no effect.  If the
+        // block was placed in its own mapping, the mapping is removed;
+        // otherwise, the block is returned to the basic allocator.  The
+        // behavior is undefined unless 'address' was returned by 'allocate'
+        // and has not already been deallocated.
+
+    // ACCESSORS
+    size_type minimumMappedSize() const;
+        // Return the smallest request (in bytes, including the header of this
+        // allocator) that this allocator satisfies by a new mapping.
+
+    bsls::Types::Int64 numBytesMapped() const;
+        // Return the number of bytes currently mapped by this allocator.  Note
+        // that this count includes the header and the rounding of each
+        // mapping to a multiple of the system page size, and excludes blocks
+        // obtained from the basic allocator.
+
+    PrefaultPolicy prefaultPolicy() const;
+        // Return the prefault policy of this allocator.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                         // -----------------------
+                         // class HugePageAllocator
+                         // -----------------------
+
+// CREATORS
+inline
+HugePageAllocator::HugePageAllocator(bslma::Allocator *basicAllocator)
+: d_prefaultPolicy(e_NO_PREFAULT)
+, d_minimumMappedSize(k_HUGE_PAGE_SIZE)
+, d_numBytesMapped(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+inline
+HugePageAllocator::HugePageAllocator(PrefaultPolicy    prefaultPolicy,
+                                     bslma::Allocator *basicAllocator)
+: d_prefaultPolicy(prefaultPolicy)
+, d_minimumMappedSize(k_HUGE_PAGE_SIZE)
+, d_numBytesMapped(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+inline
+HugePageAllocator::HugePageAllocator(PrefaultPolicy    prefaultPolicy,
+                                     size_type         minimumMappedSize,
+                                     bslma::Allocator *basicAllocator)
+: d_prefaultPolicy(prefaultPolicy)
+, d_minimumMappedSize(minimumMappedSize)
+, d_numBytesMapped(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT_SAFE(0 < minimumMappedSize);
+}
+
+// ACCESSORS
+inline
+bslma::Allocator::size_type HugePageAllocator::minimumMappedSize() const
+{
+    return d_minimumMappedSize;
+}
+
+inline
+bsls::Types::Int64 HugePageAllocator::numBytesMapped() const
+{
+    return d_numBytesMapped.loadRelaxed();
+}
+
+inline
+HugePageAllocator::PrefaultPolicy HugePageAllocator::prefaultPolicy() const
+{
+    return d_prefaultPolicy;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
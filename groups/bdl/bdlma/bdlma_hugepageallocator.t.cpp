@@ -0,0 +1,617 @@
+// bdlma_hugepageallocator.t.cpp                                      -*-C++-*-
+#include <bdlma_hugepageallocator.h>
+
+#include <bdlma_infrequentdeleteblocklist.h>  // for testing only
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_asserttest.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+  #include <unistd.h>   // 'sysconf'
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::HugePageAllocator' is an allocator mechanism that places each large
+// block in its own huge-page-aligned mapping, and forwards smaller requests to
+// a basic allocator.  The primary concerns are that requests are routed to
+// the correct source according to the minimum mapped size, that mappings are
+// aligned, sized, and accounted for correctly, and that every block is
+// returned to its source on deallocation.  Whether the kernel actually backs a
+// mapping by huge pages is not observable in a portable way, and is not
+// tested.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] HugePageAllocator(Allocator *ba = 0);
+// [ 2] HugePageAllocator(PrefaultPolicy pp, Allocator *ba = 0);
+// [ 2] HugePageAllocator(PrefaultPolicy pp, size_type mms, *ba = 0);
+// [ 2] ~HugePageAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 2] size_type minimumMappedSize() const;
+// [ 3] bsls::Types::Int64 numBytesMapped() const;
+// [ 2] PrefaultPolicy prefaultPolicy() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+// [ *] CONCERN: In no case does memory come from the global allocator.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::HugePageAllocator Obj;
+typedef Obj::size_type           size_type;
+
+enum {
+    HUGE_PAGE_SIZE = Obj::k_HUGE_PAGE_SIZE,
+    MAX_ALIGN      = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+};
+
+// The header preceding each block is one maximally-aligned unit.
+
+const size_type HEADER_SIZE = MAX_ALIGN;
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+const bool MAPPING_SUPPORTED = true;
+#else
+const bool MAPPING_SUPPORTED = false;
+#endif
+
+// ============================================================================
+//                                MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+    int veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+    const size_type pageSize = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+#else
+    const size_type pageSize = 4096;
+#endif
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da(veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Backing a Block List by Huge Pages
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a request-processing arena obtains its memory in large blocks
+// from a 'bdlma::InfrequentDeleteBlockList'.  We can back the blocks by huge
+// pages by supplying a 'bdlma::HugePageAllocator' to the block list.
+//
+// First, we create the huge-page allocator, asking it to prefault the memory
+// it maps, and the block list that uses it:
+//..
+    bdlma::HugePageAllocator hugePageAllocator(
+                                        bdlma::HugePageAllocator::e_PREFAULT);
+
+    bdlma::InfrequentDeleteBlockList blockList(&hugePageAllocator);
+//..
+// Then, we allocate a large block, which is mapped directly:
+//..
+    const int BLOCK_SIZE = 4 * bdlma::HugePageAllocator::k_HUGE_PAGE_SIZE;
+
+    char *block = static_cast<char *>(blockList.allocate(BLOCK_SIZE));
+    block[0] = block[BLOCK_SIZE - 1] = 'x';
+
+    if (MAPPING_SUPPORTED) {
+    ASSERT(BLOCK_SIZE < hugePageAllocator.numBytesMapped());
+    }
+//..
+// Next, we allocate a small block, which is obtained from the default
+// allocator instead:
+//..
+    const bsls::Types::Int64 numBytesMapped =
+                                           hugePageAllocator.numBytesMapped();
+
+    blockList.allocate(100);
+
+    ASSERT(numBytesMapped == hugePageAllocator.numBytesMapped());
+//..
+// Finally, we release the blocks, which unmaps the large one:
+//..
+    blockList.release();
+
+    ASSERT(0 == hugePageAllocator.numBytesMapped());
+//..
+
+        ASSERT(0 == da.numBytesInUse());
+
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns 0 for a request of 0 bytes, and 'deallocate'
+        //:   has no effect for a null address.
+        //:
+        //: 2 A request that, together with the header, is smaller than the
+        //:   minimum mapped size is satisfied by the basic allocator.
+        //:
+        //: 3 A request that, together with the header, is at least the
+        //:   minimum mapped size is satisfied by a new mapping that starts on
+        //:   a huge-page boundary and whose length is the header plus the
+        //:   request rounded up to the system page size, as reported by
+        //:   'numBytesMapped'.
+        //:
+        //: 4 The returned memory is maximally aligned and writable, and the
+        //:   memory of a new mapping is initially zero, irrespective of the
+        //:   prefault policy.
+        //:
+        //: 5 'deallocate' returns each block to its source, and removes the
+        //:   mapping of a mapped block from the 'numBytesMapped' count.
+        //
+        // Plan:
+        //: 1 Allocate 0 bytes, and deallocate a null address, and verify that
+        //:   neither the basic allocator nor 'numBytesMapped' is affected.
+        //:   (C-1)
+        //:
+        //: 2 For each prefault policy and for each of a set of minimum mapped
+        //:   sizes, allocate blocks of sizes on either side of the threshold,
+        //:   verify their source using a test allocator as the basic
+        //:   allocator and 'numBytesMapped', verify the alignment of the
+        //:   mappings, verify that mapped memory is zero, and overwrite every
+        //:   byte of each block.  (C-2..4)
+        //:
+        //: 3 Deallocate each block and verify that the test allocator and
+        //:   'numBytesMapped' return to their prior values.  (C-5)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   bsls::Types::Int64 numBytesMapped() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'allocate' AND 'deallocate'" << endl
+                                  << "===========================" << endl;
+
+        if (verbose) cout << "\nTesting 0-sized requests and null addresses."
+                          << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+            Obj                  mX(&ta);  const Obj& X = mX;
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+
+            ASSERT(0 == ta.numBlocksTotal());
+            ASSERT(0 == X.numBytesMapped());
+        }
+
+        if (verbose) cout << "\nTesting routing of requests." << endl;
+
+        const Obj::PrefaultPolicy POLICIES[] = { Obj::e_NO_PREFAULT,
+                                                 Obj::e_PREFAULT };
+        const int NUM_POLICIES = sizeof POLICIES / sizeof *POLICIES;
+
+        const size_type MINIMUMS[] = { 1,
+                                       pageSize,
+                                       HUGE_PAGE_SIZE / 2,
+                                       HUGE_PAGE_SIZE };
+        const int NUM_MINIMUMS = sizeof MINIMUMS / sizeof *MINIMUMS;
+
+        for (int ti = 0; ti < NUM_POLICIES; ++ti) {
+            const Obj::PrefaultPolicy POLICY = POLICIES[ti];
+
+            for (int tj = 0; tj < NUM_MINIMUMS; ++tj) {
+                const size_type MINIMUM = MINIMUMS[tj];
+
+                if (veryVerbose) { T_ P_(POLICY) P(MINIMUM) }
+
+                bslma::TestAllocator ta(veryVeryVeryVerbose);
+                Obj                  mX(POLICY, MINIMUM, &ta);
+                const Obj&           X = mX;
+
+                const size_type SIZES[] = { 1,
+                                            MINIMUM - HEADER_SIZE - 1,
+                                            MINIMUM - HEADER_SIZE,
+                                            MINIMUM,
+                                            3 * HUGE_PAGE_SIZE + 5 };
+                const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+                for (int tk = 0; tk < NUM_SIZES; ++tk) {
+                    const size_type SIZE = SIZES[tk];
+
+                    if (0 == SIZE || SIZE > 4 * HUGE_PAGE_SIZE) {
+                        continue;  // 'MINIMUM' too small for this size
+                    }
+
+                    const bool MAPPED = MAPPING_SUPPORTED
+                                     && SIZE + HEADER_SIZE >= MINIMUM;
+
+                    const size_type EXP_MAPPED =
+                        MAPPED
+                        ? (SIZE + HEADER_SIZE + pageSize - 1) & ~(pageSize - 1)
+                        : 0;
+
+                    if (veryVeryVerbose) { T_ T_ P_(SIZE) P(MAPPED) }
+
+                    const bsls::Types::Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+                    char *p = static_cast<char *>(mX.allocate(SIZE));
+
+                    LOOP3_ASSERT(POLICY, MINIMUM, SIZE,
+                                 0 == bsls::Types::UintPtr(p) % MAX_ALIGN);
+
+                    LOOP3_ASSERT(POLICY, MINIMUM, SIZE,
+                                 (MAPPED ? NUM_BLOCKS : NUM_BLOCKS + 1)
+                                                       == ta.numBlocksInUse());
+
+                    LOOP3_ASSERT(POLICY, MINIMUM, SIZE,
+                            static_cast<bsls::Types::Int64>(EXP_MAPPED)
+                                                        == X.numBytesMapped());
+
+                    if (MAPPED) {
+                        const char *mapping = p - HEADER_SIZE;
+
+                        LOOP3_ASSERT(POLICY, MINIMUM, SIZE,
+                                     0 == bsls::Types::UintPtr(mapping)
+                                                            % HUGE_PAGE_SIZE);
+
+                        LOOP3_ASSERT(POLICY, MINIMUM, SIZE,
+                                     0 == p[0] && 0 == p[SIZE - 1]
+                                               && 0 == p[SIZE / 2]);
+                    }
+
+                    bsl::memset(p, 0xa5, SIZE);
+
+                    mX.deallocate(p);
+
+                    LOOP3_ASSERT(POLICY, MINIMUM, SIZE,
+                                 NUM_BLOCKS == ta.numBlocksInUse());
+                    LOOP3_ASSERT(POLICY, MINIMUM, SIZE,
+                                 0 == X.numBytesMapped());
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting multiple outstanding blocks." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+            Obj                  mX(Obj::e_NO_PREFAULT, pageSize, &ta);
+            const Obj&           X = mX;
+
+            void *a = mX.allocate(10);
+            void *b = mX.allocate(pageSize);
+            void *c = mX.allocate(2 * pageSize);
+
+            ASSERT(1 == ta.numBlocksInUse());
+
+            if (MAPPING_SUPPORTED) {
+                ASSERT(static_cast<bsls::Types::Int64>(5 * pageSize)
+                                                        == X.numBytesMapped());
+            }
+
+            mX.deallocate(b);
+
+            if (MAPPING_SUPPORTED) {
+                ASSERT(static_cast<bsls::Types::Int64>(3 * pageSize)
+                                                        == X.numBytesMapped());
+            }
+
+            mX.deallocate(a);
+            mX.deallocate(c);
+
+            ASSERT(0 == ta.numBlocksInUse());
+            ASSERT(0 == X.numBytesMapped());
+        }
+
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CTORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor sets the prefault policy and the minimum mapped
+        //:   size to the specified values, or to 'e_NO_PREFAULT' and
+        //:   'k_HUGE_PAGE_SIZE' if they are not specified.
+        //:
+        //: 2 Each constructor uses the specified basic allocator, or the
+        //:   default allocator if none is specified, for unmapped blocks.
+        //:
+        //: 3 No memory is allocated or mapped at construction.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create objects using each constructor, with and without a basic
+        //:   allocator, and verify the values returned by the accessors.
+        //:   Allocate a small block from each, and verify that it comes from
+        //:   the expected allocator.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a minimum mapped size of 0.  (C-4)
+        //
+        // Testing:
+        //   HugePageAllocator(Allocator *ba = 0);
+        //   HugePageAllocator(PrefaultPolicy pp, Allocator *ba = 0);
+        //   HugePageAllocator(PrefaultPolicy pp, size_type mms, *ba = 0);
+        //   ~HugePageAllocator();
+        //   size_type minimumMappedSize() const;
+        //   PrefaultPolicy prefaultPolicy() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CTORS AND ACCESSORS" << endl
+                                  << "===================" << endl;
+
+        bslma::TestAllocator         da(veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        for (char cfg = 'a'; cfg <= 'f'; ++cfg) {
+            const char CONFIG = cfg;
+
+            if (veryVerbose) { T_ P(CONFIG) }
+
+            bslma::TestAllocator  sa(veryVeryVeryVerbose);
+
+            Obj                  *objPtr;
+            bslma::TestAllocator *expAlloc;
+
+            Obj::PrefaultPolicy   expPolicy  = Obj::e_NO_PREFAULT;
+            size_type             expMinimum = HUGE_PAGE_SIZE;
+
+            switch (CONFIG) {
+              case 'a': {
+                objPtr   = new (sa) Obj();
+                expAlloc = &da;
+              } break;
+              case 'b': {
+                objPtr   = new (sa) Obj(&sa);
+                expAlloc = &sa;
+              } break;
+              case 'c': {
+                objPtr    = new (sa) Obj(Obj::e_PREFAULT);
+                expAlloc  = &da;
+                expPolicy = Obj::e_PREFAULT;
+              } break;
+              case 'd': {
+                objPtr    = new (sa) Obj(Obj::e_PREFAULT, &sa);
+                expAlloc  = &sa;
+                expPolicy = Obj::e_PREFAULT;
+              } break;
+              case 'e': {
+                objPtr     = new (sa) Obj(Obj::e_NO_PREFAULT, 1000);
+                expAlloc   = &da;
+                expMinimum = 1000;
+              } break;
+              case 'f': {
+                objPtr     = new (sa) Obj(Obj::e_PREFAULT, 1000, &sa);
+                expAlloc   = &sa;
+                expPolicy  = Obj::e_PREFAULT;
+                expMinimum = 1000;
+              } break;
+              default: {
+                LOOP_ASSERT(CONFIG, !"Bad allocator config.");
+                return testStatus;                                    // RETURN
+              } break;
+            }
+
+            Obj& mX = *objPtr;  const Obj& X = mX;
+
+            const bsls::Types::Int64 NUM_BLOCKS = expAlloc->numBlocksInUse();
+
+            LOOP_ASSERT(CONFIG, expPolicy  == X.prefaultPolicy());
+            LOOP_ASSERT(CONFIG, expMinimum == X.minimumMappedSize());
+            LOOP_ASSERT(CONFIG, 0          == X.numBytesMapped());
+            LOOP_ASSERT(CONFIG, 0          == da.numBlocksInUse());
+
+            void *p = mX.allocate(8);
+
+            LOOP_ASSERT(CONFIG, NUM_BLOCKS + 1 == expAlloc->numBlocksInUse());
+
+            mX.deallocate(p);
+
+            LOOP_ASSERT(CONFIG, NUM_BLOCKS == expAlloc->numBlocksInUse());
+
+            sa.deleteObject(objPtr);
+
+            LOOP_ASSERT(CONFIG, 0 == sa.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_SAFE_PASS_RAW(Obj(Obj::e_PREFAULT, 1));
+            ASSERT_SAFE_FAIL_RAW(Obj(Obj::e_PREFAULT, size_type(0)));
+        }
+
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an allocator using a test allocator, allocate a small and
+        //:   a large block, write to them, and deallocate them.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            char *small = static_cast<char *>(mX.allocate(100));
+            ASSERT(small);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            char *large = static_cast<char *>(mX.allocate(HUGE_PAGE_SIZE));
+            ASSERT(large);
+
+            bsl::memset(small, 'a', 100);
+            bsl::memset(large, 'b', HUGE_PAGE_SIZE);
+
+            if (MAPPING_SUPPORTED) {
+                ASSERT(1 == ta.numBlocksInUse());
+                ASSERT(HUGE_PAGE_SIZE < X.numBytesMapped());
+            }
+
+            mX.deallocate(large);
+            mX.deallocate(small);
+
+            ASSERT(0 == ta.numBlocksInUse());
+            ASSERT(0 == X.numBytesMapped());
+        }
+
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -41,6 +41,54 @@ namespace bdlma {
                   // class InfrequentDeleteBlockList
                   // -------------------------------
 
+// PRIVATE CLASS METHODS
+int InfrequentDeleteBlockList::usableSize(const Block *block)
+{
+    // The payload follows the header, whose size is that of a 'Block' less
+    // its trailing, maximally-aligned 'd_memory' member (see
+    // 'alignedAllocationSize').
+
+    return block->d_size - static_cast<int>(sizeof(Block))
+                         + bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+}
+
+// PRIVATE MANIPULATORS
+InfrequentDeleteBlockList::Block *
+InfrequentDeleteBlockList::allocateBlock(int size)
+{
+    // Retained blocks are kept in increasing order of size, so the first
+    // sufficient block is the smallest one.
+
+    Block **link = &d_retained_p;
+    while (*link && (*link)->d_size < size) {
+        link = &(*link)->d_next_p;
+    }
+
+    Block *block = *link;
+
+    if (block) {
+        *link = block->d_next_p;
+    }
+    else {
+        block = reinterpret_cast<Block *>(d_allocator_p->allocate(size));
+
+        BSLS_ASSERT(0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                     reinterpret_cast<void *>(block),
+                                     bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT));
+
+        block->d_size = size;
+    }
+
+    block->d_next_p = d_head_p;
+    d_head_p        = block;
+
+    BSLS_ASSERT(0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                    reinterpret_cast<void *>(&block->d_memory),
+                                    bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT));
+
+    return block;
+}
+
 // CREATORS
 InfrequentDeleteBlockList::~InfrequentDeleteBlockList()
 {
@@ -56,20 +104,26 @@ void *InfrequentDeleteBlockList::allocate(int size)
         return 0;                                                     // RETURN
     }
 
-    size = alignedAllocationSize(size, sizeof(Block));
+    Block *block = allocateBlock(alignedAllocationSize(size, sizeof(Block)));
 
-    Block *block = reinterpret_cast<Block *>(d_allocator_p->allocate(size));
+    return reinterpret_cast<void *>(&block->d_memory);
+}
 
-    BSLS_ASSERT(0 == bsls::AlignmentUtil::calculateAlignmentOffset(
-                                     reinterpret_cast<void *>(block),
-                                     bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT));
+void *InfrequentDeleteBlockList::allocateAndExpand(int *size)
+{
+    BSLS_ASSERT(size);
+    BSLS_ASSERT(0 < *size);
 
-    block->d_next_p = d_head_p;
-    d_head_p        = block;
+    const int  blockSize = alignedAllocationSize(*size, sizeof(Block));
+    Block     *block     = allocateBlock(blockSize);
 
-    BSLS_ASSERT(0 == bsls::AlignmentUtil::calculateAlignmentOffset(
-                                    reinterpret_cast<void *>(&block->d_memory),
-                                    bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT));
+    // Only a reused block can be larger than the allocation computed for the
+    // request; the rounding slack of a block of that allocation size is not
+    // reported.
+
+    if (blockSize < block->d_size) {
+        *size = usableSize(block);
+    }
 
     return reinterpret_cast<void *>(&block->d_memory);
 }
@@ -81,6 +135,76 @@ void InfrequentDeleteBlockList::release()
         d_head_p        = d_head_p->d_next_p;
         d_allocator_p->deallocate(lastBlock);
     }
+
+    while (d_retained_p) {
+        void *lastBlock = d_retained_p;
+        d_retained_p    = d_retained_p->d_next_p;
+        d_allocator_p->deallocate(lastBlock);
+    }
+}
+
+void InfrequentDeleteBlockList::releaseAfter(void *address)
+{
+    while (d_head_p && reinterpret_cast<void *>(&d_head_p->d_memory)
+                                                                  != address) {
+        void *lastBlock = d_head_p;
+        d_head_p        = d_head_p->d_next_p;
+        d_allocator_p->deallocate(lastBlock);
+    }
+}
+
+void InfrequentDeleteBlockList::releaseRetaining(int maxRetainedBytes)
+{
+    BSLS_ASSERT(0 <= maxRetainedBytes);
+
+    // Return the blocks retained earlier to the list of blocks in use, so
+    // that all blocks compete for retention on an equal footing.
+
+    while (d_retained_p) {
+        Block *block    = d_retained_p;
+        d_retained_p    = block->d_next_p;
+        block->d_next_p = d_head_p;
+        d_head_p        = block;
+    }
+
+    Block *largest = d_head_p;
+    for (Block *block = d_head_p; block; block = block->d_next_p) {
+        if (largest->d_size < block->d_size) {
+            largest = block;
+        }
+    }
+
+    int numRetained = largest ? largest->d_size : 0;
+
+    while (d_head_p) {
+        Block *block = d_head_p;
+        d_head_p     = block->d_next_p;
+
+        if (block != largest) {
+            if (maxRetainedBytes - numRetained < block->d_size) {
+                d_allocator_p->deallocate(block);
+                continue;
+            }
+            numRetained += block->d_size;
+        }
+
+        Block **link = &d_retained_p;
+        while (*link && (*link)->d_size < block->d_size) {
+            link = &(*link)->d_next_p;
+        }
+        block->d_next_p = *link;
+        *link           = block;
+    }
+}
+
+// ACCESSORS
+int InfrequentDeleteBlockList::numRetainedBytes() const
+{
+    int numBytes = 0;
+    for (const Block *block = d_retained_p; block; block = block->d_next_p) {
+        numBytes += block->d_size;
+    }
+    return numBytes;
 }
 
 }  // close package namespace
@@ -25,6 +25,22 @@ BSLS_IDENT("$Id: $")
 // 'bdlma::InfrequentDeleteBlockList' has a 'deallocate' method, that method
 // has no effect.
 //
+///Retaining Blocks
+///----------------
+// A memory manager that repeatedly releases all of its memory and then grows
+// back to the same size (e.g., an arena used for each of a sequence of
+// similar requests) can avoid returning blocks to the underlying allocator
+// only to allocate them again.  The 'releaseRetaining' method deallocates the
+// blocks currently managed, except for the largest block and any further
+// blocks that fit within a specified byte budget.  Retained blocks are not
+// considered to be in use, but are reused, smallest sufficient block first,
+// to satisfy subsequent calls to 'allocate' and 'allocateAndExpand' before
+// any memory is obtained from the underlying allocator.  The
+// 'allocateAndExpand' method reports the full usable size of a reused block,
+// so that a memory manager obtaining a buffer from this object can make use
+// of all of it.  The 'release' method, and the destructor, deallocate the
+// retained blocks as well.
+//
 ///Usage
 ///-----
 // A 'bdlma::InfrequentDeleteBlockList' object is commonly used to supply
@@ -206,11 +222,15 @@ class InfrequentDeleteBlockList {
         // blocks.
 
         Block                               *d_next_p;  // next pointer
+        int                                  d_size;    // size of the
+                                                        // allocation
         bsls::AlignmentUtil::MaxAlignedType  d_memory;  // force alignment
     };
 
     // DATA
     Block            *d_head_p;       // address of 1st block of memory (or 0)
+    Block            *d_retained_p;   // retained blocks, in increasing order
+                                      // of size (or 0)
     bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
 
   private:
@@ -218,6 +238,21 @@ class InfrequentDeleteBlockList {
     InfrequentDeleteBlockList(const InfrequentDeleteBlockList&);
     InfrequentDeleteBlockList& operator=(const InfrequentDeleteBlockList&);
 
+  private:
+    // PRIVATE CLASS METHODS
+    static int usableSize(const Block *block);
+        // Return the number of bytes available for use in the specified
+        // 'block'.
+
+    // PRIVATE MANIPULATORS
+    Block *allocateBlock(int size);
+        // Add to the blocks in use, and return the address of, a block whose
+        // allocation is at least the specified 'size' (in bytes), reusing the
+        // smallest sufficient retained block if there is one, and obtaining a
+        // new block of 'size' bytes from the underlying allocator otherwise.
+        // The behavior is undefined unless 'size' is an allocation size
+        // computed by 'alignedAllocationSize'.
+
   public:
     // CREATORS
     explicit
@@ -238,6 +273,15 @@ class InfrequentDeleteBlockList {
         // returned.  The returned memory is guaranteed to be maximally
         // aligned.  The behavior is undefined unless '0 <= size'.
 
+    void *allocateAndExpand(int *size);
+        // Return the address of a contiguous block of memory of at least the
+        // specified '*size' (in bytes), and load into '*size' the number of
+        // bytes available at the returned address.  The available size
+        // exceeds the requested size only if a retained block (see
+        // 'releaseRetaining') is reused.  The returned memory is guaranteed to
+        // be maximally aligned.  The behavior is undefined unless
+        // '0 < *size'.
+
     void deallocate(void *address);
         // This method has no effect on the memory block at the specified
         // 'address' as all memory allocated by this object is managed.  The
@@ -247,6 +291,35 @@ class InfrequentDeleteBlockList {
     void release();
         // Deallocate all memory blocks currently managed by this object,
         // returning it to its default-constructed state.
+
+    void releaseAfter(void *address);
+        // Deallocate all memory blocks allocated by this object after the
+        // block at the specified 'address', or all memory blocks currently
+        // managed by this object if 'address' is 0.  The behavior is undefined
+        // unless 'address' is 0, or was returned by 'allocate' and has not
+        // since been released.  Note that 'lastBlock' returns a suitable
+        // 'address' with which to later undo subsequent allocations.
+
+    void releaseRetaining(int maxRetainedBytes);
+        // Deallocate all memory blocks currently managed by this object,
+        // except that the largest block is retained, together with as many
+        // other blocks, in order of most recent allocation, as fit within the
+        // specified 'maxRetainedBytes' (including the size of the largest
+        // block).  Retained blocks are reused to satisfy subsequent
+        // allocation requests.  The behavior is undefined unless
+        // '0 <= maxRetainedBytes'.  Note that the largest block is retained
+        // even if its size exceeds 'maxRetainedBytes', so that a
+        // 'maxRetainedBytes' of 0 retains the largest block only.
+
+    // ACCESSORS
+    void *lastBlock() const;
+        // Return the address of the memory block most recently allocated by
+        // this object that has not since been released, or 0 if this object
+        // currently manages no memory blocks.
+
+    int numRetainedBytes() const;
+        // Return the total size (in bytes) of the allocations held by the
+        // blocks retained by this object for reuse.
 };
 
 // ============================================================================
@@ -262,6 +335,7 @@ inline
 InfrequentDeleteBlockList::InfrequentDeleteBlockList(
                                               bslma::Allocator *basicAllocator)
 : d_head_p(0)
+, d_retained_p(0)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -272,6 +346,13 @@ void InfrequentDeleteBlockList::deallocate(void *)
 {
 }
 
+// ACCESSORS
+inline
+void *InfrequentDeleteBlockList::lastBlock() const
+{
+    return d_head_p ? reinterpret_cast<void *>(&d_head_p->d_memory) : 0;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -10,6 +10,7 @@
 #include <bsls_assert.h>
 #include <bsls_asserttest.h>
 
+#include <bsl_climits.h>
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>
 #include <bsl_iostream.h>
@@ -35,11 +36,16 @@ using namespace bsl;
 // [ 2] bdlma::InfrequentDeleteBlockList(bslma::Allocator *ba = 0);
 // [ 3] ~bdlma::InfrequentDeleteBlockList();
 // [ 2] void *allocate(int size);
+// [ 6] void *allocateAndExpand(int *size);
 // [ 4] void deallocate(void *address);
 // [ 3] void release();
+// [ 5] void releaseAfter(void *address);
+// [ 6] void releaseRetaining(int maxRetainedBytes);
+// [ 5] void *lastBlock() const;
+// [ 6] int numRetainedBytes() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 5] USAGE EXAMPLE
+// [ 7] USAGE EXAMPLE
 // [ *] CONCERN: In no case does memory come from the global allocator.
 // [ *] CONCERN: There is no temporary allocation from any allocator.
 // [ 2] CONCERN: Precondition violations are detected when enabled.
@@ -287,7 +293,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 5: {
+      case 7: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -329,6 +335,262 @@ int main(int argc, char *argv[])
         }
         ASSERT(0 == a.numBytesInUse());
       } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'releaseRetaining' AND 'allocateAndExpand'
+        //
+        // Concerns:
+        //: 1 'releaseRetaining' retains the largest block even if it exceeds
+        //:   the budget, and deallocates all other blocks if the budget is 0.
+        //:
+        //: 2 'releaseRetaining' additionally retains blocks, most recently
+        //:   allocated first, while they fit within the budget.
+        //:
+        //: 3 'allocate' and 'allocateAndExpand' reuse the smallest sufficient
+        //:   retained block before allocating from the object allocator.
+        //:
+        //: 4 'allocateAndExpand' reports the usable size of a reused block,
+        //:   and the requested size for a newly-allocated block.
+        //:
+        //: 5 'numRetainedBytes' reports the total size of the allocations
+        //:   held by retained blocks.
+        //:
+        //: 6 'release' and the destructor deallocate retained blocks.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate three blocks of different sizes, recording the number of
+        //:   bytes obtained from the object allocator for each.  Call
+        //:   'releaseRetaining(0)' and verify that only the largest block
+        //:   remains allocated from the object allocator.  (C-1, 5)
+        //:
+        //: 2 Allocate three blocks again, and call 'releaseRetaining' with a
+        //:   budget admitting the largest and most recent blocks only; verify
+        //:   the blocks remaining allocated.  (C-2, 5)
+        //:
+        //: 3 Request blocks from 'allocateAndExpand' and 'allocate', and
+        //:   verify the addresses and sizes returned, and the number of blocks
+        //:   allocated from the object allocator.  (C-3..4)
+        //:
+        //: 4 Call 'release' and let an object with retained blocks go out of
+        //:   scope, verifying that no memory remains in use.  (C-6)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-7)
+        //
+        // Testing:
+        //   void *allocateAndExpand(int *size);
+        //   void releaseRetaining(int maxRetainedBytes);
+        //   int numRetainedBytes() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                    << endl
+                    << "TESTING 'releaseRetaining' AND 'allocateAndExpand'"
+                    << endl
+                    << "=================================================="
+                    << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\nRetaining only the largest block." << endl;
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            {
+                Obj mX(&oa);  const Obj& X = mX;
+
+                ASSERT(0 == X.numRetainedBytes());
+
+                mX.allocate(100);
+                void *large = mX.allocate(1000);
+                const int LARGE = static_cast<int>(
+                                                  oa.lastAllocatedNumBytes());
+                mX.allocate(300);
+                ASSERT(3 == oa.numBlocksInUse());
+
+                mX.releaseRetaining(0);
+                ASSERT(1     == oa.numBlocksInUse());
+                ASSERT(LARGE == oa.numBytesInUse());
+                ASSERT(LARGE == X.numRetainedBytes());
+                ASSERT(0     == X.lastBlock());
+
+                // The retained block is reused, and is in use once more.
+
+                ASSERT(large == mX.allocate(500));
+                ASSERT(3     == oa.numBlocksTotal());
+                ASSERT(large == X.lastBlock());
+                ASSERT(0     == X.numRetainedBytes());
+
+                mX.releaseRetaining(0);
+                ASSERT(LARGE == X.numRetainedBytes());
+
+                mX.release();
+                ASSERT(0 == oa.numBlocksInUse());
+                ASSERT(0 == X.numRetainedBytes());
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nRetaining within a budget." << endl;
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            {
+                Obj mX(&oa);  const Obj& X = mX;
+
+                mX.allocate(100);
+                void *large  = mX.allocate(1000);
+                const int LARGE = static_cast<int>(
+                                                  oa.lastAllocatedNumBytes());
+                void *medium = mX.allocate(300);
+                const int MEDIUM = static_cast<int>(
+                                                  oa.lastAllocatedNumBytes());
+
+                mX.releaseRetaining(LARGE + MEDIUM);
+                ASSERT(2              == oa.numBlocksInUse());
+                ASSERT(LARGE + MEDIUM == oa.numBytesInUse());
+                ASSERT(LARGE + MEDIUM == X.numRetainedBytes());
+
+                const bsls::Types::Int64 NUM_BLOCKS = oa.numBlocksTotal();
+
+                // The smallest sufficient block is reused, and its full size
+                // is reported.
+
+                int size = 50;
+                ASSERT(medium == mX.allocateAndExpand(&size));
+                ASSERTV(size, 300 <= size);
+                ASSERTV(size, size < MEDIUM);
+
+                ASSERT(large == mX.allocate(400));
+                ASSERT(NUM_BLOCKS == oa.numBlocksTotal());
+                ASSERT(0          == X.numRetainedBytes());
+
+                // With no retained block, a new block is allocated and the
+                // requested size is reported.
+
+                size = 200;
+                mX.allocateAndExpand(&size);
+                ASSERT(200            == size);
+                ASSERT(NUM_BLOCKS + 1 == oa.numBlocksTotal());
+
+                // Retained blocks are deallocated on destruction.
+
+                mX.releaseRetaining(INT_MAX);
+                ASSERT(3 == oa.numBlocksInUse());
+            }
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            Obj mX(&oa);
+
+            ASSERT_PASS(mX.releaseRetaining( 0));
+            ASSERT_FAIL(mX.releaseRetaining(-1));
+
+            int size = 1;
+            ASSERT_PASS(mX.allocateAndExpand(&size));
+            size = 0;
+            ASSERT_FAIL(mX.allocateAndExpand(&size));
+            ASSERT_FAIL(mX.allocateAndExpand(0));
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'releaseAfter' AND 'lastBlock'
+        //
+        // Concerns:
+        //: 1 'lastBlock' returns 0 for an object managing no blocks, and
+        //:   otherwise the address of the most recently allocated block.
+        //:
+        //: 2 'releaseAfter' returns to the object allocator exactly the blocks
+        //:   allocated after the block at the specified address, leaving that
+        //:   block and all earlier blocks in use.
+        //:
+        //: 3 'releaseAfter(0)' releases all blocks.
+        //:
+        //: 4 No memory is allocated from the default allocator.
+        //
+        // Plan:
+        //: 1 Allocate a sequence of blocks, verifying 'lastBlock' after each
+        //:   allocation.  (C-1)
+        //:
+        //: 2 Call 'releaseAfter' with an address returned earlier in the
+        //:   sequence, and verify both the number of blocks remaining in use
+        //:   and the value of 'lastBlock'.  (C-2)
+        //:
+        //: 3 Call 'releaseAfter(0)' and verify that no blocks remain in use.
+        //:   (C-3)
+        //:
+        //: 4 Verify that the default allocator was not used.  (C-4)
+        //
+        // Testing:
+        //   void releaseAfter(void *address);
+        //   void *lastBlock() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'releaseAfter' AND 'lastBlock'"
+                          << endl << "======================================"
+                          << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            Obj mX(&oa);  const Obj& X = mX;
+
+            ASSERT(0 == X.lastBlock());
+
+            enum { NUM_BLOCKS = 5 };
+            void *blocks[NUM_BLOCKS];
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate(8 * (i + 1));
+                ASSERTV(i, blocks[i] == X.lastBlock());
+                ASSERTV(i, i + 1 == oa.numBlocksInUse());
+            }
+
+            mX.releaseAfter(blocks[NUM_BLOCKS - 1]);
+            ASSERT(NUM_BLOCKS == oa.numBlocksInUse());
+            ASSERT(blocks[NUM_BLOCKS - 1] == X.lastBlock());
+
+            mX.releaseAfter(blocks[2]);
+            ASSERT(3         == oa.numBlocksInUse());
+            ASSERT(blocks[2] == X.lastBlock());
+
+            void *p = mX.allocate(64);
+            ASSERT(4 == oa.numBlocksInUse());
+            ASSERT(p == X.lastBlock());
+
+            mX.releaseAfter(blocks[0]);
+            ASSERT(1         == oa.numBlocksInUse());
+            ASSERT(blocks[0] == X.lastBlock());
+
+            mX.releaseAfter(0);
+            ASSERT(0 == oa.numBlocksInUse());
+            ASSERT(0 == X.lastBlock());
+
+            mX.releaseAfter(0);
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+
+      } break;
       case 4: {
         // --------------------------------------------------------------------
         // TESTING DEALLOCATE
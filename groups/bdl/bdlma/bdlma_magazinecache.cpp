@@ -0,0 +1,210 @@
+// bdlma_magazinecache.cpp                                            -*-C++-*-
+#include <bdlma_magazinecache.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_magazinecache_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bsl_new.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+extern "C" void bdlma_MagazineCache_destroyCache(void *cache)
+{
+    typedef MagazineCache::ThreadCache ThreadCache;
+
+    ThreadCache *threadCache = static_cast<ThreadCache *>(cache);
+    threadCache->d_owner_p->destroyCache(threadCache);
+}
+
+                               // --------------
+                               // class Magazine
+                               // --------------
+
+// CLASS METHODS
+int Magazine::capacityFor(bsls::Types::size_type blockSize,
+                          bsls::Types::size_type numBytes,
+                          int                    minCapacity,
+                          int                    maxCapacity)
+{
+    BSLS_ASSERT(1 <= blockSize);
+    BSLS_ASSERT(1 <= minCapacity);
+    BSLS_ASSERT(minCapacity <= maxCapacity);
+
+    const bsls::Types::size_type capacity = numBytes / blockSize;
+
+    if (capacity < static_cast<bsls::Types::size_type>(minCapacity)) {
+        return minCapacity;                                           // RETURN
+    }
+    if (capacity > static_cast<bsls::Types::size_type>(maxCapacity)) {
+        return maxCapacity;                                           // RETURN
+    }
+    return static_cast<int>(capacity);
+}
+
+// MANIPULATORS
+int Magazine::moveBlocks(Magazine *destination, int numBlocks)
+{
+    BSLS_ASSERT(destination);
+    BSLS_ASSERT(0 <= numBlocks);
+
+    int numMoved = numBlocks;
+    if (numMoved > d_numBlocks) {
+        numMoved = d_numBlocks;
+    }
+    if (numMoved > destination->d_capacity - destination->d_numBlocks) {
+        numMoved = destination->d_capacity - destination->d_numBlocks;
+    }
+
+    for (int i = 0; i < numMoved; ++i) {
+        Link *link = d_head_p;
+        d_head_p   = link->d_next_p;
+
+        link->d_next_p        = destination->d_head_p;
+        destination->d_head_p = link;
+    }
+
+    d_numBlocks              -= numMoved;
+    destination->d_numBlocks += numMoved;
+
+    return numMoved;
+}
+
+                            // -------------------
+                            // class MagazineCache
+                            // -------------------
+
+// PRIVATE MANIPULATORS
+MagazineCache::ThreadCache *MagazineCache::createCache()
+{
+    BSLS_ASSERT(1 <= d_numClasses);
+    BSLS_ASSERT(d_capacities_p);
+
+    bsls::BslLockGuard guard(d_lock_p);
+
+    ThreadCache *cache = static_cast<ThreadCache *>(d_allocator_p->allocate(
+                 sizeof(ThreadCache) + (d_numClasses - 1) * sizeof(Magazine)));
+
+    cache->d_owner_p = this;
+
+    for (int i = 0; i < d_numClasses; ++i) {
+        new (cache->d_magazines + i) Magazine(d_capacities_p[i]);
+    }
+
+    cache->d_prev_p = 0;
+    cache->d_next_p = d_caches_p;
+    if (d_caches_p) {
+        d_caches_p->d_prev_p = cache;
+    }
+    d_caches_p = cache;
+
+    d_cacheKey.setValue(cache);
+
+    return cache;
+}
+
+void MagazineCache::destroyCache(ThreadCache *cache)
+{
+    BSLS_ASSERT(cache);
+    BSLS_ASSERT(this == cache->d_owner_p);
+
+    bsls::BslLockGuard guard(d_lock_p);
+
+    d_flushFunction(d_context_p, cache->d_magazines);
+
+    if (cache->d_prev_p) {
+        cache->d_prev_p->d_next_p = cache->d_next_p;
+    }
+    else {
+        d_caches_p = cache->d_next_p;
+    }
+    if (cache->d_next_p) {
+        cache->d_next_p->d_prev_p = cache->d_prev_p;
+    }
+
+    d_allocator_p->deallocate(cache);
+}
+
+// CREATORS
+MagazineCache::MagazineCache(int               numClasses,
+                             FlushFunction     flushFunction,
+                             void             *context,
+                             bsls::BslLock    *lock,
+                             bslma::Allocator *basicAllocator)
+: d_capacities_p(0)
+, d_numClasses(numClasses)
+, d_caches_p(0)
+, d_flushFunction(flushFunction)
+, d_context_p(context)
+, d_lock_p(lock)
+, d_cacheKey(&bdlma_MagazineCache_destroyCache)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(flushFunction);
+    BSLS_ASSERT(lock);
+
+    // 'numClasses' is checked by 'createCache', so that an owner constructing
+    // this object from its own arguments can report an invalid value itself.
+
+    if (1 <= numClasses) {
+        d_capacities_p = static_cast<int *>(
+              d_allocator_p->allocate(d_numClasses * sizeof *d_capacities_p));
+
+        for (int i = 0; i < d_numClasses; ++i) {
+            d_capacities_p[i] = 1;
+        }
+    }
+}
+
+MagazineCache::~MagazineCache()
+{
+    BSLS_ASSERT(d_allocator_p);
+
+    while (d_caches_p) {
+        ThreadCache *next = d_caches_p->d_next_p;
+        d_allocator_p->deallocate(d_caches_p);
+        d_caches_p = next;
+    }
+
+    d_allocator_p->deallocate(d_capacities_p);
+}
+
+// MANIPULATORS
+void MagazineCache::discardAll()
+{
+    for (ThreadCache *cache = d_caches_p; cache; cache = cache->d_next_p) {
+        for (int i = 0; i < d_numClasses; ++i) {
+            cache->d_magazines[i].removeAll();
+        }
+    }
+}
+
+void MagazineCache::flushAll()
+{
+    bsls::BslLockGuard guard(d_lock_p);
+
+    for (ThreadCache *cache = d_caches_p; cache; cache = cache->d_next_p) {
+        d_flushFunction(d_context_p, cache->d_magazines);
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
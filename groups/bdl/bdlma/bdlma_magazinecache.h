@@ -0,0 +1,635 @@
+// bdlma_magazinecache.h                                              -*-C++-*-
+#ifndef INCLUDED_BDLMA_MAGAZINECACHE
+#define INCLUDED_BDLMA_MAGAZINECACHE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide per-thread magazines of free blocks for thread caching.
+//
+//@CLASSES:
+//  bdlma::Magazine: bounded singly-linked list of free memory blocks
+//  bdlma::MagazineCache: per-thread arrays of magazines, one per size class
+//
+//@SEE_ALSO: bdlma_blockrecycler, bdlma_threadcachingmultipool
+//
+//@DESCRIPTION: This component provides the building blocks shared by the
+// thread-caching memory managers in 'bdlma': a mechanism, 'bdlma::Magazine',
+// holding a bounded number of free memory blocks in a singly-linked list, and
+// a mechanism, 'bdlma::MagazineCache', giving each thread that uses it its own
+// array of magazines (its "thread cache"), one per size class of the owning
+// memory manager.
+//
+// A memory manager built on these types satisfies an allocation by popping a
+// block from the calling thread's magazine for the appropriate size class,
+// and a deallocation by pushing the block onto that magazine; neither
+// operation takes a lock, nor touches memory written by other threads.  Only
+// when a magazine is empty (on allocation) or full (on deallocation) does the
+// manager move a batch of 'batchSize' blocks between the magazine and a
+// shared "depot" (e.g., a pool, or another 'bdlma::Magazine' of larger
+// capacity), while holding a lock.  The policy for the depot is left to the
+// memory manager.
+//
+///Magazine
+///--------
+// A 'bdlma::Magazine' stores the link to the next free block in the first
+// bytes of each free block, and therefore needs no memory of its own.  Every
+// block pushed onto a magazine must be suitably aligned for, and at least as
+// large as, a 'void *'.  A magazine has a fixed 'capacity'; 'push' must not be
+// called on a full magazine, nor 'pop' on an empty one.
+//
+// 'capacityFor' computes the capacity of a magazine that holds approximately
+// a given number of bytes of blocks of a given size, so that the memory held
+// by a thread cache is bounded regardless of block size.
+//
+///Thread Caches
+///-------------
+// A 'bdlma::MagazineCache' is configured at construction with the number of
+// size classes, a *lock* and a *flush* *function* supplied by the owning
+// memory manager.  The capacity of the magazines of each size class is set
+// with 'setCapacity' before any thread cache is created.  'threadMagazines'
+// returns the array of magazines of the calling thread, creating (under the
+// lock) and registering its thread cache on first use.
+//
+// When a thread that has a thread cache exits, the flush function is invoked
+// (while holding the lock) to return the blocks held by that thread's
+// magazines to the owning memory manager, and the thread cache is then
+// deallocated.  'flushAll' empties the magazines of every thread the same way,
+// and 'discardAll' empties them without returning their blocks (e.g., because
+// the memory of those blocks is about to be released wholesale).  The
+// destructor deallocates the thread caches of all threads *without* flushing
+// them.
+//
+///Thread Safety
+///-------------
+// A 'bdlma::Magazine' is *not* thread-safe; the magazines of a thread cache
+// are accessed only by the thread owning it, and a depot only under the lock
+// of the owning memory manager.
+//
+// 'threadMagazines' and 'lookupThreadMagazines' may be called concurrently
+// from any number of threads.  'discardAll', 'flushAll', and 'setCapacity'
+// must *not* be called concurrently with any other method.  The lock supplied
+// at construction guards every use of the basic allocator by a
+// 'bdlma::MagazineCache', so the basic allocator need not be thread-safe if
+// the owning memory manager uses it only while holding the same lock.
+//
+// On POSIX platforms, the magazines of a thread are flushed when that thread
+// exits.  On Windows, they are flushed only by 'flushAll'.  In either case,
+// the behavior is undefined if a thread that has a thread cache exits while
+// the 'bdlma::MagazineCache' is being destroyed.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A Thread-Caching Allocator of Fixed-Size Blocks
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want a thread-safe allocator of blocks of a single size
+// that rarely takes a lock.  Each thread keeps up to 16 free blocks in a
+// magazine, and the blocks that do not fit are returned to an upstream
+// allocator.
+//
+// First, we define the allocator class:
+//..
+//  class my_BlockCache {
+//      // This class dispenses blocks of 'k_BLOCK_SIZE' bytes, caching free
+//      // blocks per thread.
+//
+//    public:
+//      // TYPES
+//      enum { k_BLOCK_SIZE = 64 };
+//
+//    private:
+//      // DATA
+//      bsls::BslLock         d_lock;        // guards 'd_allocator_p'
+//      bslma::Allocator     *d_allocator_p; // upstream allocator (held)
+//      bdlma::MagazineCache  d_magazines;   // magazines of all threads
+//
+//      // PRIVATE CLASS METHODS
+//      static void flush(void *cache, bdlma::Magazine *magazines);
+//          // Return the blocks held by the specified 'magazines' to the
+//          // upstream allocator of the specified 'cache'.
+//
+//      // PRIVATE MANIPULATORS
+//      void returnBlocks(bdlma::Magazine *magazine, int numBlocks);
+//          // Return up to the specified 'numBlocks' blocks held by the
+//          // specified 'magazine' to the upstream allocator.  The behavior
+//          // is undefined unless 'd_lock' is held by the calling thread.
+//
+//    public:
+//      // CREATORS
+//      explicit my_BlockCache(bslma::Allocator *upstream);
+//          // Create a block cache obtaining its blocks from the specified
+//          // 'upstream' allocator.
+//
+//      ~my_BlockCache();
+//          // Destroy this block cache, returning all cached blocks to the
+//          // upstream allocator.
+//
+//      // MANIPULATORS
+//      void *allocate();
+//          // Return the address of a block of 'k_BLOCK_SIZE' bytes.
+//
+//      void deallocate(void *block);
+//          // Return the specified 'block' to this cache.
+//  };
+//..
+// Then, we implement the flush function, which is called with 'd_lock' held
+// whenever a thread that used the cache exits, as well as the helper that
+// returns blocks to the upstream allocator:
+//..
+//  void my_BlockCache::flush(void *cache, bdlma::Magazine *magazines)
+//  {
+//      my_BlockCache *blockCache = static_cast<my_BlockCache *>(cache);
+//      blockCache->returnBlocks(&magazines[0], magazines[0].numBlocks());
+//  }
+//
+//  void my_BlockCache::returnBlocks(bdlma::Magazine *magazine,
+//                                   int              numBlocks)
+//  {
+//      for (int i = 0; i < numBlocks && !magazine->isEmpty(); ++i) {
+//          d_allocator_p->deallocate(magazine->pop());
+//      }
+//  }
+//..
+// Next, we implement the creators.  The cache has one size class, whose
+// magazines hold up to 16 blocks:
+//..
+//  my_BlockCache::my_BlockCache(bslma::Allocator *upstream)
+//  : d_allocator_p(upstream)
+//  , d_magazines(1, &flush, this, &d_lock, upstream)
+//  {
+//      d_magazines.setCapacity(0, 16);
+//  }
+//
+//  my_BlockCache::~my_BlockCache()
+//  {
+//      d_magazines.flushAll();
+//  }
+//..
+// Then, we implement the manipulators.  Only when the calling thread's
+// magazine is empty, or full, do they take the lock, and then move a whole
+// batch of blocks at once:
+//..
+//  void *my_BlockCache::allocate()
+//  {
+//      bdlma::Magazine& magazine = d_magazines.threadMagazines()[0];
+//
+//      if (magazine.isEmpty()) {
+//          bsls::BslLockGuard guard(&d_lock);
+//
+//          for (int i = 0; i < magazine.batchSize(); ++i) {
+//              magazine.push(d_allocator_p->allocate(k_BLOCK_SIZE));
+//          }
+//      }
+//      return magazine.pop();
+//  }
+//
+//  void my_BlockCache::deallocate(void *block)
+//  {
+//      bdlma::Magazine& magazine = d_magazines.threadMagazines()[0];
+//
+//      if (magazine.isFull()) {
+//          bsls::BslLockGuard guard(&d_lock);
+//
+//          returnBlocks(&magazine, magazine.batchSize());
+//      }
+//      magazine.push(block);
+//  }
+//..
+// Finally, we use the cache, and observe that a block deallocated by a thread
+// is reused by its next allocation without involving the upstream allocator:
+//..
+//  bslma::TestAllocator ta;
+//  {
+//      my_BlockCache cache(&ta);
+//
+//      void *p = cache.allocate();     // obtains a batch of 8 blocks
+//
+//      const bsls::Types::Int64 numAllocations = ta.numAllocations();
+//
+//      cache.deallocate(p);
+//      assert(p == cache.allocate());
+//      assert(numAllocations == ta.numAllocations());
+//
+//      cache.deallocate(p);
+//  }
+//  assert(0 == ta.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLTHREADSPECIFIC
+#include <bsls_bslthreadspecific.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+extern "C" void bdlma_MagazineCache_destroyCache(void *cache);
+    // Flush the magazines of the specified thread 'cache' to the memory
+    // manager owning the 'MagazineCache' that created it, and deallocate
+    // 'cache'.  Note that this function is invoked when a thread that used a
+    // 'MagazineCache' exits, and is *not* intended for direct use by client
+    // code.
+
+                               // ==============
+                               // class Magazine
+                               // ==============
+
+class Magazine {
+    // This mechanism holds a bounded number of free memory blocks in a
+    // singly-linked list threaded through the blocks themselves.
+
+    // PRIVATE TYPES
+    struct Link {
+        // This 'struct' overlays the first bytes of a free block.
+
+        Link *d_next_p;  // next free block in the magazine
+    };
+
+    // DATA
+    Link *d_head_p;     // first free block, or 0 if empty
+    int   d_numBlocks;  // number of blocks in this magazine
+    int   d_capacity;   // maximum number of blocks in this magazine
+
+  private:
+    // NOT IMPLEMENTED
+    Magazine(const Magazine&);
+    Magazine& operator=(const Magazine&);
+
+  public:
+    // CLASS METHODS
+    static int capacityFor(bsls::Types::size_type blockSize,
+                           bsls::Types::size_type numBytes,
+                           int                    minCapacity,
+                           int                    maxCapacity);
+        // Return the number of blocks of the specified 'blockSize' (in bytes)
+        // that fit in the specified 'numBytes', clamped to the range
+        // '[minCapacity .. maxCapacity]'.  The behavior is undefined unless
+        // '1 <= blockSize' and '1 <= minCapacity <= maxCapacity'.
+
+    // CREATORS
+    explicit
+    Magazine(int capacity);
+        // Create an empty magazine that holds at most the specified
+        // 'capacity' blocks.  The behavior is undefined unless
+        // '1 <= capacity'.
+
+    // MANIPULATORS
+    int moveBlocks(Magazine *destination, int numBlocks);
+        // Move up to the specified 'numBlocks' blocks from this magazine to
+        // the specified 'destination', stopping early if this magazine
+        // becomes empty or 'destination' becomes full.  Return the number of
+        // blocks moved.  The behavior is undefined unless '0 <= numBlocks'.
+
+    void *pop();
+        // Remove the most recently pushed block from this magazine and return
+        // its address.  The behavior is undefined if this magazine is empty.
+
+    void push(void *block);
+        // Add the specified 'block' to this magazine.  The behavior is
+        // undefined if this magazine is full, or unless 'block' is suitably
+        // aligned for, and at least as large as, a 'void *', and is not
+        // otherwise in use.
+
+    void removeAll();
+        // Remove all blocks from this magazine without accessing them.  Note
+        // that the blocks are not returned anywhere; this method is intended
+        // for use when the memory of those blocks is about to be released.
+
+    // ACCESSORS
+    int batchSize() const;
+        // Return the number of blocks that should be moved between this
+        // magazine and a depot at once, which is half of the capacity of this
+        // magazine, but at least 1.
+
+    int capacity() const;
+        // Return the maximum number of blocks held by this magazine.
+
+    bool isEmpty() const;
+        // Return 'true' if this magazine holds no blocks, and 'false'
+        // otherwise.
+
+    bool isFull() const;
+        // Return 'true' if this magazine holds 'capacity()' blocks, and
+        // 'false' otherwise.
+
+    int numBlocks() const;
+        // Return the number of blocks held by this magazine.
+};
+
+                            // ===================
+                            // class MagazineCache
+                            // ===================
+
+class MagazineCache {
+    // This mechanism gives each thread that uses it its own array of
+    // magazines, one per size class of the owning memory manager, and returns
+    // the blocks held by a thread's magazines to the owning memory manager,
+    // through a flush function supplied at construction, when the thread
+    // exits.
+
+  public:
+    // TYPES
+    typedef void (*FlushFunction)(void *context, Magazine *magazines);
+        // 'FlushFunction' is an alias for the type of a function that returns
+        // all blocks held by the specified 'magazines', an array of
+        // 'numClasses()' magazines (indexed by size class), to the memory
+        // manager identified by the specified 'context'.  Such a function is
+        // invoked while holding the lock supplied at construction, and must
+        // leave every magazine empty.
+
+  private:
+    // PRIVATE TYPES
+    struct ThreadCache {
+        // This 'struct' holds the magazines of one thread, and links them
+        // into the list of all thread caches of a 'MagazineCache'.
+
+        MagazineCache *d_owner_p;       // magazine cache owning this cache
+        ThreadCache   *d_next_p;        // next cache of owner
+        ThreadCache   *d_prev_p;        // previous cache of owner
+        Magazine       d_magazines[1];  // first of 'numClasses()' magazines
+    };
+
+    // DATA
+    int                     *d_capacities_p;   // capacity of the magazines
+                                               // of each size class
+
+    int                      d_numClasses;     // number of size classes
+
+    ThreadCache             *d_caches_p;       // list of all thread caches
+
+    FlushFunction            d_flushFunction;  // returns the blocks of a
+                                               // thread cache to the owner
+
+    void                    *d_context_p;      // argument of
+                                               // 'd_flushFunction'
+
+    bsls::BslLock           *d_lock_p;         // guards cache list and basic
+                                               // allocator (held)
+
+    bsls::BslThreadSpecific  d_cacheKey;       // calling thread's cache
+
+    bslma::Allocator        *d_allocator_p;    // holds (but does not own)
+                                               // allocator
+
+    // FRIENDS
+    friend void bdlma_MagazineCache_destroyCache(void *);
+
+  private:
+    // PRIVATE MANIPULATORS
+    ThreadCache *createCache();
+        // Create a thread cache for the calling thread, having an empty
+        // magazine for each size class, and associate it with this object.
+        // Return the address of the new cache.
+
+    void destroyCache(ThreadCache *cache);
+        // Flush the magazines of the specified 'cache', remove 'cache' from
+        // the list of thread caches of this object, and deallocate it.
+
+  private:
+    // NOT IMPLEMENTED
+    MagazineCache(const MagazineCache&);
+    MagazineCache& operator=(const MagazineCache&);
+
+  public:
+    // CREATORS
+    MagazineCache(int               numClasses,
+                  FlushFunction     flushFunction,
+                  void             *context,
+                  bsls::BslLock    *lock,
+                  bslma::Allocator *basicAllocator = 0);
+        // Create a magazine cache giving each thread that uses it
+        // 'numClasses' magazines, whose blocks are returned, when the thread
+        // exits, by invoking the specified 'flushFunction' with the specified
+        // 'context' while holding the specified 'lock'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The magazines
+        // of each size class initially have a capacity of 1 (see
+        // 'setCapacity').  The behavior is undefined unless '1 <= numClasses'
+        // and 'lock' outlives this object.
+
+    ~MagazineCache();
+        // Destroy this magazine cache, deallocating the thread caches of all
+        // threads *without* flushing them.  The behavior is undefined if a
+        // thread that has a thread cache exits concurrently with this call.
+
+    // MANIPULATORS
+    void discardAll();
+        // Empty the magazines of all threads without flushing them.  The
+        // behavior is undefined if this method is called concurrently with
+        // any other method of this object.  Note that the blocks held in the
+        // magazines are forgotten; this method is intended for use when the
+        // memory of those blocks is about to be released.
+
+    void flushAll();
+        // Return the blocks held by the magazines of all threads to the
+        // owning memory manager by invoking the flush function, while holding
+        // the lock, for each thread cache in turn.  The thread caches remain
+        // associated with their threads.  The behavior is undefined if this
+        // method is called concurrently with any other method of this object,
+        // or while the calling thread holds the lock.
+
+    void setCapacity(int classIdx, int capacity);
+        // Set the capacity of the magazines of the size class having the
+        // specified 'classIdx' to the specified 'capacity'.  The behavior is
+        // undefined unless '0 <= classIdx < numClasses()',
+        // '1 <= capacity', and no thread cache has been created yet.
+
+    Magazine *threadMagazines();
+        // Return the address of the array of 'numClasses()' magazines of the
+        // calling thread, creating them if necessary.  The behavior is
+        // undefined if the calling thread holds the lock.
+
+    // ACCESSORS
+    int capacity(int classIdx) const;
+        // Return the capacity of the magazines of the size class having the
+        // specified 'classIdx'.  The behavior is undefined unless
+        // '0 <= classIdx < numClasses()'.
+
+    Magazine *lookupThreadMagazines() const;
+        // Return the address of the array of 'numClasses()' magazines of the
+        // calling thread, or 0 if the calling thread has none.
+
+    int numClasses() const;
+        // Return the number of size classes of this magazine cache.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                               // --------------
+                               // class Magazine
+                               // --------------
+
+// CREATORS
+inline
+Magazine::Magazine(int capacity)
+: d_head_p(0)
+, d_numBlocks(0)
+, d_capacity(capacity)
+{
+    BSLS_ASSERT_SAFE(1 <= capacity);
+}
+
+// MANIPULATORS
+inline
+void *Magazine::pop()
+{
+    BSLS_ASSERT_SAFE(d_head_p);
+
+    Link *link = d_head_p;
+    d_head_p   = link->d_next_p;
+    --d_numBlocks;
+    return link;
+}
+
+inline
+void Magazine::push(void *block)
+{
+    BSLS_ASSERT_SAFE(block);
+    BSLS_ASSERT_SAFE(d_numBlocks < d_capacity);
+
+    Link *link     = static_cast<Link *>(block);
+    link->d_next_p = d_head_p;
+    d_head_p       = link;
+    ++d_numBlocks;
+}
+
+inline
+void Magazine::removeAll()
+{
+    d_head_p    = 0;
+    d_numBlocks = 0;
+}
+
+// ACCESSORS
+inline
+int Magazine::batchSize() const
+{
+    return 1 < d_capacity ? d_capacity / 2 : 1;
+}
+
+inline
+int Magazine::capacity() const
+{
+    return d_capacity;
+}
+
+inline
+bool Magazine::isEmpty() const
+{
+    return 0 == d_head_p;
+}
+
+inline
+bool Magazine::isFull() const
+{
+    return d_numBlocks == d_capacity;
+}
+
+inline
+int Magazine::numBlocks() const
+{
+    return d_numBlocks;
+}
+
+                            // -------------------
+                            // class MagazineCache
+                            // -------------------
+
+// MANIPULATORS
+inline
+void MagazineCache::setCapacity(int classIdx, int capacity)
+{
+    BSLS_ASSERT(0 <= classIdx);
+    BSLS_ASSERT(classIdx < d_numClasses);
+    BSLS_ASSERT(1 <= capacity);
+    BSLS_ASSERT(!d_caches_p);
+
+    d_capacities_p[classIdx] = capacity;
+}
+
+inline
+Magazine *MagazineCache::threadMagazines()
+{
+    ThreadCache *cache = static_cast<ThreadCache *>(d_cacheKey.value());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!cache)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        cache = createCache();
+    }
+    return cache->d_magazines;
+}
+
+// ACCESSORS
+inline
+int MagazineCache::capacity(int classIdx) const
+{
+    BSLS_ASSERT_SAFE(0 <= classIdx);
+    BSLS_ASSERT_SAFE(classIdx < d_numClasses);
+
+    return d_capacities_p[classIdx];
+}
+
+inline
+Magazine *MagazineCache::lookupThreadMagazines() const
+{
+    ThreadCache *cache = static_cast<ThreadCache *>(d_cacheKey.value());
+
+    return cache ? cache->d_magazines : 0;
+}
+
+inline
+int MagazineCache::numClasses() const
+{
+    return d_numClasses;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1006 @@
+// bdlma_magazinecache.t.cpp                                          -*-C++-*-
+#include <bdlma_magazinecache.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_bsllock.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides two mechanisms: 'bdlma::Magazine', a
+// bounded list of free blocks threaded through the blocks themselves, and
+// 'bdlma::MagazineCache', which gives each thread its own array of magazines
+// and flushes them through a callback supplied by the owning memory manager.
+//
+// For 'bdlma::Magazine', we verify that blocks are pushed and popped in LIFO
+// order, that the count and capacity are maintained, and that 'moveBlocks'
+// respects both the requested number of blocks and the capacity of the
+// destination.  For 'bdlma::MagazineCache', we verify that each thread
+// obtains its own magazines with the configured capacities, that the flush
+// function is invoked (with the expected context) when a thread exits and by
+// 'flushAll', and that all memory is obtained from, and returned to, the
+// allocator supplied at construction.
+//-----------------------------------------------------------------------------
+// Magazine
+// [ 3] static int capacityFor(size_type, size_type, int, int);
+// [ 2] explicit Magazine(int capacity);
+// [ 4] int moveBlocks(Magazine *destination, int numBlocks);
+// [ 2] void *pop();
+// [ 2] void push(void *block);
+// [ 2] void removeAll();
+// [ 3] int batchSize() const;
+// [ 2] int capacity() const;
+// [ 2] bool isEmpty() const;
+// [ 2] bool isFull() const;
+// [ 2] int numBlocks() const;
+//
+// MagazineCache
+// [ 5] MagazineCache(int, FlushFunction, void *, BslLock *, Allocator *);
+// [ 5] ~MagazineCache();
+// [ 5] void discardAll();
+// [ 5] void flushAll();
+// [ 5] void setCapacity(int classIdx, int capacity);
+// [ 5] Magazine *threadMagazines();
+// [ 5] int capacity(int classIdx) const;
+// [ 5] Magazine *lookupThreadMagazines() const;
+// [ 5] int numClasses() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] CONCERN: The magazines of a thread are flushed when it exits.
+// [ 7] USAGE EXAMPLE
+// [ *] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                       GLOBAL TYPES AND CONSTANTS
+//-----------------------------------------------------------------------------
+
+typedef bdlma::Magazine      Obj;
+typedef bdlma::MagazineCache Cache;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+//=============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+struct Block {
+    // This 'struct' provides a block that can be held in a magazine.
+
+    void *d_link;      // overlaid by the magazine
+    int   d_sequence;  // identifies the block
+};
+
+struct Owner {
+    // This 'struct' plays the role of the memory manager owning a
+    // 'bdlma::MagazineCache' in the tests: its flush function returns the
+    // blocks held by a thread's magazines to 'd_allocator_p'.
+
+    bsls::BslLock     d_lock;           // lock supplied to the cache
+    int               d_numClasses;     // number of magazines per thread
+    bsls::AtomicInt   d_numFlushes;     // number of calls to 'flush'
+    bsls::AtomicInt   d_numFlushed;     // number of blocks flushed
+    bslma::Allocator *d_allocator_p;    // supplies and receives blocks
+
+    static void flush(void *owner, bdlma::Magazine *magazines)
+        // Return all blocks held by the specified 'magazines' to the allocator
+        // of the specified 'owner'.
+    {
+        Owner *o = static_cast<Owner *>(owner);
+
+        ++o->d_numFlushes;
+        for (int i = 0; i < o->d_numClasses; ++i) {
+            while (!magazines[i].isEmpty()) {
+                o->d_allocator_p->deallocate(magazines[i].pop());
+                ++o->d_numFlushed;
+            }
+        }
+    }
+};
+
+                                // ------
+                                // case 6
+                                // ------
+
+enum { NUM_THREADS = 8, NUM_BLOCKS = 5 };
+
+struct ThreadArgs {
+    Cache                *d_cache_p;     // cache shared by all threads
+    Owner                *d_owner_p;     // owner of 'd_cache_p'
+    bdlma::Magazine      *d_magazines_p; // magazines obtained by the thread
+    bsls::AtomicInt      *d_errors_p;    // number of errors detected
+};
+
+extern "C" void *workerThread(void *arg)
+    // Obtain the magazines of the calling thread from the shared cache, and
+    // fill the magazine of each size class with 'NUM_BLOCKS' blocks.
+{
+    ThreadArgs& args = *static_cast<ThreadArgs *>(arg);
+    Cache&      mX   = *args.d_cache_p;
+
+    if (0 != mX.lookupThreadMagazines()) {
+        ++*args.d_errors_p;
+    }
+
+    bdlma::Magazine *magazines = mX.threadMagazines();
+
+    if (magazines != mX.lookupThreadMagazines()) {
+        ++*args.d_errors_p;
+    }
+
+    for (int i = 0; i < mX.numClasses(); ++i) {
+        if (!magazines[i].isEmpty()) {
+            ++*args.d_errors_p;
+        }
+        for (int j = 0; j < NUM_BLOCKS; ++j) {
+            bsls::BslLockGuard guard(&args.d_owner_p->d_lock);
+
+            magazines[i].push(args.d_owner_p->d_allocator_p->allocate(
+                                                               sizeof(Block)));
+        }
+    }
+
+    args.d_magazines_p = magazines;
+
+    return arg;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Example 1: A Thread-Caching Allocator of Fixed-Size Blocks
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want a thread-safe allocator of blocks of a single size
+// that rarely takes a lock.  Each thread keeps up to 16 free blocks in a
+// magazine, and the blocks that do not fit are returned to an upstream
+// allocator.
+//
+// First, we define the allocator class:
+//..
+    class my_BlockCache {
+        // This class dispenses blocks of 'k_BLOCK_SIZE' bytes, caching free
+        // blocks per thread.
+
+      public:
+        // TYPES
+        enum { k_BLOCK_SIZE = 64 };
+
+      private:
+        // DATA
+        bsls::BslLock         d_lock;        // guards 'd_allocator_p'
+        bslma::Allocator     *d_allocator_p; // upstream allocator (held)
+        bdlma::MagazineCache  d_magazines;   // magazines of all threads
+
+        // PRIVATE CLASS METHODS
+        static void flush(void *cache, bdlma::Magazine *magazines);
+            // Return the blocks held by the specified 'magazines' to the
+            // upstream allocator of the specified 'cache'.
+
+        // PRIVATE MANIPULATORS
+        void returnBlocks(bdlma::Magazine *magazine, int numBlocks);
+            // Return up to the specified 'numBlocks' blocks held by the
+            // specified 'magazine' to the upstream allocator.  The behavior
+            // is undefined unless 'd_lock' is held by the calling thread.
+
+      public:
+        // CREATORS
+        explicit my_BlockCache(bslma::Allocator *upstream);
+            // Create a block cache obtaining its blocks from the specified
+            // 'upstream' allocator.
+
+        ~my_BlockCache();
+            // Destroy this block cache, returning all cached blocks to the
+            // upstream allocator.
+
+        // MANIPULATORS
+        void *allocate();
+            // Return the address of a block of 'k_BLOCK_SIZE' bytes.
+
+        void deallocate(void *block);
+            // Return the specified 'block' to this cache.
+    };
+//..
+// Then, we implement the flush function, which is called with 'd_lock' held
+// whenever a thread that used the cache exits, as well as the helper that
+// returns blocks to the upstream allocator:
+//..
+    void my_BlockCache::flush(void *cache, bdlma::Magazine *magazines)
+    {
+        my_BlockCache *blockCache = static_cast<my_BlockCache *>(cache);
+        blockCache->returnBlocks(&magazines[0], magazines[0].numBlocks());
+    }
+
+    void my_BlockCache::returnBlocks(bdlma::Magazine *magazine,
+                                     int              numBlocks)
+    {
+        for (int i = 0; i < numBlocks && !magazine->isEmpty(); ++i) {
+            d_allocator_p->deallocate(magazine->pop());
+        }
+    }
+//..
+// Next, we implement the creators.  The cache has one size class, whose
+// magazines hold up to 16 blocks:
+//..
+    my_BlockCache::my_BlockCache(bslma::Allocator *upstream)
+    : d_allocator_p(upstream)
+    , d_magazines(1, &flush, this, &d_lock, upstream)
+    {
+        d_magazines.setCapacity(0, 16);
+    }
+
+    my_BlockCache::~my_BlockCache()
+    {
+        d_magazines.flushAll();
+    }
+//..
+// Then, we implement the manipulators.  Only when the calling thread's
+// magazine is empty, or full, do they take the lock, and then move a whole
+// batch of blocks at once:
+//..
+    void *my_BlockCache::allocate()
+    {
+        bdlma::Magazine& magazine = d_magazines.threadMagazines()[0];
+
+        if (magazine.isEmpty()) {
+            bsls::BslLockGuard guard(&d_lock);
+
+            for (int i = 0; i < magazine.batchSize(); ++i) {
+                magazine.push(d_allocator_p->allocate(k_BLOCK_SIZE));
+            }
+        }
+        return magazine.pop();
+    }
+
+    void my_BlockCache::deallocate(void *block)
+    {
+        bdlma::Magazine& magazine = d_magazines.threadMagazines()[0];
+
+        if (magazine.isFull()) {
+            bsls::BslLockGuard guard(&d_lock);
+
+            returnBlocks(&magazine, magazine.batchSize());
+        }
+        magazine.push(block);
+    }
+//..
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator  testAllocator(veryVeryVerbose);
+    bslma::Allocator     *Z = &testAllocator;
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+//..
+// Finally, we use the cache, and observe that a block deallocated by a thread
+// is reused by its next allocation without involving the upstream allocator:
+//..
+    bslma::TestAllocator ta;
+    {
+        my_BlockCache cache(&ta);
+
+        void *p = cache.allocate();     // obtains a batch of 8 blocks
+
+        const bsls::Types::Int64 numAllocations = ta.numAllocations();
+
+        cache.deallocate(p);
+        ASSERT(p == cache.allocate());
+        ASSERT(numAllocations == ta.numAllocations());
+
+        cache.deallocate(p);
+    }
+    ASSERT(0 == ta.numBlocksInUse());
+//..
+
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCERN: THREAD EXIT
+        //
+        // Concerns:
+        //: 1 Each thread obtains its own magazines, which are empty when
+        //:   created.
+        //:
+        //: 2 When a thread that has magazines exits, the flush function is
+        //:   invoked with the context supplied at construction, and the
+        //:   thread cache is deallocated.
+        //:
+        //: 3 The thread caches of threads that are still running are not
+        //:   affected.
+        //
+        // Plan:
+        //: 1 Create several threads that each obtain their magazines from a
+        //:   shared cache, verify that they are distinct and empty, and fill
+        //:   them with blocks from a test allocator.  (C-1)
+        //:
+        //: 2 After joining the threads, verify (on POSIX platforms) that the
+        //:   flush function was called once per thread, that every block was
+        //:   returned to the test allocator, and that only the memory of the
+        //:   main thread's cache remains in use.  (C-2..3)
+        //
+        // Testing:
+        //   CONCERN: The magazines of a thread are flushed when it exits.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONCERN: THREAD EXIT"
+                          << endl << "====================" << endl;
+
+        bslma::TestAllocator blockAllocator(veryVeryVerbose);
+
+        {
+            Owner owner;
+            owner.d_numClasses  = 3;
+            owner.d_allocator_p = &blockAllocator;
+
+            Cache mX(3, &Owner::flush, &owner, &owner.d_lock, Z);
+            mX.setCapacity(0, NUM_BLOCKS);
+            mX.setCapacity(1, NUM_BLOCKS);
+            mX.setCapacity(2, NUM_BLOCKS);
+
+            bdlma::Magazine *mainMagazines = mX.threadMagazines();
+            mainMagazines[1].push(blockAllocator.allocate(sizeof(Block)));
+
+            const bsls::Types::Int64 numBytes = testAllocator.numBytesInUse();
+
+            bsls::AtomicInt errors(0);
+
+            ThreadArgs args[NUM_THREADS];
+            ThreadId   ids[NUM_THREADS];
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                args[i].d_cache_p     = &mX;
+                args[i].d_owner_p     = &owner;
+                args[i].d_magazines_p = 0;
+                args[i].d_errors_p    = &errors;
+
+                ids[i] = createThread(&workerThread, &args[i]);
+            }
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            if (veryVerbose) {
+                P_(owner.d_numFlushes) P(owner.d_numFlushed)
+            }
+
+            ASSERT(0 == errors);
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                LOOP_ASSERT(i, args[i].d_magazines_p);
+                LOOP_ASSERT(i, mainMagazines != args[i].d_magazines_p);
+            }
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+            LOOP_ASSERT(owner.d_numFlushes, NUM_THREADS == owner.d_numFlushes);
+            LOOP_ASSERT(owner.d_numFlushed,
+                        NUM_THREADS * 3 * NUM_BLOCKS == owner.d_numFlushed);
+            ASSERT(1 == blockAllocator.numBlocksInUse());
+            ASSERT(numBytes == testAllocator.numBytesInUse());
+#endif
+
+            ASSERT(mainMagazines == mX.threadMagazines());
+            ASSERT(1 == mainMagazines[1].numBlocks());
+
+            mX.flushAll();
+
+            ASSERT(0 == blockAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // MAGAZINE CACHE
+        //
+        // Concerns:
+        //: 1 A new cache has the specified number of classes, each with a
+        //:   capacity of 1, and the calling thread has no magazines.
+        //:
+        //: 2 'setCapacity' sets the capacity of the magazines of one class.
+        //:
+        //: 3 'threadMagazines' creates the magazines of the calling thread on
+        //:   first use, with the configured capacities, and returns the same
+        //:   magazines on later calls.
+        //:
+        //: 4 'flushAll' invokes the flush function with the context supplied
+        //:   at construction, leaving the thread cache in place.
+        //:
+        //: 5 'discardAll' empties the magazines without invoking the flush
+        //:   function.
+        //:
+        //: 6 All memory is obtained from the allocator supplied at
+        //:   construction, and is returned by the destructor.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create a cache, verify its accessors, set the capacities, and
+        //:   obtain the magazines of the main thread.  (C-1..3)
+        //:
+        //: 2 Push blocks onto the magazines, invoke 'flushAll' and
+        //:   'discardAll', and verify the state of the magazines and the
+        //:   number of flushes.  (C-4..5)
+        //:
+        //: 3 Verify, using a test allocator, that the memory of the cache is
+        //:   obtained from the supplied allocator, and that no memory is in
+        //:   use after the cache is destroyed.  (C-6)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-7)
+        //
+        // Testing:
+        //   MagazineCache(int, FlushFunction, void *, BslLock *, Allocator *);
+        //   ~MagazineCache();
+        //   void discardAll();
+        //   void flushAll();
+        //   void setCapacity(int classIdx, int capacity);
+        //   Magazine *threadMagazines();
+        //   int capacity(int classIdx) const;
+        //   Magazine *lookupThreadMagazines() const;
+        //   int numClasses() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MAGAZINE CACHE" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        Block blocks[8];
+
+        {
+            Owner owner;
+            owner.d_numClasses  = 2;
+            owner.d_allocator_p = 0;
+
+            Cache mX(2, &Owner::flush, &owner, &owner.d_lock, Z);
+            const Cache& X = mX;
+
+            ASSERT(2 == X.numClasses());
+            ASSERT(1 == X.capacity(0));
+            ASSERT(1 == X.capacity(1));
+            ASSERT(0 == X.lookupThreadMagazines());
+            ASSERT(1 == testAllocator.numBlocksInUse());
+
+            mX.setCapacity(0, 4);
+            mX.setCapacity(1, 2);
+            ASSERT(4 == X.capacity(0));
+            ASSERT(2 == X.capacity(1));
+
+            bdlma::Magazine *magazines = mX.threadMagazines();
+            ASSERT(magazines);
+            ASSERT(magazines == X.lookupThreadMagazines());
+            ASSERT(magazines == mX.threadMagazines());
+            ASSERT(2 == testAllocator.numBlocksInUse());
+
+            ASSERT(4 == magazines[0].capacity());
+            ASSERT(2 == magazines[1].capacity());
+            ASSERT(magazines[0].isEmpty());
+            ASSERT(magazines[1].isEmpty());
+
+            magazines[0].push(&blocks[0]);
+            magazines[1].push(&blocks[1]);
+
+            // Discarding forgets the blocks.
+
+            mX.discardAll();
+            ASSERT(0 == owner.d_numFlushes);
+            ASSERT(magazines[0].isEmpty());
+            ASSERT(magazines[1].isEmpty());
+
+            // Flushing returns them through the flush function.
+
+            bslma::TestAllocator blockAllocator(veryVeryVerbose);
+            owner.d_allocator_p = &blockAllocator;
+
+            magazines[0].push(blockAllocator.allocate(sizeof(Block)));
+            magazines[0].push(blockAllocator.allocate(sizeof(Block)));
+            magazines[1].push(blockAllocator.allocate(sizeof(Block)));
+
+            mX.flushAll();
+            ASSERT(1 == owner.d_numFlushes);
+            ASSERT(3 == owner.d_numFlushed);
+            ASSERT(0 == blockAllocator.numBlocksInUse());
+            ASSERT(magazines == X.lookupThreadMagazines());
+            ASSERT(magazines[0].isEmpty());
+            ASSERT(magazines[1].isEmpty());
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Owner owner;
+            owner.d_numClasses  = 2;
+            owner.d_allocator_p = Z;
+
+            ASSERT_FAIL(Cache(2, 0, &owner, &owner.d_lock, Z));
+            ASSERT_FAIL(Cache(2, &Owner::flush, &owner, 0, Z));
+
+            Cache mX(2, &Owner::flush, &owner, &owner.d_lock, Z);
+
+            ASSERT_PASS(mX.setCapacity(0, 1));
+            ASSERT_PASS(mX.setCapacity(1, 1));
+            ASSERT_FAIL(mX.setCapacity(-1, 1));
+            ASSERT_FAIL(mX.setCapacity( 2, 1));
+            ASSERT_FAIL(mX.setCapacity( 0, 0));
+
+            mX.threadMagazines();
+
+            ASSERT_FAIL(mX.setCapacity(0, 1));
+
+            Cache mY(0, &Owner::flush, &owner, &owner.d_lock, Z);
+
+            ASSERT_FAIL(mY.threadMagazines());
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'moveBlocks'
+        //
+        // Concerns:
+        //: 1 'moveBlocks' moves at most the requested number of blocks.
+        //:
+        //: 2 'moveBlocks' stops when the source is empty or the destination
+        //:   is full, and returns the number of blocks moved.
+        //:
+        //: 3 The counts of both magazines are updated, and the blocks remain
+        //:   intact.
+        //
+        // Plan:
+        //: 1 For a table of source sizes, destination sizes and capacities,
+        //:   and requested numbers of blocks, move blocks between two
+        //:   magazines and verify the result, the counts, and that popping
+        //:   both magazines yields exactly the original blocks.  (C-1..3)
+        //
+        // Testing:
+        //   int moveBlocks(Magazine *destination, int numBlocks);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'moveBlocks'" << endl
+                          << "====================" << endl;
+
+        static const struct {
+            int d_line;        // source line number
+            int d_srcBlocks;   // blocks initially in the source
+            int d_dstBlocks;   // blocks initially in the destination
+            int d_dstCapacity; // capacity of the destination
+            int d_numBlocks;   // number of blocks requested
+            int d_expMoved;    // expected number of blocks moved
+        } DATA[] = {
+            //LINE  SRC  DST  DCAP  NUM  EXP
+            //----  ---  ---  ----  ---  ---
+            { L_,     0,   0,    4,   2,   0 },
+            { L_,     3,   0,    4,   0,   0 },
+            { L_,     3,   0,    4,   2,   2 },
+            { L_,     3,   0,    4,   3,   3 },
+            { L_,     3,   0,    4,   5,   3 },
+            { L_,     3,   2,    4,   3,   2 },
+            { L_,     3,   4,    4,   3,   0 },
+            { L_,     8,   1,    8,   8,   7 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE = DATA[ti].d_line;
+            const int SRC  = DATA[ti].d_srcBlocks;
+            const int DST  = DATA[ti].d_dstBlocks;
+            const int DCAP = DATA[ti].d_dstCapacity;
+            const int NUM  = DATA[ti].d_numBlocks;
+            const int EXP  = DATA[ti].d_expMoved;
+
+            Block blocks[16];
+            for (int i = 0; i < 16; ++i) {
+                blocks[i].d_sequence = i;
+            }
+
+            Obj mS(8);
+            Obj mD(DCAP);
+
+            for (int i = 0; i < SRC; ++i) {
+                mS.push(&blocks[i]);
+            }
+            for (int i = 0; i < DST; ++i) {
+                mD.push(&blocks[8 + i]);
+            }
+
+            LOOP_ASSERT(LINE, EXP == mS.moveBlocks(&mD, NUM));
+            LOOP_ASSERT(LINE, SRC - EXP == mS.numBlocks());
+            LOOP_ASSERT(LINE, DST + EXP == mD.numBlocks());
+
+            int seen = 0;
+            while (!mS.isEmpty()) {
+                Block *b = static_cast<Block *>(mS.pop());
+                LOOP_ASSERT(LINE, b->d_sequence < SRC);
+                seen |= 1 << b->d_sequence;
+            }
+            while (!mD.isEmpty()) {
+                Block *b = static_cast<Block *>(mD.pop());
+                seen |= 1 << b->d_sequence;
+            }
+            const int expSeen = ((1 << SRC) - 1) | (((1 << DST) - 1) << 8);
+            LOOP_ASSERT(LINE, expSeen == seen);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'capacityFor' AND 'batchSize'
+        //
+        // Concerns:
+        //: 1 'capacityFor' returns the number of blocks fitting in the given
+        //:   number of bytes, clamped to the given range.
+        //:
+        //: 2 'batchSize' returns half of the capacity, but at least 1.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Verify 'capacityFor' and 'batchSize' for representative values,
+        //:   including the boundaries of the clamping range.  (C-1..2)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-3)
+        //
+        // Testing:
+        //   static int capacityFor(size_type, size_type, int, int);
+        //   int batchSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'capacityFor' AND 'batchSize'" << endl
+                          << "=====================================" << endl;
+
+        ASSERT(  4 == Obj::capacityFor(  16,    64, 1, 16));
+        ASSERT(  4 == Obj::capacityFor(  16,    79, 1, 16));
+        ASSERT(  1 == Obj::capacityFor(4096,  1024, 1, 16));
+        ASSERT(  2 == Obj::capacityFor(4096,  1024, 2, 16));
+        ASSERT( 16 == Obj::capacityFor(   8, 16384, 1, 16));
+        ASSERT(256 == Obj::capacityFor(  24, 16384, 2, 256));
+        ASSERT(  2 == Obj::capacityFor(   1,     0, 2, 256));
+
+        ASSERT(1 == Obj(1).batchSize());
+        ASSERT(1 == Obj(2).batchSize());
+        ASSERT(1 == Obj(3).batchSize());
+        ASSERT(8 == Obj(16).batchSize());
+        ASSERT(8 == Obj(17).batchSize());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj::capacityFor(1, 16, 1, 1));
+            ASSERT_FAIL(Obj::capacityFor(0, 16, 1, 1));
+            ASSERT_FAIL(Obj::capacityFor(1, 16, 0, 1));
+            ASSERT_FAIL(Obj::capacityFor(1, 16, 2, 1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // MAGAZINE PRIMARY MANIPULATORS
+        //
+        // Concerns:
+        //: 1 A new magazine is empty and has the specified capacity.
+        //:
+        //: 2 Blocks are popped in the reverse order of being pushed.
+        //:
+        //: 3 'numBlocks', 'isEmpty', and 'isFull' reflect the number of
+        //:   blocks held.
+        //:
+        //: 4 'removeAll' empties the magazine without accessing the blocks.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create magazines of several capacities, fill them, verify the
+        //:   accessors after each push, and pop the blocks verifying their
+        //:   order.  (C-1..3)
+        //:
+        //: 2 Fill a magazine with blocks, overwrite the blocks, and invoke
+        //:   'removeAll'.  (C-4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   explicit Magazine(int capacity);
+        //   void *pop();
+        //   void push(void *block);
+        //   void removeAll();
+        //   int capacity() const;
+        //   bool isEmpty() const;
+        //   bool isFull() const;
+        //   int numBlocks() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MAGAZINE PRIMARY MANIPULATORS" << endl
+                          << "=============================" << endl;
+
+        for (int capacity = 1; capacity <= 8; ++capacity) {
+            Block blocks[8];
+
+            Obj mX(capacity);  const Obj& X = mX;
+
+            LOOP_ASSERT(capacity, capacity == X.capacity());
+            LOOP_ASSERT(capacity, 0 == X.numBlocks());
+            LOOP_ASSERT(capacity, X.isEmpty());
+            LOOP_ASSERT(capacity, !X.isFull());
+
+            for (int i = 0; i < capacity; ++i) {
+                blocks[i].d_sequence = i;
+                mX.push(&blocks[i]);
+
+                LOOP2_ASSERT(capacity, i, i + 1 == X.numBlocks());
+                LOOP2_ASSERT(capacity, i, !X.isEmpty());
+                LOOP2_ASSERT(capacity, i, (i + 1 == capacity) == X.isFull());
+                LOOP2_ASSERT(capacity, i, i == blocks[i].d_sequence);
+            }
+
+            for (int i = capacity - 1; 0 <= i; --i) {
+                LOOP2_ASSERT(capacity, i, &blocks[i] == mX.pop());
+                LOOP2_ASSERT(capacity, i, i == X.numBlocks());
+                LOOP2_ASSERT(capacity, i, !X.isFull());
+            }
+            LOOP_ASSERT(capacity, X.isEmpty());
+
+            for (int i = 0; i < capacity; ++i) {
+                mX.push(&blocks[i]);
+            }
+            for (int i = 0; i < capacity; ++i) {
+                blocks[i].d_link = reinterpret_cast<void *>(-1);
+            }
+            mX.removeAll();
+            LOOP_ASSERT(capacity, X.isEmpty());
+            LOOP_ASSERT(capacity, 0 == X.numBlocks());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Block block;
+
+            ASSERT_SAFE_PASS(Obj(1));
+            ASSERT_SAFE_FAIL(Obj(0));
+
+            Obj mX(1);
+
+            ASSERT_SAFE_FAIL(mX.pop());
+            ASSERT_SAFE_FAIL(mX.push(0));
+            ASSERT_SAFE_PASS(mX.push(&block));
+            ASSERT_SAFE_FAIL(mX.push(&block));
+            ASSERT_SAFE_PASS(mX.pop());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Push blocks onto a magazine, move some of them to another, and
+        //:   pop them all.  Obtain the magazines of the main thread from a
+        //:   magazine cache and flush them.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        Block blocks[4];
+
+        Obj mX(4);
+        Obj mY(2);
+
+        for (int i = 0; i < 4; ++i) {
+            mX.push(&blocks[i]);
+        }
+        ASSERT(mX.isFull());
+        ASSERT(2 == mX.moveBlocks(&mY, mX.batchSize()));
+        ASSERT(mY.isFull());
+        ASSERT(&blocks[2] == mY.pop());
+        ASSERT(&blocks[1] == mX.pop());
+
+        Owner owner;
+        owner.d_numClasses  = 1;
+        owner.d_allocator_p = Z;
+
+        {
+            Cache mC(1, &Owner::flush, &owner, &owner.d_lock, Z);
+            mC.setCapacity(0, 8);
+
+            bdlma::Magazine *magazines = mC.threadMagazines();
+            ASSERT(8 == magazines[0].capacity());
+
+            magazines[0].push(Z->allocate(sizeof(Block)));
+            mC.flushAll();
+            ASSERT(1 == owner.d_numFlushed);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -10,22 +10,79 @@ BSLS_IDENT_RCSID(bdlma_multipool_cpp,"$Id$ $CSID$")
 #include <bslma_deallocatorproctor.h>
 #include <bslma_default.h>
 
+#include <bsls_alignmentfromtype.h>
+#include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
 #include <bsls_performancehint.h>
 #include <bsls_platform.h>
+#include <bsls_types.h>
 
+#include <bsl_algorithm.h>
+#include <bsl_limits.h>
 #include <bsl_new.h>
+#include <bsl_vector.h>
 
 namespace BloombergLP {
 namespace bdlma {
 
 // TYPES
 enum {
-    DEFAULT_NUM_POOLS      = 10,  // default number of pools
+    DEFAULT_NUM_POOLS       = 10,    // default number of pools
 
-    DEFAULT_MAX_CHUNK_SIZE = 32,  // default maximum number of blocks per chunk
+    DEFAULT_MAX_CHUNK_SIZE  = 32,    // default maximum number of blocks per
+                                     // chunk
 
-    MIN_BLOCK_SIZE         =  8   // minimum block size (in bytes)
+    MIN_BLOCK_SIZE          =  8,    // minimum block size (in bytes)
+
+    NUM_WARM_UP_ALLOCATIONS = 1024   // number of allocations of poolable size
+                                     // whose sizes an adaptive multipool
+                                     // records before choosing its block
+                                     // sizes
+};
+
+namespace {
+
+int nextQuarterPowerOfTwoSize(int size)
+    // Return the block size following the specified 'size' in a sequence of
+    // block sizes having four sizes, rounded up to multiples of
+    // 'MIN_BLOCK_SIZE', per power of two.
+{
+    int powerOfTwo = MIN_BLOCK_SIZE;
+    while (powerOfTwo <= size / 2) {
+        powerOfTwo *= 2;
+    }
+    return size + bsl::max<int>(MIN_BLOCK_SIZE, powerOfTwo / 4);
+}
+
+}  // close unnamed namespace
+
+                        // ------------------------
+                        // struct Multipool::WarmUp
+                        // ------------------------
+
+struct Multipool::WarmUp {
+    // This 'struct' holds the state of an adaptive multipool during its
+    // warm-up phase.  It is allocated together with the histogram of the
+    // requested sizes, which immediately follows it.
+
+    int                          d_numAllocationsRemaining;
+                                     // number of allocations of poolable
+                                     // size until the end of the warm-up
+
+    int                          d_maxNumPools;
+                                     // maximum number of pools to create
+
+    bsls::BlockGrowth::Strategy  d_growthStrategy;
+                                     // growth strategy of the pools
+
+    int                          d_maxBlocksPerChunk;
+                                     // maximum chunk size of the pools
+
+    int                         *d_counts_p;
+                                     // number of requests of each size,
+                                     // rounded up to a multiple of
+                                     // 'MIN_BLOCK_SIZE', indexed by that
+                                     // multiple
 };
 
                       // ---------------
@@ -59,6 +116,7 @@ void Multipool::initialize(bsls::BlockGrowth::Strategy growthStrategy,
     }
 
     d_maxBlockSize /= 2;
+    d_maxPooledBlockSize = d_maxBlockSize;
 
     autoDtor.release();
     autoPoolsDeallocator.release();
@@ -92,6 +150,7 @@ void Multipool::initialize(
     }
 
     d_maxBlockSize /= 2;
+    d_maxPooledBlockSize = d_maxBlockSize;
 
     autoDtor.release();
     autoPoolsDeallocator.release();
@@ -123,6 +182,7 @@ void Multipool::initialize(bsls::BlockGrowth::Strategy  growthStrategy,
     }
 
     d_maxBlockSize /= 2;
+    d_maxPooledBlockSize = d_maxBlockSize;
 
     autoDtor.release();
     autoPoolsDeallocator.release();
@@ -156,9 +216,243 @@ void Multipool::initialize(
     }
 
     d_maxBlockSize /= 2;
+    d_maxPooledBlockSize = d_maxBlockSize;
+
+    autoDtor.release();
+    autoPoolsDeallocator.release();
+}
+
+void Multipool::initialize(SizeClassSpacing            spacing,
+                           bsls::BlockGrowth::Strategy growthStrategy,
+                           int                         maxBlocksPerChunk)
+{
+    BSLS_ASSERT(1          <= d_numPools);
+    BSLS_ASSERT(d_numPools <= bsl::numeric_limits<unsigned char>::max());
+    BSLS_ASSERT(1          <= maxBlocksPerChunk);
+
+    switch (spacing) {
+      case e_POWER_OF_TWO: {
+        initialize(growthStrategy, maxBlocksPerChunk);
+      } break;
+      case e_QUARTER_POWER_OF_TWO: {
+        bsl::vector<int> blockSizes(d_allocator_p);
+        blockSizes.reserve(d_numPools);
+
+        int blockSize = MIN_BLOCK_SIZE;
+        for (int i = 0; i < d_numPools; ++i) {
+            BSLS_ASSERT(0 < blockSize);
+
+            blockSizes.push_back(blockSize);
+            blockSize = nextQuarterPowerOfTwoSize(blockSize);
+        }
+
+        initialize(blockSizes.data(),
+                   d_numPools,
+                   growthStrategy,
+                   maxBlocksPerChunk);
+      } break;
+      default: {
+        BSLS_ASSERT(e_ADAPTIVE == spacing);
+        BSLS_ASSERT(d_numPools < bsl::numeric_limits<int>::digits - 2);
+
+        // No pools exist until the end of the warm-up phase, so that every
+        // request takes the unpooled path of 'allocate'.
+
+        const int maxPooledBlockSize = MIN_BLOCK_SIZE << (d_numPools - 1);
+        const int numSizes           = maxPooledBlockSize / MIN_BLOCK_SIZE + 1;
+
+        char *buffer = static_cast<char *>(d_allocator_p->allocate(
+                                    sizeof(WarmUp) + numSizes * sizeof(int)));
+
+        WarmUp *warmUp = reinterpret_cast<WarmUp *>(buffer);
+        warmUp->d_numAllocationsRemaining = NUM_WARM_UP_ALLOCATIONS;
+        warmUp->d_maxNumPools             = d_numPools;
+        warmUp->d_growthStrategy          = growthStrategy;
+        warmUp->d_maxBlocksPerChunk       = maxBlocksPerChunk;
+        warmUp->d_counts_p = reinterpret_cast<int *>(buffer + sizeof(WarmUp));
+        bsl::fill_n(warmUp->d_counts_p, numSizes, 0);
+
+        d_pools_p            = 0;
+        d_numPools           = 0;
+        d_maxBlockSize       = 0;
+        d_maxPooledBlockSize = maxPooledBlockSize;
+        d_warmUp_p           = warmUp;
+        d_isAdaptive         = true;
+      } break;
+    }
+}
+
+void Multipool::initialize(const int                   *blockSizeArray,
+                           int                          numPools,
+                           bsls::BlockGrowth::Strategy  growthStrategy,
+                           int                          maxBlocksPerChunk)
+{
+    BSLS_ASSERT(blockSizeArray);
+    BSLS_ASSERT(1        <= numPools);
+    BSLS_ASSERT(numPools <= bsl::numeric_limits<unsigned char>::max());
+    BSLS_ASSERT(1        <= maxBlocksPerChunk);
+
+    for (int i = 0; i < numPools; ++i) {
+        BSLS_ASSERT(0 <  blockSizeArray[i]);
+        BSLS_ASSERT(0 == blockSizeArray[i] % MIN_BLOCK_SIZE);
+        BSLS_ASSERT(0 == i || blockSizeArray[i - 1] < blockSizeArray[i]);
+    }
+
+    const int maxBlockSize = blockSizeArray[numPools - 1];
+    const int numSizes     = maxBlockSize / MIN_BLOCK_SIZE + 1;
+
+    unsigned char *table = static_cast<unsigned char *>(
+                                            d_allocator_p->allocate(numSizes));
+
+    bslma::DeallocatorProctor<bslma::Allocator> autoTableDeallocator(
+                                                                table,
+                                                                d_allocator_p);
+
+    Pool *pools = static_cast<Pool *>(
+                            d_allocator_p->allocate(numPools * sizeof *pools));
+
+    bslma::DeallocatorProctor<bslma::Allocator> autoPoolsDeallocator(
+                                                                pools,
+                                                                d_allocator_p);
+    bslma::AutoDestructor<Pool> autoDtor(pools, 0);
+
+    for (int i = 0; i < numPools; ++i, ++autoDtor) {
+        new (pools + i) Pool(blockSizeArray[i] + sizeof(Header),
+                             growthStrategy,
+                             maxBlocksPerChunk,
+                             d_allocator_p);
+    }
+
+    // Entry 'i' of the table holds the index of the pool for the requests of
+    // '8 * (i - 1) + 1' to '8 * i' bytes.
+
+    for (int i = 0, pool = 0; i < numSizes; ++i) {
+        while (blockSizeArray[pool] < i * MIN_BLOCK_SIZE) {
+            ++pool;
+        }
+        table[i] = static_cast<unsigned char>(pool);
+    }
 
     autoDtor.release();
     autoPoolsDeallocator.release();
+    autoTableDeallocator.release();
+
+    d_pools_p            = pools;
+    d_numPools           = numPools;
+    d_maxBlockSize       = maxBlockSize;
+    d_maxPooledBlockSize = maxBlockSize;
+    d_sizeClassTable_p   = table;
+}
+
+void *Multipool::allocateWarmUp(int size)
+{
+    BSLS_ASSERT(d_warmUp_p);
+
+    if (size <= d_maxPooledBlockSize) {
+        ++d_warmUp_p->d_counts_p[(size + MIN_BLOCK_SIZE - 1) / MIN_BLOCK_SIZE];
+
+        if (0 >= --d_warmUp_p->d_numAllocationsRemaining) {
+            endWarmUp();
+            return allocate(size);                                    // RETURN
+        }
+    }
+
+    Header *p = static_cast<Header *>(
+                                  d_blockList.allocate(size + sizeof(Header)));
+    p->d_header.d_poolIdx = -1;
+    p->d_header.d_offset  = 0;
+    return p + 1;
+}
+
+void Multipool::endWarmUp()
+{
+    BSLS_ASSERT(d_warmUp_p);
+
+    typedef bsls::Types::Int64 Int64;
+
+    const WarmUp& warmUp   = *d_warmUp_p;
+    const int     numSizes = d_maxPooledBlockSize / MIN_BLOCK_SIZE + 1;
+
+    // The candidate block sizes are the (rounded) sizes that were requested,
+    // and the largest pooled size, which must be a block size so that every
+    // request up to 'd_maxPooledBlockSize' is pooled.  'counts[j]' is the
+    // number of requests of the 'j'th candidate size.
+
+    bsl::vector<int>   candidates(d_allocator_p);
+    bsl::vector<Int64> counts(d_allocator_p);
+
+    for (int i = 1; i < numSizes; ++i) {
+        if (warmUp.d_counts_p[i] || numSizes - 1 == i) {
+            candidates.push_back(i * MIN_BLOCK_SIZE);
+            counts.push_back(warmUp.d_counts_p[i]);
+        }
+    }
+
+    const int numCandidates = static_cast<int>(candidates.size());
+    const int numPools      = bsl::min(warmUp.d_maxNumPools, numCandidates);
+
+    // Choose the 'numPools' block sizes among the candidates minimizing the
+    // number of bytes that the recorded requests would have occupied.  After
+    // iteration 'k', 'cost[j]' is the minimal number of bytes occupied by the
+    // requests of the first 'j' candidate sizes using 'k' block sizes, the
+    // largest of which is candidate 'j - 1', and 'choice[k][j]' is the number
+    // of candidate sizes served by the smaller 'k - 1' block sizes.
+
+    const Int64 k_INFINITE = bsl::numeric_limits<Int64>::max();
+
+    bsl::vector<Int64> prefixCounts(numCandidates + 1, 0, d_allocator_p);
+    for (int j = 0; j < numCandidates; ++j) {
+        prefixCounts[j + 1] = prefixCounts[j] + counts[j];
+    }
+
+    bsl::vector<Int64> cost(numCandidates + 1, k_INFINITE, d_allocator_p);
+    bsl::vector<Int64> nextCost(numCandidates + 1, k_INFINITE, d_allocator_p);
+    bsl::vector<int>   choice((numPools + 1) * (numCandidates + 1),
+                              0,
+                              d_allocator_p);
+    cost[0] = 0;
+
+    for (int k = 1; k <= numPools; ++k) {
+        nextCost[0] = k_INFINITE;
+
+        for (int j = 1; j <= numCandidates; ++j) {
+            const Int64 blockSize = candidates[j - 1];
+
+            Int64 best       = k_INFINITE;
+            int   bestChoice = 0;
+
+            for (int i = k - 1; i < j; ++i) {
+                if (k_INFINITE == cost[i]) {
+                    continue;
+                }
+                const Int64 numRequests = prefixCounts[j] - prefixCounts[i];
+                const Int64 c           = cost[i] + blockSize * numRequests;
+                if (c < best) {
+                    best       = c;
+                    bestChoice = i;
+                }
+            }
+
+            nextCost[j]                         = best;
+            choice[k * (numCandidates + 1) + j] = bestChoice;
+        }
+
+        cost.swap(nextCost);
+    }
+
+    bsl::vector<int> blockSizes(numPools, 0, d_allocator_p);
+    for (int k = numPools, j = numCandidates; 0 < k; --k) {
+        blockSizes[k - 1] = candidates[j - 1];
+        j = choice[k * (numCandidates + 1) + j];
+    }
+
+    initialize(blockSizes.data(),
+               numPools,
+               warmUp.d_growthStrategy,
+               warmUp.d_maxBlocksPerChunk);
+
+    d_allocator_p->deallocate(d_warmUp_p);
+    d_warmUp_p = 0;
 }
 
 // PRIVATE ACCESSORS
@@ -167,6 +461,10 @@ int Multipool::findPool(int size) const
     BSLS_ASSERT_SAFE(0    <= size);
     BSLS_ASSERT_SAFE(size <= d_maxBlockSize);
 
+    if (d_sizeClassTable_p) {
+        return d_sizeClassTable_p[(size + MIN_BLOCK_SIZE - 1) >> 3];  // RETURN
+    }
+
     int accumulator = ((size + MIN_BLOCK_SIZE - 1) >> 3) * 2 - 1;
 
     accumulator |= accumulator >> 16;
@@ -198,8 +496,13 @@ int Multipool::findPool(int size) const
 // CREATORS
 Multipool::Multipool(bslma::Allocator *basicAllocator)
 : d_numPools(DEFAULT_NUM_POOLS)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     initialize(bsls::BlockGrowth::BSLS_GEOMETRIC, DEFAULT_MAX_CHUNK_SIZE);
 }
@@ -207,8 +510,13 @@ Multipool::Multipool(bslma::Allocator *basicAllocator)
 Multipool::Multipool(int               numPools,
                      bslma::Allocator *basicAllocator)
 : d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     BSLS_ASSERT(1 <= numPools);
 
@@ -218,8 +526,13 @@ Multipool::Multipool(int               numPools,
 Multipool::Multipool(bsls::BlockGrowth::Strategy  growthStrategy,
                      bslma::Allocator            *basicAllocator)
 : d_numPools(DEFAULT_NUM_POOLS)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     initialize(growthStrategy, DEFAULT_MAX_CHUNK_SIZE);
 }
@@ -228,8 +541,13 @@ Multipool::Multipool(int                          numPools,
                      bsls::BlockGrowth::Strategy  growthStrategy,
                      bslma::Allocator            *basicAllocator)
 : d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     BSLS_ASSERT(1 <= numPools);
 
@@ -240,8 +558,13 @@ Multipool::Multipool(int                                numPools,
                      const bsls::BlockGrowth::Strategy *growthStrategyArray,
                      bslma::Allocator                  *basicAllocator)
 : d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     BSLS_ASSERT(1 <= numPools);
     BSLS_ASSERT(growthStrategyArray);
@@ -254,8 +577,13 @@ Multipool::Multipool(int                          numPools,
                      int                          maxBlocksPerChunk,
                      bslma::Allocator            *basicAllocator)
 : d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     BSLS_ASSERT(1 <= numPools);
     BSLS_ASSERT(1 <= maxBlocksPerChunk);
@@ -268,8 +596,13 @@ Multipool::Multipool(int                                numPools,
                      int                                maxBlocksPerChunk,
                      bslma::Allocator                  *basicAllocator)
 : d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     BSLS_ASSERT(1 <= numPools);
     BSLS_ASSERT(growthStrategyArray);
@@ -283,8 +616,13 @@ Multipool::Multipool(int                          numPools,
                      const int                   *maxBlocksPerChunkArray,
                      bslma::Allocator            *basicAllocator)
 : d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     BSLS_ASSERT(1 <= numPools);
     BSLS_ASSERT(maxBlocksPerChunkArray);
@@ -297,8 +635,13 @@ Multipool::Multipool(int                                numPools,
                      const int                         *maxBlocksPerChunkArray,
                      bslma::Allocator                  *basicAllocator)
 : d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
 , d_blockList(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
 {
     BSLS_ASSERT(1 <= numPools);
     BSLS_ASSERT(growthStrategyArray);
@@ -307,11 +650,92 @@ Multipool::Multipool(int                                numPools,
     initialize(growthStrategyArray, maxBlocksPerChunkArray);
 }
 
+Multipool::Multipool(int                          numPools,
+                     SizeClassSpacing             spacing,
+                     bslma::Allocator            *basicAllocator)
+: d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
+, d_blockList(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
+{
+    BSLS_ASSERT(1 <= numPools);
+
+    initialize(spacing,
+               bsls::BlockGrowth::BSLS_GEOMETRIC,
+               DEFAULT_MAX_CHUNK_SIZE);
+}
+
+Multipool::Multipool(int                          numPools,
+                     SizeClassSpacing             spacing,
+                     bsls::BlockGrowth::Strategy  growthStrategy,
+                     int                          maxBlocksPerChunk,
+                     bslma::Allocator            *basicAllocator)
+: d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
+, d_blockList(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
+{
+    BSLS_ASSERT(1 <= numPools);
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+
+    initialize(spacing, growthStrategy, maxBlocksPerChunk);
+}
+
+Multipool::Multipool(int                          numPools,
+                     const int                   *blockSizeArray,
+                     bslma::Allocator            *basicAllocator)
+: d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
+, d_blockList(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
+{
+    BSLS_ASSERT(1 <= numPools);
+    BSLS_ASSERT(blockSizeArray);
+
+    initialize(blockSizeArray,
+               numPools,
+               bsls::BlockGrowth::BSLS_GEOMETRIC,
+               DEFAULT_MAX_CHUNK_SIZE);
+}
+
+Multipool::Multipool(int                          numPools,
+                     const int                   *blockSizeArray,
+                     bsls::BlockGrowth::Strategy  growthStrategy,
+                     int                          maxBlocksPerChunk,
+                     bslma::Allocator            *basicAllocator)
+: d_numPools(numPools)
+, d_sizeClassTable_p(0)
+, d_warmUp_p(0)
+, d_isAdaptive(false)
+, d_blockList(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_autoTrimInterval(0)
+, d_numDeallocationsUntilTrim(0)
+{
+    BSLS_ASSERT(1 <= numPools);
+    BSLS_ASSERT(blockSizeArray);
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+
+    initialize(blockSizeArray, numPools, growthStrategy, maxBlocksPerChunk);
+}
+
 Multipool::~Multipool()
 {
-    BSLS_ASSERT(d_pools_p);
-    BSLS_ASSERT(1 <= d_numPools);
-    BSLS_ASSERT(1 <= d_maxBlockSize);
+    BSLS_ASSERT(d_pools_p || d_warmUp_p);
+    BSLS_ASSERT(0 <= d_numPools);
+    BSLS_ASSERT(0 <= d_maxBlockSize);
     BSLS_ASSERT(d_allocator_p);
 
     d_blockList.release();
@@ -320,9 +744,173 @@ Multipool::~Multipool()
         d_pools_p[i].~Pool();
     }
     d_allocator_p->deallocate(d_pools_p);
+    d_allocator_p->deallocate(d_sizeClassTable_p);
+    d_allocator_p->deallocate(d_warmUp_p);
+}
+
+// PRIVATE MANIPULATORS
+void Multipool::countDeallocations(int numBlocks)
+{
+    BSLS_ASSERT(0 < d_autoTrimInterval);
+    BSLS_ASSERT(1 <= numBlocks);
+
+    d_numDeallocationsUntilTrim -= numBlocks;
+    if (0 >= d_numDeallocationsUntilTrim) {
+        trim();
+        d_numDeallocationsUntilTrim = d_autoTrimInterval;
+    }
 }
 
 // MANIPULATORS
+void *Multipool::allocateAligned(int size, int alignment)
+{
+    BSLS_ASSERT(1 <= size);
+    BSLS_ASSERT(0 <  alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    // Pooled blocks are aligned at least as well as a pointer, and so is the
+    // address following their header.
+
+    const int minAlignment = bsls::AlignmentFromType<void *>::VALUE;
+
+    if (alignment <= minAlignment) {
+        return allocate(size);                                        // RETURN
+    }
+
+    const int paddedSize = size + alignment - minAlignment;
+
+    int   pool;
+    char *block;
+
+    if (paddedSize <= d_maxBlockSize) {
+        pool  = findPool(paddedSize);
+        block = static_cast<char *>(d_pools_p[pool].allocate());
+    }
+    else {
+        pool  = -1;
+        block = static_cast<char *>(
+                            d_blockList.allocate(paddedSize + sizeof(Header)));
+    }
+
+    char *address = block + sizeof(Header);
+    address += bsls::AlignmentUtil::calculateAlignmentOffset(address,
+                                                             alignment);
+
+    Header *h = reinterpret_cast<Header *>(address) - 1;
+    h->d_header.d_poolIdx = pool;
+    h->d_header.d_offset  = static_cast<int>(reinterpret_cast<char *>(h)
+                                                                     - block);
+    return address;
+}
+
+void *Multipool::allocateN(int numBlocks, int size)
+{
+    BSLS_ASSERT(1 <= numBlocks);
+    BSLS_ASSERT(1 <= size);
+    BSLS_ASSERT(size <= d_maxPooledBlockSize);
+
+    if (size > d_maxBlockSize) {
+        // This multipool is warming up: allocate the blocks individually,
+        // linking them in allocation order.
+
+        void  *first = 0;
+        void **link  = &first;
+
+        for (int i = 0; i < numBlocks; ++i) {
+            void *block = allocate(size);
+            *link = block;
+            link  = static_cast<void **>(block);
+        }
+        *link = 0;
+
+        return first;                                                 // RETURN
+    }
+
+    const int pool = findPool(size);
+
+    // The chain returned by the pool is linked through the first word of each
+    // block, which is where the header goes; relink it through the first word
+    // following each header.
+
+    Header *h = static_cast<Header *>(d_pools_p[pool].allocateN(numBlocks));
+    Header *first = h;
+
+    while (h) {
+        Header *next = *reinterpret_cast<Header **>(h);
+
+        h->d_header.d_poolIdx = pool;
+        h->d_header.d_offset  = 0;
+        *reinterpret_cast<void **>(h + 1) = next ? next + 1 : 0;
+
+        h = next;
+    }
+
+    return first + 1;
+}
+
+void Multipool::deallocateN(void *first, void *last, int size)
+{
+    BSLS_ASSERT(first);
+    BSLS_ASSERT(last);
+    BSLS_ASSERT(1 <= size);
+    BSLS_ASSERT(size <= d_maxPooledBlockSize);
+
+    if (d_isAdaptive) {
+        // Blocks allocated during a warm-up phase are not pooled; if the chain
+        // has any, deallocate its blocks individually.
+
+        bool isPooled = size <= d_maxBlockSize;
+
+        for (void *p = first; isPooled; p = *static_cast<void **>(p)) {
+            const Header *h = static_cast<Header *>(p) - 1;
+            isPooled = -1 != h->d_header.d_poolIdx;
+            if (p == last) {
+                break;
+            }
+        }
+
+        if (!isPooled) {
+            void *p = first;
+            while (p != last) {
+                void *next = *static_cast<void **>(p);
+                deallocate(p);
+                p = next;
+            }
+            deallocate(last);
+            return;                                                   // RETURN
+        }
+    }
+
+    const int pool = findPool(size);
+
+    // Relink the chain through the headers of its blocks, which is where the
+    // pool expects its links.
+
+    Header *h    = static_cast<Header *>(first) - 1;
+    Header *tail = static_cast<Header *>(last)  - 1;
+    int     numBlocks = 1;
+
+    while (h != tail) {
+        BSLS_ASSERT_SAFE(pool == h->d_header.d_poolIdx);
+        BSLS_ASSERT_SAFE(0    == h->d_header.d_offset);
+
+        Header *next = *reinterpret_cast<Header **>(h + 1) - 1;
+        *reinterpret_cast<Header **>(h) = next;
+
+        h = next;
+        ++numBlocks;
+    }
+
+    BSLS_ASSERT_SAFE(pool == tail->d_header.d_poolIdx);
+    BSLS_ASSERT_SAFE(0    == tail->d_header.d_offset);
+
+    d_pools_p[pool].deallocateN(static_cast<Header *>(first) - 1, tail);
+
+    if (d_autoTrimInterval) {
+        countDeallocations(numBlocks);
+    }
+}
+
 void Multipool::release()
 {
     for (int i = 0; i < d_numPools; ++i) {
@@ -334,13 +922,36 @@ void Multipool::release()
 void Multipool::reserveCapacity(int size, int numBlocks)
 {
     BSLS_ASSERT(1    <= size);
-    BSLS_ASSERT(size <= d_maxBlockSize);
+    BSLS_ASSERT(size <= d_maxPooledBlockSize);
     BSLS_ASSERT(0    <= numBlocks);
 
+    if (size > d_maxBlockSize) {
+        // This multipool is warming up and has no pools.
+
+        return;                                                       // RETURN
+    }
+
     const int pool = findPool(size);
     d_pools_p[pool].reserveCapacity(numBlocks);
 }
 
+void Multipool::setAutoTrimInterval(int numDeallocations)
+{
+    BSLS_ASSERT(0 <= numDeallocations);
+
+    d_autoTrimInterval          = numDeallocations;
+    d_numDeallocationsUntilTrim = numDeallocations;
+}
+
+int Multipool::trim()
+{
+    int numReleased = 0;
+    for (int i = 0; i < d_numPools; ++i) {
+        numReleased += d_pools_p[i].trim();
+    }
+    return numReleased;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
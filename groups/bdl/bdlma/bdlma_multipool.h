@@ -26,6 +26,12 @@ BSLS_IDENT("$Id: $")
 // sufficient size exists.  Both the 'release' method and the destructor of a
 // 'bdlma::Multipool' release all memory currently allocated via the object.
 //
+// 'allocateAligned' dispenses blocks aligned to a specified power of two
+// (e.g., the size of a cache line).  Such a block is taken from the pool whose
+// blocks are large enough to hold the request plus the padding needed to
+// reach the alignment, so only that padding, and not a whole block, is spent
+// on the alignment.
+//
 // A 'bdlma::Multipool' can be depicted visually:
 //..
 //                    +-----+--- memory blocks of 8 bytes
@@ -96,6 +102,57 @@ BSLS_IDENT("$Id: $")
 // single value applying to all of the maintained pools, or as an array of
 // values, with the elements applying to each individually maintained pool.
 //
+///Size Classes
+///------------
+// By default, the block sizes of the pools are successive powers of two, so
+// a request a little larger than a power of two (say, a 33-byte string
+// representation, or a 72-byte map node) is given a block almost twice its
+// size.  Finer size classes can be configured at construction, by supplying
+// a 'Multipool::SizeClassSpacing' or an explicit array of block sizes:
+//
+//: 'e_POWER_OF_TWO':
+//:   The default: block sizes 8, 16, 32, ..., '2^(N+2)' for 'N' pools.
+//:
+//: 'e_QUARTER_POWER_OF_TWO':
+//:   Four block sizes per power of two, rounded up to multiples of 8 (i.e.,
+//:   8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, ...), so that no
+//:   pooled block exceeds its request by more than 25% (plus 7 bytes).  Note
+//:   that 'N' pools of this spacing cover a smaller range of sizes than 'N'
+//:   pools of power-of-two spacing.
+//:
+//: 'e_ADAPTIVE':
+//:   The range of sizes of 'N' power-of-two pools is split into at most 'N'
+//:   classes chosen from the sizes actually requested: during an initial
+//:   warm-up phase (an implementation-defined number of allocations of
+//:   poolable size), requests are satisfied directly from the underlying
+//:   allocator while a histogram of their sizes is recorded, after which the
+//:   block sizes minimizing the memory wasted on that histogram are chosen,
+//:   and the pools are created.  Blocks allocated during the warm-up phase
+//:   may be deallocated at any time.
+//:
+//: explicit block sizes:
+//:   The caller supplies the (increasing) block sizes of the pools, each a
+//:   multiple of 8.
+//
+// Whatever the configuration, finding the pool for a request takes no loop
+// and no branch other than one (perfectly predictable) test of the kind of
+// size classes: a power-of-two multipool computes the pool index
+// arithmetically, and any other multipool reads it from a table having one
+// byte for every 8 bytes of the largest pooled block size.
+//
+///Trimming
+///--------
+// The chunks of the internal pools are normally returned to the basic
+// allocator only by 'release' or by destruction, so a long-lived multipool
+// whose usage spiked once retains its peak footprint.  The 'trim' method
+// returns to the basic allocator every chunk, in every pool, none of whose
+// blocks is currently allocated (see 'bdlma_pool').  In addition, a multipool
+// can be configured, by 'setAutoTrimInterval', to call 'trim' by itself after
+// every 'N' deallocations of pooled blocks.  Automatic trimming is disabled by
+// default, in which case its only cost on the deallocation path is the test of
+// the (unchanging) trim interval; the deallocations are counted, out of line,
+// only while automatic trimming is enabled.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -479,6 +536,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_blockgrowth.h>
 #endif
 
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
 namespace BloombergLP {
 namespace bdlma {
 
@@ -499,20 +560,43 @@ class Multipool {
     // a 'bdlma::Multipool' release all memory currently allocated via the
     // object.
 
+  public:
+    // TYPES
+    enum SizeClassSpacing {
+        // Enumeration of the ways in which the block sizes of the pools of a
+        // multipool are chosen (see {Size Classes}).
+
+        e_POWER_OF_TWO,          // each block size twice the previous one
+        e_QUARTER_POWER_OF_TWO,  // four block sizes per power of two
+        e_ADAPTIVE               // chosen from the sizes requested during a
+                                 // warm-up phase
+    };
+
+  private:
     // PRIVATE TYPES
-    struct Header {
-        // This 'struct' provides header information for each allocated memory
+    struct WarmUp;
+        // State of an adaptive multipool during its warm-up phase (defined in
+        // the implementation file).
+
+    union Header {
+        // This 'union' provides header information for each allocated memory
         // block.  The header stores the index to the pool used for the memory
-        // allocation.
+        // allocation, and the distance from the start of the memory obtained
+        // from that pool (or from 'd_blockList') to the header, which is
+        // non-zero only for blocks dispensed by 'allocateAligned'.
 
-        union {
+        struct {
             int                    d_poolIdx;  // index to pool used for this
                                                // memory block, or -1 if from
                                                // 'd_blockList'
 
-            bsls::AlignmentUtil::MaxAlignedType
-                                   d_dummy;    // force maximum alignment
+            int                    d_offset;   // offset (in bytes) of this
+                                               // header from the start of the
+                                               // underlying memory block
         } d_header;
+
+        bsls::AlignmentUtil::MaxAlignedType
+                                   d_dummy;    // force maximum alignment
     };
 
     // DATA
@@ -522,16 +606,51 @@ class Multipool {
     int               d_numPools;      // number of memory pools
 
     int               d_maxBlockSize;  // largest memory block size; dispensed
-                                       // by the 'd_numPools - 1'th pool;
-                                       // always a power of 2
+                                       // by the 'd_numPools - 1'th pool, or 0
+                                       // during a warm-up phase (so that all
+                                       // requests take the unpooled path)
+
+    int               d_maxPooledBlockSize;
+                                       // largest memory block size that is
+                                       // (or, once warmed up, will be) pooled
+
+    unsigned char    *d_sizeClassTable_p;
+                                       // index of the pool for each multiple
+                                       // of 8 bytes up to 'd_maxBlockSize',
+                                       // or 0 if the block sizes are powers
+                                       // of 2
+
+    WarmUp           *d_warmUp_p;      // histogram of requested sizes, or 0
+                                       // unless in a warm-up phase
+
+    bool              d_isAdaptive;    // 'true' if the block sizes are (or
+                                       // will be) chosen adaptively, so that
+                                       // small blocks may be unpooled
 
     BlockList         d_blockList;     // memory manager for "large" memory
                                        // blocks
 
     bslma::Allocator *d_allocator_p;   // holds (but does not own) allocator
 
+    int               d_autoTrimInterval;
+                                       // number of pooled deallocations
+                                       // between automatic trims, or 0 if
+                                       // automatic trimming is disabled
+
+    int               d_numDeallocationsUntilTrim;
+                                       // number of pooled deallocations
+                                       // remaining before the next automatic
+                                       // trim; unused unless automatic
+                                       // trimming is enabled
+
   private:
     // PRIVATE MANIPULATORS
+    void countDeallocations(int numBlocks);
+        // Count the specified 'numBlocks' deallocations of pooled blocks
+        // towards automatic trimming, and 'trim' this multipool, restarting
+        // the count, if the trim interval has been reached.  The behavior is
+        // undefined unless automatic trimming is enabled and '1 <= numBlocks'.
+
     void initialize(bsls::BlockGrowth::Strategy        growthStrategy,
                     int                                maxBlocksPerChunk);
     void initialize(const bsls::BlockGrowth::Strategy *growthStrategyArray,
@@ -546,13 +665,45 @@ class Multipool {
         // with the corresponding growth strategy or max blocks per chunk entry
         // within the array.
 
+    void initialize(SizeClassSpacing            spacing,
+                    bsls::BlockGrowth::Strategy growthStrategy,
+                    int                         maxBlocksPerChunk);
+        // Initialize the 'd_numPools' pools of this multipool with block sizes
+        // of the specified 'spacing', or, if 'spacing' is 'e_ADAPTIVE', begin
+        // the warm-up phase, with pools to be created using the specified
+        // 'growthStrategy' and 'maxBlocksPerChunk'.
+
+    void initialize(const int                   *blockSizeArray,
+                    int                          numPools,
+                    bsls::BlockGrowth::Strategy  growthStrategy,
+                    int                          maxBlocksPerChunk);
+        // Create the specified 'numPools' pools of this multipool having the
+        // block sizes in the specified 'blockSizeArray', and the specified
+        // 'growthStrategy' and 'maxBlocksPerChunk', and build the table
+        // mapping request sizes to pools.  If an exception is thrown, this
+        // multipool is unchanged.
+
+    void *allocateWarmUp(int size);
+        // Return the address of a block of at least the specified 'size' (in
+        // bytes), recording 'size' in the histogram of this warming-up
+        // multipool.  The block is allocated from 'd_blockList', unless this
+        // is the last allocation of the warm-up phase, in which case the
+        // block sizes are chosen, the pools are created, and the block is
+        // allocated from them.  The behavior is undefined unless this
+        // multipool is warming up.
+
+    void endWarmUp();
+        // Choose the block sizes of the pools of this multipool from the
+        // histogram recorded during the warm-up phase, create the pools, and
+        // end the warm-up phase.
+
     // PRIVATE ACCESSORS
     int findPool(int size) const;
         // Return the index of the memory pool in this multipool for an
         // allocation request of the specified 'size' (in bytes).  The behavior
-        // is undefined unless '0 <= size <= maxPooledBlockSize()'.  Note that
-        // the index of the memory pool managing memory blocks having the
-        // minimum block size is 0.
+        // is undefined unless '0 <= size <= d_maxBlockSize'.  Note that the
+        // index of the memory pool managing memory blocks having the minimum
+        // block size is 0.
 
   private:
     // NOT IMPLEMENTED
@@ -659,6 +810,52 @@ class Multipool {
         // would exceed a maximum value, the chunk size is capped at that
         // value.
 
+    Multipool(int                                numPools,
+              SizeClassSpacing                   spacing,
+              bslma::Allocator                  *basicAllocator = 0);
+    Multipool(int                                numPools,
+              SizeClassSpacing                   spacing,
+              bsls::BlockGrowth::Strategy        growthStrategy,
+              int                                maxBlocksPerChunk,
+              bslma::Allocator                  *basicAllocator = 0);
+        // Create a multipool memory manager having the specified 'numPools'
+        // internally created 'bdlma::Pool' objects, whose block sizes have the
+        // specified 'spacing' (see {Size Classes}).  If 'spacing' is
+        // 'e_ADAPTIVE', the pools (at most 'numPools' of them, covering
+        // requests of up to '2^(numPools+2)' bytes) are created at the end of
+        // a warm-up phase, during which memory is supplied directly by the
+        // underlying allocator.  Optionally specify a 'growthStrategy' and a
+        // 'maxBlocksPerChunk' having the same meaning as for the other
+        // constructors; if they are not specified, geometric growth and an
+        // implementation-defined maximum are used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '1 <= numPools <= 255', the largest block size is
+        // representable as an 'int', and '1 <= maxBlocksPerChunk'.
+
+    Multipool(int                                numPools,
+              const int                         *blockSizeArray,
+              bslma::Allocator                  *basicAllocator = 0);
+    Multipool(int                                numPools,
+              const int                         *blockSizeArray,
+              bsls::BlockGrowth::Strategy        growthStrategy,
+              int                                maxBlocksPerChunk,
+              bslma::Allocator                  *basicAllocator = 0);
+        // Create a multipool memory manager having the specified 'numPools'
+        // internally created 'bdlma::Pool' objects, whose block sizes are the
+        // corresponding elements of the specified 'blockSizeArray'.
+        // Optionally specify a 'growthStrategy' and a 'maxBlocksPerChunk'
+        // having the same meaning as for the other constructors; if they are
+        // not specified, geometric growth and an implementation-defined
+        // maximum are used.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless
+        // '1 <= numPools <= 255', the elements of 'blockSizeArray' are
+        // positive multiples of 8 in strictly increasing order, and
+        // '1 <= maxBlocksPerChunk'.  Note that the table used to find the
+        // pool for a request has one byte for every 8 bytes of the largest
+        // block size.
+
     ~Multipool();
         // Destroy this multipool.  All memory allocated from this memory pool
         // is released.
@@ -673,12 +870,61 @@ class Multipool {
         // this object is destroyed.  The behavior is undefined unless
         // '1 <= size'.
 
+    void *allocateN(int numBlocks, int size);
+        // Return the address of the first of a chain of the specified
+        // 'numBlocks' contiguous blocks of maximally-aligned memory, each of
+        // (at least) the specified 'size' (in bytes), in which the first
+        // 'sizeof(void *)' bytes of each block hold the address of the next
+        // block in the chain, and those of the last block hold 0.  All of the
+        // blocks are obtained from the same pool with a single call to
+        // 'Pool::allocateN' (see 'bdlma_pool'), and each may be returned to
+        // this multipool individually by 'deallocate'.  During a warm-up
+        // phase, the blocks are instead allocated individually.  The behavior
+        // is undefined unless '1 <= numBlocks' and
+        // '1 <= size <= maxPooledBlockSize()'.
+
+    void *allocateAligned(int size, int alignment);
+        // Return the address of a contiguous block of memory of (at least) the
+        // specified 'size' (in bytes) aligned to the specified 'alignment',
+        // which may exceed the maximal alignment of the platform.  The block
+        // is obtained from the pool whose blocks can accommodate 'size' plus
+        // the padding needed to reach the alignment, or from the underlying
+        // allocator if no pool manages blocks of sufficient size.  The block
+        // is returned to this multipool by 'deallocate(address)' (but not by
+        // 'deallocate(address, size)').  The behavior is undefined unless
+        // '1 <= size' and 'alignment' is a positive power of two.
+
     void deallocate(void *address);
         // Relinquish the memory block at the specified 'address' back to this
         // multipool object for reuse.  The behavior is undefined unless
         // 'address' is non-zero, was allocated by this multipool object, and
         // has not already been deallocated.
 
+    void deallocate(void *address, int size);
+        // Relinquish the memory block at the specified 'address', which was
+        // obtained by a call to 'allocate' with the specified 'size', back to
+        // this multipool object for reuse.  The owning pool is computed from
+        // 'size' rather than read from the header of the block; only an
+        // adaptive multipool reads the header, to detect a block allocated
+        // during its warm-up phase.  The behavior is undefined unless
+        // 'address' is non-zero, was allocated by this multipool object by a
+        // call to 'allocate(size)', and has not already been deallocated.
+
+    void deallocateN(void *first, void *last, int size);
+        // Relinquish the chain of memory blocks starting at the specified
+        // 'first' block and ending at the specified 'last' block, each of
+        // which was obtained by a call to 'allocate' or 'allocateN' with the
+        // specified 'size', back to this multipool object for reuse, in which
+        // the first 'sizeof(void *)' bytes of each block other than 'last'
+        // hold the address of the next block in the chain.  The blocks are
+        // returned to their pool with a single call to 'Pool::deallocateN',
+        // and count as individual deallocations towards automatic trimming.
+        // The behavior is undefined unless 'first' and 'last' are non-zero,
+        // 'last' is reachable from 'first',
+        // '1 <= size <= maxPooledBlockSize()', and each block in the chain was
+        // allocated by this multipool object and has not already been
+        // deallocated.
+
     template <class TYPE>
     void deleteObject(const TYPE *object);
         // Destroy the specified 'object' based on its dynamic type and then
@@ -705,21 +951,55 @@ class Multipool {
     void reserveCapacity(int size, int numBlocks);
         // Reserve memory from this multipool to satisfy memory requests for at
         // least the specified 'numBlocks' having the specified 'size' (in
-        // bytes) before the pool replenishes.  The behavior is undefined
-        // unless '1 <= size <= maxPooledBlockSize()' and '0 <= numBlocks'.
+        // bytes) before the pool replenishes.  This method has no effect
+        // during a warm-up phase.  The behavior is undefined unless
+        // '1 <= size <= maxPooledBlockSize()' and '0 <= numBlocks'.
+
+    void setAutoTrimInterval(int numDeallocations);
+        // Configure this multipool to 'trim' itself after every specified
+        // 'numDeallocations' deallocations of pooled blocks, or disable
+        // automatic trimming if 'numDeallocations' is 0.  The count of
+        // deallocations restarts from 0.  The behavior is undefined unless
+        // '0 <= numDeallocations'.
+
+    int trim();
+        // Return to the underlying allocator every chunk of every pool of this
+        // multipool none of whose blocks is currently allocated, and return
+        // the number of chunks so released.  Note that blocks that are not
+        // pooled are returned to the underlying allocator by 'deallocate'.
 
     // ACCESSORS
+    int autoTrimInterval() const;
+        // Return the number of deallocations of pooled blocks between
+        // automatic calls to 'trim', or 0 if automatic trimming is disabled.
+
+    bool isWarmingUp() const;
+        // Return 'true' if this multipool is in the warm-up phase of adaptive
+        // size classes (see {Size Classes}), during which it has no pools,
+        // and 'false' otherwise.
+
     int numPools() const;
-        // Return the number of pools managed by this multipool object.
+        // Return the number of pools managed by this multipool object.  Note
+        // that this number is 0 during a warm-up phase, and that an adaptive
+        // multipool may create fewer pools than were specified at
+        // construction.
 
     int maxPooledBlockSize() const;
         // Return the maximum size of memory blocks that are pooled by this
-        // multipool object.  Note that the maximum value is defined as:
+        // multipool object (or, during a warm-up phase, that will be pooled
+        // at its end).  Note that, for power-of-two and adaptive size classes,
+        // the maximum value is defined as:
         //..
         //  2 ^ (numPools + 2)
         //..
         // where 'numPools' is either specified at construction, or an
         // implementation-defined value.
+
+    int pooledBlockSize(int poolIndex) const;
+        // Return the size of the memory blocks dispensed by the pool at the
+        // specified 'poolIndex'.  The behavior is undefined unless
+        // '0 <= poolIndex < numPools()'.  Note that the block sizes increase
+        // with the index of the pool.
 };
 
 // ============================================================================
@@ -746,6 +1026,18 @@ void Multipool::deleteObjectRaw(const TYPE *object)
 }
 
 // ACCESSORS
+inline
+int Multipool::autoTrimInterval() const
+{
+    return d_autoTrimInterval;
+}
+
+inline
+bool Multipool::isWarmingUp() const
+{
+    return 0 != d_warmUp_p;
+}
+
 inline
 int Multipool::numPools() const
 {
@@ -755,7 +1047,17 @@ int Multipool::numPools() const
 inline
 int Multipool::maxPooledBlockSize() const
 {
-    return d_maxBlockSize;
+    return d_maxPooledBlockSize;
+}
+
+inline
+int Multipool::pooledBlockSize(int poolIndex) const
+{
+    BSLS_ASSERT_SAFE(0         <= poolIndex);
+    BSLS_ASSERT_SAFE(poolIndex <  d_numPools);
+
+    return d_pools_p[poolIndex].blockSize()
+                                           - static_cast<int>(sizeof(Header));
 }
 
 inline
@@ -767,14 +1069,22 @@ void *Multipool::allocate(int size)
         const int pool = findPool(size);
         Header *p = static_cast<Header *>(d_pools_p[pool].allocate());
         p->d_header.d_poolIdx = pool;
+        p->d_header.d_offset  = 0;
         return p + 1;
     }
 
-    // The requested size is large and will not be pooled.
+    // The requested size is large and will not be pooled, or this multipool
+    // is warming up.
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_warmUp_p)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return allocateWarmUp(size);                                  // RETURN
+    }
 
     Header *p = static_cast<Header *>(
                                   d_blockList.allocate(size + sizeof(Header)));
     p->d_header.d_poolIdx = -1;
+    p->d_header.d_offset  = 0;
     return p + 1;
 }
 
@@ -785,13 +1095,60 @@ void Multipool::deallocate(void *address)
 
     Header *h = static_cast<Header *>(address) - 1;
 
-    const int pool = h->d_header.d_poolIdx;
+    const int  pool  = h->d_header.d_poolIdx;
+    char      *block = reinterpret_cast<char *>(h) - h->d_header.d_offset;
 
     if (-1 == pool) {
-        d_blockList.deallocate(h);
+        d_blockList.deallocate(block);
     }
     else {
+        d_pools_p[pool].deallocate(block);
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_autoTrimInterval)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            countDeallocations(1);
+        }
+    }
+}
+
+inline
+void Multipool::deallocate(void *address, int size)
+{
+    BSLS_ASSERT(address);
+    BSLS_ASSERT(1 <= size);
+
+    Header *h = static_cast<Header *>(address) - 1;
+
+    BSLS_ASSERT_SAFE(0 == h->d_header.d_offset);
+
+    if (size <= d_maxBlockSize) {
+        const int pool = findPool(size);
+
+        // Only an adaptive multipool can have allocated a small block outside
+        // of its pools (during its warm-up phase), so the header of the block
+        // is read only by an adaptive multipool.
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                              d_isAdaptive && -1 == h->d_header.d_poolIdx)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            d_blockList.deallocate(h);
+            return;                                                   // RETURN
+        }
+
+        BSLS_ASSERT_SAFE(pool == h->d_header.d_poolIdx);
+
         d_pools_p[pool].deallocate(h);
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_autoTrimInterval)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            countDeallocations(1);
+        }
+    }
+    else {
+        BSLS_ASSERT_SAFE(-1 == h->d_header.d_poolIdx);
+
+        d_blockList.deallocate(h);
     }
 }
 
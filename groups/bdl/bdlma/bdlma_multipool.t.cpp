@@ -9,6 +9,7 @@
 #include <bslma_testallocator.h>
 #include <bslma_testallocatorexception.h>
 
+#include <bsls_alignmentfromtype.h>
 #include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
 #include <bsls_asserttest.h>
@@ -54,18 +55,31 @@ using namespace bsl;
 // [ 7] bdlma::Multipool(numPools, *gs, mbpc, Allocator *ba = 0);
 // [ 7] bdlma::Multipool(numPools, gs, *mbpc, Allocator *ba = 0);
 // [ 7] bdlma::Multipool(numPools, *gs, *mbpc, Allocator *ba = 0);
+// [13] bdlma::Multipool(numPools, spacing, Allocator *ba = 0);
+// [13] bdlma::Multipool(numPools, spacing, gs, mbpc, *ba = 0);
+// [13] bdlma::Multipool(numPools, *bs, Allocator *ba = 0);
+// [13] bdlma::Multipool(numPools, *bs, gs, mbpc, *ba = 0);
 // [ 2] ~bdlma::Multipool();
 // [ 3] void *allocate(int size);
+// [12] void *allocateN(int numBlocks, int size);
+// [10] void *allocateAligned(int size, int alignment);
 // [ 4] void deallocate(void *address);
+// [ 4] void deallocate(void *address, int size);
+// [12] void deallocateN(void *first, void *last, int size);
 // [ 8] template <class TYPE> void deleteObject(const TYPE *object);
 // [ 8] template <class TYPE> void deleteObjectRaw(const TYPE *object);
 // [ 5] void release();
 // [ 6] void reserveCapacity(int size, int numBlocks);
+// [11] void setAutoTrimInterval(int numDeallocations);
+// [11] int trim();
+// [11] int autoTrimInterval() const;
 // [ 9] int numPools() const;
 // [ 9] int maxPooledBlockSize() const;
+// [13] bool isWarmingUp() const;
+// [13] int pooledBlockSize(int poolIndex) const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [10] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 // [ *] CONCERN: Precondition violations are detected when enabled.
 
 //=============================================================================
@@ -130,12 +144,13 @@ typedef bsls::BlockGrowth::Strategy Strategy;
 const int MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
 
 // Warning: keep this in sync with bdlma_multipool.h!
-struct Header {
+union Header {
     // Stores pool number of this item.
-    union {
+    struct {
         int                                 d_pool;   // pool for this item
-        bsls::AlignmentUtil::MaxAlignedType d_dummy;  // force max. alignment
+        int                                 d_offset; // offset from block
     } d_header;
+    bsls::AlignmentUtil::MaxAlignedType     d_dummy;  // force max. alignment
 };
 
 int numLeftChildren  = 0;
@@ -620,7 +635,7 @@ int main(int argc, char *argv[])
     bslma::Allocator     *Z = &testAllocator;
 
     switch (test) { case 0:
-      case 10: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -668,6 +683,789 @@ int main(int argc, char *argv[])
             allocator->deallocate(address);
         }
 
+      } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING SIZE CLASSES
+        //
+        // Concerns:
+        //: 1 Quarter-power-of-two spacing creates pools of 8, 16, 24, 32, 40,
+        //:   48, 56, 64, 80, ... bytes, and 'maxPooledBlockSize' is the size
+        //:   of the last one.
+        //:
+        //: 2 Explicit block sizes are used as supplied.
+        //:
+        //: 3 Each request is served by the pool having the smallest block
+        //:   size not less than the request, whatever the spacing.
+        //:
+        //: 4 An adaptive multipool has no pools while warming up, takes its
+        //:   memory from the underlying allocator during that phase, and then
+        //:   creates at most the specified number of pools, the largest of
+        //:   which has the block size '2^(numPools+2)', and the others of
+        //:   which have the (rounded) sizes most requested during the warm-up.
+        //:
+        //: 5 Blocks allocated during the warm-up phase can be deallocated,
+        //:   individually or as a chain, after it ends.
+        //:
+        //: 6 No memory is leaked.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create a multipool having quarter-power-of-two spacing and
+        //:   verify the block sizes with 'pooledBlockSize'.  (C-1)
+        //:
+        //: 2 Create a multipool having explicit block sizes and verify the
+        //:   block sizes with 'pooledBlockSize'.  (C-2)
+        //:
+        //: 3 For every size up to 'maxPooledBlockSize', allocate and free a
+        //:   block, and verify that it is the next block dispensed for a
+        //:   request of the block size of the expected pool.  (C-3)
+        //:
+        //: 4 Create an adaptive multipool and allocate blocks of 24 and 72
+        //:   bytes until it stops warming up; verify 'numPools', the block
+        //:   sizes, and that the blocks are then pooled.  (C-4)
+        //:
+        //: 5 Deallocate the warm-up blocks by both overloads of 'deallocate'
+        //:   and by 'deallocateN'.  (C-5)
+        //:
+        //: 6 Use a test allocator to verify that no memory is in use once the
+        //:   multipools are destroyed.  (C-6)
+        //:
+        //: 7 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-7)
+        //
+        // Testing:
+        //   bdlma::Multipool(numPools, spacing, Allocator *ba = 0);
+        //   bdlma::Multipool(numPools, spacing, gs, mbpc, *ba = 0);
+        //   bdlma::Multipool(numPools, *bs, Allocator *ba = 0);
+        //   bdlma::Multipool(numPools, *bs, gs, mbpc, *ba = 0);
+        //   bool isWarmingUp() const;
+        //   int pooledBlockSize(int poolIndex) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING SIZE CLASSES" << endl
+                          << "====================" << endl;
+
+        if (verbose) cout << "\nTesting quarter-power-of-two spacing." << endl;
+        {
+            const int EXP[] = { 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112,
+                                128, 160, 192, 224, 256, 320 };
+            const int NUM_EXP = sizeof EXP / sizeof *EXP;
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(NUM_EXP, Obj::e_QUARTER_POWER_OF_TWO, &ta);
+                const Obj& X = mX;
+
+                ASSERT(!X.isWarmingUp());
+                ASSERT(NUM_EXP           == X.numPools());
+                ASSERT(EXP[NUM_EXP - 1]  == X.maxPooledBlockSize());
+                for (int i = 0; i < NUM_EXP; ++i) {
+                    LOOP_ASSERT(i, EXP[i] == X.pooledBlockSize(i));
+                }
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting explicit block sizes." << endl;
+        {
+            const int BLOCK_SIZES[] = { 16, 40, 72, 200 };
+            const int NUM_BLOCK_SIZES = sizeof BLOCK_SIZES
+                                      / sizeof *BLOCK_SIZES;
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(NUM_BLOCK_SIZES,
+                       BLOCK_SIZES,
+                       bsls::BlockGrowth::BSLS_CONSTANT,
+                       4,
+                       &ta);
+                const Obj& X = mX;
+
+                ASSERT(NUM_BLOCK_SIZES == X.numPools());
+                ASSERT(200             == X.maxPooledBlockSize());
+                for (int i = 0; i < NUM_BLOCK_SIZES; ++i) {
+                    LOOP_ASSERT(i, BLOCK_SIZES[i] == X.pooledBlockSize(i));
+                }
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting the pool of each size." << endl;
+        {
+            const int BLOCK_SIZES[] = { 16, 40, 72, 200 };
+
+            // Pools having one block per chunk dispense freed blocks first.
+
+            const bsls::BlockGrowth::Strategy CONSTANT =
+                                              bsls::BlockGrowth::BSLS_CONSTANT;
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj mQ(12, Obj::e_QUARTER_POWER_OF_TWO, CONSTANT, 1, &ta);
+            Obj mE(4, BLOCK_SIZES, CONSTANT, 1, &ta);
+            Obj mP(6, Obj::e_POWER_OF_TWO, CONSTANT, 1, &ta);
+
+            Obj *OBJS[] = { &mQ, &mE, &mP };
+            const int NUM_OBJS = sizeof OBJS / sizeof *OBJS;
+
+            for (int ti = 0; ti < NUM_OBJS; ++ti) {
+                Obj& mX = *OBJS[ti];
+
+                for (int size = 1; size <= mX.maxPooledBlockSize(); ++size) {
+                    int exp = 0;
+                    while (mX.pooledBlockSize(exp) < size) {
+                        ++exp;
+                    }
+
+                    // A freed block is dispensed next by its own pool only.
+
+                    void *p = mX.allocate(size);
+                    bsl::memset(p, 0xab, size);
+                    mX.deallocate(p, size);
+
+                    void *q = mX.allocate(mX.pooledBlockSize(exp));
+                    LOOP2_ASSERT(ti, size, p == q);
+                    mX.deallocate(q);
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting adaptive size classes." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(5,
+                       Obj::e_ADAPTIVE,
+                       bsls::BlockGrowth::BSLS_CONSTANT,
+                       1,
+                       &ta);
+                const Obj& X = mX;
+
+                ASSERT(X.isWarmingUp());
+                ASSERT(0   == X.numPools());
+                ASSERT(128 == X.maxPooledBlockSize());
+
+                const int SIZES[]   = { 24, 70, 1000 };
+                const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+                bsl::vector<void *> blocks;
+                bsl::vector<int>    sizes;
+
+                while (X.isWarmingUp()) {
+                    const int SIZE = SIZES[blocks.size() % NUM_SIZES];
+
+                    const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+
+                    void *p = mX.allocate(SIZE);
+                    bsl::memset(p, 0xab, SIZE);
+                    blocks.push_back(p);
+                    sizes.push_back(SIZE);
+
+                    if (X.isWarmingUp()) {
+                        LOOP_ASSERT(blocks.size(),
+                                    NUM_ALLOCS + 1 == ta.numAllocations());
+                    }
+                }
+
+                ASSERT(3   == X.numPools());
+                ASSERT(24  == X.pooledBlockSize(0));
+                ASSERT(72  == X.pooledBlockSize(1));
+                ASSERT(128 == X.pooledBlockSize(2));
+                ASSERT(128 == X.maxPooledBlockSize());
+
+                // Requests of 17 to 24 bytes are served by the same pool.
+
+                void *p = mX.allocate(17);
+                void *q = mX.allocate(24);
+                mX.deallocate(p);
+                ASSERT(p == mX.allocate(20));
+                mX.deallocate(q, 24);
+
+                // The warm-up blocks are returned individually and in chains.
+
+                void *first = 0;
+                void *last  = 0;
+                for (int i = 0; i < static_cast<int>(blocks.size()); ++i) {
+                    if (24 == sizes[i] && i % 2) {
+                        *static_cast<void **>(blocks[i]) = first;
+                        first = blocks[i];
+                        if (!last) {
+                            last = blocks[i];
+                        }
+                    }
+                    else if (i % 3) {
+                        mX.deallocate(blocks[i]);
+                    }
+                    else {
+                        mX.deallocate(blocks[i], sizes[i]);
+                    }
+                }
+                ASSERT(first);
+                mX.deallocateN(first, last, 24);
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting a warming-up multipool." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(4, Obj::e_ADAPTIVE, &ta);
+
+                mX.reserveCapacity(8, 10);
+
+                void *head = mX.allocateN(5, 40);
+                void *last = head;
+                int   length = 1;
+                while (*static_cast<void **>(last)) {
+                    last = *static_cast<void **>(last);
+                    ++length;
+                }
+                ASSERT(5 == length);
+                mX.deallocateN(head, last, 40);
+
+                void *p = mX.allocateAligned(40, 64);
+                ASSERT(0 == bsls::Types::UintPtr(p) % 64);
+                mX.deallocate(p);
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+
+            // A multipool destroyed during its warm-up leaks nothing.
+
+            {
+                Obj mX(4, Obj::e_ADAPTIVE, &ta);
+                mX.allocate(8);
+                mX.allocate(1000);
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            const int GOOD[]      = { 8, 16 };
+            const int UNALIGNED[] = { 8, 12 };
+            const int UNORDERED[] = { 16, 8 };
+            const int ZERO[]      = { 0, 8 };
+
+            ASSERT_PASS(Obj(2, GOOD));
+            ASSERT_FAIL(Obj(0, GOOD));
+            ASSERT_FAIL(Obj(2, UNALIGNED));
+            ASSERT_FAIL(Obj(2, UNORDERED));
+            ASSERT_FAIL(Obj(2, ZERO));
+            ASSERT_FAIL(Obj(2, static_cast<const int *>(0)));
+
+            ASSERT_PASS(Obj(64,  Obj::e_QUARTER_POWER_OF_TWO));
+            ASSERT_FAIL(Obj(0,   Obj::e_QUARTER_POWER_OF_TWO));
+            ASSERT_FAIL(Obj(256, Obj::e_QUARTER_POWER_OF_TWO));
+            ASSERT_PASS(Obj(28,  Obj::e_ADAPTIVE));
+            ASSERT_FAIL(Obj(29,  Obj::e_ADAPTIVE));
+            ASSERT_FAIL(Obj(2,   Obj::e_ADAPTIVE,
+                            bsls::BlockGrowth::BSLS_GEOMETRIC, 0));
+
+            Obj mX(2, GOOD);
+            ASSERT_SAFE_PASS(mX.pooledBlockSize(1));
+            ASSERT_SAFE_FAIL(mX.pooledBlockSize(2));
+            ASSERT_SAFE_FAIL(mX.pooledBlockSize(-1));
+        }
+
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocateN' AND 'deallocateN'
+        //
+        // Concerns:
+        //: 1 'allocateN' returns a null-terminated chain of exactly the
+        //:   requested number of distinct blocks of the requested size, each
+        //:   suitably aligned to hold a pointer.
+        //:
+        //: 2 The shortfall of free blocks in the pool is obtained from the
+        //:   underlying allocator with a single allocation.
+        //:
+        //: 3 Each block of the chain may be deallocated individually, by
+        //:   either overload of 'deallocate'.
+        //:
+        //: 4 'deallocateN' returns the whole chain to its pool, and counts
+        //:   each block towards automatic trimming.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a set of sizes and chain lengths, call 'allocateN' and walk
+        //:   the chain verifying its length, the alignment and distinctness
+        //:   of its blocks, and the number of allocations made from the test
+        //:   allocator; write to each block.  (C-1..2)
+        //:
+        //: 2 Return the chain with 'deallocateN' and verify that 'allocate'
+        //:   dispenses the same blocks without allocating.  (C-4)
+        //:
+        //: 3 Deallocate the blocks of a chain individually.  (C-3)
+        //:
+        //: 4 Enable automatic trimming with an interval smaller than the
+        //:   length of a chain, and verify that 'deallocateN' triggers a
+        //:   trim.  (C-4)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   void *allocateN(int numBlocks, int size);
+        //   void deallocateN(void *first, void *last, int size);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocateN' AND 'deallocateN'" << endl
+                          << "=====================================" << endl;
+
+        const int NUM_POOLS = 8;
+
+        const int SIZES[]   = { 1, 5, 8, 17, 100, 1024 };
+        const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        enum { MAX_BLOCKS = 40 };
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int SIZE = SIZES[ti];
+
+            for (int tj = 1; tj <= MAX_BLOCKS; tj += 3) {
+                const int NUM_BLOCKS = tj;
+
+                bslma::TestAllocator ta(veryVeryVerbose);
+                Obj mX(NUM_POOLS, &ta);
+
+                const bsls::Types::Int64 NUM_ALLOCS = ta.numAllocations();
+
+                void *head = mX.allocateN(NUM_BLOCKS, SIZE);
+
+                LOOP2_ASSERT(ti, tj, NUM_ALLOCS + 1 == ta.numAllocations());
+
+                char *chain[MAX_BLOCKS];
+                int   length = 0;
+                void *last   = 0;
+                for (void *p = head; p; p = *static_cast<void **>(p)) {
+                    LOOP2_ASSERT(ti, tj, length < NUM_BLOCKS);
+                    if (length == NUM_BLOCKS) {
+                        break;
+                    }
+                    LOOP2_ASSERT(ti, tj,
+                                 0 == bsls::Types::UintPtr(p) % sizeof p);
+                    for (int i = 0; i < length; ++i) {
+                        LOOP3_ASSERT(ti, tj, i, chain[i] != p);
+                    }
+                    chain[length++] = static_cast<char *>(p);
+                    last            = p;
+                }
+                LOOP2_ASSERT(ti, tj, NUM_BLOCKS == length);
+
+                for (int i = 0; i < length; ++i) {
+                    bsl::memset(chain[i], 0xab, SIZE);
+                }
+
+                // Relink the chain, whose links were overwritten, before
+                // returning it.
+
+                for (int i = 0; i < length - 1; ++i) {
+                    *reinterpret_cast<void **>(chain[i]) = chain[i + 1];
+                }
+
+                mX.deallocateN(head, last, SIZE);
+
+                const bsls::Types::Int64 NUM_IN_USE = ta.numBlocksInUse();
+
+                for (int i = 0; i < length; ++i) {
+                    chain[i] = static_cast<char *>(mX.allocate(SIZE));
+                }
+                LOOP2_ASSERT(ti, tj, NUM_IN_USE == ta.numBlocksInUse());
+
+                for (int i = 0; i < length; ++i) {
+                    if (i % 2) {
+                        mX.deallocate(chain[i]);
+                    }
+                    else {
+                        mX.deallocate(chain[i], SIZE);
+                    }
+                }
+
+                ASSERT(1 == mX.trim());
+            }
+        }
+
+        if (verbose) cout << "\nTesting free blocks." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj mX(NUM_POOLS, &ta);
+
+            void *head = mX.allocateN(10, 8);
+
+            const bsls::Types::Int64 NUM_IN_USE = ta.numBlocksInUse();
+
+            for (void *p = head; p; ) {
+                void *next = *static_cast<void **>(p);
+                mX.deallocate(p, 8);
+                p = next;
+            }
+
+            head = mX.allocateN(10, 8);
+            ASSERT(NUM_IN_USE == ta.numBlocksInUse());
+
+            mX.allocateN(1, 8);
+            ASSERT(NUM_IN_USE + 1 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting automatic trimming." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj mX(NUM_POOLS, &ta);
+
+            const bsls::Types::Int64 BASE = ta.numBlocksInUse();
+
+            mX.setAutoTrimInterval(5);
+
+            void *first = mX.allocateN(10, 8);
+            void *last  = first;
+            while (*static_cast<void **>(last)) {
+                last = *static_cast<void **>(last);
+            }
+            ASSERT(BASE + 1 == ta.numBlocksInUse());
+
+            mX.deallocateN(first, last, 8);
+            ASSERT(BASE == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(NUM_POOLS);
+
+            const int MAX = mX.maxPooledBlockSize();
+
+            ASSERT_FAIL(mX.allocateN(0, 8));
+            ASSERT_FAIL(mX.allocateN(1, 0));
+            ASSERT_FAIL(mX.allocateN(1, MAX + 1));
+
+            void *p = 0;
+            ASSERT_PASS(p = mX.allocateN(1, MAX));
+
+            ASSERT_FAIL(mX.deallocateN(0, p, MAX));
+            ASSERT_FAIL(mX.deallocateN(p, 0, MAX));
+            ASSERT_FAIL(mX.deallocateN(p, p, 0));
+            ASSERT_FAIL(mX.deallocateN(p, p, MAX + 1));
+            ASSERT_PASS(mX.deallocateN(p, p, MAX));
+        }
+
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // TESTING 'trim' AND AUTOMATIC TRIMMING
+        //
+        // Concerns:
+        //: 1 'trim' returns to the underlying allocator the chunks of every
+        //:   pool none of whose blocks is allocated, and only those, and
+        //:   returns the number of chunks released.
+        //:
+        //: 2 Automatic trimming is disabled by default.
+        //:
+        //: 3 When enabled, 'trim' is called after every 'N' deallocations of
+        //:   pooled blocks, by either overload of 'deallocate', where 'N' is
+        //:   the configured interval, and deallocations of blocks that are not
+        //:   pooled are not counted.
+        //:
+        //: 4 Setting the interval to 0 disables automatic trimming.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate blocks from several pools and a block that is not
+        //:   pooled, deallocate the pooled blocks, and verify that 'trim'
+        //:   leaves only the array of pools and the large block allocated
+        //:   from the test allocator.  (C-1)
+        //:
+        //: 2 Verify the default value of 'autoTrimInterval', and that no
+        //:   memory is released by deallocation alone.  (C-2)
+        //:
+        //: 3 Set an interval, and verify, using the test allocator, that
+        //:   chunks are released exactly when the configured number of
+        //:   pooled deallocations has occurred.  (C-3)
+        //:
+        //: 4 Reset the interval to 0, and verify that chunks are no longer
+        //:   released by deallocation.  (C-4)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a negative interval.  (C-5)
+        //
+        // Testing:
+        //   int trim();
+        //   void setAutoTrimInterval(int numDeallocations);
+        //   int autoTrimInterval() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'trim' AND AUTOMATIC TRIMMING" << endl
+                          << "=====================================" << endl;
+
+        const int NUM_POOLS = 8;
+
+        if (verbose) cout << "\nTesting 'trim'." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj mX(NUM_POOLS, &ta);  const Obj& X = mX;
+
+            const bsls::Types::Int64 BASE = ta.numBlocksInUse();
+
+            ASSERT(0 == X.autoTrimInterval());
+            ASSERT(0 == mX.trim());
+            ASSERT(BASE == ta.numBlocksInUse());
+
+            const int SIZES[]   = { 1, 8, 60, 200 };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            enum { NUM_BLOCKS = 50 };
+
+            void *blocks[NUM_SIZES][NUM_BLOCKS];
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                for (int j = 0; j < NUM_BLOCKS; ++j) {
+                    blocks[i][j] = mX.allocate(SIZES[i]);
+                }
+            }
+
+            void *large = mX.allocate(X.maxPooledBlockSize() + 1);
+
+            const bsls::Types::Int64 NUM_IN_USE = ta.numBlocksInUse();
+
+            // Keep one block of the last size, then free everything else.
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                for (int j = (NUM_SIZES - 1 == i); j < NUM_BLOCKS; ++j) {
+                    if (i % 2) {
+                        mX.deallocate(blocks[i][j]);
+                    }
+                    else {
+                        mX.deallocate(blocks[i][j], SIZES[i]);
+                    }
+                }
+            }
+
+            ASSERT(NUM_IN_USE == ta.numBlocksInUse());
+
+            const int NUM_TRIMMED = mX.trim();
+
+            if (veryVerbose) { T_ P_(NUM_IN_USE) P(NUM_TRIMMED) }
+
+            ASSERT(BASE + 2 == ta.numBlocksInUse());
+            ASSERT(NUM_IN_USE - NUM_TRIMMED == ta.numBlocksInUse());
+
+            mX.deallocate(blocks[NUM_SIZES - 1][0]);
+
+            ASSERT(1 == mX.trim());
+            ASSERT(BASE + 1 == ta.numBlocksInUse());
+
+            mX.deallocate(large);
+
+            ASSERT(BASE == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting automatic trimming." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj mX(NUM_POOLS, &ta);  const Obj& X = mX;
+
+            const bsls::Types::Int64 BASE = ta.numBlocksInUse();
+
+            // With geometric growth, four blocks of one size occupy three
+            // chunks.
+
+            void *blocks[4];
+            for (int i = 0; i < 4; ++i) {
+                blocks[i] = mX.allocate(8);
+            }
+            ASSERT(BASE + 3 == ta.numBlocksInUse());
+
+            for (int i = 0; i < 4; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERT(BASE + 3 == ta.numBlocksInUse());
+
+            mX.setAutoTrimInterval(4);
+            ASSERT(4 == X.autoTrimInterval());
+
+            for (int i = 0; i < 4; ++i) {
+                blocks[i] = mX.allocate(8);
+            }
+            ASSERT(BASE + 3 == ta.numBlocksInUse());
+
+            // Deallocations of blocks that are not pooled are not counted.
+
+            void *large = mX.allocate(X.maxPooledBlockSize() + 1);
+            mX.deallocate(large);
+
+            mX.deallocate(blocks[0]);
+            mX.deallocate(blocks[1], 8);
+            mX.deallocate(blocks[2]);
+            ASSERT(BASE + 3 == ta.numBlocksInUse());
+
+            mX.deallocate(blocks[3], 8);
+            ASSERT(BASE == ta.numBlocksInUse());
+
+            // The count restarts after each automatic trim.  Note that the
+            // chunk size of the pool has grown, so that fewer chunks are
+            // needed this time.
+
+            for (int i = 0; i < 4; ++i) {
+                blocks[i] = mX.allocate(8);
+            }
+
+            const bsls::Types::Int64 NUM_IN_USE = ta.numBlocksInUse();
+            ASSERT(BASE < NUM_IN_USE);
+
+            for (int i = 0; i < 3; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERT(NUM_IN_USE == ta.numBlocksInUse());
+
+            mX.setAutoTrimInterval(0);
+            ASSERT(0 == X.autoTrimInterval());
+
+            mX.deallocate(blocks[3]);
+            ASSERT(NUM_IN_USE == ta.numBlocksInUse());
+
+            for (int i = 0; i < 100; ++i) {
+                mX.deallocate(mX.allocate(8));
+            }
+            ASSERT(NUM_IN_USE == ta.numBlocksInUse());
+
+            ASSERT(NUM_IN_USE - BASE == mX.trim());
+            ASSERT(BASE == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(Z);
+
+            ASSERT_PASS(mX.setAutoTrimInterval( 0));
+            ASSERT_PASS(mX.setAutoTrimInterval( 1));
+            ASSERT_FAIL(mX.setAutoTrimInterval(-1));
+        }
+
+      } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocateAligned'
+        //
+        // Concerns:
+        //: 1 'allocateAligned' returns memory aligned to the specified
+        //:   alignment, which may exceed the maximal alignment of the
+        //:   platform.
+        //:
+        //: 2 An aligned block is taken from the pool whose blocks accommodate
+        //:   the requested size plus the padding needed to reach the
+        //:   alignment, or from the underlying allocator if no pool does, and
+        //:   alignments not exceeding that of a pointer need no padding.
+        //:
+        //: 3 'deallocate(address)' returns an aligned block to the pool, or
+        //:   to the underlying allocator, from which it was obtained.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each alignment up to 4096 and for a set of sizes, allocate
+        //:   an aligned block, verify its alignment, write to every byte, and
+        //:   verify the pool recorded in its header against the expected
+        //:   pool.  (C-1..2)
+        //:
+        //: 2 Deallocate each pooled block and verify that the next allocation
+        //:   from the same pool returns the same underlying block; deallocate
+        //:   each non-pooled block and verify, using the test allocator, that
+        //:   its memory is released.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void *allocateAligned(int size, int alignment);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'allocateAligned'" << endl
+                                  << "=========================" << endl;
+
+        const int NUM_POOLS = 8;
+        const int PTR_ALIGN = bsls::AlignmentFromType<void *>::VALUE;
+
+        const int SIZES[]   = { 1, 8, 24, 100, 1000, 5000 };
+        const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj mX(NUM_POOLS, &ta);
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                const int SIZE = SIZES[ti];
+
+                for (int align = 1; align <= 4096; align <<= 1) {
+                    const int PADDED = align > PTR_ALIGN
+                                     ? SIZE + align - PTR_ALIGN
+                                     : SIZE;
+                    const int POOL   = calcPool(NUM_POOLS, PADDED);
+
+                    if (veryVerbose) { T_ P_(SIZE) P_(align) P(POOL) }
+
+                    const bsls::Types::Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+                    char *p = static_cast<char *>(
+                                              mX.allocateAligned(SIZE, align));
+
+                    LOOP2_ASSERT(SIZE, align,
+                                 0 == bsls::Types::UintPtr(p) % align);
+                    LOOP2_ASSERT(SIZE, align, POOL == recPool(p));
+
+                    scribble(p, SIZE);
+
+                    if (-1 == POOL) {
+                        LOOP2_ASSERT(SIZE, align,
+                                     NUM_BLOCKS + 1 == ta.numBlocksInUse());
+
+                        mX.deallocate(p);
+
+                        LOOP2_ASSERT(SIZE, align,
+                                     NUM_BLOCKS == ta.numBlocksInUse());
+                    }
+                    else {
+                        mX.deallocate(p);
+
+                        char *q = static_cast<char *>(mX.allocate(PADDED));
+
+                        LOOP2_ASSERT(SIZE, align, POOL == recPool(q));
+                        LOOP2_ASSERT(SIZE, align, q <= p);
+                        LOOP2_ASSERT(SIZE, align, p + SIZE <= q + PADDED);
+
+                        mX.deallocate(q);
+                    }
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(Z);
+
+            ASSERT_PASS(mX.allocateAligned(1, 64));
+            ASSERT_FAIL(mX.allocateAligned(0, 64));
+            ASSERT_FAIL(mX.allocateAligned(1, 0));
+            ASSERT_FAIL(mX.allocateAligned(1, 48));
+        }
+
       } break;
       case 9: {
         // --------------------------------------------------------------------
@@ -2104,8 +2902,14 @@ int main(int argc, char *argv[])
         //   appropriate assertions that no demands are put on the memory
         //   allocation beyond those attributable to start-up.
         //
+        //   For a range of sizes, both pooled and not, return a block using
+        //   the sized 'deallocate' and verify that the block is available for
+        //   the next allocation of the same size (pooled blocks are reused
+        //   LIFO), and that no memory is outstanding from the block list.
+        //
         // Testing:
         //   void deallocate(void *address);
+        //   void deallocate(void *address, int size);
         // --------------------------------------------------------------------
 
         if (verbose) cout << endl << "TESTING DEALLOCATE"
@@ -2168,6 +2972,37 @@ int main(int argc, char *argv[])
             }
         }
 
+        if (verbose) cout << "\nTesting sized 'deallocate'." << endl;
+        {
+            const int NUM_POOLS = 4;
+
+            Obj mX(NUM_POOLS, Z);  const Obj& X = mX;
+
+            const int MAX_SIZE = X.maxPooledBlockSize();
+
+            for (int size = 1; size <= 2 * MAX_SIZE; ++size) {
+                char *p = (char *) mX.allocate(size);
+                LOOP_ASSERT(size, p);
+                scribble(p, size);
+
+                const bsls::Types::Int64 numBlocks =
+                                                testAllocator.numBlocksInUse();
+
+                mX.deallocate(p, size);
+
+                if (size <= MAX_SIZE) {
+                    LOOP_ASSERT(size, numBlocks ==
+                                               testAllocator.numBlocksInUse());
+                    LOOP_ASSERT(size, p == mX.allocate(size));
+                    mX.deallocate(p);
+                }
+                else {
+                    LOOP_ASSERT(size, numBlocks - 1 ==
+                                               testAllocator.numBlocksInUse());
+                }
+            }
+        }
+
         if (verbose) cout << "\nNegative Testing." << endl;
         {
             bsls::AssertFailureHandlerGuard hG(
@@ -2182,6 +3017,17 @@ int main(int argc, char *argv[])
 
                 ASSERT_SAFE_FAIL(mX.deallocate(0));
             }
+
+            if (veryVerbose) cout << "\t'deallocate(p, size)'" << endl;
+            {
+                p = (char *)mX.allocate(8);
+
+                ASSERT_SAFE_FAIL(mX.deallocate(0, 8));
+                ASSERT_SAFE_FAIL(mX.deallocate(p, 0));
+                ASSERT_SAFE_FAIL(mX.deallocate(p, 16));
+
+                ASSERT_SAFE_PASS(mX.deallocate(p, 8));
+            }
         }
       } break;
       case 3: {
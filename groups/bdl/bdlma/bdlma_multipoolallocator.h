@@ -35,6 +35,9 @@ BSLS_IDENT("$Id: $")
 //                |         maxPooledBlockSize
 //                |         numPools
 //                |         reserveCapacity
+//                |         setAutoTrimInterval
+//                |         trim
+//                |         autoTrimInterval
 //                V
 //    ,-----------------------.
 //   ( bdlma::ManagedAllocator )
@@ -750,6 +753,48 @@ class MultipoolAllocator : public ManagedAllocator {
         // would exceed a maximum value, the chunk size is capped at that
         // value.
 
+    MultipoolAllocator(
+                     int                                numPools,
+                     Multipool::SizeClassSpacing        spacing,
+                     bslma::Allocator                  *basicAllocator = 0);
+    MultipoolAllocator(
+                     int                                numPools,
+                     Multipool::SizeClassSpacing        spacing,
+                     bsls::BlockGrowth::Strategy        growthStrategy,
+                     int                                maxBlocksPerChunk,
+                     bslma::Allocator                  *basicAllocator = 0);
+        // Create a multipool allocator having the specified 'numPools'
+        // internally created 'bdlma::Pool' objects, whose block sizes have the
+        // specified 'spacing' (see {'bdlma_multipool'|Size Classes}).
+        // Optionally specify a 'growthStrategy' and a 'maxBlocksPerChunk'
+        // having the same meaning as for the other constructors.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '1 <= numPools <= 255', the
+        // largest block size is representable as an 'int', and
+        // '1 <= maxBlocksPerChunk'.
+
+    MultipoolAllocator(
+                     int                                numPools,
+                     const int                         *blockSizeArray,
+                     bslma::Allocator                  *basicAllocator = 0);
+    MultipoolAllocator(
+                     int                                numPools,
+                     const int                         *blockSizeArray,
+                     bsls::BlockGrowth::Strategy        growthStrategy,
+                     int                                maxBlocksPerChunk,
+                     bslma::Allocator                  *basicAllocator = 0);
+        // Create a multipool allocator having the specified 'numPools'
+        // internally created 'bdlma::Pool' objects, whose block sizes are the
+        // corresponding elements of the specified 'blockSizeArray'.
+        // Optionally specify a 'growthStrategy' and a 'maxBlocksPerChunk'
+        // having the same meaning as for the other constructors.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '1 <= numPools <= 255', the
+        // elements of 'blockSizeArray' are positive multiples of 8 in strictly
+        // increasing order, and '1 <= maxBlocksPerChunk'.
+
     virtual ~MultipoolAllocator();
         // Destroy this multipool allocator.  All memory allocated from this
         // allocator is released.
@@ -762,6 +807,17 @@ class MultipoolAllocator : public ManagedAllocator {
         // is 0, this method has no effect.  The behavior is undefined unless
         // 'size <= maxPooledBlockSize()'.
 
+    void setAutoTrimInterval(int numDeallocations);
+        // Configure this multipool allocator to 'trim' itself after every
+        // specified 'numDeallocations' deallocations of pooled blocks, or
+        // disable automatic trimming if 'numDeallocations' is 0.  The behavior
+        // is undefined unless '0 <= numDeallocations'.
+
+    int trim();
+        // Return to the underlying allocator every chunk of every pool of this
+        // multipool allocator none of whose blocks is currently allocated,
+        // and return the number of chunks so released.
+
                                 // Virtual Functions
 
     virtual void *allocate(size_type size);
@@ -771,17 +827,40 @@ class MultipoolAllocator : public ManagedAllocator {
         // 'size > maxPooledBlockSize()', the memory allocation is managed
         // directly by the underlying allocator, but will not be pooled .
 
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return the address of a contiguous block of memory of (at least)
+        // the specified 'size' (in bytes) aligned to the specified
+        // 'alignment', which may exceed the maximal alignment of the
+        // platform.  If 'size' is 0, no memory is allocated and 0 is
+        // returned.  The block is returned to this allocator with
+        // 'deallocateAligned' or 'deallocate' (but not 'deallocateSized').
+        // The behavior is undefined unless 'alignment' is a positive power of
+        // two.
+
     virtual void deallocate(void *address);
         // Return the memory block at the specified 'address' back to this
         // allocator for reuse.  If 'address' is 0, this method has no effect.
         // The behavior is undefined unless 'address' was allocated by this
         // allocator, and has not already been deallocated.
 
+    virtual void deallocateSized(void *address, size_type size);
+        // Return the memory block at the specified 'address', which was
+        // obtained by a call to 'allocate' with the specified 'size', back to
+        // this allocator for reuse.  If 'address' is 0, this method has no
+        // effect.  The pool owning the block is computed from 'size' rather
+        // than read from the header of the block.  The behavior is undefined
+        // unless 'address' was allocated by this allocator by a call to
+        // 'allocate(size)', and has not already been deallocated.
+
     virtual void release();
         // Release all memory currently allocated through this multipool
         // allocator.
 
     // ACCESSORS
+    int autoTrimInterval() const;
+        // Return the number of deallocations of pooled blocks between
+        // automatic calls to 'trim', or 0 if automatic trimming is disabled.
+
     int numPools() const;
         // Return the number of pools managed by this multipool allocator.
 
@@ -888,6 +967,54 @@ MultipoolAllocator::MultipoolAllocator(
 {
 }
 
+inline
+MultipoolAllocator::MultipoolAllocator(
+                     int                                numPools,
+                     Multipool::SizeClassSpacing        spacing,
+                     bslma::Allocator                  *basicAllocator)
+: d_multipool(numPools, spacing, basicAllocator)
+{
+}
+
+inline
+MultipoolAllocator::MultipoolAllocator(
+                     int                                numPools,
+                     Multipool::SizeClassSpacing        spacing,
+                     bsls::BlockGrowth::Strategy        growthStrategy,
+                     int                                maxBlocksPerChunk,
+                     bslma::Allocator                  *basicAllocator)
+: d_multipool(numPools,
+              spacing,
+              growthStrategy,
+              maxBlocksPerChunk,
+              basicAllocator)
+{
+}
+
+inline
+MultipoolAllocator::MultipoolAllocator(
+                     int                                numPools,
+                     const int                         *blockSizeArray,
+                     bslma::Allocator                  *basicAllocator)
+: d_multipool(numPools, blockSizeArray, basicAllocator)
+{
+}
+
+inline
+MultipoolAllocator::MultipoolAllocator(
+                     int                                numPools,
+                     const int                         *blockSizeArray,
+                     bsls::BlockGrowth::Strategy        growthStrategy,
+                     int                                maxBlocksPerChunk,
+                     bslma::Allocator                  *basicAllocator)
+: d_multipool(numPools,
+              blockSizeArray,
+              growthStrategy,
+              maxBlocksPerChunk,
+              basicAllocator)
+{
+}
+
 // MANIPULATORS
 inline
 void MultipoolAllocator::release()
@@ -895,7 +1022,25 @@ void MultipoolAllocator::release()
     d_multipool.release();
 }
 
+inline
+void MultipoolAllocator::setAutoTrimInterval(int numDeallocations)
+{
+    d_multipool.setAutoTrimInterval(numDeallocations);
+}
+
+inline
+int MultipoolAllocator::trim()
+{
+    return d_multipool.trim();
+}
+
 // ACCESSORS
+inline
+int MultipoolAllocator::autoTrimInterval() const
+{
+    return d_multipool.autoTrimInterval();
+}
+
 inline
 int MultipoolAllocator::numPools() const
 {
@@ -919,6 +1064,19 @@ void *MultipoolAllocator::allocate(size_type size)
     return d_multipool.allocate(size);
 }
 
+inline
+void *MultipoolAllocator::allocateAligned(size_type size,
+                                          size_type alignment)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    return d_multipool.allocateAligned(static_cast<int>(size),
+                                       static_cast<int>(alignment));
+}
+
 inline
 void MultipoolAllocator::deallocate(void *address)
 {
@@ -928,6 +1086,15 @@ void MultipoolAllocator::deallocate(void *address)
     BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
 }
 
+inline
+void MultipoolAllocator::deallocateSized(void *address, size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(address != 0)) {
+        d_multipool.deallocate(address, static_cast<int>(size));
+    }
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
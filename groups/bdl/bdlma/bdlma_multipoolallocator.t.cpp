@@ -16,6 +16,7 @@
 #include <bsls_assert.h>
 #include <bsls_asserttest.h>
 #include <bsls_stopwatch.h>
+#include <bsls_types.h>
 
 #include <bsl_algorithm.h>
 #include <bsl_cstdio.h>
@@ -56,13 +57,18 @@ using namespace bsl;
 // [ 2] ~MultipoolAllocator();
 // [ 6] void reserveCapacity(size_type size, size_type numObjects);
 // [ 2] void *allocate(size);
+// [ 2] void *allocateAligned(size, alignment);
 // [ 4] void deallocate(address);
+// [ 4] void deallocateSized(address, size);
 // [ 5] void release();
+// [ 8] void setAutoTrimInterval(int numDeallocations);
+// [ 8] int trim();
+// [ 8] int autoTrimInterval() const;
 // [ 7] int numPools() const;
 // [ 7] int maxPooledBlockSize() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 8] USAGE EXAMPLE
+// [ 9] USAGE EXAMPLE
 // [ *] CONCERN: Precondition violations are detected when enabled.
 
 //=============================================================================
@@ -715,7 +721,7 @@ int main(int argc, char *argv[])
     bslma::Allocator     *Z = &testAllocator;
 
     switch (test) { case 0:
-      case 8: {
+      case 9: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -758,6 +764,56 @@ int main(int argc, char *argv[])
 //  }
 //..
 
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // TESTING 'trim' AND 'setAutoTrimInterval'
+        //
+        // Concerns:
+        //   1) That 'trim', 'setAutoTrimInterval', and 'autoTrimInterval'
+        //      forward to the underlying multipool.
+        //
+        // Plan:
+        //   Allocate and deallocate pooled blocks, and verify, using the test
+        //   allocator, that their chunks are released by 'trim', and by
+        //   deallocation once an automatic trim interval is set.
+        //
+        // Testing:
+        //   void setAutoTrimInterval(int numDeallocations);
+        //   int trim();
+        //   int autoTrimInterval() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'trim' AND 'setAutoTrimInterval'" << endl
+                          << "========================================"
+                          << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        Obj mX(&ta);  const Obj& X = mX;
+
+        const bsls::Types::Int64 BASE = ta.numBlocksInUse();
+
+        ASSERT(0 == X.autoTrimInterval());
+
+        void *p = mX.allocate(10);
+        ASSERT(BASE + 1 == ta.numBlocksInUse());
+
+        mX.deallocate(p);
+        ASSERT(BASE + 1 == ta.numBlocksInUse());
+
+        ASSERT(1 == mX.trim());
+        ASSERT(BASE == ta.numBlocksInUse());
+
+        mX.setAutoTrimInterval(1);
+        ASSERT(1 == X.autoTrimInterval());
+
+        p = mX.allocate(10);
+        ASSERT(BASE + 1 == ta.numBlocksInUse());
+
+        mX.deallocateSized(p, 10);
+        ASSERT(BASE == ta.numBlocksInUse());
+
       } break;
       case 7: {
         // --------------------------------------------------------------------
@@ -981,8 +1037,15 @@ int main(int argc, char *argv[])
         //   Verify with appropriate assertions that no demands are put on the
         //   memory allocation beyond those attributable to start-up.
         //
+        //   Using a 'bslma::Allocator' reference, return blocks of a range of
+        //   sizes, pooled and not, with 'deallocateSized', and verify that
+        //   pooled blocks are reused by the next allocation of the same size
+        //   and that other blocks are returned to the underlying allocator.
+        //   Verify that 'deallocateSized(0, 0)' has no effect.
+        //
         // Testing:
         //   void deallocate(void *address);
+        //   void deallocateSized(void *address, size_type size);
         // --------------------------------------------------------------------
 
         if (verbose) cout << endl << "TESTING DEALLOCATE"
@@ -1042,6 +1105,38 @@ int main(int argc, char *argv[])
                 mX.deallocate(p);
             }
         }
+
+        if (verbose) cout << "\nTesting 'deallocateSized'." << endl;
+        {
+            Obj mX(4, Z);  const Obj& X = mX;
+
+            bslma::Allocator& allocator = mX;
+
+            const int MAX_SIZE = X.maxPooledBlockSize();
+
+            allocator.deallocateSized(0, 0);
+
+            for (int size = 1; size <= 2 * MAX_SIZE; ++size) {
+                void *p = allocator.allocate(size);
+                LOOP_ASSERT(size, p);
+
+                const bsls::Types::Int64 numBlocks =
+                                                testAllocator.numBlocksInUse();
+
+                allocator.deallocateSized(p, size);
+
+                if (size <= MAX_SIZE) {
+                    LOOP_ASSERT(size, numBlocks ==
+                                               testAllocator.numBlocksInUse());
+                    LOOP_ASSERT(size, p == allocator.allocate(size));
+                    allocator.deallocate(p);
+                }
+                else {
+                    LOOP_ASSERT(size, numBlocks - 1 ==
+                                               testAllocator.numBlocksInUse());
+                }
+            }
+        }
       } break;
       case 3: {
         // --------------------------------------------------------------------
@@ -2001,6 +2096,7 @@ int main(int argc, char *argv[])
         //   MultipoolAllocator(numPools, Allocator *ba = 0);
         //   ~MultipoolAllocator();
         //   void *allocate(size);
+        //   void *allocateAligned(size, alignment);
         // --------------------------------------------------------------------
 
         if (verbose) cout << endl << "TESTING NUMPOOLS CTOR AND DTOR"
@@ -2146,6 +2242,24 @@ int main(int argc, char *argv[])
             // No destructor is called; will produce memory leak in purify
             // if internal allocators are not hooked up properly.
         }
+
+        if (verbose) cout << "\tTesting 'allocateAligned'." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj                  mX(5, &ta);
+            bslma::Allocator&    a = mX;
+
+            ASSERT(0 == a.allocateAligned(0, 64));
+
+            for (int align = 1; align <= 4096; align <<= 1) {
+                char *p = static_cast<char *>(a.allocateAligned(100, align));
+
+                LOOP_ASSERT(align, 0 == bsls::Types::UintPtr(p) % align);
+
+                bsl::memset(p, 0xff, 100);
+                a.deallocate(p);
+            }
+        }
       } break;
       case 1: {
         // --------------------------------------------------------------------
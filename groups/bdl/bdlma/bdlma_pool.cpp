@@ -46,6 +46,94 @@ int roundUp(int x, int y)
     return (x + y - 1) / y * y;
 }
 
+struct NextLink {
+    // This 'struct' provides access to the link to the next node of a free
+    // list for 'sortByAddress'.
+
+    template <class LINK>
+    LINK *& operator()(LINK *link) const
+        // Return a reference to the link to the node following the specified
+        // 'link'.
+    {
+        return link->d_next_p;
+    }
+};
+
+struct NextChunk {
+    // This 'struct' provides access to the link to the next node of a chunk
+    // list for 'sortByAddress'.
+
+    template <class CHUNK>
+    CHUNK *& operator()(CHUNK *chunk) const
+        // Return a reference to the link to the node following the specified
+        // 'chunk'.
+    {
+        return chunk->d_header.d_next_p;
+    }
+};
+
+template <class NODE, class NEXT>
+NODE *sortByAddress(NODE *list, NEXT next)
+    // Sort the singly-linked list of nodes starting at the specified 'list',
+    // whose links are accessed by the specified 'next' functor, by increasing
+    // address, and return the first node of the sorted list.  The sort is an
+    // in-place, bottom-up merge sort, and so takes 'O(N * log(N))' time and no
+    // additional memory.
+{
+    if (0 == list) {
+        return 0;                                                     // RETURN
+    }
+
+    for (int width = 1; ; width *= 2) {
+        NODE  *p         = list;
+        NODE **tail      = &list;
+        int    numMerges = 0;
+
+        while (p) {
+            ++numMerges;
+
+            // Merge the run of up to 'width' nodes starting at 'p' with the
+            // run of up to 'width' nodes that follows it.
+
+            NODE *q     = p;
+            int   pSize = 0;
+            while (pSize < width && q) {
+                ++pSize;
+                q = next(q);
+            }
+            int qSize = width;
+
+            while (0 < pSize || (0 < qSize && q)) {
+                NODE *node;
+                if (0 == pSize) {
+                    node = q;
+                    q    = next(q);
+                    --qSize;
+                }
+                else if (0 == qSize || 0 == q || p < q) {
+                    node = p;
+                    p    = next(p);
+                    --pSize;
+                }
+                else {
+                    node = q;
+                    q    = next(q);
+                    --qSize;
+                }
+                *tail = node;
+                tail  = &next(node);
+            }
+
+            p = q;
+        }
+        *tail = 0;
+
+        if (numMerges <= 1) {
+            return list;                                              // RETURN
+        }
+    }
+}
+
 }  // close unnamed namespace
 
                         // ----------
@@ -53,10 +141,23 @@ int roundUp(int x, int y)
                         // ----------
 
 // PRIVATE MANIPULATORS
+char *Pool::allocateChunk(int numBlocks)
+{
+    BSLS_ASSERT(1 <= numBlocks);
+
+    Chunk *chunk = static_cast<Chunk *>(d_blockList.allocate(
+                             sizeof(Chunk) + numBlocks * d_internalBlockSize));
+
+    chunk->d_header.d_next_p    = d_chunkList_p;
+    chunk->d_header.d_numBlocks = numBlocks;
+    d_chunkList_p               = chunk;
+
+    return reinterpret_cast<char *>(chunk + 1);
+}
+
 void Pool::replenish()
 {
-    d_begin_p = static_cast<char *>(d_blockList.allocate(d_chunkSize
-                                                       * d_internalBlockSize));
+    d_begin_p = allocateChunk(d_chunkSize);
     d_end_p = d_begin_p + d_chunkSize * d_internalBlockSize;
 
     if (   bsls::BlockGrowth::BSLS_GEOMETRIC == d_growthStrategy
@@ -80,6 +181,7 @@ Pool::Pool(int blockSize, bslma::Allocator *basicAllocator)
 , d_maxBlocksPerChunk(k_MAX_CHUNK_SIZE)
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_freeList_p(0)
+, d_chunkList_p(0)
 , d_blockList(basicAllocator)
 , d_begin_p(0)
 , d_end_p(0)
@@ -101,6 +203,7 @@ Pool::Pool(int                          blockSize,
 , d_maxBlocksPerChunk(k_MAX_CHUNK_SIZE)
 , d_growthStrategy(growthStrategy)
 , d_freeList_p(0)
+, d_chunkList_p(0)
 , d_blockList(basicAllocator)
 , d_begin_p(0)
 , d_end_p(0)
@@ -123,6 +226,7 @@ Pool::Pool(int                          blockSize,
 , d_maxBlocksPerChunk(maxBlocksPerChunk)
 , d_growthStrategy(growthStrategy)
 , d_freeList_p(0)
+, d_chunkList_p(0)
 , d_blockList(basicAllocator)
 , d_begin_p(0)
 , d_end_p(0)
@@ -142,6 +246,38 @@ Pool::~Pool()
 }
 
 // MANIPULATORS
+void *Pool::allocateN(int numBlocks)
+{
+    BSLS_ASSERT(1 <= numBlocks);
+
+    reserveCapacity(numBlocks);
+
+    // Detach the chain from the front of the free list, then complete it with
+    // blocks carved from the current chunk.
+
+    Link  *head = d_freeList_p;
+    Link **next = &head;
+
+    while (numBlocks > 0 && *next) {
+        next = &(*next)->d_next_p;
+        --numBlocks;
+    }
+    d_freeList_p = *next;
+
+    while (numBlocks > 0) {
+        BSLS_ASSERT_SAFE(d_begin_p < d_end_p);
+
+        Link *p    = reinterpret_cast<Link *>(d_begin_p);
+        d_begin_p += d_internalBlockSize;
+        *next      = p;
+        next       = &p->d_next_p;
+        --numBlocks;
+    }
+    *next = 0;
+
+    return head;
+}
+
 void Pool::reserveCapacity(int numBlocks)
 {
     BSLS_ASSERT(0 <= numBlocks);
@@ -153,8 +289,7 @@ void Pool::reserveCapacity(int numBlocks)
     }
 
     if (numBlocks > 0 && d_end_p == d_begin_p) {
-        d_begin_p = static_cast<char *>(d_blockList.allocate(numBlocks
-                                                       * d_internalBlockSize));
+        d_begin_p = allocateChunk(numBlocks);
         d_end_p = d_begin_p + numBlocks * d_internalBlockSize;
         return;                                                       // RETURN
     }
@@ -165,8 +300,7 @@ void Pool::reserveCapacity(int numBlocks)
 
         // Allocate memory and add its blocks to the free list.
 
-        char *begin = static_cast<char *>(
-                        d_blockList.allocate(numBlocks * d_internalBlockSize));
+        char *begin = allocateChunk(numBlocks);
         char *end   = begin + (numBlocks - 1) * d_internalBlockSize;
 
         for (char *p = begin; p < end; p += d_internalBlockSize) {
@@ -179,6 +313,67 @@ void Pool::reserveCapacity(int numBlocks)
     }
 }
 
+int Pool::trim()
+{
+    // Sort both the free list and the chunk list by address, so that the free
+    // blocks of each chunk form a contiguous run of the free list, and the
+    // runs appear in the same order as the chunks.
+
+    d_freeList_p  = sortByAddress(d_freeList_p,  NextLink());
+    d_chunkList_p = sortByAddress(d_chunkList_p, NextChunk());
+
+    int     numReleased = 0;
+    Link  **freeLink    = &d_freeList_p;
+    Chunk **chunkLink   = &d_chunkList_p;
+
+    while (*chunkLink) {
+        Chunk     *chunk     = *chunkLink;
+        const int  numBlocks = chunk->d_header.d_numBlocks;
+        char      *begin     = reinterpret_cast<char *>(chunk + 1);
+        char      *end       = begin + numBlocks * d_internalBlockSize;
+
+        // Every free block remaining on the list lies at or above 'begin';
+        // count those below 'end', then add the blocks not yet dispensed if
+        // they belong to this chunk.
+
+        Link **firstFreeLink = freeLink;
+        int    numFree       = 0;
+
+        while (*freeLink && reinterpret_cast<char *>(*freeLink) < end) {
+            ++numFree;
+            freeLink = &(*freeLink)->d_next_p;
+        }
+
+        const bool isCurrent = d_begin_p != d_end_p
+                            && begin <= d_begin_p
+                            && d_begin_p < end;
+
+        if (isCurrent) {
+            numFree += static_cast<int>(d_end_p - d_begin_p)
+                                                         / d_internalBlockSize;
+        }
+
+        if (numFree == numBlocks) {
+            *firstFreeLink = *freeLink;
+            freeLink       = firstFreeLink;
+
+            if (isCurrent) {
+                d_begin_p = 0;
+                d_end_p   = 0;
+            }
+
+            *chunkLink = chunk->d_header.d_next_p;
+            d_blockList.deallocate(chunk);
+            ++numReleased;
+        }
+        else {
+            chunkLink = &chunk->d_header.d_next_p;
+        }
+    }
+
+    return numReleased;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
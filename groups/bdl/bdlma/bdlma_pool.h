@@ -38,6 +38,38 @@ BSLS_IDENT("$Id: $")
 // strategy and maximum blocks per chunk, either of which can be optionally
 // specified at construction (see the "Configuration at Construction" section).
 //
+///Trimming
+///--------
+// A pool does not return a chunk to the basic allocator when the blocks
+// carved from it are deallocated, so the memory held by a pool normally
+// reflects its peak usage until 'release' is called or the pool is destroyed.
+// The 'trim' method returns to the basic allocator every chunk none of whose
+// blocks is currently allocated.  'trim' takes time proportional to
+// 'N * log(N)', where 'N' is the number of free blocks plus the number of
+// chunks, and uses no additional memory; 'allocate' and 'deallocate' are
+// unaffected by it.  Note that 'trim' leaves the free blocks that remain in
+// address order, so that subsequent allocations are dispensed from the
+// lowest addresses first.
+//
+///Batch Allocation
+///----------------
+// Clients that need many blocks at once (e.g., a node-based container being
+// loaded from a range) can obtain them with a single call to 'allocateN',
+// which returns a "chain" of blocks: the first 'sizeof(void *)' bytes of each
+// block in the chain hold the address of the next block, and those of the
+// last block hold 0.  Any shortfall of free blocks is made up by a single new
+// chunk, regardless of the growth strategy.  Conversely, 'deallocateN' returns
+// a chain of blocks, identified by its first and last block, to the pool in
+// constant time:
+//..
+//  void *head = pool.allocateN(3);
+//  void *b    = *static_cast<void **>(head);
+//  void *c    = *static_cast<void **>(b);
+//  assert(0 == *static_cast<void **>(c));
+//
+//  pool.deallocateN(head, c);
+//..
+//
 ///Configuration at Construction
 ///-----------------------------
 // When creating a 'bdlma::Pool', clients must specify the specific block size
@@ -263,8 +295,8 @@ BSLS_IDENT("$Id: $")
 #include <bdlscm_version.h>
 #endif
 
-#ifndef INCLUDED_BDLMA_INFREQUENTDELETEBLOCKLIST
-#include <bdlma_infrequentdeleteblocklist.h>
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
 #endif
 
 #ifndef INCLUDED_BSLMA_ALLOCATOR
@@ -316,6 +348,22 @@ class Pool {
         Link *d_next_p;  // pointer to next link
     };
 
+    union Chunk {
+        // This 'union' precedes the blocks of each chunk, implementing a
+        // singly-linked list of the chunks of this pool, and recording the
+        // number of blocks in the chunk so that 'trim' can determine whether
+        // all of them are free.
+
+        struct {
+            Chunk *d_next_p;     // next chunk, or 0
+
+            int    d_numBlocks;  // number of blocks in this chunk
+        } d_header;
+
+        bsls::AlignmentUtil::MaxAlignedType
+                   d_dummy;      // force maximum alignment of the blocks
+    };
+
     // DATA
     int   d_blockSize;          // size (in bytes) of each allocated memory
                                 // block returned to client
@@ -332,7 +380,9 @@ class Pool {
 
     Link *d_freeList_p;         // linked list of free memory blocks
 
-    InfrequentDeleteBlockList
+    Chunk *d_chunkList_p;       // linked list of chunks
+
+    BlockList
           d_blockList;          // memory manager for allocated memory
 
     char *d_begin_p;            // start of a contiguous group of memory blocks
@@ -341,6 +391,11 @@ class Pool {
 
   private:
     // PRIVATE MANIPULATORS
+    char *allocateChunk(int numBlocks);
+        // Allocate a chunk of the specified 'numBlocks' blocks, add it to the
+        // list of chunks of this pool, and return the address of its first
+        // block.  The behavior is undefined unless '1 <= numBlocks'.
+
     void replenish();
         // Dynamically allocate a new chunk using this pool's underlying growth
         // strategy.
@@ -388,12 +443,32 @@ class Pool {
         // Return the address of a contiguous block of maximally-aligned memory
         // having the fixed block size specified at construction.
 
+    void *allocateN(int numBlocks);
+        // Return the address of the first of a chain of the specified
+        // 'numBlocks' blocks of maximally-aligned memory, each having the
+        // fixed block size specified at construction, in which the first
+        // 'sizeof(void *)' bytes of each block hold the address of the next
+        // block in the chain, and those of the last block hold 0.  If fewer
+        // than 'numBlocks' blocks are available without replenishing, the
+        // shortfall is obtained from the basic allocator as a single chunk.
+        // The behavior is undefined unless '1 <= numBlocks'.
+
     void deallocate(void *address);
         // Relinquish the memory block at the specified 'address' back to this
         // pool object for reuse.  The behavior is undefined unless 'address'
         // is non-zero, was allocated by this pool, and has not already been
         // deallocated.
 
+    void deallocateN(void *first, void *last);
+        // Relinquish the chain of memory blocks starting at the specified
+        // 'first' block and ending at the specified 'last' block back to this
+        // pool object for reuse, in which the first 'sizeof(void *)' bytes of
+        // each block other than 'last' hold the address of the next block in
+        // the chain.  The behavior is undefined unless 'first' and 'last' are
+        // non-zero, 'last' is reachable from 'first', and each block in the
+        // chain was allocated by this pool and has not already been
+        // deallocated.  Note that this operation takes constant time.
+
     template <class TYPE>
     void deleteObject(const TYPE *object);
         // Destroy the specified 'object' based on its dynamic type and then
@@ -421,6 +496,12 @@ class Pool {
         // least the specified 'numBlocks' before the pool replenishes.  The
         // behavior is undefined unless '0 <= numBlocks'.
 
+    int trim();
+        // Return to the basic allocator every chunk of this pool none of whose
+        // blocks is currently allocated, and return the number of chunks so
+        // released.  Note that the order in which free blocks are dispensed
+        // by subsequent calls to 'allocate' is changed to address order.
+
     // ACCESSORS
     int blockSize() const;
         // Return the size (in bytes) of the memory blocks allocated from this
@@ -533,6 +614,16 @@ void Pool::deallocate(void *address)
     d_freeList_p = static_cast<Link *>(address);
 }
 
+inline
+void Pool::deallocateN(void *first, void *last)
+{
+    BSLS_ASSERT_SAFE(first);
+    BSLS_ASSERT_SAFE(last);
+
+    static_cast<Link *>(last)->d_next_p = d_freeList_p;
+    d_freeList_p = static_cast<Link *>(first);
+}
+
 template <class TYPE>
 inline
 void Pool::deleteObject(const TYPE *object)
@@ -551,6 +642,7 @@ inline
 void Pool::release()
 {
     d_blockList.release();
+    d_chunkList_p = 0;
     d_freeList_p = 0;
     d_begin_p = 0;
     d_end_p = 0;
@@ -62,11 +62,14 @@ using namespace bsl;
 // [10] template <class TYPE> void deleteObjectRaw(const TYPE *object);
 // [ 6] void release();
 // [11] void reserveCapacity(numBlocks);
+// [12] int trim();
+// [13] void *allocateN(int numBlocks);
+// [13] void deallocateN(void *first, void *last);
 // [ 2] int blockSize() const;
 // [ 7] void *operator new(bsl::size_t size, bdlma::Pool& pool);
 // [ 8] void operator delete(void *address, bdlma::Pool& pool);
 //-----------------------------------------------------------------------------
-// [12] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 // [ 2] 'allocate' returns memory of the correct block size.
 // [ 1] int blockSize(numBytes);
 // [ 1] int poolBlockSize(size);
@@ -132,12 +135,12 @@ typedef bdlma::Pool                 Obj;
 
 typedef bsls::BlockGrowth::Strategy Strategy;
 
-// This type was copied from 'bdlma_infrequentdeleteblocklist.h' for testing
-// purposes only.
+// This type was copied from 'bdlma_blocklist.h' for testing purposes only.
 
-struct InfrequentDeleteBlock {
-    InfrequentDeleteBlock               *d_next_p;
-    bsls::AlignmentUtil::MaxAlignedType  d_memory;  // force alignment
+struct Block {
+    Block                                *d_next_p;
+    Block                               **d_addrPrevNext;
+    bsls::AlignmentUtil::MaxAlignedType   d_memory;  // force alignment
 };
 
 // The following enumerator values must be kept in sync with 'bdlma_pool.cpp'.
@@ -157,13 +160,13 @@ enum {
 static
 int blockSize(int numBytes)
     // Return the adjusted block size based on the specified 'numBytes' using
-    // the calculation performed by 'bdlma::InfrequentDeleteBlockList's
-    // 'allocate' method.  The behavior is undefined unless '0 <= numBytes'.
+    // the calculation performed by 'bdlma::BlockList's 'allocate' method.
+    // The behavior is undefined unless '0 <= numBytes'.
 {
     ASSERT(0 <= numBytes);
 
     if (numBytes) {
-        numBytes += sizeof(InfrequentDeleteBlock) - 1;
+        numBytes += sizeof(Block) - 1;
         numBytes &= ~(bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT - 1);
     }
 
@@ -496,7 +499,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 12: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -551,6 +554,399 @@ int main(int argc, char *argv[])
             deleteMyType(&mX, t);
         }
 
+      } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // BATCH ALLOCATION TEST
+        //
+        // Concerns:
+        //   1. That 'allocateN' returns a null-terminated chain of exactly the
+        //      requested number of distinct, writable blocks.
+        //
+        //   2. That 'allocateN' uses free blocks and undispensed blocks of the
+        //      current chunk first, and obtains any shortfall from the
+        //      allocator as a single chunk.
+        //
+        //   3. That 'deallocateN' returns the whole chain to the pool, and the
+        //      blocks are dispensed again, in chain order, without allocating.
+        //
+        //   4. QoI: Asserted precondition violations are detected when
+        //      enabled.
+        //
+        // Plan:
+        //   For each number of blocks to request, and each number of blocks
+        //   to have previously freed, create a pool with a constant chunk size
+        //   and a test allocator, free the blocks, call 'allocateN', and walk
+        //   the chain verifying its length, the distinctness of its blocks,
+        //   and the number of chunks allocated.  Then return the chain with
+        //   'deallocateN' and verify that 'allocate' dispenses its blocks in
+        //   order without allocating.  Finally, verify that, in appropriate
+        //   build modes, defensive checks are triggered for invalid arguments.
+        //
+        // Testing:
+        //   void *allocateN(int numBlocks);
+        //   void deallocateN(void *first, void *last);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BATCH ALLOCATION TEST" << endl
+                                  << "=====================" << endl;
+
+        const int BLOCK_SIZE = 8;
+        const int CHUNK_SIZE = 4;
+
+        enum { MAX_BLOCKS = 3 * CHUNK_SIZE };
+
+        for (int ti = 1; ti <= MAX_BLOCKS; ++ti) {
+            const int NUM_BLOCKS = ti;
+
+            for (int tj = 0; tj <= CHUNK_SIZE; ++tj) {
+                const int NUM_FREE = tj;
+
+                bslma::TestAllocator a(veryVeryVerbose);
+                const bslma::TestAllocator& A = a;
+                Obj mX(BLOCK_SIZE,
+                       bsls::BlockGrowth::BSLS_CONSTANT,
+                       CHUNK_SIZE,
+                       &a);
+
+                // Allocate 'CHUNK_SIZE' blocks and free 'NUM_FREE' of them,
+                // leaving no undispensed blocks in the current chunk.
+
+                void *blocks[CHUNK_SIZE];
+                for (int i = 0; i < CHUNK_SIZE; ++i) {
+                    blocks[i] = mX.allocate();
+                }
+                for (int i = 0; i < NUM_FREE; ++i) {
+                    mX.deallocate(blocks[i]);
+                }
+                ASSERT(1 == A.numBlocksInUse());
+
+                void *head = mX.allocateN(NUM_BLOCKS);
+
+                const int EXP_CHUNKS = NUM_BLOCKS <= NUM_FREE ? 1 : 2;
+                LOOP2_ASSERT(ti, tj, EXP_CHUNKS == A.numBlocksInUse());
+
+                char *chain[MAX_BLOCKS];
+                int   length = 0;
+                void *last   = 0;
+                for (void *p = head; p; p = *static_cast<void **>(p)) {
+                    LOOP2_ASSERT(ti, tj, length < NUM_BLOCKS);
+                    if (length == NUM_BLOCKS) {
+                        break;
+                    }
+                    for (int i = 0; i < length; ++i) {
+                        LOOP3_ASSERT(ti, tj, i, chain[i] != p);
+                    }
+                    chain[length++] = static_cast<char *>(p);
+                    last            = p;
+                }
+                LOOP2_ASSERT(ti, tj, NUM_BLOCKS == length);
+
+                for (int i = 0; i < length; ++i) {
+                    bsl::memset(chain[i], 0xab, BLOCK_SIZE);
+                }
+
+                // Relink the chain, whose links were overwritten, before
+                // returning it.
+
+                for (int i = 0; i < length - 1; ++i) {
+                    *reinterpret_cast<void **>(chain[i]) = chain[i + 1];
+                }
+
+                mX.deallocateN(head, last);
+
+                for (int i = 0; i < length; ++i) {
+                    LOOP3_ASSERT(ti, tj, i, chain[i] == mX.allocate());
+                }
+                LOOP2_ASSERT(ti, tj, EXP_CHUNKS == A.numBlocksInUse());
+            }
+        }
+
+        if (verbose) cout << "\nTesting undispensed blocks." << endl;
+        {
+            bslma::TestAllocator a(veryVeryVerbose);
+            const bslma::TestAllocator& A = a;
+            Obj mX(BLOCK_SIZE,
+                   bsls::BlockGrowth::BSLS_CONSTANT,
+                   CHUNK_SIZE,
+                   &a);
+
+            void *p = mX.allocate();
+            mX.deallocate(p);
+            ASSERT(1 == A.numBlocksInUse());
+
+            // One free block, and 'CHUNK_SIZE - 1' undispensed blocks.
+
+            void *head = mX.allocateN(CHUNK_SIZE);
+            ASSERT(1 == A.numBlocksInUse());
+            ASSERT(p == head);
+
+            mX.allocate();
+            ASSERT(2 == A.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(BLOCK_SIZE);
+
+            void *p = mX.allocate();
+
+            ASSERT_FAIL(mX.allocateN(0));
+            ASSERT_PASS(mX.deallocate(mX.allocateN(1)));
+
+            ASSERT_SAFE_FAIL(mX.deallocateN(0, p));
+            ASSERT_SAFE_FAIL(mX.deallocateN(p, 0));
+            ASSERT_SAFE_PASS(mX.deallocateN(p, p));
+        }
+
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TRIM TEST
+        //
+        // Concerns:
+        //   1. That 'trim' returns to the allocator exactly those chunks none
+        //      of whose blocks is allocated, whether the free blocks of a
+        //      chunk are on the free list or have not yet been dispensed, and
+        //      returns the number of chunks released.
+        //
+        //   2. That 'trim' does not disturb the contents of allocated blocks,
+        //      and that the pool remains fully usable afterwards.
+        //
+        //   3. That chunks obtained by 'reserveCapacity' are trimmed.
+        //
+        //   4. That the free blocks remaining after 'trim' are dispensed in
+        //      increasing address order.
+        //
+        // Plan:
+        //   Using a pool with a constant chunk size and a test allocator,
+        //   free all blocks of selected chunks, call 'trim', and verify the
+        //   return value and the number of blocks in use by the allocator.
+        //   Then, for a geometrically growing pool, deallocate a
+        //   pseudo-random subset of a large number of blocks whose contents
+        //   identify them, call 'trim', and verify that the contents of the
+        //   remaining blocks are unchanged; finally deallocate all blocks and
+        //   verify that 'trim' returns all memory to the allocator.
+        //
+        // Testing:
+        //   int trim();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TRIM TEST" << endl
+                                  << "=========" << endl;
+
+        const int BLOCK_SIZE = 8;
+        const int CHUNK_SIZE = 4;
+
+        if (verbose) cout << "\nTesting an empty pool." << endl;
+        {
+            bslma::TestAllocator a(veryVeryVerbose);
+            const bslma::TestAllocator& A = a;
+            Obj mX(BLOCK_SIZE, &a);
+
+            ASSERT(0 == mX.trim());
+            ASSERT(0 == A.numAllocations());
+        }
+
+        if (verbose) cout << "\nTesting chunks freed by 'deallocate'."
+                          << endl;
+        {
+            bslma::TestAllocator a(veryVeryVerbose);
+            const bslma::TestAllocator& A = a;
+            Obj mX(BLOCK_SIZE,
+                   bsls::BlockGrowth::BSLS_CONSTANT,
+                   CHUNK_SIZE,
+                   &a);
+
+            void *blocks[3 * CHUNK_SIZE];
+            for (int i = 0; i < 3 * CHUNK_SIZE; ++i) {
+                blocks[i] = mX.allocate();
+            }
+            ASSERT(3 == A.numBlocksInUse());
+
+            ASSERT(0 == mX.trim());
+            ASSERT(3 == A.numBlocksInUse());
+
+            // Free all but one block of the first chunk, and all blocks of
+            // the second.
+
+            for (int i = 1; i < 2 * CHUNK_SIZE; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            ASSERT(1 == mX.trim());
+            ASSERT(2 == A.numBlocksInUse());
+
+            ASSERT(0 == mX.trim());
+            ASSERT(2 == A.numBlocksInUse());
+
+            // The free blocks of the first chunk are reused before the pool
+            // replenishes.
+
+            for (int i = 1; i < CHUNK_SIZE; ++i) {
+                mX.allocate();
+            }
+            ASSERT(2 == A.numBlocksInUse());
+
+            mX.allocate();
+            ASSERT(3 == A.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting blocks not yet dispensed." << endl;
+        {
+            bslma::TestAllocator a(veryVeryVerbose);
+            const bslma::TestAllocator& A = a;
+            Obj mX(BLOCK_SIZE,
+                   bsls::BlockGrowth::BSLS_CONSTANT,
+                   CHUNK_SIZE,
+                   &a);
+
+            void *p = mX.allocate();
+            ASSERT(1 == A.numBlocksInUse());
+
+            ASSERT(0 == mX.trim());
+            ASSERT(1 == A.numBlocksInUse());
+
+            mX.deallocate(p);
+
+            ASSERT(1 == mX.trim());
+            ASSERT(0 == A.numBlocksInUse());
+
+            p = mX.allocate();
+            ASSERT(p);
+            ASSERT(1 == A.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting chunks from 'reserveCapacity'."
+                          << endl;
+        {
+            bslma::TestAllocator a(veryVeryVerbose);
+            const bslma::TestAllocator& A = a;
+            Obj mX(BLOCK_SIZE, &a);
+
+            mX.reserveCapacity(10);
+            ASSERT(1 == A.numBlocksInUse());
+
+            ASSERT(1 == mX.trim());
+            ASSERT(0 == A.numBlocksInUse());
+
+            void *p = mX.allocate();
+
+            mX.reserveCapacity(10);
+            ASSERT(2 == A.numBlocksInUse());
+
+            ASSERT(1 == mX.trim());
+            ASSERT(1 == A.numBlocksInUse());
+
+            mX.deallocate(p);
+
+            ASSERT(1 == mX.trim());
+            ASSERT(0 == A.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting address order after 'trim'." << endl;
+        {
+            bslma::TestAllocator a(veryVeryVerbose);
+            Obj mX(BLOCK_SIZE,
+                   bsls::BlockGrowth::BSLS_CONSTANT,
+                   CHUNK_SIZE,
+                   &a);
+
+            enum { NUM_BLOCKS = 4 * CHUNK_SIZE };
+
+            char *blocks[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = static_cast<char *>(mX.allocate());
+            }
+
+            // Deallocate every other block, in an arbitrary order.
+
+            for (int i = 0; i < NUM_BLOCKS; i += 2) {
+                mX.deallocate(blocks[(i * 5) % NUM_BLOCKS]);
+            }
+
+            ASSERT(0 == mX.trim());
+
+            char *previous = static_cast<char *>(mX.allocate());
+            for (int i = 1; i < NUM_BLOCKS / 2; ++i) {
+                char *p = static_cast<char *>(mX.allocate());
+                LOOP_ASSERT(i, previous < p);
+                previous = p;
+            }
+        }
+
+        if (verbose) cout << "\nTesting partial deallocation." << endl;
+        {
+            bslma::TestAllocator a(veryVeryVerbose);
+            const bslma::TestAllocator& A = a;
+            Obj mX(BLOCK_SIZE, &a);
+
+            enum { NUM_BLOCKS = 1000 };
+
+            bsl::vector<char *> blocks(NUM_BLOCKS, &a);
+            bsl::vector<bool>   isFree(NUM_BLOCKS, false, &a);
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = static_cast<char *>(mX.allocate());
+                bsl::memset(blocks[i], i % 128, BLOCK_SIZE);
+            }
+
+            // Free most blocks of the earlier chunks, and few of the later
+            // ones.
+
+            unsigned int seed = 12345;
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                seed = seed * 1103515245 + 12345;
+                if (static_cast<int>((seed >> 16) % NUM_BLOCKS) >= i) {
+                    mX.deallocate(blocks[i]);
+                    isFree[i] = true;
+                }
+            }
+
+            const bsls::Types::Int64 NUM_BYTES = A.numBytesInUse();
+
+            const int NUM_TRIMMED = mX.trim();
+            if (veryVerbose) { T_ P(NUM_TRIMMED) }
+
+            ASSERT(0 < NUM_TRIMMED);
+            ASSERT(NUM_BYTES > A.numBytesInUse());
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                if (!isFree[i]) {
+                    for (int j = 0; j < BLOCK_SIZE; ++j) {
+                        LOOP2_ASSERT(i, j, i % 128 == blocks[i][j]);
+                    }
+                }
+            }
+
+            // Reallocate the free blocks, then deallocate everything.
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                if (isFree[i]) {
+                    blocks[i] = static_cast<char *>(mX.allocate());
+                    bsl::memset(blocks[i], 0xff, BLOCK_SIZE);
+                }
+            }
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                if (!isFree[i]) {
+                    for (int j = 0; j < BLOCK_SIZE; ++j) {
+                        LOOP2_ASSERT(i, j, i % 128 == blocks[i][j]);
+                    }
+                }
+                mX.deallocate(blocks[i]);
+            }
+
+            mX.trim();
+
+            // Only the memory of the vectors remains in use.
+
+            ASSERT(2 == A.numBlocksInUse());
+        }
+
       } break;
       case 11: {
         // --------------------------------------------------------------------
@@ -1629,12 +2025,11 @@ int main(int argc, char *argv[])
         //   implementation of the pool itself.
         //
         // Plan:
-        //   To test 'blockSize', create a 'bdlma::InfrequentDeleteBlockList'
-        //   object initialized with a test allocator.  Invoke both the
-        //   'blockSize' function and the 'bdlma::InfrequentDeleteBlockList's
-        //   'allocate' method with varying memory sizes, and verify that the
-        //   sizes returned by 'blockSize' are equal to the sizes recorded by
-        //   the allocator.
+        //   To test 'blockSize', create a 'bdlma::BlockList' object
+        //   initialized with a test allocator.  Invoke both the 'blockSize'
+        //   function and the 'bdlma::BlockList's 'allocate' method with
+        //   varying memory sizes, and verify that the sizes returned by
+        //   'blockSize' are equal to the sizes recorded by the allocator.
         //
         //   To test 'poolBlockSize', invoke the function with varying sizes,
         //   and verify that the returned value is equal to the difference
@@ -1662,7 +2057,7 @@ int main(int argc, char *argv[])
             const int NUM_DATA = sizeof DATA / sizeof *DATA;
 
             bslma::TestAllocator a(veryVeryVerbose);
-            bdlma::InfrequentDeleteBlockList bl(&a);
+            bdlma::BlockList bl(&a);
 
             for (int i = 0; i < NUM_DATA; ++i) {
                 const int SIZE = DATA[i];
@@ -0,0 +1,199 @@
+// bdlma_samplingcountdown.h                                          -*-C++-*-
+#ifndef INCLUDED_BDLMA_SAMPLINGCOUNTDOWN
+#define INCLUDED_BDLMA_SAMPLINGCOUNTDOWN
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a per-thread countdown to the next sampled request.
+//
+//@CLASSES:
+//  bdlma::SamplingCountdown: countdown private to each thread
+//
+//@SEE_ALSO: bdlma_heapprofilingallocator, bdlma_samplingguardedallocator
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'bdlma::SamplingCountdown', that holds, for each thread that uses it, a
+// positive countdown (of requests or bytes) to the next request to be sampled
+// by a sampling allocator.  A thread reads and writes only its own countdown,
+// so the unsampled requests of concurrent threads touch no shared memory; the
+// allocator takes its (locked) shared path only when the countdown of the
+// calling thread runs out, or when the thread makes its first request.
+//
+// The countdown of a thread that has not set one is 0, which distinguishes
+// its first request.  A countdown is stored as a 'bsls::Types::IntPtr' in a
+// thread-specific storage key, so a value that exceeds the range of that type
+// (possible only on 32-bit platforms) is stored as the largest value of the
+// type.  Note that each object consumes one thread-specific storage key (see
+// 'bsls_bslthreadspecific') for its lifetime.
+//
+///Thread Safety
+///-------------
+// 'bdlma::SamplingCountdown' is fully thread-safe (see 'bsldoc_glossary'):
+// each thread accesses only its own countdown.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sampling One Request in a Thousand
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to log one in every 1000 requests made of a service,
+// without having the threads of the service contend on a shared counter.
+//
+// First, we define a function that returns 'true' if the request made by the
+// calling thread is to be sampled:
+//..
+//  bool isSampled(bdlma::SamplingCountdown *countdown)
+//      // Return 'true' if the current request of the calling thread is
+//      // sampled according to the specified 'countdown', and 'false'
+//      // otherwise.
+//  {
+//      const bsls::Types::Int64 value = countdown->value() - 1;
+//
+//      if (0 < value) {
+//          countdown->setValue(value);
+//          return false;                                             // RETURN
+//      }
+//
+//      // The first request of a thread starts its countdown, and is not
+//      // sampled.
+//
+//      const bool result = 0 != countdown->value();
+//      countdown->setValue(1000);
+//      return result;
+//  }
+//..
+// Then, we count the sampled requests among 5000 requests:
+//..
+//  bdlma::SamplingCountdown countdown;
+//  assert(0 == countdown.value());
+//
+//  int numSampled = 0;
+//  for (int i = 0; i < 5000; ++i) {
+//      numSampled += isSampled(&countdown);
+//  }
+//..
+// Finally, we observe that the first request started the countdown, and that
+// one in every 1000 requests thereafter was sampled:
+//..
+//  assert(4 == numSampled);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLTHREADSPECIFIC
+#include <bsls_bslthreadspecific.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_LIMITS
+#include <bsl_limits.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                          // =======================
+                          // class SamplingCountdown
+                          // =======================
+
+class SamplingCountdown {
+    // This class provides a countdown private to each thread that uses it.
+
+    // DATA
+    bsls::BslThreadSpecific d_key;  // countdown of each thread, stored as an
+                                    // 'IntPtr', or 0 if the thread has set
+                                    // none
+
+  private:
+    // NOT IMPLEMENTED
+    SamplingCountdown(const SamplingCountdown&);
+    SamplingCountdown& operator=(const SamplingCountdown&);
+
+  public:
+    // CREATORS
+    SamplingCountdown();
+        // Create a sampling countdown for which no thread has set a value.
+
+    //! ~SamplingCountdown() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void setValue(bsls::Types::Int64 value);
+        // Set the countdown of the calling thread to the specified 'value',
+        // limited to the largest value of 'bsls::Types::IntPtr'.  The
+        // behavior is undefined unless '0 < value'.
+
+    // ACCESSORS
+    bsls::Types::Int64 value() const;
+        // Return the countdown of the calling thread, or 0 if the calling
+        // thread has not set one.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                          // -----------------------
+                          // class SamplingCountdown
+                          // -----------------------
+
+// CREATORS
+inline
+SamplingCountdown::SamplingCountdown()
+: d_key()
+{
+}
+
+// MANIPULATORS
+inline
+void SamplingCountdown::setValue(bsls::Types::Int64 value)
+{
+    BSLS_ASSERT_SAFE(0 < value);
+
+    const bsls::Types::Int64 maxValue =
+                               bsl::numeric_limits<bsls::Types::IntPtr>::max();
+
+    d_key.setValue(reinterpret_cast<void *>(static_cast<bsls::Types::IntPtr>(
+                                     value < maxValue ? value : maxValue)));
+}
+
+// ACCESSORS
+inline
+bsls::Types::Int64 SamplingCountdown::value() const
+{
+    return reinterpret_cast<bsls::Types::IntPtr>(d_key.value());
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
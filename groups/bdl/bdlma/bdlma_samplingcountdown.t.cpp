@@ -0,0 +1,469 @@
+// bdlma_samplingcountdown.t.cpp                                      -*-C++-*-
+#include <bdlma_samplingcountdown.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_limits.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thin wrapper around a thread-specific storage
+// key.  We verify that the countdown of a thread is initially 0, that it
+// holds any positive value set (limited to the range of
+// 'bsls::Types::IntPtr'), and that the countdowns of different threads, and
+// of different objects, are independent.
+//-----------------------------------------------------------------------------
+// [ 2] SamplingCountdown();
+// [ 2] ~SamplingCountdown();
+// [ 2] void setValue(bsls::Types::Int64 value);
+// [ 2] bsls::Types::Int64 value() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCERN: Each thread has its own countdown.
+// [ 4] USAGE EXAMPLE
+// [ 2] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                       GLOBAL TYPES AND CONSTANTS
+//-----------------------------------------------------------------------------
+
+typedef bdlma::SamplingCountdown Obj;
+typedef bsls::Types::Int64       Int64;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+//=============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+namespace TestCase3 {
+
+struct ThreadInfo {
+    // This 'struct' holds the arguments and results of 'threadFunction'.
+
+    Obj   *d_countdown_p;  // countdown under test
+    Int64  d_initial;      // countdown observed on entry
+    Int64  d_final;        // countdown observed after setting it
+    Int64  d_value;        // value to set
+};
+
+extern "C" void *threadFunction(void *arg)
+    // Record the countdown of the calling thread held by the countdown
+    // object of the 'ThreadInfo' at the specified 'arg', set it to the value
+    // given by that 'ThreadInfo', and record it again.
+{
+    ThreadInfo *info = static_cast<ThreadInfo *>(arg);
+
+    info->d_initial = info->d_countdown_p->value();
+    info->d_countdown_p->setValue(info->d_value);
+    info->d_final   = info->d_countdown_p->value();
+
+    return 0;
+}
+
+}  // close namespace TestCase3
+
+//=============================================================================
+//                               USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sampling One Request in a Thousand
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to log one in every 1000 requests made of a service,
+// without having the threads of the service contend on a shared counter.
+//
+// First, we define a function that returns 'true' if the request made by the
+// calling thread is to be sampled:
+//..
+    bool isSampled(bdlma::SamplingCountdown *countdown)
+        // Return 'true' if the current request of the calling thread is
+        // sampled according to the specified 'countdown', and 'false'
+        // otherwise.
+    {
+        const bsls::Types::Int64 value = countdown->value() - 1;
+
+        if (0 < value) {
+            countdown->setValue(value);
+            return false;                                             // RETURN
+        }
+
+        // The first request of a thread starts its countdown, and is not
+        // sampled.
+
+        const bool result = 0 != countdown->value();
+        countdown->setValue(1000);
+        return result;
+    }
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we count the sampled requests among 5000 requests:
+//..
+    bdlma::SamplingCountdown countdown;
+    ASSERT(0 == countdown.value());
+
+    int numSampled = 0;
+    for (int i = 0; i < 5000; ++i) {
+        numSampled += isSampled(&countdown);
+    }
+//..
+// Finally, we observe that the first request started the countdown, and that
+// one in every 1000 requests thereafter was sampled:
+//..
+    ASSERT(4 == numSampled);
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // PER-THREAD COUNTDOWNS
+        //
+        // Concerns:
+        //: 1 The countdown of a thread that has not set one is 0, even if
+        //:   other threads have set theirs.
+        //:
+        //: 2 Setting the countdown of a thread does not affect the countdowns
+        //:   of other threads.
+        //
+        // Plan:
+        //: 1 Set the countdown of the main thread, then have several threads
+        //:   each observe their initial countdown and set a distinct value,
+        //:   and verify the values observed and the countdown of the main
+        //:   thread.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: Each thread has its own countdown.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PER-THREAD COUNTDOWNS" << endl
+                          << "=====================" << endl;
+
+        using namespace TestCase3;
+
+        enum { NUM_THREADS = 4 };
+
+        Obj mX;  const Obj& X = mX;
+
+        mX.setValue(7);
+
+        ThreadInfo info[NUM_THREADS];
+        ThreadId   ids[NUM_THREADS];
+
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            info[i].d_countdown_p = &mX;
+            info[i].d_initial     = -1;
+            info[i].d_final       = -1;
+            info[i].d_value       = 100 + i;
+
+            ids[i] = createThread(&threadFunction, &info[i]);
+        }
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            joinThread(ids[i]);
+        }
+
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            if (veryVerbose) { P_(i) P_(info[i].d_initial) P(info[i].d_final) }
+
+            ASSERTV(i, 0       == info[i].d_initial);
+            ASSERTV(i, 100 + i == info[i].d_final);
+        }
+
+        ASSERT(7 == X.value());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATOR AND ACCESSOR
+        //
+        // Concerns:
+        //: 1 The countdown of the calling thread is initially 0.
+        //:
+        //: 2 'value' returns the value last passed to 'setValue' by the
+        //:   calling thread, limited to the largest 'bsls::Types::IntPtr'.
+        //:
+        //: 3 The countdowns held by different objects are independent.
+        //:
+        //: 4 'setValue' asserts (in appropriate build modes) that its
+        //:   argument is positive.
+        //
+        // Plan:
+        //: 1 Create two objects, set a series of values in each, and verify
+        //:   the values held by both.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid values (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-4)
+        //
+        // Testing:
+        //   SamplingCountdown();
+        //   ~SamplingCountdown();
+        //   void setValue(bsls::Types::Int64 value);
+        //   bsls::Types::Int64 value() const;
+        //   CONCERN: Precondition violations are detected when enabled.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PRIMARY MANIPULATOR AND ACCESSOR" << endl
+                          << "================================" << endl;
+
+        const Int64 MAX_PTR = bsl::numeric_limits<bsls::Types::IntPtr>::max();
+        const Int64 MAX_64  = bsl::numeric_limits<Int64>::max();
+
+        static const struct {
+            int   d_line;      // source line number
+            Int64 d_value;     // value set
+            Int64 d_expected;  // value expected
+        } DATA[] = {
+            //LINE  VALUE         EXPECTED
+            //----  ------------  -----------
+            { L_,   1,            1           },
+            { L_,   2,            2           },
+            { L_,   1000,         1000        },
+            { L_,   MAX_PTR - 1,  MAX_PTR - 1 },
+            { L_,   MAX_PTR,      MAX_PTR     },
+            { L_,   MAX_64,       MAX_PTR     },
+            { L_,   1,            1           },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        Obj mX;  const Obj& X = mX;
+        Obj mY;  const Obj& Y = mY;
+
+        ASSERT(0 == X.value());
+        ASSERT(0 == Y.value());
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE     = DATA[ti].d_line;
+            const Int64 VALUE    = DATA[ti].d_value;
+            const Int64 EXPECTED = DATA[ti].d_expected;
+
+            if (veryVerbose) { P_(LINE) P_(VALUE) P(EXPECTED) }
+
+            mX.setValue(VALUE);
+            ASSERTV(LINE, EXPECTED == X.value());
+
+            if (0 == ti) {
+                ASSERTV(LINE, 0 == Y.value());
+            }
+
+            mY.setValue(ti + 1);
+            ASSERTV(LINE, EXPECTED == X.value());
+            ASSERTV(LINE, ti + 1   == Y.value());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mZ;
+
+            ASSERT_SAFE_PASS(mZ.setValue( 1));
+            ASSERT_SAFE_FAIL(mZ.setValue( 0));
+            ASSERT_SAFE_FAIL(mZ.setValue(-1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, and set and count down its value.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        Obj mX;  const Obj& X = mX;
+
+        ASSERT(0 == X.value());
+
+        mX.setValue(3);
+        ASSERT(3 == X.value());
+
+        mX.setValue(X.value() - 1);
+        ASSERT(2 == X.value());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
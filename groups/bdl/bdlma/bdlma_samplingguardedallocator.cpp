@@ -0,0 +1,994 @@
+// bdlma_samplingguardedallocator.cpp                                 -*-C++-*-
+#include <bdlma_samplingguardedallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_samplingguardedallocator_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstddef.h>             // 'bsl::size_t'
+#include <bsl_cstdlib.h>             // 'bsl::abort'
+#include <bsl_cstring.h>             // 'bsl::memset'
+#include <bsl_limits.h>              // 'bsl::numeric_limits'
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+#include <windows.h>   // 'CaptureStackBackTrace', 'GetSystemInfo',
+                       // 'VirtualAlloc', 'VirtualFree', 'VirtualProtect'
+#include <bsl_cstdio.h>
+
+#else
+
+#include <signal.h>    // 'sigaction'
+#include <sys/mman.h>  // 'mmap', 'mprotect', 'munmap'
+#include <unistd.h>    // 'sysconf', 'write'
+
+#if defined(BSLS_PLATFORM_OS_LINUX) || defined(BSLS_PLATFORM_OS_DARWIN)
+#include <execinfo.h>  // 'backtrace'
+#endif
+
+#endif
+
+// Define a macro that loads the return addresses of the active calls, starting
+// with the function invoking the macro, into the specified 'frames' array of
+// at most the specified 'maxDepth' elements, and yields the number loaded.
+// Where the call stack cannot be walked, yield an unspecified address for the
+// invoking function followed by its return address (if available).  Note that
+// the functions using this macro ('allocate' and 'deallocate') must not be
+// inlined.
+
+#if defined(BSLS_PLATFORM_OS_LINUX) || defined(BSLS_PLATFORM_OS_DARWIN)
+#define BDLMA_SAMPLINGGUARDEDALLOCATOR_BACKTRACE(frames, maxDepth)            \
+    backtrace((frames), (maxDepth))
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+#define BDLMA_SAMPLINGGUARDEDALLOCATOR_BACKTRACE(frames, maxDepth)            \
+    static_cast<int>(CaptureStackBackTrace(0, (maxDepth), (frames), 0))
+#elif defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+#define BDLMA_SAMPLINGGUARDEDALLOCATOR_BACKTRACE(frames, maxDepth)            \
+    ((frames)[0] = 0, (frames)[1] = __builtin_return_address(0), 2)
+#else
+#define BDLMA_SAMPLINGGUARDEDALLOCATOR_BACKTRACE(frames, maxDepth) 0
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                   // ------------------------------------
+                   // struct SamplingGuardedAllocator::Slot
+                   // ------------------------------------
+
+struct SamplingGuardedAllocator::Slot {
+    // This 'struct' holds the metadata of a guarded slot.
+
+    enum State {
+        e_UNUSED,  // no block has been allocated from the slot
+        e_IN_USE,  // the slot holds a block in use
+        e_FREED    // the block last allocated from the slot is deallocated
+    };
+
+    // DATA
+    volatile int  d_state;               // 'State' of the slot
+    char         *d_block_p;             // address of the last block
+    size_type     d_size;                // size (in bytes) of the last block
+
+    const void   *d_allocationStack[k_MAX_STACK_DEPTH];
+                                         // allocation stack of the last block
+
+    int           d_allocationStackDepth;
+                                         // number of addresses in
+                                         // 'd_allocationStack'
+
+    const void   *d_deallocationStack[k_MAX_STACK_DEPTH];
+                                         // deallocation stack of the last
+                                         // block, if deallocated
+
+    int           d_deallocationStackDepth;
+                                         // number of addresses in
+                                         // 'd_deallocationStack'
+};
+
+}  // close package namespace
+
+namespace {
+
+typedef bdlma::SamplingGuardedAllocator     Obj;
+typedef bsls::AtomicOperations              AtomicOps;
+typedef bsls::AtomicOperations::AtomicTypes AtomicTypes;
+
+// Define the maximum number of allocators whose slot regions are searched by
+// the fault handler.
+
+const int MAX_REGISTERED = 64;
+
+// Define the countdown of a thread using an allocator that has no slots,
+// which is rarely exhausted.
+
+const bsls::Types::Int64 NEVER =
+                                bsl::numeric_limits<bsls::Types::Int64>::max();
+
+// Define the (zero-initialized) process-wide state of the fault handler.
+
+AtomicTypes::Pointer s_registry[MAX_REGISTERED];  // registered allocators
+AtomicTypes::Pointer s_reporter;                  // installed reporter
+AtomicTypes::Int     s_reported;                  // 1 if a fault has been
+                                                  // reported
+AtomicTypes::Int     s_installed;                 // 1 if the handler is
+                                                  // installed
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+
+struct sigaction s_previousSegv;  // 'SIGSEGV' action replaced by the handler
+struct sigaction s_previousBus;   // 'SIGBUS'  action replaced by the handler
+
+#endif
+
+const char *const FAULT_NAMES[] = {
+    "buffer overflow",
+    "buffer underflow",
+    "use after free",
+    "double free",
+    "invalid free"
+};
+
+// HELPER FUNCTIONS
+bsl::size_t getSystemPageSize()
+    // Return the size (in bytes) of a system memory page.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+
+#else
+
+    return static_cast<bsl::size_t>(sysconf(_SC_PAGESIZE));
+
+#endif
+}
+
+char *systemReserve(bsl::size_t size)
+    // Map a page-aligned region of memory of the specified 'size' (in bytes)
+    // that is protected from read/write access, and return its address, or 0
+    // if the region cannot be mapped.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    return static_cast<char *>(VirtualAlloc(0,
+                                            size,
+                                            MEM_COMMIT | MEM_RESERVE,
+                                            PAGE_NOACCESS));          // RETURN
+
+#else
+
+    void *address = mmap(0, size, PROT_NONE, MAP_ANON | MAP_PRIVATE, -1, 0);
+
+    return MAP_FAILED == address ? 0 : static_cast<char *>(address);
+                                                                      // RETURN
+
+#endif
+}
+
+void systemFree(char *address, bsl::size_t size)
+    // Unmap the region of memory of the specified 'size' (in bytes) at the
+    // specified 'address'.  The behavior is undefined unless 'address' was
+    // returned by 'systemReserve' with 'size' and has not already been freed.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    VirtualFree(address, 0, MEM_RELEASE);
+    (void) size;
+
+#else
+
+    munmap(address, size);
+
+#endif
+}
+
+int systemProtect(char *address, bsl::size_t size, bool accessible)
+    // Make the specified 'size' bytes of memory at the specified 'address'
+    // readable and writable if the specified 'accessible' is 'true', and
+    // protect them from read/write access otherwise.  Return 0 on success,
+    // and a non-zero value otherwise.  The behavior is undefined unless
+    // 'address' and 'size' are multiples of the page size.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    DWORD oldProtect;
+
+    return !VirtualProtect(address,
+                           size,
+                           accessible ? PAGE_READWRITE : PAGE_NOACCESS,
+                           &oldProtect);                              // RETURN
+
+#else
+
+    return mprotect(address,
+                    size,
+                    accessible ? PROT_READ | PROT_WRITE : PROT_NONE);
+                                                                      // RETURN
+
+#endif
+}
+
+int copyStack(const void        **result,
+              const void *const  *stack,
+              int                 depth)
+    // Copy to the specified 'result' array of 'Obj::k_MAX_STACK_DEPTH'
+    // elements the first (at most 'Obj::k_MAX_STACK_DEPTH') of the specified
+    // 'depth' return addresses at the specified 'stack', and return the number
+    // copied.
+{
+    if (depth > Obj::k_MAX_STACK_DEPTH) {
+        depth = Obj::k_MAX_STACK_DEPTH;
+    }
+    for (int i = 0; i < depth; ++i) {
+        result[i] = stack[i];
+    }
+    return depth;
+}
+
+void loadAllocationStack(Obj::FaultReport  *report,
+                         const void *const *stack,
+                         int                depth)
+    // Load into the specified 'report' the specified 'depth' return addresses
+    // at the specified 'stack' as its allocation stack and site.
+{
+    report->d_allocationStackDepth = copyStack(report->d_allocationStack,
+                                               stack,
+                                               depth);
+    report->d_allocationSite_p     = report->d_allocationStackDepth
+                                   ? report->d_allocationStack[0]
+                                   : 0;
+}
+
+void loadDeallocationStack(Obj::FaultReport  *report,
+                           const void *const *stack,
+                           int                depth)
+    // Load into the specified 'report' the specified 'depth' return addresses
+    // at the specified 'stack' as its deallocation stack and site.
+{
+    report->d_deallocationStackDepth = copyStack(report->d_deallocationStack,
+                                                 stack,
+                                                 depth);
+    report->d_deallocationSite_p     = report->d_deallocationStackDepth
+                                     ? report->d_deallocationStack[0]
+                                     : 0;
+}
+
+void reportFault(const Obj::FaultReport& report)
+    // Invoke the installed reporter, or 'Obj::printReport' if none is
+    // installed, with the specified 'report', unless a fault has already been
+    // reported since the fault handler was last installed.
+{
+    if (0 != AtomicOps::testAndSwapInt(&s_reported, 0, 1)) {
+        return;                                                       // RETURN
+    }
+
+    Obj::FaultReporter reporter = reinterpret_cast<Obj::FaultReporter>(
+                                        AtomicOps::getPtrAcquire(&s_reporter));
+
+    (reporter ? reporter : &Obj::printReport)(report);
+}
+
+char *appendString(char *cursor, char *end, const char *string)
+    // Append the specified null-terminated 'string' to the buffer at the
+    // specified 'cursor', writing no further than the specified 'end', and
+    // return the position following the last character written.
+{
+    while (cursor < end && *string) {
+        *cursor++ = *string++;
+    }
+    return cursor;
+}
+
+char *appendNumber(char                *cursor,
+                   char                *end,
+                   bsls::Types::Uint64  value,
+                   int                  base)
+    // Append the specified 'value' in the specified 'base' (10 or 16) to the
+    // buffer at the specified 'cursor', writing no further than the specified
+    // 'end', and return the position following the last character written.
+    // Hexadecimal values are prefixed with "0x".
+{
+    char  digits[24];
+    char *digit = digits + sizeof digits;
+
+    do {
+        *--digit = "0123456789abcdef"[value % base];
+        value   /= base;
+    } while (value);
+
+    if (16 == base) {
+        cursor = appendString(cursor, end, "0x");
+    }
+    while (cursor < end && digit < digits + sizeof digits) {
+        *cursor++ = *digit++;
+    }
+    return cursor;
+}
+
+char *appendAddress(char *cursor, char *end, const void *address)
+    // Append the specified 'address' in hexadecimal to the buffer at the
+    // specified 'cursor', writing no further than the specified 'end', and
+    // return the position following the last character written.
+{
+    return appendNumber(cursor,
+                        end,
+                        reinterpret_cast<bsls::Types::UintPtr>(address),
+                        16);
+}
+
+char *appendStack(char              *cursor,
+                  char              *end,
+                  const void        *site,
+                  const void *const *stack,
+                  int                depth)
+    // Append the specified 'depth' return addresses at the specified 'stack',
+    // each preceded by a space, to the buffer at the specified 'cursor',
+    // writing no further than the specified 'end', and return the position
+    // following the last character written.  If 'depth' is 0, append the
+    // specified 'site' instead.
+{
+    if (0 == depth) {
+        cursor = appendString(cursor, end, " ");
+        return appendAddress(cursor, end, site);                      // RETURN
+    }
+
+    for (int i = 0; i < depth; ++i) {
+        cursor = appendString(cursor, end, " ");
+        cursor = appendAddress(cursor, end, stack[i]);
+    }
+    return cursor;
+}
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+
+void passToPreviousHandler(int signal, siginfo_t *info, void *context)
+    // Pass the specified 'signal', having the specified 'info' and 'context',
+    // to the handler that was installed before the fault handler.  If that
+    // handler is the default (or ignores the signal), restore the default
+    // action and return, so that the faulting access is re-executed with the
+    // default action.
+{
+    const struct sigaction *previous = SIGBUS == signal
+                                     ? &s_previousBus
+                                     : &s_previousSegv;
+
+    if (previous->sa_flags & SA_SIGINFO) {
+        previous->sa_sigaction(signal, info, context);
+        return;                                                       // RETURN
+    }
+
+    if (SIG_DFL == previous->sa_handler || SIG_IGN == previous->sa_handler) {
+        struct sigaction action;
+        bsl::memset(&action, 0, sizeof action);
+        action.sa_handler = SIG_DFL;
+        sigemptyset(&action.sa_mask);
+        sigaction(signal, &action, 0);
+        return;                                                       // RETURN
+    }
+
+    previous->sa_handler(signal);
+}
+
+#endif
+
+}  // close unnamed namespace
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+
+extern "C"
+void bdlma_SamplingGuardedAllocator_handleFault(int        signal,
+                                                siginfo_t *info,
+                                                void      *context)
+    // Report the fault at the address in the specified 'info' if it can be
+    // attributed to a block sampled by a registered allocator, and pass the
+    // specified 'signal', 'info', and 'context' to the previous handler.
+{
+    for (int i = 0; i < MAX_REGISTERED; ++i) {
+        const Obj *allocator = static_cast<const Obj *>(
+                                     AtomicOps::getPtrAcquire(&s_registry[i]));
+
+        Obj::FaultReport report;
+        if (allocator && 0 == allocator->describeAddress(&report,
+                                                         info->si_addr)) {
+            reportFault(report);
+            break;
+        }
+    }
+
+    passToPreviousHandler(signal, info, context);
+}
+
+#endif
+
+namespace bdlma {
+
+                       // ------------------------------
+                       // class SamplingGuardedAllocator
+                       // ------------------------------
+
+// PRIVATE MANIPULATORS
+char *SamplingGuardedAllocator::allocateFromSlot(size_type          size,
+                                                 const void *const *stack,
+                                                 int                depth)
+{
+    if (size > d_maxGuardedSize || 0 == d_numFree) {
+        return 0;                                                     // RETURN
+    }
+
+    const int  index = d_freeQueue_p[d_freeHead];
+    char      *slot  = d_begin_p
+                     + d_pageSize
+                     + index * (d_slotSize + d_pageSize);
+
+    if (0 != systemProtect(slot, d_slotSize, true)) {
+        return 0;                                                     // RETURN
+    }
+
+    d_freeHead = (d_freeHead + 1) % d_numSlots;
+    --d_numFree;
+
+    // A block placed at the end of its slot is aligned only as its size
+    // requires, since the end of the slot is page-aligned.
+
+    char *block = d_alignToEnd ? slot + d_slotSize - size : slot;
+    d_alignToEnd = !d_alignToEnd;
+
+    Slot& metadata = d_slots_p[index];
+    metadata.d_block_p                = block;
+    metadata.d_size                   = size;
+    metadata.d_allocationStackDepth   = copyStack(metadata.d_allocationStack,
+                                                  stack,
+                                                  depth);
+    metadata.d_deallocationStackDepth = 0;
+    metadata.d_state                  = Slot::e_IN_USE;
+
+    ++d_numSampled;
+
+    return block;
+}
+
+void *SamplingGuardedAllocator::allocateSampled(
+                                          size_type           size,
+                                          bsls::Types::Int64  countdown,
+                                          const void *const  *stack,
+                                          int                 depth)
+{
+    BSLS_ASSERT(0 >= countdown);
+
+    if (!d_begin_p) {
+        d_countdown.setValue(NEVER);
+        return d_allocator_p->allocate(size);                         // RETURN
+    }
+
+    char *block = 0;
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        // A thread that has made no request has no countdown yet; start it
+        // at a fresh interval, sampling this request only if its weight
+        // exhausts that interval.
+
+        if (0 == d_countdown.value()) {
+            countdown += nextInterval();
+        }
+
+        if (0 < countdown) {
+            d_countdown.setValue(countdown);
+        }
+        else {
+            // Carry the amount by which the countdown was overrun into the
+            // next interval, so that sampling by bytes is not biased against
+            // requests of a size comparable to the period.
+
+            const bsls::Types::Int64 interval = nextInterval() + countdown;
+            d_countdown.setValue(interval > 0 ? interval : 1);
+
+            block = allocateFromSlot(size, stack, depth);
+        }
+    }
+
+    return block ? block : d_allocator_p->allocate(size);
+}
+
+void SamplingGuardedAllocator::deallocateSampled(void              *address,
+                                                 const void *const *stack,
+                                                 int                depth)
+{
+    char            *block  = static_cast<char *>(address);
+    const size_type  stride = d_slotSize + d_pageSize;
+    const size_type  offset = block - d_begin_p;
+
+    FaultReport report;
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        const bool      inSlot = offset >= d_pageSize
+                              && (offset - d_pageSize) % stride < d_slotSize;
+        const size_type index  = inSlot ? (offset - d_pageSize) / stride : 0;
+
+        if (inSlot && Slot::e_IN_USE == d_slots_p[index].d_state
+                   && block == d_slots_p[index].d_block_p) {
+            Slot& metadata = d_slots_p[index];
+
+            systemProtect(block - (offset - d_pageSize) % stride,
+                          d_slotSize,
+                          false);
+
+            metadata.d_deallocationStackDepth = copyStack(
+                                                 metadata.d_deallocationStack,
+                                                 stack,
+                                                 depth);
+            metadata.d_state                  = Slot::e_FREED;
+
+            d_freeQueue_p[(d_freeHead + d_numFree) % d_numSlots] =
+                                                     static_cast<int>(index);
+            ++d_numFree;
+
+            return;                                                   // RETURN
+        }
+
+        report.d_type           = e_INVALID_FREE;
+        report.d_faultAddress_p = address;
+        report.d_blockAddress_p = 0;
+        report.d_blockSize      = 0;
+        loadAllocationStack(&report, 0, 0);
+        loadDeallocationStack(&report, stack, depth);
+
+        if (inSlot && Slot::e_UNUSED != d_slots_p[index].d_state) {
+            const Slot& metadata = d_slots_p[index];
+
+            if (Slot::e_FREED == metadata.d_state
+             && block         == metadata.d_block_p) {
+                report.d_type = e_DOUBLE_FREE;
+                loadDeallocationStack(&report,
+                                      metadata.d_deallocationStack,
+                                      metadata.d_deallocationStackDepth);
+            }
+            report.d_blockAddress_p = metadata.d_block_p;
+            report.d_blockSize      = metadata.d_size;
+            loadAllocationStack(&report,
+                                metadata.d_allocationStack,
+                                metadata.d_allocationStackDepth);
+        }
+    }
+
+    reportFault(report);
+    bsl::abort();
+}
+
+void SamplingGuardedAllocator::initialize()
+{
+    BSLS_ASSERT(0 < d_samplePeriod);
+    BSLS_ASSERT(0 < d_numSlots);
+    BSLS_ASSERT(0 < d_maxGuardedSize);
+
+    d_pageSize = getSystemPageSize();
+    d_slotSize = (d_maxGuardedSize + d_pageSize - 1) / d_pageSize * d_pageSize;
+
+    // Seed the generator of sample intervals from the address of this object,
+    // so that allocators in different processes (and with different
+    // addresses) sample different requests.
+
+    d_randomState = reinterpret_cast<bsls::Types::UintPtr>(this)
+                  ^ 0x9E3779B97F4A7C15ULL;
+
+    // Allocate the slot metadata and the free queue in a single block.
+
+    d_slots_p = static_cast<Slot *>(d_allocator_p->allocate(
+                              d_numSlots * (sizeof(Slot) + sizeof(int))));
+    d_freeQueue_p = reinterpret_cast<int *>(d_slots_p + d_numSlots);
+
+    const size_type regionSize = d_numSlots * (d_slotSize + d_pageSize)
+                               + d_pageSize;
+
+    d_begin_p = systemReserve(regionSize);
+
+    if (!d_begin_p) {
+        d_allocator_p->deallocate(d_slots_p);
+        d_slots_p     = 0;
+        d_freeQueue_p = 0;
+        return;                                                       // RETURN
+    }
+
+    d_end_p = d_begin_p + regionSize;
+
+    for (int i = 0; i < d_numSlots; ++i) {
+        Slot& metadata = d_slots_p[i];
+        metadata.d_state                  = Slot::e_UNUSED;
+        metadata.d_block_p                = 0;
+        metadata.d_size                   = 0;
+        metadata.d_allocationStackDepth   = 0;
+        metadata.d_deallocationStackDepth = 0;
+
+        d_freeQueue_p[i] = i;
+    }
+    d_numFree = d_numSlots;
+
+    // Register this allocator with the fault handler.  If the registry is
+    // full, faults in this allocator are not reported by the handler.
+
+    for (int i = 0; i < MAX_REGISTERED; ++i) {
+        if (0 == AtomicOps::testAndSwapPtr(&s_registry[i], 0, this)) {
+            break;
+        }
+    }
+}
+
+bsls::Types::Int64 SamplingGuardedAllocator::nextInterval()
+{
+    // Advance an 'xorshift64*' generator.
+
+    bsls::Types::Uint64 x = d_randomState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    d_randomState = x;
+
+    const bsls::Types::Uint64 random = x * 0x2545F4914F6CDD1DULL;
+
+    return 1 + static_cast<bsls::Types::Int64>(
+                   random % static_cast<bsls::Types::Uint64>(
+                                                     2 * d_samplePeriod - 1));
+}
+
+// CLASS METHODS
+int SamplingGuardedAllocator::installFaultHandler(FaultReporter reporter)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    (void) reporter;
+    return -1;                                                        // RETURN
+
+#else
+
+    AtomicOps::setPtrRelease(&s_reporter, reinterpret_cast<void *>(reporter));
+    AtomicOps::setInt(&s_reported, 0);
+
+    if (AtomicOps::getInt(&s_installed)) {
+        return 0;                                                     // RETURN
+    }
+
+    struct sigaction action;
+    bsl::memset(&action, 0, sizeof action);
+    action.sa_sigaction = &bdlma_SamplingGuardedAllocator_handleFault;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_SIGINFO;
+
+    if (0 != sigaction(SIGSEGV, &action, &s_previousSegv)) {
+        return -1;                                                    // RETURN
+    }
+
+    if (0 != sigaction(SIGBUS, &action, &s_previousBus)) {
+        sigaction(SIGSEGV, &s_previousSegv, 0);
+        return -1;                                                    // RETURN
+    }
+
+    AtomicOps::setInt(&s_installed, 1);
+
+    return 0;
+
+#endif
+}
+
+void SamplingGuardedAllocator::printReport(const FaultReport& report)
+{
+    char  buffer[1024];
+    char *end    = buffer + sizeof buffer - 1;
+    char *cursor = buffer;
+
+    cursor = appendString(cursor, end, "bdlma::SamplingGuardedAllocator: ");
+    cursor = appendString(cursor, end, FAULT_NAMES[report.d_type]);
+    cursor = appendString(cursor, end, " at ");
+    cursor = appendAddress(cursor, end, report.d_faultAddress_p);
+
+    if (report.d_blockAddress_p) {
+        cursor = appendString(cursor, end, " of block ");
+        cursor = appendAddress(cursor, end, report.d_blockAddress_p);
+        cursor = appendString(cursor, end, " (");
+        cursor = appendNumber(cursor, end, report.d_blockSize, 10);
+        cursor = appendString(cursor, end, " bytes) allocated at");
+        cursor = appendStack(cursor,
+                             end,
+                             report.d_allocationSite_p,
+                             report.d_allocationStack,
+                             report.d_allocationStackDepth);
+    }
+
+    if (report.d_deallocationSite_p) {
+        cursor = appendString(cursor, end, ", deallocated at");
+        cursor = appendStack(cursor,
+                             end,
+                             report.d_deallocationSite_p,
+                             report.d_deallocationStack,
+                             report.d_deallocationStackDepth);
+    }
+
+    *cursor++ = '\n';
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    bsl::fwrite(buffer, 1, cursor - buffer, stderr);
+
+#else
+
+    ssize_t rc = write(2, buffer, cursor - buffer);
+    (void) rc;
+
+#endif
+}
+
+void SamplingGuardedAllocator::uninstallFaultHandler()
+{
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+
+    if (!AtomicOps::getInt(&s_installed)) {
+        return;                                                       // RETURN
+    }
+
+    sigaction(SIGSEGV, &s_previousSegv, 0);
+    sigaction(SIGBUS,  &s_previousBus,  0);
+
+    AtomicOps::setInt(&s_installed, 0);
+
+#endif
+}
+
+// CREATORS
+SamplingGuardedAllocator::SamplingGuardedAllocator(
+                                              bslma::Allocator *basicAllocator)
+: d_countdown()
+, d_sampleMode(e_SAMPLE_BY_COUNT)
+, d_samplePeriod(k_DEFAULT_SAMPLE_PERIOD)
+, d_maxGuardedSize(k_DEFAULT_MAX_GUARDED_SIZE)
+, d_numSlots(k_DEFAULT_NUM_SLOTS)
+, d_pageSize(0)
+, d_slotSize(0)
+, d_begin_p(0)
+, d_end_p(0)
+, d_slots_p(0)
+, d_freeQueue_p(0)
+, d_freeHead(0)
+, d_numFree(0)
+, d_alignToEnd(true)
+, d_randomState(0)
+, d_numSampled(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize();
+}
+
+SamplingGuardedAllocator::SamplingGuardedAllocator(
+                                       SampleMode          sampleMode,
+                                       bsls::Types::Int64  samplePeriod,
+                                       int                 numSlots,
+                                       size_type           maxGuardedSize,
+                                       bslma::Allocator   *basicAllocator)
+: d_countdown()
+, d_sampleMode(sampleMode)
+, d_samplePeriod(samplePeriod)
+, d_maxGuardedSize(maxGuardedSize)
+, d_numSlots(numSlots)
+, d_pageSize(0)
+, d_slotSize(0)
+, d_begin_p(0)
+, d_end_p(0)
+, d_slots_p(0)
+, d_freeQueue_p(0)
+, d_freeHead(0)
+, d_numFree(0)
+, d_alignToEnd(true)
+, d_randomState(0)
+, d_numSampled(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize();
+}
+
+SamplingGuardedAllocator::~SamplingGuardedAllocator()
+{
+    if (!d_begin_p) {
+        return;                                                       // RETURN
+    }
+
+    for (int i = 0; i < MAX_REGISTERED; ++i) {
+        if (this == AtomicOps::testAndSwapPtr(&s_registry[i], this, 0)) {
+            break;
+        }
+    }
+
+    systemFree(d_begin_p, d_end_p - d_begin_p);
+    d_allocator_p->deallocate(d_slots_p);
+}
+
+// MANIPULATORS
+void *SamplingGuardedAllocator::allocate(size_type size)
+{
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    const bsls::Types::Int64 weight = e_SAMPLE_BY_COUNT == d_sampleMode
+                                    ? 1
+                                    : static_cast<bsls::Types::Int64>(size);
+
+    const bsls::Types::Int64 countdown = d_countdown.value() - weight;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 >= countdown)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // Capture one more frame than is recorded, since the first frame is
+        // in this function.
+
+        void      *frames[k_MAX_STACK_DEPTH + 1];
+        const int  depth = BDLMA_SAMPLINGGUARDEDALLOCATOR_BACKTRACE(
+                                                       frames,
+                                                       k_MAX_STACK_DEPTH + 1);
+
+        return allocateSampled(size,
+                               countdown,
+                               frames + 1,
+                               depth > 1 ? depth - 1 : 0);            // RETURN
+    }
+
+    d_countdown.setValue(countdown);
+
+    return d_allocator_p->allocate(size);
+}
+
+void SamplingGuardedAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(isSlotAddress(address))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        void      *frames[k_MAX_STACK_DEPTH + 1];
+        const int  depth = BDLMA_SAMPLINGGUARDEDALLOCATOR_BACKTRACE(
+                                                       frames,
+                                                       k_MAX_STACK_DEPTH + 1);
+
+        deallocateSampled(address, frames + 1, depth > 1 ? depth - 1 : 0);
+        return;                                                       // RETURN
+    }
+
+    d_allocator_p->deallocate(address);
+}
+
+// ACCESSORS
+int SamplingGuardedAllocator::describeAddress(FaultReport *result,
+                                              const void  *address) const
+{
+    BSLS_ASSERT(result);
+
+    if (!isSlotAddress(address)) {
+        return -1;                                                    // RETURN
+    }
+
+    const char      *p      = static_cast<const char *>(address);
+    const size_type  stride = d_slotSize + d_pageSize;
+    const size_type  offset = p - d_begin_p;
+
+    FaultType   type = e_BUFFER_OVERFLOW;
+    const Slot *slot = 0;
+
+    if (offset >= d_pageSize && (offset - d_pageSize) % stride < d_slotSize) {
+        // 'address' is in the data pages of a slot.
+
+        slot = &d_slots_p[(offset - d_pageSize) / stride];
+
+        if (Slot::e_UNUSED == slot->d_state) {
+            return -1;                                                // RETURN
+        }
+
+        if (Slot::e_FREED == slot->d_state) {
+            type = e_USE_AFTER_FREE;
+        }
+        else if (p < slot->d_block_p) {
+            type = e_BUFFER_UNDERFLOW;
+        }
+        else if (p >= slot->d_block_p + slot->d_size) {
+            type = e_BUFFER_OVERFLOW;
+        }
+        else {
+            return -1;                                                // RETURN
+        }
+    }
+    else {
+        // 'address' is in the guard page preceding slot 'guard'; attribute it
+        // to the nearer block of the adjacent slots, preferring a block in
+        // use to a deallocated one.
+
+        const int guard = static_cast<int>(offset / stride);
+
+        size_type bestDistance = 0;
+        int       bestRank     = 2;
+
+        for (int side = 0; side < 2; ++side) {
+            const int index = guard - 1 + side;
+            if (index < 0 || index >= d_numSlots) {
+                continue;
+            }
+
+            const Slot& candidate = d_slots_p[index];
+            if (Slot::e_UNUSED == candidate.d_state) {
+                continue;
+            }
+
+            const int       rank     = Slot::e_IN_USE == candidate.d_state
+                                     ? 0
+                                     : 1;
+            const size_type distance = 0 == side
+                            ? p - (candidate.d_block_p + candidate.d_size)
+                            : candidate.d_block_p - p;
+
+            if (rank < bestRank
+             || (rank == bestRank && distance < bestDistance)) {
+                slot         = &candidate;
+                type         = 0 == side ? e_BUFFER_OVERFLOW
+                                         : e_BUFFER_UNDERFLOW;
+                bestRank     = rank;
+                bestDistance = distance;
+            }
+        }
+
+        if (!slot) {
+            return -1;                                                // RETURN
+        }
+    }
+
+    result->d_type               = type;
+    result->d_faultAddress_p     = address;
+    result->d_blockAddress_p     = slot->d_block_p;
+    result->d_blockSize          = slot->d_size;
+    loadAllocationStack(result,
+                        slot->d_allocationStack,
+                        slot->d_allocationStackDepth);
+    loadDeallocationStack(result,
+                          slot->d_deallocationStack,
+                          Slot::e_FREED == slot->d_state
+                          ? slot->d_deallocationStackDepth
+                          : 0);
+
+    return 0;
+}
+
+bsls::Types::Int64 SamplingGuardedAllocator::numGuardedBlocks() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_begin_p ? d_numSlots - d_numFree : 0;
+}
+
+bsls::Types::Int64 SamplingGuardedAllocator::numSampledAllocations() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_numSampled;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,607 @@
+// bdlma_samplingguardedallocator.h                                   -*-C++-*-
+#ifndef INCLUDED_BDLMA_SAMPLINGGUARDEDALLOCATOR
+#define INCLUDED_BDLMA_SAMPLINGGUARDEDALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator guarding a sample of blocks against misuse.
+//
+//@CLASSES:
+//  bdlma::SamplingGuardedAllocator: guards one in 'N' allocations
+//
+//@SEE_ALSO: bdlma_guardingallocator
+//
+//@DESCRIPTION: This component provides a concrete allocation mechanism,
+// 'bdlma::SamplingGuardedAllocator', that implements the 'bslma::Allocator'
+// protocol and wraps an allocator supplied at construction.  Roughly one in
+// every 'samplePeriod' allocation requests (or one in every 'samplePeriod'
+// bytes requested, see {Sampling}) is satisfied from a small pool of *slots*
+// surrounded by read/write protected guard pages, in the manner of
+// 'bdlma::GuardingAllocator'; all other requests are forwarded to the wrapped
+// allocator.  A sampled block is placed against the guard page that follows
+// or precedes its slot (alternating between the two), and its slot is
+// protected again when the block is deallocated.  Hence, an overflow,
+// underflow, or use-after-free of a sampled block triggers a memory fault at
+// the offending access, which can be attributed to the block and to the code
+// that allocated it (see {Fault Reports}):
+//..
+//   ,-------------------------------.
+//  ( bdlma::SamplingGuardedAllocator )
+//   `-------------------------------'
+//                   |         ctor/dtor
+//                   |         describeAddress
+//                   |         installFaultHandler
+//                   |         maxGuardedSize
+//                   |         numGuardedBlocks
+//                   |         numSampledAllocations
+//                   |         numSlots
+//                   |         printReport
+//                   |         sampleMode
+//                   |         samplePeriod
+//                   |         uninstallFaultHandler
+//                   V
+//          ,----------------.
+//         ( bslma::Allocator )
+//          `----------------'
+//                             allocate
+//                             deallocate
+//..
+// Unlike 'bdlma::GuardingAllocator', which makes several system calls for
+// every allocation, this allocator is intended for use in production: the cost
+// of an unsampled request is that of the wrapped allocator plus the decrement
+// of a countdown private to the calling thread and a (well-predicted) branch,
+// and with the default sample period of 5000 the cost of the two 'mprotect'
+// calls made for each sampled block is amortized to a negligible amount.
+// Since only a small fraction of blocks is guarded, a given bug is detected
+// only with some probability per run; the value of the allocator comes from
+// running it continuously across a fleet of processes.
+//
+///Sampling
+///--------
+// The allocator maintains, for each thread that uses it, a countdown that is
+// decremented by each call to 'allocate' made by that thread.  In
+// 'e_SAMPLE_BY_COUNT' mode, each request decrements the countdown by one; in
+// 'e_SAMPLE_BY_BYTES' mode, by the number of bytes requested, so that large
+// blocks are proportionally more likely to be sampled.  The request that
+// brings the countdown to zero (or below) is sampled, and a pseudo-random
+// interval drawn uniformly from '[1, 2 * samplePeriod - 1]', whose mean is
+// 'samplePeriod', is added to the countdown (so that the amount by which it
+// was overrun is carried over).  The randomization prevents a periodic
+// allocation pattern from systematically escaping (or hitting) the sample.
+//
+// The countdown of a thread is started at a pseudo-random interval by the
+// first request that the thread makes.  Intervals are drawn from a single
+// generator under the internal lock, so the state shared by all threads is
+// touched only when the countdown of some thread runs out.  Note that each
+// allocator consumes one thread-specific storage key (see
+// 'bdlma_samplingcountdown') for its lifetime.
+//
+// A sampled request is nevertheless forwarded to the wrapped allocator if it
+// is for more than 'maxGuardedSize' bytes, or if every slot is in use.  Since
+// a slot is protected again when its block is deallocated, and deallocated
+// slots are reused in first-in, first-out order, a freed block remains
+// inaccessible for as long as possible.
+//
+///Slot Layout
+///-----------
+// All slots are mapped in a single region at construction, with every page of
+// the region initially protected, so the allocator makes no further system
+// calls to map or protect guard pages:
+//..
+//  G - read/write protected guard page
+//  S - data pages of a slot (protected unless it holds a sampled block)
+//
+//      -------------------------------------------------
+//      | G |  S  | G |  S  | G |  ...  | G |  S  | G |
+//      -------------------------------------------------
+//..
+// Each slot spans the number of pages needed to hold 'maxGuardedSize' bytes.
+// Successive sampled blocks are alternately placed so that they end
+// immediately before the guard page following their slot, detecting overflow,
+// or start immediately after the guard page preceding their slot, detecting
+// underflow.  A block placed against the following guard page is aligned
+// only as required for an object of its size (see
+// 'bsls::AlignmentUtil::calculateAlignmentFromSize'), so that an access even
+// one byte past its end faults.
+//
+// If the region cannot be mapped at construction, the allocator forwards every
+// request to the wrapped allocator.
+//
+///Fault Reports
+///-------------
+// The 'describeAddress' method classifies an address that lies in the slot
+// region of an allocator as an overflow or underflow of the nearest block in
+// use (if the address is in a guard page), or as a use of a deallocated block
+// (if the address is in a slot that is not in use), and loads a 'FaultReport'
+// describing the block and the call stacks that allocated and deallocated it.
+// The allocator also reports a 'deallocate' of an address in its slot region
+// that was not returned by 'allocate', or that was already deallocated, and
+// then aborts the program.
+//
+// On POSIX platforms, the class method 'installFaultHandler' installs a
+// process-wide handler for 'SIGSEGV' and 'SIGBUS' that, on a memory fault,
+// looks up the faulting address in every 'SamplingGuardedAllocator' that
+// exists, reports the *first* fault so attributed by invoking a reporter
+// function ('printReport' by default, which writes to 'stderr'), and then
+// passes the signal to the handler that was previously installed.  If the
+// previous disposition was the default, the faulting access is re-executed
+// with the default disposition restored, so the process terminates (and
+// dumps core) exactly as if the handler had not been installed.
+//
+// The call stacks recorded for a sampled block are captured by 'backtrace' on
+// Linux and Darwin, and by 'CaptureStackBackTrace' on Windows, and consist of
+// the return addresses of (at most 'k_MAX_STACK_DEPTH') active calls, starting
+// with the call to 'allocate' or 'deallocate'.  On other platforms, only the
+// return address of that call is captured, if the compiler supports
+// '__builtin_return_address'.  The addresses can be mapped to source locations
+// with a symbolizer such as 'addr2line'.  A stack is captured only by a
+// request that is sampled (or by the first request of a thread), and only
+// before the internal lock is acquired.
+//
+///Thread Safety
+///-------------
+// The 'bdlma::SamplingGuardedAllocator' class is fully thread-safe (see
+// 'bsldoc_glossary') provided that the wrapped allocator is fully
+// thread-safe.  Sampled blocks are managed under an internal lock, which is
+// acquired only by a sampled request and by a thread's first request; an
+// unsampled request writes only to storage private to the calling thread.  The
+// 'describeAddress' method does not acquire the lock, so that it may be called
+// from a signal handler.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Catching a Use-After-Free in Production
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service occasionally crashes with a corrupted heap, and that
+// the bug cannot be reproduced under a debugging tool.  We run the service
+// with a sampling guarded allocator in place of its usual allocator, so that
+// a memory error in a sampled block is caught at the faulting access.
+//
+// First, at startup, we install the fault handler, so that the first memory
+// error detected is reported with the allocation site of the block involved:
+//..
+//  bdlma::SamplingGuardedAllocator::installFaultHandler();
+//..
+// Then, we create an allocator that guards one in every 1000 allocations and
+// wraps the default allocator:
+//..
+//  typedef bdlma::SamplingGuardedAllocator SGA;
+//
+//  SGA allocator(SGA::e_SAMPLE_BY_COUNT, 1000, 16, 4096);
+//..
+// Now, we use the allocator as we would any other.  Most requests are
+// forwarded to the default allocator; about one in 1000 is sampled:
+//..
+//  for (int i = 0; i < 100000; ++i) {
+//      void *p = allocator.allocate(64);
+//      allocator.deallocate(p);
+//  }
+//
+//  assert(0 < allocator.numSampledAllocations());
+//  assert(0 == allocator.numGuardedBlocks());
+//..
+// Finally, we observe that a guarded block, once deallocated, is recognized as
+// such, so that a subsequent access to it would be reported as a
+// use-after-free:
+//..
+//  void *block = 0;
+//  while (!block) {
+//      void *p = allocator.allocate(64);
+//      if (1 == allocator.numGuardedBlocks()) {
+//          block = p;
+//      }
+//      allocator.deallocate(p);
+//  }
+//
+//  SGA::FaultReport report;
+//  assert(0                     == allocator.describeAddress(&report, block));
+//  assert(SGA::e_USE_AFTER_FREE == report.d_type);
+//  assert(block                 == report.d_blockAddress_p);
+//  assert(64                    == report.d_blockSize);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_SAMPLINGCOUNTDOWN
+#include <bdlma_samplingcountdown.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                       // ==============================
+                       // class SamplingGuardedAllocator
+                       // ==============================
+
+class SamplingGuardedAllocator : public bslma::Allocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'bslma::Allocator' protocol, and that satisfies a
+    // pseudo-random sample of the requests made of it from slots surrounded by
+    // read/write protected guard pages, forwarding all other requests to the
+    // allocator supplied at construction.  Memory errors involving a sampled
+    // block fault at the offending access, and can be attributed to the block
+    // by 'describeAddress' and by the process-wide handler installed by
+    // 'installFaultHandler'.
+
+  public:
+    // CONSTANTS
+    enum {
+        k_DEFAULT_SAMPLE_PERIOD    = 5000,  // default 'samplePeriod'
+        k_DEFAULT_NUM_SLOTS        =   16,  // default 'numSlots'
+        k_DEFAULT_MAX_GUARDED_SIZE = 4096,  // default 'maxGuardedSize'
+        k_MAX_STACK_DEPTH          =    8   // maximum number of return
+                                            // addresses recorded for the
+                                            // allocation (or deallocation)
+                                            // of a block
+    };
+
+    // TYPES
+    enum SampleMode {
+        // Enumerate the measures by which requests are sampled.
+
+        e_SAMPLE_BY_COUNT,  // sample one in 'samplePeriod' requests
+        e_SAMPLE_BY_BYTES   // sample one in 'samplePeriod' bytes requested
+    };
+
+    enum FaultType {
+        // Enumerate the memory errors that this allocator can attribute to a
+        // sampled block.
+
+        e_BUFFER_OVERFLOW,   // access past the end of a block
+        e_BUFFER_UNDERFLOW,  // access before the start of a block
+        e_USE_AFTER_FREE,    // access to a deallocated block
+        e_DOUBLE_FREE,       // deallocation of a deallocated block
+        e_INVALID_FREE       // deallocation of an address in the slot region
+                             // that was not returned by 'allocate'
+    };
+
+    struct FaultReport {
+        // This 'struct' describes a memory error attributed to a sampled
+        // block.
+
+        FaultType   d_type;                // kind of error
+        const void *d_faultAddress_p;      // address accessed or deallocated
+        const void *d_blockAddress_p;      // address of the block, or 0 if
+                                           // none could be attributed
+        size_type   d_blockSize;           // size (in bytes) of the block
+        const void *d_allocationSite_p;    // return address of the call to
+                                           // 'allocate', or 0 if unknown
+        const void *d_deallocationSite_p;  // return address of the call to
+                                           // 'deallocate', or 0 if the block
+                                           // is in use or the site is unknown
+
+        const void *d_allocationStack[k_MAX_STACK_DEPTH];
+                                           // return addresses of the calls
+                                           // active at allocation, starting
+                                           // with 'd_allocationSite_p'
+
+        int         d_allocationStackDepth;
+                                           // number of addresses in
+                                           // 'd_allocationStack'
+
+        const void *d_deallocationStack[k_MAX_STACK_DEPTH];
+                                           // return addresses of the calls
+                                           // active at deallocation, starting
+                                           // with 'd_deallocationSite_p'
+
+        int         d_deallocationStackDepth;
+                                           // number of addresses in
+                                           // 'd_deallocationStack'
+    };
+
+    typedef void (*FaultReporter)(const FaultReport& report);
+        // 'FaultReporter' is an alias for a function that is invoked with a
+        // description of a memory error.  Note that a reporter invoked by the
+        // fault handler runs in the context of a signal handler, and must
+        // therefore call only async-signal-safe functions.
+
+  private:
+    // PRIVATE TYPES
+    struct Slot;  // metadata of a slot (defined in the implementation)
+
+    // DATA
+    SamplingCountdown     d_countdown;       // bytes or requests to go until
+                                             // the next sample by each thread
+
+    SampleMode            d_sampleMode;      // measure by which requests are
+                                             // sampled
+
+    bsls::Types::Int64    d_samplePeriod;    // mean interval between samples
+
+    size_type             d_maxGuardedSize;  // largest request satisfied from
+                                             // a slot
+
+    int                   d_numSlots;        // number of slots
+
+    size_type             d_pageSize;        // size (in bytes) of a page
+
+    size_type             d_slotSize;        // size (in bytes) of the data
+                                             // pages of a slot
+
+    char                 *d_begin_p;         // start of the slot region, or
+                                             // 0 if it could not be mapped
+
+    char                 *d_end_p;           // end of the slot region
+
+    Slot                 *d_slots_p;         // metadata of each slot
+
+    int                  *d_freeQueue_p;     // circular queue of the indices
+                                             // of free slots
+
+    int                   d_freeHead;        // position of the next free
+                                             // slot in 'd_freeQueue_p'
+
+    int                   d_numFree;         // number of free slots
+
+    bool                  d_alignToEnd;      // if 'true', place the next
+                                             // sampled block at the end of its
+                                             // slot
+
+    bsls::Types::Uint64   d_randomState;     // state of the generator of
+                                             // sample intervals
+
+    bsls::Types::Int64    d_numSampled;      // number of sampled blocks
+                                             // allocated from slots
+
+    mutable bsls::BslLock d_lock;            // guards the slots
+
+    bslma::Allocator     *d_allocator_p;     // wrapped allocator (held, not
+                                             // owned)
+
+  private:
+    // PRIVATE MANIPULATORS
+    void *allocateSampled(size_type           size,
+                          bsls::Types::Int64  countdown,
+                          const void *const  *stack,
+                          int                 depth);
+        // Reset the countdown of the calling thread, whose value after
+        // deducting the weight of this request is the specified 'countdown',
+        // to the next sample, and return a block of the specified 'size' (in
+        // bytes) allocated from a free slot, recording the specified 'depth'
+        // return addresses at the specified 'stack' as its allocation stack,
+        // or from the wrapped allocator if no slot is free or
+        // 'size > maxGuardedSize()'.  If this is the first request of
+        // the calling thread, first add an interval to 'countdown', and
+        // forward the request to the wrapped allocator if the result is
+        // positive.  The behavior is undefined unless '0 >= countdown'.
+
+    char *allocateFromSlot(size_type          size,
+                           const void *const *stack,
+                           int                depth);
+        // Return a block of the specified 'size' (in bytes) allocated from a
+        // free slot, recording the specified 'depth' return addresses at the
+        // specified 'stack' as its allocation stack, or 0 if no slot is free,
+        // 'size > maxGuardedSize()', or the slot cannot be unprotected.  The
+        // behavior is undefined unless the internal lock is held by the
+        // calling thread.
+
+    void deallocateSampled(void              *address,
+                           const void *const *stack,
+                           int                depth);
+        // Protect the slot holding the block at the specified 'address',
+        // recording the specified 'depth' return addresses at the specified
+        // 'stack' as its deallocation stack, and append the slot to the queue
+        // of free slots.  Report an error and abort the
+        // program if 'address' is not the address of a block in use.  The
+        // behavior is undefined unless 'address' lies in the slot region.
+
+    void initialize();
+        // Map and protect the slot region, and allocate the slot metadata.  If
+        // the region cannot be mapped, leave this allocator forwarding every
+        // request to the wrapped allocator.
+
+    bsls::Types::Int64 nextInterval();
+        // Return a pseudo-random interval in '[1, 2 * samplePeriod() - 1]'.
+        // The behavior is undefined unless the internal lock is held by the
+        // calling thread.
+
+    // PRIVATE ACCESSORS
+    bool isSlotAddress(const void *address) const;
+        // Return 'true' if the specified 'address' lies in the slot region of
+        // this allocator, and 'false' otherwise.
+
+  private:
+    // NOT IMPLEMENTED
+    SamplingGuardedAllocator(const SamplingGuardedAllocator&);
+    SamplingGuardedAllocator& operator=(const SamplingGuardedAllocator&);
+
+  public:
+    // CLASS METHODS
+    static int installFaultHandler(FaultReporter reporter = 0);
+        // Install a process-wide handler for 'SIGSEGV' and 'SIGBUS' that
+        // reports the first memory fault attributed to a block sampled by any
+        // 'SamplingGuardedAllocator' by invoking the optionally specified
+        // 'reporter', and then passes the signal to the previously installed
+        // handler (see {Fault Reports}).  If 'reporter' is 0, 'printReport' is
+        // used.  If the handler is already installed, replace its reporter.
+        // In either case, a subsequent fault is reported even if one was
+        // reported before this call.  Return 0 on success, and a non-zero
+        // value otherwise.  The reporter is also invoked, subject to the same
+        // first-fault rule, when 'deallocate' detects an error.  The behavior
+        // is undefined if this method is called concurrently with itself or
+        // with 'uninstallFaultHandler'.  Note that this method always fails
+        // on platforms that do not support POSIX signals.
+
+    static void printReport(const FaultReport& report);
+        // Write a one-line description of the specified 'report', including
+        // its allocation and deallocation stacks, to the standard error stream
+        // using only async-signal-safe functions.
+
+    static void uninstallFaultHandler();
+        // Restore the handlers for 'SIGSEGV' and 'SIGBUS' that were installed
+        // when 'installFaultHandler' was first called, if the handler of this
+        // component is installed, and have no effect otherwise.  The behavior
+        // is undefined if this method is called concurrently with itself or
+        // with 'installFaultHandler'.
+
+    // CREATORS
+    explicit
+    SamplingGuardedAllocator(bslma::Allocator *basicAllocator = 0);
+        // Create a sampling guarded allocator that guards one in every
+        // 'k_DEFAULT_SAMPLE_PERIOD' requests of at most
+        // 'k_DEFAULT_MAX_GUARDED_SIZE' bytes using 'k_DEFAULT_NUM_SLOTS'
+        // slots.  Optionally specify a 'basicAllocator' to which unsampled
+        // requests are forwarded, and used to supply the slot metadata.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    SamplingGuardedAllocator(SampleMode          sampleMode,
+                             bsls::Types::Int64  samplePeriod,
+                             int                 numSlots,
+                             size_type           maxGuardedSize,
+                             bslma::Allocator   *basicAllocator = 0);
+        // Create a sampling guarded allocator that guards one in every
+        // specified 'samplePeriod' requests (or bytes requested) according to
+        // the specified 'sampleMode', using the specified 'numSlots' slots
+        // each able to hold a block of the specified 'maxGuardedSize' bytes.
+        // Optionally specify a 'basicAllocator' to which unsampled requests
+        // are forwarded, and used to supply the slot metadata.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 < samplePeriod',
+        // '0 < numSlots', and '0 < maxGuardedSize'.
+
+    virtual ~SamplingGuardedAllocator();
+        // Destroy this allocator object, unmapping its slot region.  The
+        // behavior is undefined unless every block allocated from this
+        // allocator has been deallocated.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated block of memory of the specified 'size' (in
+        // bytes), aligned appropriately for any object of that size.  If
+        // 'size' is 0, no memory is allocated and 0 is returned.  If this
+        // request is sampled (see {Sampling}), the block is allocated from a
+        // guarded slot if one is free and 'size <= maxGuardedSize()';
+        // otherwise, it is allocated from the wrapped allocator.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // allocator.  If 'address' is 0, this method has no effect.  If
+        // 'address' lies in the slot region, protect its slot for reuse;
+        // otherwise, deallocate it from the wrapped allocator.  If 'address'
+        // lies in the slot region but is not the address of a block in use,
+        // report the error and abort the program.  The behavior is undefined
+        // unless 'address' was returned by 'allocate' and has not already been
+        // deallocated.
+
+    // ACCESSORS
+    int describeAddress(FaultReport *result, const void *address) const;
+        // Load into the specified 'result' a description of the memory error
+        // that an access to the specified 'address' would be, if 'address'
+        // lies in the slot region of this allocator: an overflow or underflow
+        // of the nearest block in use if 'address' lies in a guard page, or a
+        // use-after-free if 'address' lies in a slot that is not in use.
+        // Return 0 on success, and a non-zero value (with no effect on
+        // 'result') if 'address' lies outside the slot region, lies in a block
+        // in use, or cannot be attributed to any block.  Note that this
+        // method does not acquire a lock, and may be called from a signal
+        // handler; 'result' is unspecified if a block in the same slot is
+        // concurrently allocated or deallocated.
+
+    size_type maxGuardedSize() const;
+        // Return the size (in bytes) of the largest request that this
+        // allocator satisfies from a guarded slot.
+
+    bsls::Types::Int64 numGuardedBlocks() const;
+        // Return the number of blocks currently allocated from guarded slots.
+
+    bsls::Types::Int64 numSampledAllocations() const;
+        // Return the number of blocks that have been allocated from guarded
+        // slots since this allocator was created.
+
+    int numSlots() const;
+        // Return the number of guarded slots of this allocator, or 0 if the
+        // slot region could not be mapped.
+
+    SampleMode sampleMode() const;
+        // Return the measure by which this allocator samples requests.
+
+    bsls::Types::Int64 samplePeriod() const;
+        // Return the mean number of requests, or bytes requested, between
+        // sampled requests.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                       // ------------------------------
+                       // class SamplingGuardedAllocator
+                       // ------------------------------
+
+// PRIVATE ACCESSORS
+inline
+bool SamplingGuardedAllocator::isSlotAddress(const void *address) const
+{
+    // Compare as integers, since 'address' need not point into the region.
+
+    return reinterpret_cast<bsls::Types::UintPtr>(address) -
+                         reinterpret_cast<bsls::Types::UintPtr>(d_begin_p)
+         < static_cast<bsls::Types::UintPtr>(d_end_p - d_begin_p);
+}
+
+// ACCESSORS
+inline
+bslma::Allocator::size_type SamplingGuardedAllocator::maxGuardedSize() const
+{
+    return d_maxGuardedSize;
+}
+
+inline
+int SamplingGuardedAllocator::numSlots() const
+{
+    return d_begin_p ? d_numSlots : 0;
+}
+
+inline
+SamplingGuardedAllocator::SampleMode
+SamplingGuardedAllocator::sampleMode() const
+{
+    return d_sampleMode;
+}
+
+inline
+bsls::Types::Int64 SamplingGuardedAllocator::samplePeriod() const
+{
+    return d_samplePeriod;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
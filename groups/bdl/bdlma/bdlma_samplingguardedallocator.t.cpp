@@ -0,0 +1,1287 @@
+// bdlma_samplingguardedallocator.t.cpp                               -*-C++-*-
+#include <bdlma_samplingguardedallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+#include <setjmp.h>
+#include <signal.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+  #include <windows.h>  // 'GetSystemInfo', 'CreateThread'
+#else
+  #include <pthread.h>
+  #include <sys/mman.h> // 'mmap', 'munmap'
+  #include <unistd.h>   // 'sysconf'
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::SamplingGuardedAllocator' forwards most requests to a wrapped
+// allocator, and satisfies a pseudo-random sample of them from slots
+// surrounded by protected guard pages.  We verify that the sampling rate
+// matches the configured period in both sampling modes, that requests that
+// cannot be guarded are forwarded, that sampled blocks are placed against
+// their guard pages and protected when deallocated, and that faulting
+// addresses are attributed to the correct block.  'sigsetjmp' and
+// 'siglongjmp' are used in conjunction with a signal handler to test that
+// guard pages and deallocated slots are protected, and to test the
+// process-wide fault handler installed by 'installFaultHandler'.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 6] static int installFaultHandler(FaultReporter reporter = 0);
+// [ 6] static void printReport(const FaultReport& report);
+// [ 6] static void uninstallFaultHandler();
+//
+// CREATORS
+// [ 2] SamplingGuardedAllocator(bslma::Allocator *ba = 0);
+// [ 2] SamplingGuardedAllocator(mode, period, numSlots, maxSize, ba = 0);
+// [ 2] ~SamplingGuardedAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 4] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 5] int describeAddress(FaultReport *result, const void *address) const;
+// [ 2] size_type maxGuardedSize() const;
+// [ 3] bsls::Types::Int64 numGuardedBlocks() const;
+// [ 3] bsls::Types::Int64 numSampledAllocations() const;
+// [ 2] int numSlots() const;
+// [ 2] SampleMode sampleMode() const;
+// [ 2] bsls::Types::Int64 samplePeriod() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 8] USAGE EXAMPLE
+// [ 3] CONCERN: The sampling rate matches the period in both modes.
+// [ 4] CONCERN: Guard pages and deallocated slots are protected.
+// [ 6] CONCERN: Only the first fault is reported, and others are chained.
+// [ 7] CONCERN: The 'allocate' and 'deallocate' methods are thread-safe.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::SamplingGuardedAllocator Obj;
+typedef bsls::Types::Int64              Int64;
+typedef bsls::Types::UintPtr            UintPtr;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef jmp_buf    JumpBuffer;
+#else
+typedef sigjmp_buf JumpBuffer;
+#endif
+
+static JumpBuffer g_jumpBuffer;
+static bool       g_withinTestFlag = false;  // see 'signalHandler' (below)
+
+static Obj::FaultReport g_report;            // last report received
+static int              g_numReports = 0;    // number of reports received
+static bool             g_reporterJumps = false;
+                                             // if 'true', 'testReporter'
+                                             // jumps to 'g_jumpBuffer'
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                   HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+extern "C" {
+
+void signalHandler(int signal)
+    // Handle the specified 'signal'.  Note that this signal handler is
+    // intended for 'SIGSEGV' and 'SIGBUS' only.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    ASSERT(SIGSEGV == signal);
+#else
+    ASSERT(SIGSEGV == signal || SIGBUS == signal);
+#endif
+
+    if (g_withinTestFlag) {
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        longjmp   (g_jumpBuffer, 1);
+#else
+        siglongjmp(g_jumpBuffer, 1);
+#endif
+    }
+    else {
+        ASSERT("Unexpected invocation of 'signalHandler'."  && 0);
+    }
+}
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+
+void signalInfoHandler(int signal, siginfo_t *, void *)
+    // Handle the specified 'signal' as 'signalHandler' does.  Note that this
+    // handler is installed with 'SA_SIGINFO', to verify that the fault
+    // handler of the component under test chains to such handlers.
+{
+    signalHandler(signal);
+}
+
+#endif
+
+}  // close extern "C"
+
+static
+bool causesMemoryFault(void *address, int offset, char value)
+    // Return 'true' if assigning the specified 'value' to the byte at the
+    // specified 'offset' from the specified 'address' causes a memory fault,
+    // and 'false' otherwise.
+{
+    volatile bool faultFlag = false;  // modified between 'setjmp' and a jump
+
+    // Register a signal handler for the duration of this function.
+
+    signal(SIGSEGV, signalHandler);
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+    signal(SIGBUS,  signalHandler);
+#endif
+
+    // Enable the signal handler's "long jump" capabilities.
+
+    g_withinTestFlag = true;
+
+    // Set the jump position.
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    const int rc = setjmp(g_jumpBuffer);
+#else
+    const int rc = sigsetjmp(g_jumpBuffer, 1);
+#endif
+
+    if (0 == rc) {
+        // Write 'value' to the desired location.  If there is a memory fault,
+        // then 'signalHandler' should be invoked.
+
+        *(static_cast<char *>(address) + offset) = value;
+    }
+    else if (1 == rc) {
+        // There was a long jump from 'signalHandler'.
+
+        faultFlag = true;
+    }
+    else {
+        ASSERT("Unexpected return value from 'setjmp' or 'sigsetjmp'."  && 0);
+    }
+
+    // Restore the default behavior for the signals.
+
+    signal(SIGSEGV, SIG_DFL);
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+    signal(SIGBUS,  SIG_DFL);
+#endif
+
+    // Disable the signal handler's "long jump" capabilities.
+
+    g_withinTestFlag = false;
+
+    return faultFlag;
+}
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+
+static
+bool causesHandledFault(void *address, int offset, char value)
+    // Return 'true' if assigning the specified 'value' to the byte at the
+    // specified 'offset' from the specified 'address' causes a memory fault
+    // that reaches 'signalInfoHandler', and 'false' otherwise.  Unlike
+    // 'causesMemoryFault', this function does not install any signal handler.
+{
+    volatile bool faultFlag = false;  // modified between 'setjmp' and a jump
+
+    g_withinTestFlag = true;
+
+    const int rc = sigsetjmp(g_jumpBuffer, 1);
+
+    if (0 == rc) {
+        *(static_cast<volatile char *>(address) + offset) = value;
+    }
+    else {
+        faultFlag = true;
+    }
+
+    g_withinTestFlag = false;
+
+    return faultFlag;
+}
+
+#endif
+
+static
+void testReporter(const Obj::FaultReport& report)
+    // Record the specified 'report' in 'g_report', and jump to 'g_jumpBuffer'
+    // if 'g_reporterJumps' is 'true'.
+{
+    g_report = report;
+    ++g_numReports;
+
+    if (g_reporterJumps) {
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        longjmp   (g_jumpBuffer, 1);
+#else
+        siglongjmp(g_jumpBuffer, 1);
+#endif
+    }
+}
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+namespace TestCase7 {
+
+struct ThreadInfo {
+    int  d_numIterations;
+    int  d_seed;
+    Obj *d_obj_p;
+};
+
+extern "C" void *threadFunction(void *arg)
+{
+    ThreadInfo *info = (ThreadInfo *)arg;
+
+    Obj& mX = *info->d_obj_p;
+
+    enum { k_NUM_HELD = 8 };
+
+    void     *held[k_NUM_HELD]  = { 0 };
+    int       sizes[k_NUM_HELD] = { 0 };
+    unsigned  seed              = info->d_seed;
+
+    for (int i = 0; i < info->d_numIterations; ++i) {
+        seed = seed * 1103515245 + 12345;
+
+        const int j = (seed >> 16) % k_NUM_HELD;
+
+        if (held[j]) {
+            for (int k = 0; k < sizes[j]; ++k) {
+                ASSERTV(j, k, static_cast<char>(j) ==
+                                             static_cast<char *>(held[j])[k]);
+            }
+            mX.deallocate(held[j]);
+        }
+
+        sizes[j] = 1 + (seed >> 8) % 200;
+        held[j]  = mX.allocate(sizes[j]);
+        bsl::memset(held[j], j, sizes[j]);
+    }
+
+    for (int j = 0; j < k_NUM_HELD; ++j) {
+        mX.deallocate(held[j]);
+    }
+
+    return arg;
+}
+
+}  // close namespace TestCase7
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const int pageSize = static_cast<int>(info.dwPageSize);
+#else
+    const int pageSize = static_cast<int>(sysconf(_SC_PAGESIZE));
+#endif
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator         defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Catching a Use-After-Free in Production
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service occasionally crashes with a corrupted heap, and that
+// the bug cannot be reproduced under a debugging tool.  We run the service
+// with a sampling guarded allocator in place of its usual allocator, so that
+// a memory error in a sampled block is caught at the faulting access.
+//
+// First, at startup, we install the fault handler, so that the first memory
+// error detected is reported with the allocation site of the block involved:
+//..
+        bdlma::SamplingGuardedAllocator::installFaultHandler();
+//..
+// Then, we create an allocator that guards one in every 1000 allocations and
+// wraps the default allocator:
+//..
+        typedef bdlma::SamplingGuardedAllocator SGA;
+
+        SGA allocator(SGA::e_SAMPLE_BY_COUNT, 1000, 16, 4096);
+//..
+// Now, we use the allocator as we would any other.  Most requests are
+// forwarded to the default allocator; about one in 1000 is sampled:
+//..
+        for (int i = 0; i < 100000; ++i) {
+            void *p = allocator.allocate(64);
+            allocator.deallocate(p);
+        }
+
+        ASSERT(0 < allocator.numSampledAllocations());
+        ASSERT(0 == allocator.numGuardedBlocks());
+//..
+// Finally, we observe that a guarded block, once deallocated, is recognized as
+// such, so that a subsequent access to it would be reported as a
+// use-after-free:
+//..
+        void *block = 0;
+        while (!block) {
+            void *p = allocator.allocate(64);
+            if (1 == allocator.numGuardedBlocks()) {
+                block = p;
+            }
+            allocator.deallocate(p);
+        }
+
+        SGA::FaultReport report;
+        ASSERT(0                     == allocator.describeAddress(&report,
+                                                                  block));
+        ASSERT(SGA::e_USE_AFTER_FREE == report.d_type);
+        ASSERT(block                 == report.d_blockAddress_p);
+        ASSERT(64                    == report.d_blockSize);
+//..
+
+        SGA::uninstallFaultHandler();
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 The 'allocate' and 'deallocate' methods are thread-safe, and
+        //:   sampled and unsampled blocks are never shared between threads.
+        //
+        // Plan:
+        //: 1 Create an allocator that samples one in three requests using
+        //:   fewer slots than there are blocks held, and have several
+        //:   threads concurrently allocate, fill, verify, and deallocate
+        //:   blocks of varying sizes.  Verify that no block is corrupted, and
+        //:   that all memory is returned.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: The 'allocate' and 'deallocate' methods are thread-safe.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY TEST" << endl
+                          << "================" << endl;
+
+        using namespace TestCase7;
+
+        enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 20000 };
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 3, 8, 256, &ta);
+
+            ThreadInfo info[k_NUM_THREADS];
+            ThreadId   ids[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                info[i].d_numIterations = k_NUM_ITERATIONS;
+                info[i].d_seed          = i + 1;
+                info[i].d_obj_p         = &mX;
+
+                ids[i] = createThread(&threadFunction, &info[i]);
+            }
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            ASSERT(0 == mX.numGuardedBlocks());
+            ASSERT(0 <  mX.numSampledAllocations());
+            ASSERT(1 == ta.numBlocksInUse());
+
+            if (veryVerbose) {
+                P(mX.numSampledAllocations());
+            }
+        }
+
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // FAULT HANDLER
+        //
+        // Concerns:
+        //: 1 'installFaultHandler' installs a handler that reports a fault in
+        //:   a guarded slot with the description given by 'describeAddress'.
+        //:
+        //: 2 Only the first fault is reported, until the handler is installed
+        //:   again.
+        //:
+        //: 3 Every fault is passed to the previously installed handler,
+        //:   including faults that are not in any slot region.
+        //:
+        //: 4 A double free, or a free of an address in the slot region that
+        //:   was not allocated, is reported (before the program is aborted).
+        //:
+        //: 5 'uninstallFaultHandler' restores the previous handlers.
+        //:
+        //: 6 'printReport' can be invoked with any report.
+        //
+        // Plan:
+        //: 1 Install a 'SA_SIGINFO' handler that jumps back into the test,
+        //:   then install the fault handler with a reporter that records its
+        //:   report.  Write past the end of a sampled block and verify the
+        //:   recorded report.  (C-1, 3)
+        //:
+        //: 2 Cause a second fault and verify that it is not reported; then
+        //:   install the handler again and verify that a third fault is.
+        //:   (C-2)
+        //:
+        //: 3 Write to a protected page that was not mapped by the allocator,
+        //:   and verify that the fault reaches the previous handler without
+        //:   being reported.  (C-3)
+        //:
+        //: 4 Have the reporter jump back into the test, deallocate a block
+        //:   twice and an address inside a block, and verify the reports.
+        //:   (C-4)
+        //:
+        //: 5 Uninstall the handler and verify that the previous handler is
+        //:   installed.  (C-5)
+        //:
+        //: 6 Invoke 'printReport' with reports with and without a block.
+        //:   (C-6)
+        //
+        // Testing:
+        //   static int installFaultHandler(FaultReporter reporter = 0);
+        //   static void printReport(const FaultReport& report);
+        //   static void uninstallFaultHandler();
+        //   CONCERN: Only the first fault is reported, and others are chained.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "FAULT HANDLER" << endl
+                          << "=============" << endl;
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+        struct sigaction action, previousSegv, previousBus, current;
+        bsl::memset(&action, 0, sizeof action);
+        action.sa_sigaction = &signalInfoHandler;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_SIGINFO;
+
+        ASSERT(0 == sigaction(SIGSEGV, &action, &previousSegv));
+        ASSERT(0 == sigaction(SIGBUS,  &action, &previousBus));
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 1, 4, 64, &ta);
+
+            if (verbose) cout << "\tReport the first fault." << endl;
+
+            ASSERT(0 == Obj::installFaultHandler(&testReporter));
+
+            g_numReports = 0;
+
+            char *p = static_cast<char *>(mX.allocate(16));
+
+            ASSERT(causesHandledFault(p, 16, 'x'));
+            ASSERT(1                      == g_numReports);
+            ASSERT(Obj::e_BUFFER_OVERFLOW == g_report.d_type);
+            ASSERT(p + 16                 == g_report.d_faultAddress_p);
+            ASSERT(p                      == g_report.d_blockAddress_p);
+            ASSERT(16                     == g_report.d_blockSize);
+
+            if (verbose) cout << "\tDo not report later faults." << endl;
+
+            ASSERT(causesHandledFault(p, 17, 'x'));
+            ASSERT(1 == g_numReports);
+
+            ASSERT(0 == Obj::installFaultHandler(&testReporter));
+
+            mX.deallocate(p);
+
+            ASSERT(causesHandledFault(p, 0, 'x'));
+            ASSERT(2                     == g_numReports);
+            ASSERT(Obj::e_USE_AFTER_FREE == g_report.d_type);
+            ASSERT(p                     == g_report.d_blockAddress_p);
+
+            if (verbose) cout << "\tChain unattributed faults." << endl;
+
+            ASSERT(0 == Obj::installFaultHandler(&testReporter));
+
+            char *page = static_cast<char *>(mmap(0,
+                                                  pageSize,
+                                                  PROT_NONE,
+                                                  MAP_ANON | MAP_PRIVATE,
+                                                  -1,
+                                                  0));
+            ASSERT(MAP_FAILED != static_cast<void *>(page));
+
+            ASSERT(causesHandledFault(page, 0, 'x'));
+            ASSERT(2 == g_numReports);
+
+            munmap(page, pageSize);
+
+            if (verbose) cout << "\tReport invalid deallocations." << endl;
+
+            g_reporterJumps = true;
+
+            char *q = static_cast<char *>(mX.allocate(8));
+            mX.deallocate(q);
+
+            g_withinTestFlag = true;
+            if (0 == sigsetjmp(g_jumpBuffer, 1)) {
+                mX.deallocate(q);
+                ASSERT("Double free not reported." && 0);
+            }
+            g_withinTestFlag = false;
+
+            ASSERT(3                  == g_numReports);
+            ASSERT(Obj::e_DOUBLE_FREE == g_report.d_type);
+            ASSERT(q                  == g_report.d_blockAddress_p);
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+            ASSERT(0                  != g_report.d_deallocationSite_p);
+#endif
+
+            ASSERT(0 == Obj::installFaultHandler(&testReporter));
+
+            char *r = static_cast<char *>(mX.allocate(8));
+
+            g_withinTestFlag = true;
+            if (0 == sigsetjmp(g_jumpBuffer, 1)) {
+                mX.deallocate(r + 1);
+                ASSERT("Invalid free not reported." && 0);
+            }
+            g_withinTestFlag = false;
+
+            ASSERT(4                   == g_numReports);
+            ASSERT(Obj::e_INVALID_FREE == g_report.d_type);
+            ASSERT(r + 1               == g_report.d_faultAddress_p);
+            ASSERT(r                   == g_report.d_blockAddress_p);
+
+            mX.deallocate(r);
+
+            g_reporterJumps = false;
+
+            if (verbose) cout << "\tUninstall the handler." << endl;
+
+            Obj::uninstallFaultHandler();
+
+            ASSERT(0 == sigaction(SIGSEGV, 0, &current));
+            ASSERT(&signalInfoHandler == current.sa_sigaction);
+            ASSERT(0 == sigaction(SIGBUS, 0, &current));
+            ASSERT(&signalInfoHandler == current.sa_sigaction);
+
+            Obj::uninstallFaultHandler();
+
+            if (verbose) cout << "\tPrint reports." << endl;
+
+            if (veryVerbose) {
+                Obj::FaultReport report;
+                ASSERT(0 == mX.describeAddress(&report, p));
+                Obj::printReport(report);
+
+                report.d_blockAddress_p     = 0;
+                report.d_deallocationSite_p = 0;
+                Obj::printReport(report);
+            }
+        }
+
+        ASSERT(0 == sigaction(SIGSEGV, &previousSegv, 0));
+        ASSERT(0 == sigaction(SIGBUS,  &previousBus,  0));
+
+        ASSERT(0 == ta.numBlocksInUse());
+#else
+        ASSERT(0 != Obj::installFaultHandler());
+#endif
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // DESCRIBE ADDRESS
+        //
+        // Concerns:
+        //: 1 An address in the guard page following (preceding) a block in
+        //:   use is described as an overflow (underflow) of that block.
+        //:
+        //: 2 An address in a slot outside a block in use is described as an
+        //:   overflow or underflow of the block.
+        //:
+        //: 3 An address in a deallocated block is described as a
+        //:   use-after-free, with its deallocation site.
+        //:
+        //: 4 A guard page between two slots is attributed to the nearer
+        //:   block, preferring a block in use to a deallocated one.
+        //:
+        //: 5 Addresses in a block in use, in an unused slot, or outside the
+        //:   slot region are not described, and 'result' is unchanged.
+        //:
+        //: 6 The description includes the call stack that allocated (and
+        //:   deallocated) the block, starting with the allocation
+        //:   (deallocation) site, and extending beyond the immediate caller
+        //:   where the call stack can be walked.
+        //
+        // Plan:
+        //: 1 Using an allocator that samples every request, allocate blocks
+        //:   against each guard page, and verify the description of
+        //:   addresses around them.  (C-1..6)
+        //
+        // Testing:
+        //   int describeAddress(FaultReport *result, const void *addr) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DESCRIBE ADDRESS" << endl
+                          << "================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        Obj mX(Obj::e_SAMPLE_BY_COUNT, 1, 4, pageSize, &ta);
+        const Obj& X = mX;
+
+        ASSERT(4 == X.numSlots());
+
+        // The first block is placed at the end of slot 0, and the second at
+        // the start of slot 1.
+
+        char *p = static_cast<char *>(mX.allocate(100));
+        char *q = static_cast<char *>(mX.allocate(100));
+
+        ASSERT(0 == (reinterpret_cast<UintPtr>(p) + 100) % pageSize);
+        ASSERT(0 == reinterpret_cast<UintPtr>(q) % pageSize);
+        ASSERT(q == p + 100 + pageSize);
+
+        Obj::FaultReport report;
+
+        if (verbose) cout << "\tOverflow and underflow." << endl;
+
+        ASSERT(0                      == X.describeAddress(&report, p + 100));
+        ASSERT(Obj::e_BUFFER_OVERFLOW == report.d_type);
+        ASSERT(p + 100                == report.d_faultAddress_p);
+        ASSERT(p                      == report.d_blockAddress_p);
+        ASSERT(100                    == report.d_blockSize);
+        ASSERT(0                      == report.d_deallocationSite_p);
+        ASSERT(0                      == report.d_deallocationStackDepth);
+        ASSERT(report.d_allocationStackDepth <= Obj::k_MAX_STACK_DEPTH);
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+        ASSERT(0                      != report.d_allocationSite_p);
+        ASSERT(1                      <= report.d_allocationStackDepth);
+        ASSERT(report.d_allocationSite_p == report.d_allocationStack[0]);
+#endif
+#if defined(BSLS_PLATFORM_OS_LINUX) || defined(BSLS_PLATFORM_OS_DARWIN)
+        // The stack extends beyond 'main' into the code that called it.
+
+        ASSERTV(report.d_allocationStackDepth,
+                2 <= report.d_allocationStackDepth);
+#endif
+
+        ASSERT(0                       == X.describeAddress(&report, q - 1));
+        ASSERT(Obj::e_BUFFER_UNDERFLOW == report.d_type);
+        ASSERT(q                       == report.d_blockAddress_p);
+
+        ASSERT(0                       == X.describeAddress(&report, p - 1));
+        ASSERT(Obj::e_BUFFER_UNDERFLOW == report.d_type);
+        ASSERT(p                       == report.d_blockAddress_p);
+
+        ASSERT(0                      == X.describeAddress(&report, q + 100));
+        ASSERT(Obj::e_BUFFER_OVERFLOW == report.d_type);
+        ASSERT(q                      == report.d_blockAddress_p);
+
+        if (verbose) cout << "\tGuard page between two blocks." << endl;
+
+        // The guard page between slots 0 and 1 spans '[p + 100, q)'.
+
+        ASSERT(0                       == X.describeAddress(&report,
+                                                            p + 100 + 10));
+        ASSERT(Obj::e_BUFFER_OVERFLOW  == report.d_type);
+        ASSERT(p                       == report.d_blockAddress_p);
+
+        ASSERT(0                       == X.describeAddress(&report, q - 10));
+        ASSERT(Obj::e_BUFFER_UNDERFLOW == report.d_type);
+        ASSERT(q                       == report.d_blockAddress_p);
+
+        if (verbose) cout << "\tUse after free." << endl;
+
+        mX.deallocate(p);
+
+        ASSERT(0                     == X.describeAddress(&report, p + 50));
+        ASSERT(Obj::e_USE_AFTER_FREE == report.d_type);
+        ASSERT(p                     == report.d_blockAddress_p);
+        ASSERT(100                   == report.d_blockSize);
+        ASSERT(report.d_deallocationStackDepth <= Obj::k_MAX_STACK_DEPTH);
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+        ASSERT(0                     != report.d_deallocationSite_p);
+        ASSERT(1                     <= report.d_deallocationStackDepth);
+        ASSERT(report.d_deallocationSite_p == report.d_deallocationStack[0]);
+#endif
+#if defined(BSLS_PLATFORM_OS_LINUX) || defined(BSLS_PLATFORM_OS_DARWIN)
+        ASSERTV(report.d_deallocationStackDepth,
+                2 <= report.d_deallocationStackDepth);
+#endif
+
+        // A block in use is preferred to a nearer deallocated block.
+
+        ASSERT(0                       == X.describeAddress(&report,
+                                                            p + 100 + 10));
+        ASSERT(Obj::e_BUFFER_UNDERFLOW == report.d_type);
+        ASSERT(q                       == report.d_blockAddress_p);
+
+        if (verbose) cout << "\tUndescribed addresses." << endl;
+
+        report.d_blockSize = 12345;
+
+        ASSERT(0 != X.describeAddress(&report, q + 3 * pageSize - 1));
+                                                          // in unused slot 2
+        ASSERT(0 != X.describeAddress(&report, q));
+        ASSERT(0 != X.describeAddress(&report, q + 99));
+        ASSERT(0 != X.describeAddress(&report, &report));
+        ASSERT(0 != X.describeAddress(&report, 0));
+        ASSERT(12345 == report.d_blockSize);
+
+        mX.deallocate(q);
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // GUARDED SLOTS
+        //
+        // Concerns:
+        //: 1 Sampled blocks alternately end immediately before the guard page
+        //:   following their slot and start immediately after the guard page
+        //:   preceding it, and the guard pages are protected.
+        //:
+        //: 2 A block placed at the end of its slot is aligned only as its
+        //:   size requires, so that even a one-byte overflow faults.
+        //:
+        //: 3 A deallocated block is protected.
+        //:
+        //: 4 Deallocated slots are reused in first-in, first-out order.
+        //:
+        //: 5 Unsampled blocks are deallocated to the wrapped allocator.
+        //
+        // Plan:
+        //: 1 Using an allocator that samples every request, allocate blocks
+        //:   of various sizes, write every byte of each block, and verify
+        //:   that the bytes adjacent to the guard pages fault.  (C-1..2)
+        //:
+        //: 2 Deallocate a block and verify that its bytes fault.  (C-3)
+        //:
+        //: 3 Allocate and deallocate repeatedly and verify that every slot
+        //:   is used in turn.  (C-4)
+        //:
+        //: 4 Deallocate a block allocated after the slots are exhausted, and
+        //:   verify that it is returned to the wrapped allocator.  (C-5)
+        //
+        // Testing:
+        //   void deallocate(void *address);
+        //   CONCERN: Guard pages and deallocated slots are protected.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "GUARDED SLOTS" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\tBlocks against guard pages." << endl;
+        {
+            const int SIZES[] = { 1, 7, 13, 16, 24, 100, 1000 };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 1, 2, 1000, &ta);
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                const int SIZE = SIZES[i];
+
+                char *p = static_cast<char *>(mX.allocate(SIZE));
+                char *q = static_cast<char *>(mX.allocate(SIZE));
+
+                ASSERTV(SIZE, 0 == (reinterpret_cast<UintPtr>(p) + SIZE)
+                                                                   % pageSize);
+                ASSERTV(SIZE, 0 == reinterpret_cast<UintPtr>(q) % pageSize);
+
+                bsl::memset(p, 0xff, SIZE);
+                bsl::memset(q, 0xff, SIZE);
+
+                ASSERTV(SIZE, causesMemoryFault(p, SIZE, 'x'));
+                ASSERTV(SIZE, causesMemoryFault(q, -1, 'x'));
+                ASSERTV(SIZE, !causesMemoryFault(p, SIZE - 1, 'x'));
+                ASSERTV(SIZE, !causesMemoryFault(q, 0, 'x'));
+
+                mX.deallocate(p);
+                mX.deallocate(q);
+
+                ASSERTV(SIZE, causesMemoryFault(p, 0, 'x'));
+                ASSERTV(SIZE, causesMemoryFault(q, SIZE - 1, 'x'));
+            }
+            ASSERT(1 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\tFirst-in, first-out reuse." << endl;
+        {
+            enum { k_NUM_SLOTS = 4 };
+
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 1, k_NUM_SLOTS, 64, &ta);
+
+            UintPtr pages[2 * k_NUM_SLOTS];
+
+            for (int i = 0; i < 2 * k_NUM_SLOTS; ++i) {
+                void *p  = mX.allocate(64);
+                pages[i] = reinterpret_cast<UintPtr>(p) / pageSize;
+                mX.deallocate(p);
+            }
+
+            for (int i = 0; i < k_NUM_SLOTS; ++i) {
+                for (int j = 0; j < i; ++j) {
+                    ASSERTV(i, j, pages[i] != pages[j]);
+                }
+                ASSERTV(i, pages[i] == pages[i + k_NUM_SLOTS]);
+            }
+        }
+
+        if (verbose) cout << "\tUnsampled deallocation." << endl;
+        {
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 1, 1, 64, &ta);
+
+            void *p = mX.allocate(8);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            void *q = mX.allocate(8);
+            ASSERT(2 == ta.numBlocksInUse());
+
+            mX.deallocate(q);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            mX.deallocate(p);
+            ASSERT(1 == ta.numBlocksInUse());
+
+            mX.deallocate(0);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // SAMPLING
+        //
+        // Concerns:
+        //: 1 In 'e_SAMPLE_BY_COUNT' mode, about one in 'samplePeriod'
+        //:   requests is sampled; a period of 1 samples every request.
+        //:
+        //: 2 In 'e_SAMPLE_BY_BYTES' mode, about one in 'samplePeriod' bytes
+        //:   requested is sampled.
+        //:
+        //: 3 Sampled requests for more than 'maxGuardedSize' bytes, and
+        //:   sampled requests made when every slot is in use, are forwarded
+        //:   to the wrapped allocator.
+        //:
+        //: 4 Requests of 0 bytes return 0 and are not counted.
+        //:
+        //: 5 'numGuardedBlocks' and 'numSampledAllocations' track the blocks
+        //:   allocated from slots.
+        //
+        // Plan:
+        //: 1 Make many requests with various periods in both modes, and
+        //:   verify that the number of samples is within a few standard
+        //:   deviations of the expected number.  (C-1..2, 5)
+        //:
+        //: 2 Sample every request, and exceed the maximum guarded size and
+        //:   the number of slots; verify where each block is allocated.
+        //:   (C-3..5)
+        //:
+        //: 3 Request 0 bytes and verify that no sample is taken.  (C-4)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   bsls::Types::Int64 numGuardedBlocks() const;
+        //   bsls::Types::Int64 numSampledAllocations() const;
+        //   CONCERN: The sampling rate matches the period in both modes.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SAMPLING" << endl
+                          << "========" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\tSampling rate." << endl;
+        {
+            static const struct {
+                int             d_line;
+                Obj::SampleMode d_mode;
+                int             d_period;
+                int             d_size;
+                int             d_numRequests;
+            } DATA[] = {
+                //LINE  MODE                    PERIOD  SIZE  REQUESTS
+                //----  ----------------------  ------  ----  --------
+                { L_,   Obj::e_SAMPLE_BY_COUNT,      1,   32,      100 },
+                { L_,   Obj::e_SAMPLE_BY_COUNT,     10,   32,    20000 },
+                { L_,   Obj::e_SAMPLE_BY_COUNT,    100,   32,   200000 },
+                { L_,   Obj::e_SAMPLE_BY_BYTES,    256,   32,   160000 },
+                { L_,   Obj::e_SAMPLE_BY_BYTES,   1024,   32,    64000 },
+                { L_,   Obj::e_SAMPLE_BY_BYTES,   4096,  200,   200000 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int             LINE     = DATA[ti].d_line;
+                const Obj::SampleMode MODE     = DATA[ti].d_mode;
+                const int             PERIOD   = DATA[ti].d_period;
+                const int             SIZE     = DATA[ti].d_size;
+                const int             REQUESTS = DATA[ti].d_numRequests;
+
+                Obj mX(MODE, PERIOD, 4, 256, &ta);  const Obj& X = mX;
+
+                for (int i = 0; i < REQUESTS; ++i) {
+                    void *p = mX.allocate(SIZE);
+                    mX.deallocate(p);
+                }
+
+                const Int64 WEIGHT   = Obj::e_SAMPLE_BY_COUNT == MODE
+                                     ? 1
+                                     : SIZE;
+                const Int64 EXPECTED = REQUESTS * WEIGHT / PERIOD;
+                const Int64 ACTUAL   = X.numSampledAllocations();
+
+                if (veryVerbose) { P_(LINE) P_(EXPECTED) P(ACTUAL) }
+
+                if (1 == PERIOD) {
+                    ASSERTV(LINE, ACTUAL, EXPECTED == ACTUAL);
+                }
+                else {
+                    ASSERTV(LINE, ACTUAL, EXPECTED * 9 / 10 <= ACTUAL);
+                    ASSERTV(LINE, ACTUAL, EXPECTED * 11 / 10 >= ACTUAL);
+                }
+                ASSERTV(LINE, 0 == X.numGuardedBlocks());
+            }
+        }
+
+        if (verbose) cout << "\tForwarded requests." << endl;
+        {
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 1, 2, 64, &ta);
+            const Obj& X = mX;
+
+            const Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+            void *p = mX.allocate(65);
+            ASSERT(NUM_BLOCKS + 1 == ta.numBlocksInUse());
+            ASSERT(0              == X.numSampledAllocations());
+
+            void *q = mX.allocate(64);
+            void *r = mX.allocate(1);
+            ASSERT(NUM_BLOCKS + 1 == ta.numBlocksInUse());
+            ASSERT(2              == X.numSampledAllocations());
+            ASSERT(2              == X.numGuardedBlocks());
+
+            void *s = mX.allocate(1);
+            ASSERT(NUM_BLOCKS + 2 == ta.numBlocksInUse());
+            ASSERT(2              == X.numSampledAllocations());
+
+            mX.deallocate(q);
+            ASSERT(1              == X.numGuardedBlocks());
+
+            void *t = mX.allocate(1);
+            ASSERT(NUM_BLOCKS + 2 == ta.numBlocksInUse());
+            ASSERT(3              == X.numSampledAllocations());
+            ASSERT(2              == X.numGuardedBlocks());
+
+            mX.deallocate(p);
+            mX.deallocate(r);
+            mX.deallocate(s);
+            mX.deallocate(t);
+            ASSERT(NUM_BLOCKS     == ta.numBlocksInUse());
+            ASSERT(0              == X.numGuardedBlocks());
+            ASSERT(3              == X.numSampledAllocations());
+        }
+
+        if (verbose) cout << "\tZero-sized requests." << endl;
+        {
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 1, 2, 64, &ta);
+            const Obj& X = mX;
+
+            ASSERT(0 == mX.allocate(0));
+            ASSERT(0 == X.numSampledAllocations());
+            ASSERT(0 == X.numGuardedBlocks());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 The default constructor uses the documented defaults.
+        //:
+        //: 2 The value constructor uses the supplied configuration.
+        //:
+        //: 3 Slot metadata is allocated from the supplied allocator, or the
+        //:   default allocator if none is supplied, and released at
+        //:   destruction.
+        //:
+        //: 4 The slot region is page-aligned and unmapped at destruction.
+        //
+        // Plan:
+        //: 1 Create objects with each constructor and verify the accessors
+        //:   and the allocators used.  (C-1..3)
+        //:
+        //: 2 Verify that the first sampled block lies on a page boundary
+        //:   plus its size.  (C-4)
+        //
+        // Testing:
+        //   SamplingGuardedAllocator(bslma::Allocator *ba = 0);
+        //   SamplingGuardedAllocator(mode, period, numSlots, maxSize, ba = 0);
+        //   ~SamplingGuardedAllocator();
+        //   size_type maxGuardedSize() const;
+        //   int numSlots() const;
+        //   SampleMode sampleMode() const;
+        //   bsls::Types::Int64 samplePeriod() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND ACCESSORS" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(Obj::e_SAMPLE_BY_COUNT          == X.sampleMode());
+            ASSERT(Obj::k_DEFAULT_SAMPLE_PERIOD    == X.samplePeriod());
+            ASSERT(Obj::k_DEFAULT_NUM_SLOTS        == X.numSlots());
+            ASSERT(Obj::k_DEFAULT_MAX_GUARDED_SIZE == X.maxGuardedSize());
+            ASSERT(0 == X.numGuardedBlocks());
+            ASSERT(0 == X.numSampledAllocations());
+            ASSERT(1 == defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(Obj::k_DEFAULT_NUM_SLOTS == X.numSlots());
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        {
+            Obj mX(Obj::e_SAMPLE_BY_BYTES, 12345, 3, 3 * pageSize + 1, &ta);
+            const Obj& X = mX;
+
+            ASSERT(Obj::e_SAMPLE_BY_BYTES == X.sampleMode());
+            ASSERT(12345                  == X.samplePeriod());
+            ASSERT(3                      == X.numSlots());
+            ASSERT(3 * pageSize + 1       == (int)X.maxGuardedSize());
+            ASSERT(1                      == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        {
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 1, 1, 10, &ta);
+
+            void *p = mX.allocate(10);
+
+            ASSERT(0 == (reinterpret_cast<UintPtr>(p) + 10) % pageSize);
+
+            mX.deallocate(p);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate sampled and unsampled blocks.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        {
+            Obj mX(Obj::e_SAMPLE_BY_COUNT, 2, 4, 128, &ta);
+            const Obj& X = mX;
+
+            void *blocks[10];
+            for (int i = 0; i < 10; ++i) {
+                blocks[i] = mX.allocate(16 * (i + 1));
+                bsl::memset(blocks[i], i, 16 * (i + 1));
+            }
+
+            ASSERT(0 < X.numSampledAllocations());
+            ASSERT(X.numSampledAllocations() == X.numGuardedBlocks());
+            ASSERT(10 - X.numGuardedBlocks() + 1 == ta.numBlocksInUse());
+
+            for (int i = 0; i < 10; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            ASSERT(0 == X.numGuardedBlocks());
+            ASSERT(1 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
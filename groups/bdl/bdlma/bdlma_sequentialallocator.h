@@ -12,7 +12,8 @@ BSLS_IDENT("$Id: $")
 //@CLASSES:
 //   bdlma::SequentialAllocator: managed allocator using dynamic buffers
 //
-//@SEE_ALSO: bdlma_infrequentdeleteblocklist, bdlma_sequentialpool
+//@SEE_ALSO: bdlma_infrequentdeleteblocklist, bdlma_sequentialpool,
+//           bdlma_checkpoint
 //
 //@DESCRIPTION: This component provides a concrete mechanism,
 // 'bdlma::SequentialAllocator', that implements the 'bdlma::ManagedAllocator'
@@ -90,6 +91,24 @@ BSLS_IDENT("$Id: $")
 // 'alignmentStrategy' is not specified, natural alignment is used.  See
 // 'bsls_alignment' for more details.
 //
+///Checkpoints
+///-----------
+// The 'checkpoint' method returns a 'bdlma::Checkpoint' recording the current
+// allocation state of the allocator, and the 'rewind' method restores the
+// allocator to a previously recorded state, making all memory allocated since
+// available for reuse.  A 'bdlma::CheckpointGuard' can be used to rewind the
+// allocator at the end of a scope, discarding the memory allocated by, e.g., a
+// failed speculative parse.  See 'bdlma_checkpoint' for details.
+//
+///Retaining Memory on Release
+///---------------------------
+// The 'setRetainOnRelease' method configures 'release' to keep the largest
+// block of memory obtained from the allocator supplied at construction (and,
+// optionally, further blocks up to a byte budget) for reuse, rather than
+// deallocating it, so that an allocator released after each of a sequence of
+// similar tasks stops allocating from that allocator once it reaches a steady
+// state.
+//
 ///Usage
 ///-----
 // Allocators are often supplied, at construction, to objects requiring
@@ -202,6 +221,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlscm_version.h>
 #endif
 
+#ifndef INCLUDED_BDLMA_CHECKPOINT
+#include <bdlma_checkpoint.h>
+#endif
+
 #ifndef INCLUDED_BDLMA_MANAGEDALLOCATOR
 #include <bdlma_managedallocator.h>
 #endif
@@ -357,6 +380,14 @@ class SequentialAllocator : public ManagedAllocator {
         // supplied at construction to allocate a new internal buffer, then
         // allocate memory from the new buffer.
 
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return the address of a contiguous block of memory of the specified
+        // 'size' (in bytes) aligned to the specified 'alignment', which may
+        // exceed the maximal alignment of the platform.  If 'size' is 0, no
+        // memory is allocated and 0 is returned.  Only the bytes needed to
+        // reach the next suitably aligned address are skipped.  The behavior
+        // is undefined unless 'alignment' is a positive power of two.
+
     void *allocateAndExpand(size_type *size);
         // Return the address of a contiguous block of memory of at least the
         // specified '*size' (in bytes), and load the actual amount of memory
@@ -372,11 +403,22 @@ class SequentialAllocator : public ManagedAllocator {
         // behavior is undefined unless 'address' is 0, or was allocated by
         // this allocator and has not already been deallocated.
 
+    virtual void deallocateSized(void *address, size_type size);
+        // This method has no effect on the memory block at the specified
+        // 'address' of the specified 'size' as all memory allocated by this
+        // allocator is managed.  Note that this override lets a caller that
+        // binds statically to this type (e.g., 'bdlma::BoundAllocator')
+        // return memory without a call through the virtual table.  The
+        // behavior is undefined unless 'address' is 0, or was allocated by
+        // this allocator and has not already been deallocated.
+
     virtual void release();
         // Release all memory allocated through this allocator.  The allocator
         // is reset to its default constructed state, retaining the alignment
         // and growth strategy supplied at construction (if any) after this
-        // call.
+        // call.  If retention was enabled by 'setRetainOnRelease', some of the
+        // memory obtained from the allocator supplied at construction is kept
+        // for reuse by subsequent allocations instead of being deallocated.
 
     void reserveCapacity(int numBytes);
         // Reserve sufficient memory to satisfy allocation requests for at
@@ -400,6 +442,36 @@ class SequentialAllocator : public ManagedAllocator {
         // 'address' is 'originalSize', 'newSize <= originalSize',
         // '0 <= newSize', and 'release' was not called after allocating the
         // memory block at 'address'.
+
+    void rewind(const Checkpoint& checkpoint);
+        // Restore this allocator to the allocation state recorded by the
+        // specified 'checkpoint', making all memory allocated through this
+        // allocator since 'checkpoint' was taken available for subsequent
+        // allocations.  The behavior is undefined unless 'checkpoint' was
+        // returned by the 'checkpoint' method of this allocator, and neither
+        // 'release' nor 'rewind' to an earlier checkpoint was called since.
+
+    void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+        // Configure subsequent calls to 'release' to retain memory if the
+        // specified 'retain' flag is 'true', and to deallocate all memory
+        // (the default behavior) otherwise.  If retaining, 'release' keeps
+        // the largest block obtained from the allocator supplied at
+        // construction, together with further blocks as fit within the
+        // optionally specified 'maxRetainedBytes' (including the largest
+        // block), for reuse by subsequent allocations.  If 'maxRetainedBytes'
+        // is not specified, only the largest block is retained.  The behavior
+        // is undefined unless '0 <= maxRetainedBytes'.
+
+    Checkpoint checkpoint() const;
+        // Return the current allocation state of this allocator, suitable for
+        // later passing to 'rewind'.  Note that no memory is allocated.
+
+    // ACCESSORS
+    virtual bool hasNoOpDeallocate() const;
+        // Return 'true', as 'deallocate' and 'deallocateSized' have no effect
+        // for this allocator.  Note that containers using this allocator may
+        // therefore skip returning the memory of wink-out-safe elements on
+        // destruction (see 'bslma_winkoututil').
 };
 
 // ============================================================================
@@ -553,11 +625,29 @@ void *SequentialAllocator::allocate(size_type size)
     return d_sequentialPool.allocate(size);
 }
 
+inline
+void *SequentialAllocator::allocateAligned(size_type size,
+                                           size_type alignment)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    return d_sequentialPool.allocateAligned(size,
+                                            static_cast<int>(alignment));
+}
+
 inline
 void SequentialAllocator::deallocate(void *)
 {
 }
 
+inline
+void SequentialAllocator::deallocateSized(void *, size_type)
+{
+}
+
 inline
 void SequentialAllocator::release()
 {
@@ -572,6 +662,32 @@ int SequentialAllocator::truncate(void *address,
     return d_sequentialPool.truncate(address, originalSize, newSize);
 }
 
+inline
+void SequentialAllocator::rewind(const Checkpoint& checkpoint)
+{
+    d_sequentialPool.rewind(checkpoint);
+}
+
+inline
+void SequentialAllocator::setRetainOnRelease(bool retain,
+                                             int  maxRetainedBytes)
+{
+    d_sequentialPool.setRetainOnRelease(retain, maxRetainedBytes);
+}
+
+// ACCESSORS
+inline
+Checkpoint SequentialAllocator::checkpoint() const
+{
+    return d_sequentialPool.checkpoint();
+}
+
+inline
+bool SequentialAllocator::hasNoOpDeallocate() const
+{
+    return true;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
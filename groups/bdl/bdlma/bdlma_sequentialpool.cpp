@@ -1,6 +1,7 @@
 // bdlma_sequentialpool.cpp                                           -*-C++-*-
 #include <bdlma_sequentialpool.h>
 
+#include <bsls_alignmentutil.h>
 #include <bsls_performancehint.h>
 
 #include <bsl_climits.h>  // 'INT_MAX'
@@ -19,6 +20,37 @@ namespace bdlma {
                         // class SequentialPool
                         // --------------------
 
+// PRIVATE MANIPULATORS
+void *SequentialPool::allocateAlignedHelp(bsls::Types::size_type size,
+                                          int                    alignment)
+{
+    // New buffers are maximally aligned, so at most the difference between
+    // 'alignment' and the maximal alignment need be skipped to align a block.
+
+    const int padding = alignment > bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+                      ? alignment - bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+                      : 0;
+
+    const int paddedSize = static_cast<int>(size) + padding;
+    int       nextSize   = calculateNextBufferSize(paddedSize);
+
+    if (nextSize < paddedSize) {
+        char *block = static_cast<char *>(d_blockList.allocate(paddedSize));
+        return block + bsls::AlignmentUtil::calculateAlignmentOffset(
+                                                          block,
+                                                          alignment); // RETURN
+    }
+
+    // A retained block reused for the new buffer may be larger than
+    // 'nextSize', in which case all of it is used.
+
+    char *buffer = static_cast<char *>(
+                                   d_blockList.allocateAndExpand(&nextSize));
+    d_buffer.replaceBuffer(buffer, nextSize);
+
+    return d_buffer.allocateAlignedRaw(static_cast<int>(size), alignment);
+}
+
 // PRIVATE ACCESSORS
 int SequentialPool::calculateNextBufferSize(int size) const
 {
@@ -50,6 +82,7 @@ SequentialPool::SequentialPool(bslma::Allocator *basicAllocator)
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_initialSize(INITIAL_SIZE)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
 }
@@ -61,6 +94,7 @@ SequentialPool(bsls::BlockGrowth::Strategy  growthStrategy,
 , d_growthStrategy(growthStrategy)
 , d_initialSize(INITIAL_SIZE)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
 }
@@ -72,6 +106,7 @@ SequentialPool(bsls::Alignment::Strategy  alignmentStrategy,
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_initialSize(INITIAL_SIZE)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
 }
@@ -84,6 +119,7 @@ SequentialPool(bsls::BlockGrowth::Strategy  growthStrategy,
 , d_growthStrategy(growthStrategy)
 , d_initialSize(INITIAL_SIZE)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
 }
@@ -94,6 +130,7 @@ SequentialPool(int initialSize, bslma::Allocator *basicAllocator)
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_initialSize(initialSize)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(0 < initialSize);
@@ -110,6 +147,7 @@ SequentialPool(int                          initialSize,
 , d_growthStrategy(growthStrategy)
 , d_initialSize(initialSize)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(0 < initialSize);
@@ -126,6 +164,7 @@ SequentialPool(int                        initialSize,
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_initialSize(initialSize)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(0 < initialSize);
@@ -143,6 +182,7 @@ SequentialPool(int                          initialSize,
 , d_growthStrategy(growthStrategy)
 , d_initialSize(initialSize)
 , d_maxBufferSize(INT_MAX)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(0 < initialSize);
@@ -159,6 +199,7 @@ SequentialPool(int               initialSize,
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_initialSize(initialSize)
 , d_maxBufferSize(maxBufferSize)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(0 < initialSize);
@@ -177,6 +218,7 @@ SequentialPool(int                          initialSize,
 , d_growthStrategy(growthStrategy)
 , d_initialSize(initialSize)
 , d_maxBufferSize(maxBufferSize)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(0 < initialSize);
@@ -195,6 +237,7 @@ SequentialPool(int                        initialSize,
 , d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
 , d_initialSize(initialSize)
 , d_maxBufferSize(maxBufferSize)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(0 < initialSize);
@@ -214,6 +257,7 @@ SequentialPool(int                          initialSize,
 , d_growthStrategy(growthStrategy)
 , d_initialSize(initialSize)
 , d_maxBufferSize(maxBufferSize)
+, d_maxRetainedBytes(-1)
 , d_blockList(basicAllocator)
 {
     BSLS_ASSERT(0 < initialSize);
@@ -226,14 +270,15 @@ SequentialPool(int                          initialSize,
 // MANIPULATORS
 void *SequentialPool::allocateHelp(bsls::Types::size_type size)
 {
-    const int nextSize = calculateNextBufferSize(size);
+    int nextSize = calculateNextBufferSize(size);
 
     if (nextSize < static_cast<int>(size)) {
         return d_blockList.allocate(size);                            // RETURN
     }
 
-    d_buffer.replaceBuffer(static_cast<char *>(d_blockList.allocate(nextSize)),
-                           nextSize);
+    char *buffer = static_cast<char *>(
+                                   d_blockList.allocateAndExpand(&nextSize));
+    d_buffer.replaceBuffer(buffer, nextSize);
 
     return d_buffer.allocateRaw(size);
 }
@@ -266,8 +311,9 @@ void SequentialPool::reserveCapacity(int size)
         nextSize = size;
     }
 
-    d_buffer.replaceBuffer(static_cast<char *>(d_blockList.allocate(nextSize)),
-                           nextSize);
+    char *buffer = static_cast<char *>(
+                                   d_blockList.allocateAndExpand(&nextSize));
+    d_buffer.replaceBuffer(buffer, nextSize);
 }
 
 }  // close package namespace
@@ -12,7 +12,8 @@ BSLS_IDENT("$Id: $")
 //@CLASSES:
 //   bdlma::SequentialPool: memory pool using dynamically-allocated buffers
 //
-//@SEE_ALSO: bdlma_infrequentdeleteblocklist, bdlma_sequentialallocator
+//@SEE_ALSO: bdlma_infrequentdeleteblocklist, bdlma_sequentialallocator,
+//           bdlma_checkpoint
 //
 //@DESCRIPTION: This component provides a fast sequential memory pool,
 // 'bdlma::SequentialPool', that dispenses heterogeneous memory blocks (of
@@ -64,6 +65,33 @@ BSLS_IDENT("$Id: $")
 // 'alignmentStrategy' is not specified, natural alignment is used.  See
 // 'bsls_alignment' for more details.
 //
+///Checkpoints
+///-----------
+// The 'checkpoint' method returns a 'bdlma::Checkpoint' recording the current
+// allocation state of the pool, and the 'rewind' method restores the pool to
+// a previously recorded state, making all memory allocated since available
+// for reuse.  Memory dispensed after the checkpoint from the then-current
+// internal buffer is reclaimed simply by restoring the cursor; internal
+// buffers (and separate blocks) obtained after the checkpoint are returned to
+// the allocator supplied at construction.  Checkpoints nest, so a
+// 'bdlma::CheckpointGuard' can be used to discard the memory allocated by a
+// failed speculative computation, such that subsequent attempts reuse the
+// same memory instead of growing the pool.  Note that a call to 'release'
+// invalidates all outstanding checkpoints.
+//
+///Retaining Memory on Release
+///---------------------------
+// By default, 'release' returns all memory to the allocator supplied at
+// construction, so a pool that is released after each of a sequence of
+// similar tasks obtains the same memory from that allocator again for each
+// task.  Calling 'setRetainOnRelease' configures 'release' to keep the largest
+// block of memory obtained so far -- and, optionally, further blocks up to a
+// total byte budget -- and to reuse the retained memory for the internal
+// buffers of subsequent allocations.  Since the retained largest block is at
+// least as large as all the memory in use by the previous task (with geometric
+// growth), a steady-state cycle of allocations followed by 'release' soon
+// stops allocating from the allocator supplied at construction entirely.
+//
 ///Usage
 ///-----
 ///Example 1: Using 'bdlma::SequentialPool' for Efficient Allocations
@@ -288,6 +316,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlma_buffermanager.h>
 #endif
 
+#ifndef INCLUDED_BDLMA_CHECKPOINT
+#include <bdlma_checkpoint.h>
+#endif
+
 #ifndef INCLUDED_BDLMA_INFREQUENTDELETEBLOCKLIST
 #include <bdlma_infrequentdeleteblocklist.h>
 #endif
@@ -349,6 +381,11 @@ class SequentialPool {
 
     int                 d_maxBufferSize;   // maximum internal buffer size
 
+    int                 d_maxRetainedBytes;
+                                           // budget for memory retained by
+                                           // 'release' (negative if none is
+                                           // retained)
+
     InfrequentDeleteBlockList
                         d_blockList;       // memory manager used to supply
                                            // dynamically-allocated memory
@@ -360,6 +397,15 @@ class SequentialPool {
     SequentialPool& operator=(const SequentialPool&);
 
   private:
+    // PRIVATE MANIPULATORS
+    void *allocateAlignedHelp(bsls::Types::size_type size, int alignment);
+        // Return the address of a contiguous block of memory of the specified
+        // 'size' (in bytes) aligned to the specified 'alignment', obtained
+        // from a new internal buffer, or directly from the allocator supplied
+        // at construction if the buffer can no longer grow to accommodate the
+        // request.  The behavior is undefined unless '0 < size' and
+        // 'alignment' is a positive power of two.
+
     // PRIVATE ACCESSORS
     int calculateNextBufferSize(int size) const;
         // Return the next buffer size (in bytes) that is sufficiently large to
@@ -472,6 +518,17 @@ class SequentialPool {
         // allocate memory from the new buffer.  The behavior is undefined
         // unless '0 < size'.
 
+    void *allocateAligned(bsls::Types::size_type size, int alignment);
+        // Return the address of a contiguous block of memory of the specified
+        // 'size' (in bytes) aligned to the specified 'alignment', which may
+        // exceed the maximal alignment of the platform.  The alignment
+        // strategy specified at construction is not used.  If the allocation
+        // request exceeds the remaining free memory space in the current
+        // internal buffer, use the allocator supplied at construction to
+        // allocate a new internal buffer, then allocate memory from the new
+        // buffer.  The behavior is undefined unless '0 < size' and 'alignment'
+        // is a positive power of two.
+
     void *allocateAndExpand(bsls::Types::size_type *size);
         // Return the address of a contiguous block of memory of at least the
         // specified '*size' (in bytes), and load the actual amount of memory
@@ -497,7 +554,10 @@ class SequentialPool {
         // Release all memory allocated through this pool.  The pool is reset
         // to its default-constructed state, retaining the alignment and
         // growth strategies, and the initial and maximum buffer sizes in
-        // effect following construction.
+        // effect following construction.  If retention was enabled by
+        // 'setRetainOnRelease', some of the memory obtained from the
+        // allocator supplied at construction is kept for reuse by subsequent
+        // allocations instead of being deallocated.
 
     void reserveCapacity(int numBytes);
         // Reserve sufficient memory to satisfy allocation requests for at
@@ -508,6 +568,30 @@ class SequentialPool {
         // that not all 'numBytes' of memory will be used for allocation before
         // triggering dynamic allocation.
 
+    void rewind(const Checkpoint& checkpoint);
+        // Restore this pool to the allocation state recorded by the specified
+        // 'checkpoint', making all memory allocated through this pool since
+        // 'checkpoint' was taken available for subsequent allocations.
+        // Internal buffers and blocks obtained from the allocator supplied at
+        // construction after 'checkpoint' was taken are deallocated.  The
+        // behavior is undefined unless 'checkpoint' was returned by the
+        // 'checkpoint' method of this pool, and neither 'release' nor 'rewind'
+        // to an earlier checkpoint was called since.
+
+    void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+        // Configure subsequent calls to 'release' to retain memory if the
+        // specified 'retain' flag is 'true', and to deallocate all memory
+        // (the default behavior) otherwise.  If retaining, 'release' keeps
+        // the largest block obtained from the allocator supplied at
+        // construction, together with further blocks as fit within the
+        // optionally specified 'maxRetainedBytes' (including the largest
+        // block); retained memory is used to satisfy subsequent requests for
+        // internal buffers (and separate blocks) before more memory is
+        // obtained from the allocator.  If 'maxRetainedBytes' is not
+        // specified, only the largest block is retained.  The behavior is
+        // undefined unless '0 <= maxRetainedBytes'.  Note that all memory is
+        // deallocated when this pool is destroyed.
+
     int truncate(void *address, int originalSize, int newSize);
         // Reduce the amount of memory allocated at the specified 'address'
         // of the specified 'originalSize' (in bytes) to the specified
@@ -520,6 +604,11 @@ class SequentialPool {
         // block at 'address' is 'originalSize', 'newSize <= originalSize',
         // '0 <= newSize', and 'release' was not called after allocating the
         // memory block at 'address'.
+
+    // ACCESSORS
+    Checkpoint checkpoint() const;
+        // Return the current allocation state of this pool, suitable for
+        // later passing to 'rewind'.  Note that no memory is allocated.
 };
 
 }  // close package namespace
@@ -618,6 +707,24 @@ void *SequentialPool::allocate(bsls::Types::size_type size)
     return allocateHelp(size);
 }
 
+inline
+void *SequentialPool::allocateAligned(bsls::Types::size_type size,
+                                      int                    alignment)
+{
+    BSLS_ASSERT(0 < size);
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(d_buffer.buffer())) {
+        void *result = d_buffer.allocateAligned(size, alignment);
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(result)) {
+            return result;                                            // RETURN
+        }
+    }
+
+    return allocateAlignedHelp(size, alignment);
+}
+
 template <class TYPE>
 inline
 void SequentialPool::deleteObjectRaw(const TYPE *object)
@@ -646,7 +753,34 @@ void SequentialPool::release()
 
     d_buffer.reset();
 
-    d_blockList.release();
+    if (0 <= d_maxRetainedBytes) {
+        d_blockList.releaseRetaining(d_maxRetainedBytes);
+    }
+    else {
+        d_blockList.release();
+    }
+}
+
+inline
+void SequentialPool::rewind(const Checkpoint& checkpoint)
+{
+    d_blockList.releaseAfter(checkpoint.lastBlock());
+
+    if (checkpoint.buffer()) {
+        d_buffer.replaceBuffer(checkpoint.buffer(), checkpoint.bufferSize());
+        d_buffer.setCursor(checkpoint.cursor());
+    }
+    else {
+        d_buffer.reset();
+    }
+}
+
+inline
+void SequentialPool::setRetainOnRelease(bool retain, int maxRetainedBytes)
+{
+    BSLS_ASSERT_SAFE(0 <= maxRetainedBytes);
+
+    d_maxRetainedBytes = retain ? maxRetainedBytes : -1;
 }
 
 inline
@@ -659,6 +793,16 @@ int SequentialPool::truncate(void *address, int originalSize, int newSize)
     return d_buffer.truncate(address, originalSize, newSize);
 }
 
+// ACCESSORS
+inline
+Checkpoint SequentialPool::checkpoint() const
+{
+    return Checkpoint(d_buffer.buffer(),
+                      d_buffer.bufferSize(),
+                      d_buffer.cursor(),
+                      d_blockList.lastBlock());
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -11,7 +11,9 @@
 #include <bsls_alignmentutil.h>
 #include <bsls_asserttest.h>
 
+#include <bsl_climits.h>
 #include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
 #include <bsl_iostream.h>
 
 using namespace BloombergLP;
@@ -73,16 +75,22 @@ using namespace bsl;
 // // MANIPULATORS
 // [ 4] void *allocate(size_type size);
 // [ 7] void *allocateAndExpand(size_type *size);
+// [11] void *allocateAligned(size_type size, int alignment);
 // [ 6] void deleteObjectRaw(const TYPE *object);
 // [ 6] void deleteObject(const TYPE *object);
 // [ 5] void release();
 // [ 9] void reserveCapacity(int numBytes);
+// [12] void rewind(const Checkpoint& checkpoint);
+// [13] void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
 // [ 8] int truncate(void *address, int originalSize, int newSize);
+//
+// // ACCESSORS
+// [12] Checkpoint checkpoint() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] HELPER FUNCTION: 'int blockSize(numBytes)'
 // [10] FREE FUNCTION: 'operator new(size_t, bdlma::SequentialPool)'
-// [11] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -464,7 +472,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 11: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -486,6 +494,431 @@ int main(int argc, char *argv[])
                           << "USAGE EXAMPLE" << endl
                           << "=============" << endl;
 
+      } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // 'setRetainOnRelease' TEST
+        //
+        // Concerns:
+        //: 1 By default, 'release' deallocates all memory obtained from the
+        //:   allocator supplied at construction.
+        //:
+        //: 2 With retention enabled, 'release' retains only the largest block
+        //:   if no budget is specified.
+        //:
+        //: 3 With retention enabled, 'release' retains further blocks within
+        //:   the specified budget.
+        //:
+        //: 4 Retained memory is reused, so that a steady-state cycle of
+        //:   allocations followed by 'release' obtains no more memory from the
+        //:   allocator supplied at construction.
+        //:
+        //: 5 Disabling retention restores the default behavior.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate, 'release', and verify that no memory remains in use
+        //:   from the test allocator.  (C-1)
+        //:
+        //: 2 With retention enabled, 'release' keeps one block allocated from
+        //:   the test allocator, and a cycle of identical allocations followed
+        //:   by 'release' stops allocating from the test allocator after the
+        //:   first few cycles.  (C-2, 4)
+        //:
+        //: 3 Repeat P-2 with an unlimited budget, and verify that every block
+        //:   is retained and that no cycle after the first allocates from the
+        //:   test allocator.  (C-3..4)
+        //:
+        //: 4 Disable retention and verify that 'release' deallocates all
+        //:   memory.  (C-5)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-6)
+        //
+        // Testing:
+        //   void setRetainOnRelease(bool retain, int maxRetainedBytes = 0);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'setRetainOnRelease' TEST" << endl
+                                  << "=========================" << endl;
+
+        enum { NUM_CYCLES = 8, NUM_ALLOCS = 100, ALLOC_SIZE = 100 };
+
+        if (verbose) cout << "\nTesting the default behavior." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            Obj mX(&ta);
+
+            for (int i = 0; i < NUM_ALLOCS; ++i) {
+                bsl::memset(mX.allocate(ALLOC_SIZE), 0xa5, ALLOC_SIZE);
+            }
+            ASSERT(1 < ta.numBlocksInUse());
+
+            mX.release();
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nRetaining the largest block." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            Obj mX(&ta);
+
+            mX.setRetainOnRelease(true);
+
+            bsls::Types::Int64 numBlocksTotal = 0;
+
+            for (int cycle = 0; cycle < NUM_CYCLES; ++cycle) {
+                for (int i = 0; i < NUM_ALLOCS; ++i) {
+                    bsl::memset(mX.allocate(ALLOC_SIZE), 0xa5, ALLOC_SIZE);
+                }
+
+                mX.release();
+                ASSERTV(cycle, 1 == ta.numBlocksInUse());
+
+                if (2 <= cycle) {
+                    ASSERTV(cycle, numBlocksTotal == ta.numBlocksTotal());
+                }
+                numBlocksTotal = ta.numBlocksTotal();
+            }
+
+            if (verbose) cout << "\nDisabling retention." << endl;
+
+            mX.setRetainOnRelease(false);
+            mX.allocate(ALLOC_SIZE);
+            mX.release();
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nRetaining within a budget." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            Obj mX(&ta);
+
+            mX.setRetainOnRelease(true, INT_MAX);
+
+            bsls::Types::Int64 numBlocksTotal = 0;
+
+            for (int cycle = 0; cycle < NUM_CYCLES; ++cycle) {
+                for (int i = 0; i < NUM_ALLOCS; ++i) {
+                    bsl::memset(mX.allocate(ALLOC_SIZE), 0xa5, ALLOC_SIZE);
+                }
+
+                const bsls::Types::Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+                mX.release();
+                ASSERTV(cycle, NUM_BLOCKS == ta.numBlocksInUse());
+
+                if (1 <= cycle) {
+                    ASSERTV(cycle, numBlocksTotal == ta.numBlocksTotal());
+                }
+                numBlocksTotal = ta.numBlocksTotal();
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(&objectAllocator);
+
+            ASSERT_SAFE_PASS(mX.setRetainOnRelease(true,  0));
+            ASSERT_SAFE_PASS(mX.setRetainOnRelease(false, 0));
+            ASSERT_SAFE_FAIL(mX.setRetainOnRelease(true, -1));
+        }
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // 'checkpoint' AND 'rewind' TEST
+        //
+        // Concerns:
+        //: 1 Rewinding to a checkpoint taken in the current buffer makes the
+        //:   memory allocated since available again, without allocating or
+        //:   deallocating any memory.
+        //:
+        //: 2 Buffers and separate blocks obtained after a checkpoint are
+        //:   deallocated by 'rewind', and allocation resumes in the
+        //:   checkpointed buffer at the checkpointed cursor.
+        //:
+        //: 3 Checkpoints nest: rewinding to an inner checkpoint does not
+        //:   affect an outer one.
+        //:
+        //: 4 Rewinding to a checkpoint taken before the pool had any buffer
+        //:   returns all memory, and the pool remains usable.
+        //:
+        //: 5 A 'bdlma::CheckpointGuard' managing the pool keeps the memory
+        //:   footprint of repeated speculative allocation constant.
+        //
+        // Plan:
+        //: 1 Allocate from a pool, take a checkpoint, allocate further from
+        //:   the same buffer, and rewind.  Verify the next allocation reuses
+        //:   the first address allocated after the checkpoint, and that the
+        //:   test allocator saw no further traffic.  (C-1)
+        //:
+        //: 2 Using a pool with a maximum buffer size, take a checkpoint, then
+        //:   allocate enough to trigger both new buffers and separate blocks.
+        //:   Rewind, and verify the number of blocks and bytes in use, and the
+        //:   address of the next allocation.  (C-2)
+        //:
+        //: 3 Take checkpoints 'C0' (before any allocation), 'C1', and 'C2',
+        //:   allocating new buffers in between, and rewind to each in reverse
+        //:   order, verifying the blocks in use after each.  (C-3..4)
+        //:
+        //: 4 Repeatedly allocate under a 'bdlma::CheckpointGuard' and verify
+        //:   that the blocks in use after each iteration are unchanged.  (C-5)
+        //
+        // Testing:
+        //   void rewind(const Checkpoint& checkpoint);
+        //   Checkpoint checkpoint() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'checkpoint' AND 'rewind' TEST" << endl
+                                  << "==============================" << endl;
+
+        if (verbose) cout << "\nTesting rewind within the current buffer."
+                          << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(256, &ta);  const Obj& X = mX;
+            mX.allocate(8);
+
+            const bdlma::Checkpoint C = X.checkpoint();
+            ASSERT(1 == ta.numAllocations());
+
+            void *p = mX.allocate(16);
+            mX.allocate(32);
+            mX.allocate(64);
+
+            mX.rewind(C);
+            ASSERT(1 == ta.numAllocations());
+            ASSERT(0 == ta.numDeallocations());
+            ASSERT(p == mX.allocate(16));
+        }
+
+        if (verbose) cout << "\nTesting rewind across buffers." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(64, 128, &ta);  const Obj& X = mX;
+            mX.allocate(8);
+
+            const bsls::Types::Int64 NUM_BYTES = ta.numBytesInUse();
+            const bdlma::Checkpoint  C         = X.checkpoint();
+
+            void *p = mX.allocate(8);
+            for (int i = 0; i < 10; ++i) {
+                mX.allocate(100);
+                mX.allocate(1000);
+            }
+            ASSERT(10 < ta.numBlocksInUse());
+
+            mX.rewind(C);
+            ASSERTV(ta.numBlocksInUse(), 1         == ta.numBlocksInUse());
+            ASSERTV(ta.numBytesInUse(),  NUM_BYTES == ta.numBytesInUse());
+            ASSERT(p == mX.allocate(8));
+        }
+
+        if (verbose) cout << "\nTesting nested checkpoints." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(&ta);  const Obj& X = mX;
+
+            const bdlma::Checkpoint C0 = X.checkpoint();
+            ASSERT(0 == C0.buffer());
+
+            mX.allocate(10);
+            const bsls::Types::Int64 N1 = ta.numBlocksInUse();
+            const bdlma::Checkpoint  C1 = X.checkpoint();
+
+            mX.allocate(4 * DEFAULT_SIZE);
+            const bsls::Types::Int64 N2 = ta.numBlocksInUse();
+            const bdlma::Checkpoint  C2 = X.checkpoint();
+            ASSERT(N1 < N2);
+
+            mX.allocate(16 * DEFAULT_SIZE);
+            ASSERT(N2 < ta.numBlocksInUse());
+
+            mX.rewind(C2);
+            ASSERTV(ta.numBlocksInUse(), N2 == ta.numBlocksInUse());
+
+            mX.allocate(16 * DEFAULT_SIZE);
+            mX.rewind(C1);
+            ASSERTV(ta.numBlocksInUse(), N1 == ta.numBlocksInUse());
+
+            mX.rewind(C0);
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+            ASSERT(mX.allocate(10));
+            ASSERT(1 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting 'bdlma::CheckpointGuard'." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            Obj mX(&ta);
+            mX.allocate(10);
+
+            const bsls::Types::Int64 NUM_BLOCKS = ta.numBlocksInUse();
+            const bsls::Types::Int64 NUM_BYTES  = ta.numBytesInUse();
+
+            for (int i = 1; i <= 64; ++i) {
+                bdlma::CheckpointGuard<Obj> guard(&mX);
+
+                for (int j = 0; j < i; ++j) {
+                    mX.allocate(i * 8);
+                }
+            }
+
+            ASSERTV(ta.numBlocksInUse(), NUM_BLOCKS == ta.numBlocksInUse());
+            ASSERTV(ta.numBytesInUse(),  NUM_BYTES  == ta.numBytesInUse());
+        }
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // 'allocateAligned' TEST
+        //
+        // Concerns:
+        //: 1 'allocateAligned' returns memory aligned to the specified
+        //:   alignment, which may exceed the maximal alignment of the
+        //:   platform, irrespective of the alignment strategy of the pool.
+        //:
+        //: 2 A request that fits in the internal buffer after alignment does
+        //:   not trigger dynamic allocation, and only the padding needed to
+        //:   reach the alignment is skipped.
+        //:
+        //: 3 A request that cannot be satisfied by the next internal buffer
+        //:   is satisfied by a single block, from the internal block list,
+        //:   that is large enough to be aligned, and does not replace the
+        //:   internal buffer.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each alignment strategy, allocate blocks of various sizes and
+        //:   alignments (up to 4096), verify their alignment, and write to
+        //:   every byte so that the test allocator detects any overrun.  (C-1)
+        //:
+        //: 2 Using a pool having an initial and maximum buffer size of 1024,
+        //:   allocate aligned blocks that fit in the buffer and verify, using
+        //:   the test allocator, that no further allocation occurs and that
+        //:   the blocks are adjacent to the preceding allocation.  (C-2)
+        //:
+        //: 3 Using the same pool, allocate an aligned block exceeding the
+        //:   maximum buffer size and verify the size of the block obtained
+        //:   from the test allocator, then verify that subsequent allocations
+        //:   are still served from the original buffer.  (C-3)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void *allocateAligned(size_type size, int alignment);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'allocateAligned' TEST" << endl
+                                  << "======================" << endl;
+
+        const Strat STRATEGIES[] = { bsls::Alignment::BSLS_NATURAL,
+                                     bsls::Alignment::BSLS_MAXIMUM,
+                                     bsls::Alignment::BSLS_BYTEALIGNED };
+        const int NUM_STRATEGIES = sizeof STRATEGIES / sizeof *STRATEGIES;
+
+        const int SIZES[]   = { 1, 3, 8, 63, 64, 100, 1000, 5000 };
+        const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        if (verbose) cout << "\nTesting alignment of returned memory."
+                          << endl;
+
+        for (int ti = 0; ti < NUM_STRATEGIES; ++ti) {
+            const Strat STRAT = STRATEGIES[ti];
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj                  mX(STRAT, &ta);
+
+            for (int tj = 0; tj < NUM_SIZES; ++tj) {
+                const int SIZE = SIZES[tj];
+
+                for (int align = 1; align <= 4096; align <<= 1) {
+                    if (veryVeryVerbose) { T_ P_(STRAT) P_(SIZE) P(align) }
+
+                    char *p = static_cast<char *>(mX.allocate(1));
+                    *p = 'x';
+
+                    p = static_cast<char *>(mX.allocateAligned(SIZE, align));
+
+                    LOOP3_ASSERT(STRAT, SIZE, align,
+                               0 == bsls::Types::UintPtr(p) % align);
+
+                    bsl::memset(p, 0xa5, SIZE);
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting buffer use." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Obj mX(1024, 1024, bsls::Alignment::BSLS_BYTEALIGNED, &ta);
+
+            ASSERT(1 == ta.numBlocksInUse());
+
+            char *p = static_cast<char *>(mX.allocate(1));
+            char *q = static_cast<char *>(mX.allocateAligned(64, 64));
+
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(0 == bsls::Types::UintPtr(q) % 64);
+            ASSERT(p < q);
+            ASSERT(q - p <= 64);
+
+            char *r = static_cast<char *>(mX.allocateAligned(4, 4));
+
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(q + 64 == r);
+
+            if (verbose) cout << "\nTesting requests exceeding the buffer."
+                              << endl;
+
+            const int SIZE    = 2000;
+            const int ALIGN   = 512;
+            const int PADDING = ALIGN > MAX_ALIGN ? ALIGN - MAX_ALIGN : 0;
+
+            char *s = static_cast<char *>(mX.allocateAligned(SIZE, ALIGN));
+
+            ASSERT(2 == ta.numBlocksInUse());
+            ASSERT(0 == bsls::Types::UintPtr(s) % ALIGN);
+            LOOP_ASSERT(ta.lastAllocatedNumBytes(),
+                        static_cast<bsls::Types::size_type>(
+                                                   blockSize(SIZE + PADDING))
+                                                == ta.lastAllocatedNumBytes());
+
+            bsl::memset(s, 0xa5, SIZE);
+
+            char *t = static_cast<char *>(mX.allocateAligned(4, 4));
+
+            ASSERT(2 == ta.numBlocksInUse());
+            ASSERT(r + 4 == t);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(&objectAllocator);
+
+            ASSERT_PASS(mX.allocateAligned(1, 64));
+            ASSERT_FAIL(mX.allocateAligned(0, 64));
+            ASSERT_FAIL(mX.allocateAligned(1, 0));
+            ASSERT_FAIL(mX.allocateAligned(1, 48));
+        }
+
       } break;
       case 10: {
         // --------------------------------------------------------------------
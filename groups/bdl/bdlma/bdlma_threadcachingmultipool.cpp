@@ -0,0 +1,274 @@
+// bdlma_threadcachingmultipool.cpp                                   -*-C++-*-
+#include <bdlma_threadcachingmultipool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_threadcachingmultipool_cpp,"$Id$ $CSID$")
+
+#include <bslma_autodestructor.h>
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+
+#include <bsl_new.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+// TYPES
+enum {
+    DEFAULT_NUM_POOLS      = 10,       // default number of pools
+
+    DEFAULT_MAX_CHUNK_SIZE = 32,       // default maximum number of blocks per
+                                       // chunk
+
+    MIN_BLOCK_SIZE         =  8,       // minimum block size (in bytes)
+
+    MAGAZINE_BYTES         = 16 * 1024,
+                                       // approximate number of bytes of
+                                       // blocks held by a full magazine
+
+    MIN_MAGAZINE_CAPACITY  =  2,       // minimum number of blocks held by a
+                                       // full magazine
+
+    MAX_MAGAZINE_CAPACITY  = 256       // maximum number of blocks held by a
+                                       // full magazine
+};
+
+                       // ----------------------------
+                       // class ThreadCachingMultipool
+                       // ----------------------------
+
+// PRIVATE CLASS METHODS
+void ThreadCachingMultipool::flushMagazines(void     *multipool,
+                                            Magazine *magazines)
+{
+    BSLS_ASSERT(multipool);
+    BSLS_ASSERT(magazines);
+
+    ThreadCachingMultipool *owner = static_cast<ThreadCachingMultipool *>(
+                                                                    multipool);
+
+    for (int i = 0; i < owner->d_numPools; ++i) {
+        while (!magazines[i].isEmpty()) {
+            owner->d_pools_p[i].deallocate(magazines[i].pop());
+        }
+    }
+}
+
+// PRIVATE MANIPULATORS
+void ThreadCachingMultipool::drain(Magazine *magazine, int pool)
+{
+    BSLS_ASSERT(magazine);
+    BSLS_ASSERT(0 <= pool);
+    BSLS_ASSERT(pool < d_numPools);
+
+    const int numBlocks = magazine->batchSize();
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    for (int i = 0; i < numBlocks && !magazine->isEmpty(); ++i) {
+        d_pools_p[pool].deallocate(magazine->pop());
+    }
+}
+
+void ThreadCachingMultipool::initialize(
+                                 bsls::BlockGrowth::Strategy growthStrategy,
+                                 int                         maxBlocksPerChunk)
+{
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+
+    d_maxBlockSize = MIN_BLOCK_SIZE;
+
+    d_pools_p = static_cast<Pool *>(
+                      d_allocator_p->allocate(d_numPools * sizeof *d_pools_p));
+
+    bslma::DeallocatorProctor<bslma::Allocator> autoPoolsDeallocator(
+                                                                d_pools_p,
+                                                                d_allocator_p);
+    bslma::AutoDestructor<Pool> autoDtor(d_pools_p, 0);
+
+    for (int i = 0; i < d_numPools; ++i, ++autoDtor) {
+        new (d_pools_p + i) Pool(d_maxBlockSize + sizeof(Header),
+                                 growthStrategy,
+                                 maxBlocksPerChunk,
+                                 d_allocator_p);
+
+        d_magazineCache.setCapacity(i, Magazine::capacityFor(
+                                              d_maxBlockSize + sizeof(Header),
+                                              MAGAZINE_BYTES,
+                                              MIN_MAGAZINE_CAPACITY,
+                                              MAX_MAGAZINE_CAPACITY));
+
+        d_maxBlockSize *= 2;
+        BSLS_ASSERT(d_maxBlockSize > 0);
+    }
+
+    d_maxBlockSize /= 2;
+
+    autoDtor.release();
+    autoPoolsDeallocator.release();
+}
+
+void ThreadCachingMultipool::refill(Magazine *magazine, int pool)
+{
+    BSLS_ASSERT(magazine);
+    BSLS_ASSERT(magazine->isEmpty());
+    BSLS_ASSERT(0 <= pool);
+    BSLS_ASSERT(pool < d_numPools);
+
+    const int numBlocks = magazine->batchSize();
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    // Each block is placed into the magazine as soon as it is obtained, so
+    // that the magazine remains consistent if the pool throws.
+
+    for (int i = 0; i < numBlocks; ++i) {
+        magazine->push(d_pools_p[pool].allocate());
+    }
+}
+
+// CREATORS
+ThreadCachingMultipool::ThreadCachingMultipool(
+                                              bslma::Allocator *basicAllocator)
+: d_numPools(DEFAULT_NUM_POOLS)
+, d_blockList(basicAllocator)
+, d_magazineCache(d_numPools,
+                  &flushMagazines,
+                  this,
+                  &d_lock,
+                  basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize(bsls::BlockGrowth::BSLS_GEOMETRIC, DEFAULT_MAX_CHUNK_SIZE);
+}
+
+ThreadCachingMultipool::ThreadCachingMultipool(
+                                              int               numPools,
+                                              bslma::Allocator *basicAllocator)
+: d_numPools(numPools)
+, d_blockList(basicAllocator)
+, d_magazineCache(d_numPools,
+                  &flushMagazines,
+                  this,
+                  &d_lock,
+                  basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numPools);
+
+    initialize(bsls::BlockGrowth::BSLS_GEOMETRIC, DEFAULT_MAX_CHUNK_SIZE);
+}
+
+ThreadCachingMultipool::ThreadCachingMultipool(
+                                  bsls::BlockGrowth::Strategy  growthStrategy,
+                                  bslma::Allocator            *basicAllocator)
+: d_numPools(DEFAULT_NUM_POOLS)
+, d_blockList(basicAllocator)
+, d_magazineCache(d_numPools,
+                  &flushMagazines,
+                  this,
+                  &d_lock,
+                  basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize(growthStrategy, DEFAULT_MAX_CHUNK_SIZE);
+}
+
+ThreadCachingMultipool::ThreadCachingMultipool(
+                                  int                          numPools,
+                                  bsls::BlockGrowth::Strategy  growthStrategy,
+                                  bslma::Allocator            *basicAllocator)
+: d_numPools(numPools)
+, d_blockList(basicAllocator)
+, d_magazineCache(d_numPools,
+                  &flushMagazines,
+                  this,
+                  &d_lock,
+                  basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numPools);
+
+    initialize(growthStrategy, DEFAULT_MAX_CHUNK_SIZE);
+}
+
+ThreadCachingMultipool::ThreadCachingMultipool(
+                                int                          numPools,
+                                bsls::BlockGrowth::Strategy  growthStrategy,
+                                int                          maxBlocksPerChunk,
+                                bslma::Allocator            *basicAllocator)
+: d_numPools(numPools)
+, d_blockList(basicAllocator)
+, d_magazineCache(d_numPools,
+                  &flushMagazines,
+                  this,
+                  &d_lock,
+                  basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numPools);
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+
+    initialize(growthStrategy, maxBlocksPerChunk);
+}
+
+ThreadCachingMultipool::~ThreadCachingMultipool()
+{
+    BSLS_ASSERT(d_pools_p);
+    BSLS_ASSERT(1 <= d_numPools);
+    BSLS_ASSERT(1 <= d_maxBlockSize);
+    BSLS_ASSERT(d_allocator_p);
+
+    // The thread caches need not be flushed, as the pools are about to be
+    // released; they are deallocated by 'd_magazineCache'.
+
+    d_blockList.release();
+    for (int i = 0; i < d_numPools; ++i) {
+        d_pools_p[i].release();
+        d_pools_p[i].~Pool();
+    }
+    d_allocator_p->deallocate(d_pools_p);
+}
+
+// MANIPULATORS
+void ThreadCachingMultipool::release()
+{
+    d_magazineCache.discardAll();
+
+    for (int i = 0; i < d_numPools; ++i) {
+        d_pools_p[i].release();
+    }
+    d_blockList.release();
+}
+
+void ThreadCachingMultipool::reserveCapacity(int size, int numBlocks)
+{
+    BSLS_ASSERT(1    <= size);
+    BSLS_ASSERT(size <= d_maxBlockSize);
+    BSLS_ASSERT(0    <= numBlocks);
+
+    const int pool = findPool(size);
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    d_pools_p[pool].reserveCapacity(numBlocks);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
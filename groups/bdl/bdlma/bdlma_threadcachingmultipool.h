@@ -0,0 +1,519 @@
+// bdlma_threadcachingmultipool.h                                     -*-C++-*-
+#ifndef INCLUDED_BDLMA_THREADCACHINGMULTIPOOL
+#define INCLUDED_BDLMA_THREADCACHINGMULTIPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-safe multipool with per-thread block caches.
+//
+//@CLASSES:
+//  bdlma::ThreadCachingMultipool: multipool with per-thread magazines
+//
+//@SEE_ALSO: bdlma_multipool, bdlma_pool, bdlma_magazinecache
+//
+//@DESCRIPTION: This component implements a thread-safe memory manager,
+// 'bdlma::ThreadCachingMultipool', that dispenses maximally-aligned memory
+// blocks of varying sizes from an array of 'bdlma::Pool' objects, exactly as
+// a 'bdlma::Multipool' does, but that may be shared by many threads without
+// external synchronization.  The block size of the first pool is eight bytes,
+// with each successive pool managing blocks of a size twice that of the
+// previous pool.  Requests larger than the block size of the last pool are
+// satisfied from a separately managed list of memory blocks.
+//
+// Each thread that uses a 'bdlma::ThreadCachingMultipool' is given its own
+// thread cache holding one "magazine" (a short singly-linked list of free
+// blocks) per pool.  Allocation pops a block from the calling thread's
+// magazine for the appropriate size class, and deallocation pushes the block
+// onto the calling thread's magazine; neither operation takes a lock, nor
+// touches memory written by other threads, unless the magazine is empty (on
+// allocation) or full (on deallocation).  In those cases, half of a
+// magazine's worth of blocks is transferred, in one batch, between the
+// magazine and the shared pool while holding an internal lock.  The capacity
+// of each magazine is inversely proportional to the block size of its pool,
+// so that each thread cache holds a bounded amount of memory.  Requests that
+// are not pooled always take the lock.  The magazines and thread caches are
+// those of 'bdlma_magazinecache'.
+//
+// A 'bdlma::ThreadCachingMultipool' can be depicted visually:
+//..
+//   thread 1            thread 2
+//   ========            ========
+//  |8 bytes |--o-o     |8 bytes |--o
+//  >========<          >========<
+//  |16 bytes|--o       |16 bytes|--o-o-o     magazines of free blocks
+//  >========<          >========<
+//  |  ...   |          |  ...   |
+//   ========            ========
+//       \                  /
+//        \   batch refill / drain (locked)
+//         V              V
+//   ========       ----- ----- ------------
+//  |8 bytes |---->|     |     |     ...    |
+//  >========<      =====^=====^============
+//  |16 bytes|
+//  >========<
+//  |  ...   |
+//   ========
+//      |
+//      +------- array of 'bdlma::Pool' shared by all threads
+//..
+// A block may be deallocated by a thread other than the one that allocated
+// it; the block then simply becomes part of the deallocating thread's cache.
+//
+///Thread Safety
+///-------------
+// 'allocate', 'deallocate', 'deleteObject', 'deleteObjectRaw', and
+// 'reserveCapacity' may be called concurrently from any number of threads.
+// 'release' must *not* be called concurrently with any other method, and the
+// behavior is undefined if any block obtained before 'release' is
+// subsequently deallocated.
+//
+// On POSIX platforms, the blocks cached by a thread are returned to the
+// shared pools when that thread exits.  On Windows, they are returned when
+// 'release' is called or when the multipool is destroyed.  In either case, the
+// behavior is undefined if a thread that has used a
+// 'bdlma::ThreadCachingMultipool' exits while that multipool is being
+// destroyed.
+//
+///Configuration at Construction
+///-----------------------------
+// When creating a 'bdlma::ThreadCachingMultipool', clients can optionally
+// configure the NUMBER OF POOLS, the GROWTH STRATEGY, the MAX BLOCKS PER
+// CHUNK, and the BASIC ALLOCATOR exactly as for 'bdlma::Multipool' (see
+// 'bdlma_multipool').  The basic allocator need not be thread-safe; it is
+// only ever used while holding the internal lock.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing a Multipool Among Worker Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a number of worker threads each build and discard short-lived
+// messages of a few different sizes.  Rather than giving each thread its own
+// 'bdlma::Multipool' (which prevents passing messages between threads) or
+// guarding a single 'bdlma::Multipool' with a mutex (which serializes every
+// allocation), we share one 'bdlma::ThreadCachingMultipool'.
+//
+// First, we define a function that each worker thread runs:
+//..
+//  void processMessages(bdlma::ThreadCachingMultipool *pool, int numMessages)
+//      // Allocate, use, and deallocate the specified 'numMessages' from the
+//      // specified 'pool'.
+//  {
+//      for (int i = 0; i < numMessages; ++i) {
+//          int   size    = 8 << (i % 4);
+//          char *message = static_cast<char *>(pool->allocate(size));
+//          memset(message, 'x', size);
+//          pool->deallocate(message);
+//      }
+//  }
+//..
+// Then, we create the shared multipool; every thread that calls
+// 'processMessages' with its address obtains memory from the same pools,
+// almost always without acquiring a lock:
+//..
+//  bdlma::ThreadCachingMultipool pool;
+//
+//  processMessages(&pool, 1000);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_MAGAZINECACHE
+#include <bdlma_magazinecache.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_POOL
+#include <bdlma_pool.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BLOCKGROWTH
+#include <bsls_blockgrowth.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                       // ============================
+                       // class ThreadCachingMultipool
+                       // ============================
+
+class ThreadCachingMultipool {
+    // This class implements a thread-safe memory manager that maintains a
+    // configurable number of 'bdlma::Pool' objects, each dispensing memory
+    // blocks of a unique size, fronted by a per-thread cache of free blocks
+    // for each pool.  Allocation and deallocation are satisfied from the
+    // calling thread's cache, which is refilled from (or drained to) the
+    // shared pools in batches under a lock.  Requests that exceed the largest
+    // pooled block size are satisfied from a separately managed list of
+    // memory blocks.  Both the 'release' method and the destructor of a
+    // 'bdlma::ThreadCachingMultipool' release all memory currently allocated
+    // via the object.
+
+    // PRIVATE TYPES
+    struct Header {
+        // This 'struct' provides header information for each allocated memory
+        // block.  The header stores the index to the pool used for the memory
+        // allocation.
+
+        union {
+            int                    d_poolIdx;  // index to pool used for this
+                                               // memory block, or -1 if from
+                                               // 'd_blockList'
+
+            bsls::AlignmentUtil::MaxAlignedType
+                                   d_dummy;    // force maximum alignment
+        } d_header;
+    };
+
+    // DATA
+    Pool                  *d_pools_p;        // array of memory pools, each
+                                             // dispensing fixed-size memory
+                                             // blocks
+
+    int                    d_numPools;       // number of memory pools
+
+    int                    d_maxBlockSize;   // largest memory block size;
+                                             // dispensed by the
+                                             // 'd_numPools - 1'th pool;
+                                             // always a power of 2
+
+    BlockList              d_blockList;      // memory manager for "large"
+                                             // memory blocks
+
+    mutable bsls::BslLock  d_lock;           // guards pools, block list, and
+                                             // thread caches
+
+    MagazineCache          d_magazineCache;  // magazines of all threads
+
+    bslma::Allocator      *d_allocator_p;    // holds (but does not own)
+                                             // allocator
+
+  private:
+    // PRIVATE CLASS METHODS
+    static void flushMagazines(void *multipool, Magazine *magazines);
+        // Return all blocks held by the specified 'magazines' of a thread to
+        // the shared pools of the specified 'multipool'.  The behavior is
+        // undefined unless the internal lock of 'multipool' is held by the
+        // calling thread.
+
+    // PRIVATE MANIPULATORS
+    void drain(Magazine *magazine, int pool);
+        // Return half of the blocks held by the specified 'magazine' to the
+        // specified 'pool'.
+
+    void initialize(bsls::BlockGrowth::Strategy growthStrategy,
+                    int                         maxBlocksPerChunk);
+        // Initialize this multipool with the specified 'growthStrategy' and
+        // 'maxBlocksPerChunk'.
+
+    void refill(Magazine *magazine, int pool);
+        // Load the specified 'magazine' with half of its capacity of blocks
+        // obtained from the specified 'pool'.  The behavior is undefined
+        // unless 'magazine' is empty.
+
+    // PRIVATE ACCESSORS
+    int findPool(int size) const;
+        // Return the index of the memory pool in this multipool for an
+        // allocation request of the specified 'size' (in bytes).  The behavior
+        // is undefined unless '0 <= size <= maxPooledBlockSize()'.  Note that
+        // the index of the memory pool managing memory blocks having the
+        // minimum block size is 0.
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadCachingMultipool(const ThreadCachingMultipool&);
+    ThreadCachingMultipool& operator=(const ThreadCachingMultipool&);
+
+  public:
+    // CREATORS
+    explicit
+    ThreadCachingMultipool(bslma::Allocator            *basicAllocator = 0);
+    explicit
+    ThreadCachingMultipool(int                          numPools,
+                           bslma::Allocator            *basicAllocator = 0);
+    explicit
+    ThreadCachingMultipool(bsls::BlockGrowth::Strategy  growthStrategy,
+                           bslma::Allocator            *basicAllocator = 0);
+    ThreadCachingMultipool(int                          numPools,
+                           bsls::BlockGrowth::Strategy  growthStrategy,
+                           bslma::Allocator            *basicAllocator = 0);
+    ThreadCachingMultipool(int                          numPools,
+                           bsls::BlockGrowth::Strategy  growthStrategy,
+                           int                          maxBlocksPerChunk,
+                           bslma::Allocator            *basicAllocator = 0);
+        // Create a thread-caching multipool memory manager.  Optionally
+        // specify 'numPools', indicating the number of internally created
+        // 'bdlma::Pool' objects; the block size of the first pool is 8 bytes,
+        // with the block size of each additional pool successively doubling.
+        // If 'numPools' is not specified, an implementation-defined number of
+        // pools 'N' -- covering memory blocks ranging in size from '2^3 = 8'
+        // to '2^(N+2)' -- are created.  Optionally specify a 'growthStrategy'
+        // indicating whether the number of blocks allocated at once for every
+        // internally created 'bdlma::Pool' should be either fixed or grow
+        // geometrically, starting with 1.  If 'growthStrategy' is not
+        // specified, geometric growth is used.  If 'numPools' and
+        // 'growthStrategy' are specified, optionally specify a
+        // 'maxBlocksPerChunk', indicating the maximum number of blocks to be
+        // allocated at once when a pool must be replenished.  If
+        // 'maxBlocksPerChunk' is not specified, an implementation-defined
+        // value is used.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '1 <= numPools' and '1 <= maxBlocksPerChunk'.
+
+    ~ThreadCachingMultipool();
+        // Destroy this multipool.  All memory allocated from this multipool,
+        // including the blocks held in the caches of all threads, is
+        // released.
+
+    // MANIPULATORS
+    void *allocate(int size);
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes).  If
+        // 'size > maxPooledBlockSize()', the memory allocation is managed
+        // directly by the underlying allocator, and will not be pooled, but
+        // will be deallocated when the 'release' method is called, or when
+        // this object is destroyed.  The behavior is undefined unless
+        // '1 <= size'.
+
+    void deallocate(void *address);
+        // Relinquish the memory block at the specified 'address' back to this
+        // multipool object for reuse.  The behavior is undefined unless
+        // 'address' is non-zero, was allocated by this multipool object, and
+        // has not already been deallocated.  Note that 'address' need not have
+        // been allocated by the calling thread.
+
+    template <class TYPE>
+    void deleteObject(const TYPE *object);
+        // Destroy the specified 'object' based on its dynamic type and then
+        // use this multipool object to deallocate its memory footprint.  This
+        // method has no effect if 'object' is 0.  The behavior is undefined
+        // unless 'object', when cast appropriately to 'void *', was allocated
+        // using this multipool object and has not already been deallocated.
+        // Note that 'dynamic_cast<void *>(object)' is applied if 'TYPE' is
+        // polymorphic, and 'static_cast<void *>(object)' is applied otherwise.
+
+    template <class TYPE>
+    void deleteObjectRaw(const TYPE *object);
+        // Destroy the specified 'object' and then use this multipool to
+        // deallocate its memory footprint.  This method has no effect if
+        // 'object' is 0.  The behavior is undefined unless 'object' is !not! a
+        // secondary base class pointer (i.e., the address is (numerically) the
+        // same as when it was originally dispensed by this multipool), was
+        // allocated using this multipool, and has not already been
+        // deallocated.
+
+    void release();
+        // Relinquish all memory currently allocated via this multipool object,
+        // and empty the caches of all threads.  The behavior is undefined if
+        // this method is called concurrently with any other method of this
+        // object.
+
+    void reserveCapacity(int size, int numBlocks);
+        // Reserve memory from this multipool to satisfy memory requests for at
+        // least the specified 'numBlocks' having the specified 'size' (in
+        // bytes) before the shared pool replenishes.  The behavior is
+        // undefined unless '1 <= size <= maxPooledBlockSize()' and
+        // '0 <= numBlocks'.
+
+    // ACCESSORS
+    int numPools() const;
+        // Return the number of pools managed by this multipool object.
+
+    int maxPooledBlockSize() const;
+        // Return the maximum size of memory blocks that are pooled by this
+        // multipool object.  Note that the maximum value is defined as:
+        //..
+        //  2 ^ (numPools + 2)
+        //..
+        // where 'numPools' is either specified at construction, or an
+        // implementation-defined value.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                       // ----------------------------
+                       // class ThreadCachingMultipool
+                       // ----------------------------
+
+// PRIVATE ACCESSORS
+inline
+int ThreadCachingMultipool::findPool(int size) const
+{
+    BSLS_ASSERT_SAFE(0    <= size);
+    BSLS_ASSERT_SAFE(size <= d_maxBlockSize);
+
+    int accumulator = ((size + 7) >> 3) * 2 - 1;
+
+    accumulator |= accumulator >> 16;
+    accumulator |= accumulator >>  8;
+    accumulator |= accumulator >>  4;
+    accumulator |= accumulator >>  2;
+    accumulator |= accumulator >>  1;
+
+    unsigned input = accumulator;
+
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+    return __builtin_popcount(input) - 1;
+#else
+    input -= (input >> 1) & 0x55555555;
+
+    {
+        const int mask = 0x33333333;
+        input = ((input >> 2) & mask) + (input & mask);
+    }
+
+    input = ((input >>  4) + input) & 0x0f0f0f0f;
+    input =  (input >>  8) + input;
+    input =  (input >> 16) + input;
+
+    return (input & 0x000000ff) - 1;
+#endif
+}
+
+// MANIPULATORS
+inline
+void *ThreadCachingMultipool::allocate(int size)
+{
+    BSLS_ASSERT(1 <= size);
+
+    if (size <= d_maxBlockSize) {
+        const int  pool     = findPool(size);
+        Magazine&  magazine = d_magazineCache.threadMagazines()[pool];
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(magazine.isEmpty())) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            refill(&magazine, pool);
+        }
+
+        Header *p = static_cast<Header *>(magazine.pop());
+        p->d_header.d_poolIdx = pool;
+        return p + 1;
+    }
+
+    // The requested size is large and will not be pooled.
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    Header *p = static_cast<Header *>(
+                                  d_blockList.allocate(size + sizeof(Header)));
+    p->d_header.d_poolIdx = -1;
+    return p + 1;
+}
+
+inline
+void ThreadCachingMultipool::deallocate(void *address)
+{
+    BSLS_ASSERT(address);
+
+    Header *h = static_cast<Header *>(address) - 1;
+
+    const int pool = h->d_header.d_poolIdx;
+
+    if (-1 == pool) {
+        bsls::BslLockGuard guard(&d_lock);
+
+        d_blockList.deallocate(h);
+        return;                                                       // RETURN
+    }
+
+    Magazine& magazine = d_magazineCache.threadMagazines()[pool];
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(magazine.isFull())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        drain(&magazine, pool);
+    }
+
+    magazine.push(h);
+}
+
+template <class TYPE>
+inline
+void ThreadCachingMultipool::deleteObject(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObject(object, this);
+}
+
+template <class TYPE>
+inline
+void ThreadCachingMultipool::deleteObjectRaw(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObjectRaw(object, this);
+}
+
+// ACCESSORS
+inline
+int ThreadCachingMultipool::numPools() const
+{
+    return d_numPools;
+}
+
+inline
+int ThreadCachingMultipool::maxPooledBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,367 @@
+// bdlma_threadheapmultipool.cpp                                      -*-C++-*-
+#include <bdlma_threadheapmultipool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_threadheapmultipool_cpp,"$Id$ $CSID$")
+
+#include <bslma_autodestructor.h>
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+
+#include <bsl_new.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+// TYPES
+enum {
+    DEFAULT_NUM_POOLS      = 10,  // default number of pools
+
+    DEFAULT_MAX_CHUNK_SIZE = 32,  // default maximum number of blocks per
+                                  // chunk
+
+    MIN_BLOCK_SIZE         =  8   // minimum block size (in bytes)
+};
+
+extern "C" void bdlma_ThreadHeapMultipool_abandonHeap(void *heap)
+{
+    typedef ThreadHeapMultipool::Heap Heap;
+
+    Heap *threadHeap = static_cast<Heap *>(heap);
+    threadHeap->d_owner_p->abandonHeap(threadHeap);
+}
+
+                    // -----------------------------------------
+                    // class ThreadHeapMultipool_LockedAllocator
+                    // -----------------------------------------
+
+// CREATORS
+ThreadHeapMultipool_LockedAllocator::ThreadHeapMultipool_LockedAllocator(
+                                              bslma::Allocator *basicAllocator)
+: d_allocator_p(basicAllocator)
+{
+    BSLS_ASSERT(basicAllocator);
+}
+
+ThreadHeapMultipool_LockedAllocator::~ThreadHeapMultipool_LockedAllocator()
+{
+}
+
+// MANIPULATORS
+void *ThreadHeapMultipool_LockedAllocator::allocate(size_type size)
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_allocator_p->allocate(size);
+}
+
+void ThreadHeapMultipool_LockedAllocator::deallocate(void *address)
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    d_allocator_p->deallocate(address);
+}
+
+                         // -------------------------
+                         // class ThreadHeapMultipool
+                         // -------------------------
+
+// PRIVATE MANIPULATORS
+void ThreadHeapMultipool::abandonHeap(Heap *heap)
+{
+    BSLS_ASSERT(heap);
+    BSLS_ASSERT(this == heap->d_owner_p);
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    heap->d_isAbandoned = true;
+}
+
+ThreadHeapMultipool::Heap *ThreadHeapMultipool::createHeap()
+{
+    Heap *heap = 0;
+
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        for (heap = d_heaps_p; heap; heap = heap->d_next_p) {
+            if (heap->d_isAbandoned) {
+                heap->d_isAbandoned = false;
+                break;
+            }
+        }
+
+        if (!heap) {
+            heap = static_cast<Heap *>(
+                                   d_lockedAllocator.allocate(sizeof(Heap)));
+
+            bslma::DeallocatorProctor<bslma::Allocator> autoHeapDeallocator(
+                                                          heap,
+                                                          &d_lockedAllocator);
+
+            heap->d_pools_p = static_cast<Pool *>(
+                   d_lockedAllocator.allocate(d_numPools * sizeof(Pool)));
+
+            bslma::DeallocatorProctor<bslma::Allocator> autoPoolsDeallocator(
+                                                          heap->d_pools_p,
+                                                          &d_lockedAllocator);
+            bslma::AutoDestructor<Pool> autoDtor(heap->d_pools_p, 0);
+
+            int blockSize = MIN_BLOCK_SIZE;
+            for (int i = 0; i < d_numPools; ++i, ++autoDtor, blockSize *= 2) {
+                new (heap->d_pools_p + i) Pool(blockSize + sizeof(Header),
+                                               d_growthStrategy,
+                                               d_maxBlocksPerChunk,
+                                               &d_lockedAllocator);
+            }
+
+            autoDtor.release();
+            autoPoolsDeallocator.release();
+            autoHeapDeallocator.release();
+
+            heap->d_owner_p     = this;
+            heap->d_isAbandoned = false;
+            heap->d_next_p      = d_heaps_p;
+            bsls::AtomicOperations::initPointer(&heap->d_remoteFrees, 0);
+
+            d_heaps_p = heap;
+            ++d_numHeaps;
+        }
+    }
+
+    heap->d_untilDrain = k_DRAIN_INTERVAL;
+
+    d_heapKey.setValue(heap);
+
+    // An adopted heap may have blocks queued since it was abandoned.
+
+    drain(heap);
+
+    return heap;
+}
+
+void ThreadHeapMultipool::drain(Heap *heap)
+{
+    BSLS_ASSERT(heap);
+
+    // The exchange is the only removal from the queue, so the queue is not
+    // subject to the ABA problem.
+
+    Header *h = static_cast<Header *>(
+                    bsls::AtomicOperations::swapPtrAcqRel(&heap->d_remoteFrees,
+                                                          0));
+
+    while (h) {
+        Header *next = h->d_header.d_info.d_next_p;
+        heap->d_pools_p[h->d_header.d_info.d_poolIdx].deallocate(h);
+        h = next;
+    }
+}
+
+void ThreadHeapMultipool::initialize()
+{
+    BSLS_ASSERT(1 <= d_numPools);
+    BSLS_ASSERT(1 <= d_maxBlocksPerChunk);
+
+    d_maxBlockSize = MIN_BLOCK_SIZE;
+    for (int i = 1; i < d_numPools; ++i) {
+        d_maxBlockSize *= 2;
+        BSLS_ASSERT(d_maxBlockSize > 0);
+    }
+}
+
+void ThreadHeapMultipool::remoteFree(Header *header)
+{
+    BSLS_ASSERT(header);
+
+    Heap *heap = header->d_header.d_info.d_heap_p;
+
+    BSLS_ASSERT(heap);
+
+    // The pool index is kept, and the heap is overwritten by the link.
+
+    void *head = bsls::AtomicOperations::getPtrRelaxed(&heap->d_remoteFrees);
+    for (;;) {
+        header->d_header.d_info.d_next_p = static_cast<Header *>(head);
+
+        void *previous = bsls::AtomicOperations::testAndSwapPtrAcqRel(
+                                                         &heap->d_remoteFrees,
+                                                         head,
+                                                         header);
+        if (previous == head) {
+            break;
+        }
+        head = previous;
+    }
+}
+
+// CREATORS
+ThreadHeapMultipool::ThreadHeapMultipool(bslma::Allocator *basicAllocator)
+: d_lockedAllocator(bslma::Default::allocator(basicAllocator))
+, d_numPools(DEFAULT_NUM_POOLS)
+, d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
+, d_maxBlocksPerChunk(DEFAULT_MAX_CHUNK_SIZE)
+, d_blockList(&d_lockedAllocator)
+, d_heaps_p(0)
+, d_numHeaps(0)
+, d_heapKey(&bdlma_ThreadHeapMultipool_abandonHeap)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize();
+}
+
+ThreadHeapMultipool::ThreadHeapMultipool(int               numPools,
+                                         bslma::Allocator *basicAllocator)
+: d_lockedAllocator(bslma::Default::allocator(basicAllocator))
+, d_numPools(numPools)
+, d_growthStrategy(bsls::BlockGrowth::BSLS_GEOMETRIC)
+, d_maxBlocksPerChunk(DEFAULT_MAX_CHUNK_SIZE)
+, d_blockList(&d_lockedAllocator)
+, d_heaps_p(0)
+, d_numHeaps(0)
+, d_heapKey(&bdlma_ThreadHeapMultipool_abandonHeap)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numPools);
+
+    initialize();
+}
+
+ThreadHeapMultipool::ThreadHeapMultipool(
+                                  bsls::BlockGrowth::Strategy  growthStrategy,
+                                  bslma::Allocator            *basicAllocator)
+: d_lockedAllocator(bslma::Default::allocator(basicAllocator))
+, d_numPools(DEFAULT_NUM_POOLS)
+, d_growthStrategy(growthStrategy)
+, d_maxBlocksPerChunk(DEFAULT_MAX_CHUNK_SIZE)
+, d_blockList(&d_lockedAllocator)
+, d_heaps_p(0)
+, d_numHeaps(0)
+, d_heapKey(&bdlma_ThreadHeapMultipool_abandonHeap)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize();
+}
+
+ThreadHeapMultipool::ThreadHeapMultipool(
+                                  int                          numPools,
+                                  bsls::BlockGrowth::Strategy  growthStrategy,
+                                  bslma::Allocator            *basicAllocator)
+: d_lockedAllocator(bslma::Default::allocator(basicAllocator))
+, d_numPools(numPools)
+, d_growthStrategy(growthStrategy)
+, d_maxBlocksPerChunk(DEFAULT_MAX_CHUNK_SIZE)
+, d_blockList(&d_lockedAllocator)
+, d_heaps_p(0)
+, d_numHeaps(0)
+, d_heapKey(&bdlma_ThreadHeapMultipool_abandonHeap)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numPools);
+
+    initialize();
+}
+
+ThreadHeapMultipool::ThreadHeapMultipool(
+                                int                          numPools,
+                                bsls::BlockGrowth::Strategy  growthStrategy,
+                                int                          maxBlocksPerChunk,
+                                bslma::Allocator            *basicAllocator)
+: d_lockedAllocator(bslma::Default::allocator(basicAllocator))
+, d_numPools(numPools)
+, d_growthStrategy(growthStrategy)
+, d_maxBlocksPerChunk(maxBlocksPerChunk)
+, d_blockList(&d_lockedAllocator)
+, d_heaps_p(0)
+, d_numHeaps(0)
+, d_heapKey(&bdlma_ThreadHeapMultipool_abandonHeap)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numPools);
+    BSLS_ASSERT(1 <= maxBlocksPerChunk);
+
+    initialize();
+}
+
+ThreadHeapMultipool::~ThreadHeapMultipool()
+{
+    BSLS_ASSERT(1 <= d_numPools);
+    BSLS_ASSERT(1 <= d_maxBlockSize);
+    BSLS_ASSERT(d_allocator_p);
+
+    // The remote-free queues need not be drained, as the pools are about to
+    // be released.
+
+    while (d_heaps_p) {
+        Heap *next = d_heaps_p->d_next_p;
+
+        for (int i = 0; i < d_numPools; ++i) {
+            d_heaps_p->d_pools_p[i].release();
+            d_heaps_p->d_pools_p[i].~Pool();
+        }
+        d_allocator_p->deallocate(d_heaps_p->d_pools_p);
+        d_allocator_p->deallocate(d_heaps_p);
+
+        d_heaps_p = next;
+    }
+
+    d_blockList.release();
+}
+
+// MANIPULATORS
+void ThreadHeapMultipool::drainRemoteFrees()
+{
+    Heap *heap = static_cast<Heap *>(d_heapKey.value());
+
+    if (heap) {
+        drain(heap);
+    }
+}
+
+void ThreadHeapMultipool::release()
+{
+    for (Heap *heap = d_heaps_p; heap; heap = heap->d_next_p) {
+        bsls::AtomicOperations::setPtrRelaxed(&heap->d_remoteFrees, 0);
+
+        for (int i = 0; i < d_numPools; ++i) {
+            heap->d_pools_p[i].release();
+        }
+    }
+    d_blockList.release();
+}
+
+void ThreadHeapMultipool::reserveCapacity(int size, int numBlocks)
+{
+    BSLS_ASSERT(1    <= size);
+    BSLS_ASSERT(size <= d_maxBlockSize);
+    BSLS_ASSERT(0    <= numBlocks);
+
+    threadHeap()->d_pools_p[findPool(size)].reserveCapacity(numBlocks);
+}
+
+// ACCESSORS
+int ThreadHeapMultipool::numHeaps() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_numHeaps;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
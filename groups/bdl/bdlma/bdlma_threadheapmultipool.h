@@ -0,0 +1,711 @@
+// bdlma_threadheapmultipool.h                                        -*-C++-*-
+#ifndef INCLUDED_BDLMA_THREADHEAPMULTIPOOL
+#define INCLUDED_BDLMA_THREADHEAPMULTIPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-safe multipool with per-thread owning heaps.
+//
+//@CLASSES:
+//  bdlma::ThreadHeapMultipool: multipool with remote-free queues per thread
+//
+//@SEE_ALSO: bdlma_multipool, bdlma_threadcachingmultipool
+//
+//@DESCRIPTION: This component implements a thread-safe memory manager,
+// 'bdlma::ThreadHeapMultipool', that dispenses maximally-aligned memory blocks
+// of varying sizes from arrays of 'bdlma::Pool' objects, exactly as a
+// 'bdlma::Multipool' does, but that may be shared by many threads without
+// external synchronization, and is optimized for blocks that are deallocated
+// by a thread other than the one that allocated them (e.g., messages passed
+// from a producer thread to a consumer thread).  The block size of the first
+// pool is eight bytes, with each successive pool managing blocks of a size
+// twice that of the previous pool.  Requests larger than the block size of the
+// last pool are satisfied from a separately managed list of memory blocks.
+//
+// Each thread that allocates from a 'bdlma::ThreadHeapMultipool' is given its
+// own *heap*, an array of pools used only by that thread, and every pooled
+// block records in its header the heap that owns it.  Allocation is always
+// satisfied from the calling thread's heap, and a block deallocated by the
+// thread owning its heap is returned directly to that heap.  Neither
+// operation takes a lock or performs an atomic read-modify-write operation.
+//
+// A block deallocated by any other thread (a *remote free*) is instead pushed
+// onto its owning heap's remote-free queue, a lock-free singly-linked list
+// that is shared by all deallocating threads and is separated from the rest of
+// the heap so that pushing does not disturb the owner.  The owning thread
+// takes the entire queue with one atomic exchange, and returns its blocks to
+// its pools, once every few allocations, or when 'drainRemoteFrees' is called.
+// Remote frees therefore neither contend with the owner nor migrate blocks
+// between heaps: a block always returns to the heap that dispensed it, so
+// that a producer's heap does not grow without bound while a consumer's heap
+// accumulates the producer's blocks, as happens with per-thread caches.
+//
+// A 'bdlma::ThreadHeapMultipool' can be depicted visually:
+//..
+//   producer heap                consumer (no heap needed to deallocate)
+//   =============                ========
+//  |  8 bytes    |--o-o         |        |
+//  >=============<               ========
+//  | 16 bytes    |--o               |
+//  >=============<                  | remote free (lock-free push)
+//  |    ...      |                  V
+//  >=============<         ------- ------- -------
+//  | remote-free |------->| block |-| block |-| ... |
+//   =============          ------- ------- -------
+//        ^                            |
+//        +---- drained in one batch --+
+//              by the producer
+//..
+// When a thread that owns a heap exits, its heap is *abandoned* rather than
+// destroyed, because blocks it dispensed may still be in use elsewhere.
+// Remote frees continue to be queued to an abandoned heap, and the next thread
+// to need a heap adopts it (draining its queue), so that the number of heaps
+// is bounded by the maximum number of threads that concurrently allocate.
+//
+///Thread Safety
+///-------------
+// 'allocate', 'deallocate', 'deleteObject', 'deleteObjectRaw',
+// 'drainRemoteFrees', 'reserveCapacity', and the accessors may be called
+// concurrently from any number of threads.  'release' must *not* be called
+// concurrently with any other method, and the behavior is undefined if any
+// block obtained before 'release' is subsequently deallocated.
+//
+// The basic allocator need not be thread-safe; it is only ever used while
+// holding an internal lock.
+//
+// On POSIX platforms, a thread's heap is abandoned when that thread exits.  On
+// Windows, heaps are never abandoned, and are released only when the
+// multipool is destroyed.  In either case, the behavior is undefined if a
+// thread that has used a 'bdlma::ThreadHeapMultipool' exits while that
+// multipool is being destroyed.
+//
+///Configuration at Construction
+///-----------------------------
+// When creating a 'bdlma::ThreadHeapMultipool', clients can optionally
+// configure the NUMBER OF POOLS, the GROWTH STRATEGY, the MAX BLOCKS PER
+// CHUNK, and the BASIC ALLOCATOR exactly as for 'bdlma::Multipool' (see
+// 'bdlma_multipool').  Each heap has its own array of pools configured
+// accordingly.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Passing Messages Between Threads
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a producer thread builds messages that a consumer thread
+// processes and discards.  A 'bdlma::Multipool' owned by the producer cannot
+// be used, since the consumer would deallocate from it concurrently with the
+// producer's allocations, and guarding it with a mutex serializes both
+// threads.  Instead, we share one 'bdlma::ThreadHeapMultipool'.
+//
+// First, we define a simple message type and a function that the producer
+// runs to build a message:
+//..
+//  struct Message {
+//      int  d_sequence;
+//      char d_payload[60];
+//  };
+//
+//  Message *produce(bdlma::ThreadHeapMultipool *pool, int sequence)
+//      // Return a new message having the specified 'sequence' number,
+//      // allocated from the specified 'pool'.
+//  {
+//      Message *message = static_cast<Message *>(
+//                                            pool->allocate(sizeof(Message)));
+//      message->d_sequence = sequence;
+//      memset(message->d_payload, 'x', sizeof message->d_payload);
+//      return message;
+//  }
+//..
+// Then, we define the function that the consumer runs to discard a message,
+// which returns the message to the heap of the producer without taking a
+// lock:
+//..
+//  void consume(bdlma::ThreadHeapMultipool *pool, Message *message)
+//      // Process and deallocate the specified 'message', which was allocated
+//      // from the specified 'pool'.
+//  {
+//      assert(0 <= message->d_sequence);
+//      pool->deallocate(message);
+//  }
+//..
+// Now, we create the shared multipool, and the producer builds a batch of
+// messages (in a real application, the messages would be handed to the
+// consumer through a queue):
+//..
+//  bdlma::ThreadHeapMultipool pool;
+//
+//  Message *messages[8];
+//  for (int i = 0; i < 8; ++i) {
+//      messages[i] = produce(&pool, i);
+//  }
+//  assert(1 == pool.numHeaps());
+//..
+// Finally, the consumer discards the messages.  When the consumer is the
+// producer itself (as here), the messages are returned to the heap directly;
+// otherwise they are queued to the producer's heap, which reuses them once
+// the producer drains its queue:
+//..
+//  for (int i = 0; i < 8; ++i) {
+//      consume(&pool, messages[i]);
+//  }
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_POOL
+#include <bdlma_pool.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BLOCKGROWTH
+#include <bsls_blockgrowth.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLTHREADSPECIFIC
+#include <bsls_bslthreadspecific.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+extern "C" void bdlma_ThreadHeapMultipool_abandonHeap(void *heap);
+    // Mark the specified 'heap' as abandoned by the thread that owned it, so
+    // that it may be adopted by another thread of the 'ThreadHeapMultipool'
+    // that owns it.  Note that this function is invoked when a thread that
+    // allocated from a 'ThreadHeapMultipool' exits, and is *not* intended for
+    // direct use by client code.
+
+                    // =========================================
+                    // class ThreadHeapMultipool_LockedAllocator
+                    // =========================================
+
+class ThreadHeapMultipool_LockedAllocator : public bslma::Allocator {
+    // This component-private class implements the 'bslma::Allocator' protocol
+    // by forwarding each request to another allocator while holding a lock,
+    // so that the pools of all heaps of a 'ThreadHeapMultipool' may replenish
+    // concurrently from an allocator that need not be thread-safe.
+
+    // DATA
+    bsls::BslLock     d_lock;         // serializes requests
+
+    bslma::Allocator *d_allocator_p;  // allocator to which requests are
+                                      // forwarded (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadHeapMultipool_LockedAllocator(
+                                   const ThreadHeapMultipool_LockedAllocator&);
+    ThreadHeapMultipool_LockedAllocator& operator=(
+                                   const ThreadHeapMultipool_LockedAllocator&);
+
+  public:
+    // CREATORS
+    explicit
+    ThreadHeapMultipool_LockedAllocator(bslma::Allocator *basicAllocator);
+        // Create an allocator forwarding requests to the specified
+        // 'basicAllocator'.  The behavior is undefined unless
+        // 'basicAllocator' is non-zero.
+
+    virtual ~ThreadHeapMultipool_LockedAllocator();
+        // Destroy this allocator.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return the address of a block of at least the specified 'size' (in
+        // bytes) obtained from the underlying allocator while holding the
+        // lock of this object.
+
+    virtual void deallocate(void *address);
+        // Return the block at the specified 'address' to the underlying
+        // allocator while holding the lock of this object.
+};
+
+                         // =========================
+                         // class ThreadHeapMultipool
+                         // =========================
+
+class ThreadHeapMultipool {
+    // This class implements a thread-safe memory manager that maintains, for
+    // each thread that allocates from it, a heap of a configurable number of
+    // 'bdlma::Pool' objects, each dispensing memory blocks of a unique size.
+    // Allocation is satisfied from the calling thread's heap.  Deallocation
+    // returns a block directly to its heap if the calling thread owns that
+    // heap, and otherwise pushes the block onto the heap's lock-free
+    // remote-free queue, which the owner drains in batches.  Requests that
+    // exceed the largest pooled block size are satisfied from a separately
+    // managed list of memory blocks.  Both the 'release' method and the
+    // destructor of a 'bdlma::ThreadHeapMultipool' release all memory
+    // currently allocated via the object.
+
+    // PRIVATE TYPES
+    typedef bsls::AtomicOperations::AtomicTypes::Pointer AtomicPointer;
+
+    struct Heap;
+
+    struct Header {
+        // This 'struct' provides header information for each allocated memory
+        // block.
+
+        struct Info {
+            union {
+                Heap   *d_heap_p;   // heap owning this block, or 0 if from
+                                    // 'd_blockList'
+
+                Header *d_next_p;   // next block in the remote-free queue of
+                                    // the owning heap, while queued
+            };
+
+            int         d_poolIdx;  // index to pool used for this memory
+                                    // block, or -1 if from 'd_blockList'
+        };
+
+        union {
+            Info                                d_info;
+            bsls::AlignmentUtil::MaxAlignedType d_dummy;  // force maximum
+                                                          // alignment
+        } d_header;
+    };
+
+    enum {
+        k_CACHE_LINE_SIZE = 64,  // size of the padding separating the
+                                 // remote-free queue from the owner's data
+
+        k_DRAIN_INTERVAL  = 32   // number of allocations from a heap between
+                                 // checks of its remote-free queue
+    };
+
+    struct Heap {
+        // This 'struct' holds the pools of one thread, and its remote-free
+        // queue.
+
+        Pool                *d_pools_p;          // array of 'd_numPools'
+                                                 // pools
+
+        ThreadHeapMultipool *d_owner_p;          // multipool owning this
+                                                 // heap
+
+        Heap                *d_next_p;           // next heap of owner
+
+        int                  d_untilDrain;       // allocations until the
+                                                 // remote-free queue is
+                                                 // checked
+
+        bool                 d_isAbandoned;      // 'true' if no thread owns
+                                                 // this heap (guarded by
+                                                 // 'd_owner_p->d_lock')
+
+        char                 d_padding[k_CACHE_LINE_SIZE];
+                                                 // keep 'd_remoteFrees' off
+                                                 // the cache line of the
+                                                 // fields above
+
+        AtomicPointer        d_remoteFrees;      // lock-free stack of blocks
+                                                 // deallocated by other
+                                                 // threads
+    };
+
+    // DATA
+    ThreadHeapMultipool_LockedAllocator
+                             d_lockedAllocator;  // serializes requests to
+                                                 // 'd_allocator_p' from all
+                                                 // heaps
+
+    int                      d_numPools;         // number of memory pools
+                                                 // per heap
+
+    int                      d_maxBlockSize;     // largest memory block size;
+                                                 // dispensed by the
+                                                 // 'd_numPools - 1'th pool;
+                                                 // always a power of 2
+
+    bsls::BlockGrowth::Strategy
+                             d_growthStrategy;   // growth strategy of every
+                                                 // pool
+
+    int                      d_maxBlocksPerChunk;
+                                                 // maximum chunk size of every
+                                                 // pool
+
+    BlockList                d_blockList;        // memory manager for "large"
+                                                 // memory blocks
+
+    Heap                    *d_heaps_p;          // list of all heaps
+
+    int                      d_numHeaps;         // number of heaps in
+                                                 // 'd_heaps_p'
+
+    mutable bsls::BslLock    d_lock;             // guards block list, and
+                                                 // heap list
+
+    bsls::BslThreadSpecific  d_heapKey;          // calling thread's heap
+
+    bslma::Allocator        *d_allocator_p;      // holds (but does not own)
+                                                 // allocator
+
+    // FRIENDS
+    friend void bdlma_ThreadHeapMultipool_abandonHeap(void *);
+
+  private:
+    // PRIVATE MANIPULATORS
+    void abandonHeap(Heap *heap);
+        // Mark the specified 'heap' as owned by no thread.
+
+    Heap *createHeap();
+        // Associate with the calling thread an abandoned heap of this
+        // multipool if there is one, and a new heap having an empty pool of
+        // each size otherwise.  Return the address of the heap.
+
+    void drain(Heap *heap);
+        // Return every block in the remote-free queue of the specified 'heap'
+        // to its pool.  The behavior is undefined unless the calling thread
+        // owns 'heap'.
+
+    void initialize();
+        // Initialize the maximum block size of this multipool.
+
+    void remoteFree(Header *header);
+        // Push the block having the specified 'header' onto the remote-free
+        // queue of its heap.
+
+    Heap *threadHeap();
+        // Return the address of the heap of the calling thread, creating it
+        // if necessary.
+
+    // PRIVATE ACCESSORS
+    int findPool(int size) const;
+        // Return the index of the memory pool in a heap for an allocation
+        // request of the specified 'size' (in bytes).  The behavior is
+        // undefined unless '0 <= size <= maxPooledBlockSize()'.  Note that the
+        // index of the memory pool managing memory blocks having the minimum
+        // block size is 0.
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadHeapMultipool(const ThreadHeapMultipool&);
+    ThreadHeapMultipool& operator=(const ThreadHeapMultipool&);
+
+  public:
+    // CREATORS
+    explicit
+    ThreadHeapMultipool(bslma::Allocator            *basicAllocator = 0);
+    explicit
+    ThreadHeapMultipool(int                          numPools,
+                        bslma::Allocator            *basicAllocator = 0);
+    explicit
+    ThreadHeapMultipool(bsls::BlockGrowth::Strategy  growthStrategy,
+                        bslma::Allocator            *basicAllocator = 0);
+    ThreadHeapMultipool(int                          numPools,
+                        bsls::BlockGrowth::Strategy  growthStrategy,
+                        bslma::Allocator            *basicAllocator = 0);
+    ThreadHeapMultipool(int                          numPools,
+                        bsls::BlockGrowth::Strategy  growthStrategy,
+                        int                          maxBlocksPerChunk,
+                        bslma::Allocator            *basicAllocator = 0);
+        // Create a thread-heap multipool memory manager.  Optionally specify
+        // 'numPools', indicating the number of 'bdlma::Pool' objects in the
+        // heap of each thread; the block size of the first pool is 8 bytes,
+        // with the block size of each additional pool successively doubling.
+        // If 'numPools' is not specified, an implementation-defined number of
+        // pools 'N' -- covering memory blocks ranging in size from '2^3 = 8'
+        // to '2^(N+2)' -- are created.  Optionally specify a 'growthStrategy'
+        // indicating whether the number of blocks allocated at once for every
+        // 'bdlma::Pool' should be either fixed or grow geometrically, starting
+        // with 1.  If 'growthStrategy' is not specified, geometric growth is
+        // used.  If 'numPools' and 'growthStrategy' are specified, optionally
+        // specify a 'maxBlocksPerChunk', indicating the maximum number of
+        // blocks to be allocated at once when a pool must be replenished.  If
+        // 'maxBlocksPerChunk' is not specified, an implementation-defined
+        // value is used.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '1 <= numPools' and '1 <= maxBlocksPerChunk'.
+
+    ~ThreadHeapMultipool();
+        // Destroy this multipool.  All memory allocated from this multipool,
+        // including the heaps of all threads, is released.
+
+    // MANIPULATORS
+    void *allocate(int size);
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes).  If
+        // 'size > maxPooledBlockSize()', the memory allocation is managed
+        // directly by the underlying allocator, and will not be pooled, but
+        // will be deallocated when the 'release' method is called, or when
+        // this object is destroyed.  The behavior is undefined unless
+        // '1 <= size'.
+
+    void deallocate(void *address);
+        // Relinquish the memory block at the specified 'address' back to this
+        // multipool object for reuse.  If the calling thread does not own the
+        // heap from which the block was allocated, the block is queued to
+        // that heap, and becomes available for reuse after its owner drains
+        // its remote-free queue.  The behavior is undefined unless 'address'
+        // is non-zero, was allocated by this multipool object, and has not
+        // already been deallocated.
+
+    template <class TYPE>
+    void deleteObject(const TYPE *object);
+        // Destroy the specified 'object' based on its dynamic type and then
+        // use this multipool object to deallocate its memory footprint.  This
+        // method has no effect if 'object' is 0.  The behavior is undefined
+        // unless 'object', when cast appropriately to 'void *', was allocated
+        // using this multipool object and has not already been deallocated.
+        // Note that 'dynamic_cast<void *>(object)' is applied if 'TYPE' is
+        // polymorphic, and 'static_cast<void *>(object)' is applied otherwise.
+
+    template <class TYPE>
+    void deleteObjectRaw(const TYPE *object);
+        // Destroy the specified 'object' and then use this multipool to
+        // deallocate its memory footprint.  This method has no effect if
+        // 'object' is 0.  The behavior is undefined unless 'object' is !not! a
+        // secondary base class pointer (i.e., the address is (numerically) the
+        // same as when it was originally dispensed by this multipool), was
+        // allocated using this multipool, and has not already been
+        // deallocated.
+
+    void drainRemoteFrees();
+        // Make the blocks allocated by the calling thread and since
+        // deallocated by other threads available for reuse by the calling
+        // thread.  This method has no effect if the calling thread has not
+        // allocated from this multipool.  Note that the queue of remote frees
+        // is also drained periodically by 'allocate'.
+
+    void release();
+        // Relinquish all memory currently allocated via this multipool object,
+        // and empty the remote-free queues of all heaps.  The behavior is
+        // undefined if this method is called concurrently with any other
+        // method of this object.
+
+    void reserveCapacity(int size, int numBlocks);
+        // Reserve memory from this multipool to satisfy memory requests by the
+        // calling thread for at least the specified 'numBlocks' having the
+        // specified 'size' (in bytes) before the pool of the calling thread's
+        // heap replenishes.  The behavior is undefined unless
+        // '1 <= size <= maxPooledBlockSize()' and '0 <= numBlocks'.
+
+    // ACCESSORS
+    int numHeaps() const;
+        // Return the number of heaps of this multipool, including abandoned
+        // heaps.
+
+    int numPools() const;
+        // Return the number of pools in each heap of this multipool object.
+
+    int maxPooledBlockSize() const;
+        // Return the maximum size of memory blocks that are pooled by this
+        // multipool object.  Note that the maximum value is defined as:
+        //..
+        //  2 ^ (numPools + 2)
+        //..
+        // where 'numPools' is either specified at construction, or an
+        // implementation-defined value.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // class ThreadHeapMultipool
+                         // -------------------------
+
+// PRIVATE MANIPULATORS
+inline
+ThreadHeapMultipool::Heap *ThreadHeapMultipool::threadHeap()
+{
+    Heap *heap = static_cast<Heap *>(d_heapKey.value());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!heap)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        heap = createHeap();
+    }
+    return heap;
+}
+
+// PRIVATE ACCESSORS
+inline
+int ThreadHeapMultipool::findPool(int size) const
+{
+    BSLS_ASSERT_SAFE(0    <= size);
+    BSLS_ASSERT_SAFE(size <= d_maxBlockSize);
+
+    int accumulator = ((size + 7) >> 3) * 2 - 1;
+
+    accumulator |= accumulator >> 16;
+    accumulator |= accumulator >>  8;
+    accumulator |= accumulator >>  4;
+    accumulator |= accumulator >>  2;
+    accumulator |= accumulator >>  1;
+
+    unsigned input = accumulator;
+
+#if defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG)
+    return __builtin_popcount(input) - 1;
+#else
+    input -= (input >> 1) & 0x55555555;
+
+    {
+        const int mask = 0x33333333;
+        input = ((input >> 2) & mask) + (input & mask);
+    }
+
+    input = ((input >>  4) + input) & 0x0f0f0f0f;
+    input =  (input >>  8) + input;
+    input =  (input >> 16) + input;
+
+    return (input & 0x000000ff) - 1;
+#endif
+}
+
+// MANIPULATORS
+inline
+void *ThreadHeapMultipool::allocate(int size)
+{
+    BSLS_ASSERT(1 <= size);
+
+    if (size <= d_maxBlockSize) {
+        const int  pool = findPool(size);
+        Heap      *heap = threadHeap();
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == --heap->d_untilDrain)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            heap->d_untilDrain = k_DRAIN_INTERVAL;
+            if (bsls::AtomicOperations::getPtrRelaxed(&heap->d_remoteFrees)) {
+                drain(heap);
+            }
+        }
+
+        Header *p = static_cast<Header *>(heap->d_pools_p[pool].allocate());
+        p->d_header.d_info.d_heap_p  = heap;
+        p->d_header.d_info.d_poolIdx = pool;
+        return p + 1;
+    }
+
+    // The requested size is large and will not be pooled.
+
+    bsls::BslLockGuard guard(&d_lock);
+
+    Header *p = static_cast<Header *>(
+                                  d_blockList.allocate(size + sizeof(Header)));
+    p->d_header.d_info.d_heap_p  = 0;
+    p->d_header.d_info.d_poolIdx = -1;
+    return p + 1;
+}
+
+inline
+void ThreadHeapMultipool::deallocate(void *address)
+{
+    BSLS_ASSERT(address);
+
+    Header *h = static_cast<Header *>(address) - 1;
+
+    const int pool = h->d_header.d_info.d_poolIdx;
+
+    if (-1 == pool) {
+        bsls::BslLockGuard guard(&d_lock);
+
+        d_blockList.deallocate(h);
+        return;                                                       // RETURN
+    }
+
+    Heap *heap = h->d_header.d_info.d_heap_p;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(heap == d_heapKey.value())) {
+        heap->d_pools_p[pool].deallocate(h);
+        return;                                                       // RETURN
+    }
+
+    remoteFree(h);
+}
+
+template <class TYPE>
+inline
+void ThreadHeapMultipool::deleteObject(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObject(object, this);
+}
+
+template <class TYPE>
+inline
+void ThreadHeapMultipool::deleteObjectRaw(const TYPE *object)
+{
+    bslma::DeleterHelper::deleteObjectRaw(object, this);
+}
+
+// ACCESSORS
+inline
+int ThreadHeapMultipool::numPools() const
+{
+    return d_numPools;
+}
+
+inline
+int ThreadHeapMultipool::maxPooledBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1295 @@
+// bdlma_threadheapmultipool.t.cpp                                    -*-C++-*-
+#include <bdlma_threadheapmultipool.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// A 'bdlma::ThreadHeapMultipool' is a mechanism (i.e., having state but no
+// value) that is used as a thread-safe memory manager.  It manages, for each
+// thread that allocates from it, a heap of 'bdlma::Pool' objects having a
+// lock-free queue of blocks deallocated by other threads, and a list of
+// "large" blocks that are not pooled.
+//
+// Primary testing concerns are: 1) that the manipulators dispense blocks of
+// the requested size and alignment, and reuse deallocated blocks, 2) that
+// memory is obtained from, and returned to, the allocator supplied at
+// construction, 3) that a block deallocated by another thread returns to the
+// heap that dispensed it, and is reused once that heap drains its queue, 4)
+// that the heap of an exited thread is adopted by the next thread needing a
+// heap, and 5) that many threads may allocate and deallocate concurrently,
+// including deallocating blocks allocated by other threads, without
+// corrupting the blocks they own.  The 'bslma_testallocator' component is used
+// to verify the memory usage of the multipool.
+//-----------------------------------------------------------------------------
+// [ 2] ThreadHeapMultipool(Allocator *ba = 0);
+// [ 2] ThreadHeapMultipool(numPools, Allocator *ba = 0);
+// [ 2] ThreadHeapMultipool(gs, Allocator *ba = 0);
+// [ 2] ThreadHeapMultipool(numPools, gs, Allocator *ba = 0);
+// [ 2] ThreadHeapMultipool(numPools, gs, mbpc, Allocator *ba = 0);
+// [ 2] ~ThreadHeapMultipool();
+// [ 3] void *allocate(int size);
+// [ 3] void deallocate(void *address);
+// [ 4] template <class TYPE> void deleteObject(const TYPE *object);
+// [ 4] template <class TYPE> void deleteObjectRaw(const TYPE *object);
+// [ 6] void drainRemoteFrees();
+// [ 5] void release();
+// [ 5] void reserveCapacity(int size, int numBlocks);
+// [ 6] int numHeaps() const;
+// [ 2] int numPools() const;
+// [ 2] int maxPooledBlockSize() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] CONCERN: Remote frees return blocks to the dispensing heap.
+// [ 6] CONCERN: The heap of an exited thread is adopted.
+// [ 7] CONCERN: Concurrent allocation and deallocation is thread-safe.
+// [ 8] USAGE EXAMPLE
+// [ *] CONCERN: Precondition violations are detected when enabled.
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                       GLOBAL TYPES AND CONSTANTS
+//-----------------------------------------------------------------------------
+
+typedef bdlma::ThreadHeapMultipool Obj;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+//=============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+struct DeallocateArgs {
+    Obj   *d_pool_p;       // multipool from which the blocks were allocated
+    void **d_blocks_p;     // blocks to deallocate
+    int    d_numBlocks;    // number of blocks to deallocate
+};
+
+extern "C" void *deallocateThread(void *arg)
+    // Deallocate the blocks described by the specified 'arg'.
+{
+    DeallocateArgs& args = *static_cast<DeallocateArgs *>(arg);
+
+    for (int i = 0; i < args.d_numBlocks; ++i) {
+        args.d_pool_p->deallocate(args.d_blocks_p[i]);
+    }
+    return arg;
+}
+
+static
+void deallocateInThread(Obj *pool, void **blocks, int numBlocks)
+    // Deallocate the specified 'numBlocks' blocks at the specified 'blocks'
+    // from the specified 'pool' in a new thread, and wait for the thread to
+    // exit.
+{
+    DeallocateArgs args = { pool, blocks, numBlocks };
+
+    joinThread(createThread(&deallocateThread, &args));
+}
+
+struct AllocateArgs {
+    Obj   *d_pool_p;       // multipool from which to allocate
+    void **d_blocks_p;     // blocks allocated
+    int    d_numBlocks;    // number of blocks to allocate
+    int    d_size;         // size of each block
+};
+
+extern "C" void *allocateThread(void *arg)
+    // Allocate the blocks described by the specified 'arg'.
+{
+    AllocateArgs& args = *static_cast<AllocateArgs *>(arg);
+
+    for (int i = 0; i < args.d_numBlocks; ++i) {
+        args.d_blocks_p[i] = args.d_pool_p->allocate(args.d_size);
+    }
+    return arg;
+}
+
+static
+void allocateInThread(Obj *pool, void **blocks, int numBlocks, int size)
+    // Load into the specified 'blocks' the specified 'numBlocks' blocks of
+    // the specified 'size' allocated from the specified 'pool' in a new
+    // thread, and wait for the thread to exit.
+{
+    AllocateArgs args = { pool, blocks, numBlocks, size };
+
+    joinThread(createThread(&allocateThread, &args));
+}
+
+static
+bool contains(void **blocks, int numBlocks, const void *block)
+    // Return 'true' if the specified 'block' is one of the specified
+    // 'numBlocks' blocks at the specified 'blocks', and 'false' otherwise.
+{
+    for (int i = 0; i < numBlocks; ++i) {
+        if (blocks[i] == block) {
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+}
+
+static
+bool isNaturallyAligned(const void *address, int size)
+    // Return 'true' if the specified 'address' is suitably aligned for an
+    // object of the specified 'size', and 'false' otherwise.  Note that, as
+    // for 'bdlma::Multipool', blocks of 8 bytes or fewer are not necessarily
+    // maximally aligned on platforms where
+    // '8 < bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT'.
+{
+    const int alignment =
+                     bsls::AlignmentUtil::calculateAlignmentFromSize(size);
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address) % alignment;
+}
+
+                                // ------
+                                // case 7
+                                // ------
+
+enum { NUM_THREADS = 16, NUM_ITERATIONS = 2000, NUM_SLOTS = 64 };
+
+struct ThreadArgs {
+    Obj             *d_pool_p;      // multipool shared by all threads
+    int              d_id;          // index of this thread
+    char           **d_handoff_p;   // blocks passed to the main thread
+    bsls::AtomicInt *d_errors_p;    // number of corrupted blocks detected
+};
+
+extern "C" void *workerThread(void *arg)
+    // Repeatedly allocate blocks of varying sizes from the shared multipool,
+    // fill them with a thread-specific pattern, verify the pattern, and
+    // deallocate them.  Hand off half of the blocks outstanding at the end to
+    // be deallocated by the main thread.
+{
+    ThreadArgs& args = *static_cast<ThreadArgs *>(arg);
+    Obj&        mX   = *args.d_pool_p;
+
+    const char pattern = static_cast<char>('A' + args.d_id);
+
+    char *slots[NUM_SLOTS];
+    int   sizes[NUM_SLOTS];
+
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        slots[i] = 0;
+    }
+
+    unsigned seed = args.d_id + 1;
+
+    for (int iter = 0; iter < NUM_ITERATIONS; ++iter) {
+        seed = seed * 1103515245 + 12345;
+
+        const int slot = (seed >> 8) % NUM_SLOTS;
+
+        if (slots[slot]) {
+            for (int j = 0; j < sizes[slot]; ++j) {
+                if (pattern != slots[slot][j]) {
+                    ++*args.d_errors_p;
+                    break;
+                }
+            }
+            mX.deallocate(slots[slot]);
+        }
+
+        sizes[slot] = 1 + (seed >> 16) % 600;
+        slots[slot] = static_cast<char *>(mX.allocate(sizes[slot]));
+
+        if (!isNaturallyAligned(slots[slot], sizes[slot])) {
+            ++*args.d_errors_p;
+        }
+        memset(slots[slot], pattern, sizes[slot]);
+    }
+
+    // Deallocate half of the outstanding blocks, and hand off the other half
+    // to be deallocated by the main thread.
+
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        if (i % 2) {
+            if (slots[i]) {
+                mX.deallocate(slots[i]);
+            }
+        }
+        else {
+            args.d_handoff_p[i / 2] = slots[i];
+        }
+    }
+
+    return arg;
+}
+
+enum { NUM_PAIRS = 4, NUM_MESSAGES = 20000, RING_SIZE = 256 };
+
+struct Ring {
+    // This 'struct' is a bounded queue of blocks passed from one producer
+    // thread to one consumer thread.
+
+    char            *d_slots[RING_SIZE];  // queued blocks
+    bsls::AtomicInt  d_numPushed;         // number of blocks ever pushed
+    bsls::AtomicInt  d_numPopped;         // number of blocks ever popped
+};
+
+struct PairArgs {
+    Obj             *d_pool_p;    // multipool shared by all threads
+    Ring            *d_ring_p;    // queue from the producer to the consumer
+    int              d_id;        // index of this producer/consumer pair
+    bsls::AtomicInt *d_errors_p;  // number of corrupted blocks detected
+};
+
+static
+void yieldThread()
+    // Yield the processor to another thread.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    Sleep(0);
+#else
+    sched_yield();
+#endif
+}
+
+extern "C" void *producerThread(void *arg)
+    // Allocate messages of varying sizes from the shared multipool, each
+    // holding its size followed by a pattern specific to this pair, and push
+    // them onto the ring of this pair.
+{
+    PairArgs& args = *static_cast<PairArgs *>(arg);
+    Ring&     ring = *args.d_ring_p;
+
+    for (int i = 0; i < NUM_MESSAGES; ++i) {
+        const int size = static_cast<int>(sizeof(int)) + (i * 37) % 300;
+
+        char *message = static_cast<char *>(args.d_pool_p->allocate(size));
+        memcpy(message, &size, sizeof size);
+        memset(message + sizeof size, 'A' + args.d_id, size - sizeof size);
+
+        while (i - ring.d_numPopped.loadAcquire() == RING_SIZE) {
+            yieldThread();
+        }
+        ring.d_slots[i % RING_SIZE] = message;
+        ring.d_numPushed.storeRelease(i + 1);
+    }
+    return arg;
+}
+
+extern "C" void *consumerThread(void *arg)
+    // Pop the messages from the ring of this pair, verify their contents, and
+    // deallocate them.
+{
+    PairArgs& args = *static_cast<PairArgs *>(arg);
+    Ring&     ring = *args.d_ring_p;
+
+    for (int i = 0; i < NUM_MESSAGES; ++i) {
+        while (i == ring.d_numPushed.loadAcquire()) {
+            yieldThread();
+        }
+        char *message = ring.d_slots[i % RING_SIZE];
+        ring.d_numPopped.storeRelease(i + 1);
+
+        int size;
+        memcpy(&size, message, sizeof size);
+        if (size != static_cast<int>(sizeof(int)) + (i * 37) % 300) {
+            ++*args.d_errors_p;
+        }
+        else {
+            for (int j = sizeof size; j < size; ++j) {
+                if ('A' + args.d_id != message[j]) {
+                    ++*args.d_errors_p;
+                    break;
+                }
+            }
+        }
+        args.d_pool_p->deallocate(message);
+    }
+    return arg;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Example 1: Passing Messages Between Threads
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a producer thread builds messages that a consumer thread
+// processes and discards.  A 'bdlma::Multipool' owned by the producer cannot
+// be used, since the consumer would deallocate from it concurrently with the
+// producer's allocations, and guarding it with a mutex serializes both
+// threads.  Instead, we share one 'bdlma::ThreadHeapMultipool'.
+//
+// First, we define a simple message type and a function that the producer
+// runs to build a message:
+//..
+    struct Message {
+        int  d_sequence;
+        char d_payload[60];
+    };
+
+    Message *produce(bdlma::ThreadHeapMultipool *pool, int sequence)
+        // Return a new message having the specified 'sequence' number,
+        // allocated from the specified 'pool'.
+    {
+        Message *message = static_cast<Message *>(
+                                              pool->allocate(sizeof(Message)));
+        message->d_sequence = sequence;
+        memset(message->d_payload, 'x', sizeof message->d_payload);
+        return message;
+    }
+//..
+// Then, we define the function that the consumer runs to discard a message,
+// which returns the message to the heap of the producer without taking a
+// lock:
+//..
+    void consume(bdlma::ThreadHeapMultipool *pool, Message *message)
+        // Process and deallocate the specified 'message', which was allocated
+        // from the specified 'pool'.
+    {
+        ASSERT(0 <= message->d_sequence);
+        pool->deallocate(message);
+    }
+//..
+
+//=============================================================================
+//                                MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator  testAllocator(veryVeryVerbose);
+    bslma::Allocator     *Z = &testAllocator;
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+//..
+// Now, we create the shared multipool, and the producer builds a batch of
+// messages (in a real application, the messages would be handed to the
+// consumer through a queue):
+//..
+    bdlma::ThreadHeapMultipool pool;
+
+    Message *messages[8];
+    for (int i = 0; i < 8; ++i) {
+        messages[i] = produce(&pool, i);
+    }
+    ASSERT(1 == pool.numHeaps());
+//..
+// Finally, the consumer discards the messages.  When the consumer is the
+// producer itself (as here), the messages are returned to the heap directly;
+// otherwise they are queued to the producer's heap, which reuses them once
+// the producer drains its queue:
+//..
+    for (int i = 0; i < 8; ++i) {
+        consume(&pool, messages[i]);
+    }
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 Many threads may concurrently allocate and deallocate blocks of
+        //:   varying sizes from one multipool.
+        //:
+        //: 2 A block allocated by one thread may be deallocated by another
+        //:   thread.
+        //:
+        //: 3 A block is never dispensed to two threads at once.
+        //:
+        //: 4 All memory is returned to the allocator supplied at construction
+        //:   when the multipool is destroyed.
+        //:
+        //: 5 The heaps of exited threads are reused.
+        //:
+        //: 6 Blocks passed continuously from producer threads to consumer
+        //:   threads are reused by the producers, so that the memory used by
+        //:   the multipool does not grow with the number of blocks passed.
+        //
+        // Plan:
+        //: 1 Create several threads that each repeatedly allocate blocks of
+        //:   pseudo-random sizes (some exceeding the maximum pooled block
+        //:   size), fill each with a pattern unique to the thread, and verify
+        //:   that pattern before deallocating the block.  (C-1, 3)
+        //:
+        //: 2 Have each thread hand off half of its outstanding blocks to the
+        //:   main thread, which deallocates them after the thread exits.
+        //:   (C-2)
+        //:
+        //: 3 Repeat the whole procedure on the same multipool to exercise the
+        //:   reuse of blocks returned by exited threads.  Verify that no
+        //:   memory is outstanding in the test allocator after destroying the
+        //:   multipool, and (on platforms where heaps are abandoned) that
+        //:   there are no more heaps than threads in a round.  (C-4..5)
+        //:
+        //: 4 Create pairs of threads, in which the producer allocates messages
+        //:   of varying sizes and passes them through a lock-free queue to the
+        //:   consumer, which verifies and deallocates them.  Verify the
+        //:   contents of the messages, and that the memory obtained by the
+        //:   multipool is far less than the total size of the messages.
+        //:   (C-1..3, 6)
+        //
+        // Testing:
+        //   CONCERN: Concurrent allocation and deallocation is thread-safe.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONCURRENCY TEST"
+                          << endl << "================" << endl;
+
+        {
+            Obj mX(7, Z);  // pools of blocks from 8 to 512 bytes
+
+            bsls::AtomicInt errors(0);
+
+            for (int round = 0; round < 3; ++round) {
+                ThreadArgs  args[NUM_THREADS];
+                ThreadId    ids[NUM_THREADS];
+                char       *handoff[NUM_THREADS][NUM_SLOTS / 2];
+
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    args[i].d_pool_p    = &mX;
+                    args[i].d_id        = i;
+                    args[i].d_handoff_p = handoff[i];
+                    args[i].d_errors_p  = &errors;
+
+                    ids[i] = createThread(&workerThread, &args[i]);
+                }
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    joinThread(ids[i]);
+                }
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    for (int j = 0; j < NUM_SLOTS / 2; ++j) {
+                        if (handoff[i][j]) {
+                            mX.deallocate(handoff[i][j]);
+                        }
+                    }
+                }
+
+                LOOP_ASSERT(round, 0 == errors);
+
+                if (veryVerbose) {
+                    P_(round) P_(mX.numHeaps())
+                    P(testAllocator.numBlocksInUse())
+                }
+            }
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+            LOOP_ASSERT(mX.numHeaps(), NUM_THREADS >= mX.numHeaps());
+#endif
+        }
+        LOOP_ASSERT(testAllocator.numBlocksInUse(),
+                    0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nProducers and consumers." << endl;
+        {
+            Obj mX(Z);
+
+            bsls::AtomicInt errors(0);
+
+            Ring     rings[NUM_PAIRS];
+            PairArgs args[NUM_PAIRS];
+            ThreadId producers[NUM_PAIRS];
+            ThreadId consumers[NUM_PAIRS];
+
+            for (int i = 0; i < NUM_PAIRS; ++i) {
+                args[i].d_pool_p   = &mX;
+                args[i].d_ring_p   = &rings[i];
+                args[i].d_id       = i;
+                args[i].d_errors_p = &errors;
+
+                consumers[i] = createThread(&consumerThread, &args[i]);
+                producers[i] = createThread(&producerThread, &args[i]);
+            }
+            for (int i = 0; i < NUM_PAIRS; ++i) {
+                joinThread(producers[i]);
+                joinThread(consumers[i]);
+            }
+
+            ASSERT(0 == errors);
+
+            // Consumers only deallocate, so they have no heap.
+
+            LOOP_ASSERT(mX.numHeaps(), NUM_PAIRS >= mX.numHeaps());
+
+            // The messages passed total about 'NUM_PAIRS * NUM_MESSAGES * 150'
+            // (i.e., 12 million) bytes, whereas no more than 'RING_SIZE'
+            // messages per pair, plus those awaiting a drain, are in use at
+            // once.
+
+            if (veryVerbose) {
+                P(testAllocator.numBytesInUse())
+            }
+            LOOP_ASSERT(testAllocator.numBytesInUse(),
+                        4 * 1024 * 1024 > testAllocator.numBytesInUse());
+        }
+        LOOP_ASSERT(testAllocator.numBlocksInUse(),
+                    0 == testAllocator.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING REMOTE FREES AND ABANDONED HEAPS
+        //
+        // Concerns:
+        //: 1 A thread that only deallocates is not given a heap.
+        //:
+        //: 2 A block deallocated by a thread other than the owner of its heap
+        //:   is not reused before the owner drains its queue, and is then
+        //:   reused by the owner.
+        //:
+        //: 3 The owner drains its queue when 'drainRemoteFrees' is called, and
+        //:   periodically when allocating.
+        //:
+        //: 4 'drainRemoteFrees' has no effect for a thread having no heap, or
+        //:   an empty queue.
+        //:
+        //: 5 The heap of an exited thread is adopted by the next thread that
+        //:   needs a heap, which drains the blocks queued to the heap in the
+        //:   meantime, and owns the blocks previously allocated from it.
+        //
+        // Plan:
+        //: 1 Allocate blocks in the main thread, and deallocate them in
+        //:   another thread.  Verify that 'numHeaps' is unchanged, and that
+        //:   the next allocations are new blocks.  Call 'drainRemoteFrees',
+        //:   and verify that the next allocations return the blocks.
+        //:   (C-1..2, 4)
+        //:
+        //: 2 Deallocate a block in another thread, and verify that one of the
+        //:   next several allocations returns it without a call to
+        //:   'drainRemoteFrees'.  (C-3)
+        //:
+        //: 3 Allocate blocks in a thread that then exits, deallocate some of
+        //:   them in the main thread, and allocate in another thread.  Verify
+        //:   that the number of heaps is unchanged, and that the new thread
+        //:   obtains the deallocated blocks.  (C-5)
+        //
+        // Testing:
+        //   void drainRemoteFrees();
+        //   int numHeaps() const;
+        //   CONCERN: Remote frees return blocks to the dispensing heap.
+        //   CONCERN: The heap of an exited thread is adopted.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING REMOTE FREES AND ABANDONED HEAPS"
+                          << endl
+                          << "========================================"
+                          << endl;
+
+        enum { NUM_BLOCKS = 8 };
+
+        // Pools replenishing one block at a time hold no unused blocks, so
+        // that each allocation returns the block most recently returned to
+        // its pool, if any.
+
+        const bsls::BlockGrowth::Strategy CON =
+                                             bsls::BlockGrowth::BSLS_CONSTANT;
+
+        if (verbose) cout << "\tDraining explicitly." << endl;
+        {
+            Obj mX(7, CON, 1, Z);  const Obj& X = mX;
+
+            ASSERT(0 == X.numHeaps());
+
+            mX.drainRemoteFrees();
+            ASSERT(0 == X.numHeaps());
+
+            void *blocks[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate(40);
+            }
+            ASSERT(1 == X.numHeaps());
+
+            deallocateInThread(&mX, blocks, NUM_BLOCKS);
+            ASSERT(1 == X.numHeaps());
+
+            void *others[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                others[i] = mX.allocate(40);
+                LOOP_ASSERT(i, !contains(blocks, NUM_BLOCKS, others[i]));
+            }
+
+            mX.drainRemoteFrees();
+
+            void *reused[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                reused[i] = mX.allocate(33);
+                LOOP_ASSERT(i, contains(blocks, NUM_BLOCKS, reused[i]));
+            }
+
+            // Draining an empty queue has no effect.
+
+            mX.drainRemoteFrees();
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(reused[i]);
+                mX.deallocate(others[i]);
+            }
+            ASSERT(1 == X.numHeaps());
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\tDraining periodically." << endl;
+        {
+            Obj mX(Z);
+
+            enum { MAX_ALLOCATIONS = 256 };
+
+            void *block = mX.allocate(100);
+            deallocateInThread(&mX, &block, 1);
+
+            void *blocks[MAX_ALLOCATIONS];
+            int   numAllocations = 0;
+            bool  isReused       = false;
+
+            while (!isReused && numAllocations < MAX_ALLOCATIONS) {
+                blocks[numAllocations] = mX.allocate(100);
+                isReused = block == blocks[numAllocations];
+                ++numAllocations;
+            }
+            ASSERT(isReused);
+
+            if (veryVerbose) {
+                P(numAllocations)
+            }
+
+            for (int i = 0; i < numAllocations; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+        if (verbose) cout << "\tAdopting abandoned heaps." << endl;
+        {
+            Obj mX(7, CON, 1, Z);  const Obj& X = mX;
+
+            void *p = mX.allocate(8);
+            ASSERT(1 == X.numHeaps());
+
+            void *blocks[NUM_BLOCKS];
+            allocateInThread(&mX, blocks, NUM_BLOCKS, 64);
+            ASSERT(2 == X.numHeaps());
+
+            // Half of the blocks are queued to the abandoned heap.
+
+            deallocateInThread(&mX, blocks, NUM_BLOCKS / 2);
+            mX.deallocate(p);
+
+            void *reused[NUM_BLOCKS / 2];
+            allocateInThread(&mX, reused, NUM_BLOCKS / 2, 64);
+            ASSERT(2 == X.numHeaps());
+
+            for (int i = 0; i < NUM_BLOCKS / 2; ++i) {
+                LOOP_ASSERT(i, contains(blocks, NUM_BLOCKS / 2, reused[i]));
+            }
+
+            // The adopting thread deallocates the other half directly, as it
+            // now owns their heap.
+
+            deallocateInThread(&mX, blocks + NUM_BLOCKS / 2, NUM_BLOCKS / 2);
+            deallocateInThread(&mX, reused, NUM_BLOCKS / 2);
+            ASSERT(2 == X.numHeaps());
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+#endif
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'release' AND 'reserveCapacity'
+        //
+        // Concerns:
+        //: 1 'release' returns all memory, including blocks queued as remote
+        //:   frees, to the underlying allocator, but keeps the heaps.
+        //:
+        //: 2 The multipool is usable after 'release'.
+        //:
+        //: 3 'reserveCapacity' obtains enough memory from the underlying
+        //:   allocator to satisfy the reserved allocations.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Allocate a number of pooled and non-pooled blocks, deallocate
+        //:   some of them (so that they are pooled), and invoke 'release'.
+        //:   Verify that the test allocator reports no memory in use other
+        //:   than the multipool's own bookkeeping.  Then allocate again.
+        //:   (C-1..2)
+        //:
+        //: 2 Reserve capacity for a number of blocks, and verify that
+        //:   allocating those blocks does not use the test allocator.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void release();
+        //   void reserveCapacity(int size, int numBlocks);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'release' AND 'reserveCapacity'" << endl
+                          << "=======================================" << endl;
+
+        {
+            Obj mX(5, Z);
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksInUse();
+
+            void *p[20];
+            for (int i = 0; i < 20; ++i) {
+                p[i] = mX.allocate(1 + i * 7);
+            }
+            for (int i = 0; i < 20; i += 2) {
+                mX.deallocate(p[i]);
+            }
+
+            mX.release();
+
+            // The heap and its array of pools remain in use.
+
+            LOOP2_ASSERT(NUM_BLOCKS, testAllocator.numBlocksInUse(),
+                         NUM_BLOCKS + 2 == testAllocator.numBlocksInUse());
+            ASSERT(1 == mX.numHeaps());
+
+            for (int i = 0; i < 20; ++i) {
+                p[i] = mX.allocate(1 + i * 7);
+                ASSERT(p[i]);
+                memset(p[i], 'x', 1 + i * 7);
+            }
+            for (int i = 0; i < 20; ++i) {
+                mX.deallocate(p[i]);
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        {
+            Obj mX(5, bsls::BlockGrowth::BSLS_CONSTANT, 1, Z);
+
+            mX.reserveCapacity(64, 256);
+
+            const bsls::Types::Int64 NUM_ALLOCATIONS =
+                                               testAllocator.numAllocations();
+
+            // 'reserveCapacity' has already created the heap.
+
+            void *p[200];
+            for (int i = 0; i < 200; ++i) {
+                p[i] = mX.allocate(64);
+            }
+
+            LOOP2_ASSERT(NUM_ALLOCATIONS, testAllocator.numAllocations(),
+                         NUM_ALLOCATIONS == testAllocator.numAllocations());
+
+            for (int i = 0; i < 200; ++i) {
+                mX.deallocate(p[i]);
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(3, Z);
+
+            ASSERT_PASS(mX.reserveCapacity( 1, 0));
+            ASSERT_PASS(mX.reserveCapacity(32, 1));
+            ASSERT_FAIL(mX.reserveCapacity( 0, 1));
+            ASSERT_FAIL(mX.reserveCapacity(33, 1));
+            ASSERT_FAIL(mX.reserveCapacity( 1, -1));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'deleteObject' AND 'deleteObjectRaw'
+        //
+        // Concerns:
+        //: 1 Both methods destroy the object and return its footprint to the
+        //:   multipool for reuse.
+        //:
+        //: 2 Both methods have no effect on a null pointer.
+        //
+        // Plan:
+        //: 1 Create an object in memory obtained from the multipool, delete
+        //:   it, and verify that its destructor ran and that the next
+        //:   allocation of the same size returns the same address.  (C-1)
+        //:
+        //: 2 Invoke both methods with a null pointer.  (C-2)
+        //
+        // Testing:
+        //   template <class TYPE> void deleteObject(const TYPE *object);
+        //   template <class TYPE> void deleteObjectRaw(const TYPE *object);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'deleteObject' AND 'deleteObjectRaw'"
+                          << endl
+                          << "============================================"
+                          << endl;
+
+        struct Probe {
+            int *d_destroyed_p;
+
+            ~Probe() { ++*d_destroyed_p; }
+        };
+
+        int destroyed = 0;
+
+        Obj mX(Z);
+
+        Probe *p = new (mX.allocate(sizeof(Probe))) Probe;
+        p->d_destroyed_p = &destroyed;
+
+        mX.deleteObject(p);
+        ASSERT(1 == destroyed);
+
+        Probe *q = new (mX.allocate(sizeof(Probe))) Probe;
+        q->d_destroyed_p = &destroyed;
+        ASSERT(p == q);
+
+        mX.deleteObjectRaw(q);
+        ASSERT(2 == destroyed);
+
+        mX.deleteObject(static_cast<Probe *>(0));
+        mX.deleteObjectRaw(static_cast<Probe *>(0));
+        ASSERT(2 == destroyed);
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns suitably-aligned memory of at least the
+        //:   requested size.
+        //:
+        //: 2 Blocks deallocated by a thread are reused by the next allocations
+        //:   of the same size class in that thread (most recently deallocated
+        //:   first).
+        //:
+        //: 3 Requests larger than 'maxPooledBlockSize()' are satisfied by the
+        //:   underlying allocator, and are returned to it on deallocation.
+        //:
+        //: 4 Many blocks of one size class may be allocated, deallocated, and
+        //:   reallocated without error.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For a range of sizes, allocate blocks, verify their alignment,
+        //:   and write to every byte.  (C-1)
+        //:
+        //: 2 Deallocate two blocks of the same size class and verify that the
+        //:   next two allocations return them in reverse order.  (C-2)
+        //:
+        //: 3 Allocate and deallocate a large block, and verify the number of
+        //:   blocks in use in the test allocator.  (C-3)
+        //:
+        //: 4 Allocate and then deallocate many blocks of one size class.
+        //:   (C-4)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   void *allocate(int size);
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'allocate' AND 'deallocate'" << endl
+                          << "===================================" << endl;
+
+        {
+            Obj mX(Z);
+
+            for (int size = 1; size <= 2 * mX.maxPooledBlockSize(); ++size) {
+                char *p = static_cast<char *>(mX.allocate(size));
+                LOOP_ASSERT(size, isNaturallyAligned(p, size));
+                memset(p, 0xa5, size);
+                mX.deallocate(p);
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        {
+            // Replenish one block at a time, so that the pool holds no unused
+            // blocks.
+
+            Obj mX(10, bsls::BlockGrowth::BSLS_CONSTANT, 1, Z);
+
+            void *p = mX.allocate(24);
+            void *q = mX.allocate(17);
+            ASSERT(p != q);
+
+            mX.deallocate(p);
+            mX.deallocate(q);
+
+            ASSERT(q == mX.allocate(32));
+            ASSERT(p == mX.allocate(20));
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        {
+            Obj mX(3, Z);
+
+            void *p = mX.allocate(8);  // create the heap
+
+            const bsls::Types::Int64 NUM_BLOCKS =
+                                               testAllocator.numBlocksInUse();
+
+            void *q = mX.allocate(mX.maxPooledBlockSize() + 1);
+            ASSERT(NUM_BLOCKS + 1 == testAllocator.numBlocksInUse());
+
+            mX.deallocate(q);
+            ASSERT(NUM_BLOCKS     == testAllocator.numBlocksInUse());
+
+            mX.deallocate(p);
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        {
+            Obj mX(Z);
+
+            enum { NUM = 5000 };
+
+            bsl::vector<void *> blocks(Z);
+            for (int i = 0; i < NUM; ++i) {
+                blocks.push_back(mX.allocate(8));
+            }
+            for (int i = 0; i < NUM; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            for (int i = 0; i < NUM; ++i) {
+                blocks[i] = mX.allocate(8);
+            }
+            for (int i = 0; i < NUM; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            Obj mX(Z);
+
+            void *p = 0;
+            ASSERT_PASS(p = mX.allocate(1));
+            ASSERT_FAIL(mX.allocate(0));
+
+            ASSERT_PASS(mX.deallocate(p));
+            ASSERT_FAIL(mX.deallocate(0));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates the requested number of pools, and
+        //:   'maxPooledBlockSize' reflects that number.
+        //:
+        //: 2 Memory is supplied by the allocator specified at construction,
+        //:   or by the default allocator if none is specified.
+        //:
+        //: 3 The destructor returns all memory to the underlying allocator.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Construct a multipool with each constructor, verify 'numPools'
+        //:   and 'maxPooledBlockSize', allocate from it, and verify that no
+        //:   memory remains in use after it is destroyed.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   ThreadHeapMultipool(Allocator *ba = 0);
+        //   ThreadHeapMultipool(numPools, Allocator *ba = 0);
+        //   ThreadHeapMultipool(gs, Allocator *ba = 0);
+        //   ThreadHeapMultipool(numPools, gs, Allocator *ba = 0);
+        //   ThreadHeapMultipool(numPools, gs, mbpc, Allocator *ba = 0);
+        //   ~ThreadHeapMultipool();
+        //   int numPools() const;
+        //   int maxPooledBlockSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CREATORS AND BASIC ACCESSORS" << endl
+                          << "====================================" << endl;
+
+        const bsls::BlockGrowth::Strategy GEO =
+                                            bsls::BlockGrowth::BSLS_GEOMETRIC;
+        const bsls::BlockGrowth::Strategy CON =
+                                             bsls::BlockGrowth::BSLS_CONSTANT;
+
+        {
+            bslma::TestAllocator         da("default", veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(10   == X.numPools());
+            ASSERT(4096 == X.maxPooledBlockSize());
+
+            mX.deallocate(mX.allocate(100));
+            ASSERT(0 <  da.numBlocksInUse());
+            ASSERT(0 == testAllocator.numBlocksInUse());
+        }
+
+        for (int numPools = 1; numPools <= 12; ++numPools) {
+            const int MAX_SIZE = 4 << numPools;
+            {
+                Obj mX(numPools, Z);  const Obj& X = mX;
+                LOOP_ASSERT(numPools, numPools == X.numPools());
+                LOOP_ASSERT(numPools, MAX_SIZE == X.maxPooledBlockSize());
+                mX.deallocate(mX.allocate(MAX_SIZE));
+            }
+            {
+                Obj mX(numPools, CON, Z);  const Obj& X = mX;
+                LOOP_ASSERT(numPools, numPools == X.numPools());
+                LOOP_ASSERT(numPools, MAX_SIZE == X.maxPooledBlockSize());
+                mX.deallocate(mX.allocate(MAX_SIZE));
+            }
+            {
+                Obj mX(numPools, GEO, 5, Z);  const Obj& X = mX;
+                LOOP_ASSERT(numPools, numPools == X.numPools());
+                LOOP_ASSERT(numPools, MAX_SIZE == X.maxPooledBlockSize());
+                mX.deallocate(mX.allocate(MAX_SIZE));
+            }
+            LOOP_ASSERT(numPools, 0 == testAllocator.numBlocksInUse());
+        }
+
+        {
+            Obj mX(CON, Z);  const Obj& X = mX;
+            ASSERT(10 == X.numPools());
+            mX.deallocate(mX.allocate(1));
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            ASSERT_PASS(Obj( 1, Z));
+            ASSERT_FAIL(Obj( 0, Z));
+            ASSERT_FAIL(Obj(-1, Z));
+
+            ASSERT_PASS(Obj(1, GEO, 1, Z));
+            ASSERT_FAIL(Obj(1, GEO, 0, Z));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //   That the basic functionality of 'bdlma::ThreadHeapMultipool'
+        //   works properly.
+        //
+        // Plan:
+        //   Create a multipool that manages three pools.  Allocate memory from
+        //   the first two pools, as well as from the "overflow" block list.
+        //   Then 'deallocate' or 'release' the allocated blocks.  Finally, let
+        //   the multipool go out of scope to exercise the destructor.
+        //
+        // Testing:
+        //   This "test" exercises basic functionality, but tests nothing.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST"
+                          << endl << "==============" << endl;
+
+        {
+            Obj mX(3, Z);
+
+            char *p = static_cast<char *>(mX.allocate(8));     ASSERT(p);
+            mX.deallocate(p);
+
+            mX.reserveCapacity(8 * 2, 2);
+
+            p       = static_cast<char *>(mX.allocate(8 * 2));     ASSERT(p);
+            char *q = static_cast<char *>(mX.allocate(8 * 2 - 1)); ASSERT(q);
+            char *r = static_cast<char *>(mX.allocate(1024));      ASSERT(r);
+
+            ASSERT(p != q);
+
+            mX.deallocate(q);
+            mX.release();
+        }
+        ASSERT(0 == testAllocator.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
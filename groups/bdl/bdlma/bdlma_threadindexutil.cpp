@@ -0,0 +1,77 @@
+// bdlma_threadindexutil.cpp                                          -*-C++-*-
+#include <bdlma_threadindexutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_threadindexutil_cpp,"$Id$ $CSID$")
+
+#include <bsls_atomicoperations.h>
+#include <bsls_bslonce.h>
+#include <bsls_bslthreadspecific.h>
+#include <bsls_objectbuffer.h>
+#include <bsls_performancehint.h>
+#include <bsls_types.h>
+
+#include <bsl_new.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+namespace {
+
+// LOCAL VARIABLES
+
+bsls::ObjectBuffer<bsls::BslThreadSpecific> s_key;
+    // index of each thread, plus one, so that 0 indicates a thread having no
+    // index
+
+bsls::BslOnce s_once = BSLS_BSLONCE_INITIALIZER;
+    // guard for the construction of 's_key'
+
+bsls::AtomicOperations::AtomicTypes::Int s_nextIndex;
+    // number of indices assigned
+
+}  // close unnamed namespace
+
+                          // ----------------------
+                          // struct ThreadIndexUtil
+                          // ----------------------
+
+// CLASS METHODS
+int ThreadIndexUtil::threadIndex()
+{
+    bsls::BslOnceGuard onceGuard;
+    if (onceGuard.enter(&s_once)) {
+        new (s_key.buffer()) bsls::BslThreadSpecific();
+    }
+
+    bsls::Types::UintPtr value =
+                reinterpret_cast<bsls::Types::UintPtr>(s_key.object().value());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == value)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        value = bsls::AtomicOperations::addIntNvRelaxed(&s_nextIndex, 1);
+        s_key.object().setValue(reinterpret_cast<void *>(value));
+    }
+
+    return static_cast<int>(value - 1);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,114 @@
+// bdlma_threadindexutil.h                                            -*-C++-*-
+#ifndef INCLUDED_BDLMA_THREADINDEXUTIL
+#define INCLUDED_BDLMA_THREADINDEXUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a small sequential index for each thread of the process.
+//
+//@CLASSES:
+//  bdlma::ThreadIndexUtil: namespace for the index of the calling thread
+//
+//@SEE_ALSO: bdlma_countingallocator, bdlma_tracingallocator
+//
+//@DESCRIPTION: This component provides a utility 'struct',
+// 'bdlma::ThreadIndexUtil', whose 'threadIndex' function returns an index for
+// the calling thread.  Indices are assigned in sequence, starting from 0, to
+// threads in the order of their first calls to 'threadIndex', and a thread
+// keeps its index for its lifetime.  Allocators use the index to select
+// per-thread state (e.g., a shard of counters) without contending on a shared
+// counter, and to label the events recorded for each thread.
+//
+// Indices are shared by all users of this component in the process, and are
+// not reused when a thread exits.  The first call by each thread performs an
+// atomic increment and stores the result in a thread-specific storage key
+// (see 'bsls_bslthreadspecific'); subsequent calls only read the key.
+//
+///Thread Safety
+///-------------
+// 'bdlma::ThreadIndexUtil::threadIndex' is thread-safe (see
+// 'bsldoc_glossary').
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Selecting a Shard of Counters
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to count events raised by many threads, without
+// having all of the threads increment the same counter.
+//
+// First, we define a set of counters, each in its own shard, and a function
+// that increments the counter of the shard selected by the calling thread:
+//..
+//  enum { NUM_SHARDS = 4 };
+//
+//  int eventCounts[NUM_SHARDS];
+//
+//  void raiseEvent()
+//      // Count an event raised by the calling thread.
+//  {
+//      ++eventCounts[bdlma::ThreadIndexUtil::threadIndex() % NUM_SHARDS];
+//  }
+//..
+// Then, we raise a few events from the current thread:
+//..
+//  for (int i = 0; i < NUM_SHARDS; ++i) {
+//      eventCounts[i] = 0;
+//  }
+//
+//  raiseEvent();
+//  raiseEvent();
+//..
+// Finally, we observe that the events raised by the thread are counted in the
+// same shard:
+//..
+//  const int shard = bdlma::ThreadIndexUtil::threadIndex() % NUM_SHARDS;
+//
+//  assert(2 == eventCounts[shard]);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                          // ======================
+                          // struct ThreadIndexUtil
+                          // ======================
+
+struct ThreadIndexUtil {
+    // This 'struct' provides a namespace for a function returning the index of
+    // the calling thread.
+
+    // CLASS METHODS
+    static int threadIndex();
+        // Return the index of the calling thread, assigning the next index (in
+        // sequence, starting from 0) if the calling thread has none.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
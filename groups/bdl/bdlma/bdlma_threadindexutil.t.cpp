@@ -0,0 +1,344 @@
+// bdlma_threadindexutil.t.cpp                                        -*-C++-*-
+#include <bdlma_threadindexutil.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_platform.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides a single function that returns the index
+// of the calling thread.  We verify that a thread keeps its index across
+// calls, and that the threads of the process are assigned distinct indices
+// in sequence, starting from 0.
+//-----------------------------------------------------------------------------
+// [ 2] static int threadIndex();
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 2] CONCERN: Threads are assigned distinct indices in sequence.
+// [ 3] USAGE EXAMPLE
+
+//=============================================================================
+//                    STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                       GLOBAL TYPES AND CONSTANTS
+//-----------------------------------------------------------------------------
+
+typedef bdlma::ThreadIndexUtil Util;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+//=============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+namespace TestCase2 {
+
+struct ThreadInfo {
+    // This 'struct' holds the results of 'threadFunction'.
+
+    int d_first;   // index returned by the first call
+    int d_second;  // index returned by the second call
+};
+
+extern "C" void *threadFunction(void *arg)
+    // Record, in the 'ThreadInfo' at the specified 'arg', the index of the
+    // calling thread returned by two successive calls to 'threadIndex'.
+{
+    ThreadInfo *info = static_cast<ThreadInfo *>(arg);
+
+    info->d_first  = Util::threadIndex();
+    info->d_second = Util::threadIndex();
+
+    return 0;
+}
+
+}  // close namespace TestCase2
+
+//=============================================================================
+//                               USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Selecting a Shard of Counters
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to count events raised by many threads, without
+// having all of the threads increment the same counter.
+//
+// First, we define a set of counters, each in its own shard, and a function
+// that increments the counter of the shard selected by the calling thread:
+//..
+    enum { NUM_SHARDS = 4 };
+
+    int eventCounts[NUM_SHARDS];
+
+    void raiseEvent()
+        // Count an event raised by the calling thread.
+    {
+        ++eventCounts[bdlma::ThreadIndexUtil::threadIndex() % NUM_SHARDS];
+    }
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator(veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 3: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we raise a few events from the current thread:
+//..
+    for (int i = 0; i < NUM_SHARDS; ++i) {
+        eventCounts[i] = 0;
+    }
+
+    raiseEvent();
+    raiseEvent();
+//..
+// Finally, we observe that the events raised by the thread are counted in the
+// same shard:
+//..
+    const int shard = bdlma::ThreadIndexUtil::threadIndex() % NUM_SHARDS;
+
+    ASSERT(2 == eventCounts[shard]);
+//..
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // 'threadIndex'
+        //
+        // Concerns:
+        //: 1 The first thread to call 'threadIndex' is assigned index 0.
+        //:
+        //: 2 A thread is returned the same index by every call.
+        //:
+        //: 3 Threads are assigned distinct indices, in sequence.
+        //
+        // Plan:
+        //: 1 Call 'threadIndex' twice from the main thread, then twice from
+        //:   each of several threads, and verify that the indices observed by
+        //:   each thread agree, and that together they are the integers from
+        //:   0 to the number of threads.  (C-1..3)
+        //
+        // Testing:
+        //   static int threadIndex();
+        //   CONCERN: Threads are assigned distinct indices in sequence.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'threadIndex'" << endl
+                          << "=============" << endl;
+
+        using namespace TestCase2;
+
+        enum { NUM_THREADS = 4 };
+
+        ASSERT(0 == Util::threadIndex());
+        ASSERT(0 == Util::threadIndex());
+
+        ThreadInfo info[NUM_THREADS];
+        ThreadId   ids[NUM_THREADS];
+
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            info[i].d_first  = -1;
+            info[i].d_second = -1;
+
+            ids[i] = createThread(&threadFunction, &info[i]);
+        }
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            joinThread(ids[i]);
+        }
+
+        bool seen[NUM_THREADS + 1] = { true };
+
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            const int INDEX = info[i].d_first;
+
+            if (veryVerbose) { P_(i) P_(INDEX) P(info[i].d_second) }
+
+            ASSERTV(i, INDEX, info[i].d_second == INDEX);
+            ASSERTV(i, INDEX, 1 <= INDEX && INDEX <= NUM_THREADS);
+
+            if (1 <= INDEX && INDEX <= NUM_THREADS) {
+                ASSERTV(i, INDEX, !seen[INDEX]);
+                seen[INDEX] = true;
+            }
+        }
+
+        ASSERT(0 == Util::threadIndex());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Obtain the index of the calling thread twice, and verify that it
+        //:   is 0 both times.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        ASSERT(0 == Util::threadIndex());
+        ASSERT(0 == Util::threadIndex());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
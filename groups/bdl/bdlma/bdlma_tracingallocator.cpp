@@ -0,0 +1,388 @@
+// bdlma_tracingallocator.cpp                                         -*-C++-*-
+#include <bdlma_tracingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_tracingallocator_cpp,"$Id$ $CSID$")
+
+#include <bdlma_threadindexutil.h>
+
+#include <bslma_default.h>
+
+#include <bsls_assert.h>
+#include <bsls_bsllock.h>
+#include <bsls_timeutil.h>
+
+#include <bsl_cstring.h>             // 'bsl::memcmp', 'bsl::memcpy'
+
+namespace BloombergLP {
+
+namespace {
+
+// LOCAL CONSTANTS
+
+// Define the signature with which every trace begins, and its length.
+
+const char SIGNATURE[]      = "BDLMATR1";
+const int  SIGNATURE_LENGTH = 8;
+
+// Define the maximum number of bytes in the encoding of an event: four
+// integers of at most 10 bytes each.
+
+const int MAX_RECORD_LENGTH = 40;
+
+// HELPER FUNCTIONS
+
+char *encode(char *cursor, bsls::Types::Uint64 value)
+    // Write the specified 'value' in the LEB128 encoding to the buffer at the
+    // specified 'cursor', and return the position following the last byte
+    // written.
+{
+    while (value >= 0x80) {
+        *cursor++ = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    *cursor++ = static_cast<char>(value);
+    return cursor;
+}
+
+int decode(bsls::Types::Uint64 *result, bsl::FILE *file)
+    // Read an integer in the LEB128 encoding from the specified 'file' and
+    // load it into the specified 'result'.  Return 0 on success, 1 if 'file'
+    // is at its end before the first byte, and a negative value if the
+    // encoding is truncated or too long.
+{
+    bsls::Types::Uint64 value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        const int byte = bsl::getc(file);
+        if (EOF == byte) {
+            return 0 == shift ? 1 : -1;                               // RETURN
+        }
+
+        value |= static_cast<bsls::Types::Uint64>(byte & 0x7F) << shift;
+
+        if (0 == (byte & 0x80)) {
+            *result = value;
+            return 0;                                                 // RETURN
+        }
+    }
+    return -1;
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                           // ----------------------
+                           // class TracingAllocator
+                           // ----------------------
+
+// PRIVATE MANIPULATORS
+void TracingAllocator::initialize()
+{
+    if (!d_file_p) {
+        return;                                                       // RETURN
+    }
+
+    d_buffer_p = static_cast<char *>(d_allocator_p->allocate(k_BUFFER_SIZE));
+
+    bsl::memcpy(d_buffer_p, SIGNATURE, SIGNATURE_LENGTH);
+    d_length = SIGNATURE_LENGTH;
+
+    d_lastTimestamp = bsls::TimeUtil::getTimer();
+
+    writeBuffer();
+}
+
+void TracingAllocator::record(EventType type, void *address, size_type size)
+{
+    BSLS_ASSERT(d_file_p);
+
+    if (d_length + MAX_RECORD_LENGTH > k_BUFFER_SIZE) {
+        writeBuffer();
+        if (!d_file_p) {
+            return;                                                   // RETURN
+        }
+    }
+
+    // Since the timer is monotonic and read under the lock, the elapsed time
+    // is non-negative.
+
+    const bsls::Types::Int64   now   = bsls::TimeUtil::getTimer();
+    const bsls::Types::UintPtr value =
+                               reinterpret_cast<bsls::Types::UintPtr>(address);
+    const bsls::Types::Int64   delta =
+                     static_cast<bsls::Types::Int64>(value - d_lastAddress);
+
+    const bsls::Types::Uint64 threadIndex = ThreadIndexUtil::threadIndex();
+
+    char *cursor = d_buffer_p + d_length;
+
+    cursor = encode(cursor, 2 * threadIndex + (e_DEALLOCATE == type));
+    cursor = encode(cursor,
+                    static_cast<bsls::Types::Uint64>(now - d_lastTimestamp));
+    cursor = encode(cursor,
+                    delta >= 0
+                    ? 2 * static_cast<bsls::Types::Uint64>(delta)
+                    : 2 * static_cast<bsls::Types::Uint64>(-(delta + 1)) + 1);
+    if (e_ALLOCATE == type) {
+        cursor = encode(cursor, size);
+    }
+
+    d_length        = cursor - d_buffer_p;
+    d_lastTimestamp = now;
+    d_lastAddress   = value;
+    ++d_numEvents;
+}
+
+void TracingAllocator::writeBuffer()
+{
+    BSLS_ASSERT(d_file_p);
+
+    if (d_length != bsl::fwrite(d_buffer_p, 1, d_length, d_file_p)) {
+        if (d_ownsFile) {
+            bsl::fclose(d_file_p);
+        }
+        d_file_p = 0;
+    }
+    d_length = 0;
+}
+
+// CREATORS
+TracingAllocator::TracingAllocator(const char       *path,
+                                   bslma::Allocator *basicAllocator)
+: d_file_p(0)
+, d_ownsFile(true)
+, d_buffer_p(0)
+, d_length(0)
+, d_lastTimestamp(0)
+, d_lastAddress(0)
+, d_numEvents(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(path);
+
+    d_file_p = bsl::fopen(path, "wb");
+
+    initialize();
+}
+
+TracingAllocator::TracingAllocator(bsl::FILE        *file,
+                                   bslma::Allocator *basicAllocator)
+: d_file_p(file)
+, d_ownsFile(false)
+, d_buffer_p(0)
+, d_length(0)
+, d_lastTimestamp(0)
+, d_lastAddress(0)
+, d_numEvents(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(file);
+
+    initialize();
+}
+
+TracingAllocator::~TracingAllocator()
+{
+    if (d_file_p) {
+        writeBuffer();
+    }
+    if (d_file_p) {
+        if (d_ownsFile) {
+            bsl::fclose(d_file_p);
+        }
+        else {
+            bsl::fflush(d_file_p);
+        }
+    }
+    d_allocator_p->deallocate(d_buffer_p);
+}
+
+// MANIPULATORS
+void *TracingAllocator::allocate(size_type size)
+{
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    void *address = d_allocator_p->allocate(size);
+
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        if (d_file_p) {
+            record(e_ALLOCATE, address, size);
+        }
+    }
+
+    return address;
+}
+
+void TracingAllocator::deallocate(void *address)
+{
+    if (0 == address) {
+        return;                                                       // RETURN
+    }
+
+    {
+        bsls::BslLockGuard guard(&d_lock);
+
+        if (d_file_p) {
+            record(e_DEALLOCATE, address, 0);
+        }
+    }
+
+    d_allocator_p->deallocate(address);
+}
+
+int TracingAllocator::flush()
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    if (d_file_p) {
+        writeBuffer();
+    }
+    if (d_file_p && 0 != bsl::fflush(d_file_p)) {
+        if (d_ownsFile) {
+            bsl::fclose(d_file_p);
+        }
+        d_file_p = 0;
+    }
+    return d_file_p ? 0 : -1;
+}
+
+// ACCESSORS
+bool TracingAllocator::isTracing() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return 0 != d_file_p;
+}
+
+bsls::Types::Int64 TracingAllocator::numEvents() const
+{
+    bsls::BslLockGuard guard(&d_lock);
+
+    return d_numEvents;
+}
+
+                        // ----------------------------
+                        // class TracingAllocatorReader
+                        // ----------------------------
+
+// PRIVATE MANIPULATORS
+void TracingAllocatorReader::initialize()
+{
+    char signature[SIGNATURE_LENGTH];
+
+    d_isValid = d_file_p
+             && SIGNATURE_LENGTH == bsl::fread(signature,
+                                               1,
+                                               SIGNATURE_LENGTH,
+                                               d_file_p)
+             && 0 == bsl::memcmp(signature, SIGNATURE, SIGNATURE_LENGTH);
+}
+
+// CREATORS
+TracingAllocatorReader::TracingAllocatorReader(const char *path)
+: d_file_p(0)
+, d_ownsFile(true)
+, d_isValid(false)
+, d_lastTimestamp(0)
+, d_lastAddress(0)
+{
+    BSLS_ASSERT(path);
+
+    d_file_p = bsl::fopen(path, "rb");
+
+    initialize();
+}
+
+TracingAllocatorReader::TracingAllocatorReader(bsl::FILE *file)
+: d_file_p(file)
+, d_ownsFile(false)
+, d_isValid(false)
+, d_lastTimestamp(0)
+, d_lastAddress(0)
+{
+    BSLS_ASSERT(file);
+
+    initialize();
+}
+
+TracingAllocatorReader::~TracingAllocatorReader()
+{
+    if (d_file_p && d_ownsFile) {
+        bsl::fclose(d_file_p);
+    }
+}
+
+// MANIPULATORS
+int TracingAllocatorReader::readEvent(TracingAllocator::Event *result)
+{
+    BSLS_ASSERT(result);
+
+    if (!d_isValid) {
+        return -1;                                                    // RETURN
+    }
+
+    bsls::Types::Uint64 tag;
+    const int           rc = decode(&tag, d_file_p);
+
+    if (1 == rc) {
+        return 1;                                                     // RETURN
+    }
+
+    bsls::Types::Uint64 elapsed;
+    bsls::Types::Uint64 address;
+    bsls::Types::Uint64 size = 0;
+
+    const bool isDeallocation = tag & 1;
+
+    if (0 != rc
+     || 0 != decode(&elapsed, d_file_p)
+     || 0 != decode(&address, d_file_p)
+     || (!isDeallocation && 0 != decode(&size, d_file_p))) {
+        d_isValid = false;
+        return -1;                                                    // RETURN
+    }
+
+    // Undo the zig-zag encoding of the difference of the addresses.
+
+    const bsls::Types::Uint64 delta = address & 1
+                                    ? ~(address >> 1)
+                                    : address >> 1;
+
+    d_lastTimestamp += static_cast<bsls::Types::Int64>(elapsed);
+    d_lastAddress   += static_cast<bsls::Types::UintPtr>(delta);
+
+    result->d_type        = isDeallocation
+                          ? TracingAllocator::e_DEALLOCATE
+                          : TracingAllocator::e_ALLOCATE;
+    result->d_timestamp   = d_lastTimestamp;
+    result->d_threadIndex = static_cast<int>(tag >> 1);
+    result->d_address     = d_lastAddress;
+    result->d_size        = static_cast<bslma::Allocator::size_type>(size);
+
+    return 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,423 @@
+// bdlma_tracingallocator.h                                           -*-C++-*-
+#ifndef INCLUDED_BDLMA_TRACINGALLOCATOR
+#define INCLUDED_BDLMA_TRACINGALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator that records a binary trace of its requests.
+//
+//@CLASSES:
+//  bdlma::TracingAllocator: records every request to a trace file
+//  bdlma::TracingAllocatorReader: reads the events of a trace file
+//
+//@SEE_ALSO: bdlma_countingallocator, bdlma_heapprofilingallocator,
+//           bdlma_threadindexutil
+//
+//@DESCRIPTION: This component provides a concrete allocation mechanism,
+// 'bdlma::TracingAllocator', that implements the 'bslma::Allocator' protocol,
+// forwards every request to an allocator supplied at construction, and
+// records each allocation and deallocation, with the size of the block, the
+// time of the request, and the thread making it, as an *event* in a compact
+// binary trace file.  The component also provides a mechanism,
+// 'bdlma::TracingAllocatorReader', that reads the events of a trace file, so
+// that the allocation pattern of a production workload can be captured once
+// and then replayed against different allocation strategies:
+//..
+//   ,-----------------------.
+//  ( bdlma::TracingAllocator )
+//   `-----------------------'
+//              |         ctor/dtor
+//              |         flush
+//              |         isTracing
+//              |         numEvents
+//              V
+//      ,----------------.
+//     ( bslma::Allocator )
+//      `----------------'
+//                        allocate
+//                        deallocate
+//
+//   ,-----------------------------.
+//  ( bdlma::TracingAllocatorReader )
+//   `-----------------------------'
+//                        ctor/dtor
+//                        readEvent
+//                        isValid
+//..
+// Events are encoded into a buffer under an internal lock, in the order in
+// which the requests are made, and the buffer is written to the file when it
+// is full, when 'flush' is called, and when the allocator is destroyed.  The
+// event of an allocation is recorded after the block is obtained from the
+// wrapped allocator, and the event of a deallocation before the block is
+// returned to it, so that a block is never allocated in the trace before the
+// block previously occupying its address is deallocated.  Note that this
+// serializes every request made of the allocator, which is acceptable while
+// capturing a trace, but not for ordinary use.
+//
+// If the trace file cannot be opened, or an error occurs writing to it, the
+// allocator continues to forward every request to the wrapped allocator, and
+// 'isTracing' returns 'false'.
+//
+///Trace Format
+///------------
+// A trace file consists of the 8-byte signature "BDLMATR1", followed by one
+// record per event.  Each record is a sequence of unsigned integers in the
+// LEB128 variable-length encoding (7 bits per byte, least significant group
+// first, with the high bit of each byte set if another byte follows):
+//..
+//  Field      Value
+//  ---------  -------------------------------------------------------------
+//  tag        '2 * threadIndex + type', where 'type' is 0 for an allocation
+//             and 1 for a deallocation
+//  time       nanoseconds elapsed since the previous event (or since the
+//             allocator was created, for the first event)
+//  address    the difference between the address of the block and the
+//             address in the previous event, zig-zag encoded (i.e., 'n'
+//             is encoded as '2 * n' if non-negative and '-2 * n - 1'
+//             otherwise)
+//  size       the size (in bytes) of the block (allocations only)
+//..
+// Thread indices are small integers assigned to threads in the order in which
+// they first obtain an index from 'bdlma::ThreadIndexUtil' (typically, by
+// making a request of a tracing allocator) in the process.  Since
+// successive blocks tend to have nearby addresses, and successive requests to
+// be made in quick succession, a typical record occupies 6 to 10 bytes.
+// Deallocations of a null address, and allocations of 0 bytes, are not
+// recorded.
+//
+///Thread Safety
+///-------------
+// The 'bdlma::TracingAllocator' class is fully thread-safe (see
+// 'bsldoc_glossary') provided that the wrapped allocator is fully
+// thread-safe.  The 'bdlma::TracingAllocatorReader' class is *const*
+// *thread-safe*, but not fully thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Capturing and Reading a Trace
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to evaluate allocation strategies against the
+// allocation pattern of one of our services.  We first capture a trace of the
+// service's requests, and then read it back.
+//
+// First, we create a tracing allocator writing to a file, and give it to the
+// code under study (here, a loop allocating and deallocating blocks):
+//..
+//  const char *path = "service.trace";
+//  {
+//      bdlma::TracingAllocator tracer(path);
+//      assert(tracer.isTracing());
+//
+//      void *blocks[10];
+//      for (int i = 0; i < 10; ++i) {
+//          blocks[i] = tracer.allocate(16 * (i + 1));
+//      }
+//      for (int i = 0; i < 10; ++i) {
+//          tracer.deallocate(blocks[i]);
+//      }
+//      assert(20 == tracer.numEvents());
+//  }
+//..
+// Then, after the tracing allocator is destroyed (which flushes the trace), we
+// read the trace back, and verify that each allocation is matched by a
+// deallocation of the same address:
+//..
+//  bdlma::TracingAllocatorReader reader(path);
+//  assert(reader.isValid());
+//
+//  bdlma::TracingAllocator::Event event;
+//  bsls::Types::UintPtr           addresses[10];
+//  bsls::Types::Int64             previousTime = 0;
+//
+//  for (int i = 0; i < 20; ++i) {
+//      int rc = reader.readEvent(&event);
+//      assert(0 == rc);
+//      assert(previousTime <= event.d_timestamp);
+//      previousTime = event.d_timestamp;
+//
+//      if (i < 10) {
+//          assert(bdlma::TracingAllocator::e_ALLOCATE == event.d_type);
+//          assert(16 * (i + 1) == event.d_size);
+//          addresses[i] = event.d_address;
+//      }
+//      else {
+//          assert(bdlma::TracingAllocator::e_DEALLOCATE == event.d_type);
+//          assert(addresses[i - 10] == event.d_address);
+//      }
+//  }
+//..
+// Finally, we observe that the trace has no further events:
+//..
+//  assert(1 == reader.readEvent(&event));
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BSLLOCK
+#include <bsls_bsllock.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDIO
+#include <bsl_cstdio.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                           // ======================
+                           // class TracingAllocator
+                           // ======================
+
+class TracingAllocator : public bslma::Allocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'bslma::Allocator' protocol, forwards every request to
+    // the allocator supplied at construction, and records every allocation
+    // and deallocation as an event in a binary trace file.
+
+  public:
+    // TYPES
+    enum EventType {
+        // Enumerate the kinds of events recorded in a trace.
+
+        e_ALLOCATE,   // a block was allocated
+        e_DEALLOCATE  // a block was deallocated
+    };
+
+    struct Event {
+        // This 'struct' describes an event recorded in a trace.
+
+        EventType            d_type;         // kind of event
+        bsls::Types::Int64   d_timestamp;    // nanoseconds since the
+                                             // allocator was created
+        int                  d_threadIndex;  // index of the thread making
+                                             // the request
+        bsls::Types::UintPtr d_address;      // address of the block
+        size_type            d_size;         // size (in bytes) of the block,
+                                             // or 0 for a deallocation
+    };
+
+    // CONSTANTS
+    enum {
+        k_BUFFER_SIZE = 64 * 1024  // size (in bytes) of the buffer of
+                                   // encoded events
+    };
+
+  private:
+    // DATA
+    bsl::FILE             *d_file_p;         // trace file, or 0 if not
+                                             // tracing
+
+    bool                   d_ownsFile;       // 'true' if 'd_file_p' is to be
+                                             // closed at destruction
+
+    char                  *d_buffer_p;       // encoded events not yet written
+
+    size_type              d_length;         // number of bytes in
+                                             // 'd_buffer_p'
+
+    bsls::Types::Int64     d_lastTimestamp;  // time (from 'bsls::TimeUtil')
+                                             // of the last event
+
+    bsls::Types::UintPtr   d_lastAddress;    // address in the last event
+
+    bsls::Types::Int64     d_numEvents;      // number of events recorded
+
+    mutable bsls::BslLock  d_lock;           // guards the buffer and the
+                                             // file
+
+    bslma::Allocator      *d_allocator_p;    // wrapped allocator (held, not
+                                             // owned)
+
+  private:
+    // PRIVATE MANIPULATORS
+    void initialize();
+        // Allocate the buffer and write the signature of the trace.  If the
+        // signature cannot be written, stop tracing.
+
+    void record(EventType type, void *address, size_type size);
+        // Encode an event of the specified 'type' for the block at the
+        // specified 'address' of the specified 'size' (in bytes), writing the
+        // buffer to the trace file if it is full.  The behavior is undefined
+        // unless the internal lock is held by the calling thread and this
+        // allocator is tracing.
+
+    void writeBuffer();
+        // Write the encoded events in the buffer to the trace file, and empty
+        // the buffer.  If the events cannot be written, stop tracing.  The
+        // behavior is undefined unless the internal lock is held by the
+        // calling thread and this allocator is tracing.
+
+  private:
+    // NOT IMPLEMENTED
+    TracingAllocator(const TracingAllocator&);
+    TracingAllocator& operator=(const TracingAllocator&);
+
+  public:
+    // CREATORS
+    explicit
+    TracingAllocator(const char *path, bslma::Allocator *basicAllocator = 0);
+        // Create a tracing allocator that records its requests to a new trace
+        // file at the specified 'path' (replacing any existing file), which is
+        // closed when this object is destroyed.  Optionally specify a
+        // 'basicAllocator' to which every request is forwarded, and used to
+        // supply the buffer of encoded events.  If 'basicAllocator' is 0, the
+        // currently installed default allocator is used.  If the file cannot
+        // be created, this allocator forwards requests without recording
+        // them.
+
+    explicit
+    TracingAllocator(bsl::FILE *file, bslma::Allocator *basicAllocator = 0);
+        // Create a tracing allocator that records its requests to the
+        // specified open 'file', which must be open for writing in binary
+        // mode, and is not closed when this object is destroyed.  Optionally
+        // specify a 'basicAllocator' to which every request is forwarded, and
+        // used to supply the buffer of encoded events.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.  The behavior
+        // is undefined unless 'file' remains open for the lifetime of this
+        // object.
+
+    virtual ~TracingAllocator();
+        // Destroy this allocator object, writing any buffered events to the
+        // trace file, and closing the file if it was opened by this object.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly-allocated block of memory of the specified 'size' (in
+        // bytes) obtained from the wrapped allocator, and record the
+        // allocation.  If 'size' is 0, no memory is allocated, nothing is
+        // recorded, and 0 is returned.
+
+    virtual void deallocate(void *address);
+        // Record the deallocation of the memory block at the specified
+        // 'address', and return the block to the wrapped allocator.  If
+        // 'address' is 0, this method has no effect.  The behavior is
+        // undefined unless 'address' was returned by 'allocate' and has not
+        // already been deallocated.
+
+    int flush();
+        // Write any buffered events to the trace file, and flush the file.
+        // Return 0 on success, and a non-zero value if this allocator is not
+        // tracing (in which case some events may have been lost).
+
+    // ACCESSORS
+    bool isTracing() const;
+        // Return 'true' if this allocator is recording its requests, and
+        // 'false' if the trace file could not be opened or written.
+
+    bsls::Types::Int64 numEvents() const;
+        // Return the number of events recorded by this allocator.
+};
+
+                        // ============================
+                        // class TracingAllocatorReader
+                        // ============================
+
+class TracingAllocatorReader {
+    // This class provides a mechanism for reading, in order, the events of a
+    // trace file written by a 'TracingAllocator'.
+
+    // DATA
+    bsl::FILE            *d_file_p;         // trace file, or 0 if it could
+                                            // not be opened
+    bool                  d_ownsFile;       // 'true' if 'd_file_p' is to be
+                                            // closed at destruction
+    bool                  d_isValid;        // 'false' if the trace is
+                                            // malformed
+    bsls::Types::Int64    d_lastTimestamp;  // timestamp of the last event
+    bsls::Types::UintPtr  d_lastAddress;    // address in the last event
+
+  private:
+    // PRIVATE MANIPULATORS
+    void initialize();
+        // Read and verify the signature of the trace, and invalidate this
+        // reader if it is missing.
+
+    // NOT IMPLEMENTED
+    TracingAllocatorReader(const TracingAllocatorReader&);
+    TracingAllocatorReader& operator=(const TracingAllocatorReader&);
+
+  public:
+    // CREATORS
+    explicit
+    TracingAllocatorReader(const char *path);
+        // Create a reader of the trace file at the specified 'path', which is
+        // closed when this object is destroyed.  The reader is invalid if the
+        // file cannot be opened, or does not begin with the signature of a
+        // trace.
+
+    explicit
+    TracingAllocatorReader(bsl::FILE *file);
+        // Create a reader of the trace in the specified open 'file', which
+        // must be open for reading in binary mode, and is not closed when this
+        // object is destroyed.  The reader is invalid if the file does not
+        // begin with the signature of a trace.  The behavior is undefined
+        // unless 'file' remains open for the lifetime of this object.
+
+    ~TracingAllocatorReader();
+        // Destroy this object, closing the trace file if it was opened by this
+        // object.
+
+    // MANIPULATORS
+    int readEvent(TracingAllocator::Event *result);
+        // Load into the specified 'result' the next event of the trace.
+        // Return 0 on success, 1 (with no effect on 'result') if the trace has
+        // no further events, and a negative value (after which this reader
+        // is invalid) if this reader is invalid or the trace is truncated or
+        // corrupt.
+
+    // ACCESSORS
+    bool isValid() const;
+        // Return 'true' if this reader has an open trace whose signature and
+        // events read so far are well-formed, and 'false' otherwise.
+};
+
+// ============================================================================
+//                         INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                        // ----------------------------
+                        // class TracingAllocatorReader
+                        // ----------------------------
+
+// ACCESSORS
+inline
+bool TracingAllocatorReader::isValid() const
+{
+    return d_isValid;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1239 @@
+// bdlma_tracingallocator.t.cpp                                       -*-C++-*-
+#include <bdlma_tracingallocator.h>
+
+#include <bdls_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+  #include <windows.h>  // 'CreateThread'
+  #include <process.h>  // '_getpid'
+#else
+  #include <pthread.h>
+  #include <unistd.h>   // 'getpid'
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                TEST PLAN
+// ----------------------------------------------------------------------------
+//                                 Overview
+//                                 --------
+// 'bdlma::TracingAllocator' forwards every request to a wrapped allocator and
+// records each one as an event in a trace file, which
+// 'bdlma::TracingAllocatorReader' reads back.  We verify that the events read
+// back are exactly those recorded, including extreme addresses and sizes
+// (using a wrapped allocator that returns fabricated addresses), that the
+// buffer is written to the file when it is full and when it is flushed, that
+// errors opening or writing the file stop the tracing without affecting the
+// allocations, that the reader detects malformed traces, and that events
+// recorded concurrently are consistent.  Traces are written to anonymous
+// temporary files where possible, and otherwise to a file named after the
+// process, which is removed at the end of the test.
+// ----------------------------------------------------------------------------
+// TracingAllocator
+// ----------------
+// CREATORS
+// [ 2] TracingAllocator(const char *path, bslma::Allocator *ba = 0);
+// [ 2] TracingAllocator(bsl::FILE *file, bslma::Allocator *ba = 0);
+// [ 2] ~TracingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+// [ 4] int flush();
+//
+// ACCESSORS
+// [ 2] bool isTracing() const;
+// [ 3] bsls::Types::Int64 numEvents() const;
+//
+// TracingAllocatorReader
+// ----------------------
+// CREATORS
+// [ 2] TracingAllocatorReader(const char *path);
+// [ 2] TracingAllocatorReader(bsl::FILE *file);
+// [ 2] ~TracingAllocatorReader();
+//
+// MANIPULATORS
+// [ 3] int readEvent(TracingAllocator::Event *result);
+//
+// ACCESSORS
+// [ 2] bool isValid() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+// [ 4] CONCERN: Write errors stop the tracing, but not the allocations.
+// [ 5] CONCERN: The reader detects truncated and corrupt traces.
+// [ 6] CONCERN: The 'allocate' and 'deallocate' methods are thread-safe.
+
+// ============================================================================
+//                      STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BDLS_TESTUTIL_ASSERT
+#define LOOP_ASSERT  BDLS_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BDLS_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BDLS_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BDLS_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BDLS_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BDLS_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BDLS_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BDLS_TESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BDLS_TESTUTIL_ASSERTV
+
+#define Q   BDLS_TESTUTIL_Q   // Quote identifier literally.
+#define P   BDLS_TESTUTIL_P   // Print identifier and value.
+#define P_  BDLS_TESTUTIL_P_  // P(X) without '\n'.
+#define T_  BDLS_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BDLS_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL VARIABLES / TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::TracingAllocator       Obj;
+typedef bdlma::TracingAllocatorReader Reader;
+typedef Obj::Event                    Event;
+typedef bsls::Types::Int64            Int64;
+typedef bsls::Types::UintPtr          UintPtr;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                   HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+class FabricatingAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol by returning
+    // addresses set by the caller, without allocating any memory, once an
+    // address has been set.  Until then, requests are forwarded to the
+    // allocator supplied at construction, so that the buffer of a tracing
+    // allocator wrapping this allocator is a real block.  This class is
+    // intended for testing the encoding of addresses and sizes only; the
+    // fabricated "blocks" must never be accessed.
+
+    // DATA
+    UintPtr           d_nextAddress;  // address returned by the next
+                                      // 'allocate', or 0 to forward
+
+    size_type         d_lastSize;     // size passed to the last fabricating
+                                      // 'allocate'
+
+    int               d_numRequests;  // number of fabricated allocations and
+                                      // their deallocations
+
+    void             *d_block_p;      // block obtained from 'd_allocator_p'
+                                      // (held, not owned)
+
+    bslma::Allocator *d_allocator_p;  // allocator used for real blocks (held,
+                                      // not owned)
+
+  public:
+    // CREATORS
+    explicit FabricatingAllocator(bslma::Allocator *basicAllocator)
+    : d_nextAddress(0)
+    , d_lastSize(0)
+    , d_numRequests(0)
+    , d_block_p(0)
+    , d_allocator_p(basicAllocator)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        if (0 == d_nextAddress) {
+            ASSERT(0 == d_block_p);
+
+            d_block_p = d_allocator_p->allocate(size);
+            return d_block_p;                                         // RETURN
+        }
+
+        d_lastSize = size;
+        ++d_numRequests;
+        return reinterpret_cast<void *>(d_nextAddress);
+    }
+
+    virtual void deallocate(void *address)
+    {
+        if (address == d_block_p) {
+            d_allocator_p->deallocate(address);
+            d_block_p = 0;
+            return;                                                   // RETURN
+        }
+
+        ++d_numRequests;
+    }
+
+    void setNextAddress(UintPtr address)
+        // Set the address returned by the next call to 'allocate' to the
+        // specified non-zero 'address'.
+    {
+        d_nextAddress = address;
+    }
+
+    // ACCESSORS
+    size_type lastSize() const
+    {
+        return d_lastSize;
+    }
+
+    int numRequests() const
+    {
+        return d_numRequests;
+    }
+};
+
+static
+const char *tracePath()
+    // Return the name of a trace file in the current directory that is unique
+    // to this process.
+{
+    static char buffer[64];
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    const int pid = _getpid();
+#else
+    const int pid = static_cast<int>(getpid());
+#endif
+
+    bsl::sprintf(buffer, "bdlma_tracingallocator.%d.trace", pid);
+    return buffer;
+}
+
+static
+void writeBytes(bsl::FILE *file, const char *bytes, int length)
+    // Replace the contents of the specified 'file' with the specified 'length'
+    // bytes at the specified 'bytes', and rewind it.
+{
+    bsl::rewind(file);
+    bsl::fwrite(bytes, 1, length, file);
+    bsl::fflush(file);
+    bsl::rewind(file);
+}
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+namespace TestCase6 {
+
+struct ThreadInfo {
+    int  d_numIterations;
+    int  d_seed;
+    Obj *d_obj_p;
+};
+
+extern "C" void *threadFunction(void *arg)
+{
+    ThreadInfo *info = (ThreadInfo *)arg;
+
+    Obj& mX = *info->d_obj_p;
+
+    enum { k_NUM_HELD = 8 };
+
+    void     *held[k_NUM_HELD] = { 0 };
+    unsigned  seed             = info->d_seed;
+
+    for (int i = 0; i < info->d_numIterations; ++i) {
+        seed = seed * 1103515245 + 12345;
+
+        const int j = (seed >> 16) % k_NUM_HELD;
+
+        mX.deallocate(held[j]);
+        held[j] = mX.allocate(1 + (seed >> 8) % 200);
+    }
+
+    for (int j = 0; j < k_NUM_HELD; ++j) {
+        mX.deallocate(held[j]);
+    }
+
+    return arg;
+}
+
+}  // close namespace TestCase6
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator         defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   Write the trace to a file named after the process, and remove
+        //:   the file afterwards.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Capturing and Reading a Trace
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that we want to evaluate allocation strategies against the
+// allocation pattern of one of our services.  We first capture a trace of the
+// service's requests, and then read it back.
+//
+// First, we create a tracing allocator writing to a file, and give it to the
+// code under study (here, a loop allocating and deallocating blocks):
+//..
+    const char *path = tracePath();
+    {
+        bdlma::TracingAllocator tracer(path);
+        ASSERT(tracer.isTracing());
+
+        void *blocks[10];
+        for (int i = 0; i < 10; ++i) {
+            blocks[i] = tracer.allocate(16 * (i + 1));
+        }
+        for (int i = 0; i < 10; ++i) {
+            tracer.deallocate(blocks[i]);
+        }
+        ASSERT(20 == tracer.numEvents());
+    }
+//..
+// Then, after the tracing allocator is destroyed (which flushes the trace), we
+// read the trace back, and verify that each allocation is matched by a
+// deallocation of the same address:
+//..
+    bdlma::TracingAllocatorReader reader(path);
+    ASSERT(reader.isValid());
+
+    bdlma::TracingAllocator::Event event;
+    bsls::Types::UintPtr           addresses[10];
+    bsls::Types::Int64             previousTime = 0;
+
+    for (int i = 0; i < 20; ++i) {
+        int rc = reader.readEvent(&event);
+        ASSERT(0 == rc);
+        ASSERT(previousTime <= event.d_timestamp);
+        previousTime = event.d_timestamp;
+
+        if (i < 10) {
+            ASSERT(bdlma::TracingAllocator::e_ALLOCATE == event.d_type);
+            ASSERT(static_cast<bsls::Types::size_type>(16 * (i + 1))
+                                                           == event.d_size);
+            addresses[i] = event.d_address;
+        }
+        else {
+            ASSERT(bdlma::TracingAllocator::e_DEALLOCATE == event.d_type);
+            ASSERT(addresses[i - 10] == event.d_address);
+        }
+    }
+//..
+// Finally, we observe that the trace has no further events:
+//..
+    ASSERT(1 == reader.readEvent(&event));
+//..
+
+        bsl::remove(tracePath());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 The 'allocate' and 'deallocate' methods are thread-safe, and
+        //:   every request is recorded.
+        //:
+        //: 2 The events of each address alternate between allocation and
+        //:   deallocation, i.e., an address is never allocated in the trace
+        //:   before its previous block is deallocated.
+        //:
+        //: 3 Each thread is assigned a distinct index.
+        //
+        // Plan:
+        //: 1 Have several threads concurrently allocate and deallocate blocks
+        //:   of varying sizes from a tracing allocator.  Read the trace back,
+        //:   and verify the number of events, that the events of each address
+        //:   alternate, that timestamps do not decrease, and that each thread
+        //:   index occurs.  (C-1..3)
+        //
+        // Testing:
+        //   CONCERN: The 'allocate' and 'deallocate' methods are thread-safe.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY TEST" << endl
+                          << "================" << endl;
+
+        using namespace TestCase6;
+
+        enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 20000 };
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        bsl::FILE *file = bsl::tmpfile();
+        ASSERT(file);
+
+        Int64 numEvents = 0;
+        {
+            Obj mX(file, &ta);
+
+            ThreadInfo info[k_NUM_THREADS];
+            ThreadId   ids[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                info[i].d_numIterations = k_NUM_ITERATIONS;
+                info[i].d_seed          = i + 1;
+                info[i].d_obj_p         = &mX;
+
+                ids[i] = createThread(&threadFunction, &info[i]);
+            }
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+            }
+
+            ASSERT(mX.isTracing());
+            numEvents = mX.numEvents();
+            ASSERT(2 * k_NUM_THREADS * k_NUM_ITERATIONS == numEvents);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        bsl::rewind(file);
+        {
+            Reader reader(file);
+            ASSERT(reader.isValid());
+
+            bsl::map<UintPtr, bool> inUse(&ta);
+            bool                    threadSeen[k_NUM_THREADS] = { false };
+            Int64                   lastTimestamp = 0;
+            Int64                   numRead       = 0;
+            Event                   event;
+
+            int rc;
+            while (0 == (rc = reader.readEvent(&event))) {
+                ++numRead;
+
+                ASSERTV(numRead, lastTimestamp <= event.d_timestamp);
+                lastTimestamp = event.d_timestamp;
+
+                // Thread indices are assigned in order of first use, and the
+                // main thread makes no request in this test.
+
+                ASSERTV(event.d_threadIndex, 0 <= event.d_threadIndex);
+                ASSERTV(event.d_threadIndex,
+                        event.d_threadIndex < k_NUM_THREADS);
+                if (0 <= event.d_threadIndex
+                 && event.d_threadIndex < k_NUM_THREADS) {
+                    threadSeen[event.d_threadIndex] = true;
+                }
+
+                bool& isInUse = inUse[event.d_address];
+                if (Obj::e_ALLOCATE == event.d_type) {
+                    ASSERTV(numRead, !isInUse);
+                    ASSERTV(numRead, 1   <= event.d_size);
+                    ASSERTV(numRead, 200 >= event.d_size);
+                    isInUse = true;
+                }
+                else {
+                    ASSERTV(numRead, isInUse);
+                    isInUse = false;
+                }
+            }
+
+            ASSERT(1         == rc);
+            ASSERT(numEvents == numRead);
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERTV(i, threadSeen[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        bsl::fclose(file);
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // MALFORMED TRACES
+        //
+        // Concerns:
+        //: 1 A reader of a file lacking the signature is invalid, and
+        //:   'readEvent' fails with no effect on its argument.
+        //:
+        //: 2 A trace truncated within a record, or having an integer encoded
+        //:   in more than 10 bytes, makes 'readEvent' fail and invalidates the
+        //:   reader.
+        //:
+        //: 3 A trace ending after a complete record is read to its end.
+        //
+        // Plan:
+        //: 1 Write hand-encoded traces to a temporary file, and read them.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   CONCERN: The reader detects truncated and corrupt traces.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MALFORMED TRACES" << endl
+                          << "================" << endl;
+
+        static const struct {
+            int         d_line;
+            const char *d_bytes;
+            int         d_length;
+            int         d_numEvents;  // number of events read successfully
+            int         d_finalRc;    // result of the following 'readEvent'
+        } DATA[] = {
+            //LINE  BYTES                               LEN  EVENTS  RC
+            //----  ----------------------------------  ---  ------  --
+            { L_,   "",                                   0,      0, -1 },
+            { L_,   "BDLMATR",                            7,      0, -1 },
+            { L_,   "BDLMATR2",                           8,      0, -1 },
+            { L_,   "BDLMATR1",                           8,      0,  1 },
+            { L_,   "BDLMATR1\x00\x01\x02\x03",          12,      1,  1 },
+            { L_,   "BDLMATR1\x01\x01\x02",              11,      1,  1 },
+            { L_,   "BDLMATR1\x00\x01\x02",              11,      0, -1 },
+            { L_,   "BDLMATR1\x00\x01\x82",              11,      0, -1 },
+            { L_,   "BDLMATR1\x01\x01\x02\x00",          12,      1, -1 },
+            { L_,   "BDLMATR1\x80\x80\x80\x80\x80"
+                    "\x80\x80\x80\x80\x80\x00\x00\x00",  21,      0, -1 },
+            { L_,   "BDLMATR1\x80\x80\x80\x80\x80"
+                    "\x80\x80\x80\x80\x01\x00\x00\x00",  21,      1,  1 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE       = DATA[ti].d_line;
+            const char *BYTES      = DATA[ti].d_bytes;
+            const int   LENGTH     = DATA[ti].d_length;
+            const int   NUM_EVENTS = DATA[ti].d_numEvents;
+            const int   FINAL_RC   = DATA[ti].d_finalRc;
+
+            bsl::FILE *file = bsl::tmpfile();
+            ASSERTV(LINE, file);
+
+            writeBytes(file, BYTES, LENGTH);
+
+            Reader reader(file);
+            ASSERTV(LINE, (8 <= LENGTH && 0 == bsl::memcmp(BYTES,
+                                                           "BDLMATR1",
+                                                           8))
+                                                          == reader.isValid());
+
+            Event event;
+            for (int i = 0; i < NUM_EVENTS; ++i) {
+                ASSERTV(LINE, i, 0 == reader.readEvent(&event));
+            }
+
+            Event unchanged;
+            bsl::memset(&unchanged, 0xa5, sizeof unchanged);
+            event = unchanged;
+
+            ASSERTV(LINE, FINAL_RC == reader.readEvent(&event));
+            ASSERTV(LINE, 0 == bsl::memcmp(&event, &unchanged, sizeof event));
+            ASSERTV(LINE, (FINAL_RC >= 0) == reader.isValid());
+
+            if (FINAL_RC < 0) {
+                ASSERTV(LINE, 0 > reader.readEvent(&event));
+            }
+
+            bsl::fclose(file);
+        }
+
+        if (verbose) cout << "\tDecoding a hand-encoded trace." << endl;
+        {
+            // Thread 3 allocates 300 bytes at 0x40 after 5ns, then thread 0
+            // deallocates 0x30 after a further 129ns.
+
+            const char BYTES[] = "BDLMATR1"
+                                 "\x06\x05\x80\x01\xAC\x02"
+                                 "\x01\x81\x01\x1F";
+
+            bsl::FILE *file = bsl::tmpfile();
+            writeBytes(file, BYTES, sizeof BYTES - 1);
+
+            Reader reader(file);
+            Event  event;
+
+            ASSERT(0           == reader.readEvent(&event));
+            ASSERT(Obj::e_ALLOCATE == event.d_type);
+            ASSERT(3           == event.d_threadIndex);
+            ASSERT(5           == event.d_timestamp);
+            ASSERT(0x40        == event.d_address);
+            ASSERT(300         == event.d_size);
+
+            ASSERT(0           == reader.readEvent(&event));
+            ASSERT(Obj::e_DEALLOCATE == event.d_type);
+            ASSERT(0           == event.d_threadIndex);
+            ASSERT(134         == event.d_timestamp);
+            ASSERT(0x30        == event.d_address);
+            ASSERT(0           == event.d_size);
+
+            ASSERT(1 == reader.readEvent(&event));
+
+            bsl::fclose(file);
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // BUFFERING, FLUSHING, AND WRITE ERRORS
+        //
+        // Concerns:
+        //: 1 Events are written to the file when the buffer fills, and when
+        //:   'flush' is called, and no event is lost or duplicated.
+        //:
+        //: 2 'flush' returns 0 while tracing.
+        //:
+        //: 3 If the file cannot be written, tracing stops, 'flush' fails, and
+        //:   requests are still forwarded to the wrapped allocator.
+        //
+        // Plan:
+        //: 1 Record enough events to fill the buffer several times, verifying
+        //:   the size of the file as the buffer fills and after 'flush', and
+        //:   read all events back.  (C-1..2)
+        //:
+        //: 2 Create a tracing allocator with a file open only for reading, and
+        //:   verify that it stops tracing but allocates.  (C-3)
+        //
+        // Testing:
+        //   int flush();
+        //   CONCERN: Write errors stop the tracing, but not the allocations.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BUFFERING, FLUSHING, AND WRITE ERRORS" << endl
+                          << "=====================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\tBuffering." << endl;
+        {
+            bsl::FILE *file = bsl::tmpfile();
+            ASSERT(file);
+
+            FabricatingAllocator fa(&ta);
+
+            const int NUM_PAIRS = 3 * Obj::k_BUFFER_SIZE / 4;
+
+            {
+                Obj mX(file, &fa);
+
+                // The signature is written at construction.
+
+                ASSERT(8 == bsl::ftell(file));
+
+                for (int i = 0; i < NUM_PAIRS; ++i) {
+                    fa.setNextAddress(0x1000 + 64 * (i % 100));
+                    void *p = mX.allocate(i % 1000 + 1);
+                    mX.deallocate(p);
+                }
+
+                // Each pair of events takes at least 7 bytes, so the buffer
+                // has been written several times, and holds less than one
+                // buffer's worth.
+
+                const long WRITTEN = bsl::ftell(file);
+
+                ASSERTV(WRITTEN, 3 * Obj::k_BUFFER_SIZE < WRITTEN);
+
+                ASSERT(0 == mX.flush());
+
+                const long FLUSHED = bsl::ftell(file);
+
+                ASSERTV(WRITTEN, FLUSHED, WRITTEN < FLUSHED);
+                ASSERTV(WRITTEN, FLUSHED,
+                        FLUSHED < WRITTEN + Obj::k_BUFFER_SIZE);
+
+                ASSERT(0 == mX.flush());
+                ASSERT(FLUSHED == bsl::ftell(file));
+                ASSERT(2 * NUM_PAIRS == mX.numEvents());
+                ASSERT(mX.isTracing());
+            }
+
+            bsl::rewind(file);
+
+            Reader reader(file);
+            Event  event;
+            for (int i = 0; i < NUM_PAIRS; ++i) {
+                const UintPtr ADDRESS = 0x1000 + 64 * (i % 100);
+
+                ASSERTV(i, 0 == reader.readEvent(&event));
+                ASSERTV(i, Obj::e_ALLOCATE == event.d_type);
+                ASSERTV(i, ADDRESS == event.d_address);
+                ASSERTV(i, bsls::Types::size_type(i % 1000 + 1) ==
+                                                                 event.d_size);
+
+                ASSERTV(i, 0 == reader.readEvent(&event));
+                ASSERTV(i, Obj::e_DEALLOCATE == event.d_type);
+                ASSERTV(i, ADDRESS == event.d_address);
+            }
+            ASSERT(1 == reader.readEvent(&event));
+
+            bsl::fclose(file);
+        }
+
+        if (verbose) cout << "\tWrite errors." << endl;
+        {
+            const char *PATH = tracePath();
+
+            bsl::FILE *file = bsl::fopen(PATH, "wb");
+            ASSERT(file);
+            bsl::fclose(file);
+
+            file = bsl::fopen(PATH, "rb");
+            ASSERT(file);
+
+            {
+                Obj mX(file, &ta);
+
+                ASSERT(!mX.isTracing());
+                ASSERT(0 != mX.flush());
+
+                const Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+                void *p = mX.allocate(100);
+                ASSERT(NUM_BLOCKS + 1 == ta.numBlocksInUse());
+                mX.deallocate(p);
+                ASSERT(NUM_BLOCKS     == ta.numBlocksInUse());
+
+                ASSERT(0 == mX.numEvents());
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+
+            bsl::fclose(file);
+            bsl::remove(PATH);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // RECORDING AND READING EVENTS
+        //
+        // Concerns:
+        //: 1 Each allocation and deallocation is forwarded to the wrapped
+        //:   allocator and recorded, and 'numEvents' counts the events.
+        //:
+        //: 2 Allocations of 0 bytes and deallocations of 0 are neither
+        //:   forwarded nor recorded.
+        //:
+        //: 3 The reader returns each event with the type, thread index,
+        //:   address, and size recorded, and with non-decreasing timestamps.
+        //:
+        //: 4 Addresses and sizes throughout their ranges, and increasing and
+        //:   decreasing addresses, are encoded exactly.
+        //:
+        //: 5 Timestamps measure the time elapsed since the creation of the
+        //:   allocator.
+        //
+        // Plan:
+        //: 1 Using a wrapped allocator that returns fabricated addresses,
+        //:   record allocations and deallocations of a table of addresses and
+        //:   sizes, and read them back.  (C-1..4)
+        //:
+        //: 2 Record real allocations with a delay between them, and verify
+        //:   the blocks and timestamps.  (C-1, 3, 5)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   bsls::Types::Int64 numEvents() const;
+        //   int readEvent(TracingAllocator::Event *result);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RECORDING AND READING EVENTS" << endl
+                          << "============================" << endl;
+
+        if (verbose) cout << "\tFabricated addresses and sizes." << endl;
+        {
+            typedef bsls::Types::size_type size_type;
+
+            const UintPtr   MAX_ADDRESS = ~UintPtr(0);
+            const size_type MAX_SIZE    = ~size_type(0);
+
+            static const struct {
+                int       d_line;
+                UintPtr   d_address;
+                size_type d_size;
+            } DATA[] = {
+                //LINE  ADDRESS                 SIZE
+                //----  ----------------------  ---------------
+                { L_,   0x10,                   1              },
+                { L_,   0x10,                   127            },
+                { L_,   0x20,                   128            },
+                { L_,   0x18,                   16383          },
+                { L_,   0x7FFFFFF0,             16384          },
+                { L_,   0x10,                   0xFFFFFFFF     },
+                { L_,   MAX_ADDRESS & ~0xF,     MAX_SIZE       },
+                { L_,   0x10,                   MAX_SIZE / 2   },
+                { L_,   MAX_ADDRESS / 2 + 1,    3              },
+                { L_,   MAX_ADDRESS / 2 - 15,   5              },
+                { L_,   0x8,                    7              },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            bsl::FILE *file = bsl::tmpfile();
+            ASSERT(file);
+
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+            FabricatingAllocator fa(&ta);
+            {
+                Obj mX(file, &fa);  const Obj& X = mX;
+
+                ASSERT(0 == mX.allocate(0));
+                mX.deallocate(0);
+                ASSERT(0 == fa.numRequests());
+                ASSERT(0 == X.numEvents());
+
+                for (int ti = 0; ti < NUM_DATA; ++ti) {
+                    const int       LINE    = DATA[ti].d_line;
+                    const UintPtr   ADDRESS = DATA[ti].d_address;
+                    const size_type SIZE    = DATA[ti].d_size;
+
+                    fa.setNextAddress(ADDRESS);
+
+                    void *p = mX.allocate(SIZE);
+
+                    ASSERTV(LINE, ADDRESS == reinterpret_cast<UintPtr>(p));
+                    ASSERTV(LINE, SIZE    == fa.lastSize());
+
+                    mX.deallocate(p);
+
+                    ASSERTV(LINE, 2 * ti + 2 == fa.numRequests());
+                    ASSERTV(LINE, 2 * ti + 2 == X.numEvents());
+                }
+            }
+
+            bsl::rewind(file);
+
+            Reader reader(file);
+            ASSERT(reader.isValid());
+
+            Event event;
+            Int64 lastTimestamp = 0;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int       LINE    = DATA[ti].d_line;
+                const UintPtr   ADDRESS = DATA[ti].d_address;
+                const size_type SIZE    = DATA[ti].d_size;
+
+                ASSERTV(LINE, 0 == reader.readEvent(&event));
+                ASSERTV(LINE, Obj::e_ALLOCATE == event.d_type);
+                ASSERTV(LINE, 0       == event.d_threadIndex);
+                ASSERTV(LINE, ADDRESS == event.d_address);
+                ASSERTV(LINE, SIZE    == event.d_size);
+                ASSERTV(LINE, lastTimestamp <= event.d_timestamp);
+                lastTimestamp = event.d_timestamp;
+
+                ASSERTV(LINE, 0 == reader.readEvent(&event));
+                ASSERTV(LINE, Obj::e_DEALLOCATE == event.d_type);
+                ASSERTV(LINE, 0       == event.d_threadIndex);
+                ASSERTV(LINE, ADDRESS == event.d_address);
+                ASSERTV(LINE, 0       == event.d_size);
+                ASSERTV(LINE, lastTimestamp <= event.d_timestamp);
+                lastTimestamp = event.d_timestamp;
+            }
+
+            ASSERT(1 == reader.readEvent(&event));
+            ASSERT(reader.isValid());
+
+            bsl::fclose(file);
+        }
+
+        if (verbose) cout << "\tReal blocks and timestamps." << endl;
+        {
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+
+            bsl::FILE *file = bsl::tmpfile();
+            ASSERT(file);
+
+            void *blocks[3];
+            {
+                Obj mX(file, &ta);
+
+                const Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+                Sleep(10);
+#else
+                usleep(10000);
+#endif
+                for (int i = 0; i < 3; ++i) {
+                    blocks[i] = mX.allocate(10 * (i + 1));
+                    bsl::memset(blocks[i], 0xa5, 10 * (i + 1));
+                }
+                ASSERT(NUM_BLOCKS + 3 == ta.numBlocksInUse());
+
+                mX.deallocate(blocks[1]);
+                ASSERT(NUM_BLOCKS + 2 == ta.numBlocksInUse());
+
+                mX.deallocate(blocks[0]);
+                mX.deallocate(blocks[2]);
+                ASSERT(NUM_BLOCKS == ta.numBlocksInUse());
+                ASSERT(6 == mX.numEvents());
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+
+            bsl::rewind(file);
+
+            Reader reader(file);
+            Event  event;
+
+            for (int i = 0; i < 3; ++i) {
+                ASSERTV(i, 0 == reader.readEvent(&event));
+                ASSERTV(i, Obj::e_ALLOCATE == event.d_type);
+                ASSERTV(i, reinterpret_cast<UintPtr>(blocks[i]) ==
+                                                              event.d_address);
+                ASSERTV(i, bsls::Types::size_type(10 * (i + 1)) ==
+                                                                 event.d_size);
+
+                // The first event follows the creation of the allocator by at
+                // least the delay.
+
+                ASSERTV(i, event.d_timestamp, 10000000 <= event.d_timestamp);
+            }
+
+            const int ORDER[] = { 1, 0, 2 };
+            for (int i = 0; i < 3; ++i) {
+                ASSERTV(i, 0 == reader.readEvent(&event));
+                ASSERTV(i, Obj::e_DEALLOCATE == event.d_type);
+                ASSERTV(i, reinterpret_cast<UintPtr>(blocks[ORDER[i]]) ==
+                                                              event.d_address);
+            }
+            ASSERT(1 == reader.readEvent(&event));
+
+            bsl::fclose(file);
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CTORS, DTORS, AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The constructor taking a path creates (or truncates) the file,
+        //:   writes the signature, and closes the file at destruction.
+        //:
+        //: 2 The constructor taking a file writes the signature to it, and
+        //:   does not close it at destruction.
+        //:
+        //: 3 If the file cannot be created, the allocator is not tracing, but
+        //:   forwards requests to the wrapped allocator.
+        //:
+        //: 4 The buffer is allocated from the supplied allocator, or from the
+        //:   default allocator if none is supplied, and released at
+        //:   destruction.
+        //:
+        //: 5 A reader of a trace file is valid, and a reader of a missing file
+        //:   is not.
+        //
+        // Plan:
+        //: 1 Create allocators with each constructor, with and without an
+        //:   allocator, and verify 'isTracing', the memory used, and the
+        //:   file.  Create readers with each constructor, and verify
+        //:   'isValid'.  (C-1..5)
+        //
+        // Testing:
+        //   TracingAllocator(const char *path, bslma::Allocator *ba = 0);
+        //   TracingAllocator(bsl::FILE *file, bslma::Allocator *ba = 0);
+        //   ~TracingAllocator();
+        //   bool isTracing() const;
+        //   TracingAllocatorReader(const char *path);
+        //   TracingAllocatorReader(bsl::FILE *file);
+        //   ~TracingAllocatorReader();
+        //   bool isValid() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CTORS, DTORS, AND BASIC ACCESSORS" << endl
+                          << "=================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        const char *PATH = tracePath();
+
+        if (verbose) cout << "\tNamed files." << endl;
+        {
+            {
+                Obj mX(PATH);  const Obj& X = mX;
+
+                ASSERT(X.isTracing());
+                ASSERT(0 == X.numEvents());
+                ASSERT(1 == defaultAllocator.numBlocksInUse());
+            }
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+            {
+                Reader reader(PATH);
+                ASSERT(reader.isValid());
+
+                Event event;
+                ASSERT(1 == reader.readEvent(&event));
+            }
+
+            {
+                Obj mX(PATH, &ta);  const Obj& X = mX;
+
+                ASSERT(X.isTracing());
+                ASSERT(1 == ta.numBlocksInUse());
+
+                mX.deallocate(mX.allocate(10));
+                ASSERT(2 == X.numEvents());
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+
+            {
+                Reader reader(PATH);
+                ASSERT(reader.isValid());
+
+                Event event;
+                ASSERT(0 == reader.readEvent(&event));
+                ASSERT(0 == reader.readEvent(&event));
+                ASSERT(1 == reader.readEvent(&event));
+            }
+
+            // Recreating the trace truncates the file.
+
+            {
+                Obj mX(PATH, &ta);
+            }
+            {
+                Reader reader(PATH);
+                ASSERT(reader.isValid());
+
+                Event event;
+                ASSERT(1 == reader.readEvent(&event));
+            }
+
+            bsl::remove(PATH);
+
+            {
+                Reader reader(PATH);
+                ASSERT(!reader.isValid());
+
+                Event event;
+                ASSERT(0 > reader.readEvent(&event));
+            }
+        }
+
+        if (verbose) cout << "\tUnwritable path." << endl;
+        {
+            Obj mX("no-such-directory/trace", &ta);  const Obj& X = mX;
+
+            ASSERT(!X.isTracing());
+            ASSERT(0 == ta.numBlocksInUse());
+
+            void *p = mX.allocate(10);
+            ASSERT(1 == ta.numBlocksInUse());
+            mX.deallocate(p);
+            ASSERT(0 == ta.numBlocksInUse());
+            ASSERT(0 == X.numEvents());
+        }
+
+        if (verbose) cout << "\tOpen files." << endl;
+        {
+            bsl::FILE *file = bsl::tmpfile();
+            ASSERT(file);
+
+            {
+                Obj mX(file, &ta);  const Obj& X = mX;
+
+                ASSERT(X.isTracing());
+                ASSERT(1 == ta.numBlocksInUse());
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+
+            // The file is still open.
+
+            ASSERT(8 == bsl::ftell(file));
+            bsl::rewind(file);
+
+            {
+                Reader reader(file);
+                ASSERT(reader.isValid());
+            }
+
+            // The file is still open.
+
+            ASSERT(8 == bsl::ftell(file));
+
+            bsl::fclose(file);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Record allocations and deallocations of various sizes to a
+        //:   temporary file, and read them back.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        bsl::FILE *file = bsl::tmpfile();
+        ASSERT(file);
+
+        void *blocks[10];
+        {
+            Obj mX(file, &ta);  const Obj& X = mX;
+
+            for (int i = 0; i < 10; ++i) {
+                blocks[i] = mX.allocate(16 * (i + 1));
+                bsl::memset(blocks[i], i, 16 * (i + 1));
+            }
+            for (int i = 0; i < 10; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            ASSERT(X.isTracing());
+            ASSERT(20 == X.numEvents());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        bsl::rewind(file);
+
+        Reader reader(file);
+        ASSERT(reader.isValid());
+
+        Event event;
+        for (int i = 0; i < 20; ++i) {
+            ASSERTV(i, 0 == reader.readEvent(&event));
+            ASSERTV(i, (i < 10 ? Obj::e_ALLOCATE : Obj::e_DEALLOCATE)
+                                                             == event.d_type);
+            ASSERTV(i, reinterpret_cast<UintPtr>(blocks[i % 10])
+                                                           == event.d_address);
+
+            if (veryVerbose) {
+                P_(event.d_type) P_(event.d_timestamp) P(event.d_size)
+            }
+        }
+        ASSERT(1 == reader.readEvent(&event));
+
+        bsl::fclose(file);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
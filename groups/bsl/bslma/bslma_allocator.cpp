@@ -4,6 +4,8 @@
 #include <bsls_ident.h>
 BSLS_IDENT("$Id$ $CSID$")
 
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
 #include <bsls_bslexceptionutil.h>
 
 namespace BloombergLP {
@@ -20,6 +22,39 @@ Allocator::~Allocator()
 {
 }
 
+// MANIPULATORS
+void *Allocator::allocateAligned(size_type size, size_type alignment)
+{
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    if (alignment > static_cast<size_type>(
+                                   bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT)) {
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    // Memory is aligned for any object of the requested size, so a multiple of
+    // 'alignment' is aligned to (at least) 'alignment'.
+
+    return allocate((size + alignment - 1) & ~(alignment - 1));
+}
+
+void Allocator::deallocateSized(void *address, size_type)
+{
+    deallocate(address);
+}
+
+void Allocator::deallocateAligned(void *address, size_type, size_type)
+{
+    deallocate(address);
+}
+
+// ACCESSORS
+bool Allocator::hasNoOpDeallocate() const
+{
+    return false;
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
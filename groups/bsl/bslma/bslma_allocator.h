@@ -68,6 +68,38 @@ BSLS_IDENT("$Id: $")
 // memory.  Memory is allocated from the pool until it is dry; only then does
 // new memory flow into the pool from the allocator.
 //
+///Sized Deallocation
+///------------------
+// Most clients (e.g., containers) know the size of every block they return to
+// an allocator, and can pass it to 'deallocateSized' instead of calling
+// 'deallocate'.  An allocator that would otherwise have to recover the size
+// of a block -- by reading a header stored in front of it, or by searching
+// for the pool that owns it -- can override 'deallocateSized' to skip that
+// work.  The default implementation simply calls 'deallocate', so existing
+// allocators are unaffected, and the size is purely a hint that a concrete
+// allocator is free to ignore.  'bsl::allocator' forwards the sizes of the
+// blocks it deallocates through this method.
+//
+///Extended Alignment
+///------------------
+// 'allocate' returns memory aligned for any object of the requested size, up
+// to the maximal fundamental alignment of the platform
+// ('bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT').  Some data structures need a
+// stricter ("extended") alignment -- for example, to place a frequently
+// modified object on a cache line of its own, so that it is not falsely
+// shared with objects used by other threads.  'allocateAligned' returns a
+// block aligned to a caller-specified power of two; the block is returned to
+// the allocator with 'deallocateAligned', passing the same size and alignment
+// (but not with 'deallocateSized').  The default implementation of
+// 'allocateAligned' supports only alignments up to the maximal fundamental
+// alignment, and allocators that can do better override it -- e.g.,
+// sequential allocators, which need only skip a few bytes of their current
+// buffer, and 'bslma::NewDeleteAllocator' and 'bslma::MallocFreeAllocator',
+// which use the aligned allocation functions of the platform.  The default
+// implementation of 'deallocateAligned' calls 'deallocate'; an allocator
+// whose extended-alignment blocks must be released differently (e.g., with
+// an aligned 'operator delete') overrides it as well.
+//
 ///Overloaded Global Operators 'new' and 'delete'
 ///----------------------------------------------
 // This component overloads the global operator 'new' to allow convenient
@@ -429,12 +461,56 @@ class Allocator {
         // conforms to the platform requirement for any object of the specified
         // 'size'.
 
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes) whose address is a multiple of the
+        // specified 'alignment'.  If 'size' is 0, a null pointer is returned
+        // with no other effect.  The block is returned to this allocator by
+        // calling 'deallocateAligned' with the same 'size' and 'alignment'.
+        // If this allocator cannot return the requested number of bytes at
+        // the requested alignment, then it will throw a 'std::bad_alloc'
+        // exception in an exception-enabled build, or else will abort the
+        // program in a non-exception build.  The behavior is undefined unless
+        // '0 <= size' and 'alignment' is a positive power of two.  The default
+        // implementation satisfies an 'alignment' no greater than
+        // 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT' by calling 'allocate' with
+        // 'size' rounded up to a multiple of 'alignment', and throws
+        // 'std::bad_alloc' for any greater 'alignment'; derived allocators
+        // that can supply extended alignment override this method.
+
     virtual void deallocate(void *address) = 0;
         // Return the memory block at the specified 'address' back to this
         // allocator.  If 'address' is 0, this function has no effect.  The
         // behavior is undefined unless 'address' was allocated using this
         // allocator object and has not already been deallocated.
 
+    virtual void deallocateSized(void *address, size_type size);
+        // Return the memory block at the specified 'address', which was
+        // obtained by a call to 'allocate' with the specified 'size', back to
+        // this allocator.  If 'address' is 0, this function has no effect.
+        // The behavior is undefined unless 'address' was allocated using this
+        // allocator object by a call to 'allocate(size)' and has not already
+        // been deallocated.  The default implementation calls
+        // 'deallocate(address)'; derived allocators that can release a block
+        // more cheaply when its size is known (e.g., without reading a header
+        // or searching for the owning pool) may override this method.  Note
+        // that 'size' need not be passed by clients that do not track it:
+        // 'deallocate' remains the primary way of returning memory.
+
+    virtual void deallocateAligned(void      *address,
+                                   size_type  size,
+                                   size_type  alignment);
+        // Return the memory block at the specified 'address', which was
+        // obtained by a call to 'allocateAligned' with the specified 'size'
+        // and 'alignment', back to this allocator.  If 'address' is 0, this
+        // function has no effect.  The behavior is undefined unless 'address'
+        // was allocated using this allocator object by a call to
+        // 'allocateAligned(size, alignment)' and has not already been
+        // deallocated.  The default implementation calls
+        // 'deallocate(address)'; derived allocators whose extended-alignment
+        // blocks must be released differently from other blocks override this
+        // method along with 'allocateAligned'.
+
     template <class TYPE>
     void deleteObject(const TYPE *object);
         // Destroy the specified 'object' based on its dynamic type and then
@@ -454,6 +530,17 @@ class Allocator {
         // i.e., the address is (numerically) the same as when it was
         // originally dispensed by this allocator, and has not already been
         // deallocated.
+
+    // ACCESSORS
+    virtual bool hasNoOpDeallocate() const;
+        // Return 'true' if 'deallocate' and 'deallocateSized' have no effect
+        // for this allocator (e.g., because all of its memory is reclaimed at
+        // once when the allocator is released or destroyed), and 'false'
+        // otherwise.  Containers may query this method to skip returning the
+        // memory of each element individually on destruction (see
+        // 'bslma_winkoututil').  The default implementation returns 'false';
+        // derived allocators whose 'deallocate' never has an effect may
+        // override this method.
 };
 
 }  // close package namespace
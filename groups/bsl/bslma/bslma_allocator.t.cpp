@@ -28,7 +28,11 @@ using namespace BloombergLP;
 //-----------------------------------------------------------------------------
 // [ 1] virtual ~bslma::Allocator();
 // [ 1] virtual void *allocate(size_type size) = 0;
+// [ 1] virtual void *allocateAligned(size_type size, size_type align);
 // [ 1] virtual void deallocate(void *address) = 0;
+// [ 1] virtual void deallocateSized(void *address, size_type size);
+// [ 1] virtual void deallocateAligned(void *, size_type, size_type);
+// [ 1] virtual bool hasNoOpDeallocate() const;
 // [ 2] template<typename TYPE> deleteObject(const TYPE *);
 // [ 3] template<typename TYPE> deleteObjectRaw(const TYPE *);
 // [ 4] void *operator new(int size, bslma::Allocator& basicAllocator);
@@ -885,12 +889,24 @@ int main(int argc, char *argv[])
         //   Up-cast a reference to the object to the base class
         //   'bslma::Allocator'.  Using the base class reference invoke both
         //   'allocate' and 'deallocate' methods.  Verify that the correct
-        //   implementations of the methods are called.
+        //   implementations of the methods are called.  Finally, invoke
+        //   'deallocateSized', which 'my_Allocator' does not override, and
+        //   verify that the default implementation calls 'deallocate'.
+        //   Similarly, invoke 'allocateAligned' and verify that the default
+        //   implementation calls 'allocate' with the size rounded up to the
+        //   alignment, and throws 'bsl::bad_alloc' (in exception-enabled
+        //   builds) for alignments exceeding the maximal alignment, and
+        //   that the default 'deallocateAligned' calls 'deallocate'.  Verify
+        //   that the default 'hasNoOpDeallocate' returns 'false'.
         //
         // Testing:
         //   virtual ~bslma::Allocator();
         //   virtual void *allocate(size_type size) = 0;
+        //   virtual void *allocateAligned(size_type size, size_type align);
         //   virtual void deallocate(void *address) = 0;
+        //   virtual void deallocateSized(void *address, size_type size);
+        //   virtual void deallocateAligned(void *, size_type, size_type);
+        //   virtual bool hasNoOpDeallocate() const;
         // --------------------------------------------------------------------
 
         if (verbose) printf("\nPROTOCOL TEST"
@@ -904,6 +920,65 @@ int main(int argc, char *argv[])
             a.deallocate(&myA);                 ASSERT(2 == myA.fun());
         }
 
+        if (verbose) printf("\nTesting default 'deallocateSized'\n");
+        {
+            ASSERT(&myA == a.allocate(24));     ASSERT(1 == myA.fun());
+            ASSERT(24 == myA.arg());
+            ASSERT(1 == myA.deallocateCount());
+
+            a.deallocateSized(&myA, 24);        ASSERT(2 == myA.fun());
+            ASSERT(2 == myA.deallocateCount());
+        }
+
+        if (verbose) printf("\nTesting default 'allocateAligned'\n");
+        {
+            const bslma::Allocator::size_type MAX_ALIGN =
+                                      bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+            const int NUM_ALLOCATIONS = myA.allocateCount();
+
+            ASSERT(&myA == a.allocateAligned(10, 1));
+            ASSERT(1 == myA.fun());             ASSERT(10 == myA.arg());
+
+            ASSERT(&myA == a.allocateAligned(10, 8));
+            ASSERT(1 == myA.fun());             ASSERT(16 == myA.arg());
+
+            ASSERT(&myA == a.allocateAligned(24, 8));
+            ASSERT(1 == myA.fun());             ASSERT(24 == myA.arg());
+
+            ASSERT(&myA == a.allocateAligned(1, MAX_ALIGN));
+            ASSERT(1 == myA.fun());             ASSERT(MAX_ALIGN == myA.arg());
+
+            ASSERT(NUM_ALLOCATIONS + 4 == myA.allocateCount());
+
+#ifdef BDE_BUILD_TARGET_EXC
+            bool caught = false;
+            try {
+                a.allocateAligned(1, 2 * MAX_ALIGN);
+            }
+            catch (const std::bad_alloc&) {
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(NUM_ALLOCATIONS + 4 == myA.allocateCount());
+#endif
+        }
+
+        if (verbose) printf("\nTesting default 'deallocateAligned'\n");
+        {
+            const int NUM_DEALLOCATIONS = myA.deallocateCount();
+
+            a.deallocateAligned(&myA, 10, 8);   ASSERT(2 == myA.fun());
+            ASSERT(NUM_DEALLOCATIONS + 1 == myA.deallocateCount());
+        }
+
+        if (verbose) printf("\nTesting default 'hasNoOpDeallocate'\n");
+        {
+            const bslma::Allocator& A = myA;
+
+            ASSERT(false == A.hasNoOpDeallocate());
+        }
+
       } break;
       default: {
         fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
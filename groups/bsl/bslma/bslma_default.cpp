@@ -6,9 +6,51 @@ BSLS_IDENT("$Id$ $CSID$")
 
 #include <bslma_allocator.h>            // for testing only
 #include <bsls_assert.h>
+#include <bsls_bslonce.h>
+#include <bsls_bslthreadspecific.h>
+#include <bsls_objectbuffer.h>
+
+#include <new>
 
 namespace BloombergLP {
 
+extern "C" void bslma_Default_threadDefaultAllocatorExited(void *allocator);
+    // Remove the specified 'allocator', the thread default allocator of a
+    // thread that is exiting, so that the thread is no longer counted as
+    // having one.  Note that this function is invoked only on POSIX
+    // platforms.
+
+namespace {
+
+typedef bsls::AtomicOperations AtomicOps;
+
+bsls::BslThreadSpecific& threadDefaultAllocatorKey()
+    // Return a reference providing modifiable access to the key holding the
+    // thread default allocator of each thread, creating it if necessary.
+{
+    static bsls::ObjectBuffer<bsls::BslThreadSpecific> s_key;
+    static bsls::BslOnce s_once = BSLS_BSLONCE_INITIALIZER;
+
+    bsls::BslOnceGuard onceGuard;
+    if (onceGuard.enter(&s_once)) {
+        new (s_key.buffer()) bsls::BslThreadSpecific(
+                                 &bslma_Default_threadDefaultAllocatorExited);
+    }
+
+    return s_key.object();
+}
+
+}  // close unnamed namespace
+
+extern "C" void bslma_Default_threadDefaultAllocatorExited(void *allocator)
+{
+    // The value of the key has already been reset to 0, so reinstate it in
+    // order for it to be removed in the usual way.
+
+    threadDefaultAllocatorKey().setValue(allocator);
+    bslma::Default::setThreadDefaultAllocator(0);
+}
+
 namespace bslma {
 
 class Allocator;
@@ -24,10 +66,20 @@ class Allocator;
 bsls::AtomicOperations::AtomicTypes::Pointer Default::s_allocator = {0};
 bsls::AtomicOperations::AtomicTypes::Int     Default::s_locked    = {0};
 
+                        // *** thread default allocator ***
+
+bsls::AtomicOperations::AtomicTypes::Int Default::s_numThreadDefaults = {0};
+
                         // *** global allocator ***
 
 bsls::AtomicOperations::AtomicTypes::Pointer Default::s_globalAllocator = {0};
 
+// PRIVATE CLASS METHODS
+Allocator *Default::lookupThreadDefaultAllocator()
+{
+    return static_cast<Allocator *>(threadDefaultAllocatorKey().value());
+}
+
 // CLASS METHODS
 
                         // *** default allocator ***
@@ -51,6 +103,30 @@ void Default::setDefaultAllocatorRaw(Allocator *basicAllocator)
     bsls::AtomicOperations::setPtrRelease(&s_allocator, basicAllocator);
 }
 
+                        // *** thread default allocator ***
+
+Allocator *Default::setThreadDefaultAllocator(Allocator *basicAllocator)
+{
+    bsls::BslThreadSpecific& key = threadDefaultAllocatorKey();
+
+    Allocator *previous = static_cast<Allocator *>(key.value());
+
+    key.setValue(basicAllocator);
+
+    // 's_numThreadDefaults' counts the threads having a thread default
+    // allocator.  A thread always observes its own increments, so relaxed
+    // operations suffice.
+
+    if (!previous && basicAllocator) {
+        AtomicOps::addIntRelaxed(&s_numThreadDefaults, 1);
+    }
+    else if (previous && !basicAllocator) {
+        AtomicOps::addIntRelaxed(&s_numThreadDefaults, -1);
+    }
+
+    return previous;
+}
+
                         // *** global allocator ***
 
 Allocator *Default::setGlobalAllocator(Allocator *basicAllocator)
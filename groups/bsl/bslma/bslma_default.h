@@ -79,6 +79,37 @@ BSLS_IDENT("$Id: $")
 // libraries that are on the link line.  *AVOID* file-scope static objects that
 // require runtime initialization, *especially* those that take an allocator.
 //
+///Thread Default Allocator
+///------------------------
+// A thread may install a *thread* *default* allocator that, for that thread
+// only, takes precedence over the process-wide default allocator described
+// above.  'bslma::Default::setThreadDefaultAllocator' installs (or, given 0,
+// removes) the thread default allocator of the calling thread and returns the
+// one it replaces, and 'bslma::Default::threadDefaultAllocator' returns it (or
+// 0 if there is none).  While the calling thread has a thread default
+// allocator, 'bslma::Default::defaultAllocator', and
+// 'bslma::Default::allocator' with no argument or an explicit 0, return it
+// instead of the process-wide default allocator.  This allows, for example, a
+// worker thread to have all objects that it creates without an explicitly
+// supplied allocator draw their memory from an arena belonging to that thread
+// or to the request it is serving.  The 'bslma_threaddefaultallocatorguard'
+// component provides a scoped guard that is the recommended means of
+// installing a thread default allocator.
+//
+// Installing a thread default allocator is *not* subject to the lock
+// described above, and neither affects nor observes the process-wide default
+// allocator.  'bslma::Default::defaultAllocator' locks the process-wide
+// default allocator as usual, whether or not the calling thread has a thread
+// default allocator.  The process-wide default allocator itself is available
+// through 'bslma::Default::processDefaultAllocator'.
+//
+// Note that, as long as no thread has a thread default allocator,
+// 'bslma::Default::defaultAllocator' pays only for a single relaxed atomic
+// load beyond what it did before, and does not consult thread-specific
+// storage at all.  Also note that an object that is destroyed by a thread
+// other than the one that created it, or after the thread default allocator
+// is removed, still returns its memory to the allocator that supplied it.
+//
 ///Global Allocator
 ///----------------
 // The interface pertaining to the global allocator is comparatively much
@@ -644,6 +675,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_atomicoperations.h>
 #endif
 
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
 #ifndef INCLUDED_BSLMA_NEWDELETEALLOCATOR
 #include <bslma_newdeleteallocator.h>
 #endif
@@ -669,9 +704,20 @@ struct Default {
     static bsls::AtomicOperations::AtomicTypes::Int     s_locked;
                                                   // lock to disable non-Raw
                                                   // 'set' of default allocator
+    static bsls::AtomicOperations::AtomicTypes::Int     s_numThreadDefaults;
+                                                  // number of threads having
+                                                  // a thread default
+                                                  // allocator
     static bsls::AtomicOperations::AtomicTypes::Pointer s_globalAllocator;
                                                   // the global allocator
 
+    // PRIVATE CLASS METHODS
+    static Allocator *lookupThreadDefaultAllocator();
+        // Return the address of the thread default allocator of the calling
+        // thread, or 0 if it has none.  Note that, unlike
+        // 'threadDefaultAllocator', this method always consults
+        // thread-specific storage.
+
   public:
     // CLASS METHODS
 
@@ -710,13 +756,14 @@ struct Default {
         // disabled by this method.
 
     static Allocator *defaultAllocator();
-        // Return the address of the default allocator and disable all
-        // subsequent calls to the 'setDefaultAllocator' method.  Note that
-        // prior to the first call to 'setDefaultAllocator' or
-        // 'setDefaultAllocatorRaw' methods, the address of the default
-        // allocator is that of the 'NewDeleteAllocator' singleton.  Also note
-        // that subsequent calls to 'setDefaultAllocatorRaw' method are *not*
-        // disabled by this method.
+        // Return the address of the thread default allocator of the calling
+        // thread if it has one, and the address of the process-wide default
+        // allocator otherwise, and disable all subsequent calls to the
+        // 'setDefaultAllocator' method.  Note that prior to the first call to
+        // 'setDefaultAllocator' or 'setDefaultAllocatorRaw' methods, the
+        // address of the process-wide default allocator is that of the
+        // 'NewDeleteAllocator' singleton.  Also note that subsequent calls to
+        // 'setDefaultAllocatorRaw' method are *not* disabled by this method.
 
     static Allocator *allocator(Allocator *basicAllocator = 0);
         // Return the allocator returned by 'defaultAllocator' and disable all
@@ -724,6 +771,32 @@ struct Default {
         // optionally-specified 'basicAllocator' is 0; return 'basicAllocator'
         // otherwise.
 
+    static Allocator *processDefaultAllocator();
+        // Return the address of the process-wide default allocator, ignoring
+        // any thread default allocator of the calling thread, and disable all
+        // subsequent calls to the 'setDefaultAllocator' method.
+
+                        // *** thread default allocator ***
+
+    static Allocator *setThreadDefaultAllocator(Allocator *basicAllocator);
+        // Install the specified 'basicAllocator' as the thread default
+        // allocator of the calling thread, or, if 'basicAllocator' is 0,
+        // remove the thread default allocator of the calling thread.  Return
+        // the address of the thread default allocator of the calling thread
+        // in effect immediately before calling this method, or 0 if there was
+        // none.  The behavior is undefined unless 'basicAllocator' is 0 or is
+        // the address of an allocator that outlives its use as a thread
+        // default allocator, including by all objects created with it.  Note
+        // that this method succeeds whether or not the process-wide default
+        // allocator is locked, and has no effect on other threads.  Also note
+        // that 'ThreadDefaultAllocatorGuard' (see
+        // 'bslma_threaddefaultallocatorguard') is the recommended means of
+        // calling this method.
+
+    static Allocator *threadDefaultAllocator();
+        // Return the address of the thread default allocator of the calling
+        // thread, or 0 if it has none.
+
                         // *** global allocator ***
 
     static Allocator *globalAllocator(Allocator *basicAllocator = 0);
@@ -770,6 +843,30 @@ void Default::lockDefaultAllocator()
 
 inline
 Allocator *Default::defaultAllocator()
+{
+    Allocator *processAllocator = processDefaultAllocator();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                bsls::AtomicOperations::getIntRelaxed(&s_numThreadDefaults))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        Allocator *threadAllocator = lookupThreadDefaultAllocator();
+        if (threadAllocator) {
+            return threadAllocator;                                   // RETURN
+        }
+    }
+
+    return processAllocator;
+}
+
+inline
+Allocator *Default::allocator(Allocator *basicAllocator)
+{
+    return basicAllocator ? basicAllocator : defaultAllocator();
+}
+
+inline
+Allocator *Default::processDefaultAllocator()
 {
     if (!bsls::AtomicOperations::getPtrAcquire(&s_allocator)) {
         setDefaultAllocatorRaw(&NewDeleteAllocator::singleton());
@@ -783,10 +880,14 @@ Allocator *Default::defaultAllocator()
                          bsls::AtomicOperations::getPtrRelaxed(&s_allocator)));
 }
 
+                        // *** thread default allocator ***
+
 inline
-Allocator *Default::allocator(Allocator *basicAllocator)
+Allocator *Default::threadDefaultAllocator()
 {
-    return basicAllocator ? basicAllocator : defaultAllocator();
+    return bsls::AtomicOperations::getIntRelaxed(&s_numThreadDefaults)
+           ? lookupThreadDefaultAllocator()
+           : 0;
 }
 
                         // *** global allocator ***
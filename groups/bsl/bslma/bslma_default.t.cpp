@@ -36,21 +36,26 @@ using namespace BloombergLP;
 // accessor); case 3 tests 'setDefaultAllocator' and 'lockDefaultAllocator';
 // and case 4 tests 'allocator'.  The side-effects of 'defaultAllocator' and
 // 'allocator' are then tested in cases specifically targeted at them (cases 5
-// and 6 for 'defaultAllocator', and cases 7 and 8 for 'allocator').
+// and 6 for 'defaultAllocator', and cases 7 and 8 for 'allocator').  The
+// interface for the thread default allocator, and its interaction with the
+// process-wide default allocator, is tested in case 10.
 //-----------------------------------------------------------------------------
 // [ 3] int setDefaultAllocator(*ba);
 // [ 2] void setDefaultAllocatorRaw(*ba);
 // [ 3] void lockDefaultAllocator();
 // [ 2] bslma::Allocator *defaultAllocator();
 // [ 4] bslma::Allocator *allocator(*ba = 0);
+// [10] bslma::Allocator *processDefaultAllocator();
+// [10] bslma::Allocator *setThreadDefaultAllocator(*ba);
+// [10] bslma::Allocator *threadDefaultAllocator();
 // [ 9] bslma::Allocator *globalAllocator(*ba = 0);
 // [ 9] bslma::Allocator *setGlobalAllocator(*ba);
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] BOOTSTRAP TEST
-// [10] USAGE EXAMPLE 1
-// [11] USAGE EXAMPLE 2
-// [12] USAGE EXAMPLE 3
+// [11] USAGE EXAMPLE 1
+// [12] USAGE EXAMPLE 2
+// [13] USAGE EXAMPLE 3
 
 //=============================================================================
 //                  STANDARD BDE ASSERT TEST MACRO
@@ -507,7 +512,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 12: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 3
         //
@@ -563,7 +568,7 @@ int main(int argc, char *argv[])
 //..
 
       } break;
-      case 11: {
+      case 12: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 2
         //
@@ -655,7 +660,7 @@ int main(int argc, char *argv[])
 // invocations (i.e., even with correct code).
 
       } break;
-      case 10: {
+      case 11: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 1
         //
@@ -729,6 +734,87 @@ int main(int argc, char *argv[])
     ASSERT(1 == defaultCountingAllocator.numBlocksTotal());
 //..
 
+      } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // TESTING THREAD DEFAULT ALLOCATOR
+        //
+        // Concerns:
+        //   1) Initially, the calling thread has no thread default allocator.
+        //   2) 'setThreadDefaultAllocator' installs, replaces, or (given 0)
+        //      removes the thread default allocator of the calling thread,
+        //      and returns the one in effect prior to the call, or 0.
+        //   3) While the calling thread has a thread default allocator,
+        //      'defaultAllocator', and 'allocator' called with no argument,
+        //      return it; 'allocator' called with a non-zero argument still
+        //      returns that argument.
+        //   4) 'setThreadDefaultAllocator' succeeds even though the default
+        //      allocator is locked, and has no effect on the process-wide
+        //      default allocator returned by 'processDefaultAllocator'.
+        //   5) 'defaultAllocator' locks the process-wide default allocator
+        //      even while the calling thread has a thread default allocator.
+        //
+        // Plan:
+        //   Set the process-wide default allocator to 'U' (which is not
+        //   locked), and install, replace, and remove thread default
+        //   allocators, verifying the values returned by each method after
+        //   each step.  Then verify that the process-wide default allocator
+        //   was locked by the calls to 'defaultAllocator', and that thread
+        //   default allocators can still be installed.
+        //
+        // Testing:
+        //   bslma::Allocator *processDefaultAllocator();
+        //   bslma::Allocator *setThreadDefaultAllocator(*ba);
+        //   bslma::Allocator *threadDefaultAllocator();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING THREAD DEFAULT ALLOCATOR"
+                            "\n================================\n");
+
+        my_CountingAllocator mW;  bslma::Allocator *W = &mW;
+
+        Obj::setDefaultAllocatorRaw(U);
+
+        ASSERT(0 == Obj::threadDefaultAllocator());
+
+        ASSERT(0 == Obj::setThreadDefaultAllocator(V));
+        ASSERT(V == Obj::threadDefaultAllocator());
+        ASSERT(V == Obj::defaultAllocator());
+        ASSERT(V == Obj::allocator());
+        ASSERT(V == Obj::allocator(0));
+        ASSERT(W == Obj::allocator(W));
+        ASSERT(U == Obj::processDefaultAllocator());
+
+        ASSERT(V == Obj::setThreadDefaultAllocator(W));
+        ASSERT(W == Obj::threadDefaultAllocator());
+        ASSERT(W == Obj::defaultAllocator());
+        ASSERT(W == Obj::allocator());
+        ASSERT(U == Obj::processDefaultAllocator());
+
+        ASSERT(W == Obj::setThreadDefaultAllocator(0));
+        ASSERT(0 == Obj::threadDefaultAllocator());
+        ASSERT(U == Obj::defaultAllocator());
+        ASSERT(U == Obj::allocator());
+        ASSERT(U == Obj::processDefaultAllocator());
+
+        ASSERT(0 == Obj::setThreadDefaultAllocator(0));
+        ASSERT(0 == Obj::threadDefaultAllocator());
+
+        if (veryVerbose) printf("\tTesting interaction with the lock.\n");
+
+        ASSERT(0 != Obj::setDefaultAllocator(V));
+        ASSERT(U == Obj::processDefaultAllocator());
+
+        ASSERT(0 == Obj::setThreadDefaultAllocator(V));
+        ASSERT(V == Obj::defaultAllocator());
+        ASSERT(U == Obj::processDefaultAllocator());
+        ASSERT(V == Obj::setThreadDefaultAllocator(0));
+        ASSERT(U == Obj::defaultAllocator());
+
+        ASSERT(0 == mU.numBlocksTotal());
+        ASSERT(0 == mV.numBlocksTotal());
+        ASSERT(0 == mW.numBlocksTotal());
+
       } break;
       case 9: {
         // --------------------------------------------------------------------
@@ -19,7 +19,7 @@ namespace bslma {
 
 // CREATORS
 DefaultAllocatorGuard::DefaultAllocatorGuard(Allocator *temporary)
-: d_original_p(Default::defaultAllocator())
+: d_original_p(Default::processDefaultAllocator())
 {
     BSLS_ASSERT(temporary);
 
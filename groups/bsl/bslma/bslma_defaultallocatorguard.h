@@ -12,7 +12,7 @@ BSLS_IDENT("$Id: $")
 //@CLASSES:
 //  bslma::DefaultAllocatorGuard: default-allocator scoped guard
 //
-//@SEE_ALSO: bslma_allocator, bslma_default
+//@SEE_ALSO: bslma_allocator, bslma_default, bslma_threaddefaultallocatorguard
 //
 //@DESCRIPTION: This component provides an object,
 // 'bslma::DefaultAllocatorGuard', that serves as a "scoped guard" to enable
@@ -29,6 +29,12 @@ BSLS_IDENT("$Id: $")
 // process-wide default allocator (via another call to
 // 'bslma::Default::setDefaultAllocator').
 //
+// Note that the guard saves and restores the *process-wide* default allocator
+// even if the calling thread has a thread default allocator (see
+// 'bslma_default'), which continues to take precedence in that thread.  See
+// 'bslma_threaddefaultallocatorguard' for a guard that installs a thread
+// default allocator.
+//
 ///Usage
 ///-----
 // The 'bslma_default' component ensures that, unless the owner of 'main' or
@@ -228,6 +228,9 @@ int main(int argc, char *argv[])
         //   2. The allocator function returns default allocator if passed-in
         //      allocator is null.
         //   3. The allocator function.
+        //   4. The guard replaces and restores the process-wide default
+        //      allocator even if the calling thread has a thread default
+        //      allocator, which continues to take precedence.
         //
         // Plan:
         //
@@ -252,6 +255,30 @@ int main(int argc, char *argv[])
             }
             ASSERT(&defaultAllocator == bslma::Default::defaultAllocator());
         }
+
+        if (verbose) printf("\nWith a thread default allocator.\n");
+        {
+            my_CountingAllocator defaultAllocator;
+            my_CountingAllocator threadAllocator;
+
+            bslma::Default::setDefaultAllocatorRaw(&defaultAllocator);
+            bslma::Default::setThreadDefaultAllocator(&threadAllocator);
+            ASSERT(&threadAllocator == bslma::Default::defaultAllocator());
+
+            {
+                bslma::TestAllocator testAllocator(veryVeryVerbose);
+                Obj guard(&testAllocator);
+                ASSERT(&testAllocator ==
+                                   bslma::Default::processDefaultAllocator());
+                ASSERT(&threadAllocator == bslma::Default::defaultAllocator());
+            }
+            ASSERT(&defaultAllocator ==
+                                   bslma::Default::processDefaultAllocator());
+            ASSERT(&threadAllocator == bslma::Default::defaultAllocator());
+
+            bslma::Default::setThreadDefaultAllocator(0);
+            ASSERT(&defaultAllocator == bslma::Default::defaultAllocator());
+        }
       } break;
 
       default: {
@@ -4,13 +4,21 @@
 #include <bsls_ident.h>
 BSLS_IDENT("$Id$ $CSID$")
 
+#include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
 #include <bsls_atomicoperations.h>
 #include <bsls_bslexceptionutil.h>
 #include <bsls_objectbuffer.h>
+#include <bsls_platform.h>
 
 #include <new>
 
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <malloc.h>  // '_aligned_malloc', '_aligned_free'
+#else
+#include <stdlib.h>  // 'posix_memalign'
+#endif
+
 // This allocator is simply an "adapter" connecting 'std::malloc' and
 // 'std::free' to the 'bslma::Allocator' interface.  We use the reserve pool
 // pattern to ensure that the returned allocator object remains valid forever
@@ -116,6 +124,61 @@ void *MallocFreeAllocator::allocate(size_type size)
 
     return result;
 }
+
+void *MallocFreeAllocator::allocateAligned(size_type size,
+                                           size_type alignment)
+{
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    if (alignment <= static_cast<size_type>(
+                                   bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT)) {
+        return Allocator::allocateAligned(size, alignment);           // RETURN
+    }
+
+    if (!size) {
+        return 0;                                                     // RETURN
+    }
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    void *result = _aligned_malloc(size, alignment);
+#else
+    void *result = 0;
+    if (0 != ::posix_memalign(&result, alignment, size)) {
+        result = 0;
+    }
+#endif
+
+    if (!result) {
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    return result;
+}
+
+void MallocFreeAllocator::deallocateAligned(void      *address,
+                                            size_type,
+                                            size_type  alignment)
+{
+    if (!address) {
+        return;                                                       // RETURN
+    }
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    if (alignment > static_cast<size_type>(
+                                   bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT)) {
+        _aligned_free(address);
+        return;                                                       // RETURN
+    }
+#else
+    // A block obtained from 'posix_memalign' is released by 'std::free', like
+    // any other block.
+
+    (void)alignment;
+#endif
+
+    std::free(address);
+}
 }  // close package namespace
 
 }  // close enterprise namespace
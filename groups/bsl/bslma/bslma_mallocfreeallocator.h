@@ -29,7 +29,9 @@ BSLS_IDENT("$Id: $")
 //       ( bslma::Allocator )
 //        `----------------'
 //                        allocate
+//                        allocateAligned
 //                        deallocate
+//                        deallocateAligned
 //..
 // The key purpose of this component is to facilitate the use of 'malloc' and
 // 'free' when the default 'bslma::NewDeleteAllocator' is not desirable (such
@@ -37,6 +39,15 @@ BSLS_IDENT("$Id: $")
 // and 'free' are wrapped in a singleton object whose lifetime is guaranteed to
 // exceed any possibility of its use.
 //
+///Extended Alignment
+///------------------
+// 'allocateAligned' supplies blocks aligned to any power of two.  An alignment
+// no greater than the maximal fundamental alignment is satisfied by
+// 'std::malloc' itself, and a greater alignment by 'posix_memalign' (or
+// '_aligned_malloc' on Windows).  Such a block must be returned with
+// 'deallocateAligned', which releases it with 'std::free' (or '_aligned_free'
+// on Windows).
+//
 ///Thread Safety
 ///-------------
 // A single object of 'bslma::MallocFreeAllocator' is safe for concurrent
@@ -184,6 +195,28 @@ class MallocFreeAllocator : public Allocator {
         // 'std::free' is *not* called when 'address' is 0 (in order to avoid
         // having to acquire a lock, and potential contention in multi-treaded
         // programs).
+
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes) whose address is a multiple of the
+        // specified 'alignment', which may exceed the maximal fundamental
+        // alignment of the platform.  If 'size' is 0, a null pointer is
+        // returned with no other effect.  The block is returned to this
+        // allocator by calling 'deallocateAligned' with the same 'size' and
+        // 'alignment'.  If the memory cannot be obtained, 'std::bad_alloc' is
+        // thrown.  The behavior is undefined unless 'alignment' is a positive
+        // power of two.
+
+    virtual void deallocateAligned(void      *address,
+                                   size_type  size,
+                                   size_type  alignment);
+        // Return the memory block at the specified 'address', which was
+        // obtained by a call to 'allocateAligned' with the specified 'size'
+        // and 'alignment', back to this allocator.  If 'address' is 0, this
+        // function has no effect.  The behavior is undefined unless 'address'
+        // was allocated using this allocator object by a call to
+        // 'allocateAligned(size, alignment)' and has not already been
+        // deallocated.
 };
 
 // ============================================================================
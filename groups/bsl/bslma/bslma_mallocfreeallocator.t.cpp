@@ -5,9 +5,11 @@
 #include <bslma_allocator.h>       // for testing only
 
 #include <bsls_bsltestutil.h>
+#include <bsls_types.h>
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef BDE_BUILD_TARGET_EXC
 #include <new>
@@ -34,9 +36,11 @@ using namespace BloombergLP;
 // [ 2] void *allocate(size_type size)   // allocate 0
 // [ 2] void deallocate((void *address)  // deallocate 0
 // [ 3] static bslma::MallocFreeAllocator& singleton()
+// [ 4] void *allocateAligned(size_type size, size_type alignment)
+// [ 4] void deallocateAligned(void *, size_type size, size_type align)
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 4] USAGE EXAMPLE
+// [ 5] USAGE EXAMPLE
 
 //=============================================================================
 //                  STANDARD BDE ASSERT TEST MACRO
@@ -253,7 +257,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
-      case 4: {
+      case 5: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -322,6 +326,86 @@ int main(int argc, char *argv[])
         ASSERT(0 == globalDeleteCalledLastArg);
 
       } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // EXTENDED ALIGNMENT
+        //
+        // Concerns:
+        //: 1 'allocateAligned' returns a writable block aligned to the
+        //:   requested alignment, including alignments (64 and 4096) that
+        //:   exceed the maximal fundamental alignment.
+        //:
+        //: 2 Neither 'allocateAligned' nor 'deallocateAligned' invokes the
+        //:   global 'operator new' or 'operator delete'.
+        //:
+        //: 3 A request of 0 bytes returns 0, and deallocating 0 has no
+        //:   effect.
+        //
+        // Plan:
+        //: 1 For a table of sizes and alignments, allocate a block, verify
+        //:   its alignment, fill it, and deallocate it, verifying that the
+        //:   instrumented global 'operator new' and 'operator delete' are not
+        //:   called.  (C-1..2)
+        //:
+        //: 2 Request 0 bytes, and deallocate 0.  (C-3)
+        //
+        // Testing:
+        //   void *allocateAligned(size_type size, size_type alignment)
+        //   void deallocateAligned(void *, size_type size, size_type align)
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nEXTENDED ALIGNMENT"
+                            "\n==================\n");
+
+        typedef bslma::Allocator::size_type size_type;
+
+        static const size_type SIZES[]  = { 1, 24, 100, 5000 };
+        const int              NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        static const size_type ALIGNS[]  = { 1, 8, 64, 4096 };
+        const int              NUM_ALIGNS = sizeof ALIGNS / sizeof *ALIGNS;
+
+        bslma::MallocFreeAllocator alloc;
+
+        globalNewCalledCountIsEnabled    = 1;
+        globalDeleteCalledCountIsEnabled = 1;
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            for (int tj = 0; tj < NUM_ALIGNS; ++tj) {
+                const size_type SIZE  = SIZES[ti];
+                const size_type ALIGN = ALIGNS[tj];
+
+                if (veryVerbose) { P_(SIZE) P(ALIGN) }
+
+                char *p = static_cast<char *>(alloc.allocateAligned(SIZE,
+                                                                    ALIGN));
+
+                ASSERTV(SIZE, ALIGN, p);
+                ASSERTV(SIZE, ALIGN,
+                        0 == reinterpret_cast<bsls::Types::UintPtr>(p)
+                                                                   % ALIGN);
+
+                memset(p, 0xa5, SIZE);
+
+                alloc.deallocateAligned(p, SIZE, ALIGN);
+            }
+        }
+
+        if (verbose) printf("\nTesting 0 bytes\n");
+        {
+            ASSERT(0 == alloc.allocateAligned(0, 64));
+            ASSERT(0 == alloc.allocateAligned(0, 4096));
+
+            alloc.deallocateAligned(0, 0, 8);
+            alloc.deallocateAligned(0, 0, 4096);
+        }
+
+        globalNewCalledCountIsEnabled    = 0;
+        globalDeleteCalledCountIsEnabled = 0;
+
+        ASSERT(0 == globalNewCalledCount);
+        ASSERT(0 == globalDeleteCalledCount);
+      } break;
       case 3: {
         // --------------------------------------------------------------------
         // SINGLETON TEST
@@ -0,0 +1,624 @@
+// bslma_memoryresource.h                                             -*-C++-*-
+#ifndef INCLUDED_BSLMA_MEMORYRESOURCE
+#define INCLUDED_BSLMA_MEMORYRESOURCE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide interoperation between 'bslma' and 'std::pmr' allocators.
+//
+//@CLASSES:
+//  bslma::AllocatorResource: 'bslma' allocator that is also a memory resource
+//  bslma::MemoryResourceAdapter: 'bslma::Allocator' over a memory resource
+//
+//@SEE_ALSO: bslma_allocator
+//
+//@DESCRIPTION: This component provides two adaptors that allow memory to flow
+// in either direction between the 'bslma::Allocator' protocol and the C++17
+// 'std::pmr::memory_resource' protocol.
+//
+// 'bslma::AllocatorResource' is a class template, parameterized by a concrete
+// allocator type, 'ALLOCATOR', derived from 'bslma::Allocator', that inherits
+// from both 'ALLOCATOR' and 'std::pmr::memory_resource'.  An object of this
+// type *is* the allocator, rather than a wrapper around it: its address can
+// be supplied both to BDE types (as a 'bslma::Allocator *') and to standard
+// types such as 'std::pmr::vector' (as a 'std::pmr::memory_resource *'), and
+// all of those objects draw memory from the same mechanism.  The
+// 'memory_resource' virtual functions call 'ALLOCATOR::allocate',
+// 'ALLOCATOR::deallocateSized', 'ALLOCATOR::allocateAligned',
+// 'ALLOCATOR::deallocateAligned', and 'ALLOCATOR::deallocate' by their
+// qualified names, so the one virtual dispatch made by
+// 'std::pmr::memory_resource' is the only indirection, and an inline fast
+// path in 'ALLOCATOR' (such as that of a pool) is inlined into it.  The size
+// supplied to 'deallocate' by a standard container is passed through to
+// 'ALLOCATOR::deallocateSized', and an alignment stricter than the natural
+// alignment of the requested size is passed through to
+// 'ALLOCATOR::allocateAligned' and 'ALLOCATOR::deallocateAligned'.
+//
+// 'bslma::MemoryResourceAdapter' is a concrete 'bslma::Allocator' that
+// supplies memory from a 'std::pmr::memory_resource' held (not owned) by the
+// adaptor.  The adaptor adds nothing to the blocks it supplies: 'allocate'
+// requests exactly the specified size from the resource, at the natural
+// alignment of that size, and 'allocateAligned' requests the specified size
+// at the specified alignment (or the natural alignment of the size, if that
+// is stricter).  'deallocateSized', which 'bsl::allocator' (and hence every
+// BDE container) uses to return memory, and 'deallocateAligned' recompute
+// that alignment from the arguments they are passed, so the resource receives
+// the same size and alignment on deallocation that it was given on
+// allocation.
+//
+///Unsized Deallocation
+///- - - - - - - - - - -
+// 'deallocate' is not supplied the size of a block, and the adaptor does not
+// record it: doing so would require a header in front of *every* block
+// (adding a cache line to small blocks, and defeating sized deallocation),
+// since 'deallocate' cannot distinguish blocks that have a header from those
+// that do not.  Instead, 'deallocate' passes the resource a size of 0 and the
+// maximal fundamental alignment of the platform, meaning "unknown".  Such a
+// deallocation is correct for resources that do not depend on the size or
+// alignment of the blocks they release -- e.g.,
+// 'std::pmr::monotonic_buffer_resource' and 'bslma::AllocatorResource' (which
+// treats a size of 0 as unknown, and calls 'ALLOCATOR::deallocate') -- but a
+// resource that selects a pool by size (such as
+// 'std::pmr::unsynchronized_pool_resource') must be used only by clients that
+// return memory through 'deallocateSized'.
+//
+///Availability
+///------------
+// The contents of this component are available only when the standard
+// library provides the '<memory_resource>' header and the component is
+// compiled in C++17 (or later) mode; the macro
+// 'BSLMA_MEMORYRESOURCE_HAS_PMR' is defined exactly in that case.  All of the
+// functions of the component are defined inline in this header, so that a
+// C++17 client may use the adaptors even if the library itself was built in
+// an earlier mode (in which the '.cpp' file of the component is empty).
+//
+///Thread Safety
+///-------------
+// 'bslma::AllocatorResource<ALLOCATOR>' has the same thread safety as
+// 'ALLOCATOR'.  'bslma::MemoryResourceAdapter' has the same thread safety as
+// the memory resource from which it supplies memory.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing a Pool Between BDE and Standard Containers
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a subsystem uses both BDE containers and standard 'pmr'
+// containers, and we want all of them to draw memory from a single, concrete
+// 'bslma' allocator.  First, we define a 'bslma::Allocator' that counts the
+// blocks it has outstanding:
+//..
+//  class CountingAllocator : public bslma::Allocator {
+//      // This class supplies memory using 'operator new' and keeps a count of
+//      // the number of blocks in use.
+//
+//      // DATA
+//      int d_numBlocksInUse;  // number of blocks currently allocated
+//
+//    public:
+//      // CREATORS
+//      CountingAllocator() : d_numBlocksInUse(0) {}
+//          // Create a 'CountingAllocator' having no blocks in use.
+//
+//      // MANIPULATORS
+//      virtual void *allocate(size_type size)
+//          // Return a newly allocated block of at least the specified 'size'
+//          // (in bytes), or 0 if 'size' is 0.
+//      {
+//          if (0 == size) {
+//              return 0;                                             // RETURN
+//          }
+//          ++d_numBlocksInUse;
+//          return ::operator new(size);
+//      }
+//
+//      virtual void deallocate(void *address)
+//          // Return the block at the specified 'address' to this allocator.
+//          // If 'address' is 0, this function has no effect.
+//      {
+//          if (address) {
+//              --d_numBlocksInUse;
+//              ::operator delete(address);
+//          }
+//      }
+//
+//      // ACCESSORS
+//      int numBlocksInUse() const { return d_numBlocksInUse; }
+//          // Return the number of blocks currently allocated.
+//  };
+//..
+// Then, we create an object of type
+// 'bslma::AllocatorResource<CountingAllocator>', which is both a
+// 'CountingAllocator' and a 'std::pmr::memory_resource':
+//..
+//  bslma::AllocatorResource<CountingAllocator> resource;
+//
+//  bslma::Allocator          *allocator = &resource;
+//  std::pmr::memory_resource *memory    = &resource;
+//..
+// Next, we allocate a block through each of the two protocols, and observe
+// that both blocks are supplied by the same underlying mechanism:
+//..
+//  void *p = allocator->allocate(16);
+//  void *q = memory->allocate(32, 8);
+//  assert(2 == resource.numBlocksInUse());
+//
+//  memory->deallocate(q, 32, 8);
+//  allocator->deallocate(p);
+//  assert(0 == resource.numBlocksInUse());
+//..
+// Then, we use the resource to supply memory to a standard 'pmr' container:
+//..
+//  {
+//      std::pmr::vector<int> v(memory);
+//      v.push_back(1);
+//      assert(1 == resource.numBlocksInUse());
+//  }
+//  assert(0 == resource.numBlocksInUse());
+//..
+//
+///Example 2: Supplying a 'bslma::Allocator' from a Memory Resource
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that memory is supplied to our subsystem by a standard
+// 'std::pmr::memory_resource', and that we want to use it with a BDE type
+// that takes a 'bslma::Allocator *'.  We wrap the resource in a
+// 'bslma::MemoryResourceAdapter':
+//..
+//  std::pmr::monotonic_buffer_resource arena;
+//  bslma::MemoryResourceAdapter        adapter(&arena);
+//..
+// Now, any block obtained from 'adapter' is supplied by 'arena':
+//..
+//  void *r = adapter.allocate(100);
+//  assert(r);
+//  adapter.deallocateSized(r, 100);
+//..
+// Finally, note that, since we returned the block using 'deallocateSized',
+// the adaptor was able to pass 'arena' the size (and alignment) with which
+// the block was allocated, without storing them alongside the block.
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define BSLMA_MEMORYRESOURCE_HAS_PMR 1
+#endif
+#endif
+#endif
+
+#ifdef BSLMA_MEMORYRESOURCE_HAS_PMR
+
+#ifndef INCLUDED_CSTDDEF
+#include <cstddef>
+#define INCLUDED_CSTDDEF
+#endif
+
+#ifndef INCLUDED_MEMORY_RESOURCE
+#include <memory_resource>
+#define INCLUDED_MEMORY_RESOURCE
+#endif
+
+#ifndef INCLUDED_UTILITY
+#include <utility>
+#define INCLUDED_UTILITY
+#endif
+
+namespace BloombergLP {
+
+namespace bslma {
+
+                        // =======================
+                        // class AllocatorResource
+                        // =======================
+
+template <class ALLOCATOR>
+class AllocatorResource : public ALLOCATOR,
+                          public std::pmr::memory_resource {
+    // This class template is a concrete allocator of the specified 'ALLOCATOR'
+    // type (which must be derived from 'bslma::Allocator') that is also a
+    // 'std::pmr::memory_resource'.  Memory requested through either protocol
+    // is supplied by the same 'ALLOCATOR' mechanism.  The behavior is
+    // undefined unless 'ALLOCATOR::allocate' returns memory aligned for any
+    // object of the requested size (which is the contract of the
+    // 'bslma::Allocator' protocol).
+
+    // PRIVATE CLASS METHODS
+    static bool isNaturallyAligned(std::size_t bytes, std::size_t alignment);
+        // Return 'true' if a block of the specified 'bytes' (in bytes), as
+        // returned by 'ALLOCATOR::allocate', is guaranteed to be aligned to
+        // the specified 'alignment', and 'false' otherwise.  The behavior is
+        // undefined unless 'alignment' is a power of two.
+
+  private:
+    // NOT IMPLEMENTED
+    AllocatorResource(const AllocatorResource&);
+    AllocatorResource& operator=(const AllocatorResource&);
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual void *do_allocate(std::size_t bytes, std::size_t alignment);
+        // Return a newly allocated block of at least the specified 'bytes'
+        // (in bytes), aligned to (at least) the specified 'alignment'.  If
+        // 'bytes' is 0, a block of 'alignment' bytes (or of 1 byte, if
+        // 'alignment' exceeds the maximal fundamental alignment) is returned.
+        // If 'alignment'
+        // is no stricter than the natural alignment of 'bytes', the block is
+        // obtained from 'ALLOCATOR::allocate', and otherwise from
+        // 'ALLOCATOR::allocateAligned'.  The behavior is undefined unless
+        // 'alignment' is a power of two.
+
+    virtual void do_deallocate(void        *address,
+                               std::size_t  bytes,
+                               std::size_t  alignment);
+        // Return the block at the specified 'address' to this object.  The
+        // behavior is undefined unless 'address' was returned by
+        // 'do_allocate' on this object with the specified 'bytes' and
+        // 'alignment', or 'bytes' is 0 (denoting a block of unknown size) and
+        // 'alignment' is no greater than the maximal fundamental alignment,
+        // and 'address' has not already been deallocated.  Note that 'bytes'
+        // is passed to 'ALLOCATOR::deallocateSized' for a block obtained from
+        // 'ALLOCATOR::allocate', 'bytes' and 'alignment' are passed to
+        // 'ALLOCATOR::deallocateAligned' for a block obtained from
+        // 'ALLOCATOR::allocateAligned', and a block of unknown size is
+        // returned with 'ALLOCATOR::deallocate'.
+
+    // PROTECTED ACCESSORS
+    virtual bool do_is_equal(const std::pmr::memory_resource& other) const
+                                                                      noexcept;
+        // Return 'true' if the specified 'other' memory resource is this
+        // object, and 'false' otherwise.
+
+  public:
+    // CREATORS
+    template <class... ARGS>
+    explicit AllocatorResource(ARGS&&... arguments);
+        // Create an 'ALLOCATOR' that is also a 'std::pmr::memory_resource',
+        // passing the specified 'arguments' (if any) to the constructor of
+        // 'ALLOCATOR'.
+
+    virtual ~AllocatorResource();
+        // Destroy this object.
+};
+
+                        // ===========================
+                        // class MemoryResourceAdapter
+                        // ===========================
+
+class MemoryResourceAdapter : public Allocator {
+    // This class provides a concrete 'bslma::Allocator' that supplies memory
+    // from a 'std::pmr::memory_resource'.  No header is added to the blocks
+    // supplied: the size and alignment of a block are passed to the resource
+    // when the block is returned with 'deallocateSized' or
+    // 'deallocateAligned', and are unknown to the resource (see {Unsized
+    // Deallocation}) when the block is returned with 'deallocate'.
+
+    // PRIVATE TYPES
+    enum {
+        k_MAX_ALIGNMENT = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+    };
+
+    // DATA
+    std::pmr::memory_resource *d_resource_p;  // memory resource (held, not
+                                              // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    MemoryResourceAdapter(const MemoryResourceAdapter&);
+    MemoryResourceAdapter& operator=(const MemoryResourceAdapter&);
+
+  public:
+    // CREATORS
+    explicit MemoryResourceAdapter(std::pmr::memory_resource *resource = 0);
+        // Create an allocator that supplies memory from the specified
+        // 'resource'.  If 'resource' is 0, the resource returned by
+        // 'std::pmr::get_default_resource()' at construction is used.
+
+    virtual ~MemoryResourceAdapter();
+        // Destroy this allocator.  Note that memory allocated from this
+        // allocator and not yet deallocated is not returned to the resource.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes), obtained from the resource of this
+        // allocator with the natural alignment of 'size'.  If 'size' is 0, a
+        // null pointer is returned with no other effect.
+
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return a newly allocated block of memory of (at least) the specified
+        // 'size' (in bytes), aligned to (at least) the specified 'alignment',
+        // and obtained from the resource of this allocator.  If 'size' is 0,
+        // a null pointer is returned with no other effect.  The behavior is
+        // undefined unless 'alignment' is a power of two.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' to the resource
+        // of this allocator, passing a size of 0 and the maximal fundamental
+        // alignment to indicate that neither is known.  If 'address' is 0,
+        // this function has no effect.  The behavior is undefined unless
+        // 'address' was allocated using this allocator object and has not
+        // already been deallocated.
+
+    virtual void deallocateSized(void *address, size_type size);
+        // Return the memory block at the specified 'address', which was
+        // obtained by a call to 'allocate' with the specified 'size', to the
+        // resource of this allocator, passing 'size' and the natural
+        // alignment of 'size'.  If 'address' is 0, this function has no
+        // effect.  The behavior is undefined unless 'address' was allocated
+        // using this allocator object by a call to 'allocate(size)' and has
+        // not already been deallocated.
+
+    virtual void deallocateAligned(void      *address,
+                                   size_type  size,
+                                   size_type  alignment);
+        // Return the memory block at the specified 'address', which was
+        // obtained by a call to 'allocateAligned' with the specified 'size'
+        // and 'alignment', to the resource of this allocator, passing the
+        // size and alignment with which the block was obtained from the
+        // resource.  If 'address' is 0, this function has no effect.  The
+        // behavior is undefined unless 'address' was allocated using this
+        // allocator object by a call to 'allocateAligned(size, alignment)'
+        // and has not already been deallocated.
+
+    // ACCESSORS
+    std::pmr::memory_resource *resource() const;
+        // Return the address of the memory resource from which this allocator
+        // supplies memory.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                        // -----------------------
+                        // class AllocatorResource
+                        // -----------------------
+
+// PRIVATE CLASS METHODS
+template <class ALLOCATOR>
+inline
+bool AllocatorResource<ALLOCATOR>::isNaturallyAligned(std::size_t bytes,
+                                                      std::size_t alignment)
+{
+    // A block returned by 'allocate' is aligned to the largest power of two
+    // dividing its size, up to the maximal alignment of the platform.
+
+    return alignment <= static_cast<std::size_t>(
+                                     bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT)
+        && 0 == (bytes & (alignment - 1));
+}
+
+// PROTECTED MANIPULATORS
+template <class ALLOCATOR>
+inline
+void *AllocatorResource<ALLOCATOR>::do_allocate(std::size_t bytes,
+                                                std::size_t alignment)
+{
+    BSLS_ASSERT_SAFE(0 < alignment);
+    BSLS_ASSERT_SAFE(0 == (alignment & (alignment - 1)));
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == bytes)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // 'bslma::Allocator::allocate' returns 0 for a request of zero bytes,
+        // but a memory resource must return a usable address.  Requesting
+        // 'alignment' bytes keeps a fundamentally aligned block on the
+        // 'allocate' path, so that it may be returned with 'deallocate' (see
+        // 'do_deallocate').
+
+        bytes = isNaturallyAligned(alignment, alignment) ? alignment : 1;
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                                       isNaturallyAligned(bytes, alignment))) {
+        return this->ALLOCATOR::allocate(bytes);                      // RETURN
+    }
+
+    return this->ALLOCATOR::allocateAligned(bytes, alignment);
+}
+
+template <class ALLOCATOR>
+inline
+void AllocatorResource<ALLOCATOR>::do_deallocate(void        *address,
+                                                 std::size_t  bytes,
+                                                 std::size_t  alignment)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == bytes)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // A size of 0 denotes either a block whose size is unknown (e.g., one
+        // returned through 'MemoryResourceAdapter::deallocate'), or a request
+        // of zero bytes, which 'do_allocate' supplied from 'allocate' unless
+        // the alignment is extended.
+
+        if (isNaturallyAligned(alignment, alignment)) {
+            this->ALLOCATOR::deallocate(address);
+        }
+        else {
+            this->ALLOCATOR::deallocateAligned(address, 1, alignment);
+        }
+        return;                                                       // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                                       isNaturallyAligned(bytes, alignment))) {
+        this->ALLOCATOR::deallocateSized(address, bytes);
+    }
+    else {
+        this->ALLOCATOR::deallocateAligned(address, bytes, alignment);
+    }
+}
+
+// PROTECTED ACCESSORS
+template <class ALLOCATOR>
+inline
+bool AllocatorResource<ALLOCATOR>::do_is_equal(
+                       const std::pmr::memory_resource& other) const noexcept
+{
+    return static_cast<const std::pmr::memory_resource *>(this) == &other;
+}
+
+// CREATORS
+template <class ALLOCATOR>
+template <class... ARGS>
+inline
+AllocatorResource<ALLOCATOR>::AllocatorResource(ARGS&&... arguments)
+: ALLOCATOR(std::forward<ARGS>(arguments)...)
+{
+}
+
+template <class ALLOCATOR>
+inline
+AllocatorResource<ALLOCATOR>::~AllocatorResource()
+{
+}
+
+                        // ---------------------------
+                        // class MemoryResourceAdapter
+                        // ---------------------------
+
+// CREATORS
+inline
+MemoryResourceAdapter::MemoryResourceAdapter(
+                                           std::pmr::memory_resource *resource)
+: d_resource_p(resource ? resource : std::pmr::get_default_resource())
+{
+}
+
+inline
+MemoryResourceAdapter::~MemoryResourceAdapter()
+{
+}
+
+// MANIPULATORS
+inline
+void *MemoryResourceAdapter::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    return d_resource_p->allocate(
+                             size,
+                             bsls::AlignmentUtil::calculateAlignmentFromSize(
+                                                                       size));
+}
+
+inline
+void *MemoryResourceAdapter::allocateAligned(size_type size,
+                                             size_type alignment)
+{
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    const std::size_t naturalAlignment =
+                         bsls::AlignmentUtil::calculateAlignmentFromSize(size);
+
+    return d_resource_p->allocate(size,
+                                  alignment < naturalAlignment
+                                  ? naturalAlignment
+                                  : alignment);
+}
+
+inline
+void MemoryResourceAdapter::deallocate(void *address)
+{
+    if (0 == address) {
+        return;                                                       // RETURN
+    }
+
+    d_resource_p->deallocate(address, 0, k_MAX_ALIGNMENT);
+}
+
+inline
+void MemoryResourceAdapter::deallocateSized(void *address, size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    d_resource_p->deallocate(
+                             address,
+                             size,
+                             bsls::AlignmentUtil::calculateAlignmentFromSize(
+                                                                       size));
+}
+
+inline
+void MemoryResourceAdapter::deallocateAligned(void      *address,
+                                              size_type  size,
+                                              size_type  alignment)
+{
+    if (0 == address) {
+        return;                                                       // RETURN
+    }
+
+    const std::size_t naturalAlignment =
+                         bsls::AlignmentUtil::calculateAlignmentFromSize(size);
+
+    d_resource_p->deallocate(address,
+                             size,
+                             alignment < naturalAlignment
+                             ? naturalAlignment
+                             : alignment);
+}
+
+// ACCESSORS
+inline
+std::pmr::memory_resource *MemoryResourceAdapter::resource() const
+{
+    return d_resource_p;
+}
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+#endif  // BSLMA_MEMORYRESOURCE_HAS_PMR
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,805 @@
+// bslma_memoryresource.t.cpp                                         -*-C++-*-
+
+#include <bslma_memoryresource.h>
+
+#include <bslma_allocator.h>       // for testing only
+
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_types.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BSLMA_MEMORYRESOURCE_HAS_PMR
+#include <memory_resource>
+#include <vector>
+#endif
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// This component provides two adaptors between the 'bslma::Allocator' and
+// 'std::pmr::memory_resource' protocols.  'bslma::AllocatorResource' is
+// tested by instantiating it with an allocator that records the calls made
+// to each of its allocation methods (and the arguments supplied to them),
+// and verifying that each request made through the 'memory_resource'
+// interface is routed to the expected method of the allocator.
+// 'bslma::MemoryResourceAdapter' is tested by supplying it with a memory
+// resource that records the size and alignment of each request, and
+// verifying that the adaptor passes sizes and alignments through unchanged:
+// 'deallocateSized' and 'deallocateAligned' supply the size and alignment
+// that were supplied to 'allocate', and 'deallocate' supplies a size of 0.
+// The component is
+// available only in C++17 (or later) mode; otherwise only the breathing test
+// runs, and verifies that the component is unavailable for that reason.
+//-----------------------------------------------------------------------------
+// bslma::AllocatorResource
+// [ 2] AllocatorResource(ARGS&&... arguments);
+// [ 2] ~AllocatorResource();
+// [ 2] void *do_allocate(std::size_t bytes, std::size_t alignment);
+// [ 2] void do_deallocate(void *, std::size_t bytes, std::size_t alignment);
+// [ 2] bool do_is_equal(const memory_resource& other) const;
+//
+// bslma::MemoryResourceAdapter
+// [ 3] explicit MemoryResourceAdapter(memory_resource *resource = 0);
+// [ 3] ~MemoryResourceAdapter();
+// [ 3] void *allocate(size_type size);
+// [ 3] void *allocateAligned(size_type size, size_type alignment);
+// [ 3] void deallocate(void *address);
+// [ 3] void deallocateSized(void *address, size_type size);
+// [ 3] void deallocateAligned(void *, size_type size, size_type align);
+// [ 3] memory_resource *resource() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+static int testStatus = 0;
+
+static void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+
+#ifdef BSLMA_MEMORYRESOURCE_HAS_PMR
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+enum { k_MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT };
+
+                        // ===========================
+                        // class my_RecordingAllocator
+                        // ===========================
+
+class my_RecordingAllocator : public bslma::Allocator {
+    // This class supplies memory using 'aligned_alloc' and 'free', and
+    // records the number of calls to each of its allocation methods, and the
+    // most recent arguments supplied to them.
+
+  public:
+    // PUBLIC DATA
+    int       d_numAllocate;         // number of calls to 'allocate'
+    int       d_numAllocateAligned;  // number of calls to 'allocateAligned'
+    int       d_numDeallocate;       // number of calls to 'deallocate'
+    int       d_numDeallocateSized;  // number of calls to 'deallocateSized'
+    int       d_numDeallocateAligned;
+                                     // number of calls to 'deallocateAligned'
+    size_type d_lastSize;            // most recent size argument
+    size_type d_lastAlignment;       // most recent alignment argument
+    int       d_value;               // value supplied at construction
+
+    // CREATORS
+    explicit my_RecordingAllocator(int value = 0)
+    : d_numAllocate(0)
+    , d_numAllocateAligned(0)
+    , d_numDeallocate(0)
+    , d_numDeallocateSized(0)
+    , d_numDeallocateAligned(0)
+    , d_lastSize(0)
+    , d_lastAlignment(0)
+    , d_value(value)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size)
+    {
+        ++d_numAllocate;
+        d_lastSize = size;
+        return size ? malloc(size) : 0;
+    }
+
+    virtual void *allocateAligned(size_type size, size_type alignment)
+    {
+        ++d_numAllocateAligned;
+        d_lastSize      = size;
+        d_lastAlignment = alignment;
+        return aligned_alloc(alignment,
+                             (size + alignment - 1) & ~(alignment - 1));
+    }
+
+    virtual void deallocate(void *address)
+    {
+        ++d_numDeallocate;
+        free(address);
+    }
+
+    virtual void deallocateSized(void *address, size_type size)
+    {
+        ++d_numDeallocateSized;
+        d_lastSize = size;
+        free(address);
+    }
+
+    virtual void deallocateAligned(void      *address,
+                                   size_type  size,
+                                   size_type  alignment)
+    {
+        ++d_numDeallocateAligned;
+        d_lastSize      = size;
+        d_lastAlignment = alignment;
+        free(address);
+    }
+};
+
+                        // ==========================
+                        // class my_RecordingResource
+                        // ==========================
+
+class my_RecordingResource : public std::pmr::memory_resource {
+    // This class supplies memory using 'aligned_alloc' and 'free' (and so
+    // does not depend on the size or alignment supplied to 'deallocate'), and
+    // records the number of blocks outstanding, and the arguments most
+    // recently supplied to 'allocate' and 'deallocate'.
+
+    // PRIVATE MANIPULATORS
+    virtual void *do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        ++d_numBlocksInUse;
+        d_lastAllocateBytes     = bytes;
+        d_lastAllocateAlignment = alignment;
+        return aligned_alloc(alignment,
+                             (bytes + alignment - 1) & ~(alignment - 1));
+    }
+
+    virtual void do_deallocate(void        *address,
+                               std::size_t  bytes,
+                               std::size_t  alignment)
+    {
+        --d_numBlocksInUse;
+        d_lastDeallocateAddress   = address;
+        d_lastDeallocateBytes     = bytes;
+        d_lastDeallocateAlignment = alignment;
+        free(address);
+    }
+
+    // PRIVATE ACCESSORS
+    virtual bool do_is_equal(const std::pmr::memory_resource& other) const
+                                                                       noexcept
+    {
+        return this == &other;
+    }
+
+  public:
+    // PUBLIC DATA
+    int          d_numBlocksInUse;
+    std::size_t  d_lastAllocateBytes;
+    std::size_t  d_lastAllocateAlignment;
+    void        *d_lastDeallocateAddress;
+    std::size_t  d_lastDeallocateBytes;
+    std::size_t  d_lastDeallocateAlignment;
+
+    // CREATORS
+    my_RecordingResource()
+    : d_numBlocksInUse(0)
+    , d_lastAllocateBytes(0)
+    , d_lastAllocateAlignment(0)
+    , d_lastDeallocateAddress(0)
+    , d_lastDeallocateBytes(0)
+    , d_lastDeallocateAlignment(0)
+    {
+    }
+};
+
+//=============================================================================
+//                               USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing a Pool Between BDE and Standard Containers
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a subsystem uses both BDE containers and standard 'pmr'
+// containers, and we want all of them to draw memory from a single, concrete
+// 'bslma' allocator.  First, we define a 'bslma::Allocator' that counts the
+// blocks it has outstanding:
+//..
+    class CountingAllocator : public bslma::Allocator {
+        // This class supplies memory using 'operator new' and keeps a count of
+        // the number of blocks in use.
+
+        // DATA
+        int d_numBlocksInUse;  // number of blocks currently allocated
+
+      public:
+        // CREATORS
+        CountingAllocator() : d_numBlocksInUse(0) {}
+            // Create a 'CountingAllocator' having no blocks in use.
+
+        // MANIPULATORS
+        virtual void *allocate(size_type size)
+            // Return a newly allocated block of at least the specified 'size'
+            // (in bytes), or 0 if 'size' is 0.
+        {
+            if (0 == size) {
+                return 0;                                             // RETURN
+            }
+            ++d_numBlocksInUse;
+            return ::operator new(size);
+        }
+
+        virtual void deallocate(void *address)
+            // Return the block at the specified 'address' to this allocator.
+            // If 'address' is 0, this function has no effect.
+        {
+            if (address) {
+                --d_numBlocksInUse;
+                ::operator delete(address);
+            }
+        }
+
+        // ACCESSORS
+        int numBlocksInUse() const { return d_numBlocksInUse; }
+            // Return the number of blocks currently allocated.
+    };
+//..
+
+#endif  // BSLMA_MEMORYRESOURCE_HAS_PMR
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+
+    (void) veryVerbose;
+    (void) veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:
+#ifdef BSLMA_MEMORYRESOURCE_HAS_PMR
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we create an object of type
+// 'bslma::AllocatorResource<CountingAllocator>', which is both a
+// 'CountingAllocator' and a 'std::pmr::memory_resource':
+//..
+    bslma::AllocatorResource<CountingAllocator> resource;
+
+    bslma::Allocator          *allocator = &resource;
+    std::pmr::memory_resource *memory    = &resource;
+//..
+// Next, we allocate a block through each of the two protocols, and observe
+// that both blocks are supplied by the same underlying mechanism:
+//..
+    void *p = allocator->allocate(16);
+    void *q = memory->allocate(32, 8);
+    ASSERT(2 == resource.numBlocksInUse());
+
+    memory->deallocate(q, 32, 8);
+    allocator->deallocate(p);
+    ASSERT(0 == resource.numBlocksInUse());
+//..
+// Then, we use the resource to supply memory to a standard 'pmr' container:
+//..
+    {
+        std::pmr::vector<int> v(memory);
+        v.push_back(1);
+        ASSERT(1 == resource.numBlocksInUse());
+    }
+    ASSERT(0 == resource.numBlocksInUse());
+//..
+//
+///Example 2: Supplying a 'bslma::Allocator' from a Memory Resource
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that memory is supplied to our subsystem by a standard
+// 'std::pmr::memory_resource', and that we want to use it with a BDE type
+// that takes a 'bslma::Allocator *'.  We wrap the resource in a
+// 'bslma::MemoryResourceAdapter':
+//..
+    std::pmr::monotonic_buffer_resource arena;
+    bslma::MemoryResourceAdapter        adapter(&arena);
+//..
+// Now, any block obtained from 'adapter' is supplied by 'arena':
+//..
+    void *r = adapter.allocate(100);
+    ASSERT(r);
+    adapter.deallocateSized(r, 100);
+//..
+// Finally, note that, since we returned the block using 'deallocateSized',
+// the adaptor was able to pass 'arena' the size (and alignment) with which
+// the block was allocated, without storing them alongside the block.
+
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CLASS 'MemoryResourceAdapter'
+        //
+        // Concerns:
+        //: 1 The resource supplied at construction is used, and the default
+        //:   resource is used if none is supplied.
+        //:
+        //: 2 A request of 0 bytes returns 0 without using the resource, and
+        //:   deallocating 0 has no effect.
+        //:
+        //: 3 'allocate' requests exactly the specified size from the
+        //:   resource, at the natural alignment of that size, and
+        //:   'allocateAligned' requests exactly the specified size at the
+        //:   requested alignment (or the natural alignment, if stricter),
+        //:   which may exceed the maximal alignment.  No header is added, so
+        //:   the resource returns the address of the block itself.
+        //:
+        //: 4 The block is writable over its whole extent.
+        //:
+        //: 5 'deallocateSized' and 'deallocateAligned' supply the resource
+        //:   with the address, size, and alignment with which the block was
+        //:   obtained from it.
+        //:
+        //: 6 'deallocate' supplies the resource with the address, a size of
+        //:   0, and the maximal alignment.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create an adaptor over a 'my_RecordingResource', and one using
+        //:   the default resource, and verify 'resource'.  (C-1)
+        //:
+        //: 2 Request 0 bytes from each allocation method, and deallocate 0,
+        //:   and verify that the resource is not used.  (C-2)
+        //:
+        //: 3 For a range of sizes and alignments, allocate a block, verify
+        //:   the size and alignment supplied to the resource and the
+        //:   alignment of the block, and fill it.  Deallocate the block, using
+        //:   'deallocateAligned' for blocks obtained from 'allocateAligned' on
+        //:   alternate alignments, 'deallocateSized' for blocks obtained from
+        //:   'allocate' on alternate sizes, and 'deallocate' otherwise, and
+        //:   verify the arguments supplied to the resource.  (C-3..6)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for an alignment that is not a power of two.  (C-7)
+        //
+        // Testing:
+        //   explicit MemoryResourceAdapter(memory_resource *resource = 0);
+        //   ~MemoryResourceAdapter();
+        //   void *allocate(size_type size);
+        //   void *allocateAligned(size_type size, size_type alignment);
+        //   void deallocate(void *address);
+        //   void deallocateSized(void *address, size_type size);
+        //   void deallocateAligned(void *, size_type size, size_type align);
+        //   memory_resource *resource() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCLASS 'MemoryResourceAdapter'"
+                            "\n=============================\n");
+
+        typedef bslma::MemoryResourceAdapter Obj;
+
+        my_RecordingResource rr;
+
+        {
+            Obj mX(&rr);  const Obj& X = mX;
+            ASSERT(&rr == X.resource());
+
+            Obj mY;       const Obj& Y = mY;
+            ASSERT(std::pmr::get_default_resource() == Y.resource());
+        }
+
+        if (verbose) printf("\nZero-size requests.\n");
+        {
+            Obj mX(&rr);
+
+            ASSERT(0 == mX.allocate(0));
+            ASSERT(0 == mX.allocateAligned(0, 64));
+            mX.deallocate(0);
+            mX.deallocateSized(0, 8);
+            mX.deallocateAligned(0, 8, 64);
+            ASSERT(0 == rr.d_numBlocksInUse);
+            ASSERT(0 == rr.d_lastAllocateBytes);
+        }
+
+        if (verbose) printf("\nAllocate and deallocate.\n");
+        {
+            static const std::size_t SIZES[] = { 1, 2, 7, 8, 15, 16, 100,
+                                                 1000, 4096 };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            static const std::size_t ALIGNS[] = { 0, 1, 2, 8, 16, 64, 256,
+                                                  4096 };
+            const int NUM_ALIGNS = sizeof ALIGNS / sizeof *ALIGNS;
+
+            Obj mX(&rr);
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                for (int tj = 0; tj < NUM_ALIGNS; ++tj) {
+                    const std::size_t SIZE  = SIZES[ti];
+                    const std::size_t ALIGN = ALIGNS[tj];
+
+                    // An alignment of 0 denotes 'allocate'.
+
+                    char *p = static_cast<char *>(
+                                          ALIGN ? mX.allocateAligned(SIZE,
+                                                                     ALIGN)
+                                                : mX.allocate(SIZE));
+
+                    const std::size_t NATURAL_ALIGN =
+                        bsls::AlignmentUtil::calculateAlignmentFromSize(SIZE);
+                    const std::size_t EXP_ALIGN =
+                                         ALIGN > NATURAL_ALIGN
+                                         ? ALIGN
+                                         : NATURAL_ALIGN;
+
+                    ASSERTV(SIZE, ALIGN, p);
+                    ASSERTV(SIZE, ALIGN,
+                            0 == reinterpret_cast<bsls::Types::UintPtr>(p)
+                                                            % EXP_ALIGN);
+                    ASSERTV(SIZE, ALIGN, 1 == rr.d_numBlocksInUse);
+                    ASSERTV(SIZE, ALIGN, SIZE == rr.d_lastAllocateBytes);
+                    ASSERTV(SIZE, ALIGN,
+                            EXP_ALIGN == rr.d_lastAllocateAlignment);
+
+                    for (std::size_t i = 0; i < SIZE; ++i) {
+                        p[i] = static_cast<char>(i);
+                    }
+
+                    const bool SIZED = ALIGN ? tj % 2 : ti % 2;
+
+                    if (!SIZED) {
+                        mX.deallocate(p);
+                    }
+                    else if (ALIGN) {
+                        mX.deallocateAligned(p, SIZE, ALIGN);
+                    }
+                    else {
+                        mX.deallocateSized(p, SIZE);
+                    }
+
+                    ASSERTV(SIZE, ALIGN, 0 == rr.d_numBlocksInUse);
+                    ASSERTV(SIZE, ALIGN, p == rr.d_lastDeallocateAddress);
+                    ASSERTV(SIZE, ALIGN, SIZED,
+                            (SIZED ? SIZE : 0) == rr.d_lastDeallocateBytes);
+                    ASSERTV(SIZE, ALIGN, SIZED,
+                            (SIZED ? EXP_ALIGN
+                                   : static_cast<std::size_t>(k_MAX_ALIGN)) ==
+                                               rr.d_lastDeallocateAlignment);
+                }
+            }
+        }
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(&rr);
+
+            ASSERT_PASS(mX.deallocateAligned(mX.allocateAligned(8, 32),
+                                             8,
+                                             32));
+            ASSERT_FAIL(mX.allocateAligned(8, 0));
+            ASSERT_FAIL(mX.allocateAligned(8, 24));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CLASS TEMPLATE 'AllocatorResource'
+        //
+        // Concerns:
+        //: 1 The constructor forwards its arguments to 'ALLOCATOR', and the
+        //:   object converts to both 'ALLOCATOR&' and 'memory_resource&'.
+        //:
+        //: 2 A request whose alignment is no stricter than the natural
+        //:   alignment of its size is supplied by 'ALLOCATOR::allocate', and
+        //:   is returned with 'ALLOCATOR::deallocateSized', passing the size.
+        //:
+        //: 3 A request for a stricter alignment is supplied by
+        //:   'ALLOCATOR::allocateAligned', passing the alignment, and is
+        //:   returned with 'ALLOCATOR::deallocateAligned', passing the size
+        //:   and alignment.
+        //:
+        //: 4 A request of 0 bytes returns a non-null address, and a
+        //:   deallocation of 0 bytes (denoting an unknown size) is returned
+        //:   with 'ALLOCATOR::deallocate', unless the alignment is extended.
+        //:
+        //: 5 'is_equal' is 'true' only for the same object.
+        //
+        // Plan:
+        //: 1 Instantiate 'AllocatorResource' with 'my_RecordingAllocator',
+        //:   supplying a constructor argument, and verify it.  (C-1)
+        //:
+        //: 2 For a table of sizes, alignments, and expected routes, allocate
+        //:   and deallocate through the 'memory_resource' interface, and
+        //:   verify the calls recorded by the allocator.  (C-2..4)
+        //:
+        //: 3 Compare two objects using 'is_equal'.  (C-5)
+        //
+        // Testing:
+        //   AllocatorResource(ARGS&&... arguments);
+        //   ~AllocatorResource();
+        //   void *do_allocate(std::size_t bytes, std::size_t alignment);
+        //   void do_deallocate(void *, std::size_t bytes, std::size_t align);
+        //   bool do_is_equal(const memory_resource& other) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCLASS TEMPLATE 'AllocatorResource'"
+                            "\n==================================\n");
+
+        typedef bslma::AllocatorResource<my_RecordingAllocator> Obj;
+
+        {
+            Obj mX(5);  const Obj& X = mX;
+            ASSERT(5 == X.d_value);
+
+            Obj mY;     const Obj& Y = mY;
+            ASSERT(0 == Y.d_value);
+
+            const std::pmr::memory_resource& RX = X;
+            const std::pmr::memory_resource& RY = Y;
+
+            ASSERT( RX.is_equal(RX));
+            ASSERT(!RX.is_equal(RY));
+            ASSERT( RX == RX);
+            ASSERT(!(RX == RY));
+        }
+
+        static const struct {
+            int         d_line;       // source line number
+            std::size_t d_bytes;      // requested size
+            std::size_t d_alignment;  // requested alignment
+            bool        d_aligned;    // expect 'allocateAligned'
+            std::size_t d_expSize;    // size expected by the allocator
+            char        d_route;      // expected deallocation: 'S'ized,
+                                      // 'A'ligned, or 'U'nsized
+        } DATA[] = {
+            //LINE  BYTES  ALIGN  ALIGNED  EXP_SIZE  ROUTE
+            //----  -----  -----  -------  --------  -----
+            { L_,      0,     1,   false,       1,   'U' },
+            { L_,      1,     1,   false,       1,   'S' },
+            { L_,      3,     1,   false,       3,   'S' },
+            { L_,      4,     4,   false,       4,   'S' },
+            { L_,     24,     8,   false,      24,   'S' },
+            { L_,     32,    16,   false,      32,   'S' },
+            { L_,   1000,     8,   false,    1000,   'S' },
+            { L_,      0,     8,   false,       8,   'U' },
+            { L_,      0,    64,    true,       1,   'A' },
+            { L_,      4,     8,    true,       4,   'A' },
+            { L_,     12,     8,    true,      12,   'A' },
+            { L_,     64,    64,    true,      64,   'A' },
+            { L_,    100,   128,    true,     100,   'A' },
+            { L_,   4096,  4096,    true,    4096,   'A' },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE     = DATA[ti].d_line;
+            const std::size_t BYTES    = DATA[ti].d_bytes;
+            const std::size_t ALIGN    = DATA[ti].d_alignment;
+            const bool        ALIGNED  = DATA[ti].d_aligned;
+            const std::size_t EXP_SIZE = DATA[ti].d_expSize;
+            const char        ROUTE    = DATA[ti].d_route;
+
+            if (veryVerbose) { P_(LINE) P_(BYTES) P(ALIGN) }
+
+            Obj                        mX;
+            std::pmr::memory_resource& resource = mX;
+
+            char *p = static_cast<char *>(resource.allocate(BYTES, ALIGN));
+
+            ASSERTV(LINE, p);
+            ASSERTV(LINE,
+                    0 == reinterpret_cast<bsls::Types::UintPtr>(p) % ALIGN);
+            ASSERTV(LINE, EXP_SIZE == mX.d_lastSize);
+            ASSERTV(LINE, !ALIGNED == (1 == mX.d_numAllocate));
+            ASSERTV(LINE,  ALIGNED == (1 == mX.d_numAllocateAligned));
+            if (ALIGNED) {
+                ASSERTV(LINE, ALIGN == mX.d_lastAlignment);
+            }
+
+            mX.d_lastSize      = 0;
+            mX.d_lastAlignment = 0;
+
+            resource.deallocate(p, BYTES, ALIGN);
+
+            ASSERTV(LINE, ('S' == ROUTE) == (1 == mX.d_numDeallocateSized));
+            ASSERTV(LINE, ('A' == ROUTE) == (1 == mX.d_numDeallocateAligned));
+            ASSERTV(LINE, ('U' == ROUTE) == (1 == mX.d_numDeallocate));
+            if ('U' != ROUTE) {
+                ASSERTV(LINE, EXP_SIZE == mX.d_lastSize);
+            }
+            if ('A' == ROUTE) {
+                ASSERTV(LINE, ALIGN == mX.d_lastAlignment);
+            }
+        }
+
+        if (verbose) printf("\nShared use through both protocols.\n");
+        {
+            Obj mX;
+
+            bslma::Allocator          *allocator = &mX;
+            std::pmr::memory_resource *resource  = &mX;
+
+            void *p = allocator->allocate(8);
+            void *q = resource->allocate(8, 8);
+
+            ASSERT(2 == mX.d_numAllocate);
+
+            allocator->deallocate(p);
+            resource->deallocate(q, 8, 8);
+
+            ASSERT(1 == mX.d_numDeallocate);
+            ASSERT(1 == mX.d_numDeallocateSized);
+        }
+      } break;
+#endif  // BSLMA_MEMORYRESOURCE_HAS_PMR
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The classes are sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //:
+        //: 2 'BSLMA_MEMORYRESOURCE_HAS_PMR' is not defined only if the
+        //:   standard library does not provide '<memory_resource>' or the
+        //:   compilation is not in C++17 (or later) mode.
+        //
+        // Plan:
+        //: 1 Allocate from a 'std::pmr' container using an
+        //:   'AllocatorResource', and allocate from a 'MemoryResourceAdapter'
+        //:   over the 'AllocatorResource'.  (C-1)
+        //:
+        //: 2 If 'BSLMA_MEMORYRESOURCE_HAS_PMR' is not defined, verify that
+        //:   '<memory_resource>' is not available, or that '__cplusplus' is
+        //:   earlier than C++17.  (C-2)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+#ifdef BSLMA_MEMORYRESOURCE_HAS_PMR
+        bslma::AllocatorResource<my_RecordingAllocator> ar;
+        {
+            std::pmr::vector<int> v(&ar);
+            for (int i = 0; i < 100; ++i) {
+                v.push_back(i);
+            }
+            ASSERT(0 < ar.d_numAllocate);
+        }
+        ASSERT(ar.d_numAllocate == ar.d_numDeallocateSized);
+
+        bslma::MemoryResourceAdapter adapter(&ar);
+
+        void *p = adapter.allocate(10);
+        ASSERT(p);
+        adapter.deallocateSized(p, 10);
+
+        ASSERT(ar.d_numAllocate == ar.d_numDeallocateSized);
+        ASSERT(10 == ar.d_lastSize);
+
+        p = adapter.allocate(10);
+        adapter.deallocate(p);
+
+        ASSERT(1 == ar.d_numDeallocate);
+#else
+        if (verbose) printf("'std::pmr' is not available.\n");
+
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+        const bool HAS_HEADER = true;
+#else
+        const bool HAS_HEADER = false;
+#endif
+#else
+        const bool HAS_HEADER = false;
+#endif
+
+        ASSERTV(__cplusplus, !HAS_HEADER || __cplusplus < 201703L);
+#endif
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -4,12 +4,24 @@
 #include <bsls_ident.h>
 BSLS_IDENT("$Id$ $CSID$")
 
+#include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
 #include <bsls_atomicoperations.h>
+#include <bsls_bslexceptionutil.h>
 #include <bsls_objectbuffer.h>
+#include <bsls_platform.h>
 
 #include <new>
 
+#if defined(__cpp_aligned_new) && __cpp_aligned_new >= 201606L
+#define BSLMA_NEWDELETEALLOCATOR_ALIGNED_NEW 1
+    // The aligned global 'operator new' and 'operator delete' are available.
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+#include <malloc.h>  // '_aligned_malloc', '_aligned_free'
+#else
+#include <stdlib.h>  // 'posix_memalign', 'free'
+#endif
+
 namespace BloombergLP {
 
 typedef bsls::ObjectBuffer<bslma::NewDeleteAllocator>
@@ -94,6 +106,64 @@ NewDeleteAllocator::~NewDeleteAllocator()
 {
 }
 
+// MANIPULATORS
+void *NewDeleteAllocator::allocateAligned(size_type size, size_type alignment)
+{
+    BSLS_ASSERT(0 < alignment);
+    BSLS_ASSERT(0 == (alignment & (alignment - 1)));
+
+    if (alignment <= static_cast<size_type>(
+                                   bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT)) {
+        return Allocator::allocateAligned(size, alignment);           // RETURN
+    }
+
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+#if defined(BSLMA_NEWDELETEALLOCATOR_ALIGNED_NEW)
+    return ::operator new(size, std::align_val_t(alignment));
+#else
+#if defined(BSLS_PLATFORM_OS_WINDOWS)
+    void *result = _aligned_malloc(size, alignment);
+#else
+    void *result = 0;
+    if (0 != ::posix_memalign(&result, alignment, size)) {
+        result = 0;
+    }
+#endif
+
+    if (!result) {
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    return result;
+#endif
+}
+
+void NewDeleteAllocator::deallocateAligned(void      *address,
+                                           size_type,
+                                           size_type  alignment)
+{
+    if (!address) {
+        return;                                                       // RETURN
+    }
+
+    if (alignment <= static_cast<size_type>(
+                                   bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT)) {
+        ::operator delete(address);
+        return;                                                       // RETURN
+    }
+
+#if defined(BSLMA_NEWDELETEALLOCATOR_ALIGNED_NEW)
+    ::operator delete(address, std::align_val_t(alignment));
+#elif defined(BSLS_PLATFORM_OS_WINDOWS)
+    _aligned_free(address);
+#else
+    ::free(address);
+#endif
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
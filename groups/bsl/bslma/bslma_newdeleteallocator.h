@@ -31,7 +31,9 @@ BSLS_IDENT("$Id: $")
 //      ( bslma::Allocator )
 //       `----------------'
 //                       allocate
+//                       allocateAligned
 //                       deallocate
+//                       deallocateAligned
 //..
 // The essential purpose of this component is to facilitate the default use of
 // global 'new' and 'delete' in all components that accept a user-supplied
@@ -46,6 +48,17 @@ BSLS_IDENT("$Id: $")
 // natural-alignment requirement imposed by the base-class contract, or than is
 // provided by many other concrete implementations.
 //
+///Extended Alignment
+///------------------
+// 'allocateAligned' supplies blocks aligned to any power of two.  An alignment
+// no greater than the maximal fundamental alignment is satisfied by global
+// 'operator new' itself.  A greater alignment is satisfied by the aligned
+// global 'operator new' when the library is built in C++17 (or later) mode,
+// and otherwise by 'posix_memalign' (or '_aligned_malloc' on Windows), which
+// bypasses any replacement of the global 'operator new'.  Such a block must be
+// returned with 'deallocateAligned', passing the same alignment, which
+// releases it with the matching deallocation function.
+//
 ///Thread Safety
 ///-------------
 // This class is fully thread-safe, which means that all non-creator object
@@ -325,6 +338,31 @@ class NewDeleteAllocator : public Allocator {
         // global 'operator delete' is *not* called when 'address' is 0 (in
         // order to avoid having to acquire a lock, and potential contention in
         // multi-threaded programs).
+
+    virtual void *allocateAligned(size_type size, size_type alignment);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes) whose address is a multiple of the
+        // specified 'alignment', which may exceed the maximal fundamental
+        // alignment of the platform.  If 'size' is 0, a null pointer is
+        // returned with no other effect.  The block is returned to this
+        // allocator by calling 'deallocateAligned' with the same 'size' and
+        // 'alignment'.  If the memory cannot be obtained, 'std::bad_alloc' is
+        // thrown.  The behavior is undefined unless 'alignment' is a positive
+        // power of two.  Note that a block of extended alignment is obtained
+        // from the aligned allocation function of the platform (see
+        // {Extended Alignment}).
+
+    virtual void deallocateAligned(void      *address,
+                                   size_type  size,
+                                   size_type  alignment);
+        // Return the memory block at the specified 'address', which was
+        // obtained by a call to 'allocateAligned' with the specified 'size'
+        // and 'alignment', back to this allocator, using the deallocation
+        // function that matches the one that supplied the block.  If
+        // 'address' is 0, this function has no effect.  The behavior is
+        // undefined unless 'address' was allocated using this allocator object
+        // by a call to 'allocateAligned(size, alignment)' and has not already
+        // been deallocated.
 };
 
 // ============================================================================
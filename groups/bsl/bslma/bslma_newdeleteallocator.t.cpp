@@ -4,8 +4,10 @@
 
 #include <bslma_allocator.h>    // for testing only
 
+#include <bsls_alignmentutil.h>
 #include <bsls_bsltestutil.h>
 #include <bsls_platform.h>
+#include <bsls_types.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -89,11 +91,13 @@ static void aSsErT(bool b, const char *s, int i) {
 // [ 1] ~bslma::NewDeleteAllocator();
 // [ 1] void *allocate(int size);
 // [ 1] void deallocate(void *address);
+// [ 3] void *allocateAligned(size_type size, size_type alignment);
+// [ 3] void deallocateAligned(void *, size_type size, size_type align);
 //--------------------------------------------------------------------------
 // [ 1] Make sure that global operators new and delete are called.
 // [ 2] Make sure that the lifetime of the singleton is sufficient.
 // [ 2] Make sure that memory is not leaked.
-// [ 3] USAGE EXAMPLE
+// [ 4] USAGE EXAMPLE
 //==========================================================================
 
 //=============================================================================
@@ -354,7 +358,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
-      case 3: {
+      case 4: {
         // -----------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -386,6 +390,100 @@ int main(int argc, char *argv[])
         ASSERT(0 == globalNewCalledCount);
 
       } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // EXTENDED ALIGNMENT
+        //
+        // Concerns:
+        //: 1 'allocateAligned' returns a writable block aligned to the
+        //:   requested alignment, including alignments (64 and 4096) that
+        //:   exceed the maximal fundamental alignment.
+        //:
+        //: 2 A fundamental alignment is satisfied by the global
+        //:   'operator new', and an extended alignment is not.
+        //:
+        //: 3 'deallocateAligned' releases a fundamentally aligned block with
+        //:   the global 'operator delete', and an extended one with the
+        //:   matching aligned deallocation function.
+        //:
+        //: 4 A request of 0 bytes returns 0, and deallocating 0 has no
+        //:   effect.
+        //
+        // Plan:
+        //: 1 For a table of sizes and alignments, allocate a block, verify
+        //:   its alignment and the calls made to the instrumented global
+        //:   'operator new', fill the block, and deallocate it, verifying the
+        //:   calls made to the instrumented global 'operator delete'.
+        //:   (C-1..3)
+        //:
+        //: 2 Request 0 bytes, and deallocate 0.  (C-4)
+        //
+        // Testing:
+        //   void *allocateAligned(size_type size, size_type alignment);
+        //   void deallocateAligned(void *, size_type size, size_type align);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nEXTENDED ALIGNMENT"
+                            "\n==================\n");
+
+        typedef bslma::Allocator::size_type size_type;
+
+        const size_type MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+        static const size_type SIZES[]  = { 1, 24, 100, 5000 };
+        const int              NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        static const size_type ALIGNS[]  = { 1, 8, 64, 4096 };
+        const int              NUM_ALIGNS = sizeof ALIGNS / sizeof *ALIGNS;
+
+        bslma::NewDeleteAllocator a;
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            for (int tj = 0; tj < NUM_ALIGNS; ++tj) {
+                const size_type SIZE     = SIZES[ti];
+                const size_type ALIGN    = ALIGNS[tj];
+                const bool      EXTENDED = ALIGN > MAX_ALIGN;
+
+                if (veryVerbose) { P_(SIZE) P(ALIGN) }
+
+                globalNewCalledCount          = 0;
+                globalNewCalledCountIsEnabled = 1;
+                char *p = static_cast<char *>(a.allocateAligned(SIZE, ALIGN));
+                globalNewCalledCountIsEnabled = 0;
+
+                ASSERTV(SIZE, ALIGN, p);
+                ASSERTV(SIZE, ALIGN,
+                        0 == reinterpret_cast<bsls::Types::UintPtr>(p)
+                                                                   % ALIGN);
+                ASSERTV(SIZE, ALIGN, globalNewCalledCount,
+                        (EXTENDED ? 0 : 1) == globalNewCalledCount);
+
+                memset(p, 0xa5, SIZE);
+
+                globalDeleteCalledCount          = 0;
+                globalDeleteCalledCountIsEnabled = 1;
+                a.deallocateAligned(p, SIZE, ALIGN);
+                globalDeleteCalledCountIsEnabled = 0;
+
+                ASSERTV(SIZE, ALIGN, globalDeleteCalledCount,
+                        (EXTENDED ? 0 : 1) == globalDeleteCalledCount);
+            }
+        }
+
+        if (verbose) printf("\nTesting 0 bytes\n");
+        {
+            ASSERT(0 == a.allocateAligned(0, 64));
+            ASSERT(0 == a.allocateAligned(0, 4096));
+
+            globalDeleteCalledCount          = 0;
+            globalDeleteCalledCountIsEnabled = 1;
+            a.deallocateAligned(0, 0, 8);
+            a.deallocateAligned(0, 0, 4096);
+            globalDeleteCalledCountIsEnabled = 0;
+
+            ASSERT(0 == globalDeleteCalledCount);
+        }
+      } break;
       case 2: {
         // -----------------------------------------------------------------
         // SINGLETON TEST:
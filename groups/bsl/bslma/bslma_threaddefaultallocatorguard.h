@@ -0,0 +1,208 @@
+// bslma_threaddefaultallocatorguard.h                                -*-C++-*-
+#ifndef INCLUDED_BSLMA_THREADDEFAULTALLOCATORGUARD
+#define INCLUDED_BSLMA_THREADDEFAULTALLOCATORGUARD
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide scoped guard to install a thread default allocator.
+//
+//@CLASSES:
+//  bslma::ThreadDefaultAllocatorGuard: thread default-allocator scoped guard
+//
+//@SEE_ALSO: bslma_default, bslma_defaultallocatorguard
+//
+//@DESCRIPTION: This component provides an object,
+// 'bslma::ThreadDefaultAllocatorGuard', that serves as a "scoped guard" to
+// install an allocator as the *thread* *default* allocator of the calling
+// thread (see 'bslma_default').  While the guard is in scope,
+// 'bslma::Default::defaultAllocator', and 'bslma::Default::allocator' with no
+// argument or an explicit 0, return the guarded allocator when called from
+// the thread that created the guard; other threads are unaffected.
+//
+// The guard object takes as its constructor argument the address of an object
+// of a class derived from 'bslma::Allocator'.  The thread default allocator of
+// the calling thread at the time of guard construction (if any) is held by the
+// guard, and the constructor-argument allocator is installed as the new thread
+// default allocator (via a call to
+// 'bslma::Default::setThreadDefaultAllocator').  Upon destruction of the guard
+// object, its held allocator is restored as the thread default allocator, or,
+// if the thread had none, the thread default allocator is removed.  Guards may
+// therefore be nested, but must be destroyed by the thread that created them,
+// in the reverse order of their creation.
+//
+// Unlike 'bslma::DefaultAllocatorGuard', which replaces the process-wide
+// default allocator and is intended for testing only, this guard neither
+// observes nor modifies the process-wide default allocator, is not affected
+// by 'bslma::Default::lockDefaultAllocator', and is suitable for use in
+// production code.  Note that every object created while the guard is in
+// scope without an explicitly supplied allocator uses the guarded allocator
+// for its entire lifetime, so the guarded allocator must outlive all such
+// objects, including any that are handed off to another thread.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Using a Per-Request Arena
+/// - - - - - - - - - - - - - - - - - -
+// Suppose that a server processes each request on a worker thread, using
+// types that take an optional allocator and fall back to the default
+// allocator when none is supplied.  Instead of passing an allocator through
+// every function called while handling the request, we want all such objects
+// to draw their memory from an arena belonging to the request.
+//
+// First, we define a simple type, 'my_Message', that holds a copy of a string
+// and uses the default allocator unless an allocator is supplied:
+//..
+//  class my_Message {
+//      // This class holds a copy of a null-terminated string.
+//
+//      // DATA
+//      char             *d_text_p;       // copy of the text (owned)
+//      bslma::Allocator *d_allocator_p;  // memory allocator (held)
+//
+//    private:
+//      // NOT IMPLEMENTED
+//      my_Message(const my_Message&);
+//      my_Message& operator=(const my_Message&);
+//
+//    public:
+//      // CREATORS
+//      explicit
+//      my_Message(const char *text, bslma::Allocator *basicAllocator = 0)
+//          // Create a message holding a copy of the specified 'text'.
+//          // Optionally specify a 'basicAllocator' used to supply memory.
+//          // If 'basicAllocator' is 0, the currently installed default
+//          // allocator is used.
+//      : d_allocator_p(bslma::Default::allocator(basicAllocator))
+//      {
+//          std::size_t size = std::strlen(text) + 1;
+//          d_text_p = static_cast<char *>(d_allocator_p->allocate(size));
+//          std::memcpy(d_text_p, text, size);
+//      }
+//
+//      ~my_Message()
+//          // Destroy this object.
+//      {
+//          d_allocator_p->deallocate(d_text_p);
+//      }
+//
+//      // ACCESSORS
+//      const char *text() const
+//          // Return the text held by this object.
+//      {
+//          return d_text_p;
+//      }
+//  };
+//..
+// Then, we define the function that processes a request.  It installs the
+// specified 'arena' as the thread default allocator for the duration of the
+// request, so that the 'my_Message' object, and any other object created
+// without an explicitly supplied allocator, uses it:
+//..
+//  int processRequest(const char *request, bslma::Allocator *arena)
+//      // Process the specified 'request', obtaining any memory that is not
+//      // explicitly allocated otherwise from the specified 'arena'.  Return
+//      // the length of 'request'.
+//  {
+//      bslma::ThreadDefaultAllocatorGuard guard(arena);
+//
+//      my_Message message(request);
+//      assert(arena == bslma::Default::defaultAllocator());
+//
+//      return static_cast<int>(std::strlen(message.text()));
+//  }
+//..
+// Next, we install a test allocator as the process-wide default allocator, so
+// that we can observe that it is not used while a request is processed:
+//..
+//  bslma::TestAllocator         da("default");
+//  bslma::DefaultAllocatorGuard dag(&da);
+//..
+// Finally, we process a request using another test allocator as its arena,
+// and verify that the arena, rather than the process-wide default allocator,
+// supplied the memory, and that the process-wide default allocator is once
+// again the default allocator of this thread when the request is done:
+//..
+//  bslma::TestAllocator arena("arena");
+//
+//  assert(5 == processRequest("hello", &arena));
+//
+//  assert(1 == arena.numBlocksTotal());
+//  assert(0 == arena.numBlocksInUse());
+//  assert(0 == da.numBlocksTotal());
+//
+//  assert(&da == bslma::Default::defaultAllocator());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+namespace BloombergLP {
+
+namespace bslma {
+
+class Allocator;
+
+                     // =================================
+                     // class ThreadDefaultAllocatorGuard
+                     // =================================
+
+class ThreadDefaultAllocatorGuard {
+    // Upon construction, an object of this class saves the thread default
+    // allocator of the calling thread (if any) and installs the user-specified
+    // allocator as the thread default allocator.  On destruction, the original
+    // thread default allocator (or its absence) is restored.  An object of
+    // this class must be destroyed by the thread that created it.
+
+    Allocator *d_original_p;  // original (to be restored at destruction), or
+                              // 0 if the thread had no thread default
+
+    // NOT IMPLEMENTED
+    ThreadDefaultAllocatorGuard(const ThreadDefaultAllocatorGuard&);
+    ThreadDefaultAllocatorGuard& operator=(const ThreadDefaultAllocatorGuard&);
+
+  public:
+    // CREATORS
+    explicit
+    ThreadDefaultAllocatorGuard(Allocator *temporary);
+        // Create a scoped guard that installs the specified 'temporary'
+        // allocator as the thread default allocator of the calling thread.
+        // The behavior is undefined unless 'temporary' outlives every object
+        // that obtains memory from it as a result.  Note that the thread
+        // default allocator is automatically restored to the original
+        // allocator, if any, on destruction.
+
+    ~ThreadDefaultAllocatorGuard();
+        // Restore the thread default allocator of the calling thread that was
+        // in place when this scoped guard was created, or remove it if there
+        // was none, and destroy this guard.  The behavior is undefined unless
+        // the calling thread is the thread that created this guard, and every
+        // guard that this thread created after this one has been destroyed.
+};
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,506 @@
+// bslma_threaddefaultallocatorguard.t.cpp                            -*-C++-*-
+
+#include <bslma_threaddefaultallocatorguard.h>
+
+#include <bslma_allocator.h>               // for testing only
+#include <bslma_default.h>                 // for testing only
+#include <bslma_defaultallocatorguard.h>   // for testing only
+#include <bslma_testallocator.h>           // for testing only
+
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_platform.h>
+
+#include <cstring>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test "guards" the thread default allocator of the
+// calling thread: an instance of this object saves the thread default
+// allocator (if any) and installs a new one (from the constructor argument)
+// on construction, and restores the original thread default allocator (or
+// its absence) on destruction.
+//
+// In addition to the straightforward single-threaded concerns, we verify that
+// a guard affects only the thread that created it, and that it neither
+// observes nor modifies the process-wide default allocator.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 1] bslma::ThreadDefaultAllocatorGuard(bslma::Allocator *temporary);
+// [ 1] ~bslma::ThreadDefaultAllocatorGuard();
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 2] CONCERN: A guard affects only the thread that created it.
+// [ 3] USAGE EXAMPLE
+//=============================================================================
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+typedef bslma::ThreadDefaultAllocatorGuard Obj;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+                                // ------
+                                // case 2
+                                // ------
+
+struct WorkerArgs {
+    // This 'struct' describes the work of one thread in case 2.
+
+    bslma::Allocator *d_arena_p;         // thread default to install
+    bslma::Allocator *d_processDefault_p;
+                                         // expected process-wide default
+    int               d_numErrors;       // number of failed checks
+};
+
+extern "C" void *workerThread(void *arg)
+    // Install, in turn, a thread default allocator and no thread default
+    // allocator for the calling thread, allocate from the default allocator
+    // in each case, and count in the specified 'arg' the number of times that
+    // the default allocator is not as described by 'arg'.
+{
+    WorkerArgs& args = *static_cast<WorkerArgs *>(arg);
+
+    const int NUM_ITERATIONS = 1000;
+
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        {
+            Obj guard(args.d_arena_p);
+
+            if (args.d_arena_p != bslma::Default::defaultAllocator()
+             || args.d_arena_p != bslma::Default::threadDefaultAllocator()) {
+                ++args.d_numErrors;
+            }
+
+            bslma::Allocator *allocator = bslma::Default::allocator(0);
+            allocator->deallocate(allocator->allocate(i + 1));
+        }
+
+        if (args.d_processDefault_p != bslma::Default::defaultAllocator()
+         || 0 != bslma::Default::threadDefaultAllocator()) {
+            ++args.d_numErrors;
+        }
+    }
+
+    return arg;
+}
+
+//=============================================================================
+//                             USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Using a Per-Request Arena
+/// - - - - - - - - - - - - - - - - - -
+// Suppose that a server processes each request on a worker thread, using
+// types that take an optional allocator and fall back to the default
+// allocator when none is supplied.  Instead of passing an allocator through
+// every function called while handling the request, we want all such objects
+// to draw their memory from an arena belonging to the request.
+//
+// First, we define a simple type, 'my_Message', that holds a copy of a string
+// and uses the default allocator unless an allocator is supplied:
+//..
+    class my_Message {
+        // This class holds a copy of a null-terminated string.
+
+        // DATA
+        char             *d_text_p;       // copy of the text (owned)
+        bslma::Allocator *d_allocator_p;  // memory allocator (held)
+
+      private:
+        // NOT IMPLEMENTED
+        my_Message(const my_Message&);
+        my_Message& operator=(const my_Message&);
+
+      public:
+        // CREATORS
+        explicit
+        my_Message(const char *text, bslma::Allocator *basicAllocator = 0)
+            // Create a message holding a copy of the specified 'text'.
+            // Optionally specify a 'basicAllocator' used to supply memory.
+            // If 'basicAllocator' is 0, the currently installed default
+            // allocator is used.
+        : d_allocator_p(bslma::Default::allocator(basicAllocator))
+        {
+            std::size_t size = std::strlen(text) + 1;
+            d_text_p = static_cast<char *>(d_allocator_p->allocate(size));
+            std::memcpy(d_text_p, text, size);
+        }
+
+        ~my_Message()
+            // Destroy this object.
+        {
+            d_allocator_p->deallocate(d_text_p);
+        }
+
+        // ACCESSORS
+        const char *text() const
+            // Return the text held by this object.
+        {
+            return d_text_p;
+        }
+    };
+//..
+// Then, we define the function that processes a request.  It installs the
+// specified 'arena' as the thread default allocator for the duration of the
+// request, so that the 'my_Message' object, and any other object created
+// without an explicitly supplied allocator, uses it:
+//..
+    int processRequest(const char *request, bslma::Allocator *arena)
+        // Process the specified 'request', obtaining any memory that is not
+        // explicitly allocated otherwise from the specified 'arena'.  Return
+        // the length of 'request'.
+    {
+        bslma::ThreadDefaultAllocatorGuard guard(arena);
+
+        my_Message message(request);
+        ASSERT(arena == bslma::Default::defaultAllocator());
+
+        return static_cast<int>(std::strlen(message.text()));
+    }
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+    int veryVeryVerbose = argc > 4;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING USAGE EXAMPLE
+        //   The usage example provided in the component header file must
+        //   compile, link, and run on all platforms as shown.
+        //
+        // Plan:
+        //   Incorporate usage example from header into driver, remove
+        //   leading comment characters, and replace 'assert' with
+        //   'ASSERT'.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Next, we install a test allocator as the process-wide default allocator, so
+// that we can observe that it is not used while a request is processed:
+//..
+    bslma::TestAllocator         da("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+//..
+// Finally, we process a request using another test allocator as its arena,
+// and verify that the arena, rather than the process-wide default allocator,
+// supplied the memory, and that the process-wide default allocator is once
+// again the default allocator of this thread when the request is done:
+//..
+    bslma::TestAllocator arena("arena", veryVeryVerbose);
+
+    ASSERT(5 == processRequest("hello", &arena));
+
+    ASSERT(1 == arena.numBlocksTotal());
+    ASSERT(0 == arena.numBlocksInUse());
+    ASSERT(0 == da.numBlocksTotal());
+
+    ASSERT(&da == bslma::Default::defaultAllocator());
+//..
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONCERN: A GUARD AFFECTS ONLY THE THREAD THAT CREATED IT
+        //
+        // Concerns:
+        //: 1 A guard changes the default allocator of the thread that created
+        //:   it, and of no other thread.
+        //:
+        //: 2 Guards created concurrently by several threads do not interfere.
+        //:
+        //: 3 The process-wide default allocator is unchanged, both during and
+        //:   after the lifetime of the guards.
+        //
+        // Plan:
+        //: 1 Install a test allocator as the process-wide default allocator.
+        //:
+        //: 2 While the main thread holds a guard of its own, start several
+        //:   threads, each of which repeatedly creates a guard for its own
+        //:   test allocator, allocates from the default allocator, and
+        //:   verifies the default allocator with and without the guard.
+        //:   (C-1..2)
+        //:
+        //: 3 Verify that each thread's allocations went to its own test
+        //:   allocator only, and that the default allocators of the main
+        //:   thread are as expected before and after.  (C-1, 3)
+        //
+        // Testing:
+        //   CONCERN: A guard affects only the thread that created it.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nCONCERN: A GUARD AFFECTS ONLY ITS THREAD"
+                            "\n========================================\n");
+
+        enum { NUM_THREADS = 4 };
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator         ma("main", veryVeryVerbose);
+        bslma::TestAllocator         ta[NUM_THREADS];
+        WorkerArgs                   args[NUM_THREADS];
+        ThreadId                     threads[NUM_THREADS];
+
+        {
+            Obj guard(&ma);
+
+            ASSERT(&ma == bslma::Default::defaultAllocator());
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                args[i].d_arena_p          = &ta[i];
+                args[i].d_processDefault_p = &da;
+                args[i].d_numErrors        = 0;
+
+                threads[i] = createThread(&workerThread, &args[i]);
+            }
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                joinThread(threads[i]);
+            }
+
+            ASSERT(&ma == bslma::Default::defaultAllocator());
+            ASSERT(&ma == bslma::Default::threadDefaultAllocator());
+        }
+
+        ASSERT(&da == bslma::Default::defaultAllocator());
+        ASSERT(&da == bslma::Default::processDefaultAllocator());
+        ASSERT( 0  == bslma::Default::threadDefaultAllocator());
+
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            if (veryVerbose) {
+                P_(i) P_(args[i].d_numErrors) P(ta[i].numBlocksTotal())
+            }
+            ASSERTV(i, args[i].d_numErrors, 0 == args[i].d_numErrors);
+            ASSERTV(i, ta[i].numBlocksTotal(), 0 < ta[i].numBlocksTotal());
+            ASSERTV(i, ta[i].numBlocksInUse(), 0 == ta[i].numBlocksInUse());
+        }
+
+        ASSERTV(ma.numBlocksTotal(), 0 == ma.numBlocksTotal());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The guard installs the allocator supplied at construction as the
+        //:   thread default allocator, which 'bslma::Default::allocator'
+        //:   returns when supplied with 0.
+        //:
+        //: 2 On destruction, the guard removes the thread default allocator
+        //:   if the thread had none, and restores it otherwise, so that
+        //:   guards can be nested.
+        //:
+        //: 3 The guard has no effect on the process-wide default allocator,
+        //:   even if that allocator is locked.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Lock the process-wide default allocator, and create nested
+        //:   guards, verifying the thread default allocator and the default
+        //:   allocator within and after each scope.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null allocator.  (C-4)
+        //
+        // Testing:
+        //   bslma::ThreadDefaultAllocatorGuard(bslma::Allocator *temporary);
+        //   ~bslma::ThreadDefaultAllocatorGuard();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        bslma::TestAllocator da("default", veryVeryVerbose);
+
+        ASSERT(0 == bslma::Default::setDefaultAllocator(&da));
+        bslma::Default::lockDefaultAllocator();
+
+        ASSERT(&da == bslma::Default::defaultAllocator());
+        ASSERT( 0  == bslma::Default::threadDefaultAllocator());
+
+        {
+            bslma::TestAllocator oa("outer", veryVeryVerbose);
+            Obj outer(&oa);
+
+            ASSERT(&oa == bslma::Default::threadDefaultAllocator());
+            ASSERT(&oa == bslma::Default::defaultAllocator());
+            ASSERT(&oa == bslma::Default::allocator(0));
+            ASSERT(&da == bslma::Default::processDefaultAllocator());
+            ASSERT(&da == bslma::Default::allocator(&da));
+
+            {
+                bslma::TestAllocator ia("inner", veryVeryVerbose);
+                Obj inner(&ia);
+
+                ASSERT(&ia == bslma::Default::threadDefaultAllocator());
+                ASSERT(&ia == bslma::Default::defaultAllocator());
+                ASSERT(&da == bslma::Default::processDefaultAllocator());
+            }
+
+            ASSERT(&oa == bslma::Default::threadDefaultAllocator());
+            ASSERT(&oa == bslma::Default::defaultAllocator());
+        }
+
+        ASSERT( 0  == bslma::Default::threadDefaultAllocator());
+        ASSERT(&da == bslma::Default::defaultAllocator());
+        ASSERT(&da == bslma::Default::allocator(0));
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            bslma::TestAllocator oa("object", veryVeryVerbose);
+
+            ASSERT_PASS(Obj mX(&oa));
+            ASSERT_FAIL(Obj mX(0));
+        }
+
+        ASSERT( 0  == bslma::Default::threadDefaultAllocator());
+        ASSERT(&da == bslma::Default::defaultAllocator());
+      } break;
+
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,406 @@
+// bslma_winkoututil.h                                                -*-C++-*-
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#define INCLUDED_BSLMA_WINKOUTUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a trait and utility for abandoning objects in an arena.
+//
+//@CLASSES:
+//  bslma::IsWinkOutSafe: trait for types whose destruction only deallocates
+//  bslma::WinkOutUtil: namespace for deciding whether to skip destruction
+//
+//@SEE_ALSO: bslma_allocator, bslma_usesbslmaallocator
+//
+//@DESCRIPTION: This component provides a meta-function,
+// 'bslma::IsWinkOutSafe', and a utility 'struct', 'bslma::WinkOutUtil', that
+// together let a container determine that the elements it holds may be
+// "winked out": i.e., that their memory may simply be abandoned, without
+// running any destructor or returning any block to the allocator, because
+// doing so has no observable effect.
+//
+// An object may be winked out when both of the following hold:
+//
+//: o The type of the object is 'IsWinkOutSafe': its destructor has no effect
+//:   other than returning memory to the allocator supplied at construction
+//:   (or to the allocator of its container).
+//:
+//: o That allocator reports, through 'bslma::Allocator::hasNoOpDeallocate',
+//:   that its 'deallocate' method has no effect (as is the case for the
+//:   sequential allocators in 'bdlma', whose memory is reclaimed when the
+//:   allocator is released or destroyed).
+//
+// 'bslma::IsWinkOutSafe' is 'true' for all trivially copyable types, as a
+// trivially copyable type has a trivial destructor.  A type whose destructor
+// only releases memory to its 'bslma' allocator -- e.g., 'bsl::string',
+// or a 'bsl' container of 'IsWinkOutSafe' elements -- may declare the trait
+// using the 'BSLMF_NESTED_TRAIT_DECLARATION' macro, or by specializing
+// 'bslma::IsWinkOutSafe'.  Note that a type must not declare the trait if
+// its destructor has any other effect (e.g., releasing a lock, closing a
+// file, or decrementing a shared reference count).
+//
+// 'bsl::string', 'bsl::pair', and the 'bsl' containers specialize the trait
+// to hold when their elements are wink-out safe and their allocator is
+// 'bslma'-based; the comparators and hashers of the associative containers
+// are taken to have trivial destructors.
+//
+// 'bslma::WinkOutUtil::canWinkOut' combines the trait with a run-time query
+// of a container's allocator.  The query is made only if the trait holds,
+// and only for allocator types constructible from a 'bslma::Allocator *'
+// (i.e., allocators providing a 'mechanism' accessor, such as
+// 'bsl::allocator'); for any other allocator type 'canWinkOut' returns
+// 'false'.
+//
+///Usage
+///-----
+// This section illustrates intended usage of this component.
+//
+///Example 1: Skipping the Destruction of a Node-Based Container
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we implement a simple singly-linked stack whose nodes are supplied
+// by an STL-style allocator wrapping a 'bslma::Allocator'.  When the stack is
+// destroyed, each node must ordinarily be destroyed and returned to
+// the allocator.  If the allocator's 'deallocate' method is a no-op and the
+// elements are wink-out safe, that walk can be skipped entirely.
+//
+// First, we define a minimal allocator type that, like 'bsl::allocator',
+// wraps a 'bslma::Allocator' and provides access to it through a 'mechanism'
+// accessor:
+//..
+//  template <class TYPE>
+//  class MyAllocator {
+//      // This class provides a minimal allocator that supplies memory for
+//      // objects of (template parameter) 'TYPE' from a 'bslma::Allocator'.
+//
+//      // DATA
+//      bslma::Allocator *d_mechanism_p;  // allocator (held, not owned)
+//
+//    public:
+//      // CREATORS
+//      MyAllocator(bslma::Allocator *mechanism)                // IMPLICIT
+//          // Create an allocator that uses the specified 'mechanism'.
+//      : d_mechanism_p(mechanism)
+//      {
+//      }
+//
+//      // MANIPULATORS
+//      TYPE *allocate()
+//          // Return uninitialized memory for one 'TYPE' object.
+//      {
+//          return static_cast<TYPE *>(
+//                                  d_mechanism_p->allocate(sizeof(TYPE)));
+//      }
+//
+//      void deallocate(TYPE *address)
+//          // Return the memory at the specified 'address'.
+//      {
+//          d_mechanism_p->deallocate(address);
+//      }
+//
+//      // ACCESSORS
+//      bslma::Allocator *mechanism() const
+//          // Return the allocator used by this allocator.
+//      {
+//          return d_mechanism_p;
+//      }
+//  };
+//..
+// Then, we define the stack, whose 'clear' method consults
+// 'bslma::WinkOutUtil::canWinkOut' before walking the nodes:
+//..
+//  template <class TYPE>
+//  struct MyStackNode {
+//      // This 'struct' holds one element of a 'MyStack'.
+//
+//      TYPE                d_value;
+//      MyStackNode<TYPE>  *d_next_p;
+//  };
+//
+//  template <class TYPE>
+//  class MyStack {
+//      // This class provides a stack of 'TYPE' elements.
+//
+//      // PRIVATE TYPES
+//      typedef MyStackNode<TYPE> Node;
+//
+//      // DATA
+//      Node              *d_top_p;      // top of the stack
+//      MyAllocator<Node>  d_allocator;  // supplies the nodes
+//
+//      // NOT IMPLEMENTED
+//      MyStack(const MyStack&);
+//      MyStack& operator=(const MyStack&);
+//
+//    public:
+//      // CREATORS
+//      explicit MyStack(bslma::Allocator *basicAllocator)
+//          // Create an empty stack that uses the specified
+//          // 'basicAllocator' to supply memory.
+//      : d_top_p(0)
+//      , d_allocator(basicAllocator)
+//      {
+//      }
+//
+//      ~MyStack()
+//          // Destroy this object.
+//      {
+//          clear();
+//      }
+//
+//      // MANIPULATORS
+//      void push(const TYPE& value)
+//          // Push the specified 'value' onto this stack.
+//      {
+//          Node *node = d_allocator.allocate();
+//          new (&node->d_value) TYPE(value);
+//          node->d_next_p = d_top_p;
+//          d_top_p = node;
+//      }
+//
+//      void clear()
+//          // Remove all elements from this stack.
+//      {
+//          if (bslma::WinkOutUtil::canWinkOut<TYPE>(d_allocator)) {
+//              d_top_p = 0;
+//              return;                                           // RETURN
+//          }
+//          while (d_top_p) {
+//              Node *node = d_top_p;
+//              d_top_p = node->d_next_p;
+//              node->d_value.~TYPE();
+//              d_allocator.deallocate(node);
+//          }
+//      }
+//  };
+//..
+// Next, we define an arena allocator whose 'deallocate' method is a no-op,
+// and which therefore overrides 'hasNoOpDeallocate' to return 'true'.  For
+// brevity, the arena allocates from a fixed buffer:
+//..
+//  class MyArenaAllocator : public bslma::Allocator {
+//      // This class provides an allocator that supplies memory from a
+//      // fixed buffer, and reclaims it only when destroyed.
+//
+//      // DATA
+//      bsls::AlignedBuffer<1024>  d_buffer;  // memory supplied
+//      int                        d_cursor;  // offset of next free byte
+//
+//    public:
+//      // CREATORS
+//      MyArenaAllocator()
+//          // Create an arena allocator.
+//      : d_cursor(0)
+//      {
+//      }
+//
+//      // MANIPULATORS
+//      virtual void *allocate(size_type size)
+//          // Return a block of at least the specified 'size' bytes.
+//      {
+//          const int offset = d_cursor;
+//          d_cursor += static_cast<int>(
+//                             bsls::AlignmentUtil::roundUpToMaximalAlignment(
+//                                                                   size));
+//          return d_buffer.buffer() + offset;
+//      }
+//
+//      virtual void deallocate(void *)
+//          // Do nothing.
+//      {
+//      }
+//
+//      // ACCESSORS
+//      virtual bool hasNoOpDeallocate() const
+//          // Return 'true'.
+//      {
+//          return true;
+//      }
+//  };
+//..
+// Now, we populate two stacks of 'int', one using the arena and the other
+// using a 'bslma::TestAllocator', which does deallocate memory:
+//..
+//  MyArenaAllocator     arena;
+//  bslma::TestAllocator ta;
+//
+//  MyStack<int> arenaStack(&arena);
+//  MyStack<int> heapStack(&ta);
+//  for (int i = 0; i < 10; ++i) {
+//      arenaStack.push(i);
+//      heapStack.push(i);
+//  }
+//..
+// Finally, we observe that only the stack using the test allocator walks
+// its nodes when cleared:
+//..
+//  const MyAllocator<int> arenaAllocator(&arena);
+//  const MyAllocator<int> heapAllocator(&ta);
+//
+//  assert(true  == bslma::WinkOutUtil::canWinkOut<int>(arenaAllocator));
+//  assert(false == bslma::WinkOutUtil::canWinkOut<int>(heapAllocator));
+//
+//  arenaStack.clear();
+//  heapStack.clear();
+//  assert(0 == ta.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_DETECTNESTEDTRAIT
+#include <bslmf_detectnestedtrait.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_INTEGRALCONSTANT
+#include <bslmf_integralconstant.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISCONVERTIBLE
+#include <bslmf_isconvertible.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISTRIVIALLYCOPYABLE
+#include <bslmf_istriviallycopyable.h>
+#endif
+
+namespace BloombergLP {
+
+namespace bslma {
+
+                            // ====================
+                            // struct IsWinkOutSafe
+                            // ====================
+
+template <class TYPE>
+struct IsWinkOutSafe
+    : bsl::integral_constant<
+                 bool,
+                 bsl::is_trivially_copyable<TYPE>::value
+              || bslmf::DetectNestedTrait<TYPE, IsWinkOutSafe>::value> {
+    // This 'struct' template implements a meta-function to determine whether
+    // objects of the (template parameter) 'TYPE' may be abandoned without
+    // being destroyed when every allocator they use has a no-op 'deallocate'
+    // method.  This 'struct' derives from 'bsl::true_type' if 'TYPE' is
+    // trivially copyable or is declared to have the 'bslma::IsWinkOutSafe'
+    // trait using the 'BSLMF_NESTED_TRAIT_DECLARATION' macro, and from
+    // 'bsl::false_type' otherwise.  To support other types, this template
+    // may be specialized to inherit from 'bsl::true_type' for them.
+};
+
+template <class TYPE>
+struct IsWinkOutSafe<const TYPE> : IsWinkOutSafe<TYPE>::type {
+    // Specialization that associates the same trait with 'const TYPE' as with
+    // unqualified 'TYPE'.
+};
+
+template <class TYPE>
+struct IsWinkOutSafe<volatile TYPE> : IsWinkOutSafe<TYPE>::type {
+    // Specialization that associates the same trait with 'volatile TYPE' as
+    // with unqualified 'TYPE'.
+};
+
+template <class TYPE>
+struct IsWinkOutSafe<const volatile TYPE> : IsWinkOutSafe<TYPE>::type {
+    // Specialization that associates the same trait with 'const volatile
+    // TYPE' as with unqualified 'TYPE'.
+};
+
+                            // ==================
+                            // struct WinkOutUtil
+                            // ==================
+
+struct WinkOutUtil {
+    // This 'struct' provides a namespace for utility functions that determine
+    // whether objects held by a container may be winked out.
+
+  private:
+    // PRIVATE CLASS METHODS
+    template <class ALLOCATOR>
+    static bool hasNoOpDeallocate(const ALLOCATOR& allocator, bsl::true_type);
+    template <class ALLOCATOR>
+    static bool hasNoOpDeallocate(const ALLOCATOR& allocator, bsl::false_type);
+        // Return 'true' if the specified 'allocator' is based on a
+        // 'bslma::Allocator' whose 'deallocate' method has no effect, and
+        // 'false' otherwise.  The second argument indicates whether
+        // (template parameter) 'ALLOCATOR' is constructible from a
+        // 'bslma::Allocator *'.
+
+  public:
+    // CLASS METHODS
+    template <class TYPE, class ALLOCATOR>
+    static bool canWinkOut(const ALLOCATOR& allocator);
+        // Return 'true' if objects of the (template parameter) 'TYPE' whose
+        // memory was supplied by the specified 'allocator' may be abandoned
+        // without being destroyed or deallocated, and 'false' otherwise.
+        // This method returns 'true' only if 'TYPE' is 'IsWinkOutSafe' and
+        // 'allocator' is constructible from a 'bslma::Allocator *' and has a
+        // 'mechanism' whose 'hasNoOpDeallocate' method returns 'true'.  Note
+        // that the 'allocator' is not queried unless 'TYPE' is
+        // 'IsWinkOutSafe'.
+};
+
+// ============================================================================
+//                      INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                            // ------------------
+                            // struct WinkOutUtil
+                            // ------------------
+
+// PRIVATE CLASS METHODS
+template <class ALLOCATOR>
+inline
+bool WinkOutUtil::hasNoOpDeallocate(const ALLOCATOR& allocator,
+                                    bsl::true_type)
+{
+    return allocator.mechanism()->hasNoOpDeallocate();
+}
+
+template <class ALLOCATOR>
+inline
+bool WinkOutUtil::hasNoOpDeallocate(const ALLOCATOR&, bsl::false_type)
+{
+    return false;
+}
+
+// CLASS METHODS
+template <class TYPE, class ALLOCATOR>
+inline
+bool WinkOutUtil::canWinkOut(const ALLOCATOR& allocator)
+{
+    typedef typename bsl::is_convertible<Allocator *, ALLOCATOR>::type
+                                                                IsBslmaBased;
+
+    return IsWinkOutSafe<TYPE>::value
+        && hasNoOpDeallocate(allocator, IsBslmaBased());
+}
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,574 @@
+// bslma_winkoututil.t.cpp                                            -*-C++-*-
+
+#include <bslma_winkoututil.h>
+
+#include <bslma_allocator.h>
+#include <bslma_testallocator.h>
+#include <bslmf_assert.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bsls_alignedbuffer.h>
+#include <bsls_alignmentutil.h>
+#include <bsls_bsltestutil.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace BloombergLP;
+using namespace std;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component provides a meta-function, 'bslma::IsWinkOutSafe', that is
+// computed for trivially copyable types and may be associated with other
+// types, and a utility function, 'bslma::WinkOutUtil::canWinkOut', that
+// combines the trait with a query of an allocator.  We verify the trait for
+// a variety of types, then verify 'canWinkOut' for each combination of trait
+// value, allocator type, and 'hasNoOpDeallocate' result, checking that the
+// allocator is queried only when the trait holds.
+// ----------------------------------------------------------------------------
+// [ 1] bslma::IsWinkOutSafe<TYPE>
+// [ 2] bool WinkOutUtil::canWinkOut<TYPE>(const ALLOCATOR& allocator);
+// ----------------------------------------------------------------------------
+// [ 3] USAGE EXAMPLE
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+static int testStatus = 0;
+
+static void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+namespace {
+
+enum Enum { e_VALUE };
+
+struct Trivial {
+    // This 'struct' is declared trivially copyable.
+
+    BSLMF_NESTED_TRAIT_DECLARATION(Trivial, bsl::is_trivially_copyable);
+};
+
+struct NonTrivial {
+    // This 'struct' has no traits.
+
+    ~NonTrivial() {}
+        // Destroy this object.
+};
+
+struct NestedWinkOutSafe {
+    // This 'struct' is declared wink-out safe with a nested trait.
+
+    BSLMF_NESTED_TRAIT_DECLARATION(NestedWinkOutSafe, bslma::IsWinkOutSafe);
+
+    ~NestedWinkOutSafe() {}
+        // Destroy this object.
+};
+
+struct SpecializedWinkOutSafe {
+    // This 'struct' is declared wink-out safe by specializing the trait.
+
+    ~SpecializedWinkOutSafe() {}
+        // Destroy this object.
+};
+
+class QueryCountingAllocator : public bslma::Allocator {
+    // This class provides an allocator whose 'hasNoOpDeallocate' method
+    // returns a value supplied at construction and counts its invocations.
+
+    // DATA
+    bool        d_noOpDeallocate;  // value returned by 'hasNoOpDeallocate'
+    mutable int d_numQueries;      // number of calls to 'hasNoOpDeallocate'
+
+  public:
+    // CREATORS
+    explicit QueryCountingAllocator(bool noOpDeallocate)
+        // Create an allocator whose 'hasNoOpDeallocate' method returns the
+        // specified 'noOpDeallocate'.
+    : d_noOpDeallocate(noOpDeallocate)
+    , d_numQueries(0)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void *allocate(size_type)
+        // Return 0.
+    {
+        return 0;
+    }
+
+    virtual void deallocate(void *)
+        // Do nothing.
+    {
+    }
+
+    // ACCESSORS
+    virtual bool hasNoOpDeallocate() const
+        // Return the value supplied at construction.
+    {
+        ++d_numQueries;
+        return d_noOpDeallocate;
+    }
+
+    int numQueries() const
+        // Return the number of calls to 'hasNoOpDeallocate'.
+    {
+        return d_numQueries;
+    }
+};
+
+template <class TYPE>
+class BslmaBasedAllocator {
+    // This class provides a minimal allocator type that is constructible
+    // from a 'bslma::Allocator *' and provides a 'mechanism' accessor.
+
+    // DATA
+    bslma::Allocator *d_mechanism_p;  // allocator (held, not owned)
+
+  public:
+    // CREATORS
+    BslmaBasedAllocator(bslma::Allocator *mechanism)            // IMPLICIT
+        // Create an allocator that uses the specified 'mechanism'.
+    : d_mechanism_p(mechanism)
+    {
+    }
+
+    // ACCESSORS
+    bslma::Allocator *mechanism() const
+        // Return the allocator used by this allocator.
+    {
+        return d_mechanism_p;
+    }
+};
+
+template <class TYPE>
+class OtherAllocator {
+    // This class provides a minimal allocator type that is not constructible
+    // from a 'bslma::Allocator *'.
+};
+
+}  // close unnamed namespace
+
+namespace BloombergLP {
+namespace bslma {
+
+template <>
+struct IsWinkOutSafe<SpecializedWinkOutSafe> : bsl::true_type {
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+//=============================================================================
+//                              USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+// BDE_VERIFY pragma: push
+// BDE_VERIFY pragma: -FD03  // parameter not documented warning
+
+///Usage
+///-----
+// This section illustrates intended usage of this component.
+//
+///Example 1: Skipping the Destruction of a Node-Based Container
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we implement a simple singly-linked stack whose nodes are supplied
+// by an STL-style allocator wrapping a 'bslma::Allocator'.  When the stack is
+// destroyed, each node must ordinarily be destroyed and returned to the
+// allocator.  If the allocator's 'deallocate' method is a no-op and the
+// elements are wink-out safe, that walk can be skipped entirely.
+//
+// First, we define a minimal allocator type that, like 'bsl::allocator',
+// wraps a 'bslma::Allocator' and provides access to it through a 'mechanism'
+// accessor:
+//..
+    template <class TYPE>
+    class MyAllocator {
+        // This class provides a minimal allocator that supplies memory for
+        // objects of (template parameter) 'TYPE' from a 'bslma::Allocator'.
+//
+        // DATA
+        bslma::Allocator *d_mechanism_p;  // allocator (held, not owned)
+//
+      public:
+        // CREATORS
+        MyAllocator(bslma::Allocator *mechanism)                // IMPLICIT
+            // Create an allocator that uses the specified 'mechanism'.
+        : d_mechanism_p(mechanism)
+        {
+        }
+//
+        // MANIPULATORS
+        TYPE *allocate()
+            // Return uninitialized memory for one 'TYPE' object.
+        {
+            return static_cast<TYPE *>(
+                                    d_mechanism_p->allocate(sizeof(TYPE)));
+        }
+//
+        void deallocate(TYPE *address)
+            // Return the memory at the specified 'address'.
+        {
+            d_mechanism_p->deallocate(address);
+        }
+//
+        // ACCESSORS
+        bslma::Allocator *mechanism() const
+            // Return the allocator used by this allocator.
+        {
+            return d_mechanism_p;
+        }
+    };
+//..
+// Then, we define the stack, whose 'clear' method consults
+// 'bslma::WinkOutUtil::canWinkOut' before walking the nodes:
+//..
+    template <class TYPE>
+    struct MyStackNode {
+        // This 'struct' holds one element of a 'MyStack'.
+//
+        TYPE                d_value;
+        MyStackNode<TYPE>  *d_next_p;
+    };
+//
+    template <class TYPE>
+    class MyStack {
+        // This class provides a stack of 'TYPE' elements.
+//
+        // PRIVATE TYPES
+        typedef MyStackNode<TYPE> Node;
+//
+        // DATA
+        Node              *d_top_p;      // top of the stack
+        MyAllocator<Node>  d_allocator;  // supplies the nodes
+//
+        // NOT IMPLEMENTED
+        MyStack(const MyStack&);
+        MyStack& operator=(const MyStack&);
+//
+      public:
+        // CREATORS
+        explicit MyStack(bslma::Allocator *basicAllocator)
+            // Create an empty stack that uses the specified
+            // 'basicAllocator' to supply memory.
+        : d_top_p(0)
+        , d_allocator(basicAllocator)
+        {
+        }
+//
+        ~MyStack()
+            // Destroy this object.
+        {
+            clear();
+        }
+//
+        // MANIPULATORS
+        void push(const TYPE& value)
+            // Push the specified 'value' onto this stack.
+        {
+            Node *node = d_allocator.allocate();
+            new (&node->d_value) TYPE(value);
+            node->d_next_p = d_top_p;
+            d_top_p = node;
+        }
+//
+        void clear()
+            // Remove all elements from this stack.
+        {
+            if (bslma::WinkOutUtil::canWinkOut<TYPE>(d_allocator)) {
+                d_top_p = 0;
+                return;                                           // RETURN
+            }
+            while (d_top_p) {
+                Node *node = d_top_p;
+                d_top_p = node->d_next_p;
+                node->d_value.~TYPE();
+                d_allocator.deallocate(node);
+            }
+        }
+    };
+//..
+// Next, we define an arena allocator whose 'deallocate' method is a no-op,
+// and which therefore overrides 'hasNoOpDeallocate' to return 'true'.  For
+// brevity, the arena allocates from a fixed buffer:
+//..
+    class MyArenaAllocator : public bslma::Allocator {
+        // This class provides an allocator that supplies memory from a
+        // fixed buffer, and reclaims it only when destroyed.
+//
+        // DATA
+        bsls::AlignedBuffer<1024>  d_buffer;  // memory supplied
+        int                        d_cursor;  // offset of next free byte
+//
+      public:
+        // CREATORS
+        MyArenaAllocator()
+            // Create an arena allocator.
+        : d_cursor(0)
+        {
+        }
+//
+        // MANIPULATORS
+        virtual void *allocate(size_type size)
+            // Return a block of at least the specified 'size' bytes.
+        {
+            const int offset = d_cursor;
+            d_cursor += static_cast<int>(
+                               bsls::AlignmentUtil::roundUpToMaximalAlignment(
+                                                                     size));
+            return d_buffer.buffer() + offset;
+        }
+//
+        virtual void deallocate(void *)
+            // Do nothing.
+        {
+        }
+//
+        // ACCESSORS
+        virtual bool hasNoOpDeallocate() const
+            // Return 'true'.
+        {
+            return true;
+        }
+    };
+//..
+
+// BDE_VERIFY pragma: pop
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose = argc > 2;
+    bool veryVerbose = argc > 3;
+    bool veryVeryVerbose = argc > 4;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 3: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   The usage example provided in the component header file must
+        //   compile, link, and run on all platforms as shown.
+        //
+        // Plan:
+        //   Incorporate usage example from header into driver, remove leading
+        //   comment characters, and replace 'assert' with 'ASSERT'.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Now, we populate two stacks of 'int', one using the arena and the other
+// using a 'bslma::TestAllocator', which does deallocate memory:
+//..
+    MyArenaAllocator     arena;
+    bslma::TestAllocator ta;
+//
+    MyStack<int> arenaStack(&arena);
+    MyStack<int> heapStack(&ta);
+    for (int i = 0; i < 10; ++i) {
+        arenaStack.push(i);
+        heapStack.push(i);
+    }
+//..
+// Finally, we observe that only the stack using the test allocator walks
+// its nodes when cleared:
+//..
+    const MyAllocator<int> arenaAllocator(&arena);
+    const MyAllocator<int> heapAllocator(&ta);
+//
+    ASSERT(true  == bslma::WinkOutUtil::canWinkOut<int>(arenaAllocator));
+    ASSERT(false == bslma::WinkOutUtil::canWinkOut<int>(heapAllocator));
+//
+    arenaStack.clear();
+    heapStack.clear();
+    ASSERT(0 == ta.numBlocksInUse());
+//..
+
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // 'canWinkOut'
+        //
+        // Concerns:
+        //: 1 'canWinkOut' returns 'true' if and only if the type is wink-out
+        //:   safe, the allocator is 'bslma'-based, and the allocator's
+        //:   mechanism reports a no-op 'deallocate'.
+        //:
+        //: 2 The mechanism is not queried unless the type is wink-out safe.
+        //:
+        //: 3 Allocator types that are not 'bslma'-based are accepted and
+        //:   never allow winking out.
+        //
+        // Plan:
+        //: 1 Create two 'QueryCountingAllocator' objects, one reporting a
+        //:   no-op 'deallocate' and one not.  For each, invoke 'canWinkOut'
+        //:   with wink-out-safe and non-wink-out-safe types through a
+        //:   'bslma'-based allocator type, and verify the result and the
+        //:   number of queries.  (C-1,2)
+        //:
+        //: 2 Invoke 'canWinkOut' with an allocator type that is not
+        //:   'bslma'-based, and verify that it returns 'false'.  (C-3)
+        //
+        // Testing:
+        //   bool WinkOutUtil::canWinkOut<TYPE>(const ALLOCATOR& allocator);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'canWinkOut'"
+                            "\n============\n");
+
+        typedef bslma::WinkOutUtil Util;
+
+        if (verbose) printf("\nTesting 'bslma'-based allocators.\n");
+        {
+            QueryCountingAllocator noOpMechanism(true);
+            QueryCountingAllocator mechanism(false);
+
+            const BslmaBasedAllocator<int> NO_OP_ALLOC(&noOpMechanism);
+            const BslmaBasedAllocator<int> ALLOC(&mechanism);
+
+            ASSERT(true  == Util::canWinkOut<int>(NO_OP_ALLOC));
+            ASSERT(1     == noOpMechanism.numQueries());
+            ASSERT(true  == Util::canWinkOut<NestedWinkOutSafe>(NO_OP_ALLOC));
+            ASSERT(2     == noOpMechanism.numQueries());
+            ASSERT(false == Util::canWinkOut<NonTrivial>(NO_OP_ALLOC));
+            ASSERT(2     == noOpMechanism.numQueries());
+
+            ASSERT(false == Util::canWinkOut<int>(ALLOC));
+            ASSERT(1     == mechanism.numQueries());
+            ASSERT(false == Util::canWinkOut<NestedWinkOutSafe>(ALLOC));
+            ASSERT(2     == mechanism.numQueries());
+            ASSERT(false == Util::canWinkOut<NonTrivial>(ALLOC));
+            ASSERT(2     == mechanism.numQueries());
+        }
+
+        if (verbose) printf("\nTesting other allocators.\n");
+        {
+            const OtherAllocator<int> ALLOC = OtherAllocator<int>();
+
+            ASSERT(false == Util::canWinkOut<int>(ALLOC));
+            ASSERT(false == Util::canWinkOut<NestedWinkOutSafe>(ALLOC));
+            ASSERT(false == Util::canWinkOut<NonTrivial>(ALLOC));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // 'IsWinkOutSafe'
+        //
+        // Concerns:
+        //: 1 The trait is 'true' for fundamental, enumerated, and pointer
+        //:   types, and for types declared trivially copyable.
+        //:
+        //: 2 The trait is 'true' for types declaring the trait with
+        //:   'BSLMF_NESTED_TRAIT_DECLARATION' or by specialization.
+        //:
+        //: 3 The trait is 'false' for other class types.
+        //:
+        //: 4 The trait ignores cv-qualification.
+        //
+        // Plan:
+        //: 1 Verify the value of the trait for a representative type of each
+        //:   category, with and without cv-qualification, using
+        //:   'BSLMF_ASSERT'.  (C-1..4)
+        //
+        // Testing:
+        //   bslma::IsWinkOutSafe<TYPE>
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'IsWinkOutSafe'"
+                            "\n===============\n");
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<int>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<const int>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<double>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<Enum>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<char *>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<const void *>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<Trivial>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<const Trivial>::value);
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<NestedWinkOutSafe>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<const NestedWinkOutSafe>::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<SpecializedWinkOutSafe>::value);
+        BSLMF_ASSERT(bslma::IsWinkOutSafe<
+                                   volatile SpecializedWinkOutSafe>::value);
+
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<NonTrivial>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<const NonTrivial>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<bslma::TestAllocator>::value);
+
+        ASSERT(true == bslma::IsWinkOutSafe<int>::value);
+        ASSERT(false == bslma::IsWinkOutSafe<NonTrivial>::value);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,53 @@
+// bsls_bslthreadspecific.cpp                                         -*-C++-*-
+#include <bsls_bslthreadspecific.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_bslexceptionutil.h>
+
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+
+namespace BloombergLP {
+namespace bsls {
+
+                          // -----------------------
+                          // class BslThreadSpecific
+                          // -----------------------
+
+// CREATORS
+BslThreadSpecific::BslThreadSpecific(BslThreadSpecificDestructor destructor)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    (void)destructor;
+
+    d_key = TlsAlloc();
+    if (TLS_OUT_OF_INDEXES == d_key) {
+        BslExceptionUtil::throwBadAlloc();
+    }
+#else
+    if (0 != pthread_key_create(&d_key, destructor)) {
+        BslExceptionUtil::throwBadAlloc();
+    }
+#endif
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
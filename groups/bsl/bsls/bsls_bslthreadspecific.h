@@ -0,0 +1,233 @@
+// bsls_bslthreadspecific.h                                           -*-C++-*-
+#ifndef INCLUDED_BSLS_BSLTHREADSPECIFIC
+#define INCLUDED_BSLS_BSLTHREADSPECIFIC
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a platform-independent thread-specific key for use below
+//          'bslmt'.
+//
+//@CLASSES:
+//  bsls::BslThreadSpecific: wrapper of an OS-level thread-specific storage key
+//
+//@SEE_ALSO: bsls_bsllock
+//
+//@DESCRIPTION: This component provides a light-weight, portable wrapper of an
+// OS-level thread-specific storage key, 'bsls::BslThreadSpecific', for use by
+// low-level components (such as memory allocators) that cannot depend on
+// 'bslmt'.  Each 'bsls::BslThreadSpecific' object owns one key; every thread
+// sees its own 'void *' value for that key, which is initially 0.  The
+// 'setValue' method stores a value for the calling thread, and the 'value'
+// method retrieves it.
+//
+// An optional destructor function may be supplied at construction.  On POSIX
+// platforms, when a thread that stored a non-zero value for the key exits,
+// the destructor is invoked (on the exiting thread) with that value.  The
+// destructor is *not* invoked for the thread that destroys the key object, nor
+// for any thread that exits after the key object has been destroyed.  On
+// Windows the destructor is never invoked; objects that associate
+// thread-specific resources with a key must therefore be able to reclaim
+// those resources when the key object itself is destroyed.
+//
+// Note that the number of keys available to a process is limited by the
+// operating system (e.g., 'PTHREAD_KEYS_MAX'), so a key should be associated
+// with a long-lived object and not created on a per-operation basis.  Also
+// note that 'bsls::BslThreadSpecific' is *not* intended for direct use by
+// client code; it is meant for internal use only.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Maintaining a Per-Thread Counter
+///- - - - - - - - - - - - - - - - - - - - - -
+// In this example we use a 'bsls::BslThreadSpecific' key to give each thread
+// its own lazily-created counter without any locking on the fast path.
+//
+// First, we define a function that returns the counter of the calling thread,
+// creating it on first use:
+//..
+//  int *threadCounter(bsls::BslThreadSpecific *key)
+//  {
+//      int *counter = static_cast<int *>(key->value());
+//      if (!counter) {
+//          counter = new int(0);
+//          key->setValue(counter);
+//      }
+//      return counter;
+//  }
+//..
+// Then, we create the key, supplying a destructor that reclaims the counter of
+// each thread that exits:
+//..
+//  extern "C" void deleteCounter(void *counter)
+//  {
+//      delete static_cast<int *>(counter);
+//  }
+//
+//  bsls::BslThreadSpecific key(&deleteCounter);
+//..
+// Finally, we use the counter of the current thread:
+//..
+//  ++*threadCounter(&key);
+//  ++*threadCounter(&key);
+//  assert(2 == *threadCounter(&key));
+//
+//  delete threadCounter(&key);
+//  key.setValue(0);
+//..
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+#ifndef INCLUDED_WTYPES
+#include <wtypes.h>
+#define INCLUDED_WTYPES
+#endif
+
+#ifndef INCLUDED_WINBASE
+#include <winbase.h>
+#define INCLUDED_WINBASE
+#endif
+
+#else
+
+#ifndef INCLUDED_PTHREAD
+#include <pthread.h>
+#define INCLUDED_PTHREAD
+#endif
+
+#endif
+
+namespace BloombergLP {
+namespace bsls {
+
+extern "C" {
+typedef void (*BslThreadSpecificDestructor)(void *);
+    // Alias for the type of function invoked with the (non-zero) value of a
+    // thread-specific key when a thread exits.
+}
+
+                          // =======================
+                          // class BslThreadSpecific
+                          // =======================
+
+class BslThreadSpecific {
+    // This 'class' implements a light-weight, portable wrapper of an OS-level
+    // thread-specific storage key.  Note that 'BslThreadSpecific' is *not*
+    // intended for direct use by client code; it is meant for internal use
+    // only.
+
+    // DATA
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    DWORD         d_key;  // Windows TLS index
+#else
+    pthread_key_t d_key;  // pthreads key
+#endif
+
+  private:
+    // NOT IMPLEMENTED
+    BslThreadSpecific(const BslThreadSpecific&);             // = delete
+    BslThreadSpecific& operator=(const BslThreadSpecific&);  // = delete
+
+  public:
+    // CREATORS
+    explicit
+    BslThreadSpecific(BslThreadSpecificDestructor destructor = 0);
+        // Create a thread-specific key whose value is 0 for every thread.
+        // Optionally specify a 'destructor' to be invoked, on POSIX
+        // platforms, with the non-zero value of this key of each thread that
+        // exits while this object exists.  If the operating system cannot
+        // supply another key, throw 'std::bad_alloc' in an exception-enabled
+        // build, or else abort the program.
+
+    ~BslThreadSpecific();
+        // Destroy this key.  The destructor supplied at construction (if any)
+        // is *not* invoked for any value still associated with this key.
+
+    // MANIPULATORS
+    void setValue(void *value);
+        // Associate the specified 'value' with this key for the calling
+        // thread.
+
+    // ACCESSORS
+    void *value() const;
+        // Return the value associated with this key for the calling thread,
+        // or 0 if 'setValue' has not been called by this thread.
+};
+
+// ============================================================================
+//                        INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                          // -----------------------
+                          // class BslThreadSpecific
+                          // -----------------------
+
+// CREATORS
+inline
+BslThreadSpecific::~BslThreadSpecific()
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    TlsFree(d_key);
+#else
+    const int status = pthread_key_delete(d_key);
+    (void)status;
+    BSLS_ASSERT_SAFE(0 == status);
+#endif
+}
+
+// MANIPULATORS
+inline
+void BslThreadSpecific::setValue(void *value)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    TlsSetValue(d_key, value);
+#else
+    const int status = pthread_setspecific(d_key, value);
+    (void)status;
+    BSLS_ASSERT_SAFE(0 == status);
+#endif
+}
+
+// ACCESSORS
+inline
+void *BslThreadSpecific::value() const
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return TlsGetValue(d_key);
+#else
+    return pthread_getspecific(d_key);
+#endif
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
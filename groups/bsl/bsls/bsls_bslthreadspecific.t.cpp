@@ -0,0 +1,384 @@
+// bsls_bslthreadspecific.t.cpp                                       -*-C++-*-
+#include <bsls_bslthreadspecific.h>
+
+#include <bsls_atomic.h>         // for testing only
+#include <bsls_bsltestutil.h>    // for testing only
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace BloombergLP;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// We are testing a wrapper of a platform-specific thread-specific storage
+// key.  The concerns are that each thread observes its own value for a key,
+// that distinct keys are independent, and that (on POSIX platforms) the
+// destructor supplied at construction is invoked with the non-zero value of
+// each exiting thread.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 1] BslThreadSpecific(BslThreadSpecificDestructor destructor = 0);
+// [ 1] ~BslThreadSpecific();
+//
+// MANIPULATORS
+// [ 1] void setValue(void *value);
+//
+// ACCESSORS
+// [ 1] void *value() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 2] CONCERN: Each thread observes its own value.
+// [ 2] CONCERN: The destructor is invoked at thread exit (POSIX only).
+// [ 3] USAGE EXAMPLE
+
+// ============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+// ----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsls::BslThreadSpecific Obj;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+typedef HANDLE    ThreadId;
+#else
+typedef pthread_t ThreadId;
+#endif
+
+typedef void *(*ThreadFunction)(void *arg);
+
+// ============================================================================
+//                  HELPER CLASSES AND FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+ThreadId createThread(ThreadFunction func, void *arg)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return CreateThread(0, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, 0);
+#else
+    ThreadId id;
+    pthread_create(&id, 0, func, arg);
+    return id;
+#endif
+}
+
+static
+void joinThread(ThreadId id)
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+#else
+    pthread_join(id, 0);
+#endif
+}
+
+                                // ------
+                                // case 2
+                                // ------
+
+static bsls::AtomicInt numDestroyed(0);
+static bsls::AtomicInt destroyedSum(0);
+
+extern "C" void countingDestructor(void *value)
+    // Record that the specified 'value' was passed to a key destructor.
+{
+    ++numDestroyed;
+    destroyedSum += static_cast<int>(reinterpret_cast<bsls::Types::IntPtr>(
+                                                                      value));
+}
+
+struct ThreadInfo {
+    Obj             *d_key_p;
+    int              d_id;
+    bsls::AtomicInt  d_errors;
+};
+
+extern "C" void *threadFunction(void *arg)
+{
+    ThreadInfo *info = static_cast<ThreadInfo *>(arg);
+
+    if (0 != info->d_key_p->value()) {
+        ++info->d_errors;
+    }
+
+    void *mine = reinterpret_cast<void *>(
+                                 static_cast<bsls::Types::IntPtr>(info->d_id));
+    info->d_key_p->setValue(mine);
+
+    for (int i = 0; i < 1000; ++i) {
+        if (mine != info->d_key_p->value()) {
+            ++info->d_errors;
+        }
+    }
+    return arg;
+}
+
+// ============================================================================
+//                                USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Maintaining a Per-Thread Counter
+///- - - - - - - - - - - - - - - - - - - - - -
+// In this example we use a 'bsls::BslThreadSpecific' key to give each thread
+// its own lazily-created counter without any locking on the fast path.
+//
+// First, we define a function that returns the counter of the calling thread,
+// creating it on first use:
+//..
+    int *threadCounter(bsls::BslThreadSpecific *key)
+    {
+        int *counter = static_cast<int *>(key->value());
+        if (!counter) {
+            counter = new int(0);
+            key->setValue(counter);
+        }
+        return counter;
+    }
+//..
+// Then, we create the key, supplying a destructor that reclaims the counter of
+// each thread that exits:
+//..
+    extern "C" void deleteCounter(void *counter)
+    {
+        delete static_cast<int *>(counter);
+    }
+//..
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+    int veryVerbose = argc > 3;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 3: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+        bsls::BslThreadSpecific key(&deleteCounter);
+//..
+// Finally, we use the counter of the current thread:
+//..
+        ++*threadCounter(&key);
+        ++*threadCounter(&key);
+        ASSERT(2 == *threadCounter(&key));
+
+        delete threadCounter(&key);
+        key.setValue(0);
+//..
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // MULTIPLE THREADS
+        //   Ensure that each thread has its own value, and that the
+        //   destructor is invoked at thread exit.
+        //
+        // Concerns:
+        //: 1 A newly-created thread observes the value 0.
+        //:
+        //: 2 The value set by one thread is not observed by another thread.
+        //:
+        //: 3 On POSIX platforms, the destructor is invoked exactly once with
+        //:   the non-zero value of each exiting thread, and is not invoked
+        //:   for the value of the thread that destroys the key.
+        //
+        // Plan:
+        //: 1 Set a value for the main thread, then create several threads
+        //:   that each verify that the initial value is 0, set a unique value,
+        //:   and verify that they repeatedly observe that value.  After
+        //:   joining the threads, verify that the main thread still observes
+        //:   its value, and that the destructor was invoked for each child
+        //:   thread's value.  (C-1..3)
+        //
+        // Testing:
+        //   CONCERN: Each thread observes its own value.
+        //   CONCERN: The destructor is invoked at thread exit (POSIX only).
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nMULTIPLE THREADS"
+                            "\n================\n");
+
+        enum { NUM_THREADS = 8 };
+
+        {
+            Obj mX(&countingDestructor);
+
+            int mainValue = 0;
+            mX.setValue(&mainValue);
+
+            ThreadInfo info[NUM_THREADS];
+            ThreadId   ids[NUM_THREADS];
+
+            int expectedSum = 0;
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                info[i].d_key_p  = &mX;
+                info[i].d_id     = i + 1;
+                info[i].d_errors = 0;
+                expectedSum     += i + 1;
+                ids[i] = createThread(&threadFunction, &info[i]);
+            }
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                joinThread(ids[i]);
+                LOOP_ASSERT(i, 0 == info[i].d_errors);
+            }
+
+            ASSERT(&mainValue == mX.value());
+
+            if (veryVerbose) { P_(numDestroyed) P(destroyedSum) }
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+            ASSERT(NUM_THREADS == numDestroyed);
+            ASSERT(expectedSum == destroyedSum);
+#endif
+        }
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+        ASSERT(NUM_THREADS == numDestroyed);
+#endif
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 A newly-created key has the value 0.
+        //:
+        //: 2 'value' returns the most recent value passed to 'setValue'.
+        //:
+        //: 3 Distinct keys hold independent values.
+        //
+        // Plan:
+        //: 1 Create two keys and verify their initial values.  Set and reset
+        //:   the values of each key, verifying the values of both keys after
+        //:   each change.  (C-1..3)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   BslThreadSpecific(BslThreadSpecificDestructor destructor = 0);
+        //   ~BslThreadSpecific();
+        //   void setValue(void *value);
+        //   void *value() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        int a = 1;
+        int b = 2;
+
+        Obj mX;  const Obj& X = mX;
+        Obj mY;  const Obj& Y = mY;
+
+        ASSERT(0 == X.value());
+        ASSERT(0 == Y.value());
+
+        mX.setValue(&a);
+        ASSERT(&a == X.value());
+        ASSERT(0  == Y.value());
+
+        mY.setValue(&b);
+        ASSERT(&a == X.value());
+        ASSERT(&b == Y.value());
+
+        mX.setValue(0);
+        ASSERT(0  == X.value());
+        ASSERT(&b == Y.value());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2015 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
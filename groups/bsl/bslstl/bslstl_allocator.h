@@ -166,7 +166,7 @@ BSLS_IDENT("$Id: $")
 //
 //      // Default construct each element of the array:
 //      for (int i = 0; i < d_length; ++i) {
-//          d_allocator.construct(&d_array[i], T());
+//          new (static_cast<void *>(&d_array[i])) T();
 //      }
 //  }
 //
@@ -180,7 +180,7 @@ BSLS_IDENT("$Id: $")
 //
 //      // copy construct each element of the array:
 //      for (int i = 0; i < d_length; ++i) {
-//          d_allocator.construct(&d_array[i], original.d_array[i]);
+//          new (static_cast<void *>(&d_array[i])) T(original.d_array[i]);
 //      }
 //  }
 //
@@ -189,7 +189,7 @@ BSLS_IDENT("$Id: $")
 //  {
 //      // Call destructor for each element
 //      for (int i = 0; i < d_length; ++i) {
-//          d_allocator.destroy(&d_array[i]);
+//          d_array[i].~T();
 //      }
 //
 //      // Return memory to allocator.
@@ -512,9 +512,11 @@ class allocator {
 
     void deallocate(pointer p, size_type n = 1);
         // Return memory previously allocated with 'allocate' to the underlying
-        // mechanism object by calling 'deallocate' on the the mechanism
-        // object with the specified 'p'.  The optionally specified 'n'
-        // argument is ignored by this allocator type.
+        // mechanism object by calling 'deallocateSized' on the the mechanism
+        // object with the specified 'p' and the size (in bytes) of the
+        // optionally specified 'n' objects of (template parameter) 'TYPE'.
+        // The behavior is undefined unless 'p' was returned by a call to
+        // 'allocate(n)' on an allocator that compares equal to this one.
 
 #if 0
     void construct(pointer p, const TYPE& val);
@@ -743,8 +745,7 @@ inline
 void allocator<TYPE>::deallocate(typename allocator::pointer   p,
                                  typename allocator::size_type n)
 {
-    (void) n;  // suppress unsued parameter warning
-    d_mechanism->deallocate(p);
+    d_mechanism->deallocateSized(p, n * sizeof(TYPE));
 }
 
 #if 0
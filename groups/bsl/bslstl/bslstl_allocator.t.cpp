@@ -53,7 +53,7 @@ using namespace BloombergLP;
 // Modifiers
 // [  ] allocator& operator=(const allocator& rhs);
 // [  ] pointer allocate(size_type n, const void *hint = 0);
-// [  ] void deallocate(pointer p, size_type n = 1);
+// [ 6] void deallocate(pointer p, size_type n = 1);
 // [  ] void construct(pointer p, const TYPE& val);
 // [  ] void destroy(pointer p);
 //
@@ -83,7 +83,7 @@ using namespace BloombergLP;
 // [  ] bool operator!=(bsl::allocator<T>,  bslma::Allocator*);
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 6] USAGE EXAMPLE
+// [ 7] USAGE EXAMPLE
 // [ 2] bsl::is_trivially_copyable<bsl::allocator>
 // [ 2] bslmf::IsBitwiseEqualityComparable<sl::allocator>
 // [ 2] bslmf::IsBitwiseMoveable<bsl::allocator>
@@ -162,6 +162,44 @@ enum { VERBOSE_ARG_NUM = 2, VERY_VERBOSE_ARG_NUM, VERY_VERY_VERBOSE_ARG_NUM };
 //                  GLOBAL HELPER FUNCTIONS FOR TESTING
 //-----------------------------------------------------------------------------
 
+                      // ================================
+                      // class SizeRecordingTestAllocator
+                      // ================================
+
+class SizeRecordingTestAllocator : public bslma::TestAllocator {
+    // This test allocator records the arguments of the most recent call to
+    // 'deallocateSized', and counts the calls to 'deallocateSized'.
+
+    // DATA
+    void      *d_lastAddress_p;  // address of last sized deallocation
+    size_type  d_lastSize;       // size of last sized deallocation
+    int        d_numSized;       // number of calls to 'deallocateSized'
+
+  public:
+    // CREATORS
+    explicit SizeRecordingTestAllocator(bool verboseFlag = false)
+    : bslma::TestAllocator(verboseFlag)
+    , d_lastAddress_p(0)
+    , d_lastSize(0)
+    , d_numSized(0)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void deallocateSized(void *address, size_type size)
+    {
+        d_lastAddress_p = address;
+        d_lastSize      = size;
+        ++d_numSized;
+        bslma::TestAllocator::deallocateSized(address, size);
+    }
+
+    // ACCESSORS
+    void *lastAddress() const { return d_lastAddress_p; }
+    size_type lastSize() const { return d_lastSize; }
+    int numSized() const { return d_numSized; }
+};
+
 //=============================================================================
 //                            USAGE EXAMPLE
 //-----------------------------------------------------------------------------
@@ -280,7 +318,7 @@ enum { VERBOSE_ARG_NUM = 2, VERY_VERBOSE_ARG_NUM, VERY_VERY_VERBOSE_ARG_NUM };
 
         // Default construct each element of the array:
         for (int i = 0; i < d_length; ++i) {
-            d_allocator.construct(&d_array[i], TYPE());
+            new (static_cast<void *>(&d_array[i])) TYPE();
         }
     }
 
@@ -294,7 +332,7 @@ enum { VERBOSE_ARG_NUM = 2, VERY_VERBOSE_ARG_NUM, VERY_VERY_VERBOSE_ARG_NUM };
 
         // copy construct each element of the array:
         for (int i = 0; i < d_length; ++i) {
-            d_allocator.construct(&d_array[i], original.d_array[i]);
+            new (static_cast<void *>(&d_array[i])) TYPE(original.d_array[i]);
         }
     }
 
@@ -303,7 +341,7 @@ enum { VERBOSE_ARG_NUM = 2, VERY_VERBOSE_ARG_NUM, VERY_VERY_VERBOSE_ARG_NUM };
     {
         // Call destructor for each element
         for (int i = 0; i < d_length; ++i) {
-            d_allocator.destroy(&d_array[i]);
+            d_array[i].~TYPE();
         }
 
         // Return memory to allocator.
@@ -494,7 +532,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 6: {
+      case 7: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -516,6 +554,69 @@ int main(int argc, char *argv[])
 
         usageExample();
 
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'deallocate'
+        //
+        // Concerns:
+        //   o that 'deallocate' returns memory to the mechanism.
+        //   o that the mechanism is told the size (in bytes) of the block,
+        //     i.e., 'n * sizeof(TYPE)', through 'deallocateSized'.
+        //   o that the size is correct for rebound allocators.
+        //
+        // Plan:  Allocate arrays of several lengths of 'int' and 'MyObject'
+        //   from a 'bsl::allocator' holding a test allocator that records the
+        //   arguments of 'deallocateSized'.  Deallocate each array and verify
+        //   the recorded address and size, and that no memory is in use.
+        //
+        // Testing:
+        //   void deallocate(pointer p, size_type n = 1);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'deallocate'"
+                            "\n====================\n");
+
+        SizeRecordingTestAllocator ta(veryVeryVeryVerbose);
+
+        bsl::allocator<int>      ai(&ta);
+        bsl::allocator<MyObject> ao(ai);
+
+        const int LENGTHS[]   = { 1, 2, 5, 16, 100 };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        for (int i = 0; i < NUM_LENGTHS; ++i) {
+            const int N = LENGTHS[i];
+
+            int *pi = ai.allocate(N);
+            ASSERTV(N, pi);
+
+            ai.deallocate(pi, N);
+            ASSERTV(N, 2 * i + 1 == ta.numSized());
+            ASSERTV(N, pi == ta.lastAddress());
+            ASSERTV(N, N * sizeof(int) == ta.lastSize());
+
+            MyObject *po = ao.allocate(N);
+            ASSERTV(N, po);
+
+            ao.deallocate(po, N);
+            ASSERTV(N, 2 * i + 2 == ta.numSized());
+            ASSERTV(N, po == ta.lastAddress());
+            ASSERTV(N, N * sizeof(MyObject) == ta.lastSize());
+
+            ASSERTV(N, 0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) printf("\nTesting the default 'n'.\n");
+        {
+            MyObject *po = ao.allocate(1);
+
+            ao.deallocate(po);
+            ASSERT(po == ta.lastAddress());
+            ASSERT(sizeof(MyObject) == ta.lastSize());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
       } break;
       case 5: {
         // --------------------------------------------------------------------
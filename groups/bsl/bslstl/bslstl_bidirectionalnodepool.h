@@ -198,10 +198,22 @@ BSLS_IDENT("$Id: $")
 #include <bslalg_bidirectionalnode.h>
 #endif
 
+#ifndef INCLUDED_BSLALG_HASHTABLEANCHOR
+#include <bslalg_hashtableanchor.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_HASHTABLEBUCKET
+#include <bslalg_hashtablebucket.h>
+#endif
+
 #ifndef INCLUDED_BSLMA_DEALLOCATORPROCTOR
 #include <bslma_deallocatorproctor.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
 #include <bslmf_isbitwisemoveable.h>
 #endif
@@ -214,6 +226,11 @@ BSLS_IDENT("$Id: $")
 #include <bsls_util.h>
 #endif
 
+#ifndef INCLUDED_CSTRING
+#include <cstring>
+#define INCLUDED_CSTRING
+#endif
+
 namespace BloombergLP {
 namespace bslstl {
 
@@ -234,6 +251,41 @@ class BidirectionalNodePool {
         // This 'typedef' is an alias for the allocator traits defined by
         // 'SimplePool'.
 
+    class ListProctor {
+        // This class implements a proctor that, unless its 'release' method
+        // has been invoked, deletes the nodes of a null-terminated list,
+        // linked by their 'nextLink' attributes, upon destruction.
+
+        // DATA
+        BidirectionalNodePool     *d_nodePool_p;  // pool owning the nodes
+                                                  // (held, not owned)
+
+        bslalg::BidirectionalLink *d_first_p;     // first node in the list,
+                                                  // or 0
+
+      private:
+        // NOT IMPLEMENTED
+        ListProctor& operator=(const ListProctor&);
+        ListProctor(const ListProctor&);
+
+      public:
+        // CREATORS
+        explicit ListProctor(BidirectionalNodePool *nodePool);
+            // Create a proctor managing no list, that will delete nodes by
+            // calling 'deleteNodes' on the specified 'nodePool'.
+
+        ~ListProctor();
+            // Delete the nodes of the managed list, if any.
+
+        // MANIPULATORS
+        void manage(bslalg::BidirectionalLink *first);
+            // Manage the list starting at the specified 'first' node.
+
+        void release();
+            // Release from management the list currently managed by this
+            // proctor, if any.
+    };
+
     // DATA
     Pool d_pool;  // pool for allocating memory
 
@@ -242,6 +294,20 @@ class BidirectionalNodePool {
     BidirectionalNodePool& operator=(const BidirectionalNodePool&);
     BidirectionalNodePool(const BidirectionalNodePool&);
 
+    // PRIVATE MANIPULATORS
+    bslalg::BidirectionalLink *relocateNode(
+                                     const bslalg::BidirectionalLink& original,
+                                     bsl::true_type);
+    bslalg::BidirectionalLink *relocateNode(
+                                     const bslalg::BidirectionalLink& original,
+                                     bsl::false_type);
+        // Allocate a node of the type 'BidirectionalNode<VALUE>' having the
+        // 'value' attribute of the specified 'original'.  The first overload,
+        // used when 'VALUE' is bitwise moveable, copies the bytes of the
+        // value, after which the value of 'original' must not be destroyed;
+        // the second copy-constructs the value.  The behavior is undefined
+        // unless 'original' refers to a 'bslalg::BidirectionalNode<VALUE>'.
+
   public:
     // PUBLIC TYPE
     typedef typename Pool::AllocatorType AllocatorType;
@@ -316,11 +382,42 @@ class BidirectionalNodePool {
         // The behavior is undefined unless 'node' refers to a
         // 'bslalg::BidirectionalNode<VALUE>' that was allocated by this pool.
 
+    void deleteNodes(bslalg::BidirectionalLink *first);
+        // Destroy the 'VALUE' attribute of each node in the null-terminated
+        // list of nodes, linked by their 'nextLink' attributes, that starts at
+        // the specified 'first' node, and return the memory footprints of all
+        // of those nodes to this pool in a single batch.  The behavior is
+        // undefined unless 'first' is non-zero and each node in the list
+        // refers to a 'bslalg::BidirectionalNode<VALUE>' that was allocated
+        // by this pool.
+
+    void compact(bslalg::HashTableAnchor *anchor);
+        // Re-allocate the nodes of the list rooted at the specified 'anchor',
+        // in order, from a single newly-obtained chunk of memory, redirect
+        // the buckets of 'anchor' to the new nodes, and then release all of
+        // the memory previously held by this pool.  The 'value' attribute of
+        // each node is moved with 'memcpy' if 'VALUE' is bitwise moveable,
+        // and is copied (then destroyed) otherwise.  If an exception is
+        // thrown, 'anchor' and this pool are unchanged.  The behavior is
+        // undefined unless each node in the list refers to a
+        // 'bslalg::BidirectionalNode<VALUE>' allocated by this pool, each
+        // non-empty bucket of 'anchor' refers to nodes in the list, and no
+        // other node allocated by this pool is in use.  Note that traversing
+        // the list subsequently visits nodes in increasing address order.
+
     void reserveNodes(size_type numNodes);
         // Reserve memory from this pool to satisfy memory requests for at
         // least the specified 'numNodes' before the pool replenishes.  The
         // behavior is undefined unless '0 < numNodes'.
 
+    void reserveNodeCapacity(size_type numNodes);
+        // Ensure that memory requests for at least the specified 'numNodes'
+        // can be satisfied from this pool before it replenishes, obtaining
+        // the shortfall, if any, from the allocator in a single request.  The
+        // behavior is undefined unless '0 < numNodes'.  Note that, unlike
+        // 'reserveNodes', the footprints of previously deleted nodes count
+        // towards 'numNodes'.
+
     void swapRetainAllocators(BidirectionalNodePool& other);
         // Efficiently exchange the nodes of this object with those of the
         // specified 'other' object.  This method provides the no-throw
@@ -338,6 +435,13 @@ class BidirectionalNodePool {
     const AllocatorType& allocator() const;
         // Return a reference providing non-modifiable access to the allocator
         // supplying memory for the memory pool maintained by this object.
+
+    bool canWinkOutNodes() const;
+        // Return 'true' if the nodes allocated by this pool may be abandoned
+        // without destroying their values or returning them to this pool,
+        // because 'VALUE' is wink-out safe and the allocator of this pool has
+        // a no-op 'deallocate' (see 'bslma_winkoututil'), and 'false'
+        // otherwise.  Note that abandoned nodes are not available for reuse.
 };
 
 // FREE FUNCTIONS
@@ -374,6 +478,77 @@ struct IsBitwiseMoveable<bslstl::BidirectionalNodePool<VALUE, ALLOCATOR> >
 
 namespace bslstl {
 
+         // ----------------------------------------------------------
+         // class BidirectionalNodePool<VALUE, ALLOCATOR>::ListProctor
+         // ----------------------------------------------------------
+
+// CREATORS
+template <class VALUE, class ALLOCATOR>
+inline
+BidirectionalNodePool<VALUE, ALLOCATOR>::ListProctor::ListProctor(
+                                           BidirectionalNodePool *nodePool)
+: d_nodePool_p(nodePool)
+, d_first_p(0)
+{
+}
+
+template <class VALUE, class ALLOCATOR>
+inline
+BidirectionalNodePool<VALUE, ALLOCATOR>::ListProctor::~ListProctor()
+{
+    if (d_first_p) {
+        d_nodePool_p->deleteNodes(d_first_p);
+    }
+}
+
+// MANIPULATORS
+template <class VALUE, class ALLOCATOR>
+inline
+void BidirectionalNodePool<VALUE, ALLOCATOR>::ListProctor::manage(
+                                              bslalg::BidirectionalLink *first)
+{
+    d_first_p = first;
+}
+
+template <class VALUE, class ALLOCATOR>
+inline
+void BidirectionalNodePool<VALUE, ALLOCATOR>::ListProctor::release()
+{
+    d_first_p = 0;
+}
+
+                       // ---------------------------
+                       // class BidirectionalNodePool
+                       // ---------------------------
+
+// PRIVATE MANIPULATORS
+template <class VALUE, class ALLOCATOR>
+inline
+bslalg::BidirectionalLink *
+BidirectionalNodePool<VALUE, ALLOCATOR>::relocateNode(
+                                     const bslalg::BidirectionalLink& original,
+                                     bsl::true_type)
+{
+    bslalg::BidirectionalNode<VALUE> *node = d_pool.allocate();
+
+    std::memcpy(static_cast<void *>(bsls::Util::addressOf(node->value())),
+                bsls::Util::addressOf(
+                    static_cast<const bslalg::BidirectionalNode<VALUE>&>(
+                                                           original).value()),
+                sizeof(VALUE));
+    return node;
+}
+
+template <class VALUE, class ALLOCATOR>
+inline
+bslalg::BidirectionalLink *
+BidirectionalNodePool<VALUE, ALLOCATOR>::relocateNode(
+                                     const bslalg::BidirectionalLink& original,
+                                     bsl::false_type)
+{
+    return cloneNode(original);
+}
+
 // CREATORS
 template <class VALUE, class ALLOCATOR>
 inline
@@ -466,6 +641,107 @@ void BidirectionalNodePool<VALUE, ALLOCATOR>::deleteNode(
     d_pool.deallocate(node);
 }
 
+template <class VALUE, class ALLOCATOR>
+void BidirectionalNodePool<VALUE, ALLOCATOR>::deleteNodes(
+                                              bslalg::BidirectionalLink *first)
+{
+    BSLS_ASSERT(first);
+
+    typedef bslalg::BidirectionalNode<VALUE> Node;
+
+    // Link the footprints into a chain through their first words, as
+    // expected by 'SimplePool::deallocateN'.
+
+    Node                      *last;
+    bslalg::BidirectionalLink *link = first;
+    do {
+        last = static_cast<Node *>(link);
+        link = link->nextLink();
+
+        AllocatorTraits::destroy(allocator(),
+                                 bsls::Util::addressOf(last->value()));
+        *reinterpret_cast<void **>(last) = static_cast<Node *>(link);
+    } while (link);
+
+    d_pool.deallocateN(static_cast<Node *>(first), last);
+}
+
+template <class VALUE, class ALLOCATOR>
+void BidirectionalNodePool<VALUE, ALLOCATOR>::compact(
+                                               bslalg::HashTableAnchor *anchor)
+{
+    BSLS_ASSERT_SAFE(anchor);
+
+    typedef typename bslmf::IsBitwiseMoveable<VALUE>::type IsBitwiseMoveable;
+
+    BidirectionalNodePool      pool(allocator());
+    bslalg::BidirectionalLink *root = anchor->listRootAddress();
+
+    if (root) {
+        size_type numNodes = 0;
+        for (bslalg::BidirectionalLink *link = root;
+             link;
+             link = link->nextLink()) {
+            ++numNodes;
+        }
+
+        // Obtain all of the new nodes as one chunk, from which they are
+        // handed out in increasing address order.
+
+        pool.reserveNodes(numNodes);
+
+        ListProctor                proctor(&pool);
+        bslalg::BidirectionalLink *newRoot = 0;
+        bslalg::BidirectionalLink *newLast = 0;
+        for (bslalg::BidirectionalLink *link = root;
+             link;
+             link = link->nextLink()) {
+            bslalg::BidirectionalLink *node =
+                                pool.relocateNode(*link, IsBitwiseMoveable());
+            node->setPreviousLink(newLast);
+            node->setNextLink(0);
+            if (newLast) {
+                newLast->setNextLink(node);
+            }
+            else {
+                newRoot = node;
+                proctor.manage(newRoot);
+            }
+            newLast = node;
+        }
+        proctor.release();
+
+        // Record the replacement of each original node in its (no longer
+        // needed) 'previousLink', and use it to redirect the buckets without
+        // rehashing any values.
+
+        for (bslalg::BidirectionalLink *link = root, *node = newRoot;
+             link;
+             link = link->nextLink(), node = node->nextLink()) {
+            link->setPreviousLink(node);
+        }
+
+        bslalg::HashTableBucket *bucket = anchor->bucketArrayAddress();
+        bslalg::HashTableBucket *end    = bucket + anchor->bucketArraySize();
+        for (; end != bucket; ++bucket) {
+            if (bucket->first()) {
+                bucket->setFirstAndLast(bucket->first()->previousLink(),
+                                        bucket->last()->previousLink());
+            }
+        }
+        anchor->setListRootAddress(newRoot);
+
+        if (!IsBitwiseMoveable::value) {
+            deleteNodes(root);
+        }
+    }
+
+    // Take the new nodes, leaving 'pool' to release the original chunks on
+    // destruction without destroying any values relocated out of them.
+
+    swapRetainAllocators(pool);
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 void BidirectionalNodePool<VALUE, ALLOCATOR>::reserveNodes(size_type numNodes)
@@ -475,6 +751,16 @@ void BidirectionalNodePool<VALUE, ALLOCATOR>::reserveNodes(size_type numNodes)
     d_pool.reserve(numNodes);
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+void BidirectionalNodePool<VALUE, ALLOCATOR>::reserveNodeCapacity(
+                                                            size_type numNodes)
+{
+    BSLS_ASSERT_SAFE(0 < numNodes);
+
+    d_pool.reserveCapacity(numNodes);
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 void BidirectionalNodePool<VALUE, ALLOCATOR>::swapRetainAllocators(
@@ -504,6 +790,13 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::allocator() const
     return d_pool.allocator();
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+bool BidirectionalNodePool<VALUE, ALLOCATOR>::canWinkOutNodes() const
+{
+    return bslma::WinkOutUtil::canWinkOut<VALUE>(allocator());
+}
+
 }  // close namespace bslstl
 
 template <class VALUE, class ALLOCATOR>
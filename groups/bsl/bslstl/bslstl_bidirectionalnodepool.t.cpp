@@ -6,6 +6,9 @@
 #include <bslalg_bidirectionallink.h>
 #include <bslalg_bidirectionallinklistutil.h>
 #include <bslalg_bidirectionalnode.h>
+#include <bslalg_hashtableanchor.h>
+#include <bslalg_hashtablebucket.h>
+#include <bslalg_hashtableimputil.h>
 
 #include <bslma_allocator.h>
 #include <bslma_default.h>
@@ -13,11 +16,13 @@
 #include <bslma_testallocator.h>
 #include <bslma_testallocatormonitor.h>
 #include <bslma_usesbslmaallocator.h>
+#include <bslma_winkoututil.h>
 
 #include <bsls_assert.h>
 #include <bsls_asserttest.h>
 #include <bsls_bsltestutil.h>
 
+#include <bsltf_noopdeallocatetestallocator.h>
 #include <bsltf_stdtestallocator.h>
 #include <bsltf_templatetestfacility.h>
 #include <bsltf_testvaluesarray.h>
@@ -83,6 +88,7 @@ using namespace bslstl;
 // [ 7] bslalg::BidirectionalLink *createNode(const VALUE& value);
 // [ 8] bslalg::BidirectionalLink *createNode(first, second);
 // [ 9] bslalg::BidirectionalLink *cloneNode(const BidirectionalLink&);
+// [12] void compact(bslalg::HashTableAnchor *anchor);
 // [ 5] void deleteNode(bslalg::BidirectionalLink *node);
 // [ 6] void reserveNodes(std::size_t numNodes);
 // [10] void swapRetainAllocators(other);
@@ -90,11 +96,13 @@ using namespace bslstl;
 //
 // ACCESSORS
 // [ 4] const AllocatorType& allocator() const;
+// [13] bool canWinkOutNodes() const;
 //
 // FREE FUNCTIONS
 // [10] void swap(BidirectionalNodePool& a, b);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
+// [14] USAGE EXAMPLE
 // [ *] CONCERN: No memory is ever allocated from the global allocator.
 //-----------------------------------------------------------------------------
 //=============================================================================
@@ -193,6 +201,18 @@ bool expectToAllocate(size_t n)
     return (((n - 1) & n) == 0);  // Allocate when 'n' is a power of 2
 }
 
+int positionOf(const Link *root, const Link *link)
+    // Return the position of the specified 'link' in the null-terminated list
+    // starting at the specified 'root', or -1 if 'link' is not in the list.
+{
+    for (int position = 0; root; root = root->nextLink(), ++position) {
+        if (root == link) {
+            return position;                                          // RETURN
+        }
+    }
+    return -1;
+}
+
 }  // close unnamed namespace
 
 //=============================================================================
@@ -472,6 +492,12 @@ class TestDriver {
 
   public:
     // TEST CASES
+    static void testCase13();
+        // Test 'canWinkOutNodes'.
+
+    static void testCase12();
+        // Test 'compact'.
+
     static void testCase11();
         // Test type traits.
 
@@ -556,6 +582,245 @@ void TestDriver<VALUE>::createFreeBlocks(Obj   *result,
     }
 }
 
+template<class VALUE>
+void TestDriver<VALUE>::testCase13()
+{
+    // --------------------------------------------------------------------
+    // ACCESSOR 'canWinkOutNodes'
+    //
+    // Concerns:
+    //: 1 'canWinkOutNodes' returns 'true' if and only if 'VALUE' is wink-out
+    //:   safe and the allocator's mechanism has a no-op 'deallocate'.
+    //:
+    //: 2 'canWinkOutNodes' returns 'false' for an allocator that does not
+    //:   wrap a 'bslma::Allocator'.
+    //:
+    //: 3 'canWinkOutNodes' is declared 'const'.
+    //:
+    //: 4 No memory is allocated.
+    //
+    // Plan:
+    //: 1 Create pools using a 'bslma::TestAllocator' and a
+    //:   'bsltf::NoOpDeallocateTestAllocator', and verify, through a 'const'
+    //:   reference, that 'canWinkOutNodes' agrees with
+    //:   'bslma::IsWinkOutSafe<VALUE>' for the latter, and returns 'false'
+    //:   for the former.  (C-1, 3)
+    //:
+    //: 2 Create a pool using a 'bsltf::StdTestAllocator', and verify that
+    //:   'canWinkOutNodes' returns 'false'.  (C-2)
+    //:
+    //: 3 Verify that no memory is allocated.  (C-4)
+    //
+    // Testing:
+    //   bool canWinkOutNodes() const;
+    // --------------------------------------------------------------------
+
+    const bool EXP = bslma::IsWinkOutSafe<VALUE>::value;
+
+    if (verbose) printf("\nACCESSOR 'canWinkOutNodes'"
+                        "\n==========================\n");
+
+    bslma::TestAllocator da("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    {
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        Obj mX(&oa);  const Obj& X = mX;
+
+        ASSERTV(X.canWinkOutNodes(), !X.canWinkOutNodes());
+        ASSERTV(oa.numBlocksTotal(), 0 == oa.numBlocksTotal());
+    }
+    {
+        bsltf::NoOpDeallocateTestAllocator oa;
+
+        Obj mX(&oa);  const Obj& X = mX;
+
+        ASSERTV(EXP, X.canWinkOutNodes(), EXP == X.canWinkOutNodes());
+        ASSERTV(oa.numDeallocations(), 0 == oa.numDeallocations());
+    }
+    {
+        typedef bslstl::BidirectionalNodePool<VALUE, StlAlloc> StlObj;
+
+        StlObj mX((StlAlloc()));  const StlObj& X = mX;
+
+        ASSERTV(X.canWinkOutNodes(), !X.canWinkOutNodes());
+    }
+
+    ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+}
+
+template<class VALUE>
+void TestDriver<VALUE>::testCase12()
+{
+    // -----------------------------------------------------------------------
+    // MANIPULATOR 'compact'
+    //
+    // Concerns:
+    //: 1 'compact' preserves the sequence of values in the list, and each
+    //:   bucket of the anchor refers to the same positions in the list.
+    //:
+    //: 2 After 'compact', traversing the list visits nodes in increasing
+    //:   address order, and the nodes are correctly linked in both
+    //:   directions.
+    //:
+    //: 3 All of the memory previously held by the pool, including the
+    //:   footprints of deleted nodes, is released, and the nodes of the list
+    //:   then occupy a single chunk.
+    //:
+    //: 4 Values are relocated without leaking, or releasing twice, the
+    //:   memory they own, whether or not 'VALUE' is bitwise moveable.
+    //:
+    //: 5 If an allocation fails, the anchor and the pool are unchanged.
+    //:
+    //: 6 No memory is allocated from the default allocator.
+    //
+    // Plan:
+    //: 1 For a sequence of list sizes, create nodes in decreasing order,
+    //:   insert every other one into the buckets of an anchor using
+    //:   'bslalg::HashTableImpUtil', and delete the others, so that the pool
+    //:   holds free footprints and the nodes of the list are neither
+    //:   contiguous nor in address order.  Record the sequence of values in
+    //:   the list, and the list positions referred to by each bucket.
+    //:
+    //: 2 Invoke 'compact' in the presence of injected exceptions, verifying
+    //:   the sequence of values before each attempt.  (C-5)
+    //:
+    //: 3 Verify the sequence of values, the links and addresses of the
+    //:   nodes, the buckets, and the number of blocks in use from the object
+    //:   and default allocators.  Then delete the nodes, and verify that only
+    //:   the chunk remains in use.  (C-1..4, 6)
+    //
+    // Testing:
+    //   void compact(bslalg::HashTableAnchor *anchor);
+    // -----------------------------------------------------------------------
+
+    if (verbose) printf("\nMANIPULATOR 'compact'"
+                        "\n=====================\n");
+
+    const bool TYPE_ALLOC = bslma::UsesBslmaAllocator<VALUE>::value;
+
+    bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    bsltf::TestValuesArray<VALUE> VALUES;
+
+    enum { k_NUM_BUCKETS = 7, k_MAX_SIZE = 16 };
+
+    const int SIZES[]   = { 0, 1, 2, 3, 5, 8, 13, k_MAX_SIZE };
+    const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+    ASSERT(k_MAX_SIZE <= static_cast<int>(VALUES.size()));
+
+    for (int ti = 0; ti < NUM_SIZES; ++ti) {
+        const int SIZE = SIZES[ti];
+
+        if (veryVerbose) { T_ P(SIZE) }
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        {
+            Obj mX(&oa);
+
+            bslalg::HashTableBucket buckets[k_NUM_BUCKETS];
+            memset(buckets, 0, sizeof buckets);
+
+            bslalg::HashTableAnchor anchor(buckets, k_NUM_BUCKETS, 0);
+
+            for (int i = 2 * SIZE - 1; i >= 0; --i) {
+                Link *link = mX.createNode(VALUES[i / 2]);
+                if (i % 2) {
+                    bslalg::HashTableImpUtil::insertAtBackOfBucket(&anchor,
+                                                                   link,
+                                                                   i / 2);
+                }
+                else {
+                    mX.deleteNode(link);
+                }
+            }
+
+            // Record the index in 'VALUES' of the value at each position of
+            // the list, and the positions referred to by each bucket.
+
+            int order[k_MAX_SIZE];
+            int numNodes = 0;
+            for (const Link *link = anchor.listRootAddress();
+                 link;
+                 link = link->nextLink()) {
+                const VALUE& value = static_cast<const ValueNode *>(
+                                                               link)->value();
+                for (int k = 0; k < SIZE; ++k) {
+                    if (VALUES[k] == value) {
+                        order[numNodes] = k;
+                    }
+                }
+                ++numNodes;
+            }
+            ASSERTV(SIZE, numNodes, SIZE == numNodes);
+
+            int firsts[k_NUM_BUCKETS];
+            int lasts[k_NUM_BUCKETS];
+            for (int b = 0; b < k_NUM_BUCKETS; ++b) {
+                firsts[b] = positionOf(anchor.listRootAddress(),
+                                       buckets[b].first());
+                lasts[b]  = positionOf(anchor.listRootAddress(),
+                                       buckets[b].last());
+            }
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+                int i = 0;
+                for (const Link *link = anchor.listRootAddress();
+                     link;
+                     link = link->nextLink(), ++i) {
+                    const ValueNode *node = static_cast<const ValueNode *>(
+                                                                        link);
+                    ASSERTV(SIZE, i, VALUES[order[i]] == node->value());
+                }
+                ASSERTV(SIZE, i, SIZE == i);
+
+                mX.compact(&anchor);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            int         i    = 0;
+            const Link *prev = 0;
+            for (const Link *link = anchor.listRootAddress();
+                 link;
+                 link = link->nextLink(), ++i) {
+                const ValueNode *node = static_cast<const ValueNode *>(link);
+                ASSERTV(SIZE, i, VALUES[order[i]] == node->value());
+                ASSERTV(SIZE, i, prev == link->previousLink());
+                ASSERTV(SIZE, i, prev < link);
+                prev = link;
+            }
+            ASSERTV(SIZE, i, SIZE == i);
+
+            ASSERTV(SIZE, anchor.bucketArrayAddress() == buckets);
+            for (int b = 0; b < k_NUM_BUCKETS; ++b) {
+                ASSERTV(SIZE, b, firsts[b] ==
+                          positionOf(anchor.listRootAddress(),
+                                     buckets[b].first()));
+                ASSERTV(SIZE, b, lasts[b] ==
+                          positionOf(anchor.listRootAddress(),
+                                     buckets[b].last()));
+            }
+
+            // One chunk, and the memory owned by each value.
+
+            const int NUM_CHUNKS = SIZE ? 1 : 0;
+            ASSERTV(SIZE, oa.numBlocksInUse(),
+                    NUM_CHUNKS + TYPE_ALLOC * SIZE == oa.numBlocksInUse());
+            ASSERTV(SIZE, da.numBlocksTotal(), 0 == da.numBlocksTotal());
+
+            if (anchor.listRootAddress()) {
+                mX.deleteNodes(anchor.listRootAddress());
+            }
+            ASSERTV(SIZE, oa.numBlocksInUse(),
+                    NUM_CHUNKS == oa.numBlocksInUse());
+        }
+        ASSERTV(SIZE, oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+    }
+}
+
 template<class VALUE>
 void TestDriver<VALUE>::testCase11()
 {
@@ -2026,7 +2291,7 @@ int main(int argc, char *argv[])
     bslma::TestAllocatorMonitor gam(&ga);
 
     switch (test) { case 0:
-      case 12: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -2076,6 +2341,22 @@ int main(int argc, char *argv[])
         ASSERT(NUM_DATA == ti);
 
       } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // ACCESSOR 'canWinkOutNodes'
+        // --------------------------------------------------------------------
+        RUN_EACH_TYPE(TestDriver,
+                      testCase13,
+                      BSLTF_TEMPLATETESTFACILITY_TEST_TYPES_REGULAR);
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // MANIPULATOR 'compact'
+        // --------------------------------------------------------------------
+        RUN_EACH_TYPE(TestDriver,
+                      testCase12,
+                      BSLTF_TEMPLATETESTFACILITY_TEST_TYPES_REGULAR);
+      } break;
       case 11: {
         // --------------------------------------------------------------------
         // TYPE TRAITS
@@ -1499,6 +1499,10 @@ BSLS_IDENT("$Id: $")
 #include <bslma_usesbslmaallocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ADDLVALUEREFERENCE
 #include <bslmf_addlvaluereference.h>
 #endif
@@ -2078,7 +2082,10 @@ class HashTable {
         // 'maxLoadFactor' is not exceeded.
 
     ~HashTable();
-        // Destroy this object.
+        // Destroy this object.  Note that the elements are neither destroyed
+        // nor deallocated, and the array of buckets is not deallocated, if
+        // the elements are wink-out safe and the allocator of this object has
+        // a no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
     HashTable& operator=(const HashTable& rhs);
@@ -2095,6 +2102,18 @@ class HashTable {
         // requirements might simplify in the future, if the standard is
         // updated.
 
+    void compact();
+        // Re-allocate the nodes of this hash-table, in the order of its list,
+        // from a single newly-obtained block of memory, and release all of
+        // the memory previously used for nodes (including any retained for
+        // reuse), so that traversing this hash-table visits memory in
+        // increasing address order.  Elements are moved with 'memcpy' if the
+        // 'ValueType' is bitwise moveable, and copied (then destroyed)
+        // otherwise.  No hash codes are computed, and the bucket array is
+        // retained.  All pointers and references to nodes of this hash-table
+        // are invalidated.  If an exception is thrown, this hash-table is
+        // unchanged.
+
     template <class SOURCE_TYPE>
     bslalg::BidirectionalLink *insert(const SOURCE_TYPE& value);
         // Insert the specified 'value' into this hash-table, and return the
@@ -2187,15 +2206,16 @@ class HashTable {
     void reserveForNumElements(SizeType numElements);
         // Re-organize this hash-table to have a sufficient number of buckets
         // to accommodate at least the specified 'numElements' without
-        // exceeding the 'maxLoadFactor', and ensure that that there are
-        // sufficient nodes pre-allocated in this object's node pool.  If this
-        // function tries to allocate a number of buckets larger than can be
-        // represented by this hash table's 'SizeType', a 'std::length_error'
-        // exception will be thrown.  This operation provides the strong
-        // exception guarantee (see {'bsldoc_glossary'}) unless the 'hasher'
-        // throws, in which case this operation provides the basic exception
-        // guarantee, leaving the hash-table in a valid, but otherwise
-        // unspecified (and potentially empty), state.
+        // exceeding the 'maxLoadFactor', and, if this hash-table is empty,
+        // ensure that there are sufficient nodes pre-allocated in this
+        // object's node pool.  If this function tries to allocate a number of
+        // buckets larger than can be represented by this hash table's
+        // 'SizeType', a 'std::length_error' exception will be thrown.  This
+        // operation provides the strong exception guarantee (see
+        // {'bsldoc_glossary'}) unless the 'hasher' throws, in which case this
+        // operation provides the basic exception guarantee, leaving the
+        // hash-table in a valid, but otherwise unspecified (and potentially
+        // empty), state.
 
     void setMaxLoadFactor(float newMaxLoadFactor);
         // Set the maximum load factor permitted by this hash table to the
@@ -3380,7 +3400,9 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::~HashTable()
                                  HashTable_ImpDetails::incidentalAllocator()));
 #endif
 
-    this->removeAllAndDeallocate();
+    if (!d_parameters.nodeFactory().canWinkOutNodes()) {
+        this->removeAllAndDeallocate();
+    }
 }
 
 // PRIVATE MANIPULATORS
@@ -3585,13 +3607,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::removeAllImp()
     // assigns the buckets index all null pointers
 
     if (BidirectionalLink *root = d_anchor.listRootAddress()) {
-        BidirectionalLink *next;
-        do {
-            next = root->nextLink();
-            d_parameters.nodeFactory().deleteNode(
-                                                static_cast<NodeType *>(root));
-        }
-        while(0 != (root = next));
+        d_parameters.nodeFactory().deleteNodes(root);
     }
 }
 
@@ -3655,6 +3671,13 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::operator=(
     return *this;
 }
 
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+inline
+void HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::compact()
+{
+    d_parameters.nodeFactory().compact(&d_anchor);
+}
+
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
 template <class SOURCE_TYPE>
 bslalg::BidirectionalLink *
@@ -3934,6 +3957,15 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::reserveForNumElements(
         return;                                                       // RETURN
     }
 
+    // Reserve the nodes first, so that a failure to allocate them leaves this
+    // hash-table unchanged.  Reserve them only if this hash-table is empty:
+    // otherwise, a range insert of values whose keys are already present would
+    // leave their reserved nodes unused for the lifetime of the node pool.
+
+    if (0 == d_size) {
+        d_parameters.nodeFactory().reserveNodeCapacity(numElements);
+    }
+
     if (numElements > d_capacity) {
         // Compute a "good" number of buckets, e.g., pick a prime number from a
         // sorted array of exponentially increasing primes.
@@ -4437,6 +4469,17 @@ struct UsesBslmaAllocator<bslstl::HashTable_ImplParameters<KEY_CONFIG,
     : bsl::is_convertible<Allocator*, ALLOCATOR>::type {
 };
 
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+struct IsWinkOutSafe<bslstl::HashTable<KEY_CONFIG,
+                                       HASHER,
+                                       COMPARATOR,
+                                       ALLOCATOR> >
+    : bsl::integral_constant<
+                   bool,
+                   IsWinkOutSafe<typename KEY_CONFIG::ValueType>::value
+                && bsl::is_convertible<Allocator*, ALLOCATOR>::value> {
+};
+
 }  // close traits namespace
 
 namespace bslmf
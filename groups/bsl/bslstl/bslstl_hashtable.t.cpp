@@ -236,6 +236,7 @@ using bslstl::CallableVariable;
 //*[12] reserveForNumElements(SizeType numElements);
 //*[14] setMaxLoadFactor(float loadFactor);
 // [ 8] swap(HashTable& other);
+// [17] compact();
 //
 // ACCESSORS
 // [ 4] allocator() const;
@@ -5261,6 +5262,7 @@ class TestDriver {
     static void testCase14();
     static void testCase15();
     static void testCase16();
+    static void testCase17();
         // Run the test case with the corresponding case number for
         // 'HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>'.
 };
@@ -9351,6 +9353,170 @@ void TestDriver<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::testCase16()
                                                       == objIsBitwiseMoveable);
 }
 
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+void TestDriver<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::testCase17()
+{
+    // ------------------------------------------------------------------------
+    // TESTING 'compact'
+    //
+    // Concerns:
+    //: 1 'compact' does not change the value of the object, or its number of
+    //:   buckets.
+    //:
+    //: 2 After 'compact', 'find' locates every element, and each bucket
+    //:   refers to exactly the elements whose keys hash to it, i.e., the
+    //:   buckets are correctly redirected to the new nodes.
+    //:
+    //: 3 After 'compact', the nodes of the element list are in increasing
+    //:   address order, even if the object was built by interleaved
+    //:   insertions and removals.
+    //:
+    //: 4 'compact' does not increase the number of blocks in use by the
+    //:   object allocator, or by the default allocator.  (Elements of a
+    //:   container whose allocator is not a 'bsl::allocator' may legitimately
+    //:   use the default allocator.)
+    //:
+    //: 5 'compact' provides the strong exception guarantee, whether or not
+    //:   'ValueType' is bitwise moveable.
+    //
+    // Plan:
+    //: 1 For each row of the default data table, and each of a set of
+    //:   maximum load factors, create an object from the specification,
+    //:   then remove the elements for the first half of the specification
+    //:   and insert them again, so that the nodes of the object are not in
+    //:   list order in memory.  Create a copy of the object using a scratch
+    //:   allocator.
+    //:
+    //: 2 Invoke 'compact' in the presence of injected exceptions, using an
+    //:   'ExceptionGuard' to verify that the object is unchanged by each
+    //:   failed attempt.  (C-5)
+    //:
+    //: 3 Verify that the object equals its copy and has the same number of
+    //:   buckets, that 'find' locates each element of the copy, that the
+    //:   nodes of each bucket hash to that bucket and are as many as
+    //:   'countElementsInBucket' reports, and that successive nodes of the
+    //:   list have increasing addresses.  (C-1..3)
+    //:
+    //: 4 Verify that the number of blocks in use by the object allocator has
+    //:   not grown, and that the number in use by the default allocator is
+    //:   unchanged.  (C-4)
+    //
+    // Testing:
+    //   compact();
+    // ------------------------------------------------------------------------
+
+    bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    const int NUM_DATA                     = DEFAULT_NUM_DATA;
+    const DefaultDataRow (&DATA)[NUM_DATA] = DEFAULT_DATA;
+
+    const HASHER     HASH    = MakeCallableEntity<HASHER>::make();
+    const COMPARATOR COMPARE = MakeCallableEntity<COMPARATOR>::make();
+
+    bslma::TestAllocator tda("test-array values", veryVeryVeryVerbose);
+    const TestValues VALUES(&tda);
+
+    for (int ti = 0; ti < NUM_DATA; ++ti) {
+        const int         LINE   = DATA[ti].d_line;
+        const char *const SPEC   = DATA[ti].d_spec;
+        const size_t      LENGTH = strlen(SPEC);
+
+        if (veryVerbose) printf("Testing compact on spec: %s,"
+                                " index: %i\n", SPEC,  ti);
+
+        for (int tj = 0; tj < DEFAULT_MAX_LOAD_FACTOR_SIZE; ++tj) {
+            const float  MAX_LF      = DEFAULT_MAX_LOAD_FACTOR[tj];
+            const size_t NUM_BUCKETS = predictNumBuckets(LENGTH, MAX_LF);
+
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+            ALLOCATOR objAlloc = MakeAllocator<ALLOCATOR>::make(&oa);
+
+            Obj mX(HASH, COMPARE, NUM_BUCKETS, MAX_LF, objAlloc);
+            const Obj& X = gg(&mX, SPEC);
+
+            // Remove the elements for the first half of the spec, then insert
+            // them again into the freed nodes, in reverse order.
+
+            for (size_t tk = 0; tk < LENGTH / 2; ++tk) {
+                Link *link = X.find(
+                             KEY_CONFIG::extractKey(VALUES[SPEC[tk] - 'A']));
+                ASSERTV(LINE, tk, MAX_LF, 0 != link);
+                if (link) {
+                    mX.remove(link);
+                }
+            }
+            for (size_t tk = 0; tk < LENGTH / 2; ++tk) {
+                ASSERTV(LINE, tk, MAX_LF,
+                        0 != insertElement(&mX, VALUES[SPEC[tk] - 'A']));
+            }
+            ASSERTV(LINE, MAX_LF, LENGTH == X.size());
+
+            bslma::TestAllocator scratch("scratch", veryVeryVeryVerbose);
+            ALLOCATOR scratchAlloc = MakeAllocator<ALLOCATOR>::make(&scratch);
+
+            const Obj Z(X, scratchAlloc);
+
+            const size_t             EXP_NUM_BUCKETS = X.numBuckets();
+            const bsls::Types::Int64 B               = oa.numBlocksInUse();
+            const bsls::Types::Int64 D               = da.numBlocksInUse();
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+                bslma::ExceptionGuard<Obj> guard(&X, L_, scratchAlloc);
+
+                mX.compact();
+
+                guard.release();
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            const bsls::Types::Int64 A = oa.numBlocksInUse();
+
+            ASSERTV(LINE, MAX_LF, X == Z);
+            ASSERTV(LINE, MAX_LF, EXP_NUM_BUCKETS == X.numBuckets());
+            ASSERTV(LINE, MAX_LF, B, A, A <= B);
+
+            COMPARATOR compare = X.comparator();
+            for (Link *it = Z.elementListRoot(); it; it = it->nextLink()) {
+                Link *found =
+                              X.find(ImpUtil::extractKey<KEY_CONFIG>(it));
+                ASSERTV(LINE, MAX_LF, 0 != found);
+                if (found) {
+                    ASSERTV(LINE, MAX_LF, compare(
+                                  ImpUtil::extractKey<KEY_CONFIG>(it),
+                                  ImpUtil::extractKey<KEY_CONFIG>(found)));
+                }
+            }
+
+            size_t numVisited = 0;
+            for (SizeType b = 0; b < X.numBuckets(); ++b) {
+                const bslalg::HashTableBucket& bucket = X.bucketAtIndex(b);
+
+                SizeType count = 0;
+                for (Link *it = bucket.first();
+                     it;
+                     it = bucket.last() == it ? 0 : it->nextLink()) {
+                    ASSERTV(LINE, MAX_LF, b, b == X.bucketIndexForKey(
+                                       ImpUtil::extractKey<KEY_CONFIG>(it)));
+                    ++count;
+                }
+                ASSERTV(LINE, MAX_LF, b, count,
+                        X.countElementsInBucket(b) == count);
+                numVisited += count;
+            }
+            ASSERTV(LINE, MAX_LF, numVisited, LENGTH == numVisited);
+
+            for (Link *it = X.elementListRoot();
+                 it && it->nextLink();
+                 it = it->nextLink()) {
+                ASSERTV(LINE, MAX_LF, it < it->nextLink());
+            }
+
+            ASSERTV(LINE, MAX_LF, D, da.numBlocksInUse(),
+                    D == da.numBlocksInUse());
+        }
+    }
+}
+
 //=============================================================================
 //                      TEST CASE DISPATCH FUNCTIONS
 //-----------------------------------------------------------------------------
@@ -11245,6 +11411,42 @@ void mainTestCase16()
     TestDriver_AwkwardMaplike::testCase16();
 }
 
+static
+void mainTestCase17()
+    // --------------------------------------------------------------------
+    // TESTING 'compact'
+    // --------------------------------------------------------------------
+    // The full set of regular test types covers value types that are, and
+    // are not, bitwise moveable, including types whose copy constructor
+    // allocates (and so may throw).  The grouped configurations check that
+    // buckets shared by several keys, and elements with equivalent keys, are
+    // redirected correctly.
+{
+    if (verbose) printf("\nTesting basic configuration"
+                        "\n---------------------------\n");
+    RUN_EACH_TYPE(TestDriver_BasicConfiguation,
+                  testCase17,
+                  BSLTF_TEMPLATETESTFACILITY_TEST_TYPES_REGULAR);
+
+    if (verbose) printf("\nTesting grouped hash with unique key values"
+                        "\n-------------------------------------------\n");
+    RUN_EACH_TYPE(TestDriver_GroupedUniqueKeys,
+                  testCase17,
+                  BSLSTL_HASHTABLE_MINIMALTEST_TYPES);
+
+    if (verbose) printf("\nTesting grouped hash with grouped key values"
+                        "\n--------------------------------------------\n");
+    RUN_EACH_TYPE(TestDriver_GroupedSharedKeys,
+                  testCase17,
+                  BSLSTL_HASHTABLE_MINIMALTEST_TYPES);
+
+    if (verbose) printf("\nTesting stateful STL allocators"
+                        "\n-------------------------------\n");
+    RUN_EACH_TYPE(TestDriver_StatefulAllocatorConfiguation,
+                  testCase17,
+                  BSLSTL_HASHTABLE_MINIMALTEST_TYPES);
+}
+
 #if 0  // Planned test cases, not yet implemented
 static
 void mainTestCase16()
@@ -11483,9 +11685,8 @@ int main(int argc, char *argv[])
 // BDE_VERIFY pragma: -TP05 // Test doc is in delegated functions
 // BDE_VERIFY pragma: -TP17 // No test-banners in a delegating switch statement
     switch (test) { case 0:
-      case 17: { mainTestCaseUsageExample(); } break;
-//      case 18: { mainTestCase18(); } break;
-//      case 17: { mainTestCase17(); } break;
+      case 18: { mainTestCaseUsageExample(); } break;
+      case 17: { mainTestCase17(); } break;
       case 16: { mainTestCase16(); } break;
       case 15: { mainTestCase15(); } break;
       case 14: { mainTestCase14(); } break;
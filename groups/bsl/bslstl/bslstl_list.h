@@ -511,6 +511,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_allocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ENABLEIF
 #include <bslmf_enableif.h>
 #endif
@@ -547,6 +551,11 @@ BSL_OVERRIDES_STD mode"
 #include <bsls_util.h>
 #endif
 
+#ifndef INCLUDED_CSTRING
+#include <cstring>
+#define INCLUDED_CSTRING
+#endif
+
 namespace bsl {
 
                         // =====================
@@ -857,6 +866,47 @@ class list
         }
     };
 
+    class NodeChain;
+    friend class NodeChain;
+
+    class NodeChain
+        // This class accumulates nodes that no longer hold a value, and frees
+        // them all upon destruction.
+    {
+        // DATA
+        list     *d_list;   // list whose allocator frees the nodes
+        NodePtr   d_head;   // most recently added node, or 0 if none
+
+      public:
+        // CREATORS
+        explicit NodeChain(list *l)
+            // Create an empty node chain that will use the specified list 'l'
+            // to free the nodes it accumulates.
+        : d_list(l), d_head(0)
+        {
+        }
+
+        ~NodeChain()
+            // Destroy this node chain, and free the nodes it contains.
+        {
+            while (d_head) {
+                NodePtr p = d_head;
+                d_head = p->d_next;
+                d_list->free_node(p);
+            }
+        }
+
+        // MANIPULATORS
+        void add(NodePtr p)
+            // Add the specified node 'p', whose value has already been
+            // destroyed or relocated, to this chain.  Note that the links of
+            // 'p' are overwritten.
+        {
+            p->d_next = d_head;
+            d_head = p;
+        }
+    };
+
     struct Comp_Elems {
         // Binary function predicate object type for comparing two 'VALUE'
         // objects using 'operator<'.  This operation is usually, but not
@@ -914,6 +964,15 @@ class list
         // Quickly swaps 'd_sentinel' and 'size_ref()' of '*this' with 'other'
         // without checking the allocator.
 
+    void relocate_value(NodePtr to, NodePtr from, bsl::true_type);
+    void relocate_value(NodePtr to, NodePtr from, bsl::false_type);
+        // Move the value of the node pointed to by the specified 'from' into
+        // the uninitialized value of the node pointed to by the specified
+        // 'to', leaving 'from' holding no value.  The first overload, used
+        // when 'VALUE' is bitwise moveable, copies the bytes of the value; the
+        // second copy-constructs the value and then destroys the original.
+        // If an exception is thrown, 'from' is unchanged.
+
     // PRIVATE ACCESSORS
     const NodeAlloc& allocator() const;
         // Return a reference providing non-modifiable access to the allocator
@@ -939,6 +998,11 @@ class list
         list,
         BloombergLP::bslma::UsesBslmaAllocator,
         (is_convertible<BloombergLP::bslma::Allocator*, ALLOCATOR>::value));
+    BSLMF_NESTED_TRAIT_DECLARATION_IF(
+        list,
+        BloombergLP::bslma::IsWinkOutSafe,
+        (BloombergLP::bslma::IsWinkOutSafe<VALUE>::value
+      && is_convertible<BloombergLP::bslma::Allocator*, ALLOCATOR>::value));
 
     // PUBLIC TYPES
     typedef VALUE&                                             reference;
@@ -1080,7 +1144,10 @@ class list
 
     ~list();
         // Destroy this list by calling the destructor for each element and
-        // deallocating all allocated storage.
+        // deallocating all allocated storage.  Note that the elements are
+        // neither destroyed nor deallocated if 'VALUE' is wink-out safe and
+        // the allocator of this list has a no-op 'deallocate' (see
+        // 'bslma_winkoututil').
 
     // MANIPULATORS
     list& operator=(const list& rhs);
@@ -1448,7 +1515,24 @@ class list
         // returns the same value.
 
     void clear();
-        // Remove all the elements from this list.
+        // Remove all the elements from this list.  Note that the elements are
+        // neither destroyed nor deallocated if 'VALUE' is wink-out safe and
+        // the allocator of this list has a no-op 'deallocate' (see
+        // 'bslma_winkoututil').
+
+    void compact();
+        // Re-allocate the nodes of this list in order from 'begin()' to
+        // 'end()', releasing the existing nodes only once all of their
+        // replacements have been obtained, so that traversing this list
+        // visits memory in the order in which it was supplied by the
+        // allocator.  Each element is moved with 'memcpy' if 'VALUE' is
+        // bitwise moveable, and is copied (then destroyed) otherwise.  All
+        // iterators, pointers, and references to elements of this list are
+        // invalidated.  If an exception is thrown, the value of this list is
+        // unchanged, although some of its nodes may have been re-allocated.
+        // Note that the resulting locality depends on the allocator, and is
+        // best when consecutive requests are supplied from contiguous memory
+        // (e.g., by a sequential allocator, or a pool having no free blocks).
 
     // 23.3.5.5 list operations:
 
@@ -1891,6 +1975,31 @@ void list<VALUE, ALLOCATOR>::quick_swap(list& other)
     other.size_ref() = tmpSize;
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+void list<VALUE, ALLOCATOR>::relocate_value(NodePtr to,
+                                            NodePtr from,
+                                            bsl::true_type)
+{
+    std::memcpy(static_cast<void *>(
+                          BloombergLP::bsls::Util::addressOf(to->d_value)),
+                BloombergLP::bsls::Util::addressOf(from->d_value),
+                sizeof(VALUE));
+}
+
+template <class VALUE, class ALLOCATOR>
+inline
+void list<VALUE, ALLOCATOR>::relocate_value(NodePtr to,
+                                            NodePtr from,
+                                            bsl::false_type)
+{
+    AllocTraits::construct(allocator(),
+                           BloombergLP::bsls::Util::addressOf(to->d_value),
+                           from->d_value);
+    AllocTraits::destroy(allocator(),
+                         BloombergLP::bsls::Util::addressOf(from->d_value));
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 typename list<VALUE, ALLOCATOR>::iterator
@@ -2829,9 +2938,44 @@ template <class VALUE, class ALLOCATOR>
 inline
 void list<VALUE, ALLOCATOR>::clear()
 {
+    if (0 < size_ref()
+     && BloombergLP::bslma::WinkOutUtil::canWinkOut<VALUE>(allocator())) {
+        // Abandon the nodes, which have no observable destruction.
+
+        link_nodes(d_sentinel, d_sentinel);
+        size_ref() = 0;
+        return;                                                       // RETURN
+    }
+
     erase(begin(), end());
 }
 
+template <class VALUE, class ALLOCATOR>
+void list<VALUE, ALLOCATOR>::compact()
+{
+    // Each replacement is linked in place of its original, so that this list
+    // remains valid if an allocation fails.  The originals are not freed
+    // until the end, so that the allocator cannot hand their footprints back
+    // as replacements.
+
+    NodeChain originals(this);
+
+    for (NodePtr node = head(); node != d_sentinel; ) {
+        NodePtr p = allocate_node();
+        NodeProctor proctor(this, p);
+        relocate_value(p,
+                       node,
+                       BloombergLP::bslmf::IsBitwiseMoveable<VALUE>());
+        proctor.release();
+
+        NodePtr next = node->d_next;
+        link_nodes(node->d_prev, p);
+        link_nodes(p, next);
+        originals.add(node);
+        node = next;
+    }
+}
+
 // 23.3.5.5 list operations:
 template <class VALUE, class ALLOCATOR>
 void list<VALUE, ALLOCATOR>::splice(const_iterator position, list& x)
@@ -8,9 +8,11 @@
 #include <bslma_newdeleteallocator.h>
 #include <bslma_testallocator.h>           // for testing only
 #include <bslma_testallocatorexception.h>  // for testing only
+#include <bslma_winkoututil.h>             // for testing only
 
 #include <bslmf_assert.h>                  // for testing only
 #include <bslmf_issame.h>                  // for testing only
+#include <bslmf_nestedtraitdeclaration.h>  // for testing only
 
 #include <bsls_alignmentutil.h>
 #include <bsls_bsltestutil.h>
@@ -18,8 +20,11 @@
 #include <bsls_platform.h>
 #include <bsls_stopwatch.h>                // for testing only
 #include <bsls_types.h>
+#include <bsls_util.h>
 
+#include <bsltf_destructioncountingtesttype.h>
 #include <bsltf_nonassignabletesttype.h>   // for testing only
+#include <bsltf_noopdeallocatetestallocator.h>
 
 #include <stdexcept>  // 'length_error', 'out_of_range'
 #include <algorithm>  // 'next_permutation'
@@ -124,6 +129,7 @@ using namespace bsl;
 // [18] iterator erase(const_iterator first, const_iterator last);
 // [19] void swap(list&);
 // [ 2] void clear();
+// [29] void compact();
 // [24] void splice(iterator pos, list& other);
 // [24] void splice(iterator pos, list& other, iterator i);
 // [24] void splice(iterator pos, list& other, iterator first, iterator last);
@@ -160,7 +166,8 @@ using namespace bsl;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [11] ALLOCATOR-RELATED CONCERNS
-// [29] USAGE EXAMPLE
+// [30] CONCERN: 'clear' and '~list' wink out when possible
+// [31] USAGE EXAMPLE
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(list<T,A> *object, const char *spec, int vF = 1);
@@ -1310,6 +1317,7 @@ bool operator!=(IntWrapper a, IntWrapper b)
 
 enum TestEnum { TWO = 2, NINETYNINE = 99 };
 
+
 //=============================================================================
 //                       USAGE EXAMPLES
 //-----------------------------------------------------------------------------
@@ -1781,6 +1789,9 @@ struct TestDriver {
         // length has changed by 'n' elements.  Note: 'n' may be negative.
 
     // TEST CASES
+    static void testCompact();
+        // Test 'compact'
+
     static void testSort();
         // Test 'sort'
 
@@ -2046,6 +2057,91 @@ Int64 TestDriver<TYPE,ALLOC>::expectedBlocks(Int64 n)
                                  // TEST CASES
                                  // ----------
 
+template <class TYPE, class ALLOC>
+void TestDriver<TYPE,ALLOC>::testCompact()
+{
+    // --------------------------------------------------------------------
+    // TESTING COMPACT
+    //
+    // Concerns:
+    //   1. The value of the list is unchanged by 'compact', and the list
+    //      remains correctly linked in both directions.
+    //   2. Every element is moved to a newly allocated node, none of which
+    //      occupies the footprint of a node it replaces.
+    //   3. The number of blocks in use is unchanged, whether or not 'TYPE'
+    //      is bitwise moveable, and no memory is leaked.
+    //   4. If an allocation fails, the value of the list is unchanged.
+    //
+    // Test plan:
+    //   For a series of list specifications, create a list.  Invoke
+    //   'compact' in the presence of injected exceptions, verifying the value
+    //   of the list and recording the addresses of its elements before each
+    //   attempt.  Verify the value and integrity of the list, that no element
+    //   occupies a recorded address, and the number of blocks in use.
+    //
+    // Testing:
+    //   void compact();
+    // --------------------------------------------------------------------
+
+    bslma::TestAllocator testAllocator(veryVeryVerbose);
+    ALLOC Z(&testAllocator);
+
+    const int MAX_SPEC_LEN = 10;
+
+    const char *const SPECS[] = {
+        "", "A", "AB", "ABC", "ABCD", "ABCDE", "AABCC", "ABCDEFGH",
+        "ABCDEABCDE"
+    };
+    const int NUM_SPECS = sizeof(SPECS) / sizeof(SPECS[0]);
+
+    for (int i = 0; i < NUM_SPECS; ++i) {
+        const char *const SPEC   = SPECS[i];
+        const int         LENGTH = static_cast<int>(strlen(SPEC));
+        ASSERT(MAX_SPEC_LEN >= LENGTH);
+
+        if (veryVerbose) P(SPEC);
+
+        Obj mExp;  const Obj& EXP = gg(&mExp, SPEC);
+
+        {
+            Obj mX(Z);  const Obj& X = gg(&mX, SPEC);
+
+            const TYPE     *saveAddresses[MAX_SPEC_LEN];
+            const_iterator  xi;
+
+            const Int64 B = testAllocator.numBlocksInUse();
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(testAllocator) {
+                LOOP_ASSERT(SPEC, EXP == X);
+
+                // A failed attempt may have moved some of the elements, so
+                // record their addresses on each attempt.
+
+                xi = X.begin();
+                for (int j = 0; j < LENGTH; ++j, ++xi) {
+                    saveAddresses[j] = bsls::Util::addressOf(*xi);
+                }
+
+                mX.compact();
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            const Int64 A = testAllocator.numBlocksInUse();
+
+            LOOP_ASSERT(SPEC, EXP == X);
+            LOOP_ASSERT(SPEC, checkIntegrity(X, LENGTH));
+            LOOP3_ASSERT(SPEC, B, A, B == A);
+
+            for (xi = X.begin(); xi != X.end(); ++xi) {
+                const TYPE *address = bsls::Util::addressOf(*xi);
+                for (int j = 0; j < LENGTH; ++j) {
+                    LOOP2_ASSERT(SPEC, j, saveAddresses[j] != address);
+                }
+            }
+        }
+        LOOP_ASSERT(SPEC, 0 == testAllocator.numBlocksInUse());
+    }
+}
+
 template <class TYPE, class ALLOC>
 void TestDriver<TYPE,ALLOC>::testSort()
 {
@@ -8701,7 +8797,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 29: {
+      case 31: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -8741,6 +8837,167 @@ int main(int argc, char *argv[])
         remove("star_data1.txt");
         remove("star_data2.txt");
 
+      } break;
+      case 30: {
+        // --------------------------------------------------------------------
+        // TESTING WINK-OUT
+        //
+        // Concerns:
+        //: 1 If the elements are wink-out safe and the allocator's
+        //:   'deallocate' is a no-op, 'clear' and the destructor neither
+        //:   destroy the elements nor deallocate their nodes.
+        //:
+        //: 2 A list emptied in this way is empty and remains usable.
+        //:
+        //: 3 The elements are destroyed if they are not wink-out safe, or if
+        //:   the allocator's 'deallocate' has an effect.
+        //:
+        //: 4 'bslma::IsWinkOutSafe' holds for a list exactly if it holds for
+        //:   the element type and the list uses a 'bslma' allocator.
+        //
+        // Plan:
+        //: 1 Using a 'bsltf::NoOpDeallocateTestAllocator', populate lists of
+        //:   wink-out safe 'bsltf::DestructionCountingTestType' elements, then
+        //:   clear and destroy them, and verify that no destructor ran and
+        //:   that no node was deallocated.  Verify that a cleared list is
+        //:   empty and can be repopulated.  (C-1..2)
+        //:
+        //: 2 Repeat P-1 with elements that are not wink-out safe, and again
+        //:   with a 'bslma::TestAllocator', and verify that every element is
+        //:   destroyed.  (C-3)
+        //:
+        //: 3 Verify 'bslma::IsWinkOutSafe' for several list types at compile
+        //:   time.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: 'clear' and '~list' wink out when possible
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING WINK-OUT"
+                            "\n================\n");
+
+        typedef bsltf::DestructionCountingTestType<true>  SafeType;
+        typedef bsltf::DestructionCountingTestType<false> UnsafeType;
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<list<int> >::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<list<SafeType> >::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<list<UnsafeType> >::value);
+        typedef list<int, OtherAllocator<int> > OtherAllocList;
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<OtherAllocList>::value);
+
+        const int NUM_ELEMENTS = 16;
+
+        if (verbose) printf("\nWink out with a no-op 'deallocate'.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+
+            SafeType::resetNumDestructions();
+            {
+                list<SafeType> mX(&oa);  const list<SafeType>& X = mX;
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.push_back(SafeType(i));
+                }
+                const int numTemporaries = SafeType::numDestructions();
+                LOOP_ASSERT(numTemporaries, NUM_ELEMENTS == numTemporaries);
+
+                mX.clear();
+                ASSERT(X.empty());
+                ASSERT(0 == X.size());
+                ASSERT(X.begin() == X.end());
+                LOOP_ASSERT(SafeType::numDestructions(),
+                            numTemporaries == SafeType::numDestructions());
+                LOOP_ASSERT(oa.numDeallocations(), 0 == oa.numDeallocations());
+
+                mX.push_back(SafeType(7));
+                mX.push_front(SafeType(3));
+                ASSERT(2 == X.size());
+                ASSERT(3 == X.front().data());
+                ASSERT(7 == X.back().data());
+
+                SafeType::resetNumDestructions();
+            }
+            LOOP_ASSERT(SafeType::numDestructions(),
+                        0 == SafeType::numDestructions());
+
+            // Only the sentinel node is deallocated.
+
+            LOOP_ASSERT(oa.numDeallocations(), 1 == oa.numDeallocations());
+        }
+
+        if (verbose) printf("\nNo wink out for elements lacking the trait.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+
+            UnsafeType::resetNumDestructions();
+            {
+                list<UnsafeType> mX(&oa);  const list<UnsafeType>& X = mX;
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.push_back(UnsafeType(i));
+                }
+                UnsafeType::resetNumDestructions();
+
+                mX.clear();
+                ASSERT(X.empty());
+                LOOP_ASSERT(UnsafeType::numDestructions(),
+                            NUM_ELEMENTS == UnsafeType::numDestructions());
+
+                mX.push_back(UnsafeType(1));
+                UnsafeType::resetNumDestructions();
+            }
+            LOOP_ASSERT(UnsafeType::numDestructions(),
+                        1 == UnsafeType::numDestructions());
+            LOOP_ASSERT(oa.numDeallocations(), 0 < oa.numDeallocations());
+        }
+
+        if (verbose) printf("\nNo wink out for a deallocating allocator.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            SafeType::resetNumDestructions();
+            {
+                list<SafeType> mX(&oa);  const list<SafeType>& X = mX;
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.push_back(SafeType(i));
+                }
+                SafeType::resetNumDestructions();
+
+                mX.clear();
+                ASSERT(X.empty());
+                LOOP_ASSERT(SafeType::numDestructions(),
+                            NUM_ELEMENTS == SafeType::numDestructions());
+
+                mX.push_back(SafeType(1));
+                SafeType::resetNumDestructions();
+            }
+            LOOP_ASSERT(SafeType::numDestructions(),
+                        1 == SafeType::numDestructions());
+            LOOP_ASSERT(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        }
+      } break;
+      case 29: {
+        // --------------------------------------------------------------------
+        // TESTING COMPACT
+        //
+        // Concerns and plan:
+        //   See testCompact for a list of specific concerns and a test plan.
+        //
+        // Testing:
+        //   void compact();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTesting COMPACT"
+                            "\n===============\n");
+
+        if (verbose) printf("\n... with 'char'.\n");
+        TestDriver<char>::testCompact();
+
+        if (verbose) printf("\n... with 'TestType'.\n");
+        TestDriver<T>::testCompact();
+
+        if (verbose) printf("\n... with 'TestTypeOtherAlloc' and"
+                            " 'OtherAlloc'.\n");
+        TestDriver<TOA,OATOA>::testCompact();
+
       } break;
       case 28: {
         // --------------------------------------------------------------------
@@ -409,6 +409,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_allocator.h>
 #endif
 
+#ifndef INCLUDED_BSLSTL_ITERATORUTIL
+#include <bslstl_iteratorutil.h>
+#endif
+
 #ifndef INCLUDED_BSLSTL_MAPCOMPARATOR
 #include <bslstl_mapcomparator.h>
 #endif
@@ -728,7 +732,9 @@ class map {
         // "copy-constructible" (see {Requirements on 'KEY' and 'VALUE'}).
 
     ~map();
-        // Destroy this object.
+        // Destroy this object.  Note that the elements are neither destroyed
+        // nor deallocated if they are wink-out safe and the allocator of this
+        // object has a no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
     map& operator=(const map& rhs);
@@ -853,6 +859,16 @@ class map {
         // Remove all entries from this map.  Note that the map is empty after
         // this call, but allocated memory may be retained for future use.
 
+    void compact();
+        // Re-allocate the nodes of this map, in key order, from a single
+        // newly-obtained block of memory, and release all of the memory
+        // previously used for nodes (including any retained for reuse), so
+        // that iterating over this map visits memory in increasing address
+        // order.  Each 'value_type' object is moved with 'memcpy' if it is
+        // bitwise moveable, and is copied (then destroyed) otherwise.  All
+        // iterators, pointers, and references to elements of this map are
+        // invalidated.  If an exception is thrown, this map is unchanged.
+
     iterator find(const key_type& key);
         // Return an iterator providing modifiable access to the 'value_type'
         // object in this map having the specified 'key', if such an entry
@@ -1289,6 +1305,15 @@ map<KEY, VALUE, COMPARATOR, ALLOCATOR>::map(INPUT_ITERATOR    first,
 , d_tree()
 {
     if (first != last) {
+        // Obtain the footprints of all the nodes at once if the length of the
+        // sequence is known.
+
+        size_type maxInsertions =
+              ::BloombergLP::bslstl::IteratorUtil::insertDistance(first, last);
+        if (maxInsertions) {
+            nodeFactory().reserveNodeCapacity(maxInsertions);
+        }
+
         BloombergLP::bslalg::RbTreeUtilTreeProctor<NodeFactory> proctor(
                                                                &d_tree,
                                                                &nodeFactory());
@@ -1329,7 +1354,9 @@ template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
 inline
 map<KEY, VALUE, COMPARATOR, ALLOCATOR>::~map()
 {
-    clear();
+    if (!nodeFactory().canWinkOutNodes()) {
+        clear();
+    }
 }
 
 
@@ -1443,6 +1470,18 @@ inline
 void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert(INPUT_ITERATOR first,
                                                     INPUT_ITERATOR last)
 {
+    // Obtain the footprints of all the nodes at once only if this map is
+    // empty: otherwise, values whose keys are already present would leave
+    // their reserved footprints unused for the lifetime of the node pool.
+
+    if (empty()) {
+        size_type maxInsertions =
+              ::BloombergLP::bslstl::IteratorUtil::insertDistance(first, last);
+        if (maxInsertions) {
+            nodeFactory().reserveNodeCapacity(maxInsertions);
+        }
+    }
+
     while (first != last) {
         insert(*first);
         ++first;
@@ -1557,7 +1596,7 @@ void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::clear()
         BSLS_ASSERT_SAFE(0 < d_tree.numNodes());
         BSLS_ASSERT_SAFE(d_tree.firstNode() != d_tree.sentinel());
 
-        BloombergLP::bslalg::RbTreeUtil::deleteTree(&d_tree, &nodeFactory());
+        nodeFactory().deleteNodes(&d_tree);
     }
 #if defined(BSLS_ASSERT_SAFE_IS_ACTIVE)
     else {
@@ -1567,6 +1606,13 @@ void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::clear()
 #endif
 }
 
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+inline
+void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::compact()
+{
+    nodeFactory().compact(&d_tree);
+}
+
 template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
 inline
 typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator
@@ -1891,6 +1937,14 @@ struct UsesBslmaAllocator<bsl::map<KEY, VALUE, COMPARATOR, ALLOCATOR> >
     : bsl::is_convertible<Allocator*, ALLOCATOR>
 {};
 
+template <class KEY,  class VALUE,  class COMPARATOR,  class ALLOCATOR>
+struct IsWinkOutSafe<bsl::map<KEY, VALUE, COMPARATOR, ALLOCATOR> >
+    : bsl::integral_constant<bool,
+                             IsWinkOutSafe<KEY>::value
+                          && IsWinkOutSafe<VALUE>::value
+                          && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -12,6 +12,7 @@
 #include <bslma_testallocator.h>
 #include <bslma_testallocatormonitor.h>
 #include <bslma_usesbslmaallocator.h>
+#include <bslma_winkoututil.h>
 
 #include <bslmf_haspointersemantics.h>
 #include <bslmf_issame.h>
@@ -21,7 +22,10 @@
 #include <bsls_asserttest.h>
 #include <bsls_bsltestutil.h>
 #include <bsls_objectbuffer.h>
+#include <bsls_util.h>
 
+#include <bsltf_destructioncountingtesttype.h>
+#include <bsltf_noopdeallocatetestallocator.h>
 #include <bsltf_stdtestallocator.h>
 #include <bsltf_templatetestfacility.h>
 #include <bsltf_testvaluesarray.h>
@@ -137,6 +141,7 @@ using namespace bsl;
 // [18] iterator erase(const_iterator first, const_iterator last);
 // [ 8] void swap(map& other);
 // [ 2] void clear();
+// [27] void compact();
 //
 // observers:
 // [21] key_compare key_comp() const;
@@ -165,7 +170,8 @@ using namespace bsl;
 //
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [26] USAGE EXAMPLE
+// [28] CONCERN: '~map' winks out when possible
+// [29] USAGE EXAMPLE
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(map<T,A> *object, const char *spec, int verbose = 1);
@@ -845,6 +851,7 @@ bool lessThanFunction(const TYPE& lhs, const TYPE& rhs)
 
 }  // close unnamed namespace
 
+
 // ============================================================================
 //                     GLOBAL TYPEDEFS FOR TESTING
 // ----------------------------------------------------------------------------
@@ -930,6 +937,9 @@ class TestDriver {
 
   public:
     // TEST CASES
+    static void testCase27();
+        // Test 'compact'.
+
     static void testCase26();
         // Test standard interface coverage.
 
@@ -1078,6 +1088,131 @@ bsl::map<KEY, VALUE, COMP, ALLOC> TestDriver<KEY, VALUE, COMP, ALLOC>::g(
     return gg(&object, spec);
 }
 
+template <class KEY, class VALUE, class COMP, class ALLOC>
+void TestDriver<KEY, VALUE, COMP, ALLOC>::testCase27()
+{
+    // ------------------------------------------------------------------------
+    // TESTING 'compact'
+    //
+    // Concerns:
+    //: 1 'compact' does not change the value of the map, and the map remains
+    //:   searchable by key.
+    //:
+    //: 2 After 'compact', iterating over the map visits its elements in
+    //:   increasing address order, even if the map was built by interleaved
+    //:   insertions and erasures.
+    //:
+    //: 3 'compact' releases the memory retained for reuse, so the number of
+    //:   blocks in use does not grow, and all memory comes from the object
+    //:   allocator.
+    //:
+    //: 4 'compact' provides the strong exception guarantee, whether or not
+    //:   'value_type' is bitwise moveable.
+    //
+    // Plan:
+    //: 1 For a series of specifications, create a map by inserting the
+    //:   values of one specification, erasing those of a second, and
+    //:   inserting those of a third, so that the nodes of the map are not in
+    //:   key order in memory.
+    //:
+    //: 2 Invoke 'compact' in the presence of injected exceptions, using an
+    //:   'ExceptionGuard' to verify that the map is unchanged by each
+    //:   failed attempt.  (C-4)
+    //:
+    //: 3 Verify the value of the map, that 'find' returns each element, and
+    //:   that successive elements have increasing addresses.  (C-1..2)
+    //:
+    //: 4 Verify that the number of blocks in use by the object allocator has
+    //:   not grown, and that the default allocator was not used.  (C-3)
+    //
+    // Testing:
+    //   void compact();
+    // ------------------------------------------------------------------------
+
+    static const struct {
+        int         d_line;      // source line number
+        const char *d_spec;      // values inserted first
+        const char *d_erased;    // values then erased
+        const char *d_inserted;  // values then inserted
+        const char *d_results;   // expected element values
+    } DATA[] = {
+        //line  spec        erased  inserted  results
+        //----  ----        ------  --------  -------
+
+        { L_,   "",         "",     "",       ""          },
+        { L_,   "A",        "",     "",       "A"         },
+        { L_,   "AB",       "A",    "",       "B"         },
+        { L_,   "ABC",      "B",    "D",      "ACD"       },
+        { L_,   "EDCBA",    "",     "",       "ABCDE"     },
+        { L_,   "ABCDEFGH", "BDF",  "IJ",     "ACEGHIJ"   },
+        { L_,   "HGFEDCBA", "AH",   "IJK",    "BCDEFGIJK" },
+        { L_,   "ABCDEFGH", "ACEG", "ACEG",   "ABCDEFGH"  },
+    };
+    const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+    for (int ti = 0; ti < NUM_DATA; ++ti) {
+        const int         LINE     = DATA[ti].d_line;
+        const char *const SPEC     = DATA[ti].d_spec;
+        const char *const ERASED   = DATA[ti].d_erased;
+        const char *const INSERTED = DATA[ti].d_inserted;
+        const char *const RESULTS  = DATA[ti].d_results;
+        const size_t      LENGTH   = strlen(RESULTS);
+
+        const TestValues ERASED_VALUES(ERASED);
+        const TestValues INSERTED_VALUES(INSERTED);
+        const TestValues EXP(RESULTS);
+
+        if (veryVerbose) { P_(LINE) P_(SPEC) P_(ERASED) P(INSERTED) }
+
+        bslma::TestAllocator da("default", veryVeryVeryVerbose);
+        bslma::TestAllocator oa("object",  veryVeryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        Obj mX(&oa);  const Obj& X = gg(&mX, SPEC);
+
+        for (size_t tj = 0; tj < strlen(ERASED); ++tj) {
+            ASSERTV(LINE, tj, 1 == mX.erase(ERASED_VALUES[tj].first));
+        }
+        for (size_t tj = 0; tj < strlen(INSERTED); ++tj) {
+            ASSERTV(LINE, tj, mX.insert(INSERTED_VALUES[tj]).second);
+        }
+        ASSERTV(LINE, 0 == verifyContainer(X, EXP, LENGTH));
+
+        const bsls::Types::Int64 B = oa.numBlocksInUse();
+
+        bslma::TestAllocator scratch("scratch", veryVeryVeryVerbose);
+
+        BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+            ExceptionGuard<Obj> guard(&X, L_, &scratch);
+
+            mX.compact();
+
+            guard.release();
+        } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+        const bsls::Types::Int64 A = oa.numBlocksInUse();
+
+        ASSERTV(LINE, 0 == verifyContainer(X, EXP, LENGTH));
+        ASSERTV(LINE, B, A, A <= B);
+        ASSERTV(LINE, da.numBlocksTotal(), 0 == da.numBlocksTotal());
+
+        for (size_t tj = 0; tj < LENGTH; ++tj) {
+            CIter it = X.find(EXP[tj].first);
+            ASSERTV(LINE, tj, X.end() != it);
+            ASSERTV(LINE, tj, X.end() != it && EXP[tj] == *it);
+        }
+
+        if (LENGTH) {
+            CIter it = X.begin();
+            for (CIter next = it; ++next != X.end(); it = next) {
+                ASSERTV(LINE, bsls::Util::addressOf(*it)
+                                              < bsls::Util::addressOf(*next));
+            }
+        }
+    }
+}
+
 template <class KEY, class VALUE, class COMP, class ALLOC>
 void TestDriver<KEY, VALUE, COMP, ALLOC>::testCase26()
 {
@@ -6579,7 +6714,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 27: {
+      case 29: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -6622,6 +6757,108 @@ int main(int argc, char *argv[])
             ASSERT(0 < objectAllocator.numBytesInUse());
         }
       } break;
+      case 28: {
+        // --------------------------------------------------------------------
+        // TESTING WINK-OUT
+        //
+        // Concerns:
+        //: 1 If the elements are wink-out safe and the allocator's
+        //:   'deallocate' is a no-op, the destructor does not destroy the
+        //:   elements.
+        //:
+        //: 2 The elements are destroyed if they are not wink-out safe, or if
+        //:   the allocator's 'deallocate' has an effect.
+        //:
+        //: 3 'bslma::IsWinkOutSafe' holds for a 'map' exactly if it holds for
+        //:   the key and mapped types, and the container uses a 'bslma'
+        //:   allocator.
+        //
+        // Plan:
+        //: 1 Using a 'bsltf::NoOpDeallocateTestAllocator', destroy a populated
+        //:   'map' of wink-out safe 'bsltf::DestructionCountingTestType'
+        //:   objects, and verify that none of them is destroyed.  (C-1)
+        //:
+        //: 2 Repeat P-1 with objects that are not wink-out safe, and again
+        //:   with a 'bslma::TestAllocator', and verify that every object is
+        //:   destroyed.  (C-2)
+        //:
+        //: 3 Verify 'bslma::IsWinkOutSafe' for several 'map' types at compile
+        //:   time.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: '~map' winks out when possible
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING WINK-OUT"
+                            "\n================\n");
+
+        typedef bsltf::DestructionCountingTestType<true>  SafeType;
+        typedef bsltf::DestructionCountingTestType<false> UnsafeType;
+
+        typedef bsl::map<int, SafeType> SafeObj;
+        typedef bsl::map<int, UnsafeType> UnsafeObj;
+
+        typedef bsltf::StdTestAllocator<bsl::pair<const int, int> > StdAlloc;
+        typedef bsl::map<int, int, std::less<int>, StdAlloc> StdAllocObj;
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<SafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<UnsafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<StdAllocObj>::value);
+
+        const int NUM_ELEMENTS = 16;
+
+        if (verbose) printf("\nWink out with a no-op 'deallocate'.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+            {
+                SafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(SafeObj::value_type(i, SafeType(i)));
+                }
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    0 == SafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out for elements lacking the trait.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+            {
+                UnsafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(UnsafeObj::value_type(i, UnsafeType(i)));
+                }
+                UnsafeType::resetNumDestructions();
+            }
+            ASSERTV(UnsafeType::numDestructions(),
+                    NUM_ELEMENTS == UnsafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out with an effective 'deallocate'.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+            {
+                SafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(SafeObj::value_type(i, SafeType(i)));
+                }
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    NUM_ELEMENTS == SafeType::numDestructions());
+            ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        }
+      } break;
+      case 27: {
+        // --------------------------------------------------------------------
+        // TESTING 'compact'
+        // --------------------------------------------------------------------
+        RUN_EACH_TYPE(TestDriver,
+                      testCase27,
+                      BSLTF_TEMPLATETESTFACILITY_TEST_TYPES_REGULAR);
+        TestDriver<TestKeyType, TestValueType>::testCase27();
+      } break;
       case 26: {
         // --------------------------------------------------------------------
         // TESTING STANDARD INTERFACE COVERAGE
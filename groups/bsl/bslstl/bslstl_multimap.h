@@ -483,6 +483,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_allocator.h>
 #endif
 
+#ifndef INCLUDED_BSLSTL_ITERATORUTIL
+#include <bslstl_iteratorutil.h>
+#endif
+
 #ifndef INCLUDED_BSLSTL_MAPCOMPARATOR
 #include <bslstl_mapcomparator.h>
 #endif
@@ -797,7 +801,9 @@ class multimap {
         // "copy-constructible" (see {Requirements on 'KEY' and 'VALUE'}).
 
     ~multimap();
-        // Destroy this object;
+        // Destroy this object.  Note that the elements are neither destroyed
+        // nor deallocated if they are wink-out safe and the allocator of this
+        // object has a no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
     multimap& operator=(const multimap& rhs);
@@ -1277,6 +1283,15 @@ multimap<KEY, VALUE, COMPARATOR, ALLOCATOR>::multimap(
 , d_tree()
 {
     if (first != last) {
+        // Obtain the footprints of all the nodes at once if the length of the
+        // sequence is known.
+
+        size_type maxInsertions =
+              ::BloombergLP::bslstl::IteratorUtil::insertDistance(first, last);
+        if (maxInsertions) {
+            nodeFactory().reserveNodeCapacity(maxInsertions);
+        }
+
         BloombergLP::bslalg::RbTreeUtilTreeProctor<NodeFactory> proctor(
                                                                &d_tree,
                                                                &nodeFactory());
@@ -1356,7 +1371,9 @@ template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
 inline
 multimap<KEY, VALUE, COMPARATOR, ALLOCATOR>::~multimap()
 {
-    clear();
+    if (!nodeFactory().canWinkOutNodes()) {
+        clear();
+    }
 }
 
 // MANIPULATORS
@@ -1439,6 +1456,12 @@ inline
 void multimap<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert(INPUT_ITERATOR first,
                                                          INPUT_ITERATOR last)
 {
+    size_type maxInsertions =
+              ::BloombergLP::bslstl::IteratorUtil::insertDistance(first, last);
+    if (maxInsertions) {
+        nodeFactory().reserveNodeCapacity(maxInsertions);
+    }
+
     while (first != last) {
         insert(*first);
         ++first;
@@ -1551,7 +1574,7 @@ void multimap<KEY, VALUE, COMPARATOR, ALLOCATOR>::clear()
         BSLS_ASSERT_SAFE(0 < d_tree.numNodes());
         BSLS_ASSERT_SAFE(d_tree.firstNode() != d_tree.sentinel());
 
-        BloombergLP::bslalg::RbTreeUtil::deleteTree(&d_tree, &nodeFactory());
+        nodeFactory().deleteNodes(&d_tree);
     }
 #if defined(BSLS_ASSERT_SAFE_IS_ACTIVE)
     else {
@@ -1886,6 +1909,14 @@ struct UsesBslmaAllocator<bsl::multimap<KEY, VALUE, COMPARATOR, ALLOCATOR> >
     : bsl::is_convertible<Allocator*, ALLOCATOR>
 {};
 
+template <class KEY,   class VALUE, class COMPARATOR, class ALLOCATOR>
+struct IsWinkOutSafe<bsl::multimap<KEY, VALUE, COMPARATOR, ALLOCATOR> >
+    : bsl::integral_constant<bool,
+                             IsWinkOutSafe<KEY>::value
+                          && IsWinkOutSafe<VALUE>::value
+                          && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
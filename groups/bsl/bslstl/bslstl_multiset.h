@@ -415,6 +415,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_allocator.h>
 #endif
 
+#ifndef INCLUDED_BSLSTL_ITERATORUTIL
+#include <bslstl_iteratorutil.h>
+#endif
+
 #ifndef INCLUDED_BSLSTL_PAIR
 #include <bslstl_pair.h>
 #endif
@@ -682,7 +686,9 @@ class multiset {
         // "copy-constructible" (see {Requirements on 'KEY'}).
 
     ~multiset();
-        // Destroy this object.
+        // Destroy this object.  Note that the elements are neither destroyed
+        // nor deallocated if they are wink-out safe and the allocator of this
+        // object has a no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
     multiset<KEY, COMPARATOR, ALLOCATOR>&
@@ -1125,6 +1131,15 @@ multiset<KEY, COMPARATOR, ALLOCATOR>::multiset(
 , d_tree()
 {
     if (first != last) {
+        // Obtain the footprints of all the nodes at once if the length of the
+        // sequence is known.
+
+        size_type maxInsertions =
+              ::BloombergLP::bslstl::IteratorUtil::insertDistance(first, last);
+        if (maxInsertions) {
+            nodeFactory().reserveNodeCapacity(maxInsertions);
+        }
+
         BloombergLP::bslalg::RbTreeUtilTreeProctor<NodeFactory> proctor(
                                                                &d_tree,
                                                                &nodeFactory());
@@ -1203,7 +1218,9 @@ template <class KEY, class COMPARATOR, class ALLOCATOR>
 inline
 multiset<KEY, COMPARATOR, ALLOCATOR>::~multiset()
 {
-    clear();
+    if (!nodeFactory().canWinkOutNodes()) {
+        clear();
+    }
 }
 
 
@@ -1312,6 +1329,12 @@ inline
 void multiset<KEY, COMPARATOR, ALLOCATOR>::insert(INPUT_ITERATOR first,
                                                   INPUT_ITERATOR last)
 {
+    size_type maxInsertions =
+              ::BloombergLP::bslstl::IteratorUtil::insertDistance(first, last);
+    if (maxInsertions) {
+        nodeFactory().reserveNodeCapacity(maxInsertions);
+    }
+
     while (first != last) {
         insert(*first);
         ++first;
@@ -1401,7 +1424,7 @@ void multiset<KEY, COMPARATOR, ALLOCATOR>::clear()
         BSLS_ASSERT_SAFE(0 < d_tree.numNodes());
         BSLS_ASSERT_SAFE(d_tree.firstNode() != d_tree.sentinel());
 
-        BloombergLP::bslalg::RbTreeUtil::deleteTree(&d_tree, &nodeFactory());
+        nodeFactory().deleteNodes(&d_tree);
     }
 #if defined(BSLS_ASSERT_SAFE_IS_ACTIVE)
     else {
@@ -1726,6 +1749,13 @@ struct UsesBslmaAllocator<bsl::multiset<KEY, COMPARATOR, ALLOCATOR> >
     : bsl::is_convertible<Allocator*, ALLOCATOR>
 {};
 
+template <class KEY, class COMPARATOR, class ALLOCATOR>
+struct IsWinkOutSafe<bsl::multiset<KEY, COMPARATOR, ALLOCATOR> >
+    : bsl::integral_constant<bool,
+                             IsWinkOutSafe<KEY>::value
+                          && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
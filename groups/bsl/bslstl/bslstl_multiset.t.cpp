@@ -9,9 +9,11 @@
 #include <bslma_defaultallocatorguard.h>
 #include <bslma_testallocatormonitor.h>
 #include <bslma_usesbslmaallocator.h>
+#include <bslma_winkoututil.h>
 
 #include <bslmf_issame.h>
 #include <bslmf_haspointersemantics.h>
+#include <bslmf_nestedtraitdeclaration.h>
 
 #include <bsls_alignmentutil.h>
 #include <bsls_asserttest.h>
@@ -20,6 +22,8 @@
 #include <algorithm>
 #include <functional>
 
+#include <bsltf_destructioncountingtesttype.h>
+#include <bsltf_noopdeallocatetestallocator.h>
 #include <bsltf_templatetestfacility.h>
 #include <bsltf_testvaluesarray.h>
 #include <bsltf_stdtestallocator.h>
@@ -150,7 +154,8 @@ using namespace bsl;
 //
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [21] USAGE EXAMPLE
+// [26] CONCERN: '~multiset' winks out when possible
+// [27] USAGE EXAMPLE
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(multiset<T,A> *object, const char *spec, int verbose = 1);
@@ -778,6 +783,7 @@ bool lessThanFunction(const TYPE& lhs, const TYPE& rhs)
 
 }  // close unnamed namespace
 
+
 // ============================================================================
 //                     GLOBAL TYPEDEFS FOR TESTING
 // ----------------------------------------------------------------------------
@@ -6406,7 +6412,7 @@ int main(int argc, char *argv[])
     bslma::Default::setDefaultAllocator(&defaultAllocator);
 
     switch (test) { case 0:
-      case 26: {
+      case 27: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -6454,6 +6460,98 @@ int main(int argc, char *argv[])
         }
 
       } break;
+      case 26: {
+        // --------------------------------------------------------------------
+        // TESTING WINK-OUT
+        //
+        // Concerns:
+        //: 1 If the elements are wink-out safe and the allocator's
+        //:   'deallocate' is a no-op, the destructor does not destroy the
+        //:   elements.
+        //:
+        //: 2 The elements are destroyed if they are not wink-out safe, or if
+        //:   the allocator's 'deallocate' has an effect.
+        //:
+        //: 3 'bslma::IsWinkOutSafe' holds for a 'multiset' exactly if it holds
+        //:   for the element type, and the container uses a 'bslma' allocator.
+        //
+        // Plan:
+        //: 1 Using a 'bsltf::NoOpDeallocateTestAllocator', destroy a populated
+        //:   'multiset' of wink-out safe 'bsltf::DestructionCountingTestType'
+        //:   objects, and verify that none of them is destroyed.  (C-1)
+        //:
+        //: 2 Repeat P-1 with objects that are not wink-out safe, and again
+        //:   with a 'bslma::TestAllocator', and verify that every object is
+        //:   destroyed.  (C-2)
+        //:
+        //: 3 Verify 'bslma::IsWinkOutSafe' for several 'multiset' types at
+        //:   compile time.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: '~multiset' winks out when possible
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING WINK-OUT"
+                            "\n================\n");
+
+        typedef bsltf::DestructionCountingTestType<true>  SafeType;
+        typedef bsltf::DestructionCountingTestType<false> UnsafeType;
+
+        typedef bsl::multiset<SafeType> SafeObj;
+        typedef bsl::multiset<UnsafeType> UnsafeObj;
+
+        typedef bsltf::StdTestAllocator<int> StdAlloc;
+        typedef bsl::multiset<int, std::less<int>, StdAlloc> StdAllocObj;
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<SafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<UnsafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<StdAllocObj>::value);
+
+        const int NUM_ELEMENTS = 16;
+
+        if (verbose) printf("\nWink out with a no-op 'deallocate'.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+            {
+                SafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(SafeType(i));
+                }
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    0 == SafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out for elements lacking the trait.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+            {
+                UnsafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(UnsafeType(i));
+                }
+                UnsafeType::resetNumDestructions();
+            }
+            ASSERTV(UnsafeType::numDestructions(),
+                    NUM_ELEMENTS == UnsafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out with an effective 'deallocate'.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+            {
+                SafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(SafeType(i));
+                }
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    NUM_ELEMENTS == SafeType::numDestructions());
+            ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        }
+      } break;
       case 25: {
         // --------------------------------------------------------------------
         // TESTING STANDARD INTERFACE COVERAGE
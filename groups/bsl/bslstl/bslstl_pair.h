@@ -259,6 +259,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_usesbslmaallocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISBITWISEEQUALITYCOMPARABLE
 #include <bslmf_isbitwiseequalitycomparable.h>
 #endif
@@ -1036,6 +1040,12 @@ struct UsesBslmaAllocator<bsl::pair<T1, T2> >
                                    || UsesBslmaAllocator<T2>::value>
 {};
 
+template <typename T1, typename T2>
+struct IsWinkOutSafe<bsl::pair<T1, T2> >
+    : bsl::integral_constant<bool, IsWinkOutSafe<T1>::value
+                                   && IsWinkOutSafe<T2>::value>
+{};
+
 }  // close namespace bslma
 
 }  // close namespace BloombergLP
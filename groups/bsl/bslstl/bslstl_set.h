@@ -469,6 +469,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_allocator.h>
 #endif
 
+#ifndef INCLUDED_BSLSTL_ITERATORUTIL
+#include <bslstl_iteratorutil.h>
+#endif
+
 #ifndef INCLUDED_BSLSTL_PAIR
 #include <bslstl_pair.h>
 #endif
@@ -735,7 +739,9 @@ class set {
         // "copy-constructible" (see {Requirements on 'KEY'}).
 
     ~set();
-        // Destroy this object.
+        // Destroy this object.  Note that the elements are neither destroyed
+        // nor deallocated if they are wink-out safe and the allocator of this
+        // object has a no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
     set& operator=(const set& rhs);
@@ -1182,6 +1188,15 @@ set<KEY, COMPARATOR, ALLOCATOR>::set(INPUT_ITERATOR    first,
 , d_tree()
 {
     if (first != last) {
+        // Obtain the footprints of all the nodes at once if the length of the
+        // sequence is known.
+
+        size_type maxInsertions =
+              ::BloombergLP::bslstl::IteratorUtil::insertDistance(first, last);
+        if (maxInsertions) {
+            nodeFactory().reserveNodeCapacity(maxInsertions);
+        }
+
         BloombergLP::bslalg::RbTreeUtilTreeProctor<NodeFactory> proctor(
                                                                &d_tree,
                                                                &nodeFactory());
@@ -1263,7 +1278,9 @@ template <class KEY, class COMPARATOR, class ALLOCATOR>
 inline
 set<KEY, COMPARATOR, ALLOCATOR>::~set()
 {
-    clear();
+    if (!nodeFactory().canWinkOutNodes()) {
+        clear();
+    }
 }
 
 // MANIPULATORS
@@ -1379,6 +1396,18 @@ inline
 void set<KEY, COMPARATOR, ALLOCATOR>::insert(INPUT_ITERATOR first,
                                              INPUT_ITERATOR last)
 {
+    // Obtain the footprints of all the nodes at once only if this set is
+    // empty: otherwise, values whose keys are already present would leave
+    // their reserved footprints unused for the lifetime of the node pool.
+
+    if (empty()) {
+        size_type maxInsertions =
+              ::BloombergLP::bslstl::IteratorUtil::insertDistance(first, last);
+        if (maxInsertions) {
+            nodeFactory().reserveNodeCapacity(maxInsertions);
+        }
+    }
+
     while (first != last) {
         insert(*first);
         ++first;
@@ -1464,7 +1493,7 @@ void set<KEY, COMPARATOR, ALLOCATOR>::clear()
         BSLS_ASSERT_SAFE(0 < d_tree.numNodes());
         BSLS_ASSERT_SAFE(d_tree.firstNode() != d_tree.sentinel());
 
-        BloombergLP::bslalg::RbTreeUtil::deleteTree(&d_tree, &nodeFactory());
+        nodeFactory().deleteNodes(&d_tree);
     }
 #if defined(BSLS_ASSERT_SAFE_IS_ACTIVE)
     else {
@@ -1783,6 +1812,13 @@ struct UsesBslmaAllocator<bsl::set<KEY, COMPARATOR, ALLOCATOR> >
     : bsl::is_convertible<Allocator*, ALLOCATOR>
 {};
 
+template <class KEY,  class COMPARATOR,  class ALLOCATOR>
+struct IsWinkOutSafe<bsl::set<KEY, COMPARATOR, ALLOCATOR> >
+    : bsl::integral_constant<bool,
+                             IsWinkOutSafe<KEY>::value
+                          && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -42,6 +42,19 @@ BSLS_IDENT("$Id: $")
 // each time a chunk is allocated up to an implementation defined maximum
 // number of blocks.
 //
+///Batch Allocation
+///----------------
+// A node-based container that inserts or removes many elements at once can
+// obtain or return all of their memory blocks in one call.  'allocateN'
+// returns a "chain" of blocks, in which the first 'sizeof(void *)' bytes of
+// each block hold the address of the next block, and those of the last block
+// hold 0; any shortfall of free blocks is allocated as a single chunk,
+// bypassing the doubling of the chunk size.  'deallocateN' returns a chain,
+// identified by its first and last blocks, to the pool in constant time.
+// 'reserveCapacity' ensures that a number of blocks are free without
+// detaching them, so that a sequence of calls to 'allocate' can be satisfied
+// from a single chunk.
+//
 ///Comparison with 'bdema_Pool'
 ///----------------------------
 // There are a few differences between 'bslstl::SimplePool' and 'bdema_Pool':
@@ -290,9 +303,16 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
         // This 'union' prepends to the beginning of each managed block of
         // allocated memory, implementing a singly-linked list of managed
         // chunks, and thereby enabling constant-time additions to the list of
-        // chunks.
+        // chunks.  Each chunk records its own size so that it can be returned
+        // to the allocator with the same count with which it was allocated.
+
+        struct Header {
+            Chunk *d_next_p;  // pointer to next Chunk
 
-        Chunk *d_next_p;  // pointer to next Chunk
+            typename Types::AllocatorTraits::size_type d_numUnits;
+                              // number of 'MaxAlignedType' objects allocated
+                              // for this chunk
+        } d_header;
 
         typename bsls::AlignmentFromType<Block>::Type d_alignment;
                           // ensure each block is correctly aligned
@@ -361,18 +381,45 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
         // Return the address of a block of memory of at least the size of
         // 'VALUE'.  Note that the memory is *not* initialized.
 
+    VALUE *allocateN(size_type numBlocks);
+        // Return the address of the first of a chain of the specified
+        // 'numBlocks' blocks of memory, each of at least the size of 'VALUE',
+        // in which the first 'sizeof(void *)' bytes of each block hold the
+        // address of the next block in the chain, and those of the last block
+        // hold 0.  If fewer than 'numBlocks' blocks are free, the shortfall
+        // is allocated as a single chunk.  The behavior is undefined unless
+        // '0 < numBlocks'.  Note that the memory is otherwise *not*
+        // initialized.
+
     void deallocate(void *address);
         // Relinquish the memory block at the specified 'address' back to this
         // pool object for reuse.  The behavior is undefined unless 'address'
         // is non-zero, was allocated by this pool, and has not already been
         // deallocated.
 
+    void deallocateN(void *first, void *last);
+        // Relinquish the chain of memory blocks starting at the specified
+        // 'first' block and ending at the specified 'last' block back to this
+        // pool object for reuse, in which the first 'sizeof(void *)' bytes of
+        // each block other than 'last' hold the address of the next block in
+        // the chain.  The behavior is undefined unless 'first' and 'last' are
+        // non-zero, 'last' is reachable from 'first', and each block in the
+        // chain was allocated by this pool and has not already been
+        // deallocated.  Note that this operation takes constant time.
+
     void reserve(size_type numBlocks);
         // Dynamically allocate a new chunk containing the specified
         // 'numBlocks' number of blocks, and use the chunk to replenish the
         // free memory list of this pool.  The behavior is undefined unless
         // '0 < numBlocks'.
 
+    void reserveCapacity(size_type numBlocks);
+        // Ensure that at least the specified 'numBlocks' blocks are free in
+        // this pool, allocating the shortfall, if any, as a single chunk.
+        // The behavior is undefined unless '0 < numBlocks'.  Note that,
+        // unlike 'reserve', blocks that are already free count towards
+        // 'numBlocks'.
+
     void release();
         // Relinquish all memory currently allocated via this pool object.
 
@@ -425,8 +472,9 @@ SimplePool<VALUE, ALLOCATOR>::allocateChunk(size_type size)
     BSLS_ASSERT_SAFE(0 ==
              reinterpret_cast<bsls::Types::UintPtr>(chunkPtr) % sizeof(Chunk));
 
-    chunkPtr->d_next_p = d_chunkList_p;
-    d_chunkList_p      = chunkPtr;
+    chunkPtr->d_header.d_next_p   = d_chunkList_p;
+    chunkPtr->d_header.d_numUnits = numMaxAlignedType;
+    d_chunkList_p                 = chunkPtr;
 
     return reinterpret_cast<Block *>(chunkPtr + 1);
 }
@@ -483,6 +531,24 @@ VALUE *SimplePool<VALUE, ALLOCATOR>::allocate()
     return block;
 }
 
+template <class VALUE, class ALLOCATOR>
+VALUE *SimplePool<VALUE, ALLOCATOR>::allocateN(size_type numBlocks)
+{
+    BSLS_ASSERT(0 < numBlocks);
+
+    reserveCapacity(numBlocks);
+
+    Block *first = d_freeList_p;
+    Block *last  = first;
+    for (size_type i = 1; i < numBlocks; ++i) {
+        last = last->d_next_p;
+    }
+    d_freeList_p   = last->d_next_p;
+    last->d_next_p = 0;
+
+    return reinterpret_cast<VALUE *>(first);
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 void SimplePool<VALUE, ALLOCATOR>::deallocate(void *address)
@@ -493,6 +559,17 @@ void SimplePool<VALUE, ALLOCATOR>::deallocate(void *address)
     d_freeList_p = reinterpret_cast<Block *>(address);
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+void SimplePool<VALUE, ALLOCATOR>::deallocateN(void *first, void *last)
+{
+    BSLS_ASSERT_SAFE(first);
+    BSLS_ASSERT_SAFE(last);
+
+    reinterpret_cast<Block *>(last)->d_next_p = d_freeList_p;
+    d_freeList_p = reinterpret_cast<Block *>(first);
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 void SimplePool<VALUE, ALLOCATOR>::swap(SimplePool<VALUE, ALLOCATOR>& other)
@@ -539,6 +616,21 @@ void SimplePool<VALUE, ALLOCATOR>::reserve(size_type numBlocks)
     d_freeList_p  = begin;
 }
 
+template <class VALUE, class ALLOCATOR>
+void SimplePool<VALUE, ALLOCATOR>::reserveCapacity(size_type numBlocks)
+{
+    BSLS_ASSERT(0 < numBlocks);
+
+    size_type numFree = 0;
+    for (Block *p = d_freeList_p; p && numFree < numBlocks; p = p->d_next_p) {
+        ++numFree;
+    }
+
+    if (numFree < numBlocks) {
+        reserve(numBlocks - numFree);
+    }
+}
+
 // ACCESSORS
 template <class VALUE, class ALLOCATOR>
 inline
@@ -555,8 +647,9 @@ void SimplePool<VALUE, ALLOCATOR>::release()
         typename AllocatorTraits::value_type *lastChunk =
                       reinterpret_cast<typename AllocatorTraits::value_type *>(
                                                                 d_chunkList_p);
-        d_chunkList_p   = d_chunkList_p->d_next_p;
-        AllocatorTraits::deallocate(allocator(), lastChunk, 1);
+        size_type numUnits = d_chunkList_p->d_header.d_numUnits;
+        d_chunkList_p      = d_chunkList_p->d_header.d_next_p;
+        AllocatorTraits::deallocate(allocator(), lastChunk, numUnits);
     }
     d_freeList_p = 0;
 }
@@ -45,8 +45,11 @@ using namespace bslstl;
 // MANIPULATORS
 // [ 4] AllocatorType& allocator();
 // [ 2] VALUE *allocate();
+// [10] VALUE *allocateN(size_type numBlocks);
 // [ 5] void deallocate(void *address);
+// [10] void deallocateN(void *first, void *last);
 // [ 6] void reserve(std::size_t numBlocks);
+// [10] void reserveCapacity(size_type numBlocks);
 // [ 7] void release();
 // [ 8] void swap(SimplePool<VALUE, ALLOCATOR>& other);
 //
@@ -54,7 +57,7 @@ using namespace bslstl;
 // [ 4] const AllocatorType& allocator() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [10] USAGE EXAMPLE
+// [11] USAGE EXAMPLE
 // [ 9] CONCERN: Standard allocator can be used
 // [ 3] TEST APPARATUS
 
@@ -259,7 +262,7 @@ class TestDriver {
   public:
     // TEST CASES
     static void testCase10();
-        // Test usage example.
+        // Test 'allocateN', 'deallocateN', and 'reserveCapacity'.
 
     static void testCase9();
         // Test alignment concern.
@@ -343,6 +346,174 @@ void TestDriver<VALUE>::createFreeBlocks(Obj *result, int numBlocks)
     }
 }
 
+template<class VALUE>
+void TestDriver<VALUE>::testCase10()
+{
+    // ------------------------------------------------------------------------
+    // MANIPULATORS 'allocateN', 'deallocateN', AND 'reserveCapacity'
+    //
+    // Concerns:
+    //: 1 'allocateN' returns a null-terminated chain of exactly the specified
+    //:   number of distinct blocks.
+    //:
+    //: 2 'allocateN' and 'reserveCapacity' use the free blocks first, and
+    //:   allocate any shortfall from the object allocator as a single chunk.
+    //:
+    //: 3 'deallocateN' returns the whole chain to the free list, and its
+    //:   blocks are dispensed again, in chain order, by 'allocate'.
+    //:
+    //: 4 Memory is deallocated on the destruction of the object.
+    //:
+    //: 5 QoI: Asserted precondition violations are detected when enabled.
+    //
+    // Plan:
+    //: 1 For each different values of i from 1 to 7:
+    //:
+    //:   1 For each different values of j from 0 to 7:
+    //:
+    //:     1 Create 'j' memory blocks in the free list.
+    //:
+    //:     2 Call 'allocateN' for 'i' blocks, and verify that exactly one
+    //:       block is allocated from the object allocator if and only if
+    //:       'j < i'.  (C-2)
+    //:
+    //:     3 Walk the chain, verifying its length and the distinctness of its
+    //:       blocks, and write to each block.  (C-1)
+    //:
+    //:     4 Relink the chain and return it with 'deallocateN', then invoke
+    //:       'allocate' 'i' times, and verify that the blocks of the chain
+    //:       are returned in order and that no memory is allocated.  (C-3)
+    //:
+    //:     5 Create a new object with 'j' free blocks, call 'reserveCapacity'
+    //:       for 'i' blocks, and verify the memory allocated as in P-1.1.2;
+    //:       then invoke 'allocate' 'max(i, j)' times, and verify that no
+    //:       memory is allocated.  (C-2)
+    //:
+    //: 2 Verify all memory is deallocated on destruction.  (C-4)
+    //:
+    //: 3 Verify that, in appropriate build modes, defensive checks are
+    //:   triggered for invalid arguments.  (C-5)
+    //
+    // Testing:
+    //   VALUE *allocateN(size_type numBlocks);
+    //   void deallocateN(void *first, void *last);
+    //   void reserveCapacity(size_type numBlocks);
+    // ------------------------------------------------------------------------
+
+    if (verbose) printf("\nMANIPULATORS 'allocateN', 'deallocateN', AND"
+                        " 'reserveCapacity'"
+                        "\n==============================================="
+                        "==================\n");
+
+    enum { MAX_BLOCKS = 8 };
+
+    for (int ti = 1; ti < MAX_BLOCKS; ++ti) {
+        for(int tj = 0; tj < MAX_BLOCKS; ++tj) {
+            bslma::TestAllocator oa("object",  veryVeryVeryVerbose);
+            bslma::TestAllocator da("default", veryVeryVeryVerbose);
+
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            const int EXP_ALLOC = tj < ti ? 1 : 0;
+
+            if (veryVerbose) printf("'allocateN' and 'deallocateN'\n");
+            {
+                Obj mX(&oa);
+
+                createFreeBlocks(&mX, tj);
+
+                bslma::TestAllocatorMonitor oam(&oa);
+
+                VALUE *first = mX.allocateN(ti);
+
+                ASSERTV(ti, tj, oam.numBlocksInUseChange(),
+                        EXP_ALLOC == oam.numBlocksInUseChange());
+
+                void *chain[MAX_BLOCKS];
+                int   length = 0;
+                for (void *p = first; p; p = *static_cast<void **>(p)) {
+                    ASSERTV(ti, tj, length < ti);
+                    if (length == ti) {
+                        break;
+                    }
+                    for (int tk = 0; tk < length; ++tk) {
+                        ASSERTV(ti, tj, tk, chain[tk] != p);
+                    }
+                    chain[length++] = p;
+                }
+                ASSERTV(ti, tj, length, ti == length);
+
+                for (int tk = 0; tk < length; ++tk) {
+                    memset(chain[tk], 0xFF, sizeof(VALUE));
+                }
+                for (int tk = 0; tk < length - 1; ++tk) {
+                    *static_cast<void **>(chain[tk]) = chain[tk + 1];
+                }
+
+                mX.deallocateN(first, chain[length - 1]);
+
+                for (int tk = 0; tk < length; ++tk) {
+                    ASSERTV(ti, tj, tk, chain[tk] == mX.allocate());
+                }
+                ASSERTV(ti, tj, EXP_ALLOC == oam.numBlocksInUseChange());
+            }
+
+            if (veryVerbose) printf("'reserveCapacity'\n");
+            {
+                Obj mX(&oa);
+
+                createFreeBlocks(&mX, tj);
+
+                bslma::TestAllocatorMonitor oam(&oa);
+
+                mX.reserveCapacity(ti);
+
+                ASSERTV(ti, tj, oam.numBlocksInUseChange(),
+                        EXP_ALLOC == oam.numBlocksInUseChange());
+
+                const int NUM_FREE = ti < tj ? tj : ti;
+                for (int tk = 0; tk < NUM_FREE; ++tk) {
+                    mX.allocate();
+                }
+                ASSERTV(ti, tj, EXP_ALLOC == oam.numBlocksInUseChange());
+            }
+
+            ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+            ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+        }
+    }
+
+    if (verbose) printf("\nNegative Testing.\n");
+    {
+        bsls::AssertFailureHandlerGuard hG(bsls::AssertTest::failTestDriver);
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        Obj mX(&oa);
+
+        if (veryVerbose) printf("\t'allocateN'\n");
+        {
+            ASSERT_SAFE_FAIL(mX.allocateN(0));
+            ASSERT_SAFE_PASS(mX.deallocate(mX.allocateN(1)));
+        }
+
+        if (veryVerbose) printf("\t'deallocateN'\n");
+        {
+            VALUE *p = mX.allocate();
+
+            ASSERT_SAFE_FAIL(mX.deallocateN(0, p));
+            ASSERT_SAFE_FAIL(mX.deallocateN(p, 0));
+            ASSERT_SAFE_PASS(mX.deallocateN(p, p));
+        }
+
+        if (veryVerbose) printf("\t'reserveCapacity'\n");
+        {
+            ASSERT_SAFE_FAIL(mX.reserveCapacity(0));
+            ASSERT_SAFE_PASS(mX.reserveCapacity(1));
+        }
+    }
+}
+
 template<class VALUE>
 void TestDriver<VALUE>::testCase9()
 {
@@ -1266,7 +1437,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
-      case 10: {
+      case 11: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -1312,6 +1483,9 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 10: {
+          RUN_EACH_TYPE(TestDriver, testCase10, TEST_TYPES);
+      } break;
       case 9: {
         // --------------------------------------------------------------------
         // ALIGNMENT TEST
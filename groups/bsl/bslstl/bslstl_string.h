@@ -613,6 +613,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_usesbslmaallocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ASSERT
 #include <bslmf_assert.h>
 #endif
@@ -5712,6 +5716,11 @@ struct UsesBslmaAllocator<bsl::basic_string<CHAR_TYPE, CHAR_TRAITS, ALLOC> >
     : bsl::is_convertible<Allocator *, ALLOC>
 {};
 
+template <class CHAR_TYPE, class CHAR_TRAITS, class ALLOC>
+struct IsWinkOutSafe<bsl::basic_string<CHAR_TYPE, CHAR_TRAITS, ALLOC> >
+    : bsl::is_convertible<Allocator *, ALLOC>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -230,18 +230,39 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_treenode.h>
 #endif
 
+#ifndef INCLUDED_BSLALG_RBTREEANCHOR
+#include <bslalg_rbtreeanchor.h>
+#endif
+
 #ifndef INCLUDED_BSLALG_RBTREENODE
 #include <bslalg_rbtreenode.h>
 #endif
 
+#ifndef INCLUDED_BSLALG_RBTREEUTIL
+#include <bslalg_rbtreeutil.h>
+#endif
+
 #ifndef INCLUDED_BSLMA_DEALLOCATORPROCTOR
 #include <bslma_deallocatorproctor.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
 #ifndef INCLUDED_BSLS_UTIL
 #include <bsls_util.h>
 #endif
 
+#ifndef INCLUDED_CSTRING
+#include <cstring>
+#define INCLUDED_CSTRING
+#endif
+
 namespace BloombergLP {
 namespace bslstl {
 
@@ -264,6 +285,44 @@ class TreeNodePool {
     typedef typename Pool::AllocatorTraits         AllocatorTraits;
         // Alias for the allocator traits defined by 'SimplePool'.
 
+    class NodeChain {
+        // This class provides the 'deleteNode' method required of a 'FACTORY'
+        // by 'bslalg::RbTreeUtil::deleteTree'.  Each node passed to
+        // 'deleteNode' has its value destroyed and its footprint linked into
+        // a chain, which is returned to the pool in a single batch on
+        // destruction.
+
+        // DATA
+        TreeNodePool    *d_nodePool_p;  // pool owning the nodes (held, not
+                                        // owned)
+
+        TreeNode<VALUE> *d_first_p;     // first node in the chain, or 0
+
+        TreeNode<VALUE> *d_last_p;      // last node in the chain, or 0
+
+      private:
+        // NOT IMPLEMENTED
+        NodeChain& operator=(const NodeChain&);
+        NodeChain(const NodeChain&);
+
+      public:
+        // CREATORS
+        explicit NodeChain(TreeNodePool *nodePool);
+            // Create an empty chain of nodes to be returned to the specified
+            // 'nodePool'.
+
+        ~NodeChain();
+            // Return the footprints of the nodes in this chain, if any, to
+            // the pool supplied at construction.
+
+        // MANIPULATORS
+        void deleteNode(bslalg::RbTreeNode *node);
+            // Destroy the 'VALUE' value of the specified 'node' and add the
+            // memory footprint of 'node' to this chain.  The behavior is
+            // undefined unless 'node' refers to a 'TreeNode<VALUE>' allocated
+            // by the pool supplied at construction.
+    };
+
     // DATA
     Pool d_pool;  // pool for allocating memory
 
@@ -272,6 +331,18 @@ class TreeNodePool {
     TreeNodePool& operator=(const TreeNodePool&);
     TreeNodePool(const TreeNodePool&);
 
+    // PRIVATE MANIPULATORS
+    bslalg::RbTreeNode *relocateNode(const bslalg::RbTreeNode& original,
+                                     bsl::true_type);
+    bslalg::RbTreeNode *relocateNode(const bslalg::RbTreeNode& original,
+                                     bsl::false_type);
+        // Allocate a node object having the 'VALUE' of the specified
+        // 'original'.  The first overload, used when 'VALUE' is bitwise
+        // moveable, copies the bytes of the value, after which the value of
+        // 'original' must not be destroyed; the second copy-constructs the
+        // value.  The behavior is undefined unless 'original' refers to a
+        // 'TreeNode<VALUE>'.
+
   public:
     // PUBLIC TYPE
     typedef typename Pool::AllocatorType AllocatorType;
@@ -309,11 +380,38 @@ class TreeNodePool {
         // memory footprint of 'node' to this pool for potential reuse.  The
         // behavior is undefined unless 'node' refers to a 'TreeNode<VALUE>'.
 
+    void deleteNodes(bslalg::RbTreeAnchor *tree);
+        // Destroy the 'VALUE' value of each node in the specified 'tree',
+        // return the memory footprints of all of those nodes to this pool in
+        // a single batch, and reset 'tree' to the empty state.  The behavior
+        // is undefined unless each node in 'tree' refers to a
+        // 'TreeNode<VALUE>' allocated by this pool.
+
+    void compact(bslalg::RbTreeAnchor *tree);
+        // Re-allocate the nodes of the specified 'tree', in order, from a
+        // single newly-obtained chunk of memory, and then release all of the
+        // memory previously held by this pool.  The value of each node is
+        // moved with 'memcpy' if 'VALUE' is bitwise moveable, and is copied
+        // (then destroyed) otherwise.  If an exception is thrown, 'tree' and
+        // this pool are unchanged.  The behavior is undefined unless each
+        // node in 'tree' refers to a 'TreeNode<VALUE>' allocated by this
+        // pool, and no other node allocated by this pool is in use.  Note
+        // that an in-order traversal of 'tree' subsequently visits nodes in
+        // increasing address order.
+
     void reserveNodes(size_type numNodes);
         // Reserve memory from this pool to satisfy memory requests for at
         // least the specified 'numNodes' before the pool replenishes.  The
         // behavior is undefined unless '0 < numNodes'.
 
+    void reserveNodeCapacity(size_type numNodes);
+        // Ensure that memory requests for at least the specified 'numNodes'
+        // can be satisfied from this pool before it replenishes, obtaining
+        // the shortfall, if any, from the allocator in a single request.  The
+        // behavior is undefined unless '0 < numNodes'.  Note that, unlike
+        // 'reserveNodes', the footprints of previously deleted nodes count
+        // towards 'numNodes'.
+
     void swap(TreeNodePool<VALUE, ALLOCATOR>& other);
         // Efficiently exchange the management of nodes of this object and
         // the specified 'other' object.  The behavior is undefined unless the
@@ -325,12 +423,93 @@ class TreeNodePool {
         // allocator traits for the node-type.  Note that this operation
         // returns a base-class ('NodeAlloc') reference to this object.
 
+    bool canWinkOutNodes() const;
+        // Return 'true' if the nodes allocated by this pool may be abandoned
+        // without destroying their values or returning them to this pool,
+        // because 'VALUE' is wink-out safe and the allocator of this pool has
+        // a no-op 'deallocate' (see 'bslma_winkoututil'), and 'false'
+        // otherwise.  Note that abandoned nodes are not available for reuse.
+
 };
 
 // ===========================================================================
 //                  TEMPLATE AND INLINE FUNCTION DEFINITIONS
 // ===========================================================================
 
+              // ---------------------------------------------
+              // class TreeNodePool<VALUE, ALLOCATOR>::NodeChain
+              // ---------------------------------------------
+
+// CREATORS
+template <class VALUE, class ALLOCATOR>
+inline
+TreeNodePool<VALUE, ALLOCATOR>::NodeChain::NodeChain(TreeNodePool *nodePool)
+: d_nodePool_p(nodePool)
+, d_first_p(0)
+, d_last_p(0)
+{
+}
+
+template <class VALUE, class ALLOCATOR>
+inline
+TreeNodePool<VALUE, ALLOCATOR>::NodeChain::~NodeChain()
+{
+    if (d_first_p) {
+        d_nodePool_p->d_pool.deallocateN(d_first_p, d_last_p);
+    }
+}
+
+// MANIPULATORS
+template <class VALUE, class ALLOCATOR>
+inline
+void TreeNodePool<VALUE, ALLOCATOR>::NodeChain::deleteNode(
+                                                      bslalg::RbTreeNode *node)
+{
+    BSLS_ASSERT(node);
+
+    TreeNode<VALUE> *treeNode = static_cast<TreeNode<VALUE> *>(node);
+    AllocatorTraits::destroy(d_nodePool_p->allocator(),
+                             BSLS_UTIL_ADDRESSOF(treeNode->value()));
+
+    // Link the footprint through its first word, as expected by
+    // 'SimplePool::deallocateN'.
+
+    *reinterpret_cast<void **>(treeNode) = d_first_p;
+    d_first_p = treeNode;
+    if (!d_last_p) {
+        d_last_p = treeNode;
+    }
+}
+
+                       // ------------------
+                       // class TreeNodePool
+                       // ------------------
+
+// PRIVATE MANIPULATORS
+template <class VALUE, class ALLOCATOR>
+inline
+bslalg::RbTreeNode *TreeNodePool<VALUE, ALLOCATOR>::relocateNode(
+                                         const bslalg::RbTreeNode& original,
+                                         bsl::true_type)
+{
+    TreeNode<VALUE> *node = d_pool.allocate();
+
+    std::memcpy(static_cast<void *>(BSLS_UTIL_ADDRESSOF(node->value())),
+                BSLS_UTIL_ADDRESSOF(
+                   static_cast<const TreeNode<VALUE>&>(original).value()),
+                sizeof(VALUE));
+    return node;
+}
+
+template <class VALUE, class ALLOCATOR>
+inline
+bslalg::RbTreeNode *TreeNodePool<VALUE, ALLOCATOR>::relocateNode(
+                                         const bslalg::RbTreeNode& original,
+                                         bsl::false_type)
+{
+    return createNode(original);
+}
+
 // CREATORS
 template <class VALUE, class ALLOCATOR>
 inline
@@ -397,6 +576,63 @@ void TreeNodePool<VALUE, ALLOCATOR>::deleteNode(bslalg::RbTreeNode *node)
     d_pool.deallocate(treeNode);
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+void TreeNodePool<VALUE, ALLOCATOR>::deleteNodes(bslalg::RbTreeAnchor *tree)
+{
+    BSLS_ASSERT_SAFE(tree);
+
+    NodeChain chain(this);
+    bslalg::RbTreeUtil::deleteTree(tree, &chain);
+}
+
+template <class VALUE, class ALLOCATOR>
+void TreeNodePool<VALUE, ALLOCATOR>::compact(bslalg::RbTreeAnchor *tree)
+{
+    BSLS_ASSERT_SAFE(tree);
+
+    typedef typename bslmf::IsBitwiseMoveable<VALUE>::type IsBitwiseMoveable;
+
+    TreeNodePool         pool(allocator());
+    bslalg::RbTreeAnchor compacted;
+
+    if (tree->rootNode()) {
+        // Obtain all of the new nodes as one chunk, from which they are
+        // handed out in increasing address order.  Inserting them as
+        // successive right-most children rebuilds the tree in linear time
+        // without comparing any values.
+
+        pool.reserveNodes(tree->numNodes());
+
+        bslalg::RbTreeUtilTreeProctor<TreeNodePool> proctor(&compacted,
+                                                            &pool);
+
+        bslalg::RbTreeNode *prevNode = compacted.sentinel();
+        for (bslalg::RbTreeNode *node = tree->firstNode();
+             tree->sentinel() != node;
+             node = bslalg::RbTreeUtil::next(node)) {
+            bslalg::RbTreeNode *newNode =
+                               pool.relocateNode(*node, IsBitwiseMoveable());
+            bslalg::RbTreeUtil::insertAt(&compacted,
+                                         prevNode,
+                                         compacted.sentinel() == prevNode,
+                                         newNode);
+            prevNode = newNode;
+        }
+        proctor.release();
+
+        if (!IsBitwiseMoveable::value) {
+            deleteNodes(tree);
+        }
+    }
+
+    // Take the new nodes, leaving 'pool' to release the original chunks on
+    // destruction without destroying any values relocated out of them.
+
+    bslalg::RbTreeUtil::swap(tree, &compacted);
+    swap(pool);
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 void TreeNodePool<VALUE, ALLOCATOR>::reserveNodes(size_type numNodes)
@@ -406,6 +642,15 @@ void TreeNodePool<VALUE, ALLOCATOR>::reserveNodes(size_type numNodes)
     d_pool.reserve(numNodes);
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+void TreeNodePool<VALUE, ALLOCATOR>::reserveNodeCapacity(size_type numNodes)
+{
+    BSLS_ASSERT_SAFE(0 < numNodes);
+
+    d_pool.reserveCapacity(numNodes);
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 void TreeNodePool<VALUE, ALLOCATOR>::swap(
@@ -425,6 +670,13 @@ TreeNodePool<VALUE, ALLOCATOR>::allocator() const
     return d_pool.allocator();
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+bool TreeNodePool<VALUE, ALLOCATOR>::canWinkOutNodes() const
+{
+    return bslma::WinkOutUtil::canWinkOut<VALUE>(allocator());
+}
+
 }  // close namespace bslstl
 }  // close enterprise namespace
 
@@ -12,11 +12,14 @@
 #include <bslma_testallocatormonitor.h>
 #include <bslma_defaultallocatorguard.h>
 #include <bslma_default.h>
+#include <bslma_winkoututil.h>
 
 #include <bsls_assert.h>
 #include <bsls_asserttest.h>
 #include <bsls_bsltestutil.h>
 
+#include <bsltf_allocbitwisemoveabletesttype.h>
+#include <bsltf_noopdeallocatetestallocator.h>
 #include <bsltf_templatetestfacility.h>
 #include <bsltf_stdtestallocator.h>
 #include <bsltf_testvaluesarray.h>
@@ -52,14 +55,17 @@ using namespace bslstl;
 // [ 2] bslalg::RbTreeNode *createNode();
 // [ 7] bslalg::RbTreeNode *createNode(const bslalg::RbTreeNode& original);
 // [ 7] bslalg::RbTreeNode *createNode(const VALUE& value);
+// [ 9] void compact(bslalg::RbTreeAnchor *tree);
 // [ 5] void deleteNode(bslalg::RbTreeNode *node);
 // [ 6] void reserveNodes(std::size_t numNodes);
 // [ 8] void swap(TreeNodePool<VALUE, ALLOCATOR>& other);
 //
 // ACCESSORS
 // [ 4] const AllocatorType& allocator() const;
+// [10] bool canWinkOutNodes() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
+// [11] USAGE EXAMPLE
 //-----------------------------------------------------------------------------
 //=============================================================================
 
@@ -196,6 +202,29 @@ struct UsesBslmaAllocator<AllocatingIntType> : bsl::true_type {};
 //                               TEST FACILITIES
 //-----------------------------------------------------------------------------
 
+template <class VALUE>
+struct NodeComparator {
+    // This 'struct' orders 'TreeNode<VALUE>' objects by the identifier (see
+    // 'bsltf::TemplateTestFacility') of their values.
+
+    static int identifier(const RbNode& node)
+        // Return the identifier of the value of the specified 'node'.
+    {
+        typedef TreeNode<VALUE> Node;
+
+        return bsltf::TemplateTestFacility::getIdentifier(
+                                       static_cast<const Node&>(node).value());
+    }
+
+    bool operator()(const RbNode& lhs, const RbNode& rhs) const
+        // Return 'true' if the identifier of the value of the specified 'lhs'
+        // is less than that of the specified 'rhs', and 'false' otherwise.
+    {
+        return identifier(lhs) < identifier(rhs);
+    }
+};
+
+
 class Stack
 {
     enum { CAPACITY = 128 };
@@ -277,12 +306,18 @@ class TestDriver {
 
   public:
     // TEST CASES
-    // static void testCase10();
+    // static void testCase12();
         // Reserved for BSLX.
 
-    static void testCase9();
+    // static void testCase11();
         // Test usage example.
 
+    static void testCase10();
+        // Test 'canWinkOutNodes'.
+
+    static void testCase9();
+        // Test 'compact'.
+
     static void testCase8();
         // Test 'swap' member.
 
@@ -361,6 +396,208 @@ void TestDriver<VALUE>::createFreeBlocks(Obj   *result,
     }
 }
 
+template<class VALUE>
+void TestDriver<VALUE>::testCase10()
+{
+    // --------------------------------------------------------------------
+    // ACCESSOR 'canWinkOutNodes'
+    //
+    // Concerns:
+    //: 1 'canWinkOutNodes' returns 'true' if and only if 'VALUE' is wink-out
+    //:   safe and the allocator's mechanism has a no-op 'deallocate'.
+    //:
+    //: 2 'canWinkOutNodes' returns 'false' for an allocator that does not
+    //:   wrap a 'bslma::Allocator'.
+    //:
+    //: 3 'canWinkOutNodes' is declared 'const'.
+    //:
+    //: 4 No memory is allocated.
+    //
+    // Plan:
+    //: 1 Create pools using a 'bslma::TestAllocator' and a
+    //:   'bsltf::NoOpDeallocateTestAllocator', and verify, through a 'const'
+    //:   reference, that 'canWinkOutNodes' agrees with
+    //:   'bslma::IsWinkOutSafe<VALUE>' for the latter, and returns 'false'
+    //:   for the former.  (C-1, 3)
+    //:
+    //: 2 Create a pool using a 'bsltf::StdTestAllocator', and verify that
+    //:   'canWinkOutNodes' returns 'false'.  (C-2)
+    //:
+    //: 3 Verify that no memory is allocated.  (C-4)
+    //
+    // Testing:
+    //   bool canWinkOutNodes() const;
+    // --------------------------------------------------------------------
+
+    const bool EXP = bslma::IsWinkOutSafe<VALUE>::value;
+
+    if (verbose) printf("\nACCESSOR 'canWinkOutNodes'"
+                        "\n==========================\n");
+
+    bslma::TestAllocator da("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    {
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        Obj mX(&oa);  const Obj& X = mX;
+
+        ASSERTV(X.canWinkOutNodes(), !X.canWinkOutNodes());
+        ASSERTV(oa.numBlocksTotal(), 0 == oa.numBlocksTotal());
+    }
+    {
+        bsltf::NoOpDeallocateTestAllocator oa;
+
+        Obj mX(&oa);  const Obj& X = mX;
+
+        ASSERTV(EXP, X.canWinkOutNodes(), EXP == X.canWinkOutNodes());
+        ASSERTV(oa.numDeallocations(), 0 == oa.numDeallocations());
+    }
+    {
+        typedef bslstl::TreeNodePool<VALUE, StlAlloc> StlObj;
+
+        StlObj mX((StlAlloc()));  const StlObj& X = mX;
+
+        ASSERTV(X.canWinkOutNodes(), !X.canWinkOutNodes());
+    }
+
+    ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+}
+
+template<class VALUE>
+void TestDriver<VALUE>::testCase9()
+{
+    // --------------------------------------------------------------------
+    // MANIPULATOR 'compact'
+    //
+    // Concerns:
+    //: 1 'compact' preserves the ordered sequence of values in the tree, and
+    //:   the tree remains a valid red-black tree.
+    //:
+    //: 2 After 'compact', an in-order traversal of the tree visits nodes in
+    //:   increasing address order.
+    //:
+    //: 3 All of the memory previously held by the pool, including the
+    //:   footprints of deleted nodes, is released, and the nodes of the tree
+    //:   then occupy a single chunk.
+    //:
+    //: 4 Values are relocated without leaking, or releasing twice, the
+    //:   memory they own, whether or not 'VALUE' is bitwise moveable.
+    //:
+    //: 5 If an allocation fails, the tree and the pool are unchanged.
+    //:
+    //: 6 No memory is allocated from the default allocator.
+    //:
+    //: 7 QoI: Asserted precondition violations are detected when enabled.
+    //
+    // Plan:
+    //: 1 For a sequence of tree sizes, create nodes in decreasing order of
+    //:   identifier, insert those having an odd identifier into a tree, and
+    //:   delete the others, so that the pool holds free footprints and the
+    //:   nodes of the tree are neither contiguous nor in address order.
+    //:
+    //: 2 Invoke 'compact' in the presence of injected exceptions, verifying
+    //:   the values of the tree before each attempt.  (C-5)
+    //:
+    //: 3 Verify the values and validity of the tree, the addresses of its
+    //:   nodes, and the number of blocks in use from the object and default
+    //:   allocators.  Then delete the nodes, and verify that only the chunk
+    //:   remains in use.  (C-1..4, 6)
+    //:
+    //: 4 Verify that, in appropriate build modes, defensive checks are
+    //:   triggered (using the 'BSLS_ASSERTTEST_*' macros).  (C-7)
+    //
+    // Testing:
+    //   void compact(bslalg::RbTreeAnchor *tree);
+    // --------------------------------------------------------------------
+
+    typedef NodeComparator<VALUE> Comparator;
+
+    bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    const Comparator COMPARATOR = Comparator();
+
+    const int SIZES[]   = { 0, 1, 2, 3, 5, 8, 13, 40 };
+    const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+    for (int ti = 0; ti < NUM_SIZES; ++ti) {
+        const int SIZE = SIZES[ti];
+
+        if (veryVerbose) { T_ P(SIZE) }
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        {
+            Obj                  mX(&oa);
+            bslalg::RbTreeAnchor tree;
+
+            for (int i = 2 * SIZE - 1; i >= 0; --i) {
+                RbNode *node = mX.createNode();
+                static_cast<ValueNode *>(node)->value().setData(i);
+                if (i % 2) {
+                    bslalg::RbTreeUtil::insert(&tree, COMPARATOR, node);
+                }
+                else {
+                    mX.deleteNode(node);
+                }
+            }
+            ASSERTV(SIZE, SIZE == tree.numNodes());
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+                int i = 0;
+                for (const RbNode *node = tree.firstNode();
+                     tree.sentinel() != node;
+                     node = bslalg::RbTreeUtil::next(node), ++i) {
+                    ASSERTV(SIZE, i, 2 * i + 1 ==
+                                             Comparator::identifier(*node));
+                }
+                ASSERTV(SIZE, i, SIZE == i);
+
+                mX.compact(&tree);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            ASSERTV(SIZE, SIZE == tree.numNodes());
+            ASSERTV(SIZE, bslalg::RbTreeUtil::isWellFormed(tree, COMPARATOR));
+
+            int           i    = 0;
+            const RbNode *prev = 0;
+            for (const RbNode *node = tree.firstNode();
+                 tree.sentinel() != node;
+                 node = bslalg::RbTreeUtil::next(node), ++i) {
+                ASSERTV(SIZE, i, 2 * i + 1 == Comparator::identifier(*node));
+                ASSERTV(SIZE, i, prev < node);
+                prev = node;
+            }
+            ASSERTV(SIZE, i, SIZE == i);
+
+            // One chunk, and the memory owned by each value.
+
+            const int NUM_CHUNKS = SIZE ? 1 : 0;
+            ASSERTV(SIZE, oa.numBlocksInUse(),
+                    NUM_CHUNKS + SIZE == oa.numBlocksInUse());
+            ASSERTV(SIZE, da.numBlocksTotal(), 0 == da.numBlocksTotal());
+
+            mX.deleteNodes(&tree);
+            ASSERTV(SIZE, oa.numBlocksInUse(),
+                    NUM_CHUNKS == oa.numBlocksInUse());
+        }
+        ASSERTV(SIZE, oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+    }
+
+    if (verbose) printf("\nNegative Testing.\n");
+    {
+        bsls::AssertFailureHandlerGuard hG(bsls::AssertTest::failTestDriver);
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        Obj                  mX(&oa);
+        bslalg::RbTreeAnchor tree;
+
+        ASSERT_SAFE_PASS(mX.compact(&tree));
+        ASSERT_SAFE_FAIL(mX.compact(0));
+    }
+}
+
 template<class VALUE>
 void TestDriver<VALUE>::testCase8()
 {
@@ -1309,7 +1546,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
-      case 9: {
+      case 11: {
         if (verbose) printf("\nUSAGE EXAMPLE"
                             "\n=============\n");
 
@@ -1344,6 +1581,14 @@ int main(int argc, char *argv[])
     ASSERT(0 <  objectAllocator.numBytesInUse());
 //..
       } break;
+      case 10: {
+        TestDriver<int>::testCase10();
+        TestDriver<bsltf::AllocTestType>::testCase10();
+      } break;
+      case 9: {
+        TestDriver<bsltf::AllocTestType>::testCase9();
+        TestDriver<bsltf::AllocBitwiseMoveableTestType>::testCase9();
+      } break;
       case 8: {
         TestDriver<bsltf::AllocTestType>::testCase8();
       } break;
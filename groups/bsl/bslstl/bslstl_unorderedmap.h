@@ -919,6 +919,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_usesbslmaallocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
 #include <bslmf_isbitwisemoveable.h>
 #endif
@@ -1133,7 +1137,10 @@ class unordered_map {
         // strategy of the hash-table (but never fewer).
 
     ~unordered_map();
-        // Destroy this object and each of its elements.
+        // Destroy this object and each of its elements.  Note that the
+        // elements are neither destroyed nor deallocated if they are wink-out
+        // safe and the allocator of this object has a no-op 'deallocate' (see
+        // 'bslma_winkoututil').
 
     // MANIPULATORS
     unordered_map& operator=(const unordered_map& rhs);
@@ -1192,6 +1199,17 @@ class unordered_map {
         // unordered map will be empty after this call, but allocated memory
         // may be retained for future use.
 
+    void compact();
+        // Re-allocate the nodes of this unordered map, in iteration order,
+        // from a single newly-obtained block of memory, and release all of
+        // the memory previously used for nodes (including any retained for
+        // reuse), so that iterating over this unordered map visits memory in
+        // increasing address order.  Each 'value_type' object is moved with
+        // 'memcpy' if it is bitwise moveable, and is copied (then destroyed)
+        // otherwise; no keys are rehashed.  All iterators, pointers, and
+        // references to elements of this unordered map are invalidated.  If
+        // an exception is thrown, this unordered map is unchanged.
+
     iterator erase(const_iterator position);
         // Remove from this unordered map the 'value_type' object at the
         // specified 'position', and return an iterator referring to the
@@ -1630,6 +1648,14 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::clear()
     d_impl.removeAll();
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+inline
+void
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::compact()
+{
+    d_impl.compact();
+}
+
 
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
@@ -2098,6 +2124,14 @@ struct UsesBslmaAllocator<bsl::unordered_map<KEY,
      : bsl::is_convertible<Allocator*, ALLOCATOR>::type
 {};
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+struct IsWinkOutSafe<bsl::unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR> >
+    : bsl::integral_constant<bool,
+                             IsWinkOutSafe<KEY>::value
+                          && IsWinkOutSafe<VALUE>::value
+                          && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close namespace bslma
 
 }  // close enterprise namespace
@@ -15,6 +15,7 @@
 #include <bslma_testallocator.h>
 #include <bslma_testallocatormonitor.h>
 #include <bslma_usesbslmaallocator.h>
+#include <bslma_winkoututil.h>
 
 #include <bslmf_haspointersemantics.h>
 #include <bslmf_issame.h>
@@ -27,6 +28,8 @@
 #include <bsls_platform.h>
 #include <bsls_util.h>
 
+#include <bsltf_destructioncountingtesttype.h>
+#include <bsltf_noopdeallocatetestallocator.h>
 #include <bsltf_stdtestallocator.h>
 #include <bsltf_templatetestfacility.h>
 #include <bsltf_testvaluesarray.h>
@@ -55,9 +58,11 @@ using namespace BloombergLP;
 // guarantees.
 //-----------------------------------------------------------------------------
 // [ ]
+// [17] void compact();
 //-----------------------------------------------------------------------------
 // [1] BREATHING TEST
-// [2] USAGE EXAMPLE
+// [18] CONCERN: '~unordered_map' winks out when possible
+// [19] USAGE EXAMPLE
 //-----------------------------------------------------------------------------
 
 // ============================================================================
@@ -5466,6 +5471,7 @@ const char *testTypeName<bsltf::NonTypicalOverloadsTestType>()
 
 }  // close unnamed namespace
 
+
 //=============================================================================
 //                     GLOBAL TYPEDEFS FOR TESTING
 //-----------------------------------------------------------------------------
@@ -5978,6 +5984,9 @@ class TestDriver {
   public:
     // TEST CASES
 
+    static void testCase17();
+        // Testing 'compact'
+
     static void testCase16();
         // Testing Typedefs
 
@@ -6117,6 +6126,143 @@ void TestDriver<KEY, VALUE, HASH, EQUAL, ALLOC>::matchFirstValues(
     delete[] foundValues;
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOC>
+void TestDriver<KEY, VALUE, HASH, EQUAL, ALLOC>::testCase17()
+{
+    // ------------------------------------------------------------------------
+    // TESTING 'compact'
+    //
+    // Concerns:
+    //: 1 'compact' does not change the value of the unordered map.
+    //:
+    //: 2 After 'compact', 'find' returns each element, and each bucket holds
+    //:   exactly the elements whose keys hash to it, i.e., the buckets are
+    //:   correctly redirected to the new nodes.
+    //:
+    //: 3 After 'compact', iterating over the unordered map visits its
+    //:   elements in increasing address order, even if the unordered map was
+    //:   built by interleaved insertions and erasures.
+    //:
+    //: 4 'compact' does not change the number of buckets, and the number of
+    //:   blocks in use does not grow.
+    //:
+    //: 5 'compact' provides the strong exception guarantee, whether or not
+    //:   'value_type' is bitwise moveable.
+    //
+    // Plan:
+    //: 1 For a series of specifications, create an unordered map by
+    //:   inserting the values of one specification, erasing those of a
+    //:   second, and inserting those of a third, so that the nodes of the
+    //:   unordered map are not in iteration order in memory.
+    //:
+    //: 2 Invoke 'compact' in the presence of injected exceptions, using an
+    //:   'ExceptionGuard' to verify that the unordered map is unchanged by
+    //:   each failed attempt.  (C-5)
+    //:
+    //: 3 Verify the value of the unordered map, that 'find' returns each
+    //:   element, that the local iterators of each bucket visit only
+    //:   elements of that bucket and together visit every element, and that
+    //:   successive elements have increasing addresses.  (C-1..3)
+    //:
+    //: 4 Verify the number of buckets, and that the number of blocks in use
+    //:   by the object allocator has not grown.  (C-4)
+    //
+    // Testing:
+    //   void compact();
+    // ------------------------------------------------------------------------
+
+    static const struct {
+        int         d_line;      // source line number
+        const char *d_spec;      // values inserted first
+        const char *d_erased;    // values then erased
+        const char *d_inserted;  // values then inserted
+        const char *d_results;   // expected element values
+    } DATA[] = {
+        //line  spec        erased  inserted  results
+        //----  ----        ------  --------  -------
+
+        { L_,   "",         "",     "",       ""          },
+        { L_,   "A",        "",     "",       "A"         },
+        { L_,   "AB",       "A",    "",       "B"         },
+        { L_,   "ABC",      "B",    "D",      "ACD"       },
+        { L_,   "EDCBA",    "",     "",       "EDCBA"     },
+        { L_,   "ABCDEFGH", "BDF",  "IJ",     "ACEGHIJ"   },
+        { L_,   "HGFEDCBA", "AH",   "IJK",    "GFEDCBIJK" },
+        { L_,   "ABCDEFGH", "ACEG", "ACEG",   "BDFHACEG"  },
+    };
+    const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+    for (int ti = 0; ti < NUM_DATA; ++ti) {
+        const int         LINE     = DATA[ti].d_line;
+        const char *const SPEC     = DATA[ti].d_spec;
+        const char *const ERASED   = DATA[ti].d_erased;
+        const char *const INSERTED = DATA[ti].d_inserted;
+        const char *const RESULTS  = DATA[ti].d_results;
+        const size_t      LENGTH   = strlen(RESULTS);
+
+        const TestValues ERASED_VALUES(ERASED);
+        const TestValues INSERTED_VALUES(INSERTED);
+        const TestValues EXP(RESULTS);
+
+        if (veryVerbose) { P_(LINE) P_(SPEC) P_(ERASED) P(INSERTED) }
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        Obj mX(&oa);  const Obj& X = gg(&mX, SPEC);
+
+        for (size_t tj = 0; tj < strlen(ERASED); ++tj) {
+            ASSERTV(LINE, tj, 1 == mX.erase(ERASED_VALUES[tj].first));
+        }
+        for (size_t tj = 0; tj < strlen(INSERTED); ++tj) {
+            ASSERTV(LINE, tj, mX.insert(INSERTED_VALUES[tj]).second);
+        }
+        matchFirstValues(LINE, X, EXP, LENGTH);
+
+        const SizeType           NUM_BUCKETS = X.bucket_count();
+        const bsls::Types::Int64 B           = oa.numBlocksInUse();
+
+        bslma::TestAllocator scratch("scratch", veryVeryVeryVerbose);
+
+        BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(oa) {
+            ExceptionGuard<Obj> guard(&X, L_, &scratch);
+
+            mX.compact();
+
+            guard.release();
+        } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+        const bsls::Types::Int64 A = oa.numBlocksInUse();
+
+        matchFirstValues(LINE, X, EXP, LENGTH);
+        ASSERTV(LINE, LENGTH == X.size());
+        ASSERTV(LINE, NUM_BUCKETS == X.bucket_count());
+        ASSERTV(LINE, B, A, A <= B);
+
+        for (size_t tj = 0; tj < LENGTH; ++tj) {
+            CIter it = X.find(EXP[tj].first);
+            ASSERTV(LINE, tj, X.end() != it);
+            ASSERTV(LINE, tj, X.end() != it && EXP[tj] == *it);
+        }
+
+        size_t numVisited = 0;
+        for (SizeType b = 0; b < X.bucket_count(); ++b) {
+            for (CLIter it = X.cbegin(b); it != X.cend(b); ++it) {
+                ASSERTV(LINE, b, b == X.bucket(it->first));
+                ++numVisited;
+            }
+        }
+        ASSERTV(LINE, numVisited, LENGTH == numVisited);
+
+        if (LENGTH) {
+            CIter it = X.begin();
+            for (CIter next = it; ++next != X.end(); it = next) {
+                ASSERTV(LINE, bsls::Util::addressOf(*it)
+                                              < bsls::Util::addressOf(*next));
+            }
+        }
+    }
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOC>
 void TestDriver<KEY, VALUE, HASH, EQUAL, ALLOC>::testCase16()
 {
@@ -9553,7 +9699,7 @@ int main(int argc, char *argv[])
 
     switch (test) { case 0:
 #if !defined(BSLSTL_UNORDEREDMAP_DO_NOT_TEST_USAGE)
-        case 17: {
+        case 19: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -9574,6 +9720,116 @@ int main(int argc, char *argv[])
         usage();
       } break;
 #endif
+      case 18: {
+        // --------------------------------------------------------------------
+        // TESTING WINK-OUT
+        //
+        // Concerns:
+        //: 1 If the elements are wink-out safe and the allocator's
+        //:   'deallocate' is a no-op, the destructor does not destroy the
+        //:   elements.
+        //:
+        //: 2 The elements are destroyed if they are not wink-out safe, or if
+        //:   the allocator's 'deallocate' has an effect.
+        //:
+        //: 3 'bslma::IsWinkOutSafe' holds for an 'unordered_map' exactly if it
+        //:   holds for the key and mapped types, and the container uses a
+        //:   'bslma' allocator.
+        //
+        // Plan:
+        //: 1 Using a 'bsltf::NoOpDeallocateTestAllocator', destroy a populated
+        //:   'unordered_map' of wink-out safe
+        //:   'bsltf::DestructionCountingTestType' objects, and verify that
+        //:   none of them is destroyed.  (C-1)
+        //:
+        //: 2 Repeat P-1 with objects that are not wink-out safe, and again
+        //:   with a 'bslma::TestAllocator', and verify that every object is
+        //:   destroyed.  (C-2)
+        //:
+        //: 3 Verify 'bslma::IsWinkOutSafe' for several 'unordered_map' types
+        //:   at compile time.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: '~unordered_map' winks out when possible
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING WINK-OUT"
+                            "\n================\n");
+
+        typedef bsltf::DestructionCountingTestType<true>  SafeType;
+        typedef bsltf::DestructionCountingTestType<false> UnsafeType;
+
+        typedef bsl::unordered_map<int, SafeType> SafeObj;
+        typedef bsl::unordered_map<int, UnsafeType> UnsafeObj;
+
+        typedef bsltf::StdTestAllocator<bsl::pair<const int, int> > StdAlloc;
+        typedef bsl::unordered_map<int,
+                                   int,
+                                   bsl::hash<int>,
+                                   bsl::equal_to<int>,
+                                   StdAlloc>                       StdAllocObj;
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<SafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<UnsafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<StdAllocObj>::value);
+
+        const int NUM_ELEMENTS = 16;
+
+        if (verbose) printf("\nWink out with a no-op 'deallocate'.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+            {
+                SafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(SafeObj::value_type(i, SafeType(i)));
+                }
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    0 == SafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out for elements lacking the trait.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+            {
+                UnsafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(UnsafeObj::value_type(i, UnsafeType(i)));
+                }
+                UnsafeType::resetNumDestructions();
+            }
+            ASSERTV(UnsafeType::numDestructions(),
+                    NUM_ELEMENTS == UnsafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out with an effective 'deallocate'.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+            {
+                SafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(SafeObj::value_type(i, SafeType(i)));
+                }
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    NUM_ELEMENTS == SafeType::numDestructions());
+            ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        }
+      } break;
+      case 17: {
+        // --------------------------------------------------------------------
+        // TESTING 'compact'
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("Testing 'compact'\n"
+                            "=================\n");
+
+        RUN_EACH_TYPE(TestDriver,
+                      testCase17,
+                      BSLTF_TEMPLATETESTFACILITY_TEST_TYPES_REGULAR);
+      } break;
       case 16: {
         // --------------------------------------------------------------------
         // GROWING FUNCTIONS
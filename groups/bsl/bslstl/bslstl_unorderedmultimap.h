@@ -550,6 +550,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_usesbslmaallocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
 #include <bslmf_isbitwisemoveable.h>
 #endif
@@ -745,7 +749,9 @@ class unordered_multimap
         // {Requirements on 'KEY' and 'VALUE'}).
 
     ~unordered_multimap();
-        // Destroy this object.
+        // Destroy this object.  Note that the elements are neither destroyed
+        // nor deallocated if they are wink-out safe and the allocator of this
+        // object has a no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
     unordered_multimap& operator=(const unordered_multimap& rhs);
@@ -1603,6 +1609,18 @@ struct UsesBslmaAllocator<bsl::unordered_multimap<KEY,
 : bsl::is_convertible<Allocator*, ALLOCATOR>::type
 {};
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+struct IsWinkOutSafe<bsl::unordered_multimap<KEY,
+                                             VALUE,
+                                             HASH,
+                                             EQUAL,
+                                             ALLOCATOR> >
+: bsl::integral_constant<bool,
+                         IsWinkOutSafe<KEY>::value
+                      && IsWinkOutSafe<VALUE>::value
+                      && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
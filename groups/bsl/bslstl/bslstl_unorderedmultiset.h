@@ -624,6 +624,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_usesbslmaallocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
 #include <bslmf_isbitwisemoveable.h>
 #endif
@@ -824,7 +828,9 @@ class unordered_multiset
         // 'KEY'}).
 
     ~unordered_multiset();
-        // Destroy this object.
+        // Destroy this object.  Note that the elements are neither destroyed
+        // nor deallocated if they are wink-out safe and the allocator of this
+        // object has a no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
     unordered_multiset& operator=(const unordered_multiset& rhs);
@@ -1659,6 +1665,13 @@ struct UsesBslmaAllocator<bsl::unordered_multiset<KEY,
     : bsl::is_convertible<Allocator*, ALLOCATOR>::type
 {};
 
+template <class KEY, class HASH, class EQUAL, class ALLOCATOR>
+struct IsWinkOutSafe<bsl::unordered_multiset<KEY, HASH, EQUAL, ALLOCATOR> >
+    : bsl::integral_constant<bool,
+                             IsWinkOutSafe<KEY>::value
+                          && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
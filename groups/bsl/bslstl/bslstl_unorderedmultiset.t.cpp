@@ -13,6 +13,7 @@
 #include <bslma_testallocator.h>
 #include <bslma_testallocatormonitor.h>
 #include <bslma_usesbslmaallocator.h>
+#include <bslma_winkoututil.h>
 
 #include <bslmf_haspointersemantics.h>
 #include <bslmf_issame.h>
@@ -21,6 +22,8 @@
 #include <bsls_bsltestutil.h>
 #include <bsls_types.h>
 
+#include <bsltf_destructioncountingtesttype.h>
+#include <bsltf_noopdeallocatetestallocator.h>
 #include <bsltf_stdtestallocator.h>
 #include <bsltf_templatetestfacility.h>
 #include <bsltf_testvaluesarray.h>
@@ -165,7 +168,8 @@ using namespace BloombergLP;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] default construction (only)
-// [ 5] USAGE EXAMPLE
+// [16] CONCERN: '~unordered_multiset' winks out when possible
+// [17] USAGE EXAMPLE
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(unordered_multiset<T,H,E,A> *o, const char *s, int verbose);
@@ -985,6 +989,24 @@ class TestHashFunctor {
 
 }  // close unnamed namespace
 
+                   // ======================================
+                   // struct DestructionCountingTestTypeHash
+                   // ======================================
+
+struct DestructionCountingTestTypeHash {
+    // This 'struct' provides a hash functor for
+    // 'bsltf::DestructionCountingTestType'.
+
+    // ACCESSORS
+    template <bool WINK_OUT_SAFE>
+    size_t operator()(
+          const bsltf::DestructionCountingTestType<WINK_OUT_SAFE>& value) const
+        // Return the hash of the specified 'value'.
+    {
+        return static_cast<size_t>(value.data());
+    }
+};
+
 // ============================================================================
 //                     GLOBAL TYPEDEFS FOR TESTING
 // ----------------------------------------------------------------------------
@@ -4514,7 +4536,7 @@ int main(int argc, char *argv[])
     bslma::Default::setDefaultAllocator(&testAlloc);
 
     switch (test) { case 0:
-      case 16: {
+      case 17: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -4667,6 +4689,105 @@ int main(int argc, char *argv[])
 // See the material in {'bslstl_unorderedmap'|Example 2}.
 
       } break;
+      case 16: {
+        // --------------------------------------------------------------------
+        // TESTING WINK-OUT
+        //
+        // Concerns:
+        //: 1 If the elements are wink-out safe and the allocator's
+        //:   'deallocate' is a no-op, the destructor does not destroy the
+        //:   elements.
+        //:
+        //: 2 The elements are destroyed if they are not wink-out safe, or if
+        //:   the allocator's 'deallocate' has an effect.
+        //:
+        //: 3 'bslma::IsWinkOutSafe' holds for an 'unordered_multiset' exactly
+        //:   if it holds for the element type, and the container uses a
+        //:   'bslma' allocator.
+        //
+        // Plan:
+        //: 1 Using a 'bsltf::NoOpDeallocateTestAllocator', destroy a populated
+        //:   'unordered_multiset' of wink-out safe
+        //:   'bsltf::DestructionCountingTestType' objects, and verify that
+        //:   none of them is destroyed.  (C-1)
+        //:
+        //: 2 Repeat P-1 with objects that are not wink-out safe, and again
+        //:   with a 'bslma::TestAllocator', and verify that every object is
+        //:   destroyed.  (C-2)
+        //:
+        //: 3 Verify 'bslma::IsWinkOutSafe' for several 'unordered_multiset'
+        //:   types at compile time.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: '~unordered_multiset' winks out when possible
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING WINK-OUT"
+                            "\n================\n");
+
+        typedef bsltf::DestructionCountingTestType<true>  SafeType;
+        typedef bsltf::DestructionCountingTestType<false> UnsafeType;
+
+        typedef DestructionCountingTestTypeHash Hash;
+
+        typedef bsl::unordered_multiset<SafeType, Hash>   SafeObj;
+        typedef bsl::unordered_multiset<UnsafeType, Hash> UnsafeObj;
+
+        typedef bsltf::StdTestAllocator<int> StdAlloc;
+        typedef bsl::unordered_multiset<int,
+                                        bsl::hash<int>,
+                                        bsl::equal_to<int>,
+                                        StdAlloc>                  StdAllocObj;
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<SafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<UnsafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<StdAllocObj>::value);
+
+        const int NUM_ELEMENTS = 16;
+
+        if (verbose) printf("\nWink out with a no-op 'deallocate'.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+            {
+                SafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(SafeType(i));
+                }
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    0 == SafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out for elements lacking the trait.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+            {
+                UnsafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(UnsafeType(i));
+                }
+                UnsafeType::resetNumDestructions();
+            }
+            ASSERTV(UnsafeType::numDestructions(),
+                    NUM_ELEMENTS == UnsafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out with an effective 'deallocate'.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+            {
+                SafeObj mX(&oa);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.insert(SafeType(i));
+                }
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    NUM_ELEMENTS == SafeType::numDestructions());
+            ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        }
+      } break;
       case 15: {
         // --------------------------------------------------------------------
         // TESTING HASH_FUNCTION AND KEY_EQ
@@ -572,6 +572,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_usesbslmaallocator.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
 #include <bslmf_isbitwisemoveable.h>
 #endif
@@ -772,7 +776,9 @@ class unordered_set
         // 'KEY'}).
 
     ~unordered_set();
-        // Destroy this object.
+        // Destroy this object.  Note that the elements are neither destroyed
+        // nor deallocated if they are wink-out safe and the allocator of this
+        // object has a no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
     unordered_set& operator=(const unordered_set& rhs);
@@ -1613,6 +1619,13 @@ struct UsesBslmaAllocator<bsl::unordered_set<KEY, HASH, EQUAL, ALLOCATOR> >
      : bsl::is_convertible<Allocator*, ALLOCATOR>::type
 {};
 
+template <class KEY, class HASH, class EQUAL, class ALLOCATOR>
+struct IsWinkOutSafe<bsl::unordered_set<KEY, HASH, EQUAL, ALLOCATOR> >
+    : bsl::integral_constant<bool,
+                             IsWinkOutSafe<KEY>::value
+                          && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -532,6 +532,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslma_default.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_CONDITIONAL
 #include <bslmf_conditional.h>
 #endif
@@ -552,6 +556,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslmf_issame.h>
 #endif
 
+#ifndef INCLUDED_BSLMF_ISTRIVIALLYCOPYABLE
+#include <bslmf_istriviallycopyable.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_MATCHANYTYPE
 #include <bslmf_matchanytype.h>
 #endif
@@ -912,6 +920,15 @@ class Vector_Imp : public Vector_ImpBase<VALUE_TYPE>
         // Reserve exactly the specified 'numElements'.  The behavior is
         // undefined unless this vector is empty and has no capacity.
 
+    // PRIVATE ACCESSORS
+    bool canWinkOutElements() const;
+        // Return 'true' if the elements of this vector need not be destroyed
+        // nor their storage deallocated because 'VALUE_TYPE' is wink-out safe
+        // and the allocator of this vector has a no-op 'deallocate' (see
+        // 'bslma_winkoututil'), and 'false' otherwise.  Note that 'false' is
+        // returned without querying the allocator if 'VALUE_TYPE' is
+        // trivially copyable, as destroying such elements has no cost.
+
   public:
     // CREATORS
 
@@ -973,7 +990,9 @@ class Vector_Imp : public Vector_ImpBase<VALUE_TYPE>
         // (see {Requirements on 'VALUE_TYPE'}).
 
     ~Vector_Imp();
-        // Destroy this vector.
+        // Destroy this vector.  Note that the elements are not destroyed if
+        // 'VALUE_TYPE' is wink-out safe and the allocator of this vector has a
+        // no-op 'deallocate' (see 'bslma_winkoututil').
 
     // MANIPULATORS
 
@@ -2435,6 +2454,16 @@ void Vector_Imp<VALUE_TYPE, ALLOCATOR>::privateReserveEmpty(
     this->d_capacity = numElements;
 }
 
+// PRIVATE ACCESSORS
+template <class VALUE_TYPE, class ALLOCATOR>
+inline
+bool Vector_Imp<VALUE_TYPE, ALLOCATOR>::canWinkOutElements() const
+{
+    return !is_trivially_copyable<VALUE_TYPE>::value
+        && BloombergLP::bslma::WinkOutUtil::canWinkOut<VALUE_TYPE>(
+                                             VectorContainerBase::allocator());
+}
+
 // CREATORS
 
                   // *** 23.2.4.1 construct/copy/destroy: ***
@@ -2565,7 +2594,7 @@ template <class VALUE_TYPE, class ALLOCATOR>
 inline
 Vector_Imp<VALUE_TYPE, ALLOCATOR>::~Vector_Imp()
 {
-    if (this->d_dataBegin) {
+    if (this->d_dataBegin && !canWinkOutElements()) {
         BloombergLP::bslalg::ArrayDestructionPrimitives::destroy(
                                                              this->d_dataBegin,
                                                              this->d_dataEnd);
@@ -3778,7 +3807,12 @@ inline
 void Vector_Imp<VALUE_TYPE, ALLOCATOR>::clear()
 {
     if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(!this->empty())) {
-        erase(this->begin(), this->end());
+        if (canWinkOutElements()) {
+            this->d_dataEnd = this->d_dataBegin;
+        }
+        else {
+            erase(this->begin(), this->end());
+        }
     }
     BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
 }
@@ -4272,6 +4306,13 @@ struct UsesBslmaAllocator<bsl::vector<VALUE_TYPE, ALLOCATOR> >
     : bsl::is_convertible<Allocator*, ALLOCATOR>::type
 {};
 
+template <class VALUE_TYPE, class ALLOCATOR>
+struct IsWinkOutSafe<bsl::vector<VALUE_TYPE, ALLOCATOR> >
+    : bsl::integral_constant<bool,
+                             IsWinkOutSafe<VALUE_TYPE>::value
+                          && bsl::is_convertible<Allocator*, ALLOCATOR>::value>
+{};
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -12,8 +12,10 @@
 #include <bslma_newdeleteallocator.h>
 #include <bslma_testallocator.h>
 #include <bslma_testallocatorexception.h>
+#include <bslma_winkoututil.h>
 
 #include <bslmf_issame.h>
+#include <bslmf_nestedtraitdeclaration.h>
 
 #include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
@@ -26,9 +28,12 @@
 #include <bsls_stopwatch.h>
 #include <bsls_util.h>
 
+#include <bsltf_destructioncountingtesttype.h>
 #include <bsltf_nontypicaloverloadstesttype.h>
+#include <bsltf_noopdeallocatetestallocator.h>
 
 #include <iterator>   // 'iterator_traits'
+#include <memory>     // 'allocator'
 #include <stdexcept>  // 'length_error', 'out_of_range'
 
 #include <ctype.h>
@@ -153,10 +158,11 @@ using namespace bsl;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [11] ALLOCATOR-RELATED CONCERNS
-// [25] USAGE EXAMPLE
+// [28] USAGE EXAMPLE
 // [21] CONCERN: 'std::length_error' is used properly
 // [23] DRQS 31711031
 // [24] DRQS 34693876
+// [27] CONCERN: 'clear' and '~vector' wink out when possible
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int ggg(vector<T,A> *object, const char *spec, int vF = 1);
@@ -1335,6 +1341,7 @@ struct IsBitwiseMoveable<LimitAllocator<ALLOCATOR> >
 
 }  // namespace BloombergLP
 
+
 //=============================================================================
 //                            Test Case 22
 //=============================================================================
@@ -9537,7 +9544,7 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 27: {
+      case 28: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -9581,6 +9588,138 @@ int main(int argc, char *argv[])
             ASSERT(4 == m1.theValue(1, 1));
         }
       } break;
+      case 27: {
+        // --------------------------------------------------------------------
+        // TESTING WINK-OUT
+        //
+        // Concerns:
+        //: 1 If the elements are wink-out safe and the allocator's
+        //:   'deallocate' is a no-op, 'clear' and the destructor do not
+        //:   destroy the elements.
+        //:
+        //: 2 A vector emptied in this way is empty, retains its capacity, and
+        //:   remains usable.
+        //:
+        //: 3 The elements are destroyed if they are not wink-out safe, or if
+        //:   the allocator's 'deallocate' has an effect.
+        //:
+        //: 4 'bslma::IsWinkOutSafe' holds for a vector exactly if it holds for
+        //:   the element type and the vector uses a 'bslma' allocator.
+        //
+        // Plan:
+        //: 1 Using a 'bsltf::NoOpDeallocateTestAllocator', populate vectors of
+        //:   wink-out safe 'bsltf::DestructionCountingTestType' elements, then
+        //:   clear and destroy them, and verify that no destructor ran.
+        //:   Verify that a cleared vector is empty, has the same capacity, and
+        //:   can be repopulated.  (C-1..2)
+        //:
+        //: 2 Repeat P-1 with elements that are not wink-out safe, and again
+        //:   with a 'bslma::TestAllocator', and verify that every element is
+        //:   destroyed.  (C-3)
+        //:
+        //: 3 Verify 'bslma::IsWinkOutSafe' for several vector types at
+        //:   compile time.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: 'clear' and '~vector' wink out when possible
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING WINK-OUT"
+                            "\n================\n");
+
+        typedef bsltf::DestructionCountingTestType<true>  SafeType;
+        typedef bsltf::DestructionCountingTestType<false> UnsafeType;
+
+        typedef vector<int, native_std::allocator<int> > OtherAllocVector;
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<vector<int> >::value);
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<vector<SafeType> >::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<vector<UnsafeType> >::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<OtherAllocVector>::value);
+
+        const int NUM_ELEMENTS = 16;
+
+        if (verbose) printf("\nWink out with a no-op 'deallocate'.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+
+            {
+                vector<SafeType> mX(&oa);  const vector<SafeType>& X = mX;
+                mX.reserve(NUM_ELEMENTS);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.push_back(SafeType(i));
+                }
+                const size_t capacity = X.capacity();
+                SafeType::resetNumDestructions();
+
+                mX.clear();
+                ASSERT(X.empty());
+                ASSERT(0 == X.size());
+                ASSERTV(X.capacity(), capacity == X.capacity());
+                ASSERTV(SafeType::numDestructions(),
+                        0 == SafeType::numDestructions());
+
+                mX.push_back(SafeType(7));
+                mX.push_back(SafeType(3));
+                ASSERT(2 == X.size());
+                ASSERT(7 == X[0].data());
+                ASSERT(3 == X[1].data());
+
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    0 == SafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out for elements lacking the trait.\n");
+        {
+            bsltf::NoOpDeallocateTestAllocator oa;
+
+            {
+                vector<UnsafeType> mX(&oa);  const vector<UnsafeType>& X = mX;
+                mX.reserve(NUM_ELEMENTS);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.push_back(UnsafeType(i));
+                }
+                UnsafeType::resetNumDestructions();
+
+                mX.clear();
+                ASSERT(X.empty());
+                ASSERTV(UnsafeType::numDestructions(),
+                        NUM_ELEMENTS == UnsafeType::numDestructions());
+
+                mX.push_back(UnsafeType(1));
+                UnsafeType::resetNumDestructions();
+            }
+            ASSERTV(UnsafeType::numDestructions(),
+                    1 == UnsafeType::numDestructions());
+        }
+
+        if (verbose) printf("\nNo wink out for a deallocating allocator.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            {
+                vector<SafeType> mX(&oa);  const vector<SafeType>& X = mX;
+                mX.reserve(NUM_ELEMENTS);
+                for (int i = 0; i < NUM_ELEMENTS; ++i) {
+                    mX.push_back(SafeType(i));
+                }
+                SafeType::resetNumDestructions();
+
+                mX.clear();
+                ASSERT(X.empty());
+                ASSERTV(SafeType::numDestructions(),
+                        NUM_ELEMENTS == SafeType::numDestructions());
+
+                mX.push_back(SafeType(1));
+                SafeType::resetNumDestructions();
+            }
+            ASSERTV(SafeType::numDestructions(),
+                    1 == SafeType::numDestructions());
+            ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        }
+      } break;
       case 26: {
         // --------------------------------------------------------------------
         // TESTING HYMAN'S TEST CASE 2
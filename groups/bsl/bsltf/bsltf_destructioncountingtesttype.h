@@ -0,0 +1,304 @@
+// bsltf_destructioncountingtesttype.h                                -*-C++-*-
+#ifndef INCLUDED_BSLTF_DESTRUCTIONCOUNTINGTESTTYPE
+#define INCLUDED_BSLTF_DESTRUCTIONCOUNTINGTESTTYPE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a test class that counts destructions of its objects.
+//
+//@CLASSES:
+//   bsltf::DestructionCountingTestType: test class counting its destructions
+//
+//@SEE_ALSO: bsltf_noopdeallocatetestallocator, bslma_winkoututil
+//
+//@DESCRIPTION: This component provides a single, unconstrained in-core
+// (value-semantic) attribute class template, 'DestructionCountingTestType',
+// that does not allocate memory, and that counts, for each instantiation, the
+// number of its objects that are destroyed.  The class template declares the
+// 'bslma::IsWinkOutSafe' trait if and only if its 'bool' template parameter,
+// 'WINK_OUT_SAFE', is 'true'.  'DestructionCountingTestType' can therefore be
+// used to observe whether a container destroys its elements, or "winks them
+// out" (see 'bslma_winkoututil'), when it is destroyed or cleared.
+//
+// Every destruction of an object of a given instantiation is counted,
+// including that of temporaries and copies made by the code under test.  The
+// count is kept in a class-level variable that is *not* thread-safe, and that
+// may be reset by 'resetNumDestructions'.
+//
+///Attributes
+///----------
+//..
+//  Name                Type         Default
+//  ------------------  -----------  -------
+//  data                int          0
+//..
+//: o 'data': representation of the class value
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Observing Wink-Out
+///- - - - - - - - - - - - - - -
+// Suppose we wanted to verify that a simple container does not destroy its
+// elements when it is destroyed, if they are wink-out safe and the container
+// uses an allocator having a no-op 'deallocate'.
+//
+// First, we define a function template, 'destroyArray', that destroys the
+// elements of an array of the (template parameter) 'TYPE' unless they can be
+// winked out:
+//..
+//  template <class TYPE>
+//  void destroyArray(TYPE *array, int numElements, bool noOpDeallocate)
+//      // Destroy the specified 'numElements' elements of the specified
+//      // 'array' unless 'TYPE' is wink-out safe and the specified
+//      // 'noOpDeallocate' flag is 'true'.
+//  {
+//      if (bslma::IsWinkOutSafe<TYPE>::value && noOpDeallocate) {
+//          return;                                                 // RETURN
+//      }
+//      for (int i = 0; i < numElements; ++i) {
+//          array[i].~TYPE();
+//      }
+//  }
+//..
+// Then, we create an array of objects of a wink-out safe instantiation of
+// 'DestructionCountingTestType', reset the count of destructions, and destroy
+// the array as if its allocator had a no-op 'deallocate':
+//..
+//  typedef bsltf::DestructionCountingTestType<true> SafeType;
+//
+//  bsls::ObjectBuffer<SafeType> buffer[4];
+//  for (int i = 0; i < 4; ++i) {
+//      new (buffer[i].buffer()) SafeType(i);
+//  }
+//
+//  SafeType::resetNumDestructions();
+//  destroyArray(&buffer[0].object(), 4, true);
+//..
+// Finally, we observe that no element was destroyed:
+//..
+//  assert(0 == SafeType::numDestructions());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_WINKOUTUTIL
+#include <bslma_winkoututil.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+namespace BloombergLP {
+namespace bsltf {
+
+                     // =================================
+                     // class DestructionCountingTestType
+                     // =================================
+
+template <bool WINK_OUT_SAFE = false>
+class DestructionCountingTestType {
+    // This unconstrained (value-semantic) attribute class template does not
+    // allocate memory, counts the destructions of its objects, and declares
+    // the 'bslma::IsWinkOutSafe' trait if and only if 'WINK_OUT_SAFE' is
+    // 'true'.  See the Attributes section under @DESCRIPTION in the
+    // component-level documentation for information on the class attributes.
+
+    // CLASS DATA
+    static int s_numDestructions;  // number of objects destroyed since the
+                                   // last call to 'resetNumDestructions'
+
+    // DATA
+    int        d_data;             // integer class value
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION_IF(DestructionCountingTestType,
+                                      bslma::IsWinkOutSafe,
+                                      WINK_OUT_SAFE);
+
+    // CLASS METHODS
+    static int numDestructions();
+        // Return the number of objects of this class that have been destroyed
+        // since the last call to 'resetNumDestructions', or since the start of
+        // the program if there has been no such call.
+
+    static void resetNumDestructions();
+        // Reset the number of objects of this class that have been destroyed
+        // to 0.
+
+    // CREATORS
+    DestructionCountingTestType();
+        // Create a 'DestructionCountingTestType' object having the (default)
+        // attribute values:
+        //..
+        //  data() == 0
+        //..
+
+    explicit DestructionCountingTestType(int data);
+        // Create a 'DestructionCountingTestType' object having the specified
+        // 'data' attribute value.
+
+    // DestructionCountingTestType(
+    //                  const DestructionCountingTestType& original) = default;
+        // Create a 'DestructionCountingTestType' object having the same value
+        // as the specified 'original' object.
+
+    ~DestructionCountingTestType();
+        // Destroy this object, and increment the number of objects of this
+        // class that have been destroyed.
+
+    // MANIPULATORS
+    // DestructionCountingTestType& operator=(
+    //                       const DestructionCountingTestType& rhs) = default;
+        // Assign to this object the value of the specified 'rhs' object, and
+        // return a reference providing modifiable access to this object.
+
+    void setData(int value);
+        // Set the 'data' attribute of this object to the specified 'value'.
+
+    // ACCESSORS
+    int data() const;
+        // Return the value of the 'data' attribute of this object.
+};
+
+// FREE OPERATORS
+template <bool WINK_OUT_SAFE>
+bool operator==(const DestructionCountingTestType<WINK_OUT_SAFE>& lhs,
+                const DestructionCountingTestType<WINK_OUT_SAFE>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'DestructionCountingTestType' objects
+    // have the same value if their 'data' attributes are the same.
+
+template <bool WINK_OUT_SAFE>
+bool operator!=(const DestructionCountingTestType<WINK_OUT_SAFE>& lhs,
+                const DestructionCountingTestType<WINK_OUT_SAFE>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'DestructionCountingTestType'
+    // objects do not have the same value if their 'data' attributes are not
+    // the same.
+
+template <bool WINK_OUT_SAFE>
+bool operator<(const DestructionCountingTestType<WINK_OUT_SAFE>& lhs,
+               const DestructionCountingTestType<WINK_OUT_SAFE>& rhs);
+    // Return 'true' if the 'data' attribute of the specified 'lhs' object is
+    // less than that of the specified 'rhs' object, and 'false' otherwise.
+
+// ===========================================================================
+//                  INLINE AND TEMPLATE FUNCTION IMPLEMENTATIONS
+// ===========================================================================
+
+                     // ---------------------------------
+                     // class DestructionCountingTestType
+                     // ---------------------------------
+
+// CLASS DATA
+template <bool WINK_OUT_SAFE>
+int DestructionCountingTestType<WINK_OUT_SAFE>::s_numDestructions = 0;
+
+// CLASS METHODS
+template <bool WINK_OUT_SAFE>
+inline
+int DestructionCountingTestType<WINK_OUT_SAFE>::numDestructions()
+{
+    return s_numDestructions;
+}
+
+template <bool WINK_OUT_SAFE>
+inline
+void DestructionCountingTestType<WINK_OUT_SAFE>::resetNumDestructions()
+{
+    s_numDestructions = 0;
+}
+
+// CREATORS
+template <bool WINK_OUT_SAFE>
+inline
+DestructionCountingTestType<WINK_OUT_SAFE>::DestructionCountingTestType()
+: d_data(0)
+{
+}
+
+template <bool WINK_OUT_SAFE>
+inline
+DestructionCountingTestType<WINK_OUT_SAFE>::DestructionCountingTestType(
+                                                                      int data)
+: d_data(data)
+{
+}
+
+template <bool WINK_OUT_SAFE>
+inline
+DestructionCountingTestType<WINK_OUT_SAFE>::~DestructionCountingTestType()
+{
+    ++s_numDestructions;
+}
+
+// MANIPULATORS
+template <bool WINK_OUT_SAFE>
+inline
+void DestructionCountingTestType<WINK_OUT_SAFE>::setData(int value)
+{
+    d_data = value;
+}
+
+// ACCESSORS
+template <bool WINK_OUT_SAFE>
+inline
+int DestructionCountingTestType<WINK_OUT_SAFE>::data() const
+{
+    return d_data;
+}
+
+// FREE OPERATORS
+template <bool WINK_OUT_SAFE>
+inline
+bool operator==(const DestructionCountingTestType<WINK_OUT_SAFE>& lhs,
+                const DestructionCountingTestType<WINK_OUT_SAFE>& rhs)
+{
+    return lhs.data() == rhs.data();
+}
+
+template <bool WINK_OUT_SAFE>
+inline
+bool operator!=(const DestructionCountingTestType<WINK_OUT_SAFE>& lhs,
+                const DestructionCountingTestType<WINK_OUT_SAFE>& rhs)
+{
+    return lhs.data() != rhs.data();
+}
+
+template <bool WINK_OUT_SAFE>
+inline
+bool operator<(const DestructionCountingTestType<WINK_OUT_SAFE>& lhs,
+               const DestructionCountingTestType<WINK_OUT_SAFE>& rhs)
+{
+    return lhs.data() < rhs.data();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
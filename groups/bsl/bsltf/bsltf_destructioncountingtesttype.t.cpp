@@ -0,0 +1,411 @@
+// bsltf_destructioncountingtesttype.t.cpp                            -*-C++-*-
+#include <bsltf_destructioncountingtesttype.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslma_winkoututil.h>
+
+#include <bslmf_assert.h>
+
+#include <bsls_bsltestutil.h>
+#include <bsls_objectbuffer.h>
+
+#include <new>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace BloombergLP;
+using namespace BloombergLP::bsltf;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a single unconstrained (value-semantic)
+// attribute class template whose destructor counts the destructions of its
+// objects, and which declares the 'bslma::IsWinkOutSafe' trait according to
+// its template parameter.  Its value-semantic operations are the same as
+// those of 'bsltf::SimpleTestType', and are tested together in case 2; case 3
+// tests the destruction count and the trait.
+//
+// Global Concerns:
+//: o No memory is ever allocated from this component.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 3] static int numDestructions();
+// [ 3] static void resetNumDestructions();
+//
+// CREATORS
+// [ 2] DestructionCountingTestType();
+// [ 2] DestructionCountingTestType(int data);
+// [ 2] DestructionCountingTestType(const DestructionCountingTestType& o);
+// [ 3] ~DestructionCountingTestType();
+//
+// MANIPULATORS
+// [ 2] DestructionCountingTestType& operator=(const DCTT& rhs);
+// [ 2] void setData(int value);
+//
+// ACCESSORS
+// [ 2] int data() const;
+//
+// FREE OPERATORS
+// [ 2] bool operator==(const DCTT& lhs, const DCTT& rhs);
+// [ 2] bool operator!=(const DCTT& lhs, const DCTT& rhs);
+// [ 2] bool operator<(const DCTT& lhs, const DCTT& rhs);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+// [ 3] CONCERN: 'bslma::IsWinkOutSafe' holds exactly if 'WINK_OUT_SAFE'.
+// [ *] CONCERN: No memory is ever allocated.
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                     GLOBAL TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsltf::DestructionCountingTestType<true>  SafeObj;
+typedef bsltf::DestructionCountingTestType<false> UnsafeObj;
+typedef bsltf::DestructionCountingTestType<>      DefaultObj;
+
+//=============================================================================
+//                              USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Observing Wink-Out
+///- - - - - - - - - - - - - - -
+// Suppose we wanted to verify that a simple container does not destroy its
+// elements when it is destroyed, if they are wink-out safe and the container
+// uses an allocator having a no-op 'deallocate'.
+//
+// First, we define a function template, 'destroyArray', that destroys the
+// elements of an array of the (template parameter) 'TYPE' unless they can be
+// winked out:
+//..
+    template <class TYPE>
+    void destroyArray(TYPE *array, int numElements, bool noOpDeallocate)
+        // Destroy the specified 'numElements' elements of the specified
+        // 'array' unless 'TYPE' is wink-out safe and the specified
+        // 'noOpDeallocate' flag is 'true'.
+    {
+        if (bslma::IsWinkOutSafe<TYPE>::value && noOpDeallocate) {
+            return;                                                 // RETURN
+        }
+        for (int i = 0; i < numElements; ++i) {
+            array[i].~TYPE();
+        }
+    }
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+    int  test                = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose             = argc > 2;
+    bool veryVerbose         = argc > 3;
+    bool veryVeryVerbose     = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void) veryVerbose;
+    (void) veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    // CONCERN: No memory is ever allocated.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we create an array of objects of a wink-out safe instantiation of
+// 'DestructionCountingTestType', reset the count of destructions, and destroy
+// the array as if its allocator had a no-op 'deallocate':
+//..
+    typedef bsltf::DestructionCountingTestType<true> SafeType;
+
+    bsls::ObjectBuffer<SafeType> buffer[4];
+    for (int i = 0; i < 4; ++i) {
+        new (buffer[i].buffer()) SafeType(i);
+    }
+
+    SafeType::resetNumDestructions();
+    destroyArray(&buffer[0].object(), 4, true);
+//..
+// Finally, we observe that no element was destroyed:
+//..
+    ASSERT(0 == SafeType::numDestructions());
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // DESTRUCTION COUNT AND TRAIT
+        //
+        // Concerns:
+        //: 1 Each destruction of an object, including of a copy, increments
+        //:   the count of its instantiation, and of no other instantiation.
+        //:
+        //: 2 'resetNumDestructions' sets the count to 0.
+        //:
+        //: 3 'bslma::IsWinkOutSafe' holds exactly if 'WINK_OUT_SAFE' is
+        //:   'true', which it is not by default.
+        //
+        // Plan:
+        //: 1 Reset the counts, create and destroy objects and copies of each
+        //:   instantiation, and verify both counts after each destruction.
+        //:   (C-1..2)
+        //:
+        //: 2 Verify the trait of each instantiation at compile time.  (C-3)
+        //
+        // Testing:
+        //   static int numDestructions();
+        //   static void resetNumDestructions();
+        //   ~DestructionCountingTestType();
+        //   CONCERN: 'bslma::IsWinkOutSafe' holds exactly if 'WINK_OUT_SAFE'.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nDESTRUCTION COUNT AND TRAIT"
+                            "\n===========================\n");
+
+        BSLMF_ASSERT( bslma::IsWinkOutSafe<SafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<UnsafeObj>::value);
+        BSLMF_ASSERT(!bslma::IsWinkOutSafe<DefaultObj>::value);
+
+        BSLMF_ASSERT(!bslma::UsesBslmaAllocator<SafeObj>::value);
+        BSLMF_ASSERT(!bslma::UsesBslmaAllocator<UnsafeObj>::value);
+
+        SafeObj::resetNumDestructions();
+        UnsafeObj::resetNumDestructions();
+
+        ASSERT(0 == SafeObj::numDestructions());
+        ASSERT(0 == UnsafeObj::numDestructions());
+
+        {
+            SafeObj mX(1);
+            {
+                const SafeObj Y(mX);
+            }
+            ASSERTV(SafeObj::numDestructions(),
+                    1 == SafeObj::numDestructions());
+            ASSERTV(UnsafeObj::numDestructions(),
+                    0 == UnsafeObj::numDestructions());
+        }
+        ASSERTV(SafeObj::numDestructions(), 2 == SafeObj::numDestructions());
+
+        {
+            const UnsafeObj X(2);
+        }
+        ASSERTV(UnsafeObj::numDestructions(),
+                1 == UnsafeObj::numDestructions());
+        ASSERTV(SafeObj::numDestructions(), 2 == SafeObj::numDestructions());
+
+        SafeObj::resetNumDestructions();
+        ASSERT(0 == SafeObj::numDestructions());
+        ASSERT(1 == UnsafeObj::numDestructions());
+
+        UnsafeObj::resetNumDestructions();
+        ASSERT(0 == UnsafeObj::numDestructions());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // VALUE-SEMANTIC OPERATIONS
+        //
+        // Concerns:
+        //: 1 The default constructor creates an object having a 'data' of 0,
+        //:   and the value constructor one having the supplied 'data'.
+        //:
+        //: 2 'setData' sets the 'data' attribute, and 'data' returns it.
+        //:
+        //: 3 Copy construction and assignment copy the 'data' attribute.
+        //:
+        //: 4 The comparison operators compare the 'data' attributes.
+        //
+        // Plan:
+        //: 1 For a set of values, create, set, copy, and assign objects, and
+        //:   compare every pair of values.  (C-1..4)
+        //
+        // Testing:
+        //   DestructionCountingTestType();
+        //   DestructionCountingTestType(int data);
+        //   DestructionCountingTestType(const DestructionCountingTestType& o);
+        //   DestructionCountingTestType& operator=(const DCTT& rhs);
+        //   void setData(int value);
+        //   int data() const;
+        //   bool operator==(const DCTT& lhs, const DCTT& rhs);
+        //   bool operator!=(const DCTT& lhs, const DCTT& rhs);
+        //   bool operator<(const DCTT& lhs, const DCTT& rhs);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nVALUE-SEMANTIC OPERATIONS"
+                            "\n=========================\n");
+
+        const int VALUES[]   = { -2, 0, 1, 7, 1000 };
+        const int NUM_VALUES = sizeof VALUES / sizeof *VALUES;
+
+        {
+            const SafeObj X;
+            ASSERTV(X.data(), 0 == X.data());
+        }
+
+        for (int ti = 0; ti < NUM_VALUES; ++ti) {
+            const int V = VALUES[ti];
+
+            const SafeObj X(V);
+            ASSERTV(V, X.data(), V == X.data());
+
+            SafeObj mY;  const SafeObj& Y = mY;
+            mY.setData(V);
+            ASSERTV(V, Y.data(), V == Y.data());
+
+            const SafeObj Z(X);
+            ASSERTV(V, Z.data(), V == Z.data());
+
+            for (int tj = 0; tj < NUM_VALUES; ++tj) {
+                const int W = VALUES[tj];
+
+                UnsafeObj mU(W);  const UnsafeObj& U = mU;
+                const UnsafeObj W2(V);
+
+                ASSERTV(V, W, (V == W) == (W2 == U));
+                ASSERTV(V, W, (V != W) == (W2 != U));
+                ASSERTV(V, W, (V <  W) == (W2 <  U));
+
+                mU = W2;
+                ASSERTV(V, W, U.data(), V == U.data());
+                ASSERTV(V, W, W2 == U);
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create, compare, and destroy a few objects.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        DefaultObj::resetNumDestructions();
+        {
+            DefaultObj mX(1);  const DefaultObj& X = mX;
+            const DefaultObj   Y(2);
+
+            ASSERT(1 == X.data());
+            ASSERT(X != Y);
+            ASSERT(X <  Y);
+
+            mX.setData(2);
+            ASSERT(X == Y);
+        }
+        ASSERT(2 == DefaultObj::numDestructions());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: No memory is ever allocated.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    ASSERTV(defaultAllocator.numBlocksTotal(),
+            0 == defaultAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,89 @@
+// bsltf_noopdeallocatetestallocator.cpp                              -*-C++-*-
+#include <bsltf_noopdeallocatetestallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_alignmentutil.h>
+
+namespace BloombergLP {
+namespace bsltf {
+
+namespace {
+
+// LOCAL CONSTANTS
+
+// Define the number of bytes by which the address returned to the user is
+// *offset* from the start of the block obtained from the upstream allocator,
+// which holds the address of the previously allocated block.
+
+const bslma::Allocator::size_type OFFSET =
+                                       bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+}  // close unnamed namespace
+
+                     // ---------------------------------
+                     // class NoOpDeallocateTestAllocator
+                     // ---------------------------------
+
+// CREATORS
+NoOpDeallocateTestAllocator::NoOpDeallocateTestAllocator(bool verboseFlag)
+: d_upstream("no-op deallocate upstream", verboseFlag)
+, d_blocks_p(0)
+, d_numDeallocations(0)
+{
+}
+
+NoOpDeallocateTestAllocator::~NoOpDeallocateTestAllocator()
+{
+    while (d_blocks_p) {
+        void *next = *static_cast<void **>(d_blocks_p);
+        d_upstream.deallocate(d_blocks_p);
+        d_blocks_p = next;
+    }
+}
+
+// MANIPULATORS
+void *NoOpDeallocateTestAllocator::allocate(size_type size)
+{
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    char *block = static_cast<char *>(d_upstream.allocate(OFFSET + size));
+
+    *reinterpret_cast<void **>(block) = d_blocks_p;
+    d_blocks_p = block;
+
+    return block + OFFSET;
+}
+
+void NoOpDeallocateTestAllocator::deallocate(void *)
+{
+    ++d_numDeallocations;
+}
+
+// ACCESSORS
+bool NoOpDeallocateTestAllocator::hasNoOpDeallocate() const
+{
+    return true;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,185 @@
+// bsltf_noopdeallocatetestallocator.h                                -*-C++-*-
+#ifndef INCLUDED_BSLTF_NOOPDEALLOCATETESTALLOCATOR
+#define INCLUDED_BSLTF_NOOPDEALLOCATETESTALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a test allocator whose 'deallocate' has no effect.
+//
+//@CLASSES:
+//   bsltf::NoOpDeallocateTestAllocator: test allocator with no-op 'deallocate'
+//
+//@SEE_ALSO: bsltf_destructioncountingtesttype, bslma_winkoututil
+//
+//@DESCRIPTION: This component provides a concrete implementation of the
+// 'bslma::Allocator' protocol, 'NoOpDeallocateTestAllocator', whose
+// 'deallocate' method has no effect other than counting its invocations, and
+// that advertises this fact by returning 'true' from 'hasNoOpDeallocate'.
+// Containers that consult 'hasNoOpDeallocate' (see 'bslma_winkoututil') may
+// therefore "wink out" their elements, i.e., skip destroying them and
+// returning their memory, when they use this allocator, which allows test
+// drivers to observe that they do so.
+//
+// All memory is obtained from a 'bslma::TestAllocator' owned by the
+// 'NoOpDeallocateTestAllocator' object, and is returned to it when that object
+// is destroyed, so that memory abandoned by the code under test is neither
+// leaked nor reported as such.  Note that each block carries a maximally
+// aligned header linking it to the previously allocated block.
+//
+///Thread Safety
+///-------------
+// 'NoOpDeallocateTestAllocator' is *not* thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Observing That Memory Is Abandoned
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we wanted to verify that a function releases the memory it
+// allocates only if the supplied allocator's 'deallocate' has an effect.
+//
+// First, we define such a function, 'useBuffer':
+//..
+//  void useBuffer(bslma::Allocator *allocator)
+//      // Allocate a buffer from the specified 'allocator', and deallocate it
+//      // unless 'allocator' has a no-op 'deallocate'.
+//  {
+//      void *buffer = allocator->allocate(64);
+//      if (!allocator->hasNoOpDeallocate()) {
+//          allocator->deallocate(buffer);
+//      }
+//  }
+//..
+// Then, we create a 'NoOpDeallocateTestAllocator', and observe that it
+// reports a no-op 'deallocate':
+//..
+//  bsltf::NoOpDeallocateTestAllocator oa;
+//  assert(true == oa.hasNoOpDeallocate());
+//..
+// Finally, we invoke 'useBuffer', and observe that a block was allocated but
+// not deallocated:
+//..
+//  useBuffer(&oa);
+//  assert(1 == oa.numBlocksTotal());
+//  assert(0 == oa.numDeallocations());
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_TESTALLOCATOR
+#include <bslma_testallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bsltf {
+
+                     // =================================
+                     // class NoOpDeallocateTestAllocator
+                     // =================================
+
+class NoOpDeallocateTestAllocator : public bslma::Allocator {
+    // This class provides a 'bslma::Allocator' whose 'deallocate' method has
+    // no effect other than counting its invocations, and that advertises this
+    // fact through 'hasNoOpDeallocate'.  All memory is obtained from a test
+    // allocator, and is returned to it when this object is destroyed.
+
+    // DATA
+    bslma::TestAllocator  d_upstream;          // supplies all memory
+    void                 *d_blocks_p;          // singly-linked list of blocks
+    int                   d_numDeallocations;  // calls to 'deallocate'
+
+  private:
+    // NOT IMPLEMENTED
+    NoOpDeallocateTestAllocator(const NoOpDeallocateTestAllocator&);
+    NoOpDeallocateTestAllocator& operator=(
+                                           const NoOpDeallocateTestAllocator&);
+
+  public:
+    // CREATORS
+    explicit NoOpDeallocateTestAllocator(bool verboseFlag = false);
+        // Create a no-op-deallocate test allocator.  Optionally specify a
+        // 'verboseFlag' indicating whether the test allocator supplying its
+        // memory reports each allocation and deallocation.  If 'verboseFlag'
+        // is not specified, that test allocator is quiet.
+
+    virtual ~NoOpDeallocateTestAllocator();
+        // Destroy this allocator, returning all of the memory it allocated,
+        // whether or not it was "deallocated".
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes).  If 'size' is 0, a null pointer is
+        // returned with no other effect.  The returned block is maximally
+        // aligned, and remains valid until this allocator is destroyed.
+
+    virtual void deallocate(void *address);
+        // Increment the number of calls to this method, with no other effect.
+        // Note that the specified 'address' is ignored.
+
+    // ACCESSORS
+    virtual bool hasNoOpDeallocate() const;
+        // Return 'true'.
+
+    bsls::Types::Int64 numBlocksTotal() const;
+        // Return the number of blocks allocated from this object.
+
+    int numDeallocations() const;
+        // Return the number of calls to 'deallocate' on this object.
+};
+
+// ===========================================================================
+//                  INLINE AND TEMPLATE FUNCTION IMPLEMENTATIONS
+// ===========================================================================
+
+                     // ---------------------------------
+                     // class NoOpDeallocateTestAllocator
+                     // ---------------------------------
+
+// ACCESSORS
+inline
+bsls::Types::Int64 NoOpDeallocateTestAllocator::numBlocksTotal() const
+{
+    return d_upstream.numBlocksTotal();
+}
+
+inline
+int NoOpDeallocateTestAllocator::numDeallocations() const
+{
+    return d_numDeallocations;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,342 @@
+// bsltf_noopdeallocatetestallocator.t.cpp                            -*-C++-*-
+#include <bsltf_noopdeallocatetestallocator.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_types.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace BloombergLP;
+using namespace BloombergLP::bsltf;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a concrete 'bslma::Allocator' whose
+// 'deallocate' only counts its invocations and whose 'hasNoOpDeallocate'
+// returns 'true'.  We verify that each allocation returns distinct, writable,
+// maximally-aligned memory, that 'deallocate' has no effect other than being
+// counted, and that the memory is released at destruction (which the test
+// allocator supplying it would otherwise report as a leak).
+//
+// Global Concerns:
+//: o No memory is allocated from the default or global allocators.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit NoOpDeallocateTestAllocator(bool verboseFlag = false);
+// [ 2] ~NoOpDeallocateTestAllocator();
+//
+// MANIPULATORS
+// [ 2] void *allocate(size_type size);
+// [ 2] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 2] bool hasNoOpDeallocate() const;
+// [ 2] bsls::Types::Int64 numBlocksTotal() const;
+// [ 2] int numDeallocations() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] USAGE EXAMPLE
+// [ *] CONCERN: No memory is allocated from the default allocator.
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+static void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                     GLOBAL TYPEDEFS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsltf::NoOpDeallocateTestAllocator Obj;
+
+//=============================================================================
+//                              USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Observing That Memory Is Abandoned
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we wanted to verify that a function releases the memory it
+// allocates only if the supplied allocator's 'deallocate' has an effect.
+//
+// First, we define such a function, 'useBuffer':
+//..
+    void useBuffer(bslma::Allocator *allocator)
+        // Allocate a buffer from the specified 'allocator', and deallocate it
+        // unless 'allocator' has a no-op 'deallocate'.
+    {
+        void *buffer = allocator->allocate(64);
+        if (!allocator->hasNoOpDeallocate()) {
+            allocator->deallocate(buffer);
+        }
+    }
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+    int  test                = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose             = argc > 2;
+    bool veryVerbose         = argc > 3;
+    bool veryVeryVerbose     = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void) veryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    // CONCERN: No memory is allocated from the default allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 3: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we create a 'NoOpDeallocateTestAllocator', and observe that it
+// reports a no-op 'deallocate':
+//..
+    bsltf::NoOpDeallocateTestAllocator oa;
+    ASSERT(true == oa.hasNoOpDeallocate());
+//..
+// Finally, we invoke 'useBuffer', and observe that a block was allocated but
+// not deallocated:
+//..
+    useBuffer(&oa);
+    ASSERT(1 == oa.numBlocksTotal());
+    ASSERT(0 == oa.numDeallocations());
+//..
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // ALLOCATE, DEALLOCATE, AND DESTRUCTION
+        //
+        // Concerns:
+        //: 1 'allocate' returns distinct, maximally-aligned blocks that may be
+        //:   written in full, and returns 0 for a 0-sized request without
+        //:   allocating.
+        //:
+        //: 2 'deallocate' has no effect other than incrementing
+        //:   'numDeallocations', and the blocks it is passed remain valid.
+        //:
+        //: 3 'hasNoOpDeallocate' returns 'true' through a base-class
+        //:   reference.
+        //:
+        //: 4 The destructor returns every block, whether or not it was passed
+        //:   to 'deallocate', so that the supplying test allocator reports no
+        //:   leak.
+        //:
+        //: 5 The verbose flag is accepted.
+        //
+        // Plan:
+        //: 1 Allocate a sequence of blocks of various sizes, fill each, and
+        //:   verify their alignment, their contents, and 'numBlocksTotal'.
+        //:   (C-1)
+        //:
+        //: 2 Deallocate half of the blocks, and verify 'numDeallocations' and
+        //:   that every block still holds its contents.  (C-2)
+        //:
+        //: 3 Call 'hasNoOpDeallocate' through a 'bslma::Allocator' reference.
+        //:   (C-3)
+        //:
+        //: 4 Destroy the object; the test allocator it owns asserts in its
+        //:   destructor if any block is outstanding.  (C-4)
+        //:
+        //: 5 Repeat with the verbose flag specified.  (C-5)
+        //
+        // Testing:
+        //   explicit NoOpDeallocateTestAllocator(bool verboseFlag = false);
+        //   ~NoOpDeallocateTestAllocator();
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   bool hasNoOpDeallocate() const;
+        //   bsls::Types::Int64 numBlocksTotal() const;
+        //   int numDeallocations() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nALLOCATE, DEALLOCATE, AND DESTRUCTION"
+                            "\n=====================================\n");
+
+        enum { NUM_BLOCKS = 20 };
+
+        for (int cfg = 0; cfg < 2; ++cfg) {
+            const bool VERBOSE_FLAG = 1 == cfg && veryVeryVerbose;
+
+            Obj mX(VERBOSE_FLAG);  const Obj& X = mX;
+
+            ASSERTV(cfg, 0 == X.numBlocksTotal());
+            ASSERTV(cfg, 0 == X.numDeallocations());
+
+            ASSERTV(cfg, 0 == mX.allocate(0));
+            ASSERTV(cfg, 0 == X.numBlocksTotal());
+
+            char *blocks[NUM_BLOCKS];
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                const int SIZE = 1 + 7 * i;
+
+                blocks[i] = static_cast<char *>(mX.allocate(SIZE));
+
+                const bsls::Types::UintPtr ADDRESS =
+                             reinterpret_cast<bsls::Types::UintPtr>(blocks[i]);
+                const int ALIGNMENT = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+                ASSERTV(cfg, i, 0 == ADDRESS % ALIGNMENT);
+
+                memset(blocks[i], 'a' + i, SIZE);
+
+                ASSERTV(cfg, i, X.numBlocksTotal(),
+                        i + 1 == X.numBlocksTotal());
+            }
+
+            for (int i = 0; i < NUM_BLOCKS; i += 2) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERTV(cfg, X.numDeallocations(),
+                    NUM_BLOCKS / 2 == X.numDeallocations());
+            ASSERTV(cfg, X.numBlocksTotal(),
+                    NUM_BLOCKS == X.numBlocksTotal());
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                const int SIZE = 1 + 7 * i;
+
+                for (int j = 0; j < SIZE; ++j) {
+                    ASSERTV(cfg, i, j, 'a' + i == blocks[i][j]);
+                }
+            }
+
+            const bslma::Allocator& BASE = X;
+            ASSERTV(cfg, BASE.hasNoOpDeallocate());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate a block, and verify the counts.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        Obj mX;  const Obj& X = mX;
+
+        ASSERT(X.hasNoOpDeallocate());
+
+        void *p = mX.allocate(100);
+        ASSERT(p);
+        ASSERT(1 == X.numBlocksTotal());
+
+        mX.deallocate(p);
+        ASSERT(1 == X.numDeallocations());
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: No memory is allocated from the default allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    ASSERTV(defaultAllocator.numBlocksTotal(),
+            0 == defaultAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2013 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------